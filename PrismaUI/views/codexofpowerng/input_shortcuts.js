@@ -57,6 +57,7 @@
     const getKeyNavRaf = asFn(options.getKeyNavRaf, () => 0);
     const setKeyNavRaf = asFn(options.setKeyNavRaf, noop);
     const toHex32 = asFn(options.toHex32, (v) => String(v >>> 0));
+    const isPostLoadReady = asFn(options.isPostLoadReady, () => true);
 
     const doc = options.documentObj || (global && global.document) || null;
     const raf =
@@ -181,6 +182,10 @@
       const quickSelectedId = getQuickSelectedId() >>> 0;
       if (isEnter && quickSelectedId) {
         if (e && e.preventDefault) e.preventDefault();
+        if (!isPostLoadReady()) {
+          showToast("warn", t("toast.postLoadPending", "Still loading the save. Try again in a moment."));
+          return;
+        }
         safeCall("copng_log", { level: "info", message: `UI register enter: ${toHex32(quickSelectedId >>> 0)}` });
         safeCall("copng_registerItem", { formId: quickSelectedId >>> 0 });
       }
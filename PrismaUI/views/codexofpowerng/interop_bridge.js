@@ -79,6 +79,10 @@
     return Array.isArray(payload) ? payload : [];
   }
 
+  function normalizeObjectPayload(payload) {
+    return payload && typeof payload === "object" && !Array.isArray(payload) ? payload : {};
+  }
+
   function normalizeNumber(value, fallback) {
     const numeric = Number(value);
     return Number.isFinite(numeric) ? numeric : fallback;
@@ -338,29 +342,53 @@
     const onState = asFn(options.onState, noop);
     const onInventory = asFn(options.onInventory, noop);
     const onRegistered = asFn(options.onRegistered, noop);
+    const onRegisteredPage = asFn(options.onRegisteredPage, noop);
+    const onRegisteredDelta = asFn(options.onRegisteredDelta, noop);
     const onBuild = asFn(options.onBuild, noop);
     const onRewards = asFn(options.onRewards, noop);
     const onUndoList = asFn(options.onUndoList, noop);
     const onSettings = asFn(options.onSettings, noop);
     const onToast = asFn(options.onToast, noop);
 
+    const patchApi = options.uiPatchApi || global.COPNGUiPatch || null;
+    const patchReceiver =
+      patchApi && typeof patchApi.createPatchReceiver === "function"
+        ? patchApi.createPatchReceiver({
+            channels: {
+              state: (raw) => onState(raw),
+              inventory: (raw) => onInventory(normalizeInventoryPayload(raw, pick)),
+              build: (raw) => onBuild(normalizeBuildPayload(raw)),
+              rewards: (raw) => onRewards(raw),
+              undo: (raw) => onUndoList(normalizeArrayPayload(raw)),
+            },
+            requestResync: options.requestPatchResync,
+          })
+        : null;
+    const noteSnapshot = patchReceiver ? patchReceiver.noteSnapshot : noop;
+
     const prev = {
       setState: win.copng_setState,
       setInventory: win.copng_setInventory,
       setRegistered: win.copng_setRegistered,
+      setRegisteredPage: win.copng_setRegisteredPage,
+      setRegisteredDelta: win.copng_setRegisteredDelta,
       setBuild: win.copng_setBuild,
       setRewards: win.copng_setRewards,
       setUndoList: win.copng_setUndoList,
+      applyPatch: win.copng_applyPatch,
       setSettings: win.copng_setSettings,
       toast: win.copng_toast,
     };
 
     win.copng_setState = (jsonStr) => {
-      onState(parseJsonPayload(jsonStr, {}));
+      const payload = parseJsonPayload(jsonStr, {});
+      noteSnapshot("state", payload);
+      onState(payload);
     };
 
     win.copng_setInventory = (jsonStr) => {
       const payload = parseJsonPayload(jsonStr, []);
+      noteSnapshot("inventory", payload);
       onInventory(normalizeInventoryPayload(payload, pick));
     };
 
@@ -369,19 +397,38 @@
       onRegistered(normalizeArrayPayload(payload));
     };
 
+    win.copng_setRegisteredPage = (jsonStr) => {
+      onRegisteredPage(normalizeObjectPayload(parseJsonPayload(jsonStr, null)));
+    };
+
+    win.copng_setRegisteredDelta = (jsonStr) => {
+      onRegisteredDelta(normalizeObjectPayload(parseJsonPayload(jsonStr, null)));
+    };
+
     win.copng_setBuild = (jsonStr) => {
-      onBuild(normalizeBuildPayload(parseJsonPayload(jsonStr, null)));
+      const payload = parseJsonPayload(jsonStr, null);
+      noteSnapshot("build", payload);
+      onBuild(normalizeBuildPayload(payload));
     };
 
     win.copng_setRewards = (jsonStr) => {
-      onRewards(parseJsonPayload(jsonStr, { totals: [] }));
+      const payload = parseJsonPayload(jsonStr, { totals: [] });
+      noteSnapshot("rewards", payload);
+      onRewards(payload);
     };
 
     win.copng_setUndoList = (jsonStr) => {
       const payload = parseJsonPayload(jsonStr, []);
+      noteSnapshot("undo", payload);
       onUndoList(normalizeArrayPayload(payload));
     };
 
+    win.copng_applyPatch = (jsonStr) => {
+      if (patchReceiver) {
+        patchReceiver.receive(parseJsonPayload(jsonStr, null));
+      }
+    };
+
     win.copng_setSettings = (jsonStr) => {
       onSettings(parseJsonPayload(jsonStr, null));
     };
@@ -394,9 +441,12 @@
       win.copng_setState = prev.setState;
       win.copng_setInventory = prev.setInventory;
       win.copng_setRegistered = prev.setRegistered;
+      win.copng_setRegisteredPage = prev.setRegisteredPage;
+      win.copng_setRegisteredDelta = prev.setRegisteredDelta;
       win.copng_setBuild = prev.setBuild;
       win.copng_setRewards = prev.setRewards;
       win.copng_setUndoList = prev.setUndoList;
+      win.copng_applyPatch = prev.applyPatch;
       win.copng_setSettings = prev.setSettings;
       win.copng_toast = prev.toast;
     };
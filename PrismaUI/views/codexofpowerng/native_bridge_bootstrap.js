@@ -164,29 +164,64 @@
     const onState = asFn(options.onState, noop);
     const onInventory = asFn(options.onInventory, noop);
     const onRegistered = asFn(options.onRegistered, noop);
+    const onRegisteredPage = asFn(options.onRegisteredPage, noop);
+    const onRegisteredDelta = asFn(options.onRegisteredDelta, noop);
     const onBuild = asFn(options.onBuild, noop);
     const onRewards = asFn(options.onRewards, noop);
     const onUndoList = asFn(options.onUndoList, noop);
     const onSettings = asFn(options.onSettings, noop);
     const onToast = asFn(options.onToast, noop);
 
+    const patchApi = options.uiPatchApi || (global && global.COPNGUiPatch) || null;
+    const patchReceiver =
+      patchApi && typeof patchApi.createPatchReceiver === "function"
+        ? patchApi.createPatchReceiver({
+            channels: {
+              state: function (raw) {
+                onState(raw || {});
+              },
+              inventory: function (raw) {
+                onInventory(normalizeInventoryPayload(raw, coalesce));
+              },
+              build: function (raw) {
+                onBuild(normalizeBuildPayload(raw));
+              },
+              rewards: function (raw) {
+                onRewards(raw);
+              },
+              undo: function (raw) {
+                onUndoList(Array.isArray(raw) ? raw : []);
+              },
+            },
+            requestResync: options.requestPatchResync,
+          })
+        : null;
+    const noteSnapshot = patchReceiver ? patchReceiver.noteSnapshot : noop;
+
     const prev = {
       setState: win.copng_setState,
       setInventory: win.copng_setInventory,
       setRegistered: win.copng_setRegistered,
+      setRegisteredPage: win.copng_setRegisteredPage,
+      setRegisteredDelta: win.copng_setRegisteredDelta,
       setBuild: win.copng_setBuild,
       setRewards: win.copng_setRewards,
       setUndoList: win.copng_setUndoList,
+      applyPatch: win.copng_applyPatch,
       setSettings: win.copng_setSettings,
       toast: win.copng_toast,
     };
 
     win.copng_setState = function (jsonStr) {
-      onState(parseJsonPayload(jsonStr, {}) || {});
+      const payload = parseJsonPayload(jsonStr, {}) || {};
+      noteSnapshot("state", payload);
+      onState(payload);
     };
 
     win.copng_setInventory = function (jsonStr) {
-      onInventory(normalizeInventoryPayload(parseJsonPayload(jsonStr, null), coalesce));
+      const payload = parseJsonPayload(jsonStr, null);
+      noteSnapshot("inventory", payload);
+      onInventory(normalizeInventoryPayload(payload, coalesce));
     };
 
     win.copng_setRegistered = function (jsonStr) {
@@ -194,19 +229,40 @@
       onRegistered(Array.isArray(payload) ? payload : []);
     };
 
+    win.copng_setRegisteredPage = function (jsonStr) {
+      const payload = parseJsonPayload(jsonStr, null);
+      onRegisteredPage(payload && typeof payload === "object" ? payload : {});
+    };
+
+    win.copng_setRegisteredDelta = function (jsonStr) {
+      const payload = parseJsonPayload(jsonStr, null);
+      onRegisteredDelta(payload && typeof payload === "object" ? payload : {});
+    };
+
     win.copng_setBuild = function (jsonStr) {
-      onBuild(normalizeBuildPayload(parseJsonPayload(jsonStr, null)));
+      const payload = parseJsonPayload(jsonStr, null);
+      noteSnapshot("build", payload);
+      onBuild(normalizeBuildPayload(payload));
     };
 
     win.copng_setRewards = function (jsonStr) {
-      onRewards(parseJsonPayload(jsonStr, { totals: [] }));
+      const payload = parseJsonPayload(jsonStr, { totals: [] });
+      noteSnapshot("rewards", payload);
+      onRewards(payload);
     };
 
     win.copng_setUndoList = function (jsonStr) {
       const payload = parseJsonPayload(jsonStr, []);
+      noteSnapshot("undo", payload);
       onUndoList(Array.isArray(payload) ? payload : []);
     };
 
+    win.copng_applyPatch = function (jsonStr) {
+      if (patchReceiver) {
+        patchReceiver.receive(parseJsonPayload(jsonStr, null));
+      }
+    };
+
     win.copng_setSettings = function (jsonStr) {
       onSettings(parseJsonPayload(jsonStr, null));
     };
@@ -219,9 +275,12 @@
       win.copng_setState = prev.setState;
       win.copng_setInventory = prev.setInventory;
       win.copng_setRegistered = prev.setRegistered;
+      win.copng_setRegisteredPage = prev.setRegisteredPage;
+      win.copng_setRegisteredDelta = prev.setRegisteredDelta;
       win.copng_setBuild = prev.setBuild;
       win.copng_setRewards = prev.setRewards;
       win.copng_setUndoList = prev.setUndoList;
+      win.copng_applyPatch = prev.applyPatch;
       win.copng_setSettings = prev.setSettings;
       win.copng_toast = prev.toast;
     };
@@ -280,6 +280,11 @@
     return Array.isArray(nextUndoItems) ? nextUndoItems : [];
   }
 
+  function defaultApplyRowChanges(rows, changes) {
+    const tables = global && global.COPNGVirtualTables;
+    return !!(tables && typeof tables.applyRowChanges === "function" && tables.applyRowChanges(rows, changes));
+  }
+
   function createNativeStateBridge(opts) {
     const options = opts || {};
     const documentObj = options.documentObj || (global && global.document) || null;
@@ -288,6 +293,11 @@
     const setStateValue = asFn(options.setStateValue, noop);
     const setInventoryPage = asFn(options.setInventoryPage, noop);
     const setRegisteredItems = asFn(options.setRegisteredItems, noop);
+    const getRegisteredItems = asFn(options.getRegisteredItems, () => []);
+    const getRegisteredVersion = asFn(options.getRegisteredVersion, () => 0);
+    const setRegisteredVersion = asFn(options.setRegisteredVersion, noop);
+    const applyRowChanges = asFn(options.applyRowChanges, defaultApplyRowChanges);
+    const requestRegisteredResync = asFn(options.requestRegisteredResync, noop);
     const setBuildValue = asFn(options.setBuildValue, noop);
     const setRewardsValue = asFn(options.setRewardsValue, noop);
     const setUndoItems = asFn(options.setUndoItems, noop);
@@ -306,6 +316,25 @@
     const schedulePostRefreshVirtualResync = asFn(options.schedulePostRefreshVirtualResync, noop);
     const isTabActive = asFn(options.isTabActive, () => true);
 
+    let registeredPageBuffer = null;
+
+    // Drops whatever partial registered state we hold and asks native for a full snapshot.
+    function resyncRegistered() {
+      registeredPageBuffer = null;
+      setRegisteredVersion(0);
+      requestRegisteredResync();
+    }
+
+    function commitRegistered(rows, version) {
+      setRegisteredVersion(version);
+      setRegisteredItems(rows);
+      resetRegisteredVirtualWindow();
+      if (isTabActive("tabRegistered")) {
+        renderRegistered();
+        schedulePostRefreshVirtualResync();
+      }
+    }
+
     function syncLanguage(nextLang) {
       const resolved = nextLang === "ko" ? "ko" : "en";
       setUiLang(resolved);
@@ -332,6 +361,7 @@
       },
 
       onRegistered(nextRegistered) {
+        setRegisteredVersion(0);
         setRegisteredItems(nextRegistered);
         resetRegisteredVirtualWindow();
         if (isTabActive("tabRegistered")) {
@@ -340,6 +370,44 @@
         }
       },
 
+      onRegisteredPage(nextPage) {
+        const page = nextPage || {};
+        const version = Number(page.version) || 0;
+        const total = Number(page.total) >>> 0;
+        const offset = Number(page.offset) >>> 0;
+        const items = Array.isArray(page.items) ? page.items : [];
+
+        if (offset === 0) registeredPageBuffer = { version, rows: [] };
+        const buffer = registeredPageBuffer;
+        if (!buffer || buffer.version !== version || buffer.rows.length !== offset) {
+          resyncRegistered();
+          return;
+        }
+
+        for (let i = 0; i < items.length; i++) buffer.rows.push(items[i]);
+        if (buffer.rows.length < total) return;
+
+        registeredPageBuffer = null;
+        commitRegistered(buffer.rows, version);
+      },
+
+      onRegisteredDelta(nextDelta) {
+        const delta = nextDelta || {};
+        const fromVersion = Number(delta.fromVersion) || 0;
+        if (registeredPageBuffer || fromVersion === 0 || fromVersion !== getRegisteredVersion()) {
+          resyncRegistered();
+          return;
+        }
+
+        if (!applyRowChanges(getRegisteredItems(), delta.changes)) {
+          resyncRegistered();
+          return;
+        }
+
+        setRegisteredVersion(Number(delta.version) || 0);
+        if (isTabActive("tabRegistered")) renderRegistered();
+      },
+
       onBuild(nextBuild) {
         setBuildValue(normalizeBuildPayload(nextBuild));
         if (isTabActive("tabBuild")) renderBuild();
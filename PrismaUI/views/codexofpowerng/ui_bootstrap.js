@@ -198,6 +198,7 @@
     const windowObj = options.windowObj;
     const rootScrollEl = options.rootScrollEl || null;
     const t = asFn(options.t, (_key, fallback) => fallback);
+    const getRegisteredVersion = asFn(stateApi && stateApi.getRegisteredVersion, () => 0);
 
     if (uiWiringApi && typeof uiWiringApi.installUIWiring === "function") {
       uiWiringApi.installUIWiring({
@@ -226,6 +227,7 @@
         syncRewardCharacterImageState: renderingApi.syncRewardCharacterImageState,
         requestInventoryPage: interactionsApi.requestInventoryPage,
         getInventoryPage: stateApi.getInventoryPage,
+        getRegisteredVersion,
         setInventoryPageSize: stateApi.setInventoryPageSize,
         showConfirm: stateApi.showConfirm,
         t,
@@ -264,7 +266,7 @@
     safeCall("copng_requestState", {});
     safeCall("copng_getSettings", {});
     safeCall("copng_requestInventory", { page: 0, pageSize: 200 });
-    safeCall("copng_requestRegistered", {});
+    safeCall("copng_requestRegistered", { version: Number(getRegisteredVersion()) || 0 });
     safeCall("copng_requestUndoList", {});
     safeCall("copng_requestBuild", {});
 
@@ -298,6 +300,10 @@
         t,
         showToast: stateApi.showToast,
         safeCall,
+        isPostLoadReady: () => {
+          const state = stateApi.getState() || {};
+          return !state.postLoad || state.postLoad.ready !== false;
+        },
         setTab: renderingApi.setTab,
         setInputScale: stateApi.setInputScale,
         getInputScale: stateApi.getInputScale,
@@ -274,11 +274,13 @@
       "toast.bindKeyUnknown": "Unsupported key. Type a DIK code (e.g. 0x3E).",
       "toast.bindKeySet": "Hotkey set",
       "toast.lotdGateBlocked": "LOTD Display gate is enabled, but TCC lists are unavailable. Registration is blocked.",
+      "toast.postLoadPending": "Still loading the save. Try again in a moment.",
       "confirm.refund": "Refund rewards? This cannot be undone.",
       "btn.cancel": "Cancel",
       "btn.ok": "OK",
       "status.ui": "UI",
       "status.loading": "loading",
+      "status.postLoad": "loading save",
       "status.ready": "ready",
       "status.hidden": "hidden",
       "status.shown": "shown",
@@ -565,11 +567,13 @@
       "toast.bindKeyUnknown": "지원하지 않는 키입니다. DIK 코드를 입력하세요(예: 0x3E).",
       "toast.bindKeySet": "단축키 설정",
       "toast.lotdGateBlocked": "LOTD 전시 게이트가 켜져 있지만 TCC 리스트를 찾지 못했습니다. 등록이 차단됩니다.",
+      "toast.postLoadPending": "세이브를 불러오는 중입니다. 잠시 후 다시 시도하세요.",
       "confirm.refund": "보상을 환불할까요? 되돌릴 수 없습니다.",
       "btn.cancel": "취소",
       "btn.ok": "확인",
       "status.ui": "UI",
       "status.loading": "로딩",
+      "status.postLoad": "세이브 로딩",
       "status.ready": "준비됨",
       "status.hidden": "숨김",
       "status.shown": "표시",
@@ -38,6 +38,8 @@
     const getQuickActionableOnly = asFn(stateApi && stateApi.getQuickActionableOnly, () => false);
     const setQuickActionableOnly = asFn(stateApi && stateApi.setQuickActionableOnly, noop);
     const setBuildSelection = asFn(stateApi && stateApi.setBuildSelection, noop);
+    const getState = asFn(stateApi && stateApi.getState, () => null);
+    const showToast = asFn(stateApi && stateApi.showToast, noop);
 
     let quickRenderTimer = null;
     let regRenderTimer = null;
@@ -106,6 +108,14 @@
       }
     }
 
+    // Native rejects register/build/undo requests until the post-load pipeline finishes.
+    function ensurePostLoadReady() {
+      const state = getState() || {};
+      if (!state.postLoad || state.postLoad.ready !== false) return true;
+      showToast("warn", t("toast.postLoadPending", "Still loading the save. Try again in a moment."));
+      return false;
+    }
+
     function onQuickBodyClick(e) {
       let node = e.target;
       while (node && node !== quickBody) {
@@ -122,6 +132,7 @@
             const id = Number(el.getAttribute("data-id"));
             if (Number.isFinite(id) && id > 0) {
               setQuickSelected(id);
+              if (!ensurePostLoadReady()) return;
               safeCall("copng_log", { level: "info", message: `UI register click: ${stateApi.toHex32(id >>> 0)}` });
               safeCall("copng_registerItem", { formId: id >>> 0 });
             }
@@ -182,6 +193,7 @@
     function onBatchRegisterClick() {
       const summary = buildQuickBatchSummary();
       if (!summary || !Array.isArray(summary.formIds) || summary.formIds.length === 0) return;
+      if (!ensurePostLoadReady()) return;
       safeCall("copng_requestRegisterBatch", { formIds: summary.formIds.slice() });
     }
 
@@ -198,7 +210,7 @@
           if (el.tagName === "BUTTON" && el.getAttribute("data-action") === "undo") {
             if (el.disabled) return;
             const actionId = Number(el.getAttribute("data-id"));
-            if (Number.isFinite(actionId) && actionId > 0) {
+            if (Number.isFinite(actionId) && actionId > 0 && ensurePostLoadReady()) {
               safeCall("copng_undoRegisterItem", { actionId: Math.trunc(actionId) });
             }
             return;
@@ -243,13 +255,14 @@
             const slotId = String(el.getAttribute("data-slot-id") || "");
             if (optionId && slotId) {
               setBuildSelection({ optionId });
+              if (!ensurePostLoadReady()) return;
               safeCall("copng_activateBuildOption", { optionId, slotId });
             }
             return;
           }
           if (action === "build-deactivate") {
             const slotId = String(el.getAttribute("data-slot-id") || "");
-            if (slotId) {
+            if (slotId && ensurePostLoadReady()) {
               safeCall("copng_deactivateBuildOption", { slotId });
             }
             return;
@@ -260,6 +273,7 @@
             const toSlotId = String(el.getAttribute("data-to-slot-id") || "");
             if (optionId && fromSlotId && toSlotId) {
               setBuildSelection({ optionId });
+              if (!ensurePostLoadReady()) return;
               safeCall("copng_swapBuildOption", { optionId, fromSlotId, toSlotId });
             }
             return;
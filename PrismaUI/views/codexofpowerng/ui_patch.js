@@ -0,0 +1,124 @@
+(function (global) {
+  "use strict";
+
+  function noop() {}
+
+  function asFn(maybeFn, fallback) {
+    return typeof maybeFn === "function" ? maybeFn : fallback;
+  }
+
+  // Same order as PatchChannel in src/PrismaUIPatch.h.
+  const CHANNELS = Object.freeze(["state", "inventory", "build", "rewards", "undo"]);
+
+  function isPlainObject(value) {
+    return !!value && typeof value === "object" && !Array.isArray(value);
+  }
+
+  function applyRowsPatch(rows, node) {
+    if (!Array.isArray(rows) || !Array.isArray(node.rows)) return undefined;
+    const key = typeof node.key === "string" ? node.key : "";
+    const out = rows.slice();
+    for (const op of node.rows) {
+      const index = op && Number.isInteger(op.index) ? op.index : -1;
+      if (op.op === "remove") {
+        if (index < 0 || index >= out.length || !out[index] || out[index][key] !== op.key) return undefined;
+        out.splice(index, 1);
+      } else if (op.op === "insert") {
+        if (index < 0 || index > out.length) return undefined;
+        out.splice(index, 0, op.row);
+      } else if (op.op === "patch") {
+        if (index < 0 || index >= out.length) return undefined;
+        const row = applyPatch(out[index], op.patch);
+        if (row === undefined) return undefined;
+        out[index] = row;
+      } else {
+        return undefined;
+      }
+    }
+    return out;
+  }
+
+  function applyObjectPatch(value, node) {
+    if (!isPlainObject(value)) return undefined;
+    const out = Object.assign({}, value);
+    if (Array.isArray(node.unset)) {
+      for (const name of node.unset) delete out[name];
+    }
+    if (isPlainObject(node.set)) {
+      Object.assign(out, node.set);
+    }
+    if (isPlainObject(node.patch)) {
+      for (const name of Object.keys(node.patch)) {
+        const child = applyPatch(out[name], node.patch[name]);
+        if (child === undefined) return undefined;
+        out[name] = child;
+      }
+    }
+    return out;
+  }
+
+  // Returns a patched copy of `value` (untouched subtrees are shared), or undefined when the
+  // patch does not fit `value` and the view has to be re-seeded.
+  function applyPatch(value, node) {
+    if (!isPlainObject(node)) return undefined;
+    return Array.isArray(node.rows) ? applyRowsPatch(value, node) : applyObjectPatch(value, node);
+  }
+
+  function createPatchReceiver(opts) {
+    const options = opts || {};
+    const handlers = options.channels && typeof options.channels === "object" ? options.channels : {};
+    const requestResync = asFn(options.requestResync, noop);
+    const baselines = Object.create(null);
+    let generation = 0;
+
+    function noteSnapshot(name, raw) {
+      if (CHANNELS.indexOf(name) >= 0) {
+        baselines[name] = raw;
+      }
+    }
+
+    function reject() {
+      requestResync();
+      return false;
+    }
+
+    function receive(payload) {
+      if (!isPlainObject(payload) || !isPlainObject(payload.channels)) return reject();
+      if (!payload.reset && Number(payload.base) !== generation) return reject();
+
+      const resolved = [];
+      for (const name of CHANNELS) {
+        const entry = payload.channels[name];
+        if (!isPlainObject(entry)) continue;
+        const next = "full" in entry ? entry.full : applyPatch(baselines[name], entry.patch);
+        if (next === undefined) return reject();
+        resolved.push([name, next]);
+      }
+
+      generation = Number(payload.generation) || 0;
+      for (const [name, next] of resolved) {
+        baselines[name] = next;
+        asFn(handlers[name], noop)(next);
+      }
+      return true;
+    }
+
+    return {
+      noteSnapshot,
+      receive,
+      getGeneration: () => generation,
+    };
+  }
+
+  const api = Object.freeze({
+    CHANNELS,
+    applyPatch,
+    createPatchReceiver,
+  });
+
+  if (typeof module !== "undefined" && module && module.exports) {
+    module.exports = api;
+  }
+
+  global.COPNGUiPatch = api;
+})(typeof window !== "undefined" ? window : globalThis);
@@ -380,7 +380,9 @@
       if (refs.statusEl) {
         refs.statusEl.textContent = `${t("status.ui", "UI")}: ${ui.ready ? t("status.ready", "ready") : t("status.loading", "loading")} | ${
           ui.hidden ? t("status.hidden", "hidden") : t("status.shown", "shown")
-        } | ${ui.focused ? t("status.focus", "focus") : t("status.noFocus", "no-focus")}`;
+        } | ${ui.focused ? t("status.focus", "focus") : t("status.noFocus", "no-focus")}${
+          state.postLoad && state.postLoad.ready === false ? ` | ${t("status.postLoad", "loading save")}` : ""
+        }`;
       }
       if (refs.countsEl) refs.countsEl.textContent = `${t("status.registered", "Registered")}: ${coalesce(state.registeredCount, 0)}`;
       if (refs.langEl) refs.langEl.textContent = `${t("status.lang", "Lang")}: ${coalesce(state.language, "?")}`;
@@ -554,7 +556,10 @@
       const regFilterEl = documentObj ? documentObj.getElementById("regFilter") : null;
       const query = String((regFilterEl && regFilterEl.value) || "").toLowerCase();
       const registered = Array.isArray(getRegistered()) ? getRegistered() : [];
-      const rows = registered.filter((item) => !query || String(item.name || "").toLowerCase().indexOf(query) !== -1);
+      // Unfiltered views share the registered array so native splices land without a copy.
+      const rows = query
+        ? registered.filter((item) => String(item.name || "").toLowerCase().indexOf(query) !== -1)
+        : registered;
       if (refs.regVirtual) refs.regVirtual.rows = rows;
       scheduleVirtualRender({ force: true });
     }
@@ -578,11 +583,13 @@
                 const buttonText = canUndo ? t("btn.undo", "Undo") : t("undo.onlyLatest", "Latest only");
                 const disabled = canUndo ? "" : " disabled";
                 const actionClass = canUndo ? "danger" : "";
+                const itemCount = Number(item.itemCount || 1);
+                const batchText = itemCount > 1 ? ` <span class="pill mono">+${itemCount - 1}</span>` : "";
                 return `
           <tr class="dataRow ${index % 2 === 0 ? "rowOdd" : ""}">
             <td class="colGroup"><span class="pill">${escapeHtml(item.groupName || String(item.group || ""))}</span></td>
             <td>
-              <span class="itemName">${escapeHtml(item.name || "(unnamed)")}</span>
+              <span class="itemName">${escapeHtml(item.name || "(unnamed)")}</span>${batchText}
               <span class="small mono">${escapeHtml(rewardText)}</span>
             </td>
             <td class="colFormId mono">${toHex32(Number(item.formId || 0) >>> 0)}</td>
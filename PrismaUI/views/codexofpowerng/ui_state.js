@@ -120,6 +120,7 @@
     let quickActionableOnly = false;
     const quickVirtual = { rows: [], lastStart: -1, lastEnd: -1, tbodyTopPx: NaN, rowHeightPx: 0 };
     let registered = [];
+    let registeredVersion = 0;
     let undoItems = [];
     const regVirtual = { rows: [], lastStart: -1, lastEnd: -1, tbodyTopPx: NaN, rowHeightPx: 0 };
     let rewards = { totals: [] };
@@ -657,6 +658,10 @@
       setRegistered: (next) => {
         registered = next;
       },
+      getRegisteredVersion: () => registeredVersion,
+      setRegisteredVersion: (next) => {
+        registeredVersion = Number(next) || 0;
+      },
       getUndoItems: () => undoItems,
       setUndoItems: (next) => {
         undoItems = next;
@@ -30,6 +30,9 @@
       return { page: 0, pageSize: 200 };
     });
     const setInventoryPageSize = asFn(options.setInventoryPageSize, noop);
+    const getRegisteredVersion = asFn(options.getRegisteredVersion, function () {
+      return 0;
+    });
     const showConfirm = asFn(
       options.showConfirm,
       async function () {
@@ -104,11 +107,17 @@
       }
     }
 
+    // Native answers with a delta when it still journals the version the view holds. The version is a
+    // 64-bit counter sent as-is (exact up to 2^53); truncating it would never match the journal again.
+    function requestRegistered() {
+      safeCall("copng_requestRegistered", { version: Number(getRegisteredVersion()) || 0 });
+    }
+
     addListener(byId(doc, "btnRefreshState"), "click", function () {
       safeCall("copng_requestState", {});
       safeCall("copng_getSettings", {});
       requestInventoryPage(0);
-      safeCall("copng_requestRegistered", {});
+      requestRegistered();
       safeCall("copng_requestUndoList", {});
       safeCall("copng_requestBuild", {});
     });
@@ -151,7 +160,7 @@
     }
 
     addListener(byId(doc, "btnRefreshReg"), "click", function () {
-      safeCall("copng_requestRegistered", {});
+      requestRegistered();
     });
     addListener(byId(doc, "btnRefreshUndo"), "click", function () {
       safeCall("copng_requestUndoList", {});
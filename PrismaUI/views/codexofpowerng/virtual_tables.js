@@ -53,6 +53,29 @@
     return Number(re.top || 0) - Number(rr.top || 0) + Number(rootEl.scrollTop || 0);
   }
 
+  // Replays native row splices ({ op: "insert", index, row } / { op: "remove", index, formId }) in
+  // order. Returns false as soon as a change does not line up; the caller must then resync in full.
+  function applyRowChanges(rows, changes) {
+    if (!Array.isArray(rows) || !Array.isArray(changes)) return false;
+    for (let i = 0; i < changes.length; i++) {
+      const change = changes[i] || {};
+      const index = Number(change.index);
+      if (!Number.isInteger(index) || index < 0) return false;
+      if (change.op === "insert") {
+        if (index > rows.length || !change.row) return false;
+        rows.splice(index, 0, change.row);
+      } else if (change.op === "remove") {
+        if (index >= rows.length) return false;
+        const existing = rows[index] || {};
+        if (change.formId !== undefined && Number(existing.formId) >>> 0 !== Number(change.formId) >>> 0) return false;
+        rows.splice(index, 1);
+      } else {
+        return false;
+      }
+    }
+    return true;
+  }
+
   function createVirtualTableManager(opts) {
     const options = opts || {};
 
@@ -311,6 +334,7 @@
   }
 
   const api = Object.freeze({
+    applyRowChanges: applyRowChanges,
     createVirtualTableManager: createVirtualTableManager,
     getOffsetTopInRoot: getOffsetTopInRoot,
   });
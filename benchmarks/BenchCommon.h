@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace CodexOfPowerNG::Bench
+{
+	// Keeps the optimizer from discarding benchmark results.
+	template <class T>
+	inline void DoNotOptimize(const T& value) noexcept
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		static const void* volatile sink = nullptr;
+		sink = &value;
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	struct Result
+	{
+		double medianUs{ 0.0 };
+		double minUs{ 0.0 };
+	};
+
+	// Runs `fn` `iterations` times after one warmup call and reports per-call wall time.
+	template <class Fn>
+	[[nodiscard]] Result Measure(std::size_t iterations, Fn&& fn)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		fn();
+
+		std::vector<double> samples;
+		samples.reserve(iterations);
+		for (std::size_t i = 0; i < iterations; ++i) {
+			const auto start = Clock::now();
+			fn();
+			const auto end = Clock::now();
+			samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+		}
+
+		std::sort(samples.begin(), samples.end());
+		return Result{ samples[samples.size() / 2], samples.front() };
+	}
+
+	inline void Report(const char* label, std::size_t n, const Result& result) noexcept
+	{
+		std::printf("%-44s n=%-7zu median=%10.2f us  min=%10.2f us\n", label, n, result.medianUs, result.minUs);
+	}
+
+	// Deterministic xorshift so runs are comparable across machines.
+	struct Rng
+	{
+		std::uint64_t state{ 0x9E3779B97F4A7C15ull };
+
+		[[nodiscard]] std::uint64_t Next() noexcept
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return state;
+		}
+
+		[[nodiscard]] std::uint32_t Below(std::uint32_t bound) noexcept
+		{
+			return static_cast<std::uint32_t>(Next() % bound);
+		}
+	};
+}
@@ -0,0 +1,201 @@
+// One build effect sync (SyncCurrentBuildEffectsToPlayer) reduced to its container work: derive the
+// desired per-AV totals from the active build parts, diff them against the applied totals over the
+// union of both key sets, clamp each delta against the actor and store the next applied totals.
+// Previous path: unordered_map accumulate + sorted vector, a desired map, an unordered_set merge.
+// Dense path: AV-indexed table with a presence mask, whole-table Difference and Prune.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/DenseEnumMap.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+
+	enum class AV : std::uint32_t
+	{
+		kShoutRecoveryMult = 130,
+		kTotal = 164,
+	};
+
+	struct AVHash
+	{
+		std::size_t operator()(AV av) const noexcept { return static_cast<std::size_t>(av); }
+	};
+
+	inline constexpr std::size_t kAVCount = static_cast<std::size_t>(AV::kTotal);
+	inline constexpr float       kEpsilon = 0.001f;
+
+	using DenseTotals = CodexOfPowerNG::Containers::DenseEnumMap<AV, kAVCount>;
+	using MapTotals = std::unordered_map<AV, float, AVHash>;
+
+	struct EffectPart
+	{
+		AV    av;
+		float delta;
+	};
+
+	// Same shape as ClampBuildSyncDeltaForActorValue: only a floor on one AV reads the actor.
+	[[nodiscard]] float ClampDelta(AV av, float currentActorValue, float desiredDelta) noexcept
+	{
+		if (av != AV::kShoutRecoveryMult || desiredDelta >= 0.0f) {
+			return desiredDelta;
+		}
+		constexpr float kFloor = 0.30f;
+		if (currentActorValue <= kFloor + kEpsilon) {
+			return 0.0f;
+		}
+		return (currentActorValue + desiredDelta) < kFloor ? kFloor - currentActorValue : desiredDelta;
+	}
+
+	struct Fixture
+	{
+		std::vector<EffectPart>           parts;    // resolved effect parts of the active build
+		std::vector<std::pair<AV, float>> applied;  // what the previous sync left applied
+		std::array<float, kAVCount>       actor{};
+	};
+
+	[[nodiscard]] Fixture MakeFixture(std::size_t partCount, std::uint32_t distinctAVs)
+	{
+		Bench::Rng      rng;
+		Fixture         fixture;
+		std::vector<AV> pool;
+		for (std::uint32_t i = 0; i < distinctAVs; ++i) {
+			pool.push_back(static_cast<AV>((i * 37u) % kAVCount));
+		}
+		for (std::size_t i = 0; i < partCount; ++i) {
+			fixture.parts.push_back(EffectPart{ pool[rng.Below(distinctAVs)], 0.5f + static_cast<float>(rng.Below(40)) * 0.25f });
+		}
+		// Half the applied AVs overlap the desired ones, half are stale (the build slot changed).
+		for (std::uint32_t i = 0; i < distinctAVs; ++i) {
+			const auto av = i % 2 == 0 ? pool[i] : static_cast<AV>((i * 37u + 11u) % kAVCount);
+			fixture.applied.emplace_back(av, 1.0f + static_cast<float>(i));
+		}
+		for (std::size_t i = 0; i < kAVCount; ++i) {
+			fixture.actor[i] = 50.0f + static_cast<float>(i % 7);
+		}
+		return fixture;
+	}
+
+	[[nodiscard]] MapTotals SyncUnordered(const Fixture& fixture, const MapTotals& currentApplied)
+	{
+		MapTotals derived;
+		for (const auto& part : fixture.parts) {
+			derived[part.av] += part.delta;
+		}
+		std::vector<std::pair<AV, float>> desiredList;
+		desiredList.reserve(derived.size());
+		for (const auto& [av, total] : derived) {
+			if (std::abs(total) > kEpsilon) {
+				desiredList.emplace_back(av, total);
+			}
+		}
+		std::sort(desiredList.begin(), desiredList.end(), [](const auto& lhs, const auto& rhs) {
+			return static_cast<std::uint32_t>(lhs.first) < static_cast<std::uint32_t>(rhs.first);
+		});
+
+		MapTotals desired;
+		for (const auto& [av, total] : desiredList) {
+			desired.emplace(av, total);
+		}
+		auto nextApplied = currentApplied;
+		std::unordered_set<AV, AVHash> actorValues;
+		for (const auto& [av, _] : currentApplied) {
+			actorValues.insert(av);
+		}
+		for (const auto& [av, _] : desired) {
+			actorValues.insert(av);
+		}
+		for (const auto av : actorValues) {
+			const float currentTotal = currentApplied.contains(av) ? currentApplied.at(av) : 0.0f;
+			const float desiredTotal = desired.contains(av) ? desired[av] : 0.0f;
+			const float delta = ClampDelta(av, fixture.actor[static_cast<std::size_t>(av)], desiredTotal - currentTotal);
+			if (std::abs(delta) <= kEpsilon) {
+				if (std::abs(currentTotal) <= kEpsilon) {
+					nextApplied.erase(av);
+				}
+				continue;
+			}
+			const float appliedTotal = currentTotal + delta;
+			if (std::abs(appliedTotal) <= kEpsilon) {
+				nextApplied.erase(av);
+			} else {
+				nextApplied[av] = appliedTotal;
+			}
+		}
+		return nextApplied;
+	}
+
+	[[nodiscard]] DenseTotals SyncDense(const Fixture& fixture, const DenseTotals& currentApplied)
+	{
+		DenseTotals desired;
+		for (const auto& part : fixture.parts) {
+			desired.Accumulate(part.av, part.delta);
+		}
+		(void)desired.Prune(kEpsilon);
+
+		auto       nextApplied = currentApplied;
+		const auto deltas = DenseTotals::Difference(desired, currentApplied);
+		for (const auto& [av, desiredDelta] : deltas) {
+			const float delta = ClampDelta(av, fixture.actor[static_cast<std::size_t>(av)], desiredDelta);
+			if (std::abs(delta) <= kEpsilon) {
+				continue;
+			}
+			nextApplied.insert_or_assign(av, currentApplied.Value(av) + delta);
+		}
+		(void)nextApplied.Prune(kEpsilon);
+		return nextApplied;
+	}
+
+	void Run(std::size_t partCount, std::uint32_t distinctAVs)
+	{
+		const auto fixture = MakeFixture(partCount, distinctAVs);
+
+		MapTotals   mapApplied;
+		DenseTotals denseApplied;
+		for (const auto& [av, total] : fixture.applied) {
+			mapApplied.insert_or_assign(av, total);
+			denseApplied.insert_or_assign(av, total);
+		}
+
+		char        label[96];
+		std::size_t mapSize = 0;
+		std::snprintf(label, sizeof(label), "unordered derive->diff->clamp (%u AVs)", distinctAVs);
+		Bench::Report(label, partCount, Bench::Measure(2000, [&]() {
+			const auto next = SyncUnordered(fixture, mapApplied);
+			mapSize = next.size();
+			Bench::DoNotOptimize(mapSize);
+		}));
+
+		std::size_t denseSize = 0;
+		std::snprintf(label, sizeof(label), "dense derive->diff->clamp (%u AVs)", distinctAVs);
+		Bench::Report(label, partCount, Bench::Measure(2000, [&]() {
+			const auto next = SyncDense(fixture, denseApplied);
+			denseSize = next.size();
+			Bench::DoNotOptimize(denseSize);
+		}));
+
+		if (mapSize != denseSize) {
+			std::printf("MISMATCH: unordered kept %zu entries, dense kept %zu\n", mapSize, denseSize);
+		}
+	}
+}
+
+int main()
+{
+	// A full seven-slot build resolves to ~20 parts over ~12 AVs; the larger sizes stress the merge.
+	Run(20, 12);
+	Run(64, 32);
+	Run(256, 96);
+	return 0;
+}
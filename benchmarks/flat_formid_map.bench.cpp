@@ -0,0 +1,117 @@
+// Insert, lookup (hit and miss) and snapshot-copy cost of the flat form id containers against the
+// std::unordered_set/map they replace in RuntimeState, at realistic-to-large registration counts.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	using CodexOfPowerNG::Containers::FlatFormIdMap;
+	using CodexOfPowerNG::Containers::FlatFormIdSet;
+
+	// Ids spread over a few load-order bytes, like a modded registration list.
+	[[nodiscard]] std::vector<std::uint32_t> MakeIds(std::size_t n, Bench::Rng& rng)
+	{
+		std::unordered_set<std::uint32_t> seen;
+		std::vector<std::uint32_t>        ids;
+		ids.reserve(n);
+		while (ids.size() < n) {
+			const auto id = (rng.Below(0x30) << 24) | rng.Below(0x100000);
+			if (seen.insert(id).second) {
+				ids.push_back(id);
+			}
+		}
+		return ids;
+	}
+
+	template <class Map>
+	void Insert(Map& map, std::uint32_t id, std::uint32_t group)
+	{
+		map.emplace(id, group);
+	}
+
+	template <class Set>
+	void InsertKey(Set& set, std::uint32_t id)
+	{
+		set.insert(id);
+	}
+
+	template <class Map, class Set>
+	void RunPair(const char* name, const std::vector<std::uint32_t>& ids, const std::vector<std::uint32_t>& misses)
+	{
+		const auto n = ids.size();
+		const auto label = [&](const char* op) { return std::string(name) + " " + op; };
+
+		Bench::Report(label("map insert").c_str(), n, Bench::Measure(10, [&]() {
+			Map map;
+			for (std::size_t i = 0; i < n; ++i) {
+				Insert(map, ids[i], static_cast<std::uint32_t>(i % 6));
+			}
+			Bench::DoNotOptimize(map.size());
+		}));
+
+		Map map;
+		Set set;
+		for (std::size_t i = 0; i < n; ++i) {
+			Insert(map, ids[i], static_cast<std::uint32_t>(i % 6));
+			InsertKey(set, ids[i]);
+		}
+
+		Bench::Report(label("map lookup hit").c_str(), n, Bench::Measure(20, [&]() {
+			std::size_t found = 0;
+			for (const auto id : ids) {
+				found += map.contains(id) ? 1u : 0u;
+			}
+			Bench::DoNotOptimize(found);
+		}));
+
+		Bench::Report(label("set lookup miss").c_str(), n, Bench::Measure(20, [&]() {
+			std::size_t found = 0;
+			for (const auto id : misses) {
+				found += set.contains(id) ? 1u : 0u;
+			}
+			Bench::DoNotOptimize(found);
+		}));
+
+		// What SnapshotState() pays per save: one copy of the map and one of the set.
+		Bench::Report(label("snapshot copy").c_str(), n, Bench::Measure(20, [&]() {
+			Map mapCopy = map;
+			Set setCopy = set;
+			Bench::DoNotOptimize(mapCopy.size() + setCopy.size());
+		}));
+
+		Bench::Report(label("iterate map").c_str(), n, Bench::Measure(20, [&]() {
+			std::uint64_t sum = 0;
+			for (const auto& [id, group] : map) {
+				sum += id + group;
+			}
+			Bench::DoNotOptimize(sum);
+		}));
+	}
+}
+
+int main()
+{
+	for (const std::size_t n : { 10000u, 30000u, 100000u }) {
+		Bench::Rng rng;
+		const auto ids = MakeIds(n, rng);
+		auto       misses = MakeIds(n, rng);
+		for (auto& id : misses) {
+			id |= 0x80000000u;  // outside the 0x00-0x2F load-order bytes used for hits
+		}
+
+		RunPair<std::unordered_map<std::uint32_t, std::uint32_t>, std::unordered_set<std::uint32_t>>("unordered", ids, misses);
+		RunPair<FlatFormIdMap<std::uint32_t>, FlatFormIdSet>("flat", ids, misses);
+		std::printf("\n");
+	}
+	return 0;
+}
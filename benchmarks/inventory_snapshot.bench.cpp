@@ -0,0 +1,152 @@
+// Quick-list inventory pass over synthetic inventories of growing size: the previous per-entry
+// count walk (GetItemCount re-walks the whole container for one object) versus one counting pass
+// plus one entry walk into the shared snapshot. Per-entry cost stays flat only for the snapshot.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/InventorySnapshot.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+
+	inline constexpr std::array<std::size_t, 7> kSizes{ 100, 200, 400, 800, 1600, 3200, 6400 };
+
+	struct FakeObject
+	{
+		std::uint32_t id{ 0 };
+	};
+
+	struct FakeEntry
+	{
+		FakeObject*               object{ nullptr };
+		std::int32_t              countDelta{ 0 };
+		std::vector<std::int32_t> extraCounts;  // stacks with extra data; the first one is "worn"
+	};
+
+	struct Removal
+	{
+		std::int32_t safeCount{ 0 };
+	};
+
+	struct Inventory
+	{
+		std::vector<std::pair<FakeObject*, std::int32_t>> baseContainer;
+		std::vector<FakeEntry>                            entries;
+
+		// Same shape as TESObjectREFR::GetInventoryCounts: base container plus change deltas,
+		// filtered to the objects the caller asks for.
+		template <class Filter>
+		[[nodiscard]] std::map<FakeObject*, std::int32_t> Counts(Filter&& filter) const
+		{
+			std::map<FakeObject*, std::int32_t> counts;
+			for (const auto& [object, count] : baseContainer) {
+				if (filter(*object)) {
+					counts[object] += count;
+				}
+			}
+			for (const auto& entry : entries) {
+				if (filter(*entry.object)) {
+					counts[entry.object] += entry.countDelta;
+				}
+			}
+			return counts;
+		}
+
+		[[nodiscard]] std::int32_t ItemCount(const FakeObject* object) const
+		{
+			const auto counts = Counts([object](const FakeObject& candidate) { return &candidate == object; });
+			return counts.empty() ? 0 : counts.begin()->second;
+		}
+	};
+
+	[[nodiscard]] Removal SelectRemoval(const FakeEntry& entry, std::int32_t totalCount) noexcept
+	{
+		Removal out{};
+		std::int32_t extraTotal = 0;
+		for (std::size_t i = 0; i < entry.extraCounts.size(); ++i) {
+			extraTotal += entry.extraCounts[i];
+			if (i != 0) {
+				out.safeCount += entry.extraCounts[i];
+			}
+		}
+		if (totalCount > extraTotal) {
+			out.safeCount += totalCount - extraTotal;
+		}
+		return out;
+	}
+
+	[[nodiscard]] Inventory MakeInventory(std::vector<FakeObject>& objects, std::size_t size, Bench::Rng& rng)
+	{
+		Inventory inventory;
+		objects.assign(size, {});
+		for (std::size_t i = 0; i < size; ++i) {
+			objects[i].id = 0x01000000u + static_cast<std::uint32_t>(i);
+			if (i % 8 == 0) {
+				inventory.baseContainer.emplace_back(&objects[i], 1 + static_cast<std::int32_t>(rng.Below(3)));
+			}
+			FakeEntry entry{};
+			entry.object = &objects[i];
+			entry.countDelta = 1 + static_cast<std::int32_t>(rng.Below(5));
+			if (rng.Below(4) == 0) {
+				entry.extraCounts = { 1, 1 };
+			}
+			inventory.entries.push_back(std::move(entry));
+		}
+		return inventory;
+	}
+}
+
+int main()
+{
+	Bench::Rng rng;
+	std::uint64_t sink = 0;
+
+	for (const auto size : kSizes) {
+		std::vector<FakeObject> objects;
+		const auto inventory = MakeInventory(objects, size, rng);
+		const auto iterations = size <= 800 ? 30u : 5u;
+
+		const auto perEntry = Bench::Measure(iterations, [&]() {
+			for (const auto& entry : inventory.entries) {
+				const auto totalCount = inventory.ItemCount(entry.object);
+				sink += static_cast<std::uint64_t>(SelectRemoval(entry, totalCount).safeCount);
+			}
+			Bench::DoNotOptimize(sink);
+		});
+
+		const auto snapshot = Bench::Measure(iterations, [&]() {
+			CodexOfPowerNG::Inventory::Snapshot<const FakeEntry, Removal> built;
+			const auto counts = inventory.Counts([](const FakeObject&) { return true; });
+			built.Reserve(counts.size());
+			for (const auto& [object, count] : counts) {
+				built.AddCount(object->id, count);
+			}
+			for (const auto& entry : inventory.entries) {
+				built.AttachEntry(entry.object->id, &entry);
+			}
+			built.SelectRemovals(SelectRemoval);
+			for (const auto& row : built.Rows()) {
+				sink += static_cast<std::uint64_t>(row.removal.safeCount);
+			}
+			Bench::DoNotOptimize(sink);
+		});
+
+		char label[64];
+		std::snprintf(label, sizeof(label), "GetItemCount per entry (%zu)", size);
+		Bench::Report(label, size, perEntry);
+		std::snprintf(label, sizeof(label), "one-pass snapshot (%zu)", size);
+		Bench::Report(label, size, snapshot);
+		std::printf(
+			"  per entry: %.3f us vs %.3f us\n",
+			perEntry.medianUs / static_cast<double>(size),
+			snapshot.medianUs / static_cast<double>(size));
+	}
+	return 0;
+}
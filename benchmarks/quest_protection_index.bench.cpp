@@ -0,0 +1,147 @@
+// Quest protection against a synthetic quest/alias model: the old full rescan that rebuilt an
+// unordered_set every 2 s versus the incremental index (one quest event, one reconciliation slice,
+// one full pass spread over slices), plus the per-item lookup the quick list pays.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/RegistrationQuestProtectionIndex.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace QP = CodexOfPowerNG::Registration::QuestProtection;
+
+	struct FakeQuest
+	{
+		std::uint32_t              id{ 0 };
+		bool                       running{ false };
+		std::vector<std::uint32_t> aliasForms{};
+	};
+
+	// Roughly a large load order: a quarter of the quests run, each holding a handful of aliases.
+	[[nodiscard]] std::vector<FakeQuest> MakeQuests(std::size_t n)
+	{
+		Bench::Rng rng;
+		std::vector<FakeQuest> quests(n);
+		for (std::uint32_t q = 0; q < n; ++q) {
+			auto& quest = quests[q];
+			quest.id = 0x00010000u + q;
+			quest.running = rng.Below(4) == 0;
+			const auto aliases = rng.Below(12);
+			for (std::uint32_t a = 0; a < aliases; ++a) {
+				quest.aliasForms.push_back(0x01000000u + rng.Below(static_cast<std::uint32_t>(n * 4)));
+			}
+		}
+		return quests;
+	}
+
+	[[nodiscard]] QP::QuestForms Collect(const FakeQuest& quest)
+	{
+		QP::QuestForms result{ quest.id, {} };
+		if (quest.running) {
+			result.forms = quest.aliasForms;
+		}
+		return result;
+	}
+
+	void Run(std::size_t n)
+	{
+		auto quests = MakeQuests(n);
+
+		std::unordered_set<std::uint32_t> rescanned;
+		Bench::Report("full rescan -> unordered_set", n, Bench::Measure(50, [&]() {
+			std::unordered_set<std::uint32_t> out;
+			for (const auto& quest : quests) {
+				if (!quest.running) {
+					continue;
+				}
+				for (const auto formId : quest.aliasForms) {
+					out.insert(formId);
+				}
+			}
+			rescanned = std::move(out);
+			Bench::DoNotOptimize(rescanned.size());
+		}));
+
+		QP::ProtectionIndex index;
+		const auto runPass = [&](std::size_t questsPerSlice) {
+			QP::BeginSweep(index);
+			for (;;) {
+				std::size_t visited = 0;
+				if (QP::SweepStep(
+						index,
+						quests.size(),
+						[&](std::size_t i) { return Collect(quests[i]); },
+						[&]() { return ++visited >= questsPerSlice; })) {
+					break;
+				}
+			}
+		};
+
+		runPass(quests.size());
+		Bench::Report("reconcile pass, 256 quests/slice", n, Bench::Measure(50, [&]() {
+			runPass(256);
+			Bench::DoNotOptimize(index.protectedForms.size());
+		}));
+		Bench::Report("  one 256-quest slice", 256, Bench::Measure(200, [&]() {
+			QP::BeginSweep(index);
+			std::size_t visited = 0;
+			Bench::DoNotOptimize(QP::SweepStep(
+				index,
+				quests.size(),
+				[&](std::size_t i) { return Collect(quests[i]); },
+				[&]() { return ++visited >= 256; }));
+		}));
+		runPass(quests.size());
+
+		// A quest starting or stopping touches only its own aliases.
+		std::size_t next = 0;
+		Bench::Report("quest start/stop event", n, Bench::Measure(2000, [&]() {
+			auto& quest = quests[next++ % quests.size()];
+			quest.running = !quest.running;
+			QP::SetQuestForms(index, quest.id, Collect(quest).forms);
+			Bench::DoNotOptimize(QP::TakeChanged(index));
+		}));
+
+		// Publishing to readers is a refcount bump on the shared table.
+		Bench::Report("publish snapshot", n, Bench::Measure(2000, [&]() {
+			const QP::ProtectedForms published = index.protectedForms;
+			Bench::DoNotOptimize(published.size());
+		}));
+
+		std::vector<std::uint32_t> probes;
+		Bench::Rng rng;
+		for (std::size_t i = 0; i < 4096; ++i) {
+			probes.push_back(0x01000000u + rng.Below(static_cast<std::uint32_t>(n * 4)));
+		}
+		Bench::Report("4096 lookups, unordered_set", n, Bench::Measure(200, [&]() {
+			std::size_t hits = 0;
+			for (const auto formId : probes) {
+				hits += rescanned.contains(formId) ? 1u : 0u;
+			}
+			Bench::DoNotOptimize(hits);
+		}));
+		Bench::Report("4096 lookups, flat index", n, Bench::Measure(200, [&]() {
+			std::size_t hits = 0;
+			for (const auto formId : probes) {
+				hits += index.protectedForms.contains(formId) ? 1u : 0u;
+			}
+			Bench::DoNotOptimize(hits);
+		}));
+	}
+}
+
+int main()
+{
+	for (const std::size_t n : { 3000u, 6000u }) {
+		Run(n);
+		std::printf("\n");
+	}
+	return 0;
+}
@@ -0,0 +1,185 @@
+// Loot-event classification for a looted item over a 100k-form "game": the three independent
+// lookups the sink used to make (IsDiscoverable, IsRegistered, GetRegisterKeyId), the single
+// uncached pass, and the memoised classification (blocked/registered still checked per call).
+// Name-based intrinsic exclusion uses the real substring rules.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+#include "CodexOfPowerNG/RegistrationClassCache.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace CC = CodexOfPowerNG::Registration::ClassCache;
+	using CodexOfPowerNG::Containers::FlatFormIdMap;
+	using CodexOfPowerNG::Containers::FlatFormIdSet;
+
+	inline constexpr std::uint32_t kForms = 100000;
+	inline constexpr std::uint32_t kUnknownGroup = 255;
+	inline constexpr std::size_t   kEvents = 4096;
+
+	struct FakeForm
+	{
+		std::uint32_t id{ 0 };
+		std::uint32_t formType{ 0 };
+		std::string   name;
+		bool          isKey{ false };
+	};
+
+	struct World
+	{
+		std::unordered_map<std::uint32_t, FakeForm*> forms;  // stand-in for TESForm::LookupByID
+		FlatFormIdMap<FakeForm*>                      registerKeys;
+		FlatFormIdSet                                 excluded;
+		FlatFormIdSet                                 blocked;
+		FlatFormIdSet                                 registered;
+
+		[[nodiscard]] FakeForm* Lookup(std::uint32_t id) const
+		{
+			const auto it = forms.find(id);
+			return it != forms.end() ? it->second : nullptr;
+		}
+
+		[[nodiscard]] FakeForm* RegisterKey(FakeForm* form) const
+		{
+			const auto it = registerKeys.find(form->id);
+			return it != registerKeys.end() ? it->second : form;
+		}
+	};
+
+	[[nodiscard]] bool IsDragonClawName(std::string_view name) noexcept
+	{
+		return name.find("Dragon Claw") != std::string_view::npos || name.find("dragon claw") != std::string_view::npos ||
+		       name.find("용발톱") != std::string_view::npos;
+	}
+
+	[[nodiscard]] bool IsStaticExcluded(const World& world, const FakeForm* form)
+	{
+		return world.excluded.contains(form->id) || form->isKey || IsDragonClawName(form->name);
+	}
+
+	[[nodiscard]] bool IsExcludedForm(const World& world, const FakeForm* form)
+	{
+		return IsStaticExcluded(world, form) || world.blocked.contains(form->id);
+	}
+
+	[[nodiscard]] std::uint32_t GroupFromFormType(std::uint32_t formType) noexcept
+	{
+		return formType < 6 ? formType : kUnknownGroup;
+	}
+
+	struct ItemClass
+	{
+		FakeForm*     form{ nullptr };
+		FakeForm*     regKey{ nullptr };
+		std::uint32_t group{ kUnknownGroup };
+		bool          staticExcluded{ true };
+	};
+
+	[[nodiscard]] ItemClass Classify(const World& world, FakeForm* form)
+	{
+		ItemClass itemClass{ form, world.RegisterKey(form), kUnknownGroup, true };
+		itemClass.staticExcluded =
+			IsStaticExcluded(world, form) || (itemClass.regKey != form && IsStaticExcluded(world, itemClass.regKey));
+		if (!itemClass.staticExcluded) {
+			itemClass.group = GroupFromFormType(itemClass.regKey->formType);
+		}
+		return itemClass;
+	}
+
+	[[nodiscard]] std::uint32_t LootKeyFrom(const World& world, const ItemClass& itemClass, std::uint32_t id)
+	{
+		if (!itemClass.regKey || itemClass.group > 5 || world.blocked.contains(id) ||
+			world.blocked.contains(itemClass.regKey->id)) {
+			return 0;
+		}
+		const auto regKeyId = itemClass.regKey->id;
+		return world.registered.contains(regKeyId) || world.registered.contains(id) ? 0 : regKeyId;
+	}
+}
+
+int main()
+{
+	Bench::Rng rng;
+	std::vector<FakeForm> storage(kForms);
+	World world;
+	world.forms.reserve(kForms);
+	for (std::uint32_t i = 0; i < kForms; ++i) {
+		auto& form = storage[i];
+		form.id = 0x01000000u + i;
+		form.formType = rng.Below(8);
+		form.name = "Generated Item Name " + std::to_string(i) + (i % 997 == 0 ? " Dragon Claw" : "");
+		form.isKey = i % 501 == 0;
+		world.forms.emplace(form.id, &form);
+	}
+	for (std::uint32_t i = 0; i < kForms / 10; ++i) {
+		world.registerKeys.emplace(storage[rng.Below(kForms)].id, &storage[rng.Below(kForms)]);
+		world.excluded.insert(storage[rng.Below(kForms)].id);
+		world.registered.insert(storage[rng.Below(kForms)].id);
+	}
+	for (std::uint32_t i = 0; i < 500; ++i) {
+		world.blocked.insert(storage[rng.Below(kForms)].id);
+	}
+
+	// Looting revisits a working set of a few hundred base objects.
+	std::vector<std::uint32_t> events(kEvents);
+	for (auto& id : events) {
+		id = storage[rng.Below(400) * 211u % kForms].id;
+	}
+
+	std::uint64_t sink = 0;
+	Bench::Report("three lookups per event (previous sink)", kEvents, Bench::Measure(50, [&]() {
+		for (const auto id : events) {
+			// IsDiscoverable
+			auto* form = world.Lookup(id);
+			auto* regKey = world.RegisterKey(form);
+			const bool excluded = IsExcludedForm(world, form) || (regKey != form && IsExcludedForm(world, regKey));
+			const bool discoverable =
+				!excluded && GroupFromFormType(IsExcludedForm(world, regKey) ? 99 : regKey->formType) <= 5;
+			// IsRegistered
+			auto* form2 = world.Lookup(id);
+			auto* regKey2 = world.RegisterKey(form2);
+			const bool registered = world.registered.contains(regKey2->id) || world.registered.contains(id);
+			// GetRegisterKeyId
+			auto* form3 = world.Lookup(id);
+			const auto regKeyId = world.RegisterKey(form3)->id;
+			sink += discoverable && !registered ? regKeyId : 0;
+		}
+		Bench::DoNotOptimize(sink);
+	}));
+
+	Bench::Report("single uncached pass", kEvents, Bench::Measure(50, [&]() {
+		for (const auto id : events) {
+			sink += LootKeyFrom(world, Classify(world, world.Lookup(id)), id);
+		}
+		Bench::DoNotOptimize(sink);
+	}));
+
+	CC::GenerationalFormCache<ItemClass> cache;
+	Bench::Report("memoised classification", kEvents, Bench::Measure(50, [&]() {
+		for (const auto id : events) {
+			const auto itemClass = cache.GetOrCompute(id, 1, [&]() -> std::optional<ItemClass> {
+				auto* form = world.Lookup(id);
+				if (!form) {
+					return std::nullopt;
+				}
+				return Classify(world, form);
+			});
+			sink += itemClass ? LootKeyFrom(world, *itemClass, id) : 0;
+		}
+		Bench::DoNotOptimize(sink);
+	}));
+
+	const auto stats = cache.GetStats();
+	std::printf("cache: %zu entries, hit rate %.1f%%\n", stats.size, stats.HitRate() * 100.0);
+	return 0;
+}
@@ -0,0 +1,202 @@
+// Multi-threaded stress of the loot-event query mix (IsBlocked x2, IsRegisteredEither, notified
+// ContainsAny) against the std::mutex + unordered_set state it replaces and the RCU snapshot,
+// while one writer registers/unregisters items at a fixed rate.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/RcuCell.h"
+#include "CodexOfPowerNG/RegistrationLookupSnapshot.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace Lookup = CodexOfPowerNG::RegistrationLookup;
+	using CodexOfPowerNG::RcuCell;
+
+	constexpr std::uint32_t kRegistered = 4000;
+	constexpr std::uint32_t kBlocked = 300;
+	constexpr std::uint32_t kNotified = 6000;
+	constexpr std::uint32_t kIdSpace = 20000;
+	constexpr auto          kRunTime = std::chrono::milliseconds(300);
+
+	struct MutexState
+	{
+		std::mutex                                        mutex;
+		std::unordered_map<std::uint32_t, std::uint32_t>  registered;
+		std::unordered_set<std::uint32_t>                 blocked;
+		std::unordered_set<std::uint32_t>                 notified;
+	};
+
+	class MutexPath
+	{
+	public:
+		explicit MutexPath(MutexState& state) : _state(state) {}
+
+		[[nodiscard]] bool Query(std::uint32_t item, std::uint32_t regKey)
+		{
+			{
+				std::scoped_lock lock(_state.mutex);
+				if (_state.blocked.contains(item)) {
+					return false;
+				}
+			}
+			{
+				std::scoped_lock lock(_state.mutex);
+				if (_state.blocked.contains(regKey)) {
+					return false;
+				}
+			}
+			{
+				std::scoped_lock lock(_state.mutex);
+				if (_state.registered.contains(regKey) || _state.registered.contains(item)) {
+					return false;
+				}
+			}
+			std::scoped_lock lock(_state.mutex);
+			return !_state.notified.contains(regKey) && !_state.notified.contains(item);
+		}
+
+		void Toggle(std::uint32_t id)
+		{
+			std::scoped_lock lock(_state.mutex);
+			if (_state.registered.erase(id) == 0) {
+				_state.registered.emplace(id, 0u);
+			}
+		}
+
+	private:
+		MutexState& _state;
+	};
+
+	class RcuPath
+	{
+	public:
+		explicit RcuPath(MutexState& state) : _state(state)
+		{
+			auto initial = std::make_unique<Lookup::Snapshot>();
+			initial->registered = Lookup::Share(Lookup::SortedIds(state.registered, [](const auto& e) { return e.first; }));
+			initial->blocked = Lookup::Share(Lookup::SortedIds(state.blocked));
+			initial->notified = Lookup::Share(Lookup::SortedIds(state.notified));
+			_cell.Publish(std::move(initial));
+		}
+
+		[[nodiscard]] bool Query(std::uint32_t item, std::uint32_t regKey)
+		{
+			if (Lookup::Contains(*_cell.Read()->blocked, item) || Lookup::Contains(*_cell.Read()->blocked, regKey)) {
+				return false;
+			}
+			if (Lookup::ContainsAny(*_cell.Read()->registered, regKey, item)) {
+				return false;
+			}
+			return !Lookup::ContainsAny(*_cell.Read()->notified, regKey, item);
+		}
+
+		// Mirrors the store: mutate under the state mutex, then publish the edited snapshot.
+		void Toggle(std::uint32_t id)
+		{
+			std::scoped_lock lock(_state.mutex);
+			auto next = _cell.CloneCurrent();
+			if (_state.registered.erase(id) == 0) {
+				_state.registered.emplace(id, 0u);
+				Lookup::Rewrite(next->registered, [id](Lookup::FormIdList& ids) { Lookup::Insert(ids, id); });
+			} else {
+				Lookup::Rewrite(next->registered, [id](Lookup::FormIdList& ids) { Lookup::Erase(ids, id); });
+			}
+			++next->version;
+			_cell.Publish(std::move(next));
+		}
+
+	private:
+		MutexState&              _state;
+		RcuCell<Lookup::Snapshot> _cell;
+	};
+
+	void Seed(MutexState& state)
+	{
+		Bench::Rng rng;
+		while (state.registered.size() < kRegistered) {
+			state.registered.emplace(1 + rng.Below(kIdSpace), 0u);
+		}
+		while (state.blocked.size() < kBlocked) {
+			state.blocked.insert(1 + rng.Below(kIdSpace));
+		}
+		while (state.notified.size() < kNotified) {
+			state.notified.insert(1 + rng.Below(kIdSpace));
+		}
+	}
+
+	template <class Path>
+	void Run(const char* label, unsigned readers, std::chrono::microseconds writeEvery)
+	{
+		MutexState state;
+		Seed(state);
+		Path path(state);
+
+		std::atomic_bool          stop{ false };
+		std::atomic<std::uint64_t> queries{ 0 };
+		std::vector<std::thread>  threads;
+		for (unsigned t = 0; t < readers; ++t) {
+			threads.emplace_back([&, t]() {
+				Bench::Rng    rng{ 0x9E3779B97F4A7C15ull + t };
+				std::uint64_t local = 0;
+				std::uint64_t hits = 0;
+				while (!stop.load(std::memory_order_relaxed)) {
+					for (int i = 0; i < 256; ++i) {
+						const auto item = 1 + rng.Below(kIdSpace);
+						hits += path.Query(item, (item & ~0xFu) + 1) ? 1u : 0u;
+					}
+					local += 256;
+				}
+				Bench::DoNotOptimize(hits);
+				queries.fetch_add(local, std::memory_order_relaxed);
+			});
+		}
+
+		std::uint64_t writes = 0;
+		Bench::Rng    rng{ 42 };
+		const auto    start = std::chrono::steady_clock::now();
+		while (std::chrono::steady_clock::now() - start < kRunTime) {
+			path.Toggle(1 + rng.Below(kIdSpace));
+			++writes;
+			std::this_thread::sleep_for(writeEvery);
+		}
+		stop.store(true);
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		const auto total = static_cast<double>(queries.load());
+		std::printf(
+			"%-28s readers=%u write every %5lldus  %8.2f M queries/s  %8.1f ns/query/thread  (%llu writes)\n",
+			label,
+			readers,
+			static_cast<long long>(writeEvery.count()),
+			total / seconds / 1e6,
+			seconds * 1e9 * readers / (total > 0 ? total : 1),
+			static_cast<unsigned long long>(writes));
+	}
+}
+
+int main()
+{
+	std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+	for (const unsigned readers : { 1u, 2u, 4u }) {
+		for (const auto writeEvery : { std::chrono::microseconds(100), std::chrono::microseconds(5000) }) {
+			Run<MutexPath>("mutex + unordered_set", readers, writeEvery);
+			Run<RcuPath>("rcu snapshot", readers, writeEvery);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,252 @@
+// Startup cost of the exclude/variant maps with generated files (60k exclude entries over
+// exclude_map.json + 4 patches, 10k variant mappings): the old DOM parse, the streaming SAX
+// fallback that also writes the cache (cold), and a validated cache read (warm).
+//
+// The parsers need nlohmann/json on the include path, e.g.
+//   CPLUS_INCLUDE_PATH=/path/to/nlohmann/include scripts/bench.sh registration_maps_cache
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/RegistrationMapsCache.h"
+
+#if __has_include(<nlohmann/json.hpp>)
+#	include "CodexOfPowerNG/RegistrationMapsSax.h"
+#	define COPNG_BENCH_MAPS_JSON 1
+#endif
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace Cache = CodexOfPowerNG::RegistrationMaps::Cache;
+	namespace fs = std::filesystem;
+
+	inline constexpr std::uint32_t kPluginCount = 200;
+	inline constexpr std::uint32_t kExcludeEntries = 40000;
+	inline constexpr std::uint32_t kPatchFiles = 4;
+	inline constexpr std::uint32_t kPatchEntries = 5000;
+	inline constexpr std::uint32_t kVariantEntries = 10000;
+
+	[[nodiscard]] std::string PluginName(std::uint32_t index)
+	{
+		return "Plugin" + std::to_string(index) + ".esp";
+	}
+
+	[[nodiscard]] std::string HexId(std::uint32_t id)
+	{
+		char buffer[16];
+		std::snprintf(buffer, sizeof(buffer), "0x%08X", id);
+		return buffer;
+	}
+
+	void WriteExclude(const fs::path& path, std::uint32_t count, Bench::Rng& rng)
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out << "{\n  \"version\": 1,\n  \"forms\": [\n";
+		for (std::uint32_t i = 0; i < count; ++i) {
+			out << "    { \"file\": \"" << PluginName(rng.Below(kPluginCount)) << "\", \"id\": \""
+				<< HexId(0x800u + rng.Below(0xFFFFF)) << "\" }" << (i + 1 < count ? ",\n" : "\n");
+		}
+		out << "  ]\n}\n";
+	}
+
+	void WriteVariants(const fs::path& path, Bench::Rng& rng)
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out << "{\n  \"mappings\": [\n";
+		for (std::uint32_t i = 0; i < kVariantEntries; ++i) {
+			out << "    { \"variant\": { \"file\": \"" << PluginName(rng.Below(kPluginCount)) << "\", \"id\": \""
+				<< HexId(0x800u + rng.Below(0xFFFFF)) << "\" }, \"base\": { \"file\": \"Skyrim.esm\", \"id\": \""
+				<< HexId(0x800u + rng.Below(0xFFFFF)) << "\" } }" << (i + 1 < kVariantEntries ? ",\n" : "\n");
+		}
+		out << "  ]\n}\n";
+	}
+
+	// Stand-in for TESDataHandler::LookupForm: plugin name -> load index, id must parse.
+	struct Resolver
+	{
+		std::unordered_map<std::string, std::uint32_t> loadIndex;
+
+		[[nodiscard]] std::optional<std::uint32_t> operator()(std::string_view file, std::string_view idText) const
+		{
+			const auto it = loadIndex.find(std::string(file));
+			if (it == loadIndex.end() || idText.size() < 3) {
+				return std::nullopt;
+			}
+			std::uint32_t raw = 0;
+			const auto [ptr, ec] = std::from_chars(idText.data() + 2, idText.data() + idText.size(), raw, 16);
+			if (ec != std::errc{} || ptr != idText.data() + idText.size()) {
+				return std::nullopt;
+			}
+			return (it->second << 24) | (raw & 0x00FFFFFFu);
+		}
+	};
+
+	[[nodiscard]] std::string ReadAll(const fs::path& path)
+	{
+		std::ifstream in(path, std::ios::binary | std::ios::ate);
+		std::string bytes(static_cast<std::size_t>(in.tellg()), '\0');
+		in.seekg(0);
+		in.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+		return bytes;
+	}
+
+	[[nodiscard]] Cache::SourceStamp StampOf(const fs::path& path)
+	{
+		std::error_code ec;
+		if (!fs::exists(path, ec)) {
+			return { path.generic_string(), false, 0, 0 };
+		}
+		return { path.generic_string(), true, fs::file_size(path), fs::last_write_time(path).time_since_epoch().count() };
+	}
+
+	[[nodiscard]] Cache::Key CollectKey(const std::vector<fs::path>& sources, std::uint64_t loadOrder)
+	{
+		Cache::Key key{ loadOrder, {} };
+		for (const auto& path : sources) {
+			key.sources.push_back(StampOf(path));
+		}
+		return key;
+	}
+}
+
+int main()
+{
+	const auto dir = fs::temp_directory_path() / "copng_maps_bench";
+	fs::create_directories(dir);
+
+	Bench::Rng rng;
+	std::vector<fs::path> excludeFiles{ dir / "exclude_map.json" };
+	WriteExclude(excludeFiles.back(), kExcludeEntries, rng);
+	for (std::uint32_t i = 1; i <= kPatchFiles; ++i) {
+		char name[64];
+		std::snprintf(name, sizeof(name), "exclude_patch_%02u.json", i);
+		excludeFiles.push_back(dir / name);
+		WriteExclude(excludeFiles.back(), kPatchEntries, rng);
+	}
+	const auto variantFile = dir / "variant_map.json";
+	WriteVariants(variantFile, rng);
+	const auto cacheFile = dir / "maps.cache";
+
+	Resolver resolve;
+	resolve.loadIndex.emplace("Skyrim.esm", 0u);
+	for (std::uint32_t i = 0; i < kPluginCount; ++i) {
+		resolve.loadIndex.emplace(PluginName(i), 5u + i % 0xF0u);
+	}
+	const std::uint64_t loadOrder = Cache::Fnv1a64("Skyrim.esm|Plugin0.esp|...");
+
+	auto sources = excludeFiles;
+	sources.push_back(dir / "exclude_patch_05.json");  // first missing patch slot
+	sources.push_back(variantFile);
+
+	std::size_t sourceBytes = 0;
+	for (const auto& path : excludeFiles) {
+		sourceBytes += fs::file_size(path);
+	}
+	sourceBytes += fs::file_size(variantFile);
+	std::printf("sources: %zu files, %.1f MB\n", excludeFiles.size() + 1, static_cast<double>(sourceBytes) / 1e6);
+
+#ifdef COPNG_BENCH_MAPS_JSON
+	namespace Sax = CodexOfPowerNG::RegistrationMaps::Sax;
+
+	Cache::Tables expected;
+	Bench::Report("cold: DOM parse (previous loader)", kExcludeEntries, Bench::Measure(5, [&]() {
+		Cache::Tables tables;
+		for (const auto& path : excludeFiles) {
+			std::ifstream in(path, std::ios::binary);
+			nlohmann::json j;
+			in >> j;
+			for (const auto& entry : j["forms"]) {
+				if (auto id = resolve(entry["file"].get<std::string>(), entry["id"].get<std::string>())) {
+					tables.excluded.insert(*id);
+				}
+			}
+		}
+		std::ifstream in(variantFile, std::ios::binary);
+		nlohmann::json j;
+		in >> j;
+		for (const auto& entry : j["mappings"]) {
+			const auto& v = entry["variant"];
+			const auto& b = entry["base"];
+			auto variant = resolve(v["file"].get<std::string>(), v["id"].get<std::string>());
+			auto base = resolve(b["file"].get<std::string>(), b["id"].get<std::string>());
+			if (variant && base && *variant != *base) {
+				tables.variantBase.emplace(*variant, *base);
+			}
+		}
+		expected = tables;
+	}));
+
+	Cache::Tables cold;
+	Bench::Report("cold: SAX parse + write cache", kExcludeEntries, Bench::Measure(5, [&]() {
+		Cache::Tables tables;
+		for (const auto& path : excludeFiles) {
+			const auto text = ReadAll(path);
+			(void)Sax::ParseExcludeEntries(text, [&](const Sax::FormRef& entry) {
+				if (auto id = resolve(entry.file, entry.id)) {
+					tables.excluded.insert(*id);
+				}
+			});
+		}
+		const auto text = ReadAll(variantFile);
+		(void)Sax::ParseVariantEntries(text, [&](const Sax::FormRef& variant, const Sax::FormRef& base) {
+			auto variantId = resolve(variant.file, variant.id);
+			auto baseId = resolve(base.file, base.id);
+			if (variantId && baseId && *variantId != *baseId) {
+				tables.variantBase.emplace(*variantId, *baseId);
+			}
+		});
+		const auto bytes = Cache::Encode(CollectKey(sources, loadOrder), tables);
+		std::ofstream out(cacheFile, std::ios::binary | std::ios::trunc);
+		out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+		cold = tables;
+	}));
+	if (!(cold.excluded == expected.excluded) || !(cold.variantBase == expected.variantBase)) {
+		std::printf("mismatch between DOM and SAX loaders\n");
+		return 1;
+	}
+#else
+	std::printf("nlohmann/json not on the include path; cold parse timings skipped\n");
+	Cache::Tables cold;
+	for (std::uint32_t i = 0; i < kExcludeEntries + kPatchFiles * kPatchEntries; ++i) {
+		cold.excluded.insert(0x05000000u + rng.Below(0x0FFFFFFFu));
+	}
+	for (std::uint32_t i = 0; i < kVariantEntries; ++i) {
+		cold.variantBase.emplace(0x06000000u + i, 0x00000800u + i);
+	}
+	{
+		const auto bytes = Cache::Encode(CollectKey(sources, loadOrder), cold);
+		std::ofstream out(cacheFile, std::ios::binary | std::ios::trunc);
+		out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+#endif
+
+	std::printf("cache: %.1f KB\n", static_cast<double>(fs::file_size(cacheFile)) / 1e3);
+
+	std::size_t warmForms = 0;
+	Bench::Report("warm: stamp sources + read + decode cache", cold.excluded.size(), Bench::Measure(20, [&]() {
+		const auto bytes = ReadAll(cacheFile);
+		const auto tables = Cache::Decode(std::span<const char>(bytes.data(), bytes.size()), CollectKey(sources, loadOrder));
+		warmForms = tables ? tables->excluded.size() + tables->variantBase.size() : 0;
+		Bench::DoNotOptimize(warmForms);
+	}));
+	if (warmForms != cold.excluded.size() + cold.variantBase.size()) {
+		std::printf("cache did not validate\n");
+		return 1;
+	}
+
+	std::error_code ec;
+	fs::remove_all(dir, ec);
+	return 0;
+}
@@ -0,0 +1,215 @@
+// Replays synthetic inventory add/remove streams against the incremental quick-list index and
+// compares each page request with the full rescan + sort path it replaces.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/RegistrationQuickListIndex.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace Index = CodexOfPowerNG::Registration::QuickListIndex;
+
+	struct Row
+	{
+		std::uint32_t formId{ 0 };
+		std::uint32_t regKey{ 0 };
+		std::uint32_t group{ 0 };
+		std::int32_t  totalCount{ 0 };
+		std::string   name{};
+	};
+
+	struct FakeForm
+	{
+		std::uint32_t formId{ 0 };
+		std::uint32_t regKey{ 0 };
+		std::uint32_t group{ 0 };
+		std::string   name{};
+	};
+
+	struct FakeEntry
+	{
+		const FakeForm* form{ nullptr };
+		std::int32_t    count{ 0 };
+	};
+
+	// Stand-in for InventoryChanges::entryList plus the per-entry rule evaluation.
+	struct FakeInventory
+	{
+		std::vector<FakeForm>              forms{};
+		std::vector<FakeEntry>             entries{};
+		std::unordered_set<std::uint32_t>  registered{};
+
+		[[nodiscard]] std::optional<Row> Evaluate(const FakeEntry& entry) const
+		{
+			const auto& form = *entry.form;
+			if (entry.count <= 0 || registered.contains(form.regKey) || registered.contains(form.formId)) {
+				return std::nullopt;
+			}
+			return Row{ form.formId, form.regKey, form.group, entry.count, form.name };
+		}
+	};
+
+	[[nodiscard]] FakeInventory MakeInventory(std::size_t n, Bench::Rng& rng)
+	{
+		static constexpr const char* kWords[] = { "Iron", "Steel", "Elven", "Glass", "Ebony", "Daedric", "Orcish", "Dwarven" };
+		static constexpr const char* kKinds[] = { "Sword", "Dagger", "Helmet", "Boots", "Potion", "Ring", "Scroll", "Ingot" };
+
+		FakeInventory inv;
+		inv.forms.reserve(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			FakeForm form{};
+			form.formId = 0x01000000u + static_cast<std::uint32_t>(i);
+			// Every eighth form is an enchanted variant that normalizes to its neighbour.
+			form.regKey = (i % 8 == 7) ? form.formId - 1 : form.formId;
+			form.group = rng.Below(6);
+			form.name = std::string(kWords[rng.Below(8)]) + " " + kKinds[rng.Below(8)] + " " + std::to_string(i);
+			inv.forms.push_back(std::move(form));
+		}
+
+		inv.entries.reserve(n);
+		for (const auto& form : inv.forms) {
+			inv.entries.push_back(FakeEntry{ &form, static_cast<std::int32_t>(1 + rng.Below(4)) });
+		}
+		for (std::size_t i = 0; i < n / 10; ++i) {
+			inv.registered.insert(inv.forms[rng.Below(static_cast<std::uint32_t>(n))].regKey);
+		}
+		return inv;
+	}
+
+	// The pre-index path: evaluate every entry, dedupe by regKey, sort by (group, name).
+	[[nodiscard]] std::vector<Row> FullRescan(const FakeInventory& inv)
+	{
+		std::vector<Row>                  rows;
+		std::unordered_set<std::uint32_t> seenRegKeys;
+		for (const auto& entry : inv.entries) {
+			auto row = inv.Evaluate(entry);
+			if (!row || !seenRegKeys.insert(row->regKey).second) {
+				continue;
+			}
+			rows.push_back(std::move(*row));
+		}
+		std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+			if (a.group != b.group) {
+				return a.group < b.group;
+			}
+			return a.name < b.name;
+		});
+		return rows;
+	}
+
+	[[nodiscard]] std::vector<Row> CollectCandidates(const FakeInventory& inv)
+	{
+		std::vector<Row> rows;
+		for (const auto& entry : inv.entries) {
+			if (auto row = inv.Evaluate(entry)) {
+				rows.push_back(std::move(*row));
+			}
+		}
+		return rows;
+	}
+
+	void ApplyDeltas(const FakeInventory& inv, Index::EligibleIndex<Row>& index)
+	{
+		for (int pass = 0; pass < 2 && !index.dirtyObjects.empty(); ++pass) {
+			auto pending = Index::TakeDirtyObjects(index);
+			for (const auto& entry : inv.entries) {
+				if (pending.erase(entry.form->formId) == 0) {
+					continue;
+				}
+				if (auto row = inv.Evaluate(entry)) {
+					Index::Upsert(index, std::move(*row));
+				} else {
+					Index::EraseObject(index, entry.form->formId);
+				}
+				if (pending.empty()) {
+					break;
+				}
+			}
+			for (const auto formId : pending) {
+				Index::EraseObject(index, formId);
+			}
+		}
+	}
+
+	// One step of the stream: pick an entry and either drop its stack or add one.
+	void MutateInventory(FakeInventory& inv, Bench::Rng& rng, std::vector<std::uint32_t>& touched)
+	{
+		auto& entry = inv.entries[rng.Below(static_cast<std::uint32_t>(inv.entries.size()))];
+		entry.count = (rng.Below(3) == 0) ? 0 : entry.count + 1;
+		touched.push_back(entry.form->formId);
+	}
+
+	void RunScale(std::size_t n, std::size_t deltasPerRequest)
+	{
+		Bench::Rng rng{};
+		auto inv = MakeInventory(n, rng);
+		constexpr std::size_t kPage = 200;
+		constexpr std::size_t kIterations = 200;
+
+		std::vector<std::uint32_t> touched;
+		auto rescan = Bench::Measure(kIterations, [&] {
+			touched.clear();
+			for (std::size_t i = 0; i < deltasPerRequest; ++i) {
+				MutateInventory(inv, rng, touched);
+			}
+			const auto rows = FullRescan(inv);
+			std::vector<Row> page(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>((std::min)(kPage, rows.size())));
+			Bench::DoNotOptimize(page);
+		});
+
+		Bench::Rng rng2{};
+		inv = MakeInventory(n, rng2);
+		Index::EligibleIndex<Row> index;
+		Index::Rebuild(index, CollectCandidates(inv), 0u);
+		auto incremental = Bench::Measure(kIterations, [&] {
+			touched.clear();
+			for (std::size_t i = 0; i < deltasPerRequest; ++i) {
+				MutateInventory(inv, rng2, touched);
+			}
+			for (const auto formId : touched) {
+				Index::MarkObjectDirty(index, formId);
+			}
+			ApplyDeltas(inv, index);
+			const auto page = Index::Page(index, 0, kPage);
+			Bench::DoNotOptimize(page);
+		});
+
+		char label[96];
+		std::snprintf(label, sizeof(label), "full rescan+sort (%zu deltas/request)", deltasPerRequest);
+		Bench::Report(label, n, rescan);
+		std::snprintf(label, sizeof(label), "incremental index (%zu deltas/request)", deltasPerRequest);
+		Bench::Report(label, n, incremental);
+
+		// Sanity: the incremental index must agree with a fresh rescan on the visible regKey set.
+		const auto expected = FullRescan(inv);
+		std::unordered_set<std::uint32_t> expectedKeys;
+		for (const auto& row : expected) {
+			expectedKeys.insert(row.regKey);
+		}
+		std::unordered_set<std::uint32_t> actualKeys;
+		index.items.for_each([&actualKeys](const auto& ref) { actualKeys.insert(ref->regKey); });
+		if (expectedKeys != actualKeys) {
+			std::printf("  MISMATCH: rescan=%zu index=%zu\n", expectedKeys.size(), actualKeys.size());
+		}
+	}
+}
+
+int main()
+{
+	for (const std::size_t n : { 1000u, 5000u, 20000u }) {
+		for (const std::size_t deltas : { 1u, 16u }) {
+			RunScale(n, deltas);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,132 @@
+// Page fetch and single-row churn on the quick-list order-statistics index versus the sorted
+// vector of deep-copied rows it replaces.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/RegistrationQuickListIndex.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace Index = CodexOfPowerNG::Registration::QuickListIndex;
+
+	struct Row
+	{
+		std::uint32_t formId{ 0 };
+		std::uint32_t regKey{ 0 };
+		std::uint32_t group{ 0 };
+		std::int32_t  totalCount{ 0 };
+		std::string   name{};
+		std::string   typeLabel{};
+	};
+
+	[[nodiscard]] bool RowLess(const Row& a, const Row& b) noexcept
+	{
+		if (a.group != b.group) {
+			return a.group < b.group;
+		}
+		if (a.name != b.name) {
+			return a.name < b.name;
+		}
+		return a.regKey < b.regKey;
+	}
+
+	[[nodiscard]] Row MakeRow(std::uint32_t i, Bench::Rng& rng)
+	{
+		static constexpr const char* kWords[] = { "Iron", "Steel", "Elven", "Glass", "Ebony", "Daedric", "Orcish", "Dwarven" };
+		static constexpr const char* kKinds[] = { "Sword", "Dagger", "Helmet", "Boots", "Potion", "Ring", "Scroll", "Ingot" };
+
+		Row row{};
+		row.formId = 0x01000000u + i;
+		row.regKey = row.formId;
+		row.group = rng.Below(6);
+		row.totalCount = static_cast<std::int32_t>(1 + rng.Below(4));
+		row.name = std::string(kWords[rng.Below(8)]) + " " + kKinds[rng.Below(8)] + " of the Northern Reach " + std::to_string(i);
+		row.typeLabel = "Weapon / One-handed";
+		return row;
+	}
+
+	void RunScale(std::size_t n)
+	{
+		constexpr std::size_t kPage = 200;
+		constexpr std::size_t kIterations = 500;
+
+		Bench::Rng rng{};
+		std::vector<Row> sorted;
+		sorted.reserve(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			sorted.push_back(MakeRow(static_cast<std::uint32_t>(i), rng));
+		}
+		std::sort(sorted.begin(), sorted.end(), RowLess);
+
+		Index::EligibleIndex<Row> index;
+		Index::Rebuild(index, sorted, 0u);
+
+		const auto randomOffset = [n](Bench::Rng& r) {
+			return n > kPage ? static_cast<std::size_t>(r.Below(static_cast<std::uint32_t>(n - kPage))) : 0;
+		};
+
+		Bench::Rng pageRng{};
+		const auto vectorPage = Bench::Measure(kIterations, [&] {
+			const auto offset = randomOffset(pageRng);
+			std::vector<Row> page(
+				sorted.begin() + static_cast<std::ptrdiff_t>(offset),
+				sorted.begin() + static_cast<std::ptrdiff_t>((std::min)(sorted.size(), offset + kPage)));
+			Bench::DoNotOptimize(page);
+		});
+
+		pageRng = Bench::Rng{};
+		const auto indexPage = Bench::Measure(kIterations, [&] {
+			const auto page = Index::Page(index, randomOffset(pageRng), kPage);
+			Bench::DoNotOptimize(page);
+		});
+
+		// One row leaves and one arrives per request, as a single pickup/drop would.
+		Bench::Rng churnRng{};
+		auto nextId = static_cast<std::uint32_t>(n);
+		const auto vectorChurn = Bench::Measure(kIterations, [&] {
+			const auto victim = churnRng.Below(static_cast<std::uint32_t>(sorted.size()));
+			sorted.erase(sorted.begin() + static_cast<std::ptrdiff_t>(victim));
+			auto row = MakeRow(nextId++, churnRng);
+			sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), row, RowLess), std::move(row));
+			Bench::DoNotOptimize(sorted);
+		});
+
+		churnRng = Bench::Rng{};
+		nextId = static_cast<std::uint32_t>(n);
+		const auto indexChurn = Bench::Measure(kIterations, [&] {
+			const auto victim = churnRng.Below(static_cast<std::uint32_t>(index.items.size()));
+			Index::EraseObject(index, index.items.at(victim)->formId);
+			Index::Upsert(index, MakeRow(nextId++, churnRng));
+			Bench::DoNotOptimize(index);
+		});
+
+		Bench::Report("sorted vector page copy", n, vectorPage);
+		Bench::Report("ranked index page refs", n, indexPage);
+		Bench::Report("sorted vector erase+insert", n, vectorChurn);
+		Bench::Report("ranked index erase+insert", n, indexChurn);
+
+		// Sanity: both containers saw the same churn and must agree on order.
+		bool same = sorted.size() == index.items.size();
+		for (std::size_t i = 0; same && i < sorted.size(); i += 97) {
+			same = sorted[i].formId == index.items.at(i)->formId;
+		}
+		if (!same) {
+			std::printf("  MISMATCH: vector=%zu index=%zu\n", sorted.size(), index.items.size());
+		}
+	}
+}
+
+int main()
+{
+	for (const std::size_t n : { 1000u, 10000u, 50000u }) {
+		RunScale(n);
+	}
+	return 0;
+}
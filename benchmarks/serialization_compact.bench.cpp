@@ -0,0 +1,106 @@
+// Compact co-save records (sorted, partitioned by plugin, varint deltas, 3-bit groups) against the
+// fixed-width layouts they replace: REGI v3 -> v4 and BLCK/NTFY v2 -> v3. 50k registered items
+// spread over base game, DLC, regular and light plugins the way a large load order looks.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+#include "CodexOfPowerNG/SerializationRecordCodec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace Codec = CodexOfPowerNG::Serialization::RecordCodec;
+	using CodexOfPowerNG::Containers::FlatFormIdMap;
+	using CodexOfPowerNG::Containers::FlatFormIdSet;
+
+	inline constexpr std::uint32_t kRegistered = 50000;
+	inline constexpr std::uint32_t kBlocked = 20000;
+
+	[[nodiscard]] std::uint32_t RandomFormId(Bench::Rng& rng)
+	{
+		const auto bucket = rng.Below(100);
+		if (bucket < 40) {
+			return 0x00000800u + rng.Below(0x0010F800u);  // Skyrim.esm
+		}
+		if (bucket < 55) {
+			return ((1u + rng.Below(4)) << 24) | (0x000800u + rng.Below(0x020000u));  // Update + DLC
+		}
+		if (bucket < 80) {
+			return ((5u + rng.Below(60)) << 24) | (0x000800u + rng.Below(0x00F800u));  // regular plugins
+		}
+		return 0xFE000000u | (rng.Below(0x200u) << 12) | (0x800u + rng.Below(0x800u));  // light plugins
+	}
+
+	[[nodiscard]] std::span<const std::byte> BytesOf(const Codec::ByteWriter& writer)
+	{
+		return { writer.data(), writer.size() };
+	}
+
+	template <class Encode, class Decode>
+	void Compare(const char* name, std::size_t n, Encode&& encode, Decode&& decode)
+	{
+		Codec::ByteWriter writer;
+		encode(writer);
+		std::printf("%s: %zu bytes (%.2f bytes/entry)\n", name, writer.size(), static_cast<double>(writer.size()) / static_cast<double>(n));
+
+		char label[64];
+		std::snprintf(label, sizeof(label), "%s encode", name);
+		Bench::Report(label, n, Bench::Measure(20, [&]() {
+			writer.Clear();
+			encode(writer);
+			Bench::DoNotOptimize(writer.size());
+		}));
+		std::snprintf(label, sizeof(label), "%s decode", name);
+		Bench::Report(label, n, Bench::Measure(20, [&]() { decode(BytesOf(writer)); }));
+	}
+}
+
+int main()
+{
+	Bench::Rng rng;
+	FlatFormIdMap<std::uint32_t> registered;
+	FlatFormIdSet                blocked;
+	registered.reserve(kRegistered);
+	blocked.reserve(kBlocked);
+	while (registered.size() < kRegistered) {
+		const auto group = rng.Below(10) == 0 ? 255u : rng.Below(6);
+		registered.emplace(RandomFormId(rng), group);
+	}
+	while (blocked.size() < kBlocked) {
+		blocked.insert(RandomFormId(rng));
+	}
+
+	std::uint64_t sink = 0;
+	const auto decodeRegistered = [&](std::uint32_t version) {
+		return [&sink, version](std::span<const std::byte> bytes) {
+			FlatFormIdMap<std::uint32_t> loaded;
+			loaded.reserve(Codec::CountHint(bytes));
+			(void)Codec::DecodeRegistered(bytes, version, 255u, [&](std::uint32_t formId, std::uint32_t group) {
+				loaded.emplace(formId, group);
+			});
+			sink += loaded.size();
+			Bench::DoNotOptimize(sink);
+		};
+	};
+	const auto decodeFormIds = [&](std::uint32_t version) {
+		return [&sink, version](std::span<const std::byte> bytes) {
+			FlatFormIdSet loaded;
+			loaded.reserve(Codec::CountHint(bytes));
+			(void)Codec::DecodeFormIds(bytes, version, [&](std::uint32_t formId) { loaded.insert(formId); });
+			sink += loaded.size();
+			Bench::DoNotOptimize(sink);
+		};
+	};
+
+	Compare("REGI v3 (columns)", kRegistered, [&](Codec::ByteWriter& writer) { Codec::EncodeRegisteredColumns(writer, registered); }, decodeRegistered(3u));
+	Compare("REGI v4 (compact)", kRegistered, [&](Codec::ByteWriter& writer) { Codec::EncodeRegistered(writer, registered); }, decodeRegistered(4u));
+	Compare("BLCK v2 (raw)", kBlocked, [&](Codec::ByteWriter& writer) { Codec::EncodeFormIdsRaw(writer, blocked); }, decodeFormIds(2u));
+	Compare("BLCK v3 (compact)", kBlocked, [&](Codec::ByteWriter& writer) { Codec::EncodeFormIds(writer, blocked); }, decodeFormIds(3u));
+	return 0;
+}
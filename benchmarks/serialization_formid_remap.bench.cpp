@@ -0,0 +1,123 @@
+// Remapping 50k stored FormIDs on co-save load: one ResolveFormID interface call per ID (previous
+// loader) versus the per-load plugin translation table, resolved once per plugin and applied in
+// bulk. The fake resolver does SKSE's work (plugin index lookup in a load-order table) behind a
+// virtual call the optimizer cannot see through, like SKSE's proxy.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/SerializationFormIdRemap.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace FormIdRemap = CodexOfPowerNG::Serialization::FormIdRemap;
+
+	inline constexpr std::size_t kEntries = 50000;
+	inline constexpr std::uint32_t kMissing = 0xFFFFu;
+
+	class FakeResolver
+	{
+	public:
+		FakeResolver()
+		{
+			for (std::uint32_t i = 0; i < _regular.size(); ++i) {
+				_regular[i] = i % 17 == 16 ? kMissing : (i + 3) & 0xFFu;  // shifted load order, a few plugins gone
+			}
+			for (std::uint32_t i = 0; i < _light.size(); ++i) {
+				_light[i] = i % 23 == 22 ? kMissing : (i + 5) & 0xFFFu;
+			}
+		}
+		virtual ~FakeResolver() = default;
+
+		virtual bool ResolveFormID(std::uint32_t oldId, std::uint32_t& newId)
+		{
+			const auto index = oldId >> 24;
+			if (index == 0xFFu) {
+				newId = oldId;
+				return true;
+			}
+			if (index == 0xFEu) {
+				const auto light = _light[(oldId >> 12) & 0xFFFu];
+				if (light == kMissing) {
+					return false;
+				}
+				newId = 0xFE000000u | (light << 12) | (oldId & 0xFFFu);
+				return true;
+			}
+			const auto regular = _regular[index];
+			if (regular == kMissing) {
+				return false;
+			}
+			newId = (regular << 24) | (oldId & 0x00FFFFFFu);
+			return true;
+		}
+
+	private:
+		std::array<std::uint32_t, 0x100>  _regular{};
+		std::array<std::uint32_t, 0x1000> _light{};
+	};
+
+	[[nodiscard]] FakeResolver* MakeResolver()
+	{
+		static FakeResolver resolver;
+		auto* pointer = &resolver;
+		Bench::DoNotOptimize(pointer);
+		return pointer;
+	}
+}
+
+int main()
+{
+	Bench::Rng rng;
+	std::vector<std::uint32_t> stored(kEntries);
+	for (auto& id : stored) {
+		const auto bucket = rng.Below(100);
+		if (bucket < 40) {
+			id = 0x00000800u + rng.Below(0x0010F800u);
+		} else if (bucket < 80) {
+			id = ((1u + rng.Below(80)) << 24) | (0x000800u + rng.Below(0x00F800u));
+		} else {
+			id = 0xFE000000u | (rng.Below(0x200u) << 12) | (0x800u + rng.Below(0x800u));
+		}
+	}
+
+	auto*                      resolver = MakeResolver();
+	std::vector<std::uint32_t> ids;
+	ids.reserve(kEntries);
+	std::uint64_t sink = 0;
+
+	Bench::Report("ResolveFormID per entry", kEntries, Bench::Measure(20, [&]() {
+		ids.clear();
+		for (const auto oldId : stored) {
+			std::uint32_t newId{};
+			if (resolver->ResolveFormID(oldId, newId)) {
+				ids.push_back(newId);
+			}
+		}
+		sink += ids.size();
+		Bench::DoNotOptimize(sink);
+	}));
+	const auto perEntryKept = ids.size();
+
+	std::size_t calls = 0;
+	Bench::Report("translation table, bulk remap", kEntries, Bench::Measure(20, [&]() {
+		ids.assign(stored.begin(), stored.end());
+		FormIdRemap::Translation translation([resolver](std::uint32_t oldId, std::uint32_t& newId) {
+			return resolver->ResolveFormID(oldId, newId);
+		});
+		const auto kept = translation.RemapInPlace(std::span(ids));
+		ids.resize(kept);
+		calls = translation.ResolveCalls();
+		sink += kept;
+		Bench::DoNotOptimize(sink);
+	}));
+
+	std::printf("kept %zu vs %zu; %zu resolver calls instead of %zu\n", perEntryKept, ids.size(), calls, kEntries);
+	return 0;
+}
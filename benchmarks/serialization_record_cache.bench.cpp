@@ -0,0 +1,96 @@
+// Save-time encoding of the FormID records (50k REGI, 20k BLCK, 20k NTFY) when nothing changed
+// since the previous save and when only REGI did: re-encoding everything every save versus the
+// per-record generation cache handing back the previous bytes.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+#include "CodexOfPowerNG/SerializationRecordCache.h"
+#include "CodexOfPowerNG/SerializationRecordCodec.h"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace Codec = CodexOfPowerNG::Serialization::RecordCodec;
+	namespace Serialization = CodexOfPowerNG::Serialization;
+	using CodexOfPowerNG::Containers::FlatFormIdMap;
+	using CodexOfPowerNG::Containers::FlatFormIdSet;
+	using Serialization::SaveRecord;
+
+	inline constexpr std::uint32_t kRegistered = 50000;
+	inline constexpr std::uint32_t kListed = 20000;
+
+	struct Records
+	{
+		FlatFormIdMap<std::uint32_t> registered;
+		FlatFormIdSet                blocked;
+		FlatFormIdSet                notified;
+	};
+
+	template <class Get>
+	std::size_t EncodeAll(const Records& records, Get&& get)
+	{
+		std::size_t bytes = 0;
+		bytes += get(SaveRecord::kRegistered, [&](auto& buffer) { Codec::EncodeRegistered(buffer, records.registered); }).size();
+		bytes += get(SaveRecord::kBlocked, [&](auto& buffer) { Codec::EncodeFormIds(buffer, records.blocked); }).size();
+		bytes += get(SaveRecord::kNotified, [&](auto& buffer) { Codec::EncodeFormIds(buffer, records.notified); }).size();
+		return bytes;
+	}
+}
+
+int main()
+{
+	Bench::Rng rng;
+	Records    records;
+	records.registered.reserve(kRegistered);
+	while (records.registered.size() < kRegistered) {
+		records.registered.emplace(0x01000000u + rng.Below(0x00FFFFFFu), rng.Below(6));
+	}
+	while (records.blocked.size() < kListed) {
+		records.blocked.insert(0x02000000u + rng.Below(0x00FFFFFFu));
+	}
+	while (records.notified.size() < kListed) {
+		records.notified.insert(0x03000000u + rng.Below(0x00FFFFFFu));
+	}
+
+	std::uint64_t     sink = 0;
+	Codec::ByteWriter buffer;
+	Bench::Report("save: re-encode every record", kRegistered + 2 * kListed, Bench::Measure(20, [&]() {
+		sink += EncodeAll(records, [&](SaveRecord, auto&& encode) -> const Codec::ByteWriter& {
+			buffer.Clear();
+			encode(buffer);
+			return buffer;
+		});
+		Bench::DoNotOptimize(sink);
+	}));
+
+	Serialization::EncodedRecordCache     cache;
+	Serialization::SaveRecordGenerations generations;
+	Serialization::SaveStats             stats{};
+	const auto cached = [&](SaveRecord record, auto&& encode) -> const Codec::ByteWriter& {
+		return cache.Get(record, generations.Of(record), encode, stats);
+	};
+	(void)EncodeAll(records, cached);
+
+	Bench::Report("save: cache, nothing changed", kRegistered + 2 * kListed, Bench::Measure(20, [&]() {
+		sink += EncodeAll(records, cached);
+		Bench::DoNotOptimize(sink);
+	}));
+
+	Bench::Report("save: cache, REGI changed", kRegistered + 2 * kListed, Bench::Measure(20, [&]() {
+		generations.Bump(SaveRecord::kRegistered);
+		sink += EncodeAll(records, cached);
+		Bench::DoNotOptimize(sink);
+	}));
+
+	std::printf(
+		"cache totals: %zu record(s) encoded (%zu bytes), %zu reused (%zu bytes)\n",
+		stats.encodedRecords,
+		stats.encodedBytes,
+		stats.reusedRecords,
+		stats.reusedBytes);
+	return 0;
+}
@@ -0,0 +1,217 @@
+// Co-save REGI/BLCK records at 50k entries through a fake SerializationInterface: one
+// WriteRecordData/ReadRecordData per field (previous v2 writers/readers) versus encoding the
+// record into a reused buffer and handing it over in one call, decoded from a span (into tables
+// reserved from the record header) on load. Layouts are the fixed-width ones (REGI v3, BLCK v2);
+// serialization_compact.bench.cpp compares those against the compact records.
+// The fake forwards through virtual calls the optimizer cannot see through, like SKSE's proxy.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+#include "CodexOfPowerNG/SerializationRecordCodec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace Codec = CodexOfPowerNG::Serialization::RecordCodec;
+	using CodexOfPowerNG::Containers::FlatFormIdMap;
+	using CodexOfPowerNG::Containers::FlatFormIdSet;
+
+	inline constexpr std::uint32_t kEntries = 50000;
+
+	class FakeSerializationInterface
+	{
+	public:
+		virtual ~FakeSerializationInterface() = default;
+
+		virtual bool WriteRecordData(const void* buffer, std::uint32_t length)
+		{
+			const auto* bytes = static_cast<const std::byte*>(buffer);
+			record.insert(record.end(), bytes, bytes + length);
+			return true;
+		}
+
+		virtual std::uint32_t ReadRecordData(void* buffer, std::uint32_t length)
+		{
+			const auto available = static_cast<std::uint32_t>(record.size() - readPos);
+			const auto taken = length < available ? length : available;
+			std::memcpy(buffer, record.data() + readPos, taken);
+			readPos += taken;
+			return taken;
+		}
+
+		virtual bool ResolveFormID(std::uint32_t oldId, std::uint32_t& newId)
+		{
+			newId = oldId;
+			return true;
+		}
+
+		template <class T>
+		bool WriteRecordData(const T& value)
+		{
+			return WriteRecordData(&value, static_cast<std::uint32_t>(sizeof(T)));
+		}
+
+		template <class T>
+		std::uint32_t ReadRecordData(T& value)
+		{
+			return ReadRecordData(&value, static_cast<std::uint32_t>(sizeof(T)));
+		}
+
+		void OpenRecord()
+		{
+			record.clear();
+			readPos = 0;
+		}
+
+		std::vector<std::byte> record;
+		std::size_t            readPos{ 0 };
+	};
+
+	[[nodiscard]] FakeSerializationInterface* MakeInterface()
+	{
+		static FakeSerializationInterface intfc;
+		auto* pointer = &intfc;
+		Bench::DoNotOptimize(pointer);
+		return pointer;
+	}
+}
+
+int main()
+{
+	Bench::Rng rng;
+	FlatFormIdMap<std::uint32_t> registered;
+	FlatFormIdSet                blocked;
+	registered.reserve(kEntries);
+	blocked.reserve(kEntries);
+	while (registered.size() < kEntries) {
+		registered.emplace(0x01000000u + rng.Below(0x00FFFFFFu), rng.Below(6));
+	}
+	while (blocked.size() < kEntries) {
+		blocked.insert(0x02000000u + rng.Below(0x00FFFFFFu));
+	}
+
+	auto* intfc = MakeInterface();
+	intfc->record.reserve(std::size_t{ kEntries } * 8 + 16);
+	Codec::ByteWriter buffer;
+
+	Bench::Report("REGI save: per-field WriteRecordData (v2)", kEntries, Bench::Measure(20, [&]() {
+		intfc->OpenRecord();
+		(void)intfc->WriteRecordData(static_cast<std::uint32_t>(registered.size()));
+		for (const auto& [formId, group] : registered) {
+			(void)intfc->WriteRecordData(formId);
+			(void)intfc->WriteRecordData(group);
+		}
+	}));
+	const auto v2Bytes = intfc->record.size();
+
+	Bench::Report("REGI save: encoded buffer, one call (v3)", kEntries, Bench::Measure(20, [&]() {
+		intfc->OpenRecord();
+		buffer.Clear();
+		Codec::EncodeRegisteredColumns(buffer, registered);
+		(void)intfc->WriteRecordData(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+	}));
+	std::printf("REGI record: %zu bytes (v2) -> %zu bytes (v3)\n", v2Bytes, intfc->record.size());
+
+	std::uint64_t sink = 0;
+	intfc->OpenRecord();
+	(void)intfc->WriteRecordData(static_cast<std::uint32_t>(registered.size()));
+	for (const auto& [formId, group] : registered) {
+		(void)intfc->WriteRecordData(formId);
+		(void)intfc->WriteRecordData(group);
+	}
+	Bench::Report("REGI load: per-field ReadRecordData (v2)", kEntries, Bench::Measure(20, [&]() {
+		intfc->readPos = 0;
+		FlatFormIdMap<std::uint32_t> loaded;
+		std::uint32_t count{};
+		(void)intfc->ReadRecordData(count);
+		for (std::uint32_t i = 0; i < count; ++i) {
+			std::uint32_t oldId{};
+			std::uint32_t group{};
+			if (intfc->ReadRecordData(oldId) != sizeof(oldId) || intfc->ReadRecordData(group) != sizeof(group)) {
+				break;
+			}
+			std::uint32_t newId{};
+			if (intfc->ResolveFormID(oldId, newId)) {
+				loaded.emplace(newId, group);
+			}
+		}
+		sink += loaded.size();
+		Bench::DoNotOptimize(sink);
+	}));
+
+	intfc->OpenRecord();
+	buffer.Clear();
+	Codec::EncodeRegisteredColumns(buffer, registered);
+	(void)intfc->WriteRecordData(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+	std::vector<std::byte> recordBytes;
+	Bench::Report("REGI load: one read, span decode (v3)", kEntries, Bench::Measure(20, [&]() {
+		intfc->readPos = 0;
+		FlatFormIdMap<std::uint32_t> loaded;
+		recordBytes.resize(intfc->record.size());
+		(void)intfc->ReadRecordData(recordBytes.data(), static_cast<std::uint32_t>(recordBytes.size()));
+		loaded.reserve(Codec::CountHint(recordBytes));
+		(void)Codec::DecodeRegistered(recordBytes, 3u, 255u, [&](std::uint32_t oldId, std::uint32_t group) {
+			std::uint32_t newId{};
+			if (intfc->ResolveFormID(oldId, newId)) {
+				loaded.emplace(newId, group);
+			}
+		});
+		sink += loaded.size();
+		Bench::DoNotOptimize(sink);
+	}));
+
+	Bench::Report("BLCK save: per-entry WriteRecordData", kEntries, Bench::Measure(20, [&]() {
+		intfc->OpenRecord();
+		(void)intfc->WriteRecordData(static_cast<std::uint32_t>(blocked.size()));
+		for (const auto formId : blocked) {
+			(void)intfc->WriteRecordData(formId);
+		}
+	}));
+
+	Bench::Report("BLCK save: encoded buffer, one call", kEntries, Bench::Measure(20, [&]() {
+		intfc->OpenRecord();
+		buffer.Clear();
+		Codec::EncodeFormIdsRaw(buffer, blocked);
+		(void)intfc->WriteRecordData(buffer.data(), static_cast<std::uint32_t>(buffer.size()));
+	}));
+
+	Bench::Report("BLCK load: per-entry ReadRecordData", kEntries, Bench::Measure(20, [&]() {
+		intfc->readPos = 0;
+		FlatFormIdSet loaded;
+		std::uint32_t count{};
+		(void)intfc->ReadRecordData(count);
+		for (std::uint32_t i = 0; i < count; ++i) {
+			std::uint32_t oldId{};
+			std::uint32_t newId{};
+			if (intfc->ReadRecordData(oldId) == sizeof(oldId) && intfc->ResolveFormID(oldId, newId)) {
+				loaded.insert(newId);
+			}
+		}
+		sink += loaded.size();
+		Bench::DoNotOptimize(sink);
+	}));
+
+	Bench::Report("BLCK load: one read, span decode", kEntries, Bench::Measure(20, [&]() {
+		intfc->readPos = 0;
+		FlatFormIdSet loaded;
+		recordBytes.resize(intfc->record.size());
+		(void)intfc->ReadRecordData(recordBytes.data(), static_cast<std::uint32_t>(recordBytes.size()));
+		loaded.reserve(Codec::CountHint(recordBytes));
+		(void)Codec::DecodeFormIds(recordBytes, 2u, [&](std::uint32_t oldId) {
+			std::uint32_t newId{};
+			if (intfc->ResolveFormID(oldId, newId)) {
+				loaded.insert(newId);
+			}
+		});
+		sink += loaded.size();
+		Bench::DoNotOptimize(sink);
+	}));
+	return 0;
+}
@@ -0,0 +1,106 @@
+// Cost of SnapshotState()/SnapshotQuickList()-style copies of the registration state as the
+// collections grow: deep copies of node-based containers versus copy-on-write shared tables,
+// plus what the first write after a snapshot pays to unshare.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/CopyOnWrite.h"
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	using CodexOfPowerNG::Containers::CopyOnWrite;
+	using CodexOfPowerNG::Containers::FlatFormIdMap;
+	using CodexOfPowerNG::Containers::FlatFormIdSet;
+
+	struct UndoRecord
+	{
+		std::uint64_t                              actionId{ 0 };
+		std::uint32_t                              formId{ 0 };
+		std::vector<std::pair<std::uint32_t, float>> rewardDeltas;
+	};
+
+	struct DeepState
+	{
+		std::unordered_map<std::uint32_t, std::uint32_t> registeredItems;
+		std::unordered_set<std::uint32_t>                blockedItems;
+		std::unordered_set<std::uint32_t>                notifiedItems;
+		std::deque<UndoRecord>                           undoHistory;
+	};
+
+	struct SharedState
+	{
+		FlatFormIdMap<std::uint32_t>      registeredItems;
+		FlatFormIdSet                     blockedItems;
+		FlatFormIdSet                     notifiedItems;
+		CopyOnWrite<std::deque<UndoRecord>> undoHistory;
+	};
+
+	template <class State>
+	void Fill(State& state, std::size_t n)
+	{
+		std::deque<UndoRecord> undo;
+		for (std::uint32_t i = 0; i < n; ++i) {
+			const auto id = 0x01000000u + i * 3u;
+			state.registeredItems.emplace(id, i % 6);
+			state.notifiedItems.insert(id);
+			if (i % 50 == 0) {
+				state.blockedItems.insert(id + 1);
+			}
+		}
+		// Undo keeps the last 10 groups; a big batch registration makes one group of many records.
+		for (std::uint32_t i = 0; i < n / 10; ++i) {
+			undo.push_back(UndoRecord{ i / 50, 0x01000000u + i, { { 1u, 0.5f }, { 2u, 1.0f } } });
+		}
+		if constexpr (requires { state.undoHistory.Write(); }) {
+			state.undoHistory.Write() = std::move(undo);
+		} else {
+			state.undoHistory = std::move(undo);
+		}
+	}
+
+	template <class State>
+	void Run(const char* name, std::size_t n)
+	{
+		State state;
+		Fill(state, n);
+		const auto label = [&](const char* op) { return std::string(name) + " " + op; };
+
+		Bench::Report(label("snapshot").c_str(), n, Bench::Measure(50, [&]() {
+			const State snapshot = state;
+			Bench::DoNotOptimize(snapshot.registeredItems.size());
+		}));
+
+		// Snapshot held by a reader while the owner registers one item: the shared path pays to
+		// unshare only the table it writes.
+		std::uint32_t next = 0x7F000000u;
+		Bench::Report(label("snapshot + 1 write").c_str(), n, Bench::Measure(50, [&]() {
+			const State snapshot = state;
+			state.registeredItems.emplace(next++, 1u);
+			Bench::DoNotOptimize(snapshot.registeredItems.size());
+		}));
+
+		Bench::Report(label("write, no snapshot").c_str(), n, Bench::Measure(200, [&]() {
+			state.registeredItems.emplace(next++, 1u);
+		}));
+	}
+}
+
+int main()
+{
+	for (const std::size_t n : { 1000u, 10000u, 100000u }) {
+		Run<DeepState>("deep copy", n);
+		Run<SharedState>("copy-on-write", n);
+		std::printf("\n");
+	}
+	return 0;
+}
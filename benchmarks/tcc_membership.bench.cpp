@@ -0,0 +1,107 @@
+// TCC gate lookups against a 10k-entry dbmDisp and a 15k-entry dbmMaster: BGSListForm::HasForm's
+// linear scan (two lists x item + regKey) versus the hashed membership cache, per quick-list build
+// over a 300-item inventory, plus what a cache rebuild and the per-call staleness check cost.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/RegistrationTccMembership.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace TM = CodexOfPowerNG::Registration::TccMembership;
+
+	inline constexpr std::size_t kInventoryItems = 300;
+
+	[[nodiscard]] bool ScanHasEither(const std::vector<std::uint32_t>& list, std::uint32_t first, std::uint32_t second)
+	{
+		if (first != 0 && std::find(list.begin(), list.end(), first) != list.end()) {
+			return true;
+		}
+		return second != 0 && second != first && std::find(list.begin(), list.end(), second) != list.end();
+	}
+
+	[[nodiscard]] TM::Fingerprint FingerprintOf(const std::vector<std::uint32_t>& added)
+	{
+		TM::Fingerprint fingerprint{};
+		if (!added.empty()) {
+			fingerprint.addedCount = static_cast<std::uint32_t>(added.size());
+			fingerprint.lastAddedId = added.back();
+		}
+		return fingerprint;
+	}
+
+	[[nodiscard]] TM::ListMembership Build(const std::vector<std::uint32_t>& added)
+	{
+		const std::vector<std::uint32_t> noForms;
+		return TM::Build(FingerprintOf(added), noForms, [](std::uint32_t formId) { return formId; }, &added);
+	}
+}
+
+int main()
+{
+	Bench::Rng rng;
+	std::vector<std::uint32_t> master;
+	std::vector<std::uint32_t> displayed;
+	for (std::uint32_t i = 0; i < 15000; ++i) {
+		const auto formId = 0x05000000u + i * 3u;
+		master.push_back(formId);
+		if (i < 10000) {
+			displayed.push_back(formId);
+		}
+	}
+	// Displays are appended in play order, not FormID order.
+	for (std::size_t i = displayed.size(); i > 1; --i) {
+		std::swap(displayed[i - 1], displayed[rng.Below(static_cast<std::uint32_t>(i))]);
+	}
+
+	// Inventory: most items are not tracked by LOTD at all (full scans of both lists).
+	std::vector<std::pair<std::uint32_t, std::uint32_t>> inventory;
+	for (std::size_t i = 0; i < kInventoryItems; ++i) {
+		const auto item = 0x05000000u + rng.Below(15000 * 6);
+		inventory.emplace_back(item, i % 4 == 0 ? item + 1 : item);
+	}
+
+	std::size_t scanAllowed = 0;
+	Bench::Report("HasForm scans, 300-item quick list", displayed.size(), Bench::Measure(20, [&]() {
+		scanAllowed = 0;
+		for (const auto& [item, regKey] : inventory) {
+			const bool tracked = ScanHasEither(master, regKey, item);
+			const bool shown = ScanHasEither(displayed, regKey, item);
+			scanAllowed += (!tracked || shown) ? 1u : 0u;
+		}
+		Bench::DoNotOptimize(scanAllowed);
+	}));
+
+	const auto masterForms = Build(master);
+	auto displayedForms = Build(displayed);
+	std::size_t cachedAllowed = 0;
+	Bench::Report("cached membership, 300-item quick list", displayed.size(), Bench::Measure(200, [&]() {
+		cachedAllowed = 0;
+		for (const auto& [item, regKey] : inventory) {
+			const bool tracked = TM::HasEither(masterForms, regKey, item);
+			const bool shown = TM::HasEither(displayedForms, regKey, item);
+			cachedAllowed += (!tracked || shown) ? 1u : 0u;
+		}
+		Bench::DoNotOptimize(cachedAllowed);
+	}));
+	if (scanAllowed != cachedAllowed) {
+		std::printf("mismatch: scan=%zu cached=%zu\n", scanAllowed, cachedAllowed);
+		return 1;
+	}
+
+	Bench::Report("staleness check (fingerprint)", displayed.size(), Bench::Measure(2000, [&]() {
+		Bench::DoNotOptimize(FingerprintOf(displayed) == displayedForms.fingerprint);
+	}));
+	Bench::Report("rebuild after a display change", displayed.size(), Bench::Measure(50, [&]() {
+		displayedForms = Build(displayed);
+		Bench::DoNotOptimize(displayedForms.forms.size());
+	}));
+	return 0;
+}
@@ -0,0 +1,208 @@
+// Bytes on the wire and native build time per mutation: five full snapshots (the old
+// RefreshUIAfterMutation) against one copng_applyPatch diffed by the shipped UiPatch::DiffValue.
+//
+// The diff needs nlohmann/json on the include path, e.g.
+//   CPLUS_INCLUDE_PATH=/path/to/nlohmann/include scripts/bench.sh ui_patch
+
+#include "BenchCommon.h"
+
+#if __has_include(<nlohmann/json.hpp>)
+#	include "CodexOfPowerNG/UiPatchJson.h"
+#	define COPNG_BENCH_UI_PATCH_JSON 1
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifdef COPNG_BENCH_UI_PATCH_JSON
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace UiPatch = CodexOfPowerNG::UiPatch;
+	using Json = UiPatch::Json;
+
+	constexpr std::size_t kMutations = 200;
+	constexpr std::array  kChannels{ "state", "inventory", "build", "rewards", "undo" };
+
+	struct Item
+	{
+		std::uint32_t formId{ 0 };
+		std::uint32_t group{ 0 };
+		std::uint32_t count{ 0 };
+		std::uint32_t discipline{ 0 };
+	};
+
+	struct UndoRow
+	{
+		std::uint64_t actionId{ 0 };
+		std::uint32_t formId{ 0 };
+	};
+
+	struct World
+	{
+		std::uint32_t        registeredCount{ 120 };
+		std::uint64_t        nextAction{ 1000 };
+		std::uint32_t        attackScore{ 40 };
+		std::vector<Item>    inventory;
+		std::vector<UndoRow> undo;
+		std::vector<double>  totals;
+	};
+
+	[[nodiscard]] World MakeWorld(std::size_t inventorySize, Bench::Rng& rng)
+	{
+		World world;
+		for (std::size_t i = 0; i < inventorySize; ++i) {
+			world.inventory.push_back(Item{ 0x01000000u + static_cast<std::uint32_t>(i), rng.Below(6), 1 + rng.Below(5), rng.Below(3) });
+		}
+		for (std::uint32_t i = 0; i < 10; ++i) {
+			world.undo.push_back(UndoRow{ 1000u - i, 0x02000000u + i });
+		}
+		for (std::uint32_t i = 0; i < 24; ++i) {
+			world.totals.push_back(i * 0.5);
+		}
+		return world;
+	}
+
+	[[nodiscard]] std::array<Json, kChannels.size()> Snapshots(const World& world)
+	{
+		static constexpr std::array kDisciplines{ "attack", "defense", "utility" };
+
+		Json items = Json::array();
+		for (const auto& item : world.inventory) {
+			items.push_back({
+				{ "formId", item.formId },
+				{ "regKey", item.formId },
+				{ "name", "Item " + std::to_string(item.formId & 0xFFFFu) + " of the Dragonborn" },
+				{ "group", item.group },
+				{ "groupName", "Weapons" },
+				{ "totalCount", item.count },
+				{ "safeCount", 1 },
+				{ "discipline", kDisciplines[item.discipline] },
+				{ "actionable", true },
+			});
+		}
+
+		Json options = Json::array();
+		for (std::uint32_t i = 0; i < 48; ++i) {
+			options.push_back({
+				{ "id", "opt_" + std::to_string(i) },
+				{ "discipline", "attack" },
+				{ "themeId", "fury" },
+				{ "unlockPoints", i * 5 },
+				{ "unlocked", i * 5 <= world.attackScore },
+				{ "currentTier", 0 },
+			});
+		}
+
+		Json undo = Json::array();
+		for (const auto& row : world.undo) {
+			undo.push_back({ { "actionId", row.actionId }, { "formId", row.formId }, { "name", "Undo " + std::to_string(row.formId & 0xFFu) } });
+		}
+
+		Json totals = Json::array();
+		for (std::size_t av = 0; av < world.totals.size(); ++av) {
+			totals.push_back({ { "av", av }, { "label", "AV " + std::to_string(av) }, { "total", world.totals[av] } });
+		}
+
+		return {
+			Json{ { "registeredCount", world.registeredCount }, { "language", "en" }, { "perfMode", false }, { "busy", false } },
+			Json{ { "page", 0 }, { "pageSize", world.inventory.size() }, { "total", world.inventory.size() }, { "hasMore", false }, { "items", std::move(items) } },
+			Json{
+				{ "disciplines", { { "attack", { { "score", world.attackScore }, { "currentTier", world.attackScore >> 4 } } } } },
+				{ "options", std::move(options) },
+				{ "activeSlots", Json::array({ { { "slotId", "attack_1" }, { "optionId", "opt_1" }, { "occupied", true } } }) },
+			},
+			Json{ { "registeredCount", world.registeredCount }, { "rewardEvery", 10 }, { "totals", std::move(totals) } },
+			std::move(undo),
+		};
+	}
+
+	// Registers the item at `victim`: it leaves the quick list and joins the undo history.
+	void RegisterOne(World& world, std::size_t victim)
+	{
+		const auto formId = world.inventory[victim].formId;
+		world.inventory.erase(world.inventory.begin() + static_cast<std::ptrdiff_t>(victim));
+		++world.registeredCount;
+		++world.attackScore;
+		world.undo.insert(world.undo.begin(), UndoRow{ ++world.nextAction, formId });
+		world.undo.pop_back();
+		if (world.registeredCount % 10 == 0) {
+			world.totals[world.registeredCount % world.totals.size()] += 1.0;
+		}
+	}
+
+	void RunScale(std::size_t inventorySize)
+	{
+		Bench::Rng rng;
+		auto       world = MakeWorld(inventorySize, rng);
+		auto       baseline = Snapshots(world);
+
+		std::vector<std::array<Json, kChannels.size()>> steps;
+		steps.reserve(kMutations);
+		for (std::size_t m = 0; m < kMutations; ++m) {
+			RegisterOne(world, rng.Below(static_cast<std::uint32_t>(world.inventory.size())));
+			steps.push_back(Snapshots(world));
+		}
+
+		std::size_t fullBytes = 0;
+		std::size_t patchBytes = 0;
+		for (const auto& next : steps) {
+			for (const auto& doc : next) {
+				fullBytes += doc.dump().size();
+			}
+		}
+
+		// Measure() warms up once and then runs kMutations - 1 times: exactly one pass over `steps`.
+		std::size_t step = 0;
+		const auto  full = Bench::Measure(kMutations - 1, [&]() {
+			std::size_t bytes = 0;
+			for (const auto& doc : steps[step++ % steps.size()]) {
+				bytes += doc.dump().size();
+			}
+			Bench::DoNotOptimize(bytes);
+		});
+
+		step = 0;
+		auto       prev = baseline;
+		const auto patch = Bench::Measure(kMutations - 1, [&]() {
+			const auto& next = steps[step++ % steps.size()];
+			Json        channels = Json::object();
+			for (std::size_t i = 0; i < kChannels.size(); ++i) {
+				if (prev[i] == next[i]) {
+					continue;
+				}
+				Json node;
+				if (UiPatch::DiffValue(prev[i], next[i], node)) {
+					channels[kChannels[i]] = Json{ { "patch", std::move(node) } };
+				} else {
+					channels[kChannels[i]] = Json{ { "full", next[i] } };
+				}
+			}
+			prev = next;
+			const auto wire = Json{ { "base", step }, { "generation", step + 1 }, { "reset", false }, { "channels", std::move(channels) } }.dump();
+			patchBytes += wire.size();
+			Bench::DoNotOptimize(wire);
+		});
+
+		std::printf("bytes/mutation: five full snapshots=%zu  one copng_applyPatch=%zu\n", fullBytes / kMutations, patchBytes / kMutations);
+		Bench::Report("five full snapshots (dump)", inventorySize, full);
+		Bench::Report("one copng_applyPatch (diff + dump)", inventorySize, patch);
+	}
+}
+#endif
+
+int main()
+{
+#ifdef COPNG_BENCH_UI_PATCH_JSON
+	for (const std::size_t n : { 200u, 1000u, 5000u }) {
+		RunScale(n);
+	}
+#else
+	std::puts("ui_patch: nlohmann/json not on the include path; skipped");
+#endif
+	return 0;
+}
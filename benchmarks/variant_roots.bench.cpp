@@ -0,0 +1,100 @@
+// Register-key resolution over deep synthetic variant chains: the previous per-call walk (up to 8
+// map hops, each followed by a form lookup) versus one probe into the compiled root table, plus
+// the one-off compile. 20k chains of depth 1..12 over a 200k-form "game" table.
+
+#include "BenchCommon.h"
+
+#include "CodexOfPowerNG/RegistrationVariantRoots.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	namespace Bench = CodexOfPowerNG::Bench;
+	namespace VR = CodexOfPowerNG::Registration::VariantRoots;
+
+	inline constexpr std::uint32_t kChains = 20000;
+	inline constexpr std::uint32_t kMaxDepth = 12;
+	inline constexpr std::uint32_t kGameForms = 200000;
+	inline constexpr std::size_t   kLookups = 4096;
+
+	[[nodiscard]] bool ValidStep(std::uint32_t current, std::uint32_t next) noexcept
+	{
+		return next != 0 && next != current;
+	}
+}
+
+int main()
+{
+	Bench::Rng rng;
+
+	// Stand-in for TESForm::LookupByID's global form map.
+	std::unordered_set<std::uint32_t> gameForms;
+	gameForms.reserve(kGameForms);
+	for (std::uint32_t i = 0; i < kGameForms; ++i) {
+		gameForms.insert(0x01000000u + i);
+	}
+
+	std::unordered_map<std::uint32_t, std::uint32_t>       legacyMap;
+	CodexOfPowerNG::Containers::FlatFormIdMap<std::uint32_t> variantBase;
+	std::vector<std::uint32_t>                             probes;
+	std::uint32_t                                          next = 0x01000000u;
+	std::size_t                                            entries = 0;
+	for (std::uint32_t chain = 0; chain < kChains; ++chain) {
+		const std::uint32_t depth = 1 + rng.Below(kMaxDepth);
+		const std::uint32_t root = next++;
+		std::uint32_t       base = root;
+		for (std::uint32_t step = 0; step < depth; ++step) {
+			const std::uint32_t variant = next++;
+			legacyMap.emplace(variant, base);
+			variantBase.emplace(variant, base);
+			base = variant;
+			++entries;
+		}
+		probes.push_back(base);  // deepest variant
+	}
+	// Inventories hold plenty of forms that are not variants at all.
+	while (probes.size() < kChains * 2) {
+		probes.push_back(0x01000000u + kGameForms / 2 + rng.Below(kGameForms / 2));
+	}
+
+	const auto accept = [&](std::uint32_t current, std::uint32_t base) {
+		return ValidStep(current, base) && gameForms.contains(base);
+	};
+
+	VR::CompileStats stats{};
+	VR::Table roots;
+	Bench::Report("compile root table", entries, Bench::Measure(5, [&]() {
+		stats = {};
+		roots = VR::Compile(variantBase, accept, &stats);
+	}));
+	std::printf("chains: %u, longest %zu, table %zu entries\n", kChains, stats.maxDepth, roots.size());
+
+	std::uint64_t sink = 0;
+	Bench::Report("walk: <=8 hops, map + form lookup per hop", kLookups, Bench::Measure(50, [&]() {
+		for (std::size_t i = 0; i < kLookups; ++i) {
+			std::uint32_t id = probes[(i * 7919u) % probes.size()];
+			for (int safety = 0; safety < 8; ++safety) {
+				const auto it = legacyMap.find(id);
+				if (it == legacyMap.end() || !accept(id, it->second)) {
+					break;
+				}
+				id = it->second;
+			}
+			sink += id;
+		}
+		Bench::DoNotOptimize(sink);
+	}));
+
+	Bench::Report("compiled: one probe", kLookups, Bench::Measure(50, [&]() {
+		for (std::size_t i = 0; i < kLookups; ++i) {
+			sink += VR::Resolve(roots, probes[(i * 7919u) % probes.size()]);
+		}
+		Bench::DoNotOptimize(sink);
+	}));
+	return 0;
+}
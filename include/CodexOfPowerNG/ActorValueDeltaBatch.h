@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace CodexOfPowerNG::ActorValueSync
+{
+	// Sources that write the player's permanent AV modifiers. Each keeps its own bookkeeping
+	// (reward totals, applied build effect totals); only the actor writes are merged.
+	enum class Layer : std::uint8_t
+	{
+		kRewards,
+		kBuildEffects,
+	};
+
+	inline constexpr std::size_t kLayerCount = static_cast<std::size_t>(Layer::kBuildEffects) + 1;
+
+	struct DeltaBatchStats
+	{
+		std::array<std::size_t, kLayerCount> staged{};
+		std::size_t                          writes{ 0 };
+		std::size_t                          cancelled{ 0 };  // touched, but the layers summed to ~0
+	};
+
+	// Permanent-modifier deltas staged by every layer during one action, dense by AV index, so an AV
+	// touched by several layers (or several times) gets a single net write.
+	template <std::size_t Count>
+	class DeltaBatch
+	{
+	public:
+		// False (nothing staged) for an index outside the table.
+		bool Add(std::size_t av, Layer layer, float delta) noexcept
+		{
+			if (av >= Count) {
+				return false;
+			}
+			if (!_touchedMask.test(av)) {
+				_touchedMask.set(av);
+				_touched.push_back(static_cast<std::uint32_t>(av));
+			}
+			_net[av] += delta;
+			++_stats.staged[static_cast<std::size_t>(layer)];
+			return true;
+		}
+
+		[[nodiscard]] float Pending(std::size_t av) const noexcept { return av < Count ? _net[av] : 0.0f; }
+		[[nodiscard]] bool  Empty() const noexcept { return _touched.empty(); }
+		[[nodiscard]] std::size_t TouchedCount() const noexcept { return _touched.size(); }
+
+		// Calls `write(av, netDelta)` once per touched AV whose net delta is outside `epsilon`, in
+		// first-touch order, then resets the batch. Returns the stats of the flushed batch.
+		template <class Write>
+		DeltaBatchStats Flush(Write&& write, float epsilon)
+		{
+			auto stats = _stats;
+			for (const auto av : _touched) {
+				const float net = _net[av];
+				_net[av] = 0.0f;
+				if (std::abs(net) <= epsilon) {
+					++stats.cancelled;
+					continue;
+				}
+				write(static_cast<std::size_t>(av), net);
+				++stats.writes;
+			}
+			_touched.clear();
+			_touchedMask.reset();
+			_stats = {};
+			return stats;
+		}
+
+	private:
+		std::array<float, Count>   _net{};
+		std::bitset<Count>         _touchedMask;
+		std::vector<std::uint32_t> _touched;
+		DeltaBatchStats            _stats{};
+	};
+}
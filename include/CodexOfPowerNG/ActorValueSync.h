@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CodexOfPowerNG/ActorValueDeltaBatch.h"
+
+#include <RE/Skyrim.h>
+
+namespace CodexOfPowerNG::ActorValueSync
+{
+	// While one is alive on this thread, reward and build-effect writes are staged and applied when
+	// the outermost scope ends: one permanent-modifier write per AV, then at most one weapon ability
+	// refresh. Nested scopes join the outermost one. If the player is gone when it ends, the writes
+	// stay staged for the next batch, since the layers have already booked them.
+	class [[nodiscard]] WriteBatch
+	{
+	public:
+		WriteBatch() noexcept;
+		~WriteBatch();
+
+		WriteBatch(const WriteBatch&) = delete;
+		WriteBatch& operator=(const WriteBatch&) = delete;
+	};
+
+	// Adds `delta` to the player's permanent modifier for `av`: staged inside a WriteBatch,
+	// applied at once otherwise. Returns false when the player is unavailable for an immediate write.
+	bool ApplyPermanentDelta(RE::ActorValue av, float delta, Layer layer) noexcept;
+
+	// Staged but not yet applied delta for `av` on this thread (0 outside a WriteBatch).
+	[[nodiscard]] float PendingDelta(RE::ActorValue av) noexcept;
+
+	// Re-runs UpdateWeaponAbility for equipped weapons so attack/weapon-speed changes reach them;
+	// deferred to the end of the current WriteBatch.
+	void RequestWeaponAbilityRefresh() noexcept;
+
+	// Load boundary: drops writes still staged for the previous save's player on this thread.
+	void DiscardStagedForLoad() noexcept;
+}
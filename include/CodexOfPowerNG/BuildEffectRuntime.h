@@ -1,14 +1,15 @@
 #pragma once
 
 #include "CodexOfPowerNG/BuildTypes.h"
+#include "CodexOfPowerNG/State.h"
 
 #include <RE/Skyrim.h>
 
 #include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string>
-#include <utility>
-#include <vector>
 
 namespace CodexOfPowerNG::Builds
 {
@@ -23,14 +24,27 @@ namespace CodexOfPowerNG::Builds
 		std::array<std::string, kBuildSlotCount> activeBuildSlots{};
 	};
 
-	[[nodiscard]] std::vector<std::pair<RE::ActorValue, float>> ComputeDerivedBuildActorValueTotals(
-		const BuildRuntimeSnapshot& snapshot) noexcept;
+	[[nodiscard]] ActorValueTotals ComputeDerivedBuildActorValueTotals(const BuildRuntimeSnapshot& snapshot) noexcept;
 	[[nodiscard]] float ClampBuildSyncDeltaForActorValue(
 		RE::ActorValue av,
 		float          currentActorValue,
 		float          desiredDelta) noexcept;
 
 	void SyncCurrentBuildEffectsToPlayer() noexcept;
+
+	// Progress of a build effect sync spread over several slices (post-load).
+	struct BuildEffectSyncCursor
+	{
+		std::size_t nextActorValue{ 0 };
+		bool        refreshWeaponAbilities{ false };
+	};
+
+	// SyncCurrentBuildEffectsToPlayer in budget-bounded slices: syncs AVs from `cursor` on until
+	// `budget` is spent (after at least one AV). True once every AV is synced; the weapon ability
+	// refresh, if any AV needed it, is requested once in that last slice.
+	[[nodiscard]] bool SyncCurrentBuildEffectsToPlayerSlice(
+		BuildEffectSyncCursor&    cursor,
+		std::chrono::microseconds budget) noexcept;
 	void ResetForLoad() noexcept;
 }
 
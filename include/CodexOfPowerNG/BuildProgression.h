@@ -2,7 +2,11 @@
 
 #include "CodexOfPowerNG/SerializationStateStore.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace CodexOfPowerNG::BuildProgression
 {
@@ -25,9 +29,37 @@ namespace CodexOfPowerNG::BuildProgression
 		std::uint32_t            legacyGroup,
 		LegacyDisciplineResolver resolver = nullptr) noexcept;
 
+	// Legacy build scores re-derived from registered items, tallied over several calls so a large
+	// pre-build save does not stall one frame. Registration stays closed until post-load is ready,
+	// so the items cannot change while the tally runs.
+	struct LegacyScoreTally
+	{
+		std::vector<std::pair<RE::FormID, std::uint32_t>> items{};
+		std::size_t                                       next{ 0u };
+		std::uint32_t                                     attackScore{ 0u };
+		std::uint32_t                                     defenseScore{ 0u };
+		std::uint32_t                                     utilityScore{ 0u };
+		Builds::BuildPointCenti                           attackBuildPointsCenti{ 0u };
+		Builds::BuildPointCenti                           defenseBuildPointsCenti{ 0u };
+		Builds::BuildPointCenti                           utilityBuildPointsCenti{ 0u };
+		std::uint32_t                                     unresolvedHistoricalRegistrations{ 0u };
+
+		[[nodiscard]] bool Finished() const noexcept { return next >= items.size(); }
+	};
+
+	// Empty (already finished) unless `snapshot` still needs the legacy migration.
+	[[nodiscard]] LegacyScoreTally BeginLegacyScoreTally(const SerializationStateStore::Snapshot& snapshot);
+	// Counts up to `maxItems` more items; true once every item is counted.
+	[[nodiscard]] bool ContinueLegacyScoreTally(
+		LegacyScoreTally&        tally,
+		std::size_t              maxItems,
+		LegacyDisciplineResolver resolver = nullptr) noexcept;
+
+	// A finished `tally` begun from the same registered items replaces the item walk.
 	void NormalizeLoadedSnapshot(
 		SerializationStateStore::Snapshot& snapshot,
-		LegacyDisciplineResolver           resolver = nullptr) noexcept;
+		LegacyDisciplineResolver           resolver = nullptr,
+		const LegacyScoreTally*            tally = nullptr) noexcept;
 
 	[[nodiscard]] bool TryFinalizePendingMigration(
 		SerializationStateStore::Snapshot& snapshot,
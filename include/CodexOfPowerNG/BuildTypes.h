@@ -75,6 +75,7 @@ namespace CodexOfPowerNG::Builds
 
 	using BuildMagnitude = std::variant<float, std::int32_t>;
 	using BuildPointCenti = std::uint32_t;
+	inline constexpr std::size_t kBuildDisciplineCount = static_cast<std::size_t>(BuildDiscipline::Utility) + 1;
 	inline constexpr std::size_t kBuildSlotCount = static_cast<std::size_t>(BuildSlotId::Wildcard1) + 1;
 	inline constexpr BuildPointCenti kBuildPointScale = 100u;
 	inline constexpr BuildPointCenti kBuildPointsPerTierCenti = 800u;
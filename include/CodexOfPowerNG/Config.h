@@ -5,6 +5,11 @@
 
 namespace CodexOfPowerNG
 {
+	namespace Startup
+	{
+		class WorkerPool;
+	}
+
 	struct Settings
 	{
 		// UI / input
@@ -38,11 +43,16 @@ namespace CodexOfPowerNG
 	[[nodiscard]] Settings GetSettings();
 	void                  SetSettings(const Settings& settings);
 
+	// Settings::normalizeRegistration without copying the whole struct (registration key hot path).
+	[[nodiscard]] bool IsRegistrationNormalized() noexcept;
+
 	// Clamps setting values to their valid ranges.
 	[[nodiscard]] Settings ClampSettings(const Settings& settings);
 
 	// Loads from disk and replaces current settings (falls back to defaults on error).
 	void LoadSettingsFromDisk();
+	// Runs LoadSettingsFromDisk() as a pool stage; GetSettings() blocks until it has finished.
+	void LoadSettingsFromDiskAsync(Startup::WorkerPool& pool);
 	// Saves current settings to disk.
 	bool SaveSettingsToDisk();
 
@@ -8,6 +8,7 @@ namespace CodexOfPowerNG
 	inline constexpr auto kPrismaUIViewPath = "codexofpowerng/index.html";
 
 	// Paths are relative to the game runtime directory (SkyrimSE.exe).
+	inline constexpr auto kGameDataDir = "Data";
 	inline constexpr auto kPluginDataDir = "Data/SKSE/Plugins/CodexOfPowerNG";
 	// Distributed defaults/template (can be replaced by mod updates).
 	inline constexpr auto kSettingsPath = "Data/SKSE/Plugins/CodexOfPowerNG/settings.json";
@@ -18,6 +19,8 @@ namespace CodexOfPowerNG
 	inline constexpr auto kExcludeUserPath = "Data/SKSE/Plugins/CodexOfPowerNG/exclude_user.json";
 	inline constexpr auto kVariantMapPath = "Data/SKSE/Plugins/CodexOfPowerNG/variant_map.json";
 	inline constexpr std::uint32_t kExcludePatchMax = 32;
+	// Resolved exclude/variant maps, keyed by source stamps and load order (rebuilt when stale).
+	inline constexpr auto kMapsCachePath = "Data/SKSE/Plugins/CodexOfPowerNG/maps.cache";
 
 	inline constexpr std::uint32_t kSerializationUniqueId = 'CPNG';
 	inline constexpr std::uint32_t kSerializationVersion = 2;
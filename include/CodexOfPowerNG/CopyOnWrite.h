@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace CodexOfPowerNG::Containers
+{
+	// Value with shared, immutable copies: copying is a refcount bump and Write() clones the value
+	// only while another copy still holds it. Same threading rules as FlatFormIdTable: copies may
+	// be read and dropped on other threads, writes to one object need external locking. A default
+	// constructed or moved-from box reads as a value-initialized T and allocates on first write.
+	template <class T>
+	class CopyOnWrite
+	{
+	public:
+		CopyOnWrite() = default;
+		explicit CopyOnWrite(T value) :
+			_value(std::make_shared<T>(std::move(value)))
+		{}
+
+		[[nodiscard]] const T& Read() const noexcept { return _value ? *_value : Empty(); }
+		[[nodiscard]] const T& operator*() const noexcept { return Read(); }
+		[[nodiscard]] const T* operator->() const noexcept { return &Read(); }
+
+		[[nodiscard]] T& Write()
+		{
+			if (!_value) {
+				_value = std::make_shared<T>();
+			} else if (_value.use_count() != 1) {
+				_value = std::make_shared<T>(*_value);
+			} else {
+				// See FlatFormIdTable::IsUnique: the other owners' reads happen before this write.
+				std::atomic_thread_fence(std::memory_order_acquire);
+			}
+			return *_value;
+		}
+
+		[[nodiscard]] bool SharesWith(const CopyOnWrite& other) const noexcept
+		{
+			return _value != nullptr && _value == other._value;
+		}
+
+	private:
+		[[nodiscard]] static const T& Empty() noexcept
+		{
+			static const T empty{};
+			return empty;
+		}
+
+		std::shared_ptr<T> _value;
+	};
+}
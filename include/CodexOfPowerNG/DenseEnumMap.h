@@ -0,0 +1,275 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace CodexOfPowerNG::Containers
+{
+	// Map from a small dense enum (0..Count-1) to a number: one cache-aligned value array indexed
+	// by the key plus a presence bitmask. Absent slots always hold zero, so whole-table arithmetic
+	// (Difference, Prune) is a straight loop over the array that never looks at the mask.
+	//
+	// Mirrors the std::unordered_map members the state stores and RewardStateStore::Ops use, and
+	// iterates in key order. Dereferencing an iterator yields a (key, value reference) pair by
+	// value; bind it with `const auto&` or `auto&&`. Keys outside the table are never present:
+	// lookups miss and inserts are dropped. Copies are a flat memcpy of the whole table.
+	template <class Key, std::size_t Count, class T = float>
+	class DenseEnumMap
+	{
+		static_assert(std::is_arithmetic_v<T>, "dense enum maps hold arithmetic values only");
+
+		static constexpr std::size_t kWordBits = 64;
+		static constexpr std::size_t kWords = (Count + kWordBits - 1) / kWordBits;
+		static constexpr std::size_t kNone = Count;
+
+		template <bool kConst>
+		class BasicIterator
+		{
+			using Table = std::conditional_t<kConst, const DenseEnumMap, DenseEnumMap>;
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::pair<Key, T>;
+			using difference_type = std::ptrdiff_t;
+			using reference = std::pair<Key, std::conditional_t<kConst, const T&, T&>>;
+
+			// `it->second = value` writes through to the table.
+			struct pointer
+			{
+				reference entry;
+
+				[[nodiscard]] reference* operator->() noexcept { return &entry; }
+			};
+
+			BasicIterator() = default;
+			BasicIterator(Table* table, std::size_t index) noexcept :
+				_table(table),
+				_index(index)
+			{}
+
+			operator BasicIterator<true>() const noexcept requires(!kConst)
+			{
+				return BasicIterator<true>(_table, _index);
+			}
+
+			[[nodiscard]] reference operator*() const noexcept
+			{
+				return reference{ static_cast<Key>(_index), _table->_values[_index] };
+			}
+
+			[[nodiscard]] pointer operator->() const noexcept { return pointer{ **this }; }
+
+			BasicIterator& operator++() noexcept
+			{
+				_index = _table->NextPresent(_index + 1);
+				return *this;
+			}
+
+			BasicIterator operator++(int) noexcept
+			{
+				auto copy = *this;
+				++*this;
+				return copy;
+			}
+
+			[[nodiscard]] friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+			{
+				return lhs._index == rhs._index;
+			}
+
+		private:
+			friend class DenseEnumMap;
+
+			Table*      _table{ nullptr };
+			std::size_t _index{ kNone };
+		};
+
+	public:
+		using key_type = Key;
+		using mapped_type = T;
+		using size_type = std::size_t;
+		using iterator = BasicIterator<false>;
+		using const_iterator = BasicIterator<true>;
+
+		static constexpr std::size_t kCapacity = Count;
+
+		[[nodiscard]] iterator       begin() noexcept { return iterator(this, NextPresent(0)); }
+		[[nodiscard]] const_iterator begin() const noexcept { return const_iterator(this, NextPresent(0)); }
+		[[nodiscard]] iterator       end() noexcept { return iterator(this, kNone); }
+		[[nodiscard]] const_iterator end() const noexcept { return const_iterator(this, kNone); }
+
+		[[nodiscard]] bool      empty() const noexcept { return _size == 0; }
+		[[nodiscard]] size_type size() const noexcept { return _size; }
+
+		[[nodiscard]] bool contains(const Key& key) const noexcept
+		{
+			const auto index = IndexOf(key);
+			return index != kNone && Test(index);
+		}
+
+		[[nodiscard]] iterator find(const Key& key) noexcept { return iterator(this, contains(key) ? IndexOf(key) : kNone); }
+
+		[[nodiscard]] const_iterator find(const Key& key) const noexcept
+		{
+			return const_iterator(this, contains(key) ? IndexOf(key) : kNone);
+		}
+
+		// Zero when absent.
+		[[nodiscard]] T Value(const Key& key) const noexcept
+		{
+			const auto index = IndexOf(key);
+			return index != kNone ? _values[index] : T{};
+		}
+
+		std::pair<iterator, bool> insert_or_assign(const Key& key, T value) noexcept
+		{
+			const auto index = IndexOf(key);
+			if (index == kNone) {
+				return { end(), false };
+			}
+			const bool inserted = Mark(index);
+			_values[index] = value;
+			return { iterator(this, index), inserted };
+		}
+
+		std::pair<iterator, bool> emplace(const Key& key, T value) noexcept
+		{
+			const auto index = IndexOf(key);
+			if (index == kNone) {
+				return { end(), false };
+			}
+			if (!Mark(index)) {
+				return { iterator(this, index), false };
+			}
+			_values[index] = value;
+			return { iterator(this, index), true };
+		}
+
+		// Adds `delta` to the key's value, inserting it at zero first.
+		void Accumulate(const Key& key, T delta) noexcept
+		{
+			const auto index = IndexOf(key);
+			if (index == kNone) {
+				return;
+			}
+			(void)Mark(index);
+			_values[index] += delta;
+		}
+
+		size_type erase(const Key& key) noexcept
+		{
+			const auto index = IndexOf(key);
+			if (index == kNone || !Test(index)) {
+				return 0;
+			}
+			Unmark(index);
+			return 1;
+		}
+
+		iterator erase(const_iterator pos) noexcept
+		{
+			const auto index = pos._index;
+			Unmark(index);
+			return iterator(this, NextPresent(index + 1));
+		}
+
+		void clear() noexcept
+		{
+			_values.fill(T{});
+			_present.fill(0);
+			_size = 0;
+		}
+
+		// `lhs - rhs` for every key present on either side. Keys whose difference is zero stay
+		// present, so the result also walks the union of both key sets.
+		[[nodiscard]] static DenseEnumMap Difference(const DenseEnumMap& lhs, const DenseEnumMap& rhs) noexcept
+		{
+			DenseEnumMap out;
+			for (std::size_t i = 0; i < Count; ++i) {
+				out._values[i] = lhs._values[i] - rhs._values[i];
+			}
+			for (std::size_t word = 0; word < kWords; ++word) {
+				out._present[word] = lhs._present[word] | rhs._present[word];
+				out._size += static_cast<std::size_t>(std::popcount(out._present[word]));
+			}
+			return out;
+		}
+
+		// Drops every entry with |value| <= epsilon. Returns how many were dropped.
+		size_type Prune(T epsilon) noexcept
+		{
+			for (std::size_t i = 0; i < Count; ++i) {
+				_values[i] = std::abs(_values[i]) <= epsilon ? T{} : _values[i];
+			}
+
+			size_type dropped = 0;
+			for (std::size_t word = 0; word < kWords; ++word) {
+				for (auto bits = _present[word]; bits != 0; bits &= bits - 1) {
+					const auto index = word * kWordBits + static_cast<std::size_t>(std::countr_zero(bits));
+					if (_values[index] == T{}) {
+						_present[word] &= ~(std::uint64_t{ 1 } << (index % kWordBits));
+						++dropped;
+					}
+				}
+			}
+			_size -= dropped;
+			return dropped;
+		}
+
+		[[nodiscard]] friend bool operator==(const DenseEnumMap&, const DenseEnumMap&) = default;
+
+	private:
+		[[nodiscard]] static std::size_t IndexOf(const Key& key) noexcept
+		{
+			const auto index = static_cast<std::size_t>(key);
+			return index < Count ? index : kNone;
+		}
+
+		[[nodiscard]] bool Test(std::size_t index) const noexcept
+		{
+			return (_present[index / kWordBits] >> (index % kWordBits)) & 1u;
+		}
+
+		// True when the key was absent.
+		bool Mark(std::size_t index) noexcept
+		{
+			if (Test(index)) {
+				return false;
+			}
+			_present[index / kWordBits] |= std::uint64_t{ 1 } << (index % kWordBits);
+			++_size;
+			return true;
+		}
+
+		void Unmark(std::size_t index) noexcept
+		{
+			_present[index / kWordBits] &= ~(std::uint64_t{ 1 } << (index % kWordBits));
+			_values[index] = T{};
+			--_size;
+		}
+
+		[[nodiscard]] std::size_t NextPresent(std::size_t from) const noexcept
+		{
+			for (auto word = from / kWordBits; word < kWords; ++word) {
+				auto bits = _present[word];
+				if (word == from / kWordBits) {
+					bits &= ~std::uint64_t{ 0 } << (from % kWordBits);
+				}
+				if (bits != 0) {
+					return word * kWordBits + static_cast<std::size_t>(std::countr_zero(bits));
+				}
+			}
+			return kNone;
+		}
+
+		alignas(64) std::array<T, Count> _values{};
+		std::array<std::uint64_t, kWords> _present{};
+		std::size_t                        _size{ 0 };
+	};
+}
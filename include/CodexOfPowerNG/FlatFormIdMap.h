@@ -0,0 +1,511 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define CODEXOFPOWERNG_FLAT_ID_SSE2 1
+#	include <emmintrin.h>
+#endif
+
+namespace CodexOfPowerNG::Containers
+{
+	template <class Mapped>
+	struct FlatFormIdEntry
+	{
+		std::uint32_t first;
+		Mapped        second;
+	};
+
+	// Open-addressing hash set (`Mapped = void`) / map keyed by 32-bit form ids.
+	//
+	// One control byte per slot holds 7 bits of the hash (or empty/deleted); lookups compare a whole
+	// 16-byte group of control bytes at once (SSE2, scalar fallback) and only touch slots whose byte
+	// matches. Control bytes and slots are two flat arrays of trivially copyable data.
+	//
+	// Copies share those arrays (refcounted, frozen while shared): copying a table is O(1) and the
+	// first write to a shared copy clones the arrays with two memcpys, keeping slot positions. A
+	// copy may be read and destroyed on another thread while the original keeps changing; writes
+	// to one table object need the same external locking as a std container. Non-const map
+	// iteration and find() hand out mutable references, so they unshare first; iterate through a
+	// const reference to avoid that. Mirrors the std::unordered_set/map members the state stores
+	// use; iterators and references are invalidated by any insert, erase leaves others valid.
+	template <class Mapped>
+	class FlatFormIdTable
+	{
+		static constexpr bool kIsSet = std::is_void_v<Mapped>;
+
+		using Slot = std::conditional_t<kIsSet, std::uint32_t, FlatFormIdEntry<std::conditional_t<kIsSet, char, Mapped>>>;
+		static_assert(std::is_trivially_copyable_v<Slot>, "flat form id tables hold trivially copyable values only");
+
+		static constexpr std::size_t kGroupWidth = 16;
+		static constexpr std::int8_t kEmpty = -128;
+		static constexpr std::int8_t kDeleted = -2;
+
+		struct Storage
+		{
+			std::vector<std::int8_t> ctrl;
+			std::vector<Slot>        slots;
+		};
+
+		template <bool kConst>
+		class BasicIterator
+		{
+			using Table = std::conditional_t<kConst, const FlatFormIdTable, FlatFormIdTable>;
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = Slot;
+			using difference_type = std::ptrdiff_t;
+			using reference = std::conditional_t<kConst, const Slot&, Slot&>;
+			using pointer = std::conditional_t<kConst, const Slot*, Slot*>;
+
+			BasicIterator() = default;
+			BasicIterator(Table* table, std::size_t index) noexcept :
+				_table(table),
+				_index(index)
+			{}
+
+			operator BasicIterator<true>() const noexcept requires(!kConst)
+			{
+				return BasicIterator<true>(_table, _index);
+			}
+
+			[[nodiscard]] reference operator*() const noexcept { return _table->_slots[_index]; }
+			[[nodiscard]] pointer   operator->() const noexcept { return &_table->_slots[_index]; }
+
+			BasicIterator& operator++() noexcept
+			{
+				_index = _table->NextFull(_index + 1);
+				return *this;
+			}
+
+			BasicIterator operator++(int) noexcept
+			{
+				auto previous = *this;
+				++*this;
+				return previous;
+			}
+
+			[[nodiscard]] friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept
+			{
+				return lhs._index == rhs._index;
+			}
+
+		private:
+			friend class FlatFormIdTable;
+
+			Table*      _table{ nullptr };
+			std::size_t _index{ 0 };
+		};
+
+	public:
+		using key_type = std::uint32_t;
+		using mapped_type = Mapped;
+		using value_type = Slot;
+		using size_type = std::size_t;
+		using const_iterator = BasicIterator<true>;
+		using iterator = std::conditional_t<kIsSet, const_iterator, BasicIterator<false>>;
+
+		FlatFormIdTable() = default;
+		FlatFormIdTable(const FlatFormIdTable&) = default;
+		FlatFormIdTable& operator=(const FlatFormIdTable&) = default;
+
+		FlatFormIdTable(FlatFormIdTable&& other) noexcept :
+			_storage(std::move(other._storage)),
+			_ctrl(std::exchange(other._ctrl, nullptr)),
+			_slots(std::exchange(other._slots, nullptr)),
+			_capacity(std::exchange(other._capacity, 0)),
+			_size(std::exchange(other._size, 0)),
+			_growthLeft(std::exchange(other._growthLeft, 0))
+		{}
+
+		FlatFormIdTable& operator=(FlatFormIdTable&& other) noexcept
+		{
+			if (this != &other) {
+				_storage = std::move(other._storage);
+				_ctrl = std::exchange(other._ctrl, nullptr);
+				_slots = std::exchange(other._slots, nullptr);
+				_capacity = std::exchange(other._capacity, 0);
+				_size = std::exchange(other._size, 0);
+				_growthLeft = std::exchange(other._growthLeft, 0);
+			}
+			return *this;
+		}
+
+		FlatFormIdTable(std::initializer_list<Slot> values)
+		{
+			reserve(values.size());
+			for (const auto& value : values) {
+				if constexpr (kIsSet) {
+					insert(value);
+				} else {
+					insert_or_assign(value.first, value.second);
+				}
+			}
+		}
+
+		[[nodiscard]] size_type size() const noexcept { return _size; }
+		[[nodiscard]] bool      empty() const noexcept { return _size == 0; }
+		[[nodiscard]] size_type capacity() const noexcept { return _capacity; }
+
+		// True when both tables still read the same arrays (neither was written since the copy).
+		[[nodiscard]] bool shares_storage_with(const FlatFormIdTable& other) const noexcept
+		{
+			return _storage != nullptr && _storage == other._storage;
+		}
+
+		[[nodiscard]] iterator begin()
+		{
+			if constexpr (!kIsSet) {
+				Unshare();
+			}
+			return iterator(this, NextFull(0));
+		}
+
+		[[nodiscard]] iterator       end() noexcept { return iterator(this, _capacity); }
+		[[nodiscard]] const_iterator begin() const noexcept { return const_iterator(this, NextFull(0)); }
+		[[nodiscard]] const_iterator end() const noexcept { return const_iterator(this, _capacity); }
+
+		void clear() noexcept
+		{
+			if (!IsUnique()) {
+				*this = FlatFormIdTable{};
+				return;
+			}
+			std::fill(_storage->ctrl.begin(), _storage->ctrl.end(), kEmpty);
+			_size = 0;
+			_growthLeft = MaxLoad(_capacity);
+		}
+
+		void reserve(size_type count)
+		{
+			const auto needed = CapacityFor(count);
+			if (needed > _capacity) {
+				Rehash(needed);
+			}
+		}
+
+		[[nodiscard]] iterator find(key_type key)
+		{
+			const auto index = FindIndex(key);
+			if constexpr (!kIsSet) {
+				if (index != _capacity) {
+					Unshare();
+				}
+			}
+			return iterator(this, index);
+		}
+
+		[[nodiscard]] const_iterator find(key_type key) const noexcept { return const_iterator(this, FindIndex(key)); }
+		[[nodiscard]] bool      contains(key_type key) const noexcept { return FindIndex(key) != _capacity; }
+		[[nodiscard]] size_type count(key_type key) const noexcept { return contains(key) ? 1u : 0u; }
+
+		std::pair<iterator, bool> insert(key_type key) requires kIsSet
+		{
+			const auto [index, inserted] = FindOrPrepareInsert(key);
+			if (inserted) {
+				_slots[index] = key;
+			}
+			return { iterator(this, index), inserted };
+		}
+
+		std::pair<iterator, bool> emplace(key_type key) requires kIsSet
+		{
+			return insert(key);
+		}
+
+		template <class Value>
+		std::pair<iterator, bool> try_emplace(key_type key, Value&& value) requires(!kIsSet)
+		{
+			const auto [index, inserted] = FindOrPrepareInsert(key);
+			if (inserted) {
+				_slots[index] = Slot{ key, static_cast<Mapped>(std::forward<Value>(value)) };
+			} else {
+				Unshare();
+			}
+			return { iterator(this, index), inserted };
+		}
+
+		template <class Value>
+		std::pair<iterator, bool> emplace(key_type key, Value&& value) requires(!kIsSet)
+		{
+			return try_emplace(key, std::forward<Value>(value));
+		}
+
+		template <class Value>
+		std::pair<iterator, bool> insert_or_assign(key_type key, Value&& value) requires(!kIsSet)
+		{
+			const auto [index, inserted] = FindOrPrepareInsert(key);
+			if (!inserted) {
+				Unshare();
+			}
+			_slots[index] = Slot{ key, static_cast<Mapped>(std::forward<Value>(value)) };
+			return { iterator(this, index), inserted };
+		}
+
+		auto& operator[](key_type key) requires(!kIsSet)
+		{
+			return try_emplace(key, Mapped{}).first->second;
+		}
+
+		iterator erase(const_iterator position)
+		{
+			Unshare();
+			EraseAt(position._index);
+			return iterator(this, NextFull(position._index + 1));
+		}
+
+		size_type erase(key_type key)
+		{
+			const auto index = FindIndex(key);
+			if (index == _capacity) {
+				return 0;
+			}
+			Unshare();
+			EraseAt(index);
+			return 1;
+		}
+
+		[[nodiscard]] friend bool operator==(const FlatFormIdTable& lhs, const FlatFormIdTable& rhs) noexcept
+		{
+			if (lhs._size != rhs._size) {
+				return false;
+			}
+			if (lhs._storage == rhs._storage) {
+				return true;
+			}
+			for (const auto& slot : lhs) {
+				if constexpr (kIsSet) {
+					if (!rhs.contains(slot)) {
+						return false;
+					}
+				} else {
+					const auto it = rhs.find(slot.first);
+					if (it == rhs.end() || !(it->second == slot.second)) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+	private:
+		[[nodiscard]] static constexpr std::uint64_t Hash(key_type key) noexcept
+		{
+			return static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+		}
+
+		[[nodiscard]] static constexpr std::size_t H1(std::uint64_t hash) noexcept { return static_cast<std::size_t>(hash >> 32); }
+		[[nodiscard]] static constexpr std::int8_t H2(std::uint64_t hash) noexcept { return static_cast<std::int8_t>(hash >> 57); }
+
+		[[nodiscard]] static constexpr key_type KeyOf(const Slot& slot) noexcept
+		{
+			if constexpr (kIsSet) {
+				return slot;
+			} else {
+				return slot.first;
+			}
+		}
+
+		[[nodiscard]] static constexpr std::size_t MaxLoad(std::size_t capacity) noexcept { return capacity - capacity / 8; }
+
+		[[nodiscard]] static constexpr std::size_t CapacityFor(std::size_t count) noexcept
+		{
+			if (count == 0) {
+				return 0;
+			}
+			std::size_t capacity = kGroupWidth;
+			while (MaxLoad(capacity) < count) {
+				capacity *= 2;
+			}
+			return capacity;
+		}
+
+		// Bit i set when control byte i of the group equals `value`.
+		[[nodiscard]] static std::uint32_t Match(const std::int8_t* group, std::int8_t value) noexcept
+		{
+#if defined(CODEXOFPOWERNG_FLAT_ID_SSE2)
+			const auto ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(value))));
+#else
+			std::uint32_t mask = 0;
+			for (std::size_t i = 0; i < kGroupWidth; ++i) {
+				mask |= static_cast<std::uint32_t>(group[i] == value) << i;
+			}
+			return mask;
+#endif
+		}
+
+		// Bit i set when slot i of the group is empty or deleted (the control byte's sign bit).
+		[[nodiscard]] static std::uint32_t MatchFree(const std::int8_t* group) noexcept
+		{
+#if defined(CODEXOFPOWERNG_FLAT_ID_SSE2)
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#else
+			std::uint32_t mask = 0;
+			for (std::size_t i = 0; i < kGroupWidth; ++i) {
+				mask |= static_cast<std::uint32_t>(group[i] < 0) << i;
+			}
+			return mask;
+#endif
+		}
+
+		[[nodiscard]] bool IsUnique() const noexcept
+		{
+			if (_storage.use_count() != 1) {
+				return false;
+			}
+			// Pairs with the release in the last other owner's refcount decrement, so its reads of the
+			// arrays happen before our writes.
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return true;
+		}
+
+		void Bind() noexcept
+		{
+			_ctrl = _storage ? _storage->ctrl.data() : nullptr;
+			_slots = _storage ? _storage->slots.data() : nullptr;
+			_capacity = _storage ? _storage->ctrl.size() : 0;
+		}
+
+		// Gives this table its own arrays before a write; slot positions are unchanged.
+		void Unshare()
+		{
+			if (_storage && !IsUnique()) {
+				_storage = std::make_shared<Storage>(*_storage);
+				Bind();
+			}
+		}
+
+		[[nodiscard]] std::size_t NextFull(std::size_t index) const noexcept
+		{
+			while (index < _capacity && _ctrl[index] < 0) {
+				++index;
+			}
+			return index;
+		}
+
+		// Slot index of `key`, or capacity() when absent. Groups are probed triangularly, which visits
+		// every group of a power-of-two table; a group with an empty byte ends the probe.
+		[[nodiscard]] std::size_t FindIndex(key_type key) const noexcept
+		{
+			if (_size == 0) {
+				return _capacity;
+			}
+			const auto  hash = Hash(key);
+			const auto  h2 = H2(hash);
+			const auto  groupMask = _capacity / kGroupWidth - 1;
+			std::size_t group = H1(hash) & groupMask;
+			for (std::size_t step = 1;; ++step) {
+				const auto* ctrl = _ctrl + group * kGroupWidth;
+				for (auto mask = Match(ctrl, h2); mask != 0; mask &= mask - 1) {
+					const auto index = group * kGroupWidth + static_cast<std::size_t>(std::countr_zero(mask));
+					if (KeyOf(_slots[index]) == key) {
+						return index;
+					}
+				}
+				if (Match(ctrl, kEmpty) != 0) {
+					return _capacity;
+				}
+				group = (group + step) & groupMask;
+			}
+		}
+
+		[[nodiscard]] std::size_t FindFreeSlot(std::uint64_t hash) const noexcept
+		{
+			const auto  groupMask = _capacity / kGroupWidth - 1;
+			std::size_t group = H1(hash) & groupMask;
+			for (std::size_t step = 1;; ++step) {
+				if (const auto mask = MatchFree(_ctrl + group * kGroupWidth); mask != 0) {
+					return group * kGroupWidth + static_cast<std::size_t>(std::countr_zero(mask));
+				}
+				group = (group + step) & groupMask;
+			}
+		}
+
+		// Returns the slot holding `key`, or claims a free one (control byte set, slot left for the
+		// caller to fill) and reports it as inserted. Only a claim unshares the arrays.
+		[[nodiscard]] std::pair<std::size_t, bool> FindOrPrepareInsert(key_type key)
+		{
+			if (const auto index = FindIndex(key); index != _capacity) {
+				return { index, false };
+			}
+
+			const auto hash = Hash(key);
+			if (_capacity == 0) {
+				Rehash(CapacityFor(1));
+			}
+			Unshare();
+			auto index = FindFreeSlot(hash);
+			if (_growthLeft == 0 && _ctrl[index] == kEmpty) {
+				// Out of empty slots: grow, or just drop the tombstones if the live count still fits.
+				Rehash(CapacityFor(_size + 1));
+				index = FindFreeSlot(hash);
+			}
+			if (_ctrl[index] == kEmpty) {
+				--_growthLeft;
+			}
+			_storage->ctrl[index] = H2(hash);
+			++_size;
+			return { index, true };
+		}
+
+		void EraseAt(std::size_t index) noexcept
+		{
+			--_size;
+			// A group that still has an empty byte never overflowed, so no probe continues past it and
+			// the slot can go straight back to empty instead of becoming a tombstone.
+			const auto* group = _ctrl + (index / kGroupWidth) * kGroupWidth;
+			if (Match(group, kEmpty) != 0) {
+				_storage->ctrl[index] = kEmpty;
+				++_growthLeft;
+			} else {
+				_storage->ctrl[index] = kDeleted;
+			}
+		}
+
+		void Rehash(std::size_t capacity)
+		{
+			auto next = std::make_shared<Storage>();
+			next->ctrl.assign(capacity, kEmpty);
+			next->slots.resize(capacity);
+
+			FlatFormIdTable rebuilt;
+			rebuilt._storage = std::move(next);
+			rebuilt.Bind();
+			rebuilt._size = _size;
+			rebuilt._growthLeft = MaxLoad(capacity) - _size;
+			for (std::size_t i = 0; i < _capacity; ++i) {
+				if (_ctrl[i] >= 0) {
+					const auto hash = Hash(KeyOf(_slots[i]));
+					const auto index = rebuilt.FindFreeSlot(hash);
+					rebuilt._storage->ctrl[index] = H2(hash);
+					rebuilt._slots[index] = _slots[i];
+				}
+			}
+			*this = std::move(rebuilt);
+		}
+
+		std::shared_ptr<Storage> _storage;
+		const std::int8_t*       _ctrl{ nullptr };
+		Slot*                    _slots{ nullptr };
+		std::size_t              _capacity{ 0 };
+		std::size_t              _size{ 0 };
+		std::size_t              _growthLeft{ 0 };
+	};
+
+	using FlatFormIdSet = FlatFormIdTable<void>;
+
+	template <class Mapped>
+	using FlatFormIdMap = FlatFormIdTable<Mapped>;
+}
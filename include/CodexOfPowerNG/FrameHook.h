@@ -0,0 +1,7 @@
+#pragma once
+
+namespace CodexOfPowerNG::FrameHook
+{
+	// Hooks Main::Update so the main task queue sees real game frames. Call once after SKSE::Init.
+	void Install() noexcept;
+}
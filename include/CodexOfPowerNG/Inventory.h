@@ -1,8 +1,11 @@
 #pragma once
 
+#include "CodexOfPowerNG/InventorySnapshot.h"
+
 #include <RE/Skyrim.h>
 
 #include <cstdint>
+#include <memory>
 
 namespace CodexOfPowerNG::Inventory
 {
@@ -18,4 +21,14 @@ namespace CodexOfPowerNG::Inventory
 
 	// Computes a safe removal target for an inventory entry (never removes worn items; optionally protects hotkey items).
 	[[nodiscard]] RemoveSelection SelectSafeRemoval(const RE::InventoryEntryData* entry, std::int32_t totalCount, bool protectFavorites) noexcept;
+
+	using PlayerSnapshot = Snapshot<RE::InventoryEntryData, RemoveSelection>;
+
+	// Counts, entries and removal selections for the whole player inventory from one counting pass
+	// and one entry-list walk. Shared until the inventory changes or the frame ends; entry pointers
+	// must not be kept past either.
+	[[nodiscard]] std::shared_ptr<const PlayerSnapshot> GetPlayerSnapshot(RE::PlayerCharacter& player, bool protectFavorites);
+
+	// Container/equip events and our own inventory edits drop the shared snapshot.
+	void InvalidatePlayerSnapshot() noexcept;
 }
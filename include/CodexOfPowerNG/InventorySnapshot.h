@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG::Inventory
+{
+	// One pass worth of inventory facts: per-object total counts, the inventory-change entry (if
+	// any) and the removal selection computed from both. Filled in three steps so the counting pass
+	// and the entry walk each touch the inventory once; lookups afterwards are a single probe.
+	template <class Entry, class Removal>
+	class Snapshot
+	{
+	public:
+		struct Row
+		{
+			std::uint32_t formId{ 0 };
+			Entry*        entry{ nullptr };  // null when the object only comes from the base container
+			std::int32_t  totalCount{ 0 };
+			Removal       removal{};
+		};
+
+		void Reserve(std::size_t count)
+		{
+			_rows.reserve(count);
+			_index.reserve(count);
+		}
+
+		// Counts for the same object are summed.
+		void AddCount(std::uint32_t formId, std::int32_t count)
+		{
+			if (formId == 0) {
+				return;
+			}
+			if (auto* row = FindMutable(formId)) {
+				row->totalCount += count;
+				return;
+			}
+			Append(formId).totalCount = count;
+		}
+
+		// The first entry seen for an object wins, like a linear search of the entry list would.
+		void AttachEntry(std::uint32_t formId, Entry* entry)
+		{
+			if (formId == 0 || !entry) {
+				return;
+			}
+			auto* row = FindMutable(formId);
+			if (!row) {
+				row = &Append(formId);
+			}
+			if (!row->entry) {
+				row->entry = entry;
+			}
+		}
+
+		// `select(Entry&, std::int32_t totalCount)` runs once per carried object that has an entry.
+		template <class Select>
+		void SelectRemovals(Select&& select)
+		{
+			for (auto& row : _rows) {
+				if (row.entry && row.totalCount > 0) {
+					row.removal = select(*row.entry, row.totalCount);
+				}
+			}
+		}
+
+		[[nodiscard]] const Row* Find(std::uint32_t formId) const noexcept
+		{
+			const auto it = _index.find(formId);
+			return it != _index.end() ? &_rows[it->second] : nullptr;
+		}
+
+		[[nodiscard]] std::int32_t CountOf(std::uint32_t formId) const noexcept
+		{
+			const auto* row = Find(formId);
+			return row ? row->totalCount : 0;
+		}
+
+		// Rows in the order objects were first seen.
+		[[nodiscard]] std::span<const Row> Rows() const noexcept { return _rows; }
+		[[nodiscard]] std::size_t          size() const noexcept { return _rows.size(); }
+		[[nodiscard]] bool                 empty() const noexcept { return _rows.empty(); }
+
+	private:
+		[[nodiscard]] Row* FindMutable(std::uint32_t formId) noexcept
+		{
+			const auto& index = std::as_const(_index);
+			const auto  it = index.find(formId);
+			return it != index.end() ? &_rows[it->second] : nullptr;
+		}
+
+		Row& Append(std::uint32_t formId)
+		{
+			_index.try_emplace(formId, static_cast<std::uint32_t>(_rows.size()));
+			auto& row = _rows.emplace_back();
+			row.formId = formId;
+			return row;
+		}
+
+		std::vector<Row>                         _rows;
+		Containers::FlatFormIdMap<std::uint32_t> _index;
+	};
+}
@@ -1,16 +1,29 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 
+namespace CodexOfPowerNG::Startup
+{
+	class WorkerPool;
+}
+
 namespace CodexOfPowerNG::L10n
 {
 	// Loads localization JSON based on current Settings (auto/en/ko).
 	void Load();
 
+	// Same as Load(), run as a pool stage after the settings stage. The game language is read on the
+	// calling thread; T()/ActiveLanguage()/LanguageGeneration() block until the stage has finished.
+	void LoadAsync(Startup::WorkerPool& pool);
+
 	// Lookup a dotted path (e.g. "msg.rewardPrefix") with fallback.
 	[[nodiscard]] std::string T(std::string_view dottedPath, std::string_view fallback);
 
 	[[nodiscard]] std::string ActiveLanguage();
+
+	// Bumped whenever Load() switches the active language; caches of localized data compare against it.
+	[[nodiscard]] std::uint64_t LanguageGeneration() noexcept;
 }
 
@@ -0,0 +1,350 @@
+#pragma once
+
+#include "CodexOfPowerNG/TaskScheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace CodexOfPowerNG
+{
+	using TaskErrorSink = void (*)(const char* what) noexcept;
+
+	// Cooperative main-thread queue layered over an ITaskScheduler backend. Work runs in pump tasks
+	// posted to the backend, and each game frame gets at most `frameBudget` of it:
+	// - Tick() marks a game frame (FrameHook calls it from Main::Update) and posts a pump if work waits;
+	// - pumps only start tasks queued before the frame's first pump, so self-requeueing and yielded work
+	//   waits a frame;
+	// - once the frame's budget is spent (after at least one slice) leftover work waits for the next Tick().
+	//   The game drains tasks posted during a drain in that same drain, so re-posting would not defer it.
+	// Until the first Tick() (no frame hook), each pump counts as a frame and re-posts itself.
+	template <class Clock = std::chrono::steady_clock>
+	class MainTaskQueue
+	{
+	public:
+		explicit MainTaskQueue(std::chrono::microseconds frameBudget, TaskErrorSink onError = nullptr) noexcept :
+			_frameBudget(frameBudget),
+			_onError(onError)
+		{}
+
+		MainTaskQueue(const MainTaskQueue&) = delete;
+		MainTaskQueue& operator=(const MainTaskQueue&) = delete;
+
+		[[nodiscard]] bool Enqueue(
+			ITaskScheduler&  backend,
+			TaskPriority     priority,
+			std::string_view coalesceKey,
+			ResumableTask    task)
+		{
+			if (!task) {
+				return false;
+			}
+
+			std::uint64_t seq = 0;
+			{
+				std::scoped_lock lock(_mutex);
+				if (!coalesceKey.empty()) {
+					if (auto it = _keyed.find(std::string(coalesceKey)); it != _keyed.end()) {
+						it->second = std::move(task);
+						++_stats.coalesced;
+						return true;
+					}
+				}
+
+				seq = _nextSeq++;
+				Entry entry{};
+				entry.seq = seq;
+				entry.enqueuedAt = Clock::now();
+				if (coalesceKey.empty()) {
+					entry.task = std::move(task);
+				} else {
+					entry.key.assign(coalesceKey);
+					_keyed.emplace(entry.key, std::move(task));
+				}
+				_queues[Index(priority)].push_back(std::move(entry));
+				++_stats.enqueued;
+				_stats.maxQueueDepth = (std::max)(_stats.maxQueueDepth, DepthLocked());
+
+				if (_pumpQueued) {
+					return true;
+				}
+				_pumpQueued = true;
+			}
+
+			if (PostPump(backend)) {
+				return true;
+			}
+
+			// Nothing will run this entry; withdraw it so the caller can report the failure.
+			{
+				std::scoped_lock lock(_mutex);
+				_pumpQueued = false;
+				auto& queue = _queues[Index(priority)];
+				const auto it = std::find_if(queue.begin(), queue.end(), [seq](const Entry& entry) { return entry.seq == seq; });
+				if (it != queue.end()) {
+					if (!it->key.empty()) {
+						_keyed.erase(it->key);
+					}
+					queue.erase(it);
+				}
+				// Callers that enqueued while this pump was being posted were told it would run.
+				if (DepthLocked() == 0) {
+					return false;
+				}
+				_pumpQueued = true;
+			}
+
+			if (!PostPump(backend)) {
+				std::scoped_lock lock(_mutex);
+				_pumpQueued = false;
+				Report("main task queue: backend refused the frame pump");
+			}
+			return false;
+		}
+
+		// Marks the start of a game frame: opens a fresh budget and posts a pump for waiting work.
+		void Tick(ITaskScheduler& backend)
+		{
+			_frameDriven.store(true, std::memory_order_release);
+			_frame.fetch_add(1, std::memory_order_acq_rel);
+			{
+				std::scoped_lock lock(_mutex);
+				if (_pumpQueued || DepthLocked() == 0) {
+					return;
+				}
+				_pumpQueued = true;
+			}
+
+			if (!PostPump(backend)) {
+				std::scoped_lock lock(_mutex);
+				_pumpQueued = false;
+				Report("main task queue: backend refused the frame pump");
+			}
+		}
+
+		// Runs what is left of the current frame's budget; normally called from the pump posted to `backend`.
+		void RunFrame(ITaskScheduler& backend)
+		{
+			const bool driven = _frameDriven.load(std::memory_order_acquire);
+			if (!driven) {
+				_frame.fetch_add(1, std::memory_order_acq_rel);
+			}
+			const auto frame = _frame.load(std::memory_order_acquire);
+			const auto pumpStart = Clock::now();
+
+			std::uint64_t             cutoff = 0;
+			std::chrono::microseconds spentBefore{ 0 };
+			std::size_t               slices = 0;
+			bool                      newFrame = false;
+			{
+				std::scoped_lock lock(_mutex);
+				if (!_budget.open || _budget.frame != frame) {
+					_budget = FrameBudget{ true, frame, _nextSeq, std::chrono::microseconds{ 0 }, 0 };
+					newFrame = true;
+				}
+				cutoff = _budget.cutoff;
+				spentBefore = _budget.spent;
+				slices = _budget.slices;
+			}
+
+			bool morePending = false;
+			for (;;) {
+				const auto elapsed = spentBefore + std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - pumpStart);
+				Entry        entry{};
+				TaskPriority priority{};
+				{
+					std::scoped_lock lock(_mutex);
+					if (slices > 0 && elapsed >= _frameBudget) {
+						morePending = DepthLocked() > 0;
+						break;
+					}
+					if (!PopRunnableLocked(cutoff, entry, priority)) {
+						morePending = DepthLocked() > 0;
+						break;
+					}
+					if (!entry.started) {
+						entry.started = true;
+						const auto latencyUs = ToUs(Clock::now() - entry.enqueuedAt);
+						++_stats.startedTasks;
+						_stats.totalLatencyUs += latencyUs;
+						_stats.maxLatencyUs = (std::max)(_stats.maxLatencyUs, latencyUs);
+					}
+				}
+
+				const auto sliceBudget = elapsed < _frameBudget ? _frameBudget - elapsed : std::chrono::microseconds{ 0 };
+				const auto step = RunSlice(entry.task, sliceBudget);
+				++slices;
+
+				std::scoped_lock lock(_mutex);
+				++_stats.slicesRun;
+				if (step == TaskStep::kYield) {
+					// Resumes next frame: a task that yields early (e.g. polling) must not spin out the budget.
+					entry.seq = _nextSeq++;
+					_queues[Index(priority)].push_back(std::move(entry));
+				}
+			}
+
+			const auto pumpUs = ToUs(Clock::now() - pumpStart);
+			{
+				std::scoped_lock lock(_mutex);
+				const auto budgetUs = static_cast<std::uint64_t>(_frameBudget.count());
+				const auto beforeUs = static_cast<std::uint64_t>(spentBefore.count());
+				const auto frameUs = beforeUs + pumpUs;
+				if (_budget.frame == frame) {
+					_budget.spent = std::chrono::microseconds{ static_cast<std::int64_t>(frameUs) };
+					_budget.slices = slices;
+				}
+				if (newFrame) {
+					++_stats.frames;
+				}
+				_stats.lastFrameUs = frameUs;
+				_stats.maxFrameUs = (std::max)(_stats.maxFrameUs, frameUs);
+				if (frameUs > budgetUs && beforeUs <= budgetUs) {
+					++_stats.framesOverBudget;
+				}
+				// With a frame hook, the next Tick() posts the pump for what is left.
+				if (!morePending || driven) {
+					_pumpQueued = false;
+					return;
+				}
+			}
+
+			if (!PostPump(backend)) {
+				// Left for the next Enqueue, which posts a fresh pump.
+				std::scoped_lock lock(_mutex);
+				_pumpQueued = false;
+				Report("main task queue: backend refused the next frame pump");
+			}
+		}
+
+		// Bumped once per game frame (once per pump before the first Tick), so per-frame caches can tell
+		// that a frame boundary has passed.
+		[[nodiscard]] std::uint64_t CurrentFrame() const noexcept { return _frame.load(std::memory_order_acquire); }
+
+		[[nodiscard]] MainTaskStats Snapshot() const
+		{
+			std::scoped_lock lock(_mutex);
+			auto stats = _stats;
+			for (std::size_t i = 0; i < kTaskPriorityCount; ++i) {
+				stats.queueDepth[i] = _queues[i].size();
+			}
+			return stats;
+		}
+
+	private:
+		struct Entry
+		{
+			std::uint64_t                seq{ 0 };
+			typename Clock::time_point   enqueuedAt{};
+			std::string                  key;
+			ResumableTask                task;
+			bool                         started{ false };
+		};
+
+		// Budget of the frame currently being worked; shared by every pump that runs during it.
+		struct FrameBudget
+		{
+			bool                      open{ false };
+			std::uint64_t             frame{ 0 };
+			std::uint64_t             cutoff{ 0 };
+			std::chrono::microseconds spent{ 0 };
+			std::size_t               slices{ 0 };
+		};
+
+		[[nodiscard]] static constexpr std::size_t Index(TaskPriority priority) noexcept
+		{
+			return (std::min)(static_cast<std::size_t>(priority), kTaskPriorityCount - 1);
+		}
+
+		[[nodiscard]] static std::uint64_t ToUs(typename Clock::duration duration) noexcept
+		{
+			const auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+			return us > 0 ? static_cast<std::uint64_t>(us) : 0u;
+		}
+
+		[[nodiscard]] std::size_t DepthLocked() const noexcept
+		{
+			std::size_t depth = 0;
+			for (const auto& queue : _queues) {
+				depth += queue.size();
+			}
+			return depth;
+		}
+
+		// Highest priority first; a priority whose head was queued during this frame waits for the next one.
+		[[nodiscard]] bool PopRunnableLocked(std::uint64_t cutoff, Entry& out, TaskPriority& priority)
+		{
+			for (std::size_t i = 0; i < kTaskPriorityCount; ++i) {
+				auto& queue = _queues[i];
+				if (queue.empty() || queue.front().seq >= cutoff) {
+					continue;
+				}
+
+				out = std::move(queue.front());
+				queue.pop_front();
+				if (!out.key.empty()) {
+					// Released before running, so a request made while it runs queues a fresh task.
+					if (auto it = _keyed.find(out.key); it != _keyed.end()) {
+						out.task = std::move(it->second);
+						_keyed.erase(it);
+					}
+					out.key.clear();
+				}
+				priority = static_cast<TaskPriority>(i);
+				return true;
+			}
+			return false;
+		}
+
+		[[nodiscard]] TaskStep RunSlice(ResumableTask& task, std::chrono::microseconds sliceBudget) noexcept
+		{
+			if (!task) {
+				return TaskStep::kDone;
+			}
+			try {
+				return task(sliceBudget);
+			} catch (const std::exception& e) {
+				Report(e.what());
+			} catch (...) {
+				Report("unknown exception");
+			}
+			std::scoped_lock lock(_mutex);
+			++_stats.failedTasks;
+			return TaskStep::kDone;
+		}
+
+		[[nodiscard]] bool PostPump(ITaskScheduler& backend)
+		{
+			return backend.AddMainTask([this, &backend]() { RunFrame(backend); });
+		}
+
+		void Report(const char* what) const noexcept
+		{
+			if (_onError) {
+				_onError(what);
+			}
+		}
+
+		mutable std::mutex                                  _mutex;
+		std::array<std::deque<Entry>, kTaskPriorityCount>   _queues{};
+		std::unordered_map<std::string, ResumableTask>      _keyed;
+		std::uint64_t                                       _nextSeq{ 1 };
+		bool                                                _pumpQueued{ false };
+		FrameBudget                                         _budget{};
+		std::atomic<std::uint64_t>                          _frame{ 0 };
+		std::atomic<bool>                                   _frameDriven{ false };
+		MainTaskStats                                       _stats{};
+		std::chrono::microseconds                           _frameBudget;
+		TaskErrorSink                                       _onError{ nullptr };
+	};
+}
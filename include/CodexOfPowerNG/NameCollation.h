@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace CodexOfPowerNG::NameCollation
+{
+	enum class Locale : std::uint8_t
+	{
+		kDefault,
+		kKorean,
+	};
+
+	[[nodiscard]] inline Locale LocaleFor(std::string_view langCode) noexcept
+	{
+		return langCode == "ko" ? Locale::kKorean : Locale::kDefault;
+	}
+
+	namespace Detail
+	{
+		// Primary weight classes; the top byte of every weight.
+		inline constexpr std::uint32_t kClassSymbol = 1;
+		inline constexpr std::uint32_t kClassDigit = 2;
+		inline constexpr std::uint32_t kClassFirstScript = 3;
+		inline constexpr std::uint32_t kClassSecondScript = 4;
+		inline constexpr std::uint32_t kClassOther = 5;
+
+		inline constexpr char32_t kHangulBase = 0xAC00;
+		inline constexpr char32_t kHangulLast = 0xD7A3;
+		inline constexpr char32_t kJamoConsonantFirst = 0x3131;
+		inline constexpr char32_t kJamoConsonantLast = 0x314E;
+		inline constexpr char32_t kJamoVowelFirst = 0x314F;
+		inline constexpr char32_t kJamoVowelLast = 0x3163;
+
+		// Leading consonant (choseong index) for each compatibility consonant U+3131..U+314E.
+		// Clusters that cannot start a syllable sort with their first consonant.
+		inline constexpr std::array<std::uint8_t, 30> kJamoConsonantToLead{
+			0, 1, 0, 2, 2, 2, 3, 4, 5, 5, 5, 5, 5, 5, 5, 5, 6, 7, 8, 7, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18
+		};
+
+		// Base letter for U+00C0..U+00FF (0 = not a Latin letter).
+		inline constexpr std::array<char, 64> kLatin1Fold{
+			'a', 'a', 'a', 'a', 'a', 'a', 'a', 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',
+			'd', 'n', 'o', 'o', 'o', 'o', 'o', 0, 'o', 'u', 'u', 'u', 'u', 'y', 't', 's',
+			'a', 'a', 'a', 'a', 'a', 'a', 'a', 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',
+			'd', 'n', 'o', 'o', 'o', 'o', 'o', 0, 'o', 'u', 'u', 'u', 'u', 'y', 't', 'y'
+		};
+
+		// Decodes one UTF-8 code point; malformed bytes decode as themselves.
+		[[nodiscard]] inline char32_t NextCodePoint(std::string_view text, std::size_t& pos) noexcept
+		{
+			const auto lead = static_cast<unsigned char>(text[pos++]);
+			std::size_t extra = 0;
+			char32_t    cp = lead;
+			if (lead >= 0xF0 && lead < 0xF8) {
+				extra = 3;
+				cp = lead & 0x07u;
+			} else if (lead >= 0xE0) {
+				extra = 2;
+				cp = lead & 0x0Fu;
+			} else if (lead >= 0xC0) {
+				extra = 1;
+				cp = lead & 0x1Fu;
+			}
+			if (lead >= 0xF8 || pos + extra > text.size()) {
+				return lead;
+			}
+			for (std::size_t i = 0; i < extra; ++i) {
+				const auto next = static_cast<unsigned char>(text[pos + i]);
+				if ((next & 0xC0u) != 0x80u) {
+					return lead;
+				}
+				cp = (cp << 6) | (next & 0x3Fu);
+			}
+			pos += extra;
+			return cp;
+		}
+
+		// Hangul weight: syllables order by (lead, vowel, tail); a bare consonant sorts before
+		// every syllable that starts with it, bare vowels after all syllables.
+		[[nodiscard]] inline std::uint32_t HangulWeight(char32_t cp) noexcept
+		{
+			if (cp >= kHangulBase && cp <= kHangulLast) {
+				const auto index = static_cast<std::uint32_t>(cp - kHangulBase);
+				const auto lead = index / (21 * 28);
+				const auto vowel = (index / 28) % 21;
+				const auto tail = index % 28;
+				return lead * 1024 + (vowel + 1) * 32 + tail;
+			}
+			if (cp <= kJamoConsonantLast) {
+				return static_cast<std::uint32_t>(kJamoConsonantToLead[cp - kJamoConsonantFirst]) * 1024;
+			}
+			return 19 * 1024 + static_cast<std::uint32_t>(cp - kJamoVowelFirst + 1) * 32;
+		}
+
+		[[nodiscard]] inline bool IsHangul(char32_t cp) noexcept
+		{
+			return (cp >= kHangulBase && cp <= kHangulLast) || (cp >= kJamoConsonantFirst && cp <= kJamoVowelLast);
+		}
+
+		[[nodiscard]] inline std::uint32_t PrimaryWeight(char32_t cp, Locale locale) noexcept
+		{
+			const auto latinClass = locale == Locale::kKorean ? kClassSecondScript : kClassFirstScript;
+			const auto hangulClass = locale == Locale::kKorean ? kClassFirstScript : kClassSecondScript;
+
+			if (cp >= U'0' && cp <= U'9') {
+				return (kClassDigit << 24) | static_cast<std::uint32_t>(cp);
+			}
+			if (cp >= U'A' && cp <= U'Z') {
+				return (latinClass << 24) | static_cast<std::uint32_t>(cp - U'A' + U'a');
+			}
+			if (cp >= U'a' && cp <= U'z') {
+				return (latinClass << 24) | static_cast<std::uint32_t>(cp);
+			}
+			if (cp >= 0xC0 && cp <= 0xFF && kLatin1Fold[cp - 0xC0] != 0) {
+				return (latinClass << 24) | static_cast<std::uint32_t>(kLatin1Fold[cp - 0xC0]);
+			}
+			if (IsHangul(cp)) {
+				return (hangulClass << 24) | HangulWeight(cp);
+			}
+			if (cp < 0x80 || (cp >= 0x2000 && cp <= 0x206F) || (cp >= 0x3000 && cp <= 0x303F)) {
+				return (kClassSymbol << 24) | static_cast<std::uint32_t>(cp);
+			}
+			return (kClassOther << 24) | static_cast<std::uint32_t>(cp & 0xFFFFFFu);
+		}
+
+		inline void AppendWeight(std::string& key, std::uint32_t weight)
+		{
+			key.push_back(static_cast<char>((weight >> 24) & 0xFFu));
+			key.push_back(static_cast<char>((weight >> 16) & 0xFFu));
+			key.push_back(static_cast<char>((weight >> 8) & 0xFFu));
+			key.push_back(static_cast<char>(weight & 0xFFu));
+		}
+	}
+
+	// Byte string whose plain lexicographic order is the display order of `utf8`.
+	//
+	// Primary level: symbols < digits < scripts (Latin then Hangul, or Hangul first for Korean),
+	// case-insensitive with Latin-1 accents folded; Hangul by jamo. Ties fall back to the raw bytes,
+	// so keys are equal only for identical names.
+	[[nodiscard]] inline std::string BuildKey(std::string_view utf8, Locale locale)
+	{
+		std::string key;
+		key.reserve(utf8.size() * 4 + 4 + utf8.size());
+		for (std::size_t pos = 0; pos < utf8.size();) {
+			Detail::AppendWeight(key, Detail::PrimaryWeight(Detail::NextCodePoint(utf8, pos), locale));
+		}
+		Detail::AppendWeight(key, 0);
+		key.append(utf8);
+		return key;
+	}
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CodexOfPowerNG/NamePoolOps.h"
+
+#include <RE/Skyrim.h>
+
+#include <cstddef>
+
+namespace CodexOfPowerNG::NamePool
+{
+	// Display name of `primary` (or `fallback` when `primary` is unnamed), interned by FormID with a
+	// precomputed collation key. Unnamed forms share the localized "(unnamed)" entry.
+	// The pool is dropped whenever L10n switches language.
+	[[nodiscard]] NameRef Resolve(const RE::TESForm* primary, const RE::TESForm* fallback);
+
+	[[nodiscard]] std::size_t Count() noexcept;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CodexOfPowerNG/NameCollation.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace CodexOfPowerNG::NamePool
+{
+	// One display name, stored once and shared by every list row that shows it.
+	struct InternedName
+	{
+		std::string text;
+		std::string collationKey;
+	};
+
+	using NameRef = std::shared_ptr<const InternedName>;
+
+	[[nodiscard]] inline const std::string& TextOf(const NameRef& name) noexcept
+	{
+		static const std::string kEmpty{};
+		return name ? name->text : kEmpty;
+	}
+
+	// Display order without touching the text; identical interned names short-circuit.
+	[[nodiscard]] inline bool CollatesBefore(const NameRef& a, const NameRef& b) noexcept
+	{
+		if (a == b) {
+			return false;
+		}
+		if (!a || !b) {
+			return !a;
+		}
+		return a->collationKey < b->collationKey;
+	}
+}
+
+namespace CodexOfPowerNG::NamePool::Ops
+{
+	template <class Key>
+	struct PoolState
+	{
+		std::unordered_map<Key, NameRef> byKey{};
+		NameCollation::Locale            locale{ NameCollation::Locale::kDefault };
+		std::uint64_t                    languageGeneration{ 0 };
+	};
+
+	[[nodiscard]] inline NameRef MakeName(std::string_view text, NameCollation::Locale locale)
+	{
+		return std::make_shared<const InternedName>(
+			InternedName{ std::string(text), NameCollation::BuildKey(text, locale) });
+	}
+
+	// Drops every entry when the language changed since the pool was filled.
+	template <class Key>
+	[[nodiscard]] bool SyncLanguage(PoolState<Key>& pool, std::uint64_t languageGeneration, NameCollation::Locale locale)
+	{
+		if (pool.languageGeneration == languageGeneration) {
+			return false;
+		}
+		pool.byKey.clear();
+		pool.locale = locale;
+		pool.languageGeneration = languageGeneration;
+		return true;
+	}
+
+	// Returns the pooled name for `key`, re-interning only when the form's text changed.
+	template <class Key>
+	[[nodiscard]] NameRef Intern(PoolState<Key>& pool, const Key& key, std::string_view text)
+	{
+		auto& slot = pool.byKey[key];
+		if (!slot || slot->text != text) {
+			slot = MakeName(text, pool.locale);
+		}
+		return slot;
+	}
+}
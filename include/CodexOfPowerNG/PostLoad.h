@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CodexOfPowerNG/StagePipeline.h"
+#include "CodexOfPowerNG/TaskScheduler.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CodexOfPowerNG::PostLoad
+{
+	struct Stage
+	{
+		std::string              name;
+		std::vector<std::string> after;
+		StageFn                  run;
+	};
+
+	// Cancels any pipeline still in flight and runs `stages` as background main-thread slices,
+	// starting next frame; a stage that yields or waits resumes on the following frame. Each load or
+	// new game starts a new generation. `onReady` runs on the main thread once every stage has
+	// finished, unless the generation was cancelled first. A stage that throws, a dependency cycle,
+	// or a pipeline still unfinished after a minute logs an error and marks the generation ready.
+	void Start(std::vector<Stage> stages, ScheduledTask onReady = {}) noexcept;
+	// Load boundary: the running pipeline stops at its next slice and readiness drops.
+	void Cancel() noexcept;
+
+	// True once every stage of the current generation has finished or the pipeline gave up.
+	[[nodiscard]] bool IsReady() noexcept;
+	[[nodiscard]] std::uint64_t CurrentGeneration() noexcept;
+
+	// Waits until the player exists and the game is active, or until `timeout` has passed.
+	[[nodiscard]] StageFn WaitForGameplay(std::chrono::milliseconds timeout);
+}
@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG::Containers
+{
+	// Sorted sequence with order statistics: a two-level counted B+-tree.
+	//
+	// Values live in sorted leaf chunks of at most `kLeafMax` entries; a Fenwick tree over leaf sizes
+	// maps a rank to its leaf in O(log leaves). Insert/erase are O(log n + kLeafMax), fetching a page
+	// of `count` values from an arbitrary offset is O(log n + count). `Less` must be a strict weak
+	// order under which stored values are unique.
+	template <class T, class Less = std::less<T>, std::size_t kLeafMax = 128>
+	class RankedList
+	{
+		static_assert(kLeafMax >= 4, "leaf chunks must hold at least four values");
+
+	public:
+		RankedList() = default;
+		explicit RankedList(Less less) :
+			_less(std::move(less))
+		{}
+
+		[[nodiscard]] std::size_t size() const noexcept { return _size; }
+		[[nodiscard]] bool        empty() const noexcept { return _size == 0; }
+
+		void clear() noexcept
+		{
+			_leaves.clear();
+			_fenwick.clear();
+			_size = 0;
+		}
+
+		// Replaces the contents with `values`, which must already be sorted and unique.
+		void assign_sorted(std::vector<T> values)
+		{
+			clear();
+			const auto fill = (kLeafMax * 3) / 4;
+			for (std::size_t i = 0; i < values.size(); i += fill) {
+				const auto end = (std::min)(values.size(), i + fill);
+				auto& leaf = _leaves.emplace_back();
+				leaf.reserve(kLeafMax);
+				leaf.insert(
+					leaf.end(),
+					std::make_move_iterator(values.begin() + static_cast<std::ptrdiff_t>(i)),
+					std::make_move_iterator(values.begin() + static_cast<std::ptrdiff_t>(end)));
+			}
+			_size = values.size();
+			RebuildFenwick();
+		}
+
+		// Inserts `value` (or replaces an equivalent one) and returns its rank.
+		std::size_t insert(T value)
+		{
+			if (_leaves.empty()) {
+				_leaves.emplace_back().reserve(kLeafMax);
+				RebuildFenwick();
+			}
+
+			const auto leafIndex = FindLeaf(value);
+			auto&      leaf = _leaves[leafIndex];
+			const auto pos = std::lower_bound(leaf.begin(), leaf.end(), value, _less);
+			auto       offset = static_cast<std::size_t>(pos - leaf.begin());
+			if (pos != leaf.end() && !_less(value, *pos)) {
+				*pos = std::move(value);
+				return PrefixBefore(leafIndex) + offset;
+			}
+
+			leaf.insert(pos, std::move(value));
+			++_size;
+
+			if (leaf.size() <= kLeafMax) {
+				FenwickAdd(leafIndex, 1);
+				return PrefixBefore(leafIndex) + offset;
+			}
+
+			SplitLeaf(leafIndex);
+			if (offset >= _leaves[leafIndex].size()) {
+				offset -= _leaves[leafIndex].size();
+				return PrefixBefore(leafIndex + 1) + offset;
+			}
+			return PrefixBefore(leafIndex) + offset;
+		}
+
+		// Erases the value equivalent to `probe`; returns false when absent.
+		bool erase(const T& probe)
+		{
+			if (_leaves.empty()) {
+				return false;
+			}
+
+			const auto leafIndex = FindLeaf(probe);
+			auto&      leaf = _leaves[leafIndex];
+			const auto pos = std::lower_bound(leaf.begin(), leaf.end(), probe, _less);
+			if (pos == leaf.end() || _less(probe, *pos)) {
+				return false;
+			}
+
+			leaf.erase(pos);
+			--_size;
+
+			if (leaf.empty()) {
+				_leaves.erase(_leaves.begin() + static_cast<std::ptrdiff_t>(leafIndex));
+				RebuildFenwick();
+			} else if (!MaybeMergeLeaf(leafIndex)) {
+				FenwickAdd(leafIndex, -1);
+			}
+			return true;
+		}
+
+		[[nodiscard]] bool contains(const T& probe) const
+		{
+			if (_leaves.empty()) {
+				return false;
+			}
+			const auto& leaf = _leaves[FindLeaf(probe)];
+			const auto  pos = std::lower_bound(leaf.begin(), leaf.end(), probe, _less);
+			return pos != leaf.end() && !_less(probe, *pos);
+		}
+
+		// Rank of the first value not less than `probe` (size() when every value is less).
+		[[nodiscard]] std::size_t rank_of(const T& probe) const
+		{
+			if (_leaves.empty()) {
+				return 0;
+			}
+			const auto  leafIndex = FindLeaf(probe);
+			const auto& leaf = _leaves[leafIndex];
+			const auto  pos = std::lower_bound(leaf.begin(), leaf.end(), probe, _less);
+			return PrefixBefore(leafIndex) + static_cast<std::size_t>(pos - leaf.begin());
+		}
+
+		[[nodiscard]] const T& at(std::size_t rank) const
+		{
+			assert(rank < _size);
+			const auto [leafIndex, offset] = Select(rank);
+			return _leaves[leafIndex][offset];
+		}
+
+		// Calls `fn(value)` for up to `count` values starting at rank `offset`.
+		template <class Fn>
+		void for_each_range(std::size_t offset, std::size_t count, Fn&& fn) const
+		{
+			if (offset >= _size || count == 0) {
+				return;
+			}
+
+			auto [leafIndex, pos] = Select(offset);
+			while (count > 0 && leafIndex < _leaves.size()) {
+				const auto& leaf = _leaves[leafIndex];
+				for (; pos < leaf.size() && count > 0; ++pos, --count) {
+					fn(leaf[pos]);
+				}
+				++leafIndex;
+				pos = 0;
+			}
+		}
+
+		template <class Fn>
+		void for_each(Fn&& fn) const
+		{
+			for (const auto& leaf : _leaves) {
+				for (const auto& value : leaf) {
+					fn(value);
+				}
+			}
+		}
+
+	private:
+		// Leaf whose key range should hold `value`: the first leaf whose last element is not less.
+		[[nodiscard]] std::size_t FindLeaf(const T& value) const
+		{
+			std::size_t lo = 0;
+			std::size_t hi = _leaves.size() - 1;
+			while (lo < hi) {
+				const auto mid = lo + (hi - lo) / 2;
+				if (_less(_leaves[mid].back(), value)) {
+					lo = mid + 1;
+				} else {
+					hi = mid;
+				}
+			}
+			return lo;
+		}
+
+		[[nodiscard]] std::pair<std::size_t, std::size_t> Select(std::size_t rank) const noexcept
+		{
+			// Fenwick descent: largest leaf prefix whose total is <= rank.
+			std::size_t leafIndex = 0;
+			std::size_t remaining = rank;
+			std::size_t step = 1;
+			while ((step << 1) <= _fenwick.size()) {
+				step <<= 1;
+			}
+			for (; step > 0; step >>= 1) {
+				const auto next = leafIndex + step;
+				if (next <= _fenwick.size() && _fenwick[next - 1] <= remaining) {
+					leafIndex = next;
+					remaining -= _fenwick[next - 1];
+				}
+			}
+			return { leafIndex, remaining };
+		}
+
+		[[nodiscard]] std::size_t PrefixBefore(std::size_t leafIndex) const noexcept
+		{
+			std::size_t sum = 0;
+			for (auto i = leafIndex; i > 0; i -= i & (~i + 1)) {
+				sum += _fenwick[i - 1];
+			}
+			return sum;
+		}
+
+		void FenwickAdd(std::size_t leafIndex, std::ptrdiff_t delta) noexcept
+		{
+			for (auto i = leafIndex + 1; i <= _fenwick.size(); i += i & (~i + 1)) {
+				_fenwick[i - 1] = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(_fenwick[i - 1]) + delta);
+			}
+		}
+
+		void RebuildFenwick()
+		{
+			_fenwick.assign(_leaves.size(), 0);
+			for (std::size_t i = 0; i < _leaves.size(); ++i) {
+				_fenwick[i] += _leaves[i].size();
+				const auto parent = i + ((i + 1) & (~(i + 1) + 1));
+				if (parent < _fenwick.size()) {
+					_fenwick[parent] += _fenwick[i];
+				}
+			}
+		}
+
+		void SplitLeaf(std::size_t leafIndex)
+		{
+			auto&      leaf = _leaves[leafIndex];
+			const auto half = leaf.size() / 2;
+			std::vector<T> upper;
+			upper.reserve(kLeafMax);
+			upper.insert(
+				upper.end(),
+				std::make_move_iterator(leaf.begin() + static_cast<std::ptrdiff_t>(half)),
+				std::make_move_iterator(leaf.end()));
+			leaf.erase(leaf.begin() + static_cast<std::ptrdiff_t>(half), leaf.end());
+			_leaves.insert(_leaves.begin() + static_cast<std::ptrdiff_t>(leafIndex + 1), std::move(upper));
+			RebuildFenwick();
+		}
+
+		// Folds an underfull leaf into its right neighbour so leaf count tracks n / kLeafMax.
+		bool MaybeMergeLeaf(std::size_t leafIndex)
+		{
+			if (leafIndex + 1 >= _leaves.size() || _leaves[leafIndex].size() >= kLeafMax / 4) {
+				return false;
+			}
+			auto& leaf = _leaves[leafIndex];
+			auto& next = _leaves[leafIndex + 1];
+			if (leaf.size() + next.size() > kLeafMax) {
+				return false;
+			}
+			leaf.insert(leaf.end(), std::make_move_iterator(next.begin()), std::make_move_iterator(next.end()));
+			_leaves.erase(_leaves.begin() + static_cast<std::ptrdiff_t>(leafIndex + 1));
+			RebuildFenwick();
+			return true;
+		}
+
+		std::vector<std::vector<T>> _leaves{};
+		std::vector<std::size_t>    _fenwick{};
+		std::size_t                 _size{ 0 };
+		Less                        _less{};
+	};
+}
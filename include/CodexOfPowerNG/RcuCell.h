@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace CodexOfPowerNG
+{
+	// Read-copy-update cell: readers pin the current immutable value with two atomic increments and
+	// never block; Publish() swaps in a new value and frees the old one after a grace period.
+	//
+	// Grace periods use two reader counters and an epoch bit (flipped twice per publish, as in
+	// userspace RCU) so a reader that sampled the epoch just before a flip is still waited for.
+	// A thread must not Publish() while it holds a ReadGuard on the same cell.
+	template <class T>
+	class RcuCell
+	{
+	public:
+		class ReadGuard
+		{
+		public:
+			explicit ReadGuard(const RcuCell& cell) noexcept :
+				_cell(&cell),
+				_slot(cell._epoch.load(std::memory_order_seq_cst) & 1u)
+			{
+				_cell->_readers[_slot].fetch_add(1, std::memory_order_seq_cst);
+				_value = _cell->_current.load(std::memory_order_seq_cst);
+			}
+
+			ReadGuard(const ReadGuard&) = delete;
+			ReadGuard& operator=(const ReadGuard&) = delete;
+
+			~ReadGuard() { _cell->_readers[_slot].fetch_sub(1, std::memory_order_release); }
+
+			[[nodiscard]] const T& operator*() const noexcept { return *_value; }
+			[[nodiscard]] const T* operator->() const noexcept { return _value; }
+
+		private:
+			const RcuCell* _cell;
+			std::uint32_t  _slot;
+			const T*       _value{ nullptr };
+		};
+
+		RcuCell() : RcuCell(std::make_unique<const T>()) {}
+		explicit RcuCell(std::unique_ptr<const T> initial) : _current(initial.release()) {}
+
+		RcuCell(const RcuCell&) = delete;
+		RcuCell& operator=(const RcuCell&) = delete;
+
+		~RcuCell() { delete _current.load(std::memory_order_acquire); }
+
+		[[nodiscard]] ReadGuard Read() const noexcept { return ReadGuard(*this); }
+
+		// Writers are serialized; returns once no reader can still see the previous value.
+		void Publish(std::unique_ptr<const T> next)
+		{
+			if (!next) {
+				return;
+			}
+
+			std::scoped_lock lock(_writerMutex);
+			std::unique_ptr<const T> previous(_current.exchange(next.release(), std::memory_order_seq_cst));
+			for (int phase = 0; phase < 2; ++phase) {
+				const auto drained = _epoch.fetch_xor(1u, std::memory_order_seq_cst) & 1u;
+				while (_readers[drained].load(std::memory_order_acquire) != 0) {
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		// Copy of the current value for a writer to edit and Publish(); call with writers serialized.
+		[[nodiscard]] std::unique_ptr<T> CloneCurrent() const
+		{
+			return std::make_unique<T>(*_current.load(std::memory_order_acquire));
+		}
+
+	private:
+		std::atomic<const T*>                     _current;
+		std::atomic<std::uint32_t>                _epoch{ 0 };
+		mutable std::array<std::atomic<std::uint64_t>, 2> _readers{};
+		std::mutex                                _writerMutex;
+	};
+}
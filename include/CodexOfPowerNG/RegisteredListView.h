@@ -0,0 +1,150 @@
+#pragma once
+
+#include "CodexOfPowerNG/RankedList.h"
+#include "CodexOfPowerNG/RegistrationListOrder.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG::Registration::RegisteredView
+{
+	inline constexpr std::size_t kJournalLimit = 256;
+
+	enum class ChangeKind : std::uint8_t
+	{
+		kInsert,
+		kRemove,
+	};
+
+	// One splice against the row array as it was right before the change: insert `item` at
+	// `index`, or remove the row at `index`. Replaying changes in version order reproduces the view.
+	template <class Item>
+	struct Change
+	{
+		std::uint64_t            version{ 0 };
+		ChangeKind               kind{ ChangeKind::kInsert };
+		std::size_t              index{ 0 };
+		ListOrder::ItemRef<Item> item{};
+	};
+
+	// Sorted, versioned registered-items view kept in step with InsertRegistered/RemoveRegistered.
+	//
+	// `Item` must expose `regKey`, `group` and `name`. Every mutation bumps `version` and appends a
+	// change to a bounded journal, so a client at any version since `baseVersion` can catch up with
+	// splices instead of a full snapshot.
+	template <class Item>
+	struct View
+	{
+		Containers::RankedList<ListOrder::ItemRef<Item>, ListOrder::RefLess<Item>> rows{};
+		std::unordered_map<std::uint32_t, ListOrder::ItemRef<Item>>                byKey{};
+		std::deque<Change<Item>>                                                   journal{};
+		std::uint64_t                                                              version{ 0 };
+		std::uint64_t                                                              baseVersion{ 0 };
+		bool                                                                       built{ false };
+	};
+
+	namespace Detail
+	{
+		template <class Item>
+		void Record(View<Item>& view, ChangeKind kind, std::size_t index, ListOrder::ItemRef<Item> item)
+		{
+			++view.version;
+			view.journal.push_back(Change<Item>{ view.version, kind, index, std::move(item) });
+			while (view.journal.size() > kJournalLimit) {
+				view.journal.pop_front();
+			}
+		}
+	}
+
+	template <class Item>
+	void Rebuild(View<Item>& view, std::vector<Item> items)
+	{
+		std::sort(items.begin(), items.end(), &ListOrder::Less<Item>);
+
+		std::vector<ListOrder::ItemRef<Item>> refs;
+		refs.reserve(items.size());
+		view.byKey.clear();
+		view.byKey.reserve(items.size());
+		for (auto& item : items) {
+			auto ref = std::make_shared<const Item>(std::move(item));
+			view.byKey[ref->regKey] = ref;
+			refs.push_back(std::move(ref));
+		}
+		view.rows.assign_sorted(std::move(refs));
+		view.journal.clear();
+		++view.version;
+		view.baseVersion = view.version;
+		view.built = true;
+	}
+
+	template <class Item>
+	void Invalidate(View<Item>& view) noexcept
+	{
+		view.built = false;
+	}
+
+	// Removes the row for `regKey`; no-op when absent.
+	template <class Item>
+	void Remove(View<Item>& view, std::uint32_t regKey)
+	{
+		const auto it = view.byKey.find(regKey);
+		if (it == view.byKey.end()) {
+			return;
+		}
+		auto       ref = std::move(it->second);
+		const auto index = view.rows.rank_of(ref);
+		view.byKey.erase(it);
+		(void)view.rows.erase(ref);
+		Detail::Record(view, ChangeKind::kRemove, index, std::move(ref));
+	}
+
+	// Inserts (or re-inserts) the row for `item.regKey`.
+	template <class Item>
+	void Upsert(View<Item>& view, Item item)
+	{
+		Remove(view, item.regKey);
+		auto       ref = std::make_shared<const Item>(std::move(item));
+		const auto index = view.rows.insert(ref);
+		view.byKey[ref->regKey] = ref;
+		Detail::Record(view, ChangeKind::kInsert, index, std::move(ref));
+	}
+
+	// Whether a client holding `fromVersion` can be brought current with journal splices.
+	template <class Item>
+	[[nodiscard]] bool CanReplayFrom(const View<Item>& view, std::uint64_t fromVersion) noexcept
+	{
+		if (!view.built || fromVersion < view.baseVersion || fromVersion > view.version) {
+			return false;
+		}
+		return fromVersion == view.version || (!view.journal.empty() && view.journal.front().version <= fromVersion + 1);
+	}
+
+	template <class Item>
+	[[nodiscard]] std::vector<Change<Item>> ChangesSince(const View<Item>& view, std::uint64_t fromVersion)
+	{
+		std::vector<Change<Item>> out;
+		for (const auto& change : view.journal) {
+			if (change.version > fromVersion) {
+				out.push_back(change);
+			}
+		}
+		return out;
+	}
+
+	template <class Item>
+	[[nodiscard]] std::vector<ListOrder::ItemRef<Item>> Page(const View<Item>& view, std::size_t offset, std::size_t limit)
+	{
+		std::vector<ListOrder::ItemRef<Item>> page;
+		if (offset < view.rows.size()) {
+			page.reserve((std::min)(limit, view.rows.size() - offset));
+		}
+		view.rows.for_each_range(offset, limit, [&page](const ListOrder::ItemRef<Item>& ref) { page.push_back(ref); });
+		return page;
+	}
+}
@@ -1,14 +1,23 @@
 #pragma once
 
 #include "CodexOfPowerNG/BuildTypes.h"
+#include "CodexOfPowerNG/NamePoolOps.h"
+#include "CodexOfPowerNG/RegistrationClassCache.h"
 #include "CodexOfPowerNG/RegistrationUndoTypes.h"
 
 #include <RE/Skyrim.h>
 
+#include <chrono>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
+namespace CodexOfPowerNG::Startup
+{
+	class WorkerPool;
+}
+
 namespace CodexOfPowerNG::Registration
 {
 	struct ListItem
@@ -23,14 +32,35 @@ namespace CodexOfPowerNG::Registration
 		bool            blocked{ false };
 		Builds::BuildPointCenti buildPointsCenti{ 0 };
 		std::string     disabledReason;
-		std::string     name;
+		NamePool::NameRef name;
 	};
 
+	// Quick-list rows are shared with the eligible index and never mutated after publishing.
+	using ListItemRef = std::shared_ptr<const ListItem>;
+
 	struct QuickRegisterList
 	{
-		bool                  hasMore{ false };
-		std::size_t           total{ 0 };
-		std::vector<ListItem> items;
+		bool                     hasMore{ false };
+		std::size_t              total{ 0 };
+		std::vector<ListItemRef> items;
+	};
+
+	struct RegisteredListChange
+	{
+		bool        removed{ false };
+		std::size_t index{ 0 };
+		ListItemRef item;
+	};
+
+	// Registered tab update relative to the version a view already holds: journal splices when
+	// possible, otherwise the full sorted list.
+	struct RegisteredListUpdate
+	{
+		std::uint64_t                     fromVersion{ 0 };
+		std::uint64_t                     version{ 0 };
+		bool                              full{ false };
+		std::vector<ListItemRef>          items;
+		std::vector<RegisteredListChange> changes;
 	};
 
 	struct RegisterResult
@@ -42,15 +72,30 @@ namespace CodexOfPowerNG::Registration
 		std::size_t     totalRegistered{ 0 };
 	};
 
+	// A multi-item registration filed as one undo group. It may span several frames; each slice
+	// commits its registrations under one state lock with one build contribution per discipline.
+	struct RegisterBatchJob
+	{
+		std::vector<RE::FormID> formIds;
+		std::size_t             next{ 0 };
+		std::size_t             registered{ 0 };
+		std::size_t             totalRegistered{ 0 };
+		std::uint64_t           actionId{ 0 };
+		bool                    buildChanged{ false };
+		bool                    finished{ false };
+		std::string             lastMessage;
+	};
+
 	struct UndoListItem
 	{
 		std::uint64_t actionId{ 0 };
 		RE::FormID    formId{ 0 };
 		RE::FormID    regKey{ 0 };
 		std::uint32_t group{ 255 };
+		std::size_t   itemCount{ 1 };
 		bool          canUndo{ false };
 		bool          hasRewardDelta{ false };
-		std::string   name;
+		NamePool::NameRef name;
 	};
 
 	struct UndoResult
@@ -77,16 +122,49 @@ namespace CodexOfPowerNG::Registration
 	// Returns whether a FormID is discoverable (group 0..5 and not excluded).
 	[[nodiscard]] bool IsDiscoverable(RE::FormID formId) noexcept;
 
+	// IsDiscoverable && !IsRegistered, resolving the form and its regKey once; returns the regKey
+	// ID, or 0 when the item should not prompt a loot notification.
+	[[nodiscard]] RE::FormID ResolveUnregisteredLootKey(RE::FormID formId) noexcept;
+
+	// Hit/miss counters of the per-FormID classification memo behind the lookups above.
+	[[nodiscard]] ClassCache::Stats GetClassificationCacheStats() noexcept;
+
 	// Quick-register inventory: unregistered + owned + registerable, including temporarily protected rows.
+	// Served from a persistent eligible index; only objects marked dirty are re-evaluated.
 	[[nodiscard]] QuickRegisterList BuildQuickRegisterList(std::size_t offset, std::size_t limit);
 	void InvalidateQuickRegisterCache() noexcept;
 
+	// Forces a full quick-list rescan on the next request (save load/revert, undo).
+	void ResetQuickRegisterIndex() noexcept;
+
+	// Records an inventory delta for one base object (container change, equip change). Never waits on a list build.
+	void MarkQuickRegisterItemDirty(RE::FormID formId) noexcept;
+
+	// Re-evaluates every row (gate, safe count) on the next request. Called when the view opens,
+	// since favorite toggles raise no event.
+	void RefreshQuickRegisterRows() noexcept;
+
 	// Registered items view (discovery mode): state map keys -> names + groups.
-	[[nodiscard]] std::vector<ListItem> BuildRegisteredList();
+	// Maintained incrementally; rebuilt only after load/revert or a language switch.
+	[[nodiscard]] RegisteredListUpdate BuildRegisteredListUpdate(std::uint64_t knownVersion);
+
+	// Keeps the registered view in step with RegistrationStateStore::InsertRegistered/RemoveRegistered.
+	void NoteRegisteredInserted(RE::FormID regKey, std::uint32_t group) noexcept;
+	void NoteRegisteredRemoved(RE::FormID regKey) noexcept;
+
+	// Drops the registered view; the next request rebuilds it from the state store.
+	void ResetRegisteredListCache() noexcept;
 
 	// Registers an inventory item (consumes 1) and updates co-save state.
 	[[nodiscard]] RegisterResult TryRegisterItem(RE::FormID formId);
 
+	// Runs one slice of `job` (main thread), stopping once `sliceBudget` is spent. Returns true
+	// when every FormID was processed; build effects are then synced once for the whole batch.
+	[[nodiscard]] bool TryRegisterBatch(RegisterBatchJob& job, std::chrono::microseconds sliceBudget);
+
+	// Completes a batch that cannot be continued. Called by TryRegisterBatch on its last slice.
+	void FinishRegisterBatch(RegisterBatchJob& job);
+
 	// Returns recent registration actions (newest first).
 	[[nodiscard]] std::vector<UndoListItem> BuildRecentUndoList(std::size_t limit = kUndoHistoryLimit);
 
@@ -97,6 +175,10 @@ namespace CodexOfPowerNG::Registration
 	// Whether TCC LOTD tracking lists (dbmMaster/dbmDisp) are currently available.
 	[[nodiscard]] bool IsTccDisplayedListsAvailable() noexcept;
 
-	// Loads exclude/variant maps early (safe to call multiple times).
+	// Reads and parses the exclude/variant map files on `pool` (kPostLoad; no game data needed).
+	void PrepareAsync(Startup::WorkerPool& pool) noexcept;
+
+	// Loads exclude/variant maps early (safe to call multiple times). After PrepareAsync() this only
+	// resolves FormIDs, waiting for the parse stages if they are still running.
 	void Warmup() noexcept;
 }
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG::Registration::BatchOps
+{
+	// Undo history is a sequence of groups: consecutive records sharing one actionId are undone together.
+
+	template <class Record>
+	[[nodiscard]] std::size_t CountUndoGroups(const std::deque<Record>& history) noexcept
+	{
+		std::size_t groups = 0;
+		for (std::size_t i = 0; i < history.size(); ++i) {
+			if (i == 0 || history[i].actionId != history[i - 1].actionId) {
+				++groups;
+			}
+		}
+		return groups;
+	}
+
+	// Drops whole groups from the front until at most `groupLimit` remain.
+	template <class Record>
+	void TrimUndoGroups(std::deque<Record>& history, std::size_t groupLimit)
+	{
+		auto groups = CountUndoGroups(history);
+		while (groups > groupLimit && !history.empty()) {
+			const auto oldest = history.front().actionId;
+			while (!history.empty() && history.front().actionId == oldest) {
+				history.pop_front();
+			}
+			--groups;
+		}
+	}
+
+	// Appends `records` as one group and returns its actionId. When the newest group is
+	// `joinActionId` the records extend it instead (a batch committed over several frames).
+	template <class Record>
+	std::uint64_t PushUndoGroup(
+		std::deque<Record>&  history,
+		std::uint64_t&       nextActionId,
+		std::vector<Record>  records,
+		std::uint64_t        joinActionId,
+		std::size_t          groupLimit)
+	{
+		if (records.empty()) {
+			return joinActionId;
+		}
+
+		const bool join = joinActionId != 0 && !history.empty() && history.back().actionId == joinActionId;
+		const auto actionId = join ? joinActionId : nextActionId++;
+		for (auto& record : records) {
+			record.actionId = actionId;
+			history.push_back(std::move(record));
+		}
+		TrimUndoGroups(history, groupLimit);
+		return actionId;
+	}
+
+	// Removes the newest group when it is `actionId`; records keep their original order.
+	template <class Record>
+	[[nodiscard]] std::vector<Record> PopLatestUndoGroup(std::deque<Record>& history, std::uint64_t actionId)
+	{
+		std::vector<Record> out;
+		if (history.empty() || history.back().actionId != actionId) {
+			return out;
+		}
+
+		auto first = history.size();
+		while (first > 0 && history[first - 1].actionId == actionId) {
+			--first;
+		}
+		out.reserve(history.size() - first);
+		for (auto i = first; i < history.size(); ++i) {
+			out.push_back(std::move(history[i]));
+		}
+		history.erase(history.begin() + static_cast<std::ptrdiff_t>(first), history.end());
+		return out;
+	}
+
+	// Newest group first, at most `limit` groups.
+	template <class Record>
+	[[nodiscard]] std::vector<std::vector<Record>> SnapshotUndoGroups(const std::deque<Record>& history, std::size_t limit)
+	{
+		std::vector<std::vector<Record>> out;
+		auto end = history.size();
+		while (end > 0 && out.size() < limit) {
+			auto first = end - 1;
+			while (first > 0 && history[first - 1].actionId == history[end - 1].actionId) {
+				--first;
+			}
+			out.emplace_back(history.begin() + static_cast<std::ptrdiff_t>(first), history.begin() + static_cast<std::ptrdiff_t>(end));
+			end = first;
+		}
+		return out;
+	}
+
+	// Folds one registration's build contribution into a per-discipline total, so a batch applies
+	// (and an undo group rolls back) at most one contribution per discipline.
+	template <class Contribution, std::size_t kDisciplines>
+	void AccumulateContribution(std::array<std::optional<Contribution>, kDisciplines>& totals, const Contribution& contribution)
+	{
+		const auto index = static_cast<std::size_t>(contribution.discipline);
+		if (index >= kDisciplines) {
+			return;
+		}
+
+		auto& total = totals[index];
+		if (!total) {
+			total = contribution;
+			return;
+		}
+		total->recordDelta += contribution.recordDelta;
+		total->pointsDeltaCenti += contribution.pointsDeltaCenti;
+	}
+
+	// A slice always makes progress on at least one item, then yields once its frame budget is spent.
+	[[nodiscard]] constexpr bool ShouldYield(
+		std::size_t              doneInSlice,
+		std::chrono::nanoseconds elapsed,
+		std::chrono::nanoseconds budget) noexcept
+	{
+		return doneInSlice > 0 && elapsed >= budget;
+	}
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace CodexOfPowerNG::Registration::ClassCache
+{
+	struct Stats
+	{
+		std::uint64_t hits{ 0 };
+		std::uint64_t misses{ 0 };
+		std::uint64_t resets{ 0 };  // generation changes that dropped the table
+		std::size_t   size{ 0 };
+
+		[[nodiscard]] double HitRate() const noexcept
+		{
+			const auto total = hits + misses;
+			return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+		}
+	};
+
+	// Lazily filled per-FormID memo. Every call names the generation its inputs came from; a
+	// different generation than the table was filled under drops all entries first.
+	template <class Value>
+	class GenerationalFormCache
+	{
+	public:
+		// `compute()` returns std::optional<Value>; nullopt results are returned but not cached.
+		// It runs outside the lock, so racing misses may compute the same entry twice.
+		template <class Compute>
+		[[nodiscard]] std::optional<Value> GetOrCompute(std::uint32_t formId, std::uint64_t generation, Compute&& compute)
+		{
+			{
+				std::scoped_lock lock(_mutex);
+				ResetIfStaleLocked(generation);
+				const auto& entries = std::as_const(_entries);
+				if (const auto it = entries.find(formId); it != entries.end()) {
+					_hits.fetch_add(1, std::memory_order_relaxed);
+					return it->second;
+				}
+			}
+
+			_misses.fetch_add(1, std::memory_order_relaxed);
+			std::optional<Value> value = compute();
+			if (value) {
+				std::scoped_lock lock(_mutex);
+				if (_generation == generation) {
+					_entries.insert_or_assign(formId, *value);
+				}
+			}
+			return value;
+		}
+
+		void Clear()
+		{
+			std::scoped_lock lock(_mutex);
+			_entries.clear();
+		}
+
+		[[nodiscard]] Stats GetStats() const
+		{
+			Stats stats{};
+			stats.hits = _hits.load(std::memory_order_relaxed);
+			stats.misses = _misses.load(std::memory_order_relaxed);
+			stats.resets = _resets.load(std::memory_order_relaxed);
+			std::scoped_lock lock(_mutex);
+			stats.size = _entries.size();
+			return stats;
+		}
+
+	private:
+		void ResetIfStaleLocked(std::uint64_t generation)
+		{
+			if (_generation == generation) {
+				return;
+			}
+			if (!_entries.empty()) {
+				_entries.clear();
+				_resets.fetch_add(1, std::memory_order_relaxed);
+			}
+			_generation = generation;
+		}
+
+		mutable std::mutex               _mutex;
+		Containers::FlatFormIdMap<Value> _entries;
+		std::uint64_t                    _generation{ 0 };
+		std::atomic<std::uint64_t>       _hits{ 0 };
+		std::atomic<std::uint64_t>       _misses{ 0 };
+		std::atomic<std::uint64_t>       _resets{ 0 };
+	};
+}
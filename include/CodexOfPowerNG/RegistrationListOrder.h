@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CodexOfPowerNG/NamePoolOps.h"
+
+#include <memory>
+#include <string>
+
+namespace CodexOfPowerNG::Registration::ListOrder
+{
+	// Rows are immutable once indexed; pages hand out shared references instead of string copies.
+	template <class Item>
+	using ItemRef = std::shared_ptr<const Item>;
+
+	[[nodiscard]] inline bool NameLess(const std::string& a, const std::string& b) noexcept
+	{
+		return a < b;
+	}
+
+	[[nodiscard]] inline bool NameLess(const NamePool::NameRef& a, const NamePool::NameRef& b) noexcept
+	{
+		return NamePool::CollatesBefore(a, b);
+	}
+
+	// List display order shared by the quick-register and registered views: (group, name, regKey).
+	template <class Item>
+	[[nodiscard]] bool Less(const Item& a, const Item& b) noexcept
+	{
+		if (a.group != b.group) {
+			return a.group < b.group;
+		}
+		if (NameLess(a.name, b.name)) {
+			return true;
+		}
+		if (NameLess(b.name, a.name)) {
+			return false;
+		}
+		return a.regKey < b.regKey;
+	}
+
+	template <class Item>
+	struct RefLess
+	{
+		[[nodiscard]] bool operator()(const ItemRef<Item>& a, const ItemRef<Item>& b) const noexcept
+		{
+			return Less(*a, *b);
+		}
+	};
+}
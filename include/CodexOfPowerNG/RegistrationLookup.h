@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CodexOfPowerNG/State.h"
+
+#include <RE/Skyrim.h>
+
+#include <cstdint>
+#include <span>
+
+namespace CodexOfPowerNG::RegistrationLookup
+{
+	// Lock-free reads of the last published registered/blocked/notified ids (see RcuCell.h).
+	[[nodiscard]] bool          IsRegistered(RE::FormID formId) noexcept;
+	[[nodiscard]] bool          IsRegisteredEither(RE::FormID regKeyId, RE::FormID legacyId) noexcept;
+	[[nodiscard]] bool          IsBlocked(RE::FormID formId) noexcept;
+	[[nodiscard]] bool          IsNotifiedAny(RE::FormID primaryId, RE::FormID secondaryId) noexcept;
+	[[nodiscard]] std::uint64_t Version() noexcept;
+
+	// Writers call these with RuntimeState::mutex held, right after changing the matching set, so
+	// snapshots are published in mutation order. Blocked/notified ids are readable at once but are
+	// folded into the snapshot by one publish per frame.
+	void PublishLocked(const RuntimeState& state) noexcept;
+	void NoteRegisteredLocked(std::span<const RE::FormID> regKeys) noexcept;
+	void NoteUnregisteredLocked(RE::FormID regKeyId) noexcept;
+	void NoteBlockedLocked(RE::FormID regKeyId, RE::FormID itemId) noexcept;
+	void NoteNotifiedLocked(RE::FormID primaryId, RE::FormID secondaryId) noexcept;
+}
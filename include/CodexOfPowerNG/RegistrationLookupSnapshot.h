@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG::RegistrationLookup
+{
+	using FormIdList = std::vector<std::uint32_t>;
+	using SharedFormIdList = std::shared_ptr<const FormIdList>;
+
+	[[nodiscard]] inline SharedFormIdList Share(FormIdList ids)
+	{
+		return std::make_shared<const FormIdList>(std::move(ids));
+	}
+
+	// Immutable, sorted copies of the id sets queried on every item the player picks up. Lists are
+	// shared between snapshots, so an edit to one set copies only that set.
+	struct Snapshot
+	{
+		SharedFormIdList registered{ Share({}) };
+		SharedFormIdList blocked{ Share({}) };
+		SharedFormIdList notified{ Share({}) };
+		std::uint64_t    version{ 0 };
+	};
+
+	// Branchless lower bound: the probe sequence does not depend on the data, so lookups of random
+	// ids do not pay a mispredict per level the way std::binary_search does.
+	[[nodiscard]] inline bool Contains(const FormIdList& ids, std::uint32_t id) noexcept
+	{
+		if (id == 0 || ids.empty()) {
+			return false;
+		}
+		const std::uint32_t* base = ids.data();
+		std::size_t          n = ids.size();
+		while (n > 1) {
+			const auto half = n / 2;
+			base = base[half] < id ? base + half : base;
+			n -= half;
+		}
+		return *base == id || (*base < id && base + 1 < ids.data() + ids.size() && base[1] == id);
+	}
+
+	[[nodiscard]] inline bool ContainsAny(const FormIdList& ids, std::uint32_t primaryId, std::uint32_t secondaryId) noexcept
+	{
+		return Contains(ids, primaryId) || (secondaryId != primaryId && Contains(ids, secondaryId));
+	}
+
+	inline void Insert(FormIdList& ids, std::uint32_t id)
+	{
+		if (id == 0) {
+			return;
+		}
+		const auto it = std::lower_bound(ids.begin(), ids.end(), id);
+		if (it == ids.end() || *it != id) {
+			ids.insert(it, id);
+		}
+	}
+
+	inline void Erase(FormIdList& ids, std::uint32_t id) noexcept
+	{
+		const auto it = std::lower_bound(ids.begin(), ids.end(), id);
+		if (it != ids.end() && *it == id) {
+			ids.erase(it);
+		}
+	}
+
+	// Merges many ids at once (a registration batch) instead of one O(n) insert each.
+	template <class Range>
+	void InsertAll(FormIdList& ids, const Range& added)
+	{
+		const auto middle = ids.size();
+		for (const auto id : added) {
+			if (id != 0) {
+				ids.push_back(static_cast<std::uint32_t>(id));
+			}
+		}
+		std::sort(ids.begin() + static_cast<std::ptrdiff_t>(middle), ids.end());
+		std::inplace_merge(ids.begin(), ids.begin() + static_cast<std::ptrdiff_t>(middle), ids.end());
+		ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+	}
+
+	// Replaces `ids` with an edited copy; snapshots still holding the old list keep it unchanged.
+	template <class Edit>
+	void Rewrite(SharedFormIdList& ids, Edit&& edit)
+	{
+		FormIdList next = *ids;
+		edit(next);
+		ids = Share(std::move(next));
+	}
+
+	// Keys of a set, or of a map via `key`.
+	template <class Container, class KeyOf>
+	[[nodiscard]] FormIdList SortedIds(const Container& source, KeyOf key)
+	{
+		FormIdList ids;
+		ids.reserve(source.size());
+		for (const auto& entry : source) {
+			ids.push_back(static_cast<std::uint32_t>(key(entry)));
+		}
+		std::sort(ids.begin(), ids.end());
+		return ids;
+	}
+
+	template <class Container>
+	[[nodiscard]] FormIdList SortedIds(const Container& source)
+	{
+		return SortedIds(source, [](const auto& id) { return id; });
+	}
+}
@@ -1,14 +1,18 @@
 #pragma once
 
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+#include "CodexOfPowerNG/RegistrationMapsCache.h"
+
 #include <RE/Skyrim.h>
 
 #include <cstdint>
 #include <filesystem>
 #include <functional>
 #include <optional>
+#include <string>
 #include <string_view>
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace CodexOfPowerNG::RegistrationMaps
 {
@@ -21,13 +25,77 @@ namespace CodexOfPowerNG::RegistrationMaps
 		std::filesystem::path pluginDataDir;
 		std::filesystem::path variantMapPath;
 		std::uint32_t         excludePatchMax{ 0 };
+		// Compiled copy of the resolved maps; empty disables caching.
+		std::filesystem::path cachePath{};
 	};
 
 	struct Data
 	{
-		std::unordered_set<RE::FormID>             excluded;
-		std::unordered_map<RE::FormID, RE::FormID> variantBase;
+		Containers::FlatFormIdSet             excluded;
+		Containers::FlatFormIdMap<RE::FormID> variantBase;
+	};
+
+	// Unresolved `{ "file", "id" }` pair as written in a source file.
+	struct EntryText
+	{
+		std::string file;
+		std::string id;
+	};
+
+	// Parse results that do not need game data. Each source is stamped before it is read, so a file
+	// edited mid-parse leaves a stale stamp and the cache is rebuilt next time. `complete` is false
+	// when a stamp could not be taken; such results are used but never cached.
+	struct ParsedExcludes
+	{
+		std::vector<Cache::SourceStamp> sources;
+		std::vector<EntryText>          entries;
+		bool                            complete{ true };
+	};
+
+	struct ParsedVariants
+	{
+		std::vector<Cache::SourceStamp>              sources;
+		std::vector<std::pair<EntryText, EntryText>> entries;
+		bool                                         complete{ true };
 	};
 
+	// Current source stamps plus the raw cache file; either may be missing.
+	struct CacheProbe
+	{
+		std::optional<std::vector<Cache::SourceStamp>> sources;
+		std::optional<std::string>                     bytes;
+	};
+
+	// Load-order fingerprint for a load whose plugins could not all be stamped: the cache is neither
+	// served nor rewritten.
+	inline constexpr std::uint64_t kUnknownLoadOrder = 0;
+
+	// Size and mtime of `path`; nullopt when the file system could not tell whether it exists.
+	[[nodiscard]] std::optional<Cache::SourceStamp> StampOf(const std::filesystem::path& path);
+
+	// File I/O + JSON decode stages; safe to run on worker threads before game data is loaded.
+	[[nodiscard]] CacheProbe     ProbeCache(const Paths& paths) noexcept;
+	[[nodiscard]] ParsedExcludes ParseExcludeSources(const Paths& paths) noexcept;
+	[[nodiscard]] ParsedVariants ParseVariantSources(const Paths& paths) noexcept;
+
+	// FormID resolution step (needs game data). Serves the cache when the probe matches the current
+	// load order; otherwise resolves the parsed entries and rewrites the cache.
+	[[nodiscard]] Data Resolve(
+		const Paths&          paths,
+		const CacheProbe&     probe,
+		const ParsedExcludes& excludes,
+		const ParsedVariants& variants,
+		std::uint64_t         loadOrderFingerprint,
+		const ResolveEntryFn& resolveEntry) noexcept;
+
+	// Parses every source file (streaming, no DOM) and resolves each entry.
 	[[nodiscard]] Data LoadFromDisk(const Paths& paths, const ResolveEntryFn& resolveEntry) noexcept;
+
+	// Serves the maps from `paths.cachePath` when its recorded source sizes/mtimes and load-order
+	// fingerprint still match; otherwise falls back to LoadFromDisk() and rewrites the cache.
+	// Sequential form of the stages above.
+	[[nodiscard]] Data LoadCached(
+		const Paths&          paths,
+		std::uint64_t         loadOrderFingerprint,
+		const ResolveEntryFn& resolveEntry) noexcept;
 }
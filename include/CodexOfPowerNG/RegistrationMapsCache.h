@@ -0,0 +1,247 @@
+#pragma once
+
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG::RegistrationMaps::Cache
+{
+	// The cache is written and read by the same x86-64 plugin, so integers are stored as-is.
+	static_assert(std::endian::native == std::endian::little);
+
+	inline constexpr char          kMagic[8] = { 'C', 'O', 'P', 'N', 'G', 'M', 'A', 'P' };
+	inline constexpr std::uint32_t kFormatVersion = 1;
+	inline constexpr std::uint64_t kFnvOffset = 14695981039346656037ull;
+	inline constexpr std::uint64_t kFnvPrime = 1099511628211ull;
+
+	[[nodiscard]] constexpr std::uint64_t Fnv1a64(std::string_view bytes, std::uint64_t hash = kFnvOffset) noexcept
+	{
+		for (const char c : bytes) {
+			hash ^= static_cast<std::uint8_t>(c);
+			hash *= kFnvPrime;
+		}
+		return hash;
+	}
+
+	// Folds one loaded plugin into a load-order fingerprint. The on-disk size and mtime are mixed in
+	// with the name and load index, so a plugin replaced in place (same name, same slot) invalidates.
+	[[nodiscard]] inline std::uint64_t MixPlugin(
+		std::uint64_t    hash,
+		std::string_view fileName,
+		std::uint32_t    loadIndex,
+		std::uint64_t    size,
+		std::int64_t     mtime) noexcept
+	{
+		const auto bytesOf = [](const auto& value) {
+			return std::string_view(reinterpret_cast<const char*>(&value), sizeof(value));
+		};
+		hash = Fnv1a64(fileName, hash);
+		hash = Fnv1a64(bytesOf(loadIndex), hash);
+		hash = Fnv1a64(bytesOf(size), hash);
+		return Fnv1a64(bytesOf(mtime), hash);
+	}
+
+	// One JSON source as seen on disk; a missing file is recorded too so creating it invalidates.
+	struct SourceStamp
+	{
+		std::string   path{};
+		bool          exists{ false };
+		std::uint64_t size{ 0 };
+		std::int64_t  mtime{ 0 };
+
+		[[nodiscard]] bool operator==(const SourceStamp&) const noexcept = default;
+	};
+
+	// Everything the resolved FormIDs depend on.
+	struct Key
+	{
+		std::uint64_t            loadOrder{ 0 };
+		std::vector<SourceStamp> sources{};
+
+		[[nodiscard]] bool operator==(const Key&) const noexcept = default;
+	};
+
+	struct Tables
+	{
+		Containers::FlatFormIdSet                   excluded{};
+		Containers::FlatFormIdMap<std::uint32_t>    variantBase{};
+	};
+
+	namespace Detail
+	{
+		// Fixed-size prefix; the body checksum covers everything after it.
+		struct Header
+		{
+			char          magic[8]{};
+			std::uint32_t formatVersion{ 0 };
+			std::uint32_t sourceCount{ 0 };
+			std::uint64_t loadOrder{ 0 };
+			std::uint32_t excludedCount{ 0 };
+			std::uint32_t variantCount{ 0 };
+			std::uint64_t bodySize{ 0 };
+			std::uint64_t bodyChecksum{ 0 };
+		};
+		static_assert(sizeof(Header) == 48);
+
+		template <class T>
+		void Append(std::vector<char>& out, const T& value)
+		{
+			const auto* bytes = reinterpret_cast<const char*>(&value);
+			out.insert(out.end(), bytes, bytes + sizeof(T));
+		}
+
+		class Reader
+		{
+		public:
+			explicit Reader(std::span<const char> bytes) noexcept :
+				_bytes(bytes)
+			{}
+
+			template <class T>
+			[[nodiscard]] bool Read(T& value) noexcept
+			{
+				if (_bytes.size() - _offset < sizeof(T)) {
+					return false;
+				}
+				std::memcpy(&value, _bytes.data() + _offset, sizeof(T));
+				_offset += sizeof(T);
+				return true;
+			}
+
+			[[nodiscard]] std::optional<std::string_view> Take(std::size_t size) noexcept
+			{
+				if (_bytes.size() - _offset < size) {
+					return std::nullopt;
+				}
+				const std::string_view view(_bytes.data() + _offset, size);
+				_offset += size;
+				return view;
+			}
+
+			[[nodiscard]] bool AtEnd() const noexcept { return _offset == _bytes.size(); }
+
+		private:
+			std::span<const char> _bytes;
+			std::size_t           _offset{ 0 };
+		};
+	}
+
+	// Layout: Header, then per source {u64 size, i64 mtime, u32 exists, u32 pathLength, path bytes},
+	// then the excluded ids ascending, then (variant, base) pairs ascending by variant.
+	[[nodiscard]] inline std::vector<char> Encode(const Key& key, const Tables& tables)
+	{
+		std::vector<std::uint32_t> excluded;
+		excluded.reserve(tables.excluded.size());
+		for (const auto formId : tables.excluded) {
+			excluded.push_back(formId);
+		}
+		std::sort(excluded.begin(), excluded.end());
+
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> variants;
+		variants.reserve(tables.variantBase.size());
+		for (const auto& entry : tables.variantBase) {
+			variants.emplace_back(entry.first, entry.second);
+		}
+		std::sort(variants.begin(), variants.end());
+
+		std::vector<char> out(sizeof(Detail::Header));
+		for (const auto& source : key.sources) {
+			Detail::Append(out, source.size);
+			Detail::Append(out, source.mtime);
+			Detail::Append(out, static_cast<std::uint32_t>(source.exists ? 1u : 0u));
+			Detail::Append(out, static_cast<std::uint32_t>(source.path.size()));
+			out.insert(out.end(), source.path.begin(), source.path.end());
+		}
+		for (const auto formId : excluded) {
+			Detail::Append(out, formId);
+		}
+		for (const auto& [variant, base] : variants) {
+			Detail::Append(out, variant);
+			Detail::Append(out, base);
+		}
+
+		Detail::Header header{};
+		std::memcpy(header.magic, kMagic, sizeof(kMagic));
+		header.formatVersion = kFormatVersion;
+		header.sourceCount = static_cast<std::uint32_t>(key.sources.size());
+		header.loadOrder = key.loadOrder;
+		header.excludedCount = static_cast<std::uint32_t>(excluded.size());
+		header.variantCount = static_cast<std::uint32_t>(variants.size());
+		header.bodySize = out.size() - sizeof(Detail::Header);
+		header.bodyChecksum = Fnv1a64(std::string_view(out.data() + sizeof(Detail::Header), header.bodySize));
+		std::memcpy(out.data(), &header, sizeof(header));
+		return out;
+	}
+
+	// nullopt unless `bytes` is an intact cache written for exactly `expected`.
+	[[nodiscard]] inline std::optional<Tables> Decode(std::span<const char> bytes, const Key& expected)
+	{
+		Detail::Reader reader(bytes);
+		Detail::Header header{};
+		if (!reader.Read(header) || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+			header.formatVersion != kFormatVersion || header.loadOrder != expected.loadOrder ||
+			header.sourceCount != expected.sources.size() || header.bodySize != bytes.size() - sizeof(Detail::Header)) {
+			return std::nullopt;
+		}
+		if (Fnv1a64(std::string_view(bytes.data() + sizeof(Detail::Header), header.bodySize)) != header.bodyChecksum) {
+			return std::nullopt;
+		}
+
+		for (const auto& source : expected.sources) {
+			SourceStamp stamp{};
+			std::uint32_t exists = 0;
+			std::uint32_t pathLength = 0;
+			if (!reader.Read(stamp.size) || !reader.Read(stamp.mtime) || !reader.Read(exists) || !reader.Read(pathLength)) {
+				return std::nullopt;
+			}
+			const auto path = reader.Take(pathLength);
+			if (!path) {
+				return std::nullopt;
+			}
+			stamp.exists = exists != 0;
+			stamp.path.assign(*path);
+			if (!(stamp == source)) {
+				return std::nullopt;
+			}
+		}
+
+		Tables tables{};
+		tables.excluded.reserve(header.excludedCount);
+		std::uint32_t previous = 0;
+		for (std::uint32_t i = 0; i < header.excludedCount; ++i) {
+			std::uint32_t formId = 0;
+			if (!reader.Read(formId) || formId <= previous) {
+				return std::nullopt;
+			}
+			tables.excluded.insert(formId);
+			previous = formId;
+		}
+
+		tables.variantBase.reserve(header.variantCount);
+		previous = 0;
+		for (std::uint32_t i = 0; i < header.variantCount; ++i) {
+			std::uint32_t variant = 0;
+			std::uint32_t base = 0;
+			if (!reader.Read(variant) || !reader.Read(base) || variant <= previous || base == 0) {
+				return std::nullopt;
+			}
+			tables.variantBase.emplace(variant, base);
+			previous = variant;
+		}
+
+		if (!reader.AtEnd()) {
+			return std::nullopt;
+		}
+		return tables;
+	}
+}
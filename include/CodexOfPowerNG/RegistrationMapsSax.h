@@ -0,0 +1,182 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace CodexOfPowerNG::RegistrationMaps::Sax
+{
+	struct FormRef
+	{
+		std::string file{};
+		std::string id{};
+		bool        hasFile{ false };
+		bool        hasId{ false };
+
+		[[nodiscard]] bool Complete() const noexcept { return hasFile && hasId; }
+	};
+
+	namespace Detail
+	{
+		enum class Kind : std::uint8_t
+		{
+			kExclude,  // { "forms": [ { "file": "...", "id": "..." } ] }
+			kVariant,  // { "mappings": [ { "variant": { "file", "id" }, "base": { "file", "id" } } ] }
+		};
+
+		// Streams the map files without building a DOM. Only string fields at the expected depth are
+		// kept; entries missing a string field are dropped, like the DOM loader's type checks did.
+		template <Kind K, class OnEntry>
+		class MapEntryHandler final : public nlohmann::json_sax<nlohmann::json>
+		{
+		public:
+			explicit MapEntryHandler(OnEntry& onEntry) noexcept :
+				_onEntry(onEntry)
+			{}
+
+			bool null() override { return true; }
+			bool boolean(bool) override { return true; }
+			bool number_integer(number_integer_t) override { return true; }
+			bool number_unsigned(number_unsigned_t) override { return true; }
+			bool number_float(number_float_t, const string_t&) override { return true; }
+			bool binary(binary_t&) override { return true; }
+
+			bool string(string_t& value) override
+			{
+				FormRef* target = nullptr;
+				if (K == Kind::kExclude && _inEntry && _depth == kEntryDepth) {
+					target = &_first;
+				} else if (_group && _depth == kEntryDepth + 1) {
+					target = _group;
+				}
+				if (target) {
+					if (_key == "file") {
+						target->file = std::move(value);
+						target->hasFile = true;
+					} else if (_key == "id") {
+						target->id = std::move(value);
+						target->hasId = true;
+					}
+				}
+				return true;
+			}
+
+			bool key(string_t& value) override
+			{
+				_key = std::move(value);
+				return true;
+			}
+
+			bool start_object(std::size_t) override
+			{
+				++_depth;
+				if (_depth == 1) {
+					_topIsObject = true;
+				} else if (_inList && _depth == kEntryDepth) {
+					_inEntry = true;
+					_first = {};
+					_second = {};
+				} else if (K == Kind::kVariant && _inEntry && _depth == kEntryDepth + 1) {
+					_group = _key == "variant" ? &_first : _key == "base" ? &_second : nullptr;
+					if (_group) {
+						*_group = {};
+					}
+				}
+				return true;
+			}
+
+			bool end_object() override
+			{
+				if (_group && _depth == kEntryDepth + 1) {
+					_group = nullptr;
+				} else if (_inEntry && _depth == kEntryDepth) {
+					_inEntry = false;
+					if constexpr (K == Kind::kExclude) {
+						if (_first.Complete()) {
+							_onEntry(std::as_const(_first));
+						}
+					} else {
+						if (_first.Complete() && _second.Complete()) {
+							_onEntry(std::as_const(_first), std::as_const(_second));
+						}
+					}
+				}
+				--_depth;
+				return true;
+			}
+
+			bool start_array(std::size_t) override
+			{
+				++_depth;
+				if (_topIsObject && _depth == kEntryDepth - 1 && _key == kListKey) {
+					_inList = true;
+				}
+				return true;
+			}
+
+			bool end_array() override
+			{
+				if (_inList && _depth == kEntryDepth - 1) {
+					_inList = false;
+				}
+				--_depth;
+				return true;
+			}
+
+			bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override
+			{
+				_error = e.what();
+				return false;
+			}
+
+			[[nodiscard]] const std::string& Error() const noexcept { return _error; }
+
+		private:
+			// Top-level object = 1, the list array = 2, its entry objects = 3.
+			static constexpr std::size_t      kEntryDepth = 3;
+			static constexpr std::string_view kListKey = K == Kind::kExclude ? "forms" : "mappings";
+
+			OnEntry&         _onEntry;
+			std::string      _key{};
+			std::string      _error{};
+			FormRef          _first{};
+			FormRef          _second{};
+			FormRef*         _group{ nullptr };
+			std::size_t      _depth{ 0 };
+			bool             _topIsObject{ false };
+			bool             _inList{ false };
+			bool             _inEntry{ false };
+		};
+
+		template <Kind K, class OnEntry>
+		[[nodiscard]] bool Parse(std::string_view text, OnEntry& onEntry, std::string* error)
+		{
+			MapEntryHandler<K, OnEntry> handler(onEntry);
+			// Non-strict like `stream >> json`: trailing bytes after the document are ignored.
+			const bool ok = nlohmann::json::sax_parse(text, &handler, nlohmann::json::input_format_t::json, false);
+			if (!ok && error) {
+				*error = handler.Error();
+			}
+			return ok;
+		}
+	}
+
+	// Calls onEntry(const FormRef&) per complete `forms` entry. Returns false on malformed JSON;
+	// entries reported before the error should then be discarded by the caller.
+	template <class OnEntry>
+	[[nodiscard]] bool ParseExcludeEntries(std::string_view text, OnEntry&& onEntry, std::string* error = nullptr)
+	{
+		return Detail::Parse<Detail::Kind::kExclude>(text, onEntry, error);
+	}
+
+	// Calls onEntry(const FormRef& variant, const FormRef& base) per complete `mappings` entry.
+	template <class OnEntry>
+	[[nodiscard]] bool ParseVariantEntries(std::string_view text, OnEntry&& onEntry, std::string* error = nullptr)
+	{
+		return Detail::Parse<Detail::Kind::kVariant>(text, onEntry, error);
+	}
+}
@@ -1,14 +1,37 @@
 #pragma once
 
+#include "CodexOfPowerNG/RegistrationQuestProtectionIndex.h"
+
 #include <RE/Skyrim.h>
 
-#include <unordered_set>
+#include <cstdint>
+#include <span>
 
 namespace CodexOfPowerNG::Registration::QuestGuard
 {
-	/// Returns a snapshot of base FormIDs referenced by running quest RefAliases (TTL-cached).
-	[[nodiscard]] std::unordered_set<RE::FormID> SnapshotProtectedForms();
+	using ProtectedForms = QuestProtection::ProtectedForms;
+
+	struct Snapshot
+	{
+		ProtectedForms forms{};
+		std::uint64_t  version{ 0 };
+	};
+
+	/// Installs the quest start/stop/init/stage sinks (once) and starts a reconciliation pass.
+	void OnGameLoaded() noexcept;
 
-	/// Single-FormID convenience check against the cached set.
+	/// Base FormIDs referenced by running quest RefAliases, shared with the index (O(1) copy).
+	[[nodiscard]] Snapshot SnapshotProtectedForms();
+
+	/// Bumped whenever the protected set changes; lock-free.
+	[[nodiscard]] std::uint64_t Version() noexcept;
+
+	/// Single-FormID check against the published set; lock-free.
 	[[nodiscard]] bool IsQuestProtected(RE::FormID formId) noexcept;
+
+	/// Like IsQuestProtected for any of `formIds`, but when the published set may be stale (a pass
+	/// or quest event is still pending) it also checks the running quests' aliases, walked at most once
+	/// per frame. Main thread only; for the register path, which must not consume an item a script
+	/// just made a quest target.
+	[[nodiscard]] bool IsQuestProtectedNow(std::span<const RE::FormID> formIds) noexcept;
 }
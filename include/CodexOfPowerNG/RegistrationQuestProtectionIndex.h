@@ -0,0 +1,186 @@
+#pragma once
+
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG::Registration::QuestProtection
+{
+	using FormIdList = std::vector<std::uint32_t>;
+
+	// Protected base form -> number of running quests whose aliases hold it.
+	using ProtectedForms = Containers::FlatFormIdMap<std::uint32_t>;
+
+	// What one quest protects right now; `questId == 0` skips the slot (null form).
+	struct QuestForms
+	{
+		std::uint32_t questId{ 0 };
+		FormIdList    forms{};
+	};
+
+	struct QuestEntry
+	{
+		FormIdList    forms{};
+		std::uint64_t seenPass{ 0 };
+	};
+
+	// Incrementally maintained union of the forms referenced by running quests' aliases.
+	//
+	// Quest events replace one quest's contribution at a time; a reconciliation pass walks every
+	// quest in resumable steps and afterwards drops quests it no longer saw. `protectedForms` is the
+	// set readers need and is cheap to copy (it shares storage until the next change).
+	struct ProtectionIndex
+	{
+		std::unordered_map<std::uint32_t, QuestEntry> quests{};
+		ProtectedForms                                protectedForms{};
+		std::uint64_t                                 pass{ 0 };
+		std::size_t                                   cursor{ 0 };
+		bool                                          sweeping{ false };
+		bool                                          changed{ false };
+	};
+
+	namespace Detail
+	{
+		inline void Retain(ProtectionIndex& index, std::uint32_t formId)
+		{
+			if (++index.protectedForms[formId] == 1u) {
+				index.changed = true;
+			}
+		}
+
+		inline void Release(ProtectionIndex& index, std::uint32_t formId)
+		{
+			const auto it = index.protectedForms.find(formId);
+			if (it == index.protectedForms.end()) {
+				return;
+			}
+			if (--it->second == 0u) {
+				index.protectedForms.erase(it);
+				index.changed = true;
+			}
+		}
+	}
+
+	// Replaces what `questId` protects (an empty list drops the quest). Only forms that differ from
+	// the quest's previous list touch the counts.
+	inline void SetQuestForms(ProtectionIndex& index, std::uint32_t questId, FormIdList forms)
+	{
+		std::sort(forms.begin(), forms.end());
+		forms.erase(std::unique(forms.begin(), forms.end()), forms.end());
+		forms.erase(std::remove(forms.begin(), forms.end(), 0u), forms.end());
+
+		const auto it = index.quests.find(questId);
+		if (it == index.quests.end()) {
+			if (forms.empty()) {
+				return;
+			}
+			for (const auto formId : forms) {
+				Detail::Retain(index, formId);
+			}
+			index.quests.emplace(questId, QuestEntry{ std::move(forms), index.pass });
+			return;
+		}
+
+		auto& previous = it->second.forms;
+		auto  oldIt = previous.begin();
+		auto  newIt = forms.begin();
+		while (oldIt != previous.end() || newIt != forms.end()) {
+			if (newIt == forms.end() || (oldIt != previous.end() && *oldIt < *newIt)) {
+				Detail::Release(index, *oldIt++);
+			} else if (oldIt == previous.end() || *newIt < *oldIt) {
+				Detail::Retain(index, *newIt++);
+			} else {
+				++oldIt;
+				++newIt;
+			}
+		}
+
+		if (forms.empty()) {
+			index.quests.erase(it);
+			return;
+		}
+		previous = std::move(forms);
+		it->second.seenPass = index.pass;
+	}
+
+	inline void BeginSweep(ProtectionIndex& index) noexcept
+	{
+		++index.pass;
+		index.cursor = 0;
+		index.sweeping = true;
+	}
+
+	// Advances the reconciliation pass over `questCount` quests; `visit(i)` returns the QuestForms
+	// of quest i. Stops early when `shouldYield()` (asked after each quest) says so. Returns true once
+	// the pass is complete, after dropping quests the pass did not see.
+	template <class Visit, class ShouldYield>
+	bool SweepStep(ProtectionIndex& index, std::size_t questCount, Visit&& visit, ShouldYield&& shouldYield)
+	{
+		if (!index.sweeping) {
+			return true;
+		}
+
+		while (index.cursor < questCount) {
+			auto quest = visit(index.cursor++);
+			if (quest.questId != 0) {
+				SetQuestForms(index, quest.questId, std::move(quest.forms));
+				if (const auto it = index.quests.find(quest.questId); it != index.quests.end()) {
+					it->second.seenPass = index.pass;
+				}
+			}
+			if (index.cursor < questCount && shouldYield()) {
+				return false;
+			}
+		}
+
+		std::vector<std::uint32_t> stale;
+		for (const auto& [questId, entry] : index.quests) {
+			if (entry.seenPass != index.pass) {
+				stale.push_back(questId);
+			}
+		}
+		for (const auto questId : stale) {
+			SetQuestForms(index, questId, {});
+		}
+		index.sweeping = false;
+		return true;
+	}
+
+	// True (once) when the protected set changed since the last call.
+	[[nodiscard]] inline bool TakeChanged(ProtectionIndex& index) noexcept
+	{
+		return std::exchange(index.changed, false);
+	}
+
+	// Forms held by running quests' aliases as one live walk saw them, for checks made while the
+	// published set is stale. Every check under the same key (the main-task frame) reuses the walk,
+	// so a register batch slice walks the quests at most once however many items it plans.
+	struct LiveWalk
+	{
+		Containers::FlatFormIdSet forms{};
+		std::uint64_t             key{ 0 };
+		std::size_t               walks{ 0 };
+		bool                      valid{ false };
+	};
+
+	// `walk(forms)` inserts every alias form of the running quests into `forms`; a walk that throws
+	// leaves nothing cached.
+	template <class Walk>
+	[[nodiscard]] const Containers::FlatFormIdSet& LiveForms(LiveWalk& live, std::uint64_t key, Walk&& walk)
+	{
+		if (!live.valid || live.key != key) {
+			live.valid = false;
+			live.forms.clear();
+			walk(live.forms);
+			live.key = key;
+			live.valid = true;
+			++live.walks;
+		}
+		return live.forms;
+	}
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "CodexOfPowerNG/RankedList.h"
+#include "CodexOfPowerNG/RegistrationListOrder.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG::Registration::QuickListIndex
+{
+	template <class Item>
+	using ItemRef = ListOrder::ItemRef<Item>;
+
+	// Persistent quick-register eligible set.
+	//
+	// `Item` must expose `formId`, `regKey`, `group` and `name` (text or interned). One item per
+	// regKey is visible (the representative); other inventory objects that normalize to the same
+	// regKey are kept as members so they can take over when the representative leaves the inventory.
+	// Visible items are kept in an order-statistics list on ListOrder, so a page at any offset costs
+	// O(log n + pageSize) and a single insert/erase O(log n) plus one leaf shift. Members are also
+	// listed per regKey, so dropping an object or a regKey only touches that regKey's members.
+	template <class Item>
+	struct EligibleIndex
+	{
+		Containers::RankedList<ItemRef<Item>, ListOrder::RefLess<Item>> items{};
+		std::unordered_map<std::uint32_t, std::uint32_t>                 members{};
+		std::unordered_map<std::uint32_t, std::vector<std::uint32_t>>    regKeyMembers{};
+		std::unordered_map<std::uint32_t, ItemRef<Item>>                 visible{};
+		std::unordered_set<std::uint32_t>                                dirtyObjects{};
+		std::uint32_t                                                    settingsMask{ 0 };
+		bool                                                             built{ false };
+	};
+
+	namespace Detail
+	{
+		template <class Item>
+		void InsertVisible(EligibleIndex<Item>& index, Item item)
+		{
+			auto ref = std::make_shared<const Item>(std::move(item));
+			index.visible[ref->regKey] = ref;
+			(void)index.items.insert(std::move(ref));
+		}
+
+		template <class Item>
+		void EraseVisible(EligibleIndex<Item>& index, std::uint32_t regKey)
+		{
+			const auto it = index.visible.find(regKey);
+			if (it == index.visible.end()) {
+				return;
+			}
+			(void)index.items.erase(it->second);
+			index.visible.erase(it);
+		}
+
+		template <class Item>
+		void AddMember(EligibleIndex<Item>& index, std::uint32_t objectId, std::uint32_t regKey)
+		{
+			if (index.members.insert_or_assign(objectId, regKey).second) {
+				index.regKeyMembers[regKey].push_back(objectId);
+			}
+		}
+
+		// Unlists `objectId` from `regKey`; returns how many members remain for it.
+		template <class Item>
+		std::size_t DropMember(EligibleIndex<Item>& index, std::uint32_t regKey, std::uint32_t objectId)
+		{
+			const auto it = index.regKeyMembers.find(regKey);
+			if (it == index.regKeyMembers.end()) {
+				return 0;
+			}
+			auto& objects = it->second;
+			if (const auto pos = std::find(objects.begin(), objects.end(), objectId); pos != objects.end()) {
+				*pos = objects.back();
+				objects.pop_back();
+			}
+			if (objects.empty()) {
+				index.regKeyMembers.erase(it);
+				return 0;
+			}
+			return objects.size();
+		}
+
+		template <class Item>
+		[[nodiscard]] std::uint32_t RepresentativeOf(const EligibleIndex<Item>& index, std::uint32_t regKey) noexcept
+		{
+			const auto it = index.visible.find(regKey);
+			return it != index.visible.end() ? it->second->formId : 0u;
+		}
+	}
+
+	template <class Item>
+	[[nodiscard]] bool NeedsRebuild(const EligibleIndex<Item>& index, std::uint32_t settingsMask) noexcept
+	{
+		return !index.built || index.settingsMask != settingsMask;
+	}
+
+	template <class Item>
+	void RequestRebuild(EligibleIndex<Item>& index) noexcept
+	{
+		index.built = false;
+		index.dirtyObjects.clear();
+	}
+
+	// Replaces the whole index from a full scan. Input may contain several objects per regKey;
+	// the first one in sorted order becomes the representative.
+	template <class Item>
+	void Rebuild(EligibleIndex<Item>& index, std::vector<Item> candidates, std::uint32_t settingsMask)
+	{
+		if (!std::is_sorted(candidates.begin(), candidates.end(), &ListOrder::Less<Item>)) {
+			std::sort(candidates.begin(), candidates.end(), &ListOrder::Less<Item>);
+		}
+
+		index.members.clear();
+		index.regKeyMembers.clear();
+		index.visible.clear();
+		index.dirtyObjects.clear();
+
+		std::vector<ItemRef<Item>> sorted;
+		sorted.reserve(candidates.size());
+		for (auto& item : candidates) {
+			Detail::AddMember(index, item.formId, item.regKey);
+			if (!index.visible.contains(item.regKey)) {
+				auto ref = std::make_shared<const Item>(std::move(item));
+				index.visible.emplace(ref->regKey, ref);
+				sorted.push_back(std::move(ref));
+			}
+		}
+		index.items.assign_sorted(std::move(sorted));
+
+		index.settingsMask = settingsMask;
+		index.built = true;
+	}
+
+	template <class Item>
+	void MarkObjectDirty(EligibleIndex<Item>& index, std::uint32_t objectId)
+	{
+		if (index.built && objectId != 0) {
+			index.dirtyObjects.insert(objectId);
+		}
+	}
+
+	// Marks every indexed inventory object dirty, for changes no event reports (favorites, TCC lists).
+	template <class Item>
+	void MarkAllDirty(EligibleIndex<Item>& index)
+	{
+		if (!index.built) {
+			return;
+		}
+		for (const auto& entry : index.members) {
+			index.dirtyObjects.insert(entry.first);
+		}
+	}
+
+	// Marks `formId` dirty both as an inventory object and as a regKey (via its representative).
+	template <class Item>
+	void MarkFormDirty(EligibleIndex<Item>& index, std::uint32_t formId)
+	{
+		MarkObjectDirty(index, formId);
+		if (const auto representative = Detail::RepresentativeOf(index, formId); representative != 0) {
+			MarkObjectDirty(index, representative);
+		}
+	}
+
+	template <class Item>
+	[[nodiscard]] std::unordered_set<std::uint32_t> TakeDirtyObjects(EligibleIndex<Item>& index) noexcept
+	{
+		return std::exchange(index.dirtyObjects, {});
+	}
+
+	// Drops an inventory object that is gone or no longer eligible. If it was the visible
+	// representative, remaining members of the same regKey are marked dirty for re-evaluation.
+	template <class Item>
+	void EraseObject(EligibleIndex<Item>& index, std::uint32_t objectId)
+	{
+		const auto memberIt = index.members.find(objectId);
+		if (memberIt == index.members.end()) {
+			return;
+		}
+
+		const auto regKey = memberIt->second;
+		index.members.erase(memberIt);
+		const auto remaining = Detail::DropMember(index, regKey, objectId);
+
+		if (Detail::RepresentativeOf(index, regKey) != objectId) {
+			return;
+		}
+
+		Detail::EraseVisible(index, regKey);
+		if (remaining == 0) {
+			return;
+		}
+
+		for (const auto memberId : index.regKeyMembers.at(regKey)) {
+			index.dirtyObjects.insert(memberId);
+		}
+	}
+
+	// Applies a fresh evaluation of one inventory object that is (still) eligible.
+	template <class Item>
+	void Upsert(EligibleIndex<Item>& index, Item item)
+	{
+		if (const auto it = index.members.find(item.formId); it != index.members.end() && it->second != item.regKey) {
+			EraseObject(index, item.formId);
+		}
+
+		Detail::AddMember(index, item.formId, item.regKey);
+
+		const auto representative = Detail::RepresentativeOf(index, item.regKey);
+		if (representative != 0 && representative != item.formId) {
+			return;
+		}
+
+		Detail::EraseVisible(index, item.regKey);
+		Detail::InsertVisible(index, std::move(item));
+	}
+
+	// Drops every object normalized to `regKey` (registered or blocked).
+	template <class Item>
+	void EraseRegKey(EligibleIndex<Item>& index, std::uint32_t regKey)
+	{
+		Detail::EraseVisible(index, regKey);
+
+		const auto it = index.regKeyMembers.find(regKey);
+		if (it == index.regKeyMembers.end()) {
+			return;
+		}
+
+		for (const auto memberId : it->second) {
+			index.members.erase(memberId);
+			index.dirtyObjects.erase(memberId);
+		}
+		index.regKeyMembers.erase(it);
+	}
+
+	// Copies references for up to `limit` visible rows starting at `offset`.
+	template <class Item>
+	[[nodiscard]] std::vector<ItemRef<Item>> Page(const EligibleIndex<Item>& index, std::size_t offset, std::size_t limit)
+	{
+		std::vector<ItemRef<Item>> page;
+		if (offset < index.items.size()) {
+			page.reserve((std::min)(limit, index.items.size() - offset));
+		}
+		index.items.for_each_range(offset, limit, [&page](const ItemRef<Item>& ref) { page.push_back(ref); });
+		return page;
+	}
+}
@@ -1,12 +1,12 @@
 #pragma once
 
+#include "CodexOfPowerNG/FlatFormIdMap.h"
 #include "CodexOfPowerNG/RegistrationUndoTypes.h"
 
 #include <RE/Skyrim.h>
 
 #include <cstdint>
 #include <optional>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -14,8 +14,15 @@ namespace CodexOfPowerNG::RegistrationStateStore
 {
 	struct QuickListSnapshot
 	{
-		std::unordered_set<RE::FormID> blockedItems;
-		std::unordered_set<RE::FormID> registeredKeys;
+		// Shared with RuntimeState until the next write (see FlatFormIdMap.h).
+		Containers::FlatFormIdSet                blockedItems;
+		Containers::FlatFormIdMap<std::uint32_t> registeredItems;
+	};
+
+	struct BatchCommitResult
+	{
+		std::size_t   totalRegistered{ 0 };
+		std::uint64_t actionId{ 0 };
 	};
 
 	class IRegistrationStateStore
@@ -31,10 +38,15 @@ public:
 		[[nodiscard]] virtual std::size_t InsertRegistered(RE::FormID regKeyId, std::uint32_t group) noexcept = 0;
 		[[nodiscard]] virtual bool        RemoveRegistered(RE::FormID regKeyId) noexcept = 0;
 
+		// Registers every record's regKey and files the records as one undo group, under one lock.
+		[[nodiscard]] virtual BatchCommitResult CommitRegisterBatch(
+			std::vector<Registration::UndoRecord> records,
+			std::uint64_t                         joinActionId) noexcept = 0;
+
 		[[nodiscard]] virtual std::uint64_t PushUndoRecord(Registration::UndoRecord record) noexcept = 0;
-		[[nodiscard]] virtual std::optional<Registration::UndoRecord> PopLatestUndoRecord(std::uint64_t actionId) noexcept = 0;
-		virtual void                                               RestoreUndoRecord(Registration::UndoRecord record) noexcept = 0;
-		[[nodiscard]] virtual std::vector<Registration::UndoRecord> SnapshotUndoRecords(std::size_t limit) noexcept = 0;
+		[[nodiscard]] virtual std::vector<Registration::UndoRecord> PopLatestUndoGroup(std::uint64_t actionId) noexcept = 0;
+		virtual void RestoreUndoGroup(std::vector<Registration::UndoRecord> records) noexcept = 0;
+		[[nodiscard]] virtual std::vector<std::vector<Registration::UndoRecord>> SnapshotUndoGroups(std::size_t limit) noexcept = 0;
 
 		[[nodiscard]] virtual QuickListSnapshot SnapshotQuickList() noexcept = 0;
 		[[nodiscard]] virtual std::vector<std::pair<RE::FormID, std::uint32_t>> SnapshotRegisteredItems() noexcept = 0;
@@ -52,10 +64,14 @@ public:
 	[[nodiscard]] std::size_t InsertRegistered(RE::FormID regKeyId, std::uint32_t group) noexcept;
 	[[nodiscard]] bool        RemoveRegistered(RE::FormID regKeyId) noexcept;
 
+	[[nodiscard]] BatchCommitResult CommitRegisterBatch(
+		std::vector<Registration::UndoRecord> records,
+		std::uint64_t                         joinActionId) noexcept;
+
 	[[nodiscard]] std::uint64_t PushUndoRecord(Registration::UndoRecord record) noexcept;
-	[[nodiscard]] std::optional<Registration::UndoRecord> PopLatestUndoRecord(std::uint64_t actionId) noexcept;
-	void                                                  RestoreUndoRecord(Registration::UndoRecord record) noexcept;
-	[[nodiscard]] std::vector<Registration::UndoRecord>   SnapshotUndoRecords(std::size_t limit) noexcept;
+	[[nodiscard]] std::vector<Registration::UndoRecord> PopLatestUndoGroup(std::uint64_t actionId) noexcept;
+	void                                                RestoreUndoGroup(std::vector<Registration::UndoRecord> records) noexcept;
+	[[nodiscard]] std::vector<std::vector<Registration::UndoRecord>> SnapshotUndoGroups(std::size_t limit) noexcept;
 
 	[[nodiscard]] QuickListSnapshot SnapshotQuickList() noexcept;
 	[[nodiscard]] std::vector<std::pair<RE::FormID, std::uint32_t>> SnapshotRegisteredItems() noexcept;
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CodexOfPowerNG::Registration::TccMembership
+{
+	// O(1) summary of a FormList's two arrays (plugin-defined forms and script-added ids). LOTD only
+	// appends to and removes from dbmDisp, so any change moves a count or the tail id.
+	struct Fingerprint
+	{
+		std::uint32_t formCount{ 0 };
+		std::uint32_t lastFormId{ 0 };
+		std::uint32_t addedCount{ 0 };
+		std::uint32_t lastAddedId{ 0 };
+
+		[[nodiscard]] bool operator==(const Fingerprint&) const noexcept = default;
+	};
+
+	// Every FormID a list answers HasForm() for, keyed the way the gate asks.
+	struct ListMembership
+	{
+		Fingerprint               fingerprint{};
+		Containers::FlatFormIdSet forms{};
+	};
+
+	// `formIdOf` maps an element of `forms` to its FormID (0 for null entries).
+	template <class Forms, class FormIdOf, class AddedIds>
+	[[nodiscard]] ListMembership Build(
+		const Fingerprint& fingerprint,
+		const Forms&       forms,
+		FormIdOf&&         formIdOf,
+		const AddedIds*    addedIds)
+	{
+		ListMembership membership{ fingerprint, {} };
+		membership.forms.reserve(static_cast<std::size_t>(fingerprint.formCount) + fingerprint.addedCount);
+		for (const auto& form : forms) {
+			if (const std::uint32_t formId = formIdOf(form); formId != 0) {
+				membership.forms.insert(formId);
+			}
+		}
+		if (addedIds) {
+			for (const std::uint32_t formId : *addedIds) {
+				if (formId != 0) {
+					membership.forms.insert(formId);
+				}
+			}
+		}
+		return membership;
+	}
+
+	[[nodiscard]] inline bool HasEither(
+		const ListMembership& membership,
+		std::uint32_t         first,
+		std::uint32_t         second) noexcept
+	{
+		return (first != 0 && membership.forms.contains(first)) ||
+		       (second != 0 && second != first && membership.forms.contains(second));
+	}
+}
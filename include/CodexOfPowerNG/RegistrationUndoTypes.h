@@ -4,6 +4,7 @@
 
 #include <RE/Skyrim.h>
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -36,4 +37,7 @@ namespace CodexOfPowerNG::Registration
 		std::optional<BuildScoreContribution>    buildContribution;
 		std::vector<RewardDelta>                 rewardDeltas;
 	};
+
+	// Build contributions summed per discipline (a registration batch or an undo group).
+	using BuildContributionTotals = std::array<std::optional<BuildScoreContribution>, Builds::kBuildDisciplineCount>;
 }
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace CodexOfPowerNG::Registration::VariantRoots
+{
+	// FormID -> root FormID. Ids that are their own root are kept too, so a miss means "not a variant".
+	using Table = Containers::FlatFormIdMap<std::uint32_t>;
+
+	struct CompileStats
+	{
+		std::size_t cycles{ 0 };    // chains that looped back; broken at the last new node
+		std::size_t maxDepth{ 0 };  // longest chain walked before reaching a known root
+	};
+
+	// Follows `variantBase` from every key while `acceptStep(current, next)` holds and records where
+	// each chain ends. Walks share their results, so the whole map costs O(entries).
+	template <class AcceptStep>
+	[[nodiscard]] Table Compile(
+		const Containers::FlatFormIdMap<std::uint32_t>& variantBase,
+		AcceptStep&&                                    acceptStep,
+		CompileStats*                                   stats = nullptr)
+	{
+		Table roots;
+		roots.reserve(variantBase.size() * 2);
+
+		std::vector<std::uint32_t> path;
+		for (const auto& entry : variantBase) {
+			if (roots.find(entry.first) != roots.end()) {
+				continue;
+			}
+
+			path.clear();
+			std::uint32_t current = entry.first;
+			std::uint32_t root = current;
+			for (;;) {
+				path.push_back(current);
+				if (const auto known = roots.find(current); known != roots.end()) {
+					path.pop_back();
+					root = known->second;
+					break;
+				}
+				const auto next = variantBase.find(current);
+				if (next == variantBase.end() || !acceptStep(current, next->second)) {
+					root = current;
+					break;
+				}
+				if (std::find(path.begin(), path.end(), next->second) != path.end()) {
+					root = current;
+					if (stats) {
+						++stats->cycles;
+					}
+					break;
+				}
+				current = next->second;
+			}
+
+			if (stats) {
+				stats->maxDepth = (std::max)(stats->maxDepth, path.size());
+			}
+			for (const auto id : path) {
+				roots.insert_or_assign(id, root);
+			}
+		}
+		return roots;
+	}
+
+	// Root of `id`, or `id` itself when it is not part of any chain. One probe.
+	[[nodiscard]] inline std::uint32_t Resolve(const Table& roots, std::uint32_t id) noexcept
+	{
+		const auto it = roots.find(id);
+		return it != roots.end() ? it->second : id;
+	}
+}
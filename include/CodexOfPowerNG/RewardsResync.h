@@ -3,6 +3,10 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace CodexOfPowerNG::Rewards
 {
@@ -281,4 +285,78 @@ namespace CodexOfPowerNG::Rewards
 		const float delta = cappedExpectedTotal - observed;
 		return (delta < -epsilon) ? delta : 0.0f;
 	}
+
+	// The four actor channels a resync pass reads for one AV.
+	struct RewardActorObservation
+	{
+		float base{ 0.0f };
+		float current{ 0.0f };
+		float permanent{ 0.0f };
+		float permanentModifier{ 0.0f };
+	};
+
+	[[nodiscard]] inline bool HasObservationDrifted(
+		const RewardActorObservation& settled,
+		const RewardActorObservation& observed,
+		float epsilon = 0.001f) noexcept
+	{
+		return std::abs(observed.base - settled.base) > epsilon ||
+		       std::abs(observed.current - settled.current) > epsilon ||
+		       std::abs(observed.permanent - settled.permanent) > epsilon ||
+		       std::abs(observed.permanentModifier - settled.permanentModifier) > epsilon;
+	}
+
+	// Remembers, per AV, the expected total and actor channels it last converged at. Steady-state
+	// passes skip the resync policy for AVs that are neither marked dirty (grant, refund, rollback,
+	// cap adjustment) nor changed since then, so only changed AVs pay for a full examination.
+	template <class ActorValue, class Hash = std::hash<ActorValue>>
+	class RewardResyncTracker
+	{
+	public:
+		void MarkDirty(ActorValue av) { _dirty.insert(av); }
+
+		// Load boundary or a bulk change: every AV is examined again.
+		void MarkAllDirty() noexcept
+		{
+			_dirty.clear();
+			_settled.clear();
+		}
+
+		[[nodiscard]] bool NeedsExamination(
+			ActorValue                    av,
+			float                         expectedTotal,
+			const RewardActorObservation& observed,
+			float                         epsilon = 0.001f) const
+		{
+			if (_dirty.contains(av)) {
+				return true;
+			}
+			const auto it = _settled.find(av);
+			if (it == _settled.end()) {
+				return true;
+			}
+			return std::abs(it->second.expectedTotal - expectedTotal) > epsilon ||
+			       HasObservationDrifted(it->second.observed, observed, epsilon);
+		}
+
+		// The AV needs no correction at `observed`; it is skipped until something changes.
+		void MarkSettled(ActorValue av, float expectedTotal, const RewardActorObservation& observed)
+		{
+			_dirty.erase(av);
+			_settled.insert_or_assign(av, Settled{ expectedTotal, observed });
+		}
+
+		[[nodiscard]] std::size_t DirtyCount() const noexcept { return _dirty.size(); }
+		[[nodiscard]] std::size_t SettledCount() const noexcept { return _settled.size(); }
+
+	private:
+		struct Settled
+		{
+			float                  expectedTotal{ 0.0f };
+			RewardActorObservation observed{};
+		};
+
+		std::unordered_set<ActorValue, Hash>          _dirty;
+		std::unordered_map<ActorValue, Settled, Hash> _settled;
+	};
 }
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG::Serialization::FormIdRemap
+{
+	// One slot per load-order byte, then one per light plugin (0xFE prefix, 12-bit index).
+	inline constexpr std::size_t   kRegularSlots = 0x100;
+	inline constexpr std::size_t   kLightSlots = 0x1000;
+	inline constexpr std::uint32_t kLightPrefix = 0xFEu;
+
+	[[nodiscard]] constexpr bool IsLight(std::uint32_t formId) noexcept
+	{
+		return (formId >> 24) == kLightPrefix;
+	}
+
+	[[nodiscard]] constexpr std::size_t SlotOf(std::uint32_t formId) noexcept
+	{
+		return IsLight(formId) ? kRegularSlots + ((formId >> 12) & 0xFFFu) : formId >> 24;
+	}
+
+	[[nodiscard]] constexpr std::uint32_t LocalMaskOf(std::uint32_t formId) noexcept
+	{
+		return IsLight(formId) ? 0x00000FFFu : 0x00FFFFFFu;
+	}
+
+	// Old plugin slot -> new FormID prefix and local mask for one co-save load. `resolve(oldId, newId)`
+	// (SKSE's ResolveFormID, which only remaps the plugin part) runs the first time a slot shows up,
+	// so a load makes one interface call per plugin instead of one per stored FormID. A plugin can be
+	// flagged light or regular between saves, so the local bits are masked by both the old and the
+	// new layout.
+	template <class Resolve>
+	class Translation
+	{
+	public:
+		explicit Translation(Resolve resolve) :
+			_resolve(std::move(resolve)),
+			_slots(kRegularSlots + kLightSlots)
+		{}
+
+		// Same contract as SerializationInterface::ResolveFormID.
+		[[nodiscard]] bool ResolveFormID(std::uint32_t oldId, std::uint32_t& newId)
+		{
+			const auto& slot = SlotFor(oldId);
+			if (slot.prefix == kDropped) {
+				++_dropped;
+				return false;
+			}
+			newId = Compose(slot, oldId);
+			return true;
+		}
+
+		// Remaps `ids` in place and drops those whose plugin is gone, moving `payload[i]` along with
+		// `ids[i]`. Kept entries end up at the front in their original order; returns their count.
+		template <class Payload>
+		[[nodiscard]] std::size_t RemapInPlace(std::span<std::uint32_t> ids, std::span<Payload> payload)
+		{
+			std::size_t kept = 0;
+			for (std::size_t i = 0; i < ids.size(); ++i) {
+				const auto  id = ids[i];
+				const auto& slot = SlotFor(id);
+				ids[kept] = Compose(slot, id);
+				payload[kept] = payload[i];
+				kept += slot.prefix != kDropped ? 1 : 0;
+			}
+			_dropped += ids.size() - kept;
+			return kept;
+		}
+
+		[[nodiscard]] std::size_t RemapInPlace(std::span<std::uint32_t> ids)
+		{
+			std::size_t kept = 0;
+			for (std::size_t i = 0; i < ids.size(); ++i) {
+				const auto  id = ids[i];
+				const auto& slot = SlotFor(id);
+				ids[kept] = Compose(slot, id);
+				kept += slot.prefix != kDropped ? 1 : 0;
+			}
+			_dropped += ids.size() - kept;
+			return kept;
+		}
+
+		[[nodiscard]] std::size_t ResolveCalls() const noexcept { return _resolveCalls; }
+		[[nodiscard]] std::size_t Dropped() const noexcept { return _dropped; }
+
+	private:
+		// Real prefixes have every local bit clear, so these never collide with one.
+		static constexpr std::uint32_t kPending = 1;
+		static constexpr std::uint32_t kDropped = 2;
+
+		struct Slot
+		{
+			std::uint32_t prefix{ kPending };
+			std::uint32_t localMask{ 0 };  // of the new plugin; 0 while pending or dropped
+		};
+
+		[[nodiscard]] static constexpr std::uint32_t Compose(const Slot& slot, std::uint32_t oldId) noexcept
+		{
+			return slot.prefix | (oldId & LocalMaskOf(oldId) & slot.localMask);
+		}
+
+		[[nodiscard]] const Slot& SlotFor(std::uint32_t formId)
+		{
+			auto& slot = _slots[SlotOf(formId)];
+			if (slot.prefix == kPending) {
+				std::uint32_t newId{};
+				++_resolveCalls;
+				if (_resolve(formId, newId)) {
+					slot.localMask = LocalMaskOf(newId);
+					slot.prefix = newId & ~slot.localMask;
+				} else {
+					slot.prefix = kDropped;
+				}
+			}
+			return slot;
+		}
+
+		Resolve           _resolve;
+		std::vector<Slot> _slots;
+		std::size_t                _resolveCalls{ 0 };
+		std::size_t                _dropped{ 0 };
+	};
+}
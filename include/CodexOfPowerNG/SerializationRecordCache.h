@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CodexOfPowerNG/SerializationRecordCodec.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace CodexOfPowerNG::Serialization
+{
+	// Co-save records, in the order Save writes them.
+	enum class SaveRecord : std::uint32_t
+	{
+		kRegistered,
+		kBlocked,
+		kNotified,
+		kBuildScores,
+		kBuildSlots,
+		kBuildMigration,
+		kBuildAppliedEffects,
+		kRewards,
+		kUndo,
+
+		kTotal
+	};
+
+	inline constexpr std::size_t kSaveRecordCount = static_cast<std::size_t>(SaveRecord::kTotal);
+
+	// Per-record change counters. Whoever mutates the data behind a record bumps its counter under
+	// the state mutex; the counters only ever grow, so an unchanged value means unchanged data.
+	class SaveRecordGenerations
+	{
+	public:
+		void Bump(SaveRecord record) noexcept { ++_values[static_cast<std::size_t>(record)]; }
+
+		void BumpAll() noexcept
+		{
+			for (auto& value : _values) {
+				++value;
+			}
+		}
+
+		[[nodiscard]] std::uint64_t Of(SaveRecord record) const noexcept { return _values[static_cast<std::size_t>(record)]; }
+
+	private:
+		std::array<std::uint64_t, kSaveRecordCount> _values{};
+	};
+
+	struct SaveStats
+	{
+		std::size_t encodedRecords{ 0 };
+		std::size_t reusedRecords{ 0 };
+		std::size_t encodedBytes{ 0 };
+		std::size_t reusedBytes{ 0 };
+	};
+
+	// Last encoded payload of every record and the generation it was encoded at. Not thread-safe;
+	// the save callback owns it.
+	class EncodedRecordCache
+	{
+	public:
+		// Returns the payload of `record` at `generation`, calling `encode(ByteWriter&)` only when
+		// the cached bytes are from another generation. If encode throws, the entry stays invalid.
+		template <class Encode>
+		[[nodiscard]] const RecordCodec::ByteWriter& Get(
+			SaveRecord    record,
+			std::uint64_t generation,
+			Encode&&      encode,
+			SaveStats&    stats)
+		{
+			auto& entry = _entries[static_cast<std::size_t>(record)];
+			if (entry.valid && entry.generation == generation) {
+				++stats.reusedRecords;
+				stats.reusedBytes += entry.bytes.size();
+				return entry.bytes;
+			}
+
+			entry.valid = false;
+			entry.bytes.Clear();
+			encode(entry.bytes);
+			entry.generation = generation;
+			entry.valid = true;
+			++stats.encodedRecords;
+			stats.encodedBytes += entry.bytes.size();
+			return entry.bytes;
+		}
+
+		void Invalidate() noexcept
+		{
+			for (auto& entry : _entries) {
+				entry.valid = false;
+			}
+		}
+
+	private:
+		struct Entry
+		{
+			RecordCodec::ByteWriter bytes;
+			std::uint64_t           generation{ 0 };
+			bool                    valid{ false };
+		};
+
+		std::array<Entry, kSaveRecordCount> _entries{};
+	};
+}
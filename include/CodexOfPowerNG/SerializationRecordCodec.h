@@ -0,0 +1,476 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG::Serialization::RecordCodec
+{
+	// REGI layouts:
+	//   v1: [count][FormID]...
+	//   v2: [count]([FormID][group u32])...
+	//   v3: [count][FormID x count][group u8 x count]
+	//   v4: [count] compact partitions, each entry varint((delta << 3) | group3)
+	// BLCK/NTFY layouts:
+	//   v1/v2: [count][FormID]...
+	//   v3: [count] compact partitions, each entry varint(delta)
+	//
+	// Compact partitions: FormIDs sorted ascending and grouped by plugin (the load-order byte, or
+	// the 0xFEXXX prefix for light plugins): [varint partitions] then per partition
+	// [varint prefix][varint entries][entries...], where delta is the local id minus the previous
+	// one in the partition (the first delta is the local id itself).
+	inline constexpr std::uint32_t kRegisteredRecordVersion = 4u;
+	inline constexpr std::uint32_t kFormIdListRecordVersion = 3u;
+
+	// Groups are 0..5 or kGroupUnknown (255); anything wider is stored as unknown.
+	inline constexpr std::uint32_t kPackedGroupUnknown = 0xFFu;
+	// Compact records keep 3 group bits: 0..6 as-is, 7 for unknown.
+	inline constexpr std::uint32_t kGroupBits = 3u;
+	inline constexpr std::uint32_t kCompactGroupUnknown = (1u << kGroupBits) - 1;
+
+	// Growable byte buffer (entries are copied in native byte order, as WriteRecordData does); Clear() keeps the capacity so one writer serves every save.
+	class ByteWriter
+	{
+	public:
+		void Clear() noexcept { _bytes.clear(); }
+		void Reserve(std::size_t bytes) { _bytes.reserve(bytes); }
+
+		template <class T>
+		void Put(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			std::memcpy(Grow(sizeof(T)), &value, sizeof(T));
+		}
+
+		// Unsigned LEB128: 7 bits per byte, high bit set on all but the last.
+		void PutVarint(std::uint32_t value)
+		{
+			std::byte encoded[5];
+			std::size_t length = 0;
+			while (value >= 0x80u) {
+				encoded[length++] = static_cast<std::byte>((value & 0x7Fu) | 0x80u);
+				value >>= 7;
+			}
+			encoded[length++] = static_cast<std::byte>(value);
+			std::memcpy(Grow(length), encoded, length);
+		}
+
+		// Appends `bytes` uninitialised bytes and returns where they start.
+		[[nodiscard]] std::byte* Grow(std::size_t bytes)
+		{
+			const auto offset = _bytes.size();
+			_bytes.resize(offset + bytes);
+			return _bytes.data() + offset;
+		}
+
+		[[nodiscard]] const std::byte* data() const noexcept { return _bytes.data(); }
+		[[nodiscard]] std::size_t      size() const noexcept { return _bytes.size(); }
+
+	private:
+		std::vector<std::byte> _bytes;
+	};
+
+	class ByteReader
+	{
+	public:
+		explicit ByteReader(std::span<const std::byte> bytes) noexcept :
+			_bytes(bytes)
+		{}
+
+		template <class T>
+		[[nodiscard]] bool Get(T& out) noexcept
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			if (_bytes.size() < sizeof(T)) {
+				return false;
+			}
+			std::memcpy(&out, _bytes.data(), sizeof(T));
+			_bytes = _bytes.subspan(sizeof(T));
+			return true;
+		}
+
+		// False on a truncated or over-long (more than 32 bits) encoding.
+		[[nodiscard]] bool GetVarint(std::uint32_t& out) noexcept
+		{
+			std::uint32_t value = 0;
+			for (std::size_t i = 0; i < 5 && i < _bytes.size(); ++i) {
+				const auto byte = static_cast<std::uint32_t>(_bytes[i]);
+				if (i == 4 && byte > 0x0Fu) {
+					return false;
+				}
+				value |= (byte & 0x7Fu) << (7 * i);
+				if ((byte & 0x80u) == 0) {
+					_bytes = _bytes.subspan(i + 1);
+					out = value;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// Takes the next `bytes` bytes as a sub-span; empty when fewer remain.
+		[[nodiscard]] std::span<const std::byte> Take(std::size_t bytes) noexcept
+		{
+			if (_bytes.size() < bytes) {
+				return {};
+			}
+			const auto taken = _bytes.first(bytes);
+			_bytes = _bytes.subspan(bytes);
+			return taken;
+		}
+
+		[[nodiscard]] std::size_t Remaining() const noexcept { return _bytes.size(); }
+
+	private:
+		std::span<const std::byte> _bytes;
+	};
+
+	enum class DecodeStatus : std::uint8_t
+	{
+		kOk,
+		kTruncatedHeader,
+		kUnsupportedVersion,
+		kMalformed,  // compact entries that do not form a valid FormID; decoding stops there
+	};
+
+	struct DecodeResult
+	{
+		DecodeStatus  status{ DecodeStatus::kOk };
+		std::uint32_t declared{ 0 };  // count in the record header
+		std::uint32_t decoded{ 0 };   // entries that fit in the record
+	};
+
+	namespace Detail
+	{
+		inline constexpr std::uint32_t kLightPrefix = 0xFEu;
+
+		// Light-plugin forms share the 0xFE byte; their plugin is the next 12 bits.
+		[[nodiscard]] constexpr std::uint32_t PartitionOf(std::uint32_t formId) noexcept
+		{
+			return (formId >> 24) == kLightPrefix ? formId >> 12 : formId >> 24;
+		}
+
+		[[nodiscard]] constexpr std::uint32_t LocalBitsOf(std::uint32_t partition) noexcept
+		{
+			return partition > 0xFFu ? 12u : 24u;
+		}
+
+		[[nodiscard]] constexpr std::uint32_t PackGroup(std::uint32_t group) noexcept
+		{
+			return group < kCompactGroupUnknown ? group : kCompactGroupUnknown;
+		}
+
+		[[nodiscard]] constexpr std::uint32_t UnpackGroup(std::uint32_t packed, std::uint32_t unknownGroup) noexcept
+		{
+			return packed == kCompactGroupUnknown ? unknownGroup : packed;
+		}
+
+		// Entries are packed as (FormID << 32) | payload so one 64-bit key carries both.
+		[[nodiscard]] constexpr std::uint64_t PackEntry(std::uint32_t formId, std::uint32_t payload) noexcept
+		{
+			return (static_cast<std::uint64_t>(formId) << 32) | payload;
+		}
+
+		[[nodiscard]] constexpr std::uint32_t FormIdOf(std::uint64_t entry) noexcept
+		{
+			return static_cast<std::uint32_t>(entry >> 32);
+		}
+
+		[[nodiscard]] constexpr std::uint32_t PayloadOf(std::uint64_t entry) noexcept
+		{
+			return static_cast<std::uint32_t>(entry);
+		}
+
+		// LSD radix sort on the FormID half, one byte per pass; a save sorts tens of thousands of
+		// entries, where this is several times quicker than std::sort.
+		inline void SortByFormId(std::vector<std::uint64_t>& entries)
+		{
+			if (entries.size() < 2) {
+				return;
+			}
+			std::vector<std::uint64_t> scratch(entries.size());
+			for (std::uint32_t shift = 32; shift < 64; shift += 8) {
+				std::size_t offsets[257]{};
+				for (const auto entry : entries) {
+					++offsets[((entry >> shift) & 0xFFu) + 1];
+				}
+				if (offsets[((entries.front() >> shift) & 0xFFu) + 1] == entries.size()) {
+					continue;  // every entry shares this byte
+				}
+				for (std::size_t i = 1; i < 257; ++i) {
+					offsets[i] += offsets[i - 1];
+				}
+				for (const auto entry : entries) {
+					scratch[offsets[(entry >> shift) & 0xFFu]++] = entry;
+				}
+				entries.swap(scratch);
+			}
+		}
+
+		// `sorted` holds packed entries ascending by FormID without duplicates; `payloadBits` low
+		// bits of every encoded delta carry the payload.
+		inline void EncodeCompact(
+			ByteWriter&                    writer,
+			std::span<const std::uint64_t> sorted,
+			std::uint32_t                  payloadBits)
+		{
+			writer.Put(static_cast<std::uint32_t>(sorted.size()));
+
+			std::uint32_t partitions = 0;
+			for (std::size_t i = 0; i < sorted.size(); ++i) {
+				if (i == 0 || PartitionOf(FormIdOf(sorted[i])) != PartitionOf(FormIdOf(sorted[i - 1]))) {
+					++partitions;
+				}
+			}
+			writer.PutVarint(partitions);
+
+			for (std::size_t begin = 0; begin < sorted.size();) {
+				const auto partition = PartitionOf(FormIdOf(sorted[begin]));
+				auto       end = begin + 1;
+				while (end < sorted.size() && PartitionOf(FormIdOf(sorted[end])) == partition) {
+					++end;
+				}
+
+				const auto localMask = (1u << LocalBitsOf(partition)) - 1;
+				writer.PutVarint(partition);
+				writer.PutVarint(static_cast<std::uint32_t>(end - begin));
+				std::uint32_t previous = 0;
+				for (auto i = begin; i < end; ++i) {
+					const auto local = FormIdOf(sorted[i]) & localMask;
+					writer.PutVarint(((local - previous) << payloadBits) | PayloadOf(sorted[i]));
+					previous = local;
+				}
+				begin = end;
+			}
+		}
+
+		// Calls `sink(formId, payload)` per entry. Stops with kMalformed on ids that overflow their
+		// partition or a second entry for the same id; a cut-off record just ends early.
+		template <class Sink>
+		[[nodiscard]] DecodeResult DecodeCompact(ByteReader& reader, std::uint32_t payloadBits, Sink&& sink)
+		{
+			DecodeResult result{};
+			if (!reader.Get(result.declared)) {
+				result.status = DecodeStatus::kTruncatedHeader;
+				return result;
+			}
+
+			std::uint32_t partitions{};
+			if (!reader.GetVarint(partitions)) {
+				return result;
+			}
+			const auto payloadMask = (1u << payloadBits) - 1;
+			std::uint32_t lastBase = 0;
+			for (std::uint32_t p = 0; p < partitions; ++p) {
+				std::uint32_t partition{};
+				std::uint32_t entries{};
+				if (!reader.GetVarint(partition) || !reader.GetVarint(entries)) {
+					return result;
+				}
+				if (partition == kLightPrefix || partition > 0xFFFFFu || (partition > 0xFFu && (partition >> 12) != kLightPrefix)) {
+					result.status = DecodeStatus::kMalformed;
+					return result;
+				}
+				// Partitions follow FormID order, so their first ids must strictly increase.
+				const auto localBits = LocalBitsOf(partition);
+				const auto base = partition << localBits;
+				if (p > 0 && base <= lastBase) {
+					result.status = DecodeStatus::kMalformed;
+					return result;
+				}
+				lastBase = base;
+
+				std::uint64_t local = 0;
+				for (std::uint32_t i = 0; i < entries; ++i) {
+					std::uint32_t value{};
+					if (!reader.GetVarint(value)) {
+						return result;
+					}
+					const auto delta = value >> payloadBits;
+					local += delta;
+					if ((i > 0 && delta == 0) || local >= (std::uint64_t{ 1 } << localBits) || result.decoded == result.declared) {
+						result.status = DecodeStatus::kMalformed;
+						return result;
+					}
+					sink(base | static_cast<std::uint32_t>(local), value & payloadMask);
+					++result.decoded;
+				}
+			}
+			return result;
+		}
+	}
+
+	// REGI v3. `entries` iterates (FormID, group) pairs.
+	template <class Entries>
+	void EncodeRegisteredColumns(ByteWriter& writer, const Entries& entries)
+	{
+		const auto count = static_cast<std::uint32_t>(entries.size());
+		writer.Reserve(writer.size() + sizeof(count) + std::size_t{ count } * (sizeof(std::uint32_t) + 1));
+		writer.Put(count);
+
+		auto* ids = writer.Grow(std::size_t{ count } * (sizeof(std::uint32_t) + 1));
+		auto* groups = ids + std::size_t{ count } * sizeof(std::uint32_t);
+		for (const auto& [formId, group] : entries) {
+			const auto id = static_cast<std::uint32_t>(formId);
+			std::memcpy(ids, &id, sizeof(id));
+			ids += sizeof(id);
+			*groups++ = static_cast<std::byte>((std::min)(static_cast<std::uint32_t>(group), kPackedGroupUnknown));
+		}
+	}
+
+	// BLCK/NTFY v2. `formIds` iterates FormIDs.
+	template <class FormIds>
+	void EncodeFormIdsRaw(ByteWriter& writer, const FormIds& formIds)
+	{
+		const auto count = static_cast<std::uint32_t>(formIds.size());
+		writer.Reserve(writer.size() + sizeof(count) + std::size_t{ count } * sizeof(std::uint32_t));
+		writer.Put(count);
+
+		auto* ids = writer.Grow(std::size_t{ count } * sizeof(std::uint32_t));
+		for (const auto formId : formIds) {
+			const auto id = static_cast<std::uint32_t>(formId);
+			std::memcpy(ids, &id, sizeof(id));
+			ids += sizeof(id);
+		}
+	}
+
+	// REGI v4. `entries` iterates (FormID, group) pairs with unique FormIDs.
+	template <class Entries>
+	void EncodeRegistered(ByteWriter& writer, const Entries& entries)
+	{
+		std::vector<std::uint64_t> sorted;
+		sorted.reserve(entries.size());
+		for (const auto& [formId, group] : entries) {
+			sorted.push_back(Detail::PackEntry(static_cast<std::uint32_t>(formId), Detail::PackGroup(static_cast<std::uint32_t>(group))));
+		}
+		Detail::SortByFormId(sorted);
+		writer.Reserve(writer.size() + 16 + sorted.size() * 3);
+		Detail::EncodeCompact(writer, sorted, kGroupBits);
+	}
+
+	// BLCK/NTFY v3. `formIds` iterates unique FormIDs.
+	template <class FormIds>
+	void EncodeFormIds(ByteWriter& writer, const FormIds& formIds)
+	{
+		std::vector<std::uint64_t> sorted;
+		sorted.reserve(formIds.size());
+		for (const auto formId : formIds) {
+			sorted.push_back(Detail::PackEntry(static_cast<std::uint32_t>(formId), 0u));
+		}
+		Detail::SortByFormId(sorted);
+		writer.Reserve(writer.size() + 16 + sorted.size() * 3);
+		Detail::EncodeCompact(writer, sorted, 0u);
+	}
+
+	// Upper bound on the entries a REGI/BLCK/NTFY record can hold, for reserving before decoding.
+	[[nodiscard]] inline std::uint32_t CountHint(std::span<const std::byte> bytes) noexcept
+	{
+		std::uint32_t declared{};
+		ByteReader    reader(bytes);
+		if (!reader.Get(declared)) {
+			return 0;
+		}
+		// Every layout spends at least one byte per entry.
+		return (std::min)(declared, static_cast<std::uint32_t>((std::min)(reader.Remaining(), std::size_t{ UINT32_MAX })));
+	}
+
+	// Calls `sink(formId, group)` for every entry that fits; counts larger than the record are
+	// clamped the way the per-field readers always did. v1 entries get `unknownGroup`.
+	template <class Sink>
+	[[nodiscard]] DecodeResult DecodeRegistered(
+		std::span<const std::byte> bytes,
+		std::uint32_t              version,
+		std::uint32_t              unknownGroup,
+		Sink&&                     sink)
+	{
+		DecodeResult result{};
+		ByteReader   reader(bytes);
+		if (!reader.Get(result.declared)) {
+			result.status = DecodeStatus::kTruncatedHeader;
+			return result;
+		}
+
+		switch (version) {
+		case 1u: {
+			result.decoded = (std::min)(result.declared, static_cast<std::uint32_t>(reader.Remaining() / sizeof(std::uint32_t)));
+			for (std::uint32_t i = 0; i < result.decoded; ++i) {
+				std::uint32_t formId{};
+				(void)reader.Get(formId);
+				sink(formId, unknownGroup);
+			}
+			return result;
+		}
+		case 2u: {
+			constexpr std::size_t kEntrySize = sizeof(std::uint32_t) * 2;
+			result.decoded = (std::min)(result.declared, static_cast<std::uint32_t>(reader.Remaining() / kEntrySize));
+			for (std::uint32_t i = 0; i < result.decoded; ++i) {
+				std::uint32_t formId{};
+				std::uint32_t group{};
+				(void)reader.Get(formId);
+				(void)reader.Get(group);
+				sink(formId, group);
+			}
+			return result;
+		}
+		case 3u: {
+			// The group column starts after the declared number of ids, so a cut-off record has
+			// no addressable entries at all.
+			constexpr std::size_t kEntrySize = sizeof(std::uint32_t) + 1;
+			if (reader.Remaining() / kEntrySize < result.declared) {
+				return result;
+			}
+			const auto ids = reader.Take(std::size_t{ result.declared } * sizeof(std::uint32_t));
+			const auto groups = reader.Take(result.declared);
+			result.decoded = result.declared;
+			for (std::uint32_t i = 0; i < result.decoded; ++i) {
+				std::uint32_t formId{};
+				std::memcpy(&formId, ids.data() + std::size_t{ i } * sizeof(formId), sizeof(formId));
+				sink(formId, static_cast<std::uint32_t>(groups[i]));
+			}
+			return result;
+		}
+		case 4u: {
+			ByteReader compact(bytes);
+			return Detail::DecodeCompact(compact, kGroupBits, [&](std::uint32_t formId, std::uint32_t packed) {
+				sink(formId, Detail::UnpackGroup(packed, unknownGroup));
+			});
+		}
+		default:
+			result.status = DecodeStatus::kUnsupportedVersion;
+			return result;
+		}
+	}
+
+	// Calls `sink(formId)` for every FormID that fits in a BLCK/NTFY record.
+	template <class Sink>
+	[[nodiscard]] DecodeResult DecodeFormIds(std::span<const std::byte> bytes, std::uint32_t version, Sink&& sink)
+	{
+		ByteReader reader(bytes);
+		if (version == kFormIdListRecordVersion) {
+			return Detail::DecodeCompact(reader, 0u, [&](std::uint32_t formId, std::uint32_t) { sink(formId); });
+		}
+
+		DecodeResult result{};
+		if (!reader.Get(result.declared)) {
+			result.status = DecodeStatus::kTruncatedHeader;
+			return result;
+		}
+		if (version > 2u) {
+			result.status = DecodeStatus::kUnsupportedVersion;
+			return result;
+		}
+
+		result.decoded = (std::min)(result.declared, static_cast<std::uint32_t>(reader.Remaining() / sizeof(std::uint32_t)));
+		for (std::uint32_t i = 0; i < result.decoded; ++i) {
+			std::uint32_t formId{};
+			(void)reader.Get(formId);
+			sink(formId);
+		}
+		return result;
+	}
+}
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "CodexOfPowerNG/BuildTypes.h"
+#include "CodexOfPowerNG/CopyOnWrite.h"
+#include "CodexOfPowerNG/FlatFormIdMap.h"
 #include "CodexOfPowerNG/RegistrationUndoTypes.h"
+#include "CodexOfPowerNG/SerializationRecordCache.h"
 #include "CodexOfPowerNG/State.h"
 
 #include <RE/Skyrim.h>
@@ -10,18 +13,18 @@
 #include <cstdint>
 #include <deque>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
 
 namespace CodexOfPowerNG::SerializationStateStore
 {
+	// Copies of the containers share storage with RuntimeState until either side writes, so taking
+	// a snapshot does not copy any collection; the AV totals are small fixed-size tables copied flat.
 	struct Snapshot
 	{
-		std::unordered_map<RE::FormID, std::uint32_t>             registeredItems;
-		std::unordered_set<RE::FormID>                            blockedItems;
-		std::unordered_set<RE::FormID>                            notifiedItems;
-		std::unordered_map<RE::ActorValue, float, ActorValueHash> rewardTotals;
-		std::unordered_map<RE::ActorValue, float, ActorValueHash> buildAppliedEffectTotals;
+		Containers::FlatFormIdMap<std::uint32_t>                  registeredItems;
+		Containers::FlatFormIdSet                                 blockedItems;
+		Containers::FlatFormIdSet                                 notifiedItems;
+		ActorValueTotals                                          rewardTotals;
+		ActorValueTotals                                          buildAppliedEffectTotals;
 		std::uint32_t                                             attackScore{ 0 };
 		std::uint32_t                                             defenseScore{ 0 };
 		std::uint32_t                                             utilityScore{ 0 };
@@ -32,8 +35,10 @@ namespace CodexOfPowerNG::SerializationStateStore
 		std::uint32_t                                             buildMigrationVersion{ 0 };
 		Builds::BuildMigrationState                               buildMigrationState{ Builds::BuildMigrationState::kNotStarted };
 		Builds::BuildMigrationNoticeSnapshot                      buildMigrationNotice{};
-		std::deque<Registration::UndoRecord>                      undoHistory;
+		Containers::CopyOnWrite<std::deque<Registration::UndoRecord>> undoHistory;
 		std::uint64_t                                             undoNextActionId{ 1 };
+		// Filled by SnapshotState only; ReplaceState marks every record changed.
+		Serialization::SaveRecordGenerations                      saveGenerations{};
 	};
 
 	[[nodiscard]] Snapshot SnapshotState() noexcept;
@@ -69,7 +69,7 @@ namespace CodexOfPowerNG::SerializationStateStore::Ops
 		state.buildMigrationVersion = 0;
 		state.buildMigrationState = decltype(state.buildMigrationState)::kNotStarted;
 		state.buildMigrationNotice = {};
-		state.undoHistory.clear();
+		state.undoHistory = {};
 		state.undoNextActionId = resetUndoNextActionId;
 	}
 }
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG
+{
+	enum class StageStatus : std::uint8_t
+	{
+		kDone,
+		kYield,  // more work; run again while the slice budget lasts
+		kWait,   // blocked on something outside the pipeline; retry next slice
+	};
+
+	using StageFn = std::function<StageStatus(std::chrono::microseconds sliceBudget)>;
+
+	enum class PipelineStep : std::uint8_t
+	{
+		kFinished,
+		kYield,
+		kWait,
+	};
+
+	struct StageTiming
+	{
+		std::string   name;
+		std::uint64_t runUs{ 0 };       // time spent inside the stage's own slices
+		std::uint32_t slices{ 0 };
+		std::uint64_t finishedAtUs{ 0 };  // since the pipeline's first slice
+		bool          done{ false };
+	};
+
+	// Named stages with "runs after" dependencies, run in a stable topological order in
+	// budget-bounded slices. A stage that waits stalls the ones behind it in that order.
+	template <class Clock = std::chrono::steady_clock>
+	class StagePipeline
+	{
+	public:
+		// False for a duplicate name or once sealed.
+		[[nodiscard]] bool Add(std::string name, std::vector<std::string> after, StageFn run)
+		{
+			if (_sealed || !run || Find(name) != kNone) {
+				return false;
+			}
+			_stages.push_back(Stage{ std::move(after), std::move(run) });
+			_timings.push_back(StageTiming{ std::move(name) });
+			return true;
+		}
+
+		// Orders stages after their dependencies, keeping insertion order where free to.
+		// False (and nothing runs) for an unknown dependency or a cycle.
+		[[nodiscard]] bool Seal()
+		{
+			if (_sealed) {
+				return Ordered();
+			}
+			_sealed = true;
+
+			std::vector<std::vector<std::size_t>> dependents(_stages.size());
+			std::vector<std::size_t>              pending(_stages.size(), 0);
+			for (std::size_t i = 0; i < _stages.size(); ++i) {
+				for (const auto& dependency : _stages[i].after) {
+					const auto index = Find(dependency);
+					if (index == kNone) {
+						return false;
+					}
+					dependents[index].push_back(i);
+					++pending[i];
+				}
+			}
+
+			std::vector<bool> placed(_stages.size(), false);
+			_order.reserve(_stages.size());
+			while (_order.size() < _stages.size()) {
+				std::size_t next = kNone;
+				for (std::size_t i = 0; i < _stages.size(); ++i) {
+					if (!placed[i] && pending[i] == 0) {
+						next = i;
+						break;
+					}
+				}
+				if (next == kNone) {
+					_order.clear();
+					return false;
+				}
+				placed[next] = true;
+				_order.push_back(next);
+				for (const auto dependent : dependents[next]) {
+					--pending[dependent];
+				}
+			}
+			return true;
+		}
+
+		// Runs stages until one waits or `budget` is used up; the first slice of a call always runs.
+		[[nodiscard]] PipelineStep Run(std::chrono::microseconds budget)
+		{
+			if (!Ordered()) {
+				return PipelineStep::kFinished;
+			}
+
+			const auto callStart = Clock::now();
+			if (!_started) {
+				_started = true;
+				_startedAt = callStart;
+			}
+
+			bool ranSlice = false;
+			while (_next < _order.size()) {
+				const auto sliceStart = Clock::now();
+				const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(sliceStart - callStart);
+				if (ranSlice && elapsed >= budget) {
+					return PipelineStep::kYield;
+				}
+
+				const auto index = _order[_next];
+				const auto remaining = (std::max)(budget - elapsed, std::chrono::microseconds::zero());
+				const auto status = _stages[index].run(remaining);
+				const auto sliceEnd = Clock::now();
+				ranSlice = true;
+
+				auto& timing = _timings[index];
+				timing.runUs += ToUs(sliceEnd - sliceStart);
+				++timing.slices;
+				if (status == StageStatus::kWait) {
+					return PipelineStep::kWait;
+				}
+				if (status == StageStatus::kDone) {
+					timing.done = true;
+					timing.finishedAtUs = ToUs(sliceEnd - _startedAt);
+					++_next;
+				}
+			}
+			return PipelineStep::kFinished;
+		}
+
+		[[nodiscard]] bool Finished() const noexcept { return Ordered() && _next == _order.size(); }
+
+		// The stage whose turn it is, or empty once finished.
+		[[nodiscard]] std::string_view CurrentStage() const noexcept
+		{
+			return _next < _order.size() ? std::string_view(_timings[_order[_next]].name) : std::string_view{};
+		}
+
+		// In the order stages were added.
+		[[nodiscard]] std::span<const StageTiming> Timings() const noexcept { return _timings; }
+
+	private:
+		static constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+
+		struct Stage
+		{
+			std::vector<std::string> after;
+			StageFn                  run;
+		};
+
+		[[nodiscard]] static std::uint64_t ToUs(typename Clock::duration duration) noexcept
+		{
+			const auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+			return us > 0 ? static_cast<std::uint64_t>(us) : 0u;
+		}
+
+		[[nodiscard]] bool Ordered() const noexcept { return _sealed && _order.size() == _stages.size(); }
+
+		[[nodiscard]] std::size_t Find(std::string_view name) const noexcept
+		{
+			for (std::size_t i = 0; i < _timings.size(); ++i) {
+				if (_timings[i].name == name) {
+					return i;
+				}
+			}
+			return kNone;
+		}
+
+		std::vector<Stage>         _stages;
+		std::vector<StageTiming>   _timings;
+		std::vector<std::size_t>   _order;
+		std::size_t                _next{ 0 };
+		typename Clock::time_point _startedAt{};
+		bool                       _started{ false };
+		bool                       _sealed{ false };
+	};
+}
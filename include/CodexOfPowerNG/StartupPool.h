@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG::Startup
+{
+	struct StageTiming
+	{
+		std::string               name{};
+		std::chrono::microseconds waited{ 0 };  // queued -> started
+		std::chrono::microseconds ran{ 0 };
+	};
+
+	// Small FIFO thread pool for startup file I/O and JSON decode. A stage may wait on a stage that
+	// was submitted before it (FIFO guarantees that one has started), never on a later one.
+	// Submit() and Join() are called from the owning thread only.
+	class WorkerPool
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		explicit WorkerPool(std::size_t threadCount)
+		{
+			_threads.reserve(threadCount);
+			for (std::size_t i = 0; i < threadCount; ++i) {
+				try {
+					_threads.emplace_back([this]() { WorkerLoop(); });
+				} catch (const std::exception&) {
+					break;  // fewer workers; with none, Submit() runs stages inline
+				}
+			}
+		}
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		~WorkerPool() { Join(); }
+
+		// Finishes every queued stage and stops the workers; later Submit() calls run inline.
+		// Timings() is complete afterwards.
+		void Join()
+		{
+			{
+				std::scoped_lock lock(_mutex);
+				_stopping = true;
+			}
+			_wake.notify_all();
+			for (auto& thread : _threads) {
+				thread.join();
+			}
+			_threads.clear();
+		}
+
+		// Leaves one core to the game's own loading thread; startup has only a handful of stages.
+		[[nodiscard]] static std::size_t DefaultThreadCount() noexcept
+		{
+			const auto cores = static_cast<std::size_t>(std::thread::hardware_concurrency());
+			return std::clamp<std::size_t>(cores > 1 ? cores - 1 : 1, 1, 3);
+		}
+
+		[[nodiscard]] std::size_t ThreadCount() const noexcept { return _threads.size(); }
+
+		// Exceptions thrown by `fn` surface from the future's get().
+		template <class Fn>
+		[[nodiscard]] std::shared_future<std::invoke_result_t<Fn&>> Submit(std::string name, Fn fn)
+		{
+			using Result = std::invoke_result_t<Fn&>;
+			auto task = std::make_shared<std::packaged_task<Result()>>(std::move(fn));
+			auto future = task->get_future().share();
+			Job  job{ std::move(name), Clock::now(), [task]() { (*task)(); } };
+
+			if (_threads.empty()) {
+				Run(job);
+				return future;
+			}
+			{
+				std::scoped_lock lock(_mutex);
+				_jobs.push_back(std::move(job));
+			}
+			_wake.notify_one();
+			return future;
+		}
+
+		[[nodiscard]] std::vector<StageTiming> Timings() const
+		{
+			std::scoped_lock lock(_mutex);
+			return _timings;
+		}
+
+	private:
+		struct Job
+		{
+			std::string           name;
+			Clock::time_point     queuedAt;
+			std::function<void()> run;
+		};
+
+		void Run(Job& job)
+		{
+			const auto startedAt = Clock::now();
+			job.run();
+			const auto finishedAt = Clock::now();
+
+			std::scoped_lock lock(_mutex);
+			_timings.push_back(StageTiming{
+				std::move(job.name),
+				std::chrono::duration_cast<std::chrono::microseconds>(startedAt - job.queuedAt),
+				std::chrono::duration_cast<std::chrono::microseconds>(finishedAt - startedAt) });
+		}
+
+		void WorkerLoop()
+		{
+			for (;;) {
+				Job job;
+				{
+					std::unique_lock lock(_mutex);
+					_wake.wait(lock, [this]() { return _stopping || !_jobs.empty(); });
+					if (_jobs.empty()) {
+						return;
+					}
+					job = std::move(_jobs.front());
+					_jobs.pop_front();
+				}
+				Run(job);
+			}
+		}
+
+		mutable std::mutex       _mutex;
+		std::condition_variable  _wake;
+		std::deque<Job>          _jobs;
+		std::vector<StageTiming> _timings;
+		std::vector<std::thread> _threads;
+		bool                     _stopping{ false };
+	};
+
+	// Readiness of a background load. Consumers call Wait() before reading the loaded data; an
+	// unarmed gate (synchronous load, or tests) never blocks. Once ready, Wait() is one atomic load.
+	class LoadGate
+	{
+	public:
+		void Arm(std::shared_future<void> ready)
+		{
+			std::scoped_lock lock(_mutex);
+			_future = std::move(ready);
+			_ready.store(!_future.valid(), std::memory_order_release);
+		}
+
+		void Wait() const noexcept
+		{
+			if (_ready.load(std::memory_order_acquire)) {
+				return;
+			}
+			std::shared_future<void> future;
+			{
+				std::scoped_lock lock(_mutex);
+				future = _future;
+			}
+			if (future.valid()) {
+				future.wait();
+			}
+			_ready.store(true, std::memory_order_release);
+		}
+
+		[[nodiscard]] bool IsReady() const noexcept
+		{
+			if (_ready.load(std::memory_order_acquire)) {
+				return true;
+			}
+			std::scoped_lock lock(_mutex);
+			return !_future.valid() ||
+			       _future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}
+
+	private:
+		mutable std::mutex        _mutex;
+		std::shared_future<void>  _future{};
+		mutable std::atomic_bool  _ready{ true };
+	};
+}
@@ -1,17 +1,21 @@
 #pragma once
 
 #include "CodexOfPowerNG/BuildTypes.h"
+#include "CodexOfPowerNG/CopyOnWrite.h"
+#include "CodexOfPowerNG/DenseEnumMap.h"
+#include "CodexOfPowerNG/FlatFormIdMap.h"
 #include "CodexOfPowerNG/RegistrationUndoTypes.h"
+#include "CodexOfPowerNG/SerializationRecordCache.h"
 
 #include <RE/Skyrim.h>
 
 #include <array>
+#include <cstddef>
 #include <deque>
+#include <functional>
 #include <mutex>
 #include <string>
 #include <type_traits>
-#include <unordered_map>
-#include <unordered_set>
 
 namespace CodexOfPowerNG
 {
@@ -24,15 +28,22 @@ namespace CodexOfPowerNG
 		}
 	};
 
+	inline constexpr std::size_t kActorValueCount = static_cast<std::size_t>(RE::ActorValue::kTotal);
+
+	// Per-AV totals (rewards, applied build effects), indexed directly by the AV.
+	using ActorValueTotals = Containers::DenseEnumMap<RE::ActorValue, kActorValueCount>;
+
+	static_assert(std::is_same_v<RE::FormID, std::uint32_t>, "flat form id containers assume 32-bit form ids");
+
 	struct RuntimeState
 	{
 		std::mutex mutex;
 		// regKey(FormID) -> discovery group (0..5). Values may be 255 for "unknown" when loaded from older data.
-		std::unordered_map<RE::FormID, std::uint32_t> registeredItems;
-		std::unordered_set<RE::FormID> blockedItems;
-		std::unordered_set<RE::FormID> notifiedItems;
-		std::unordered_map<RE::ActorValue, float, ActorValueHash> rewardTotals;
-		std::unordered_map<RE::ActorValue, float, ActorValueHash> buildAppliedEffectTotals;
+		Containers::FlatFormIdMap<std::uint32_t> registeredItems;
+		Containers::FlatFormIdSet                blockedItems;
+		Containers::FlatFormIdSet                notifiedItems;
+		ActorValueTotals                         rewardTotals;
+		ActorValueTotals                         buildAppliedEffectTotals;
 		std::uint32_t                                        attackScore{ 0 };
 		std::uint32_t                                        defenseScore{ 0 };
 		std::uint32_t                                        utilityScore{ 0 };
@@ -43,8 +54,10 @@ namespace CodexOfPowerNG
 		std::uint32_t                                        buildMigrationVersion{ 0 };
 		Builds::BuildMigrationState                          buildMigrationState{ Builds::BuildMigrationState::kNotStarted };
 		Builds::BuildMigrationNoticeSnapshot                 buildMigrationNotice{};
-		std::deque<Registration::UndoRecord> undoHistory;
-		std::uint64_t                        undoNextActionId{ 1 };
+		Containers::CopyOnWrite<std::deque<Registration::UndoRecord>> undoHistory;
+		std::uint64_t                                                 undoNextActionId{ 1 };
+		// Bumped by the state stores on every change to a co-save record's data.
+		Serialization::SaveRecordGenerations                          saveGenerations{};
 	};
 
 	[[nodiscard]] RuntimeState& GetState() noexcept;
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <string_view>
 
 namespace CodexOfPowerNG
 {
@@ -20,6 +25,59 @@ namespace CodexOfPowerNG
 	// Test-only hook to replace scheduler behavior.
 	void SetTaskSchedulerForTesting(ITaskScheduler* scheduler) noexcept;
 
+	// Main-thread work runs through a frame-budgeted queue: higher priorities first, FIFO within
+	// a priority, and at most one frame budget of work per game frame (at least one task always runs).
+	enum class TaskPriority : std::uint8_t
+	{
+		kHigh,
+		kNormal,
+		kBackground,
+	};
+
+	inline constexpr std::size_t kTaskPriorityCount = static_cast<std::size_t>(TaskPriority::kBackground) + 1;
+	inline constexpr std::chrono::microseconds kMainTaskFrameBudget{ 4000 };
+
+	enum class TaskStep : std::uint8_t
+	{
+		kDone,
+		kYield,
+	};
+
+	// Runs one chunk within `sliceBudget` and returns kYield to be resumed later (possibly next frame).
+	using ResumableTask = std::function<TaskStep(std::chrono::microseconds sliceBudget)>;
+
+	struct MainTaskStats
+	{
+		std::array<std::size_t, kTaskPriorityCount> queueDepth{};
+		std::size_t   maxQueueDepth{ 0 };
+		std::uint64_t enqueued{ 0 };
+		std::uint64_t coalesced{ 0 };
+		std::uint64_t slicesRun{ 0 };
+		std::uint64_t failedTasks{ 0 };
+		std::uint64_t frames{ 0 };
+		std::uint64_t framesOverBudget{ 0 };
+		std::uint64_t lastFrameUs{ 0 };
+		std::uint64_t maxFrameUs{ 0 };
+		std::uint64_t startedTasks{ 0 };
+		std::uint64_t totalLatencyUs{ 0 };
+		std::uint64_t maxLatencyUs{ 0 };
+	};
+
 	[[nodiscard]] bool QueueMainTask(ScheduledTask task) noexcept;
+	[[nodiscard]] bool QueueMainTask(TaskPriority priority, ScheduledTask task) noexcept;
+	// While a task with `key` is still waiting, later ones replace its body instead of queueing again.
+	[[nodiscard]] bool QueueCoalescedMainTask(
+		std::string_view key,
+		ScheduledTask    task,
+		TaskPriority     priority = TaskPriority::kNormal) noexcept;
+	[[nodiscard]] bool QueueResumableMainTask(
+		ResumableTask task,
+		TaskPriority  priority = TaskPriority::kBackground) noexcept;
 	[[nodiscard]] bool QueueUITask(ScheduledTask task) noexcept;
+
+	[[nodiscard]] MainTaskStats SnapshotMainTaskStats() noexcept;
+	// Called once per game frame on the main thread (FrameHook); opens the next frame's budget.
+	void TickMainTaskFrame() noexcept;
+	// Number of game frames seen so far; moves once per Tick (once per pump until the frame hook ticks).
+	[[nodiscard]] std::uint64_t CurrentMainTaskFrame() noexcept;
 }
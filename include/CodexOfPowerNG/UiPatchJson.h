@@ -0,0 +1,147 @@
+#pragma once
+
+#include "CodexOfPowerNG/UiPatchOps.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// JSON document diff behind copng_applyPatch; PrismaUI/views/codexofpowerng/ui_patch.js applies it.
+namespace CodexOfPowerNG::UiPatch
+{
+	using Json = nlohmann::json;
+
+	// Fields tried, in order, as the identity of rows in an array of objects.
+	inline constexpr std::array<const char*, 6> kRowKeyFields{ "formId", "id", "actionId", "av", "slotId", "group" };
+
+	[[nodiscard]] inline bool DiffValue(const Json& prev, const Json& next, Json& out);
+
+	namespace Detail
+	{
+		[[nodiscard]] inline const char* FindRowKeyField(const Json& prev, const Json& next)
+		{
+			for (const auto* field : kRowKeyFields) {
+				const auto hasKey = [field](const Json& row) {
+					if (!row.is_object()) {
+						return false;
+					}
+					const auto it = row.find(field);
+					return it != row.end() && (it->is_number() || it->is_string());
+				};
+				if (std::all_of(prev.begin(), prev.end(), hasKey) && std::all_of(next.begin(), next.end(), hasKey)) {
+					return field;
+				}
+			}
+			return nullptr;
+		}
+
+		// Keyed splices for arrays of objects; anything else is replaced wholesale by the caller.
+		[[nodiscard]] inline bool DiffArray(const Json& prev, const Json& next, Json& out)
+		{
+			const auto* keyField = FindRowKeyField(prev, next);
+			if (!keyField) {
+				return false;
+			}
+
+			std::vector<Json> prevKeys;
+			std::vector<Json> nextKeys;
+			prevKeys.reserve(prev.size());
+			nextKeys.reserve(next.size());
+			for (const auto& row : prev) {
+				prevKeys.push_back(row.at(keyField));
+			}
+			for (const auto& row : next) {
+				nextKeys.push_back(row.at(keyField));
+			}
+
+			const auto ops = PlanRowOps(prevKeys, nextKeys, [&prev, &next](std::size_t i, std::size_t j) {
+				return prev[i] == next[j];
+			});
+			if (!ops || ops->size() > next.size()) {
+				return false;
+			}
+
+			Json rows = Json::array();
+			for (const auto& op : *ops) {
+				switch (op.kind) {
+				case RowOpKind::kRemove:
+					rows.push_back({ { "op", "remove" }, { "index", op.index }, { "key", prevKeys[op.prevIndex] } });
+					break;
+				case RowOpKind::kInsert:
+					rows.push_back({ { "op", "insert" }, { "index", op.index }, { "row", next[op.nextIndex] } });
+					break;
+				case RowOpKind::kUpdate:
+					{
+						Json rowPatch;
+						if (!DiffValue(prev[op.prevIndex], next[op.nextIndex], rowPatch)) {
+							return false;
+						}
+						rows.push_back({ { "op", "patch" }, { "index", op.index }, { "patch", std::move(rowPatch) } });
+					}
+					break;
+				}
+			}
+
+			out = Json{ { "key", keyField }, { "rows", std::move(rows) } };
+			return true;
+		}
+
+		[[nodiscard]] inline bool DiffObject(const Json& prev, const Json& next, Json& out)
+		{
+			Json set = Json::object();
+			Json unset = Json::array();
+			Json nested = Json::object();
+
+			for (const auto& item : next.items()) {
+				const auto it = prev.find(item.key());
+				if (it == prev.end()) {
+					set[item.key()] = item.value();
+					continue;
+				}
+				if (*it == item.value()) {
+					continue;
+				}
+
+				Json child;
+				if (DiffValue(*it, item.value(), child)) {
+					nested[item.key()] = std::move(child);
+				} else {
+					set[item.key()] = item.value();
+				}
+			}
+			for (const auto& item : prev.items()) {
+				if (!next.contains(item.key())) {
+					unset.push_back(item.key());
+				}
+			}
+
+			out = Json::object();
+			if (!set.empty()) {
+				out["set"] = std::move(set);
+			}
+			if (!unset.empty()) {
+				out["unset"] = std::move(unset);
+			}
+			if (!nested.empty()) {
+				out["patch"] = std::move(nested);
+			}
+			return true;
+		}
+	}
+
+	// Writes a patch turning `prev` into `next`; false when `next` must be sent whole.
+	[[nodiscard]] inline bool DiffValue(const Json& prev, const Json& next, Json& out)
+	{
+		if (prev.is_object() && next.is_object()) {
+			return Detail::DiffObject(prev, next, out);
+		}
+		if (prev.is_array() && next.is_array()) {
+			return Detail::DiffArray(prev, next, out);
+		}
+		return false;
+	}
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CodexOfPowerNG::UiPatch
+{
+	enum class RowOpKind : std::uint8_t
+	{
+		kRemove,
+		kInsert,
+		kUpdate,
+	};
+
+	// One step of a keyed row patch. Ops are applied in order: removes (descending `index`, into the
+	// old rows), inserts (ascending `index`, into the final positions), then in-place updates.
+	struct RowOp
+	{
+		RowOpKind   kind{ RowOpKind::kInsert };
+		std::size_t index{ 0 };
+		std::size_t prevIndex{ 0 };
+		std::size_t nextIndex{ 0 };
+	};
+
+	namespace Detail
+	{
+		// Positions (into `values`) of one longest strictly increasing subsequence.
+		[[nodiscard]] inline std::vector<std::size_t> LongestIncreasing(const std::vector<std::size_t>& values)
+		{
+			std::vector<std::size_t> tails;
+			std::vector<std::size_t> parent(values.size(), values.size());
+			for (std::size_t i = 0; i < values.size(); ++i) {
+				const auto pos = static_cast<std::size_t>(
+					std::lower_bound(tails.begin(), tails.end(), values[i], [&values](std::size_t at, std::size_t v) {
+						return values[at] < v;
+					}) -
+					tails.begin());
+				if (pos > 0) {
+					parent[i] = tails[pos - 1];
+				}
+				if (pos == tails.size()) {
+					tails.push_back(i);
+				} else {
+					tails[pos] = i;
+				}
+			}
+
+			std::vector<std::size_t> out(tails.size());
+			auto at = tails.empty() ? values.size() : tails.back();
+			for (auto slot = out.size(); slot > 0; --slot) {
+				out[slot - 1] = at;
+				at = parent[at];
+			}
+			return out;
+		}
+	}
+
+	// Smallest-ish splice plan turning rows keyed `prevKeys` into rows keyed `nextKeys`: rows that
+	// keep their relative order stay put (updated in place when `sameRow(prev, next)` is false),
+	// everything else is removed and re-inserted. Returns nullopt when either side repeats a key.
+	template <class Key, class SameRowFn>
+	[[nodiscard]] std::optional<std::vector<RowOp>> PlanRowOps(
+		const std::vector<Key>& prevKeys,
+		const std::vector<Key>& nextKeys,
+		SameRowFn&&             sameRow)
+	{
+		std::unordered_map<Key, std::size_t> nextIndex;
+		nextIndex.reserve(nextKeys.size());
+		for (std::size_t j = 0; j < nextKeys.size(); ++j) {
+			if (!nextIndex.emplace(nextKeys[j], j).second) {
+				return std::nullopt;
+			}
+		}
+
+		std::unordered_map<Key, std::size_t> seenPrev;
+		seenPrev.reserve(prevKeys.size());
+		std::vector<std::size_t> matchedPrev;
+		std::vector<std::size_t> matchedNext;
+		for (std::size_t i = 0; i < prevKeys.size(); ++i) {
+			if (!seenPrev.emplace(prevKeys[i], i).second) {
+				return std::nullopt;
+			}
+			if (const auto it = nextIndex.find(prevKeys[i]); it != nextIndex.end()) {
+				matchedPrev.push_back(i);
+				matchedNext.push_back(it->second);
+			}
+		}
+
+		std::vector<bool> keepPrev(prevKeys.size(), false);
+		std::vector<bool> keepNext(nextKeys.size(), false);
+		std::vector<std::pair<std::size_t, std::size_t>> kept;
+		for (const auto at : Detail::LongestIncreasing(matchedNext)) {
+			keepPrev[matchedPrev[at]] = true;
+			keepNext[matchedNext[at]] = true;
+			kept.emplace_back(matchedPrev[at], matchedNext[at]);
+		}
+
+		std::vector<RowOp> ops;
+		for (auto i = prevKeys.size(); i > 0; --i) {
+			if (!keepPrev[i - 1]) {
+				ops.push_back(RowOp{ RowOpKind::kRemove, i - 1, i - 1, 0 });
+			}
+		}
+		for (std::size_t j = 0; j < nextKeys.size(); ++j) {
+			if (!keepNext[j]) {
+				ops.push_back(RowOp{ RowOpKind::kInsert, j, 0, j });
+			}
+		}
+		for (const auto& [i, j] : kept) {
+			if (!sameRow(i, j)) {
+				ops.push_back(RowOp{ RowOpKind::kUpdate, j, i, j });
+			}
+		}
+		return ops;
+	}
+
+	// Last full document the view holds for each channel, plus the generation stamped on every
+	// patch. A patch is only valid against the exact generation it was diffed from; generation 0
+	// means the journal was just reset and the view must accept the next patch unconditionally.
+	// `epoch` counts resets, so a patch diffed at generation 0 is told apart from one after a reset.
+	template <class Doc, std::size_t kChannels>
+	struct Journal
+	{
+		std::array<std::optional<Doc>, kChannels> baselines{};
+		std::uint64_t                             generation{ 0 };
+		std::uint64_t                             epoch{ 0 };
+	};
+
+	template <class Doc, std::size_t kChannels>
+	void Reset(Journal<Doc, kChannels>& journal) noexcept
+	{
+		for (auto& baseline : journal.baselines) {
+			baseline.reset();
+		}
+		journal.generation = 0;
+		++journal.epoch;
+	}
+
+	// Records a full snapshot the view just received outside the patch channel.
+	template <class Doc, std::size_t kChannels>
+	void Record(Journal<Doc, kChannels>& journal, std::size_t channel, Doc doc)
+	{
+		if (channel < kChannels) {
+			journal.baselines[channel] = std::move(doc);
+		}
+	}
+
+	// Stamps the next patch; returns the generation it was diffed against and the new generation.
+	template <class Doc, std::size_t kChannels>
+	[[nodiscard]] std::pair<std::uint64_t, std::uint64_t> Advance(Journal<Doc, kChannels>& journal) noexcept
+	{
+		const auto base = journal.generation;
+		++journal.generation;
+		return { base, journal.generation };
+	}
+
+	// Baselines a built patch moves the view to, held back until the patch is delivered.
+	template <class Doc, std::size_t kChannels>
+	struct PendingPatch
+	{
+		std::array<std::optional<Doc>, kChannels> baselines{};
+		std::uint64_t                             base{ 0 };
+		std::uint64_t                             epoch{ 0 };
+	};
+
+	// Stamps `pending` with the journal position it is diffed against.
+	template <class Doc, std::size_t kChannels>
+	void Begin(const Journal<Doc, kChannels>& journal, PendingPatch<Doc, kChannels>& pending) noexcept
+	{
+		pending.base = journal.generation;
+		pending.epoch = journal.epoch;
+	}
+
+	// Adopts a delivered patch's baselines and advances the generation. Returns false, leaving the
+	// journal untouched, when it moved or was reset after the patch was diffed (e.g. on DOM ready),
+	// including a reset that lands back on the same generation.
+	template <class Doc, std::size_t kChannels>
+	bool Commit(Journal<Doc, kChannels>& journal, PendingPatch<Doc, kChannels>& pending)
+	{
+		if (journal.epoch != pending.epoch || journal.generation != pending.base) {
+			return false;
+		}
+		for (std::size_t i = 0; i < kChannels; ++i) {
+			if (pending.baselines[i]) {
+				journal.baselines[i] = std::move(*pending.baselines[i]);
+			}
+		}
+		(void)Advance(journal);
+		return true;
+	}
+}
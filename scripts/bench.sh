@@ -0,0 +1,37 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+
+if ! command -v c++ >/dev/null 2>&1; then
+  echo "[copng] c++ not found (required for benchmarks)" >&2
+  exit 1
+fi
+
+shopt -s nullglob
+BENCHES=( "$ROOT_DIR/benchmarks/"*.bench.cpp )
+if (( $# > 0 )); then
+  BENCHES=()
+  for name in "$@"; do
+    BENCHES+=( "$ROOT_DIR/benchmarks/${name%.bench.cpp}.bench.cpp" )
+  done
+fi
+
+if (( ${#BENCHES[@]} == 0 )); then
+  echo "[copng] No benchmarks found (benchmarks/*.bench.cpp)"
+  exit 0
+fi
+
+TMP_DIR="$(mktemp -d)"
+cleanup() { rm -rf "$TMP_DIR"; }
+trap cleanup EXIT
+
+for bench_src in "${BENCHES[@]}"; do
+  exe="$TMP_DIR/$(basename "${bench_src%.cpp}")"
+  echo "[copng] build: $(basename "$bench_src")"
+  c++ -std=c++20 -O2 -DNDEBUG -Wall -Wextra -pthread -I"$ROOT_DIR/include" -I"$ROOT_DIR/benchmarks" "$bench_src" -o "$exe"
+  echo "[copng] run: $(basename "$bench_src")"
+  "$exe"
+done
+
+echo "[copng] OK"
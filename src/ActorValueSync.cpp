@@ -0,0 +1,165 @@
+#include "CodexOfPowerNG/ActorValueSync.h"
+
+#include "CodexOfPowerNG/RewardCaps.h"
+#include "CodexOfPowerNG/State.h"
+
+#include <RE/T/TESObjectWEAP.h>
+
+#include <SKSE/Logger.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace CodexOfPowerNG::ActorValueSync
+{
+	namespace
+	{
+		struct ThreadBatch
+		{
+			std::uint32_t                 depth{ 0 };
+			bool                          refreshWeaponAbilities{ false };
+			DeltaBatch<kActorValueCount>  deltas;
+		};
+
+		thread_local ThreadBatch g_batch{};
+
+		[[nodiscard]] RE::ExtraDataList* PickFirstExtraDataList(RE::InventoryEntryData* entry) noexcept
+		{
+			if (!entry || !entry->extraLists) {
+				return nullptr;
+			}
+
+			for (auto* extraData : *entry->extraLists) {
+				if (extraData) {
+					return extraData;
+				}
+			}
+
+			return nullptr;
+		}
+
+		void RefreshEquippedWeaponAbilityForHand(RE::Actor* actor, bool leftHand) noexcept
+		{
+			if (!actor) {
+				return;
+			}
+
+			auto* equippedForm = actor->GetEquippedObject(leftHand);
+			if (!equippedForm || !equippedForm->As<RE::TESObjectWEAP>()) {
+				return;
+			}
+
+			auto* entry = actor->GetEquippedEntryData(leftHand);
+			auto* extraData = PickFirstExtraDataList(entry);
+			actor->UpdateWeaponAbility(equippedForm, extraData, leftHand);
+		}
+
+		void RefreshEquippedWeaponAbilities() noexcept
+		{
+			auto* player = RE::PlayerCharacter::GetSingleton();
+			if (!player) {
+				return;
+			}
+
+			RefreshEquippedWeaponAbilityForHand(player, false);
+			RefreshEquippedWeaponAbilityForHand(player, true);
+		}
+
+		[[nodiscard]] RE::ActorValueOwner* PlayerActorValueOwner() noexcept
+		{
+			auto* player = RE::PlayerCharacter::GetSingleton();
+			return player ? player->AsActorValueOwner() : nullptr;
+		}
+
+		void FlushBatch() noexcept
+		{
+			auto* avOwner = PlayerActorValueOwner();
+			if (!avOwner) {
+				// The layers already booked these writes; keep them for the next batch that sees the player.
+				if (!g_batch.deltas.Empty()) {
+					SKSE::log::warn(
+						"Actor value sync: player unavailable; keeping {} staged AV write(s) for the next batch",
+						g_batch.deltas.TouchedCount());
+				}
+				return;
+			}
+
+			const auto stats = g_batch.deltas.Flush(
+				[avOwner](std::size_t av, float delta) {
+					avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kPermanent, static_cast<RE::ActorValue>(av), delta);
+				},
+				Rewards::kRewardCapEpsilon);
+
+			const bool refresh = g_batch.refreshWeaponAbilities;
+			g_batch.refreshWeaponAbilities = false;
+			if (refresh) {
+				RefreshEquippedWeaponAbilities();
+			}
+
+			const auto staged = stats.staged[static_cast<std::size_t>(Layer::kRewards)] +
+			                    stats.staged[static_cast<std::size_t>(Layer::kBuildEffects)];
+			if (staged > stats.writes) {
+				SKSE::log::info(
+					"Actor value sync: {} reward + {} build effect delta(s) -> {} write(s) ({} cancelled out){}",
+					stats.staged[static_cast<std::size_t>(Layer::kRewards)],
+					stats.staged[static_cast<std::size_t>(Layer::kBuildEffects)],
+					stats.writes,
+					stats.cancelled,
+					refresh ? ", weapon abilities refreshed once" : "");
+			}
+		}
+	}
+
+	WriteBatch::WriteBatch() noexcept
+	{
+		++g_batch.depth;
+	}
+
+	WriteBatch::~WriteBatch()
+	{
+		if (--g_batch.depth == 0) {
+			FlushBatch();
+		}
+	}
+
+	bool ApplyPermanentDelta(RE::ActorValue av, float delta, Layer layer) noexcept
+	{
+		if (!std::isfinite(delta) || std::abs(delta) <= Rewards::kRewardCapEpsilon) {
+			return true;
+		}
+		if (g_batch.depth > 0 && g_batch.deltas.Add(static_cast<std::size_t>(av), layer, delta)) {
+			return true;
+		}
+
+		auto* avOwner = PlayerActorValueOwner();
+		if (!avOwner) {
+			return false;
+		}
+		avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kPermanent, av, delta);
+		return true;
+	}
+
+	float PendingDelta(RE::ActorValue av) noexcept
+	{
+		return g_batch.depth > 0 ? g_batch.deltas.Pending(static_cast<std::size_t>(av)) : 0.0f;
+	}
+
+	void RequestWeaponAbilityRefresh() noexcept
+	{
+		if (g_batch.depth > 0) {
+			g_batch.refreshWeaponAbilities = true;
+			return;
+		}
+		RefreshEquippedWeaponAbilities();
+	}
+
+	void DiscardStagedForLoad() noexcept
+	{
+		const auto stats = g_batch.deltas.Flush([](std::size_t, float) {}, Rewards::kRewardCapEpsilon);
+		g_batch.refreshWeaponAbilities = false;
+		if (stats.writes > 0) {
+			SKSE::log::info("Actor value sync: discarded {} write(s) staged before the load", stats.writes);
+		}
+	}
+}
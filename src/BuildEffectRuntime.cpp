@@ -1,5 +1,6 @@
 #include "CodexOfPowerNG/BuildEffectRuntime.h"
 
+#include "CodexOfPowerNG/ActorValueSync.h"
 #include "CodexOfPowerNG/BuildOptionCatalog.h"
 #include "CodexOfPowerNG/RewardCaps.h"
 #include "CodexOfPowerNG/SerializationStateStore.h"
@@ -7,14 +8,11 @@
 
 #include <RE/Skyrim.h>
 
-#include <RE/T/TESObjectWEAP.h>
-
-#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <mutex>
 #include <optional>
 #include <string_view>
-#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -240,10 +238,10 @@ namespace CodexOfPowerNG::Builds
 		}
 
 		void AccumulateEffect(
-			std::unordered_map<RE::ActorValue, float, ActorValueHash>& totals,
-			BuildEffectType                                           effectType,
-			std::string_view                                          effectKey,
-			const BuildMagnitude&                                     magnitude) noexcept
+			ActorValueTotals&     totals,
+			BuildEffectType       effectType,
+			std::string_view      effectKey,
+			const BuildMagnitude& magnitude) noexcept
 		{
 			const auto resolved = ResolveActorValueDeltas(effectType, effectKey, magnitude);
 			if (resolved.empty()) {
@@ -251,8 +249,7 @@ namespace CodexOfPowerNG::Builds
 			}
 
 			for (const auto& [actorValue, delta] : resolved) {
-				auto& total = totals[actorValue];
-				total += delta;
+				totals.Accumulate(actorValue, delta);
 			}
 		}
 
@@ -270,19 +267,19 @@ namespace CodexOfPowerNG::Builds
 			return snapshot;
 		}
 
-		[[nodiscard]] std::unordered_map<RE::ActorValue, float, ActorValueHash> SnapshotAppliedBuildEffectTotals() noexcept
+		[[nodiscard]] ActorValueTotals SnapshotAppliedBuildEffectTotals() noexcept
 		{
 			auto& state = GetState();
 			std::scoped_lock lock(state.mutex);
 			return state.buildAppliedEffectTotals;
 		}
 
-		void ReplaceAppliedBuildEffectTotals(
-			std::unordered_map<RE::ActorValue, float, ActorValueHash> totals) noexcept
+		void ReplaceAppliedBuildEffectTotals(const ActorValueTotals& totals) noexcept
 		{
 			auto& state = GetState();
 			std::scoped_lock lock(state.mutex);
-			state.buildAppliedEffectTotals = std::move(totals);
+			state.buildAppliedEffectTotals = totals;
+			state.saveGenerations.Bump(Serialization::SaveRecord::kBuildAppliedEffects);
 		}
 
 		void ClearAppliedBuildEffectTotals() noexcept
@@ -290,55 +287,13 @@ namespace CodexOfPowerNG::Builds
 			auto& state = GetState();
 			std::scoped_lock lock(state.mutex);
 			state.buildAppliedEffectTotals.clear();
-		}
-
-		[[nodiscard]] RE::ExtraDataList* PickFirstExtraDataList(RE::InventoryEntryData* entry) noexcept
-		{
-			if (!entry || !entry->extraLists) {
-				return nullptr;
-			}
-
-			for (auto* extraData : *entry->extraLists) {
-				if (extraData) {
-					return extraData;
-				}
-			}
-
-			return nullptr;
-		}
-
-		void RefreshEquippedWeaponAbilityForHand(RE::Actor* actor, bool leftHand) noexcept
-		{
-			if (!actor) {
-				return;
-			}
-
-			auto* equippedForm = actor->GetEquippedObject(leftHand);
-			if (!equippedForm || !equippedForm->As<RE::TESObjectWEAP>()) {
-				return;
-			}
-
-			auto* entry = actor->GetEquippedEntryData(leftHand);
-			auto* extraData = PickFirstExtraDataList(entry);
-			actor->UpdateWeaponAbility(equippedForm, extraData, leftHand);
-		}
-
-		void RefreshEquippedWeaponAbilities() noexcept
-		{
-			auto* player = RE::PlayerCharacter::GetSingleton();
-			if (!player) {
-				return;
-			}
-
-			RefreshEquippedWeaponAbilityForHand(player, false);
-			RefreshEquippedWeaponAbilityForHand(player, true);
+			state.saveGenerations.Bump(Serialization::SaveRecord::kBuildAppliedEffects);
 		}
 	}
 
-	std::vector<std::pair<RE::ActorValue, float>> ComputeDerivedBuildActorValueTotals(
-		const BuildRuntimeSnapshot& snapshot) noexcept
+	ActorValueTotals ComputeDerivedBuildActorValueTotals(const BuildRuntimeSnapshot& snapshot) noexcept
 	{
-		std::unordered_map<RE::ActorValue, float, ActorValueHash> totals;
+		ActorValueTotals totals;
 
 		std::unordered_set<std::string_view> appliedOptionIds;
 		for (const auto slotId : GetInitialBuildSlotLayout()) {
@@ -373,22 +328,8 @@ namespace CodexOfPowerNG::Builds
 			}
 		}
 
-		std::vector<std::pair<RE::ActorValue, float>> out;
-		out.reserve(totals.size());
-		for (const auto& [av, total] : totals) {
-			if (std::abs(total) <= Rewards::kRewardCapEpsilon) {
-				continue;
-			}
-			out.emplace_back(av, total);
-		}
-
-		std::sort(
-			out.begin(),
-			out.end(),
-			[](const auto& lhs, const auto& rhs) {
-				return static_cast<std::uint32_t>(lhs.first) < static_cast<std::uint32_t>(rhs.first);
-			});
-		return out;
+		(void)totals.Prune(Rewards::kRewardCapEpsilon);
+		return totals;
 	}
 
 	float ClampBuildSyncDeltaForActorValue(
@@ -415,67 +356,71 @@ namespace CodexOfPowerNG::Builds
 	}
 
 	void SyncCurrentBuildEffectsToPlayer() noexcept
+	{
+		BuildEffectSyncCursor cursor{};
+		(void)SyncCurrentBuildEffectsToPlayerSlice(cursor, std::chrono::microseconds::max());
+	}
+
+	bool SyncCurrentBuildEffectsToPlayerSlice(
+		BuildEffectSyncCursor&    cursor,
+		std::chrono::microseconds budget) noexcept
 	{
 		auto* player = RE::PlayerCharacter::GetSingleton();
 		if (!player) {
-			return;
+			return true;
 		}
 		auto* avOwner = player->AsActorValueOwner();
 		if (!avOwner) {
-			return;
+			return true;
 		}
 
-		const auto desiredList = ComputeDerivedBuildActorValueTotals(SnapshotCurrentBuildRuntime());
-		std::unordered_map<RE::ActorValue, float, ActorValueHash> desiredTotals;
-		for (const auto& [av, total] : desiredList) {
-			desiredTotals.emplace(av, total);
-		}
+		const auto sliceStart = std::chrono::steady_clock::now();
+		ActorValueSync::WriteBatch actorValueWrites;
+		const auto desiredTotals = ComputeDerivedBuildActorValueTotals(SnapshotCurrentBuildRuntime());
 
-		bool refreshWeaponAbilities = false;
+		bool finished = true;
 		{
 			std::scoped_lock lock(g_runtimeMutex);
+			// Re-read every slice: whatever ran in between is reconciled against the live totals.
 			const auto currentAppliedTotals = SnapshotAppliedBuildEffectTotals();
 			auto nextAppliedTotals = currentAppliedTotals;
-			std::unordered_set<RE::ActorValue, ActorValueHash> actorValues;
-			for (const auto& [av, _] : currentAppliedTotals) {
-				actorValues.insert(av);
-			}
-			for (const auto& [av, _] : desiredTotals) {
-				actorValues.insert(av);
-			}
+			// Covers every AV that is applied now or desired, in AV order.
+			const auto desiredDeltas = ActorValueTotals::Difference(desiredTotals, currentAppliedTotals);
 
-			for (const auto av : actorValues) {
-				const float currentTotal = currentAppliedTotals.contains(av) ? currentAppliedTotals.at(av) : 0.0f;
-				const float desiredTotal = desiredTotals.contains(av) ? desiredTotals[av] : 0.0f;
-				const float desiredDelta = desiredTotal - currentTotal;
-				const float currentActorValue = avOwner->GetActorValue(av);
+			bool synced = false;
+			for (const auto& [av, desiredDelta] : desiredDeltas) {
+				const auto avIndex = static_cast<std::size_t>(av);
+				if (avIndex < cursor.nextActorValue) {
+					continue;
+				}
+				if (synced && std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sliceStart) >= budget) {
+					finished = false;
+					break;
+				}
+				cursor.nextActorValue = avIndex + 1;
+				synced = true;
+
+				// Other layers' writes staged in the same batch have not reached the actor yet.
+				const float currentActorValue = avOwner->GetActorValue(av) + ActorValueSync::PendingDelta(av);
 				const float delta = ClampBuildSyncDeltaForActorValue(av, currentActorValue, desiredDelta);
 				if (std::abs(delta) <= Rewards::kRewardCapEpsilon) {
-					if (std::abs(currentTotal) <= Rewards::kRewardCapEpsilon) {
-						nextAppliedTotals.erase(av);
-					} else {
-						nextAppliedTotals[av] = currentTotal;
-					}
 					continue;
 				}
 
-				avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kPermanent, av, delta);
-				const float appliedTotal = currentTotal + delta;
-				if (std::abs(appliedTotal) <= Rewards::kRewardCapEpsilon) {
-					nextAppliedTotals.erase(av);
-				} else {
-					nextAppliedTotals[av] = appliedTotal;
-				}
+				(void)ActorValueSync::ApplyPermanentDelta(av, delta, ActorValueSync::Layer::kBuildEffects);
+				nextAppliedTotals.insert_or_assign(av, currentAppliedTotals.Value(av) + delta);
 				if (av == RE::ActorValue::kAttackDamageMult || av == RE::ActorValue::kWeaponSpeedMult) {
-					refreshWeaponAbilities = true;
+					cursor.refreshWeaponAbilities = true;
 				}
 			}
-			ReplaceAppliedBuildEffectTotals(std::move(nextAppliedTotals));
+			(void)nextAppliedTotals.Prune(Rewards::kRewardCapEpsilon);
+			ReplaceAppliedBuildEffectTotals(nextAppliedTotals);
 		}
 
-		if (refreshWeaponAbilities) {
-			RefreshEquippedWeaponAbilities();
+		if (finished && cursor.refreshWeaponAbilities) {
+			ActorValueSync::RequestWeaponAbilityRefresh();
 		}
+		return finished;
 	}
 
 	void ResetForLoad() noexcept
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <utility>
 
 namespace CodexOfPowerNG::BuildProgression
 {
@@ -30,8 +31,8 @@ namespace CodexOfPowerNG::BuildProgression
 		[[nodiscard]] bool HasLegacyUndoRewardDeltas(const SerializationStateStore::Snapshot& snapshot) noexcept
 		{
 			return std::any_of(
-				snapshot.undoHistory.begin(),
-				snapshot.undoHistory.end(),
+				snapshot.undoHistory->begin(),
+				snapshot.undoHistory->end(),
 				[](const Registration::UndoRecord& record) { return !record.rewardDeltas.empty(); });
 		}
 
@@ -42,7 +43,11 @@ namespace CodexOfPowerNG::BuildProgression
 
 		void StripLegacyUndoRewardDeltas(SerializationStateStore::Snapshot& snapshot) noexcept
 		{
-			for (auto& record : snapshot.undoHistory) {
+			// Only unshare the history from RuntimeState when there is something to strip.
+			if (!HasLegacyUndoRewardDeltas(snapshot)) {
+				return;
+			}
+			for (auto& record : snapshot.undoHistory.Write()) {
 				record.rewardDeltas.clear();
 			}
 		}
@@ -74,50 +79,27 @@ namespace CodexOfPowerNG::BuildProgression
 			}
 		}
 
-		void ApplyDerivedScore(
-			SerializationStateStore::Snapshot& snapshot,
-			Builds::BuildDiscipline           discipline) noexcept
-		{
-			switch (discipline) {
-			case Builds::BuildDiscipline::Attack:
-				++snapshot.attackScore;
-				break;
-			case Builds::BuildDiscipline::Defense:
-				++snapshot.defenseScore;
-				break;
-			case Builds::BuildDiscipline::Utility:
-				++snapshot.utilityScore;
-				break;
-			}
-		}
-
-		void ApplyDerivedBuildPoints(
-			SerializationStateStore::Snapshot& snapshot,
-			Builds::BuildDiscipline           discipline,
-			Builds::BuildPointCenti           pointsCenti) noexcept
+		void ApplyDerivedContribution(
+			LegacyScoreTally&       tally,
+			Builds::BuildDiscipline discipline,
+			Builds::BuildPointCenti pointsCenti) noexcept
 		{
 			switch (discipline) {
 			case Builds::BuildDiscipline::Attack:
-				snapshot.attackBuildPointsCenti += pointsCenti;
+				++tally.attackScore;
+				tally.attackBuildPointsCenti += pointsCenti;
 				break;
 			case Builds::BuildDiscipline::Defense:
-				snapshot.defenseBuildPointsCenti += pointsCenti;
+				++tally.defenseScore;
+				tally.defenseBuildPointsCenti += pointsCenti;
 				break;
 			case Builds::BuildDiscipline::Utility:
-				snapshot.utilityBuildPointsCenti += pointsCenti;
+				++tally.utilityScore;
+				tally.utilityBuildPointsCenti += pointsCenti;
 				break;
 			}
 		}
 
-		void ApplyDerivedContribution(
-			SerializationStateStore::Snapshot& snapshot,
-			Builds::BuildDiscipline           discipline,
-			Builds::BuildPointCenti           pointsCenti) noexcept
-		{
-			ApplyDerivedScore(snapshot, discipline);
-			ApplyDerivedBuildPoints(snapshot, discipline, pointsCenti);
-		}
-
 		[[nodiscard]] std::uint32_t CurrentScore(Builds::BuildDiscipline discipline) noexcept
 		{
 			switch (discipline) {
@@ -318,42 +300,34 @@ namespace CodexOfPowerNG::BuildProgression
 		return effectiveResolver ? effectiveResolver(regKey) : std::nullopt;
 	}
 
-	void NormalizeLoadedSnapshot(
-		SerializationStateStore::Snapshot& snapshot,
-		LegacyDisciplineResolver           resolver) noexcept
+	LegacyScoreTally BeginLegacyScoreTally(const SerializationStateStore::Snapshot& snapshot)
 	{
-		NormalizeActiveSlotOptionIds(snapshot);
-
+		LegacyScoreTally tally{};
 		if (snapshot.buildMigrationVersion >= kBuildMigrationVersion) {
-			if (snapshot.buildMigrationState == Builds::BuildMigrationState::kPendingCleanup) {
-				ClearActiveSlots(snapshot);
-			} else if (snapshot.buildMigrationState == Builds::BuildMigrationState::kComplete) {
-				StripLegacyUndoRewardDeltas(snapshot);
-			}
-			return;
+			return tally;
 		}
+		tally.items.reserve(snapshot.registeredItems.size());
+		for (const auto& [formId, group] : std::as_const(snapshot.registeredItems)) {
+			tally.items.emplace_back(formId, group);
+		}
+		return tally;
+	}
 
-		const bool hadLegacyRegistrations = !snapshot.registeredItems.empty();
-		const bool hadLegacyRewards = HasLegacyRewardTotals(snapshot);
-		const bool hadLegacyUndo = HasLegacyUndoRewardDeltas(snapshot);
-
-		snapshot.attackScore = 0u;
-		snapshot.defenseScore = 0u;
-		snapshot.utilityScore = 0u;
-		snapshot.attackBuildPointsCenti = 0u;
-		snapshot.defenseBuildPointsCenti = 0u;
-		snapshot.utilityBuildPointsCenti = 0u;
-		ClearActiveSlots(snapshot);
-
-		std::uint32_t unresolvedHistoricalRegistrations = 0u;
-		for (const auto& [formId, group] : snapshot.registeredItems) {
+	bool ContinueLegacyScoreTally(
+		LegacyScoreTally&        tally,
+		std::size_t              maxItems,
+		LegacyDisciplineResolver resolver) noexcept
+	{
+		const auto end = tally.items.size() - tally.next > maxItems ? tally.next + maxItems : tally.items.size();
+		for (; tally.next < end; ++tally.next) {
+			const auto [formId, group] = tally.items[tally.next];
 			if (resolver == nullptr) {
 				if (const auto* form = RE::TESForm::LookupByID(formId)) {
 					const auto formType = form->GetFormType();
 					const auto discipline = TryResolveDisciplineFromFormType(formType);
 					const auto pointsCenti = ResolveBuildPointsForFormType(formType);
 					if (discipline.has_value() && pointsCenti > 0u) {
-						ApplyDerivedContribution(snapshot, discipline.value(), pointsCenti);
+						ApplyDerivedContribution(tally, discipline.value(), pointsCenti);
 						continue;
 					}
 				}
@@ -361,11 +335,54 @@ namespace CodexOfPowerNG::BuildProgression
 
 			const auto discipline = TryResolveLegacyDiscipline(formId, group, resolver);
 			if (!discipline.has_value()) {
-				++unresolvedHistoricalRegistrations;
+				++tally.unresolvedHistoricalRegistrations;
 				continue;
 			}
-			ApplyDerivedContribution(snapshot, discipline.value(), ResolveFallbackBuildPointsCenti(discipline.value()));
+			ApplyDerivedContribution(tally, discipline.value(), ResolveFallbackBuildPointsCenti(discipline.value()));
 		}
+		return tally.Finished();
+	}
+
+	void NormalizeLoadedSnapshot(
+		SerializationStateStore::Snapshot& snapshot,
+		LegacyDisciplineResolver           resolver,
+		const LegacyScoreTally*            tally) noexcept
+	{
+		NormalizeActiveSlotOptionIds(snapshot);
+
+		if (snapshot.buildMigrationVersion >= kBuildMigrationVersion) {
+			if (snapshot.buildMigrationState == Builds::BuildMigrationState::kPendingCleanup) {
+				ClearActiveSlots(snapshot);
+			} else if (snapshot.buildMigrationState == Builds::BuildMigrationState::kComplete) {
+				StripLegacyUndoRewardDeltas(snapshot);
+			}
+			return;
+		}
+
+		const bool hadLegacyRegistrations = !snapshot.registeredItems.empty();
+		const bool hadLegacyRewards = HasLegacyRewardTotals(snapshot);
+		const bool hadLegacyUndo = HasLegacyUndoRewardDeltas(snapshot);
+
+		LegacyScoreTally inlineTally{};
+		if (!tally || !tally->Finished() || tally->items.size() != snapshot.registeredItems.size()) {
+			try {
+				inlineTally = BeginLegacyScoreTally(snapshot);
+			} catch (...) {
+				inlineTally = {};
+			}
+			(void)ContinueLegacyScoreTally(inlineTally, inlineTally.items.size(), resolver);
+			tally = &inlineTally;
+		}
+
+		snapshot.attackScore = tally->attackScore;
+		snapshot.defenseScore = tally->defenseScore;
+		snapshot.utilityScore = tally->utilityScore;
+		snapshot.attackBuildPointsCenti = tally->attackBuildPointsCenti;
+		snapshot.defenseBuildPointsCenti = tally->defenseBuildPointsCenti;
+		snapshot.utilityBuildPointsCenti = tally->utilityBuildPointsCenti;
+		ClearActiveSlots(snapshot);
+
+		const std::uint32_t unresolvedHistoricalRegistrations = tally->unresolvedHistoricalRegistrations;
 
 		snapshot.buildMigrationVersion = kBuildMigrationVersion;
 		snapshot.buildMigrationNotice = {};
@@ -140,6 +140,7 @@ namespace CodexOfPowerNG::BuildStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		state.attackScore = score;
+		state.saveGenerations.Bump(Serialization::SaveRecord::kBuildScores);
 	}
 
 	void SetDefenseScore(std::uint32_t score) noexcept
@@ -147,6 +148,7 @@ namespace CodexOfPowerNG::BuildStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		state.defenseScore = score;
+		state.saveGenerations.Bump(Serialization::SaveRecord::kBuildScores);
 	}
 
 	void SetUtilityScore(std::uint32_t score) noexcept
@@ -154,6 +156,7 @@ namespace CodexOfPowerNG::BuildStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		state.utilityScore = score;
+		state.saveGenerations.Bump(Serialization::SaveRecord::kBuildScores);
 	}
 
 	void SetAttackBuildPointsCenti(Builds::BuildPointCenti points) noexcept
@@ -161,6 +164,7 @@ namespace CodexOfPowerNG::BuildStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		state.attackBuildPointsCenti = points;
+		state.saveGenerations.Bump(Serialization::SaveRecord::kBuildScores);
 	}
 
 	void SetDefenseBuildPointsCenti(Builds::BuildPointCenti points) noexcept
@@ -168,6 +172,7 @@ namespace CodexOfPowerNG::BuildStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		state.defenseBuildPointsCenti = points;
+		state.saveGenerations.Bump(Serialization::SaveRecord::kBuildScores);
 	}
 
 	void SetUtilityBuildPointsCenti(Builds::BuildPointCenti points) noexcept
@@ -175,6 +180,7 @@ namespace CodexOfPowerNG::BuildStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		state.utilityBuildPointsCenti = points;
+		state.saveGenerations.Bump(Serialization::SaveRecord::kBuildScores);
 	}
 
 	std::optional<std::string> GetActiveSlot(Builds::BuildSlotId slotId) noexcept
@@ -210,6 +216,7 @@ namespace CodexOfPowerNG::BuildStateStore
 		}
 
 		state.activeBuildSlots[Builds::ToIndex(slotId)] = std::string(optionId);
+		state.saveGenerations.Bump(Serialization::SaveRecord::kBuildSlots);
 		return true;
 	}
 
@@ -218,6 +225,7 @@ namespace CodexOfPowerNG::BuildStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		state.activeBuildSlots[Builds::ToIndex(slotId)].clear();
+		state.saveGenerations.Bump(Serialization::SaveRecord::kBuildSlots);
 	}
 
 	void ClearActiveSlots() noexcept
@@ -227,6 +235,7 @@ namespace CodexOfPowerNG::BuildStateStore
 		for (auto& slot : state.activeBuildSlots) {
 			slot.clear();
 		}
+		state.saveGenerations.Bump(Serialization::SaveRecord::kBuildSlots);
 	}
 
 	Builds::BuildMigrationState MigrationState() noexcept
@@ -255,6 +264,7 @@ namespace CodexOfPowerNG::BuildStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		state.buildMigrationState = migrationState;
+		state.saveGenerations.Bump(Serialization::SaveRecord::kBuildMigration);
 	}
 
 	void SetMigrationVersion(std::uint32_t version) noexcept
@@ -262,6 +272,7 @@ namespace CodexOfPowerNG::BuildStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		state.buildMigrationVersion = version;
+		state.saveGenerations.Bump(Serialization::SaveRecord::kBuildMigration);
 	}
 
 	void SetMigrationNoticeSnapshot(Builds::BuildMigrationNoticeSnapshot snapshot) noexcept
@@ -269,5 +280,6 @@ namespace CodexOfPowerNG::BuildStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		state.buildMigrationNotice = snapshot;
+		state.saveGenerations.Bump(Serialization::SaveRecord::kBuildMigration);
 	}
 }
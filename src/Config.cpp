@@ -1,6 +1,7 @@
 #include "CodexOfPowerNG/Config.h"
 
 #include "CodexOfPowerNG/Constants.h"
+#include "CodexOfPowerNG/StartupPool.h"
 
 #include <RE/Skyrim.h>
 
@@ -11,6 +12,7 @@
 #include <filesystem>
 #include <fstream>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <exception>
 #include <mutex>
@@ -22,6 +24,11 @@ namespace CodexOfPowerNG
 	{
 		std::mutex g_settingsMutex;
 		Settings   g_settings{};
+		// Mirrors g_settings.normalizeRegistration; written under g_settingsMutex.
+		std::atomic_bool g_normalizeRegistration{ Settings{}.normalizeRegistration };
+
+		// Armed while the startup settings stage runs. SetSettings() does not wait: the stage itself calls it.
+		Startup::LoadGate g_settingsReady;
 
 		[[nodiscard]] bool IsValidJsonFile(const std::filesystem::path& path) noexcept
 		{
@@ -355,6 +362,7 @@ namespace CodexOfPowerNG
 
 	Settings GetSettings()
 	{
+		g_settingsReady.Wait();
 		std::scoped_lock lock(g_settingsMutex);
 		return g_settings;
 	}
@@ -363,6 +371,13 @@ namespace CodexOfPowerNG
 	{
 		std::scoped_lock lock(g_settingsMutex);
 		g_settings = Clamp(settings);
+		g_normalizeRegistration.store(g_settings.normalizeRegistration, std::memory_order_release);
+	}
+
+	bool IsRegistrationNormalized() noexcept
+	{
+		g_settingsReady.Wait();
+		return g_normalizeRegistration.load(std::memory_order_acquire);
 	}
 
 	Settings ClampSettings(const Settings& settings)
@@ -375,6 +390,16 @@ namespace CodexOfPowerNG
 		SetSettings(LoadFromDisk());
 	}
 
+	void LoadSettingsFromDiskAsync(Startup::WorkerPool& pool)
+	{
+		try {
+			g_settingsReady.Arm(pool.Submit("settings", []() { LoadSettingsFromDisk(); }));
+		} catch (const std::exception& e) {
+			SKSE::log::warn("Background settings load unavailable ({}); loading inline", e.what());
+			LoadSettingsFromDisk();
+		}
+	}
+
 	bool SaveSettingsToDisk()
 	{
 		const auto snapshot = GetSettings();
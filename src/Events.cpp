@@ -2,6 +2,7 @@
 
 #include "CodexOfPowerNG/Config.h"
 #include "CodexOfPowerNG/EventsNotifyGate.h"
+#include "CodexOfPowerNG/Inventory.h"
 #include "CodexOfPowerNG/L10n.h"
 #include "CodexOfPowerNG/NotifiedStateStore.h"
 #include "CodexOfPowerNG/Registration.h"
@@ -39,6 +40,17 @@ namespace CodexOfPowerNG::Events
 					return RE::BSEventNotifyControl::kContinue;
 				}
 
+				auto* player = RE::PlayerCharacter::GetSingleton();
+				if (!player) {
+					return RE::BSEventNotifyControl::kContinue;
+				}
+
+				const auto playerId = player->GetFormID();
+				if (event->oldContainer == playerId || event->newContainer == playerId) {
+					Inventory::InvalidatePlayerSnapshot();
+					Registration::MarkQuickRegisterItemDirty(event->baseObj);
+				}
+
 				const auto settings = GetSettings();
 				if (!settings.enableLootNotify) {
 					return RE::BSEventNotifyControl::kContinue;
@@ -66,26 +78,13 @@ namespace CodexOfPowerNG::Events
 					return RE::BSEventNotifyControl::kContinue;
 				}
 
-				auto* player = RE::PlayerCharacter::GetSingleton();
-				if (!player) {
-					return RE::BSEventNotifyControl::kContinue;
-				}
-
-				if (event->newContainer != player->GetFormID()) {
+				if (event->newContainer != playerId) {
 					return RE::BSEventNotifyControl::kContinue;
 				}
 
 				const auto baseId = event->baseObj;
 
-				if (!Registration::IsDiscoverable(baseId)) {
-					return RE::BSEventNotifyControl::kContinue;
-				}
-
-				if (Registration::IsRegistered(baseId)) {
-					return RE::BSEventNotifyControl::kContinue;
-				}
-
-				const auto regKeyId = Registration::GetRegisterKeyId(baseId);
+				const auto regKeyId = Registration::ResolveUnregisteredLootKey(baseId);
 				if (!regKeyId) {
 					return RE::BSEventNotifyControl::kContinue;
 				}
@@ -116,7 +115,25 @@ namespace CodexOfPowerNG::Events
 			}
 		};
 
+		// Equip state feeds the quick list's safe count; there is no container delta for it.
+		class EquipChangedSink final : public RE::BSTEventSink<RE::TESEquipEvent>
+		{
+		public:
+			RE::BSEventNotifyControl ProcessEvent(const RE::TESEquipEvent* event,
+				RE::BSTEventSource<RE::TESEquipEvent>* /*source*/) override
+			{
+				if (!event || !event->actor || !event->actor->IsPlayerRef()) {
+					return RE::BSEventNotifyControl::kContinue;
+				}
+
+				Inventory::InvalidatePlayerSnapshot();
+				Registration::MarkQuickRegisterItemDirty(event->baseObject);
+				return RE::BSEventNotifyControl::kContinue;
+			}
+		};
+
 		ContainerChangedSink g_containerChangedSink;
+		EquipChangedSink     g_equipChangedSink;
 		bool g_installed{ false };
 	}
 
@@ -133,7 +150,8 @@ namespace CodexOfPowerNG::Events
 		}
 
 		sources->AddEventSink<RE::TESContainerChangedEvent>(&g_containerChangedSink);
-		SKSE::log::info("Registered TESContainerChangedEvent sink");
+		sources->AddEventSink<RE::TESEquipEvent>(&g_equipChangedSink);
+		SKSE::log::info("Registered TESContainerChangedEvent/TESEquipEvent sinks");
 		g_installed = true;
 	}
 
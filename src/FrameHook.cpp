@@ -0,0 +1,43 @@
+#include "CodexOfPowerNG/FrameHook.h"
+
+#include "CodexOfPowerNG/TaskScheduler.h"
+
+#include <RE/Skyrim.h>
+#include <SKSE/SKSE.h>
+#include <SKSE/Logger.h>
+
+#include <cstdint>
+#include <exception>
+
+namespace CodexOfPowerNG::FrameHook
+{
+	namespace
+	{
+		// Main::Update calls an empty function once per frame on the main thread; the call site is
+		// redirected here and forwards to the original.
+		struct MainUpdate
+		{
+			static void Thunk()
+			{
+				Original();
+				TickMainTaskFrame();
+			}
+
+			static inline REL::Relocation<decltype(Thunk)> Original;
+		};
+	}
+
+	void Install() noexcept
+	{
+		try {
+			REL::Relocation<std::uintptr_t> target{ RELOCATION_ID(35565, 36564), REL::Relocate(0x748, 0xC26) };
+			SKSE::AllocTrampoline(14);
+			MainUpdate::Original = SKSE::GetTrampoline().write_call<5>(target.address(), MainUpdate::Thunk);
+			SKSE::log::info("Frame hook installed (Main::Update)");
+		} catch (const std::exception& e) {
+			SKSE::log::error("Frame hook install failed ({}); main tasks fall back to one budget per pump", e.what());
+		} catch (...) {
+			SKSE::log::error("Frame hook install failed; main tasks fall back to one budget per pump");
+		}
+	}
+}
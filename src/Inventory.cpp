@@ -1,9 +1,52 @@
 #include "CodexOfPowerNG/Inventory.h"
 
+#include "CodexOfPowerNG/TaskScheduler.h"
+
 #include <RE/Skyrim.h>
 
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
 namespace CodexOfPowerNG::Inventory
 {
+	namespace
+	{
+		// Nothing reports hotkey changes, so a shared snapshot is only reused within the main-task frame
+		// it was built in.
+		std::mutex                            g_snapshotMutex;
+		std::shared_ptr<const PlayerSnapshot> g_snapshot;
+		bool                                  g_snapshotProtectFavorites{ false };
+		std::uint64_t                         g_snapshotFrame{ 0 };
+
+		[[nodiscard]] std::shared_ptr<const PlayerSnapshot> BuildPlayerSnapshot(RE::PlayerCharacter& player, bool protectFavorites)
+		{
+			auto snapshot = std::make_shared<PlayerSnapshot>();
+
+			// GetItemCount runs this same counting walk for a single object; here it runs once for all of them.
+			const auto counts = player.GetInventoryCounts();
+			snapshot->Reserve(counts.size());
+			for (const auto& [object, count] : counts) {
+				if (object) {
+					snapshot->AddCount(object->GetFormID(), count);
+				}
+			}
+
+			if (auto* changes = player.GetInventoryChanges(); changes && changes->entryList) {
+				for (auto* entry : *changes->entryList) {
+					if (auto* obj = entry ? entry->GetObject() : nullptr) {
+						snapshot->AttachEntry(obj->GetFormID(), entry);
+					}
+				}
+			}
+
+			snapshot->SelectRemovals([protectFavorites](RE::InventoryEntryData& entry, std::int32_t totalCount) {
+				return SelectSafeRemoval(&entry, totalCount, protectFavorites);
+			});
+			return snapshot;
+		}
+	}
+
 	RemoveSelection SelectSafeRemoval(const RE::InventoryEntryData* entry, std::int32_t totalCount, bool protectFavorites) noexcept
 	{
 		RemoveSelection out{};
@@ -53,4 +96,28 @@ namespace CodexOfPowerNG::Inventory
 
 		return out;
 	}
+
+	std::shared_ptr<const PlayerSnapshot> GetPlayerSnapshot(RE::PlayerCharacter& player, bool protectFavorites)
+	{
+		const auto frame = CurrentMainTaskFrame();
+		std::scoped_lock lock(g_snapshotMutex);
+		if (g_snapshot && g_snapshotFrame == frame && g_snapshotProtectFavorites == protectFavorites) {
+			return g_snapshot;
+		}
+
+		auto snapshot = BuildPlayerSnapshot(player, protectFavorites);
+		g_snapshot = snapshot;
+		g_snapshotProtectFavorites = protectFavorites;
+		g_snapshotFrame = frame;
+		return snapshot;
+	}
+
+	void InvalidatePlayerSnapshot() noexcept
+	{
+		std::shared_ptr<const PlayerSnapshot> dropped;
+		{
+			std::scoped_lock lock(g_snapshotMutex);
+			dropped = std::move(g_snapshot);
+		}
+	}
 }
@@ -2,6 +2,7 @@
 
 #include "CodexOfPowerNG/Config.h"
 #include "CodexOfPowerNG/Constants.h"
+#include "CodexOfPowerNG/StartupPool.h"
 
 #include <RE/Skyrim.h>
 
@@ -13,6 +14,7 @@
 #include <nlohmann/json.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <filesystem>
 #include <fstream>
@@ -20,6 +22,7 @@
 #include <optional>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace CodexOfPowerNG::L10n
@@ -30,6 +33,18 @@ namespace CodexOfPowerNG::L10n
 		nlohmann::json g_lang;
 		std::string    g_langCode{ "en" };
 
+		std::atomic<std::uint64_t> g_languageGeneration{ 1 };
+
+		Startup::LoadGate g_ready;
+
+		void SetLanguageLocked(std::string code) noexcept
+		{
+			if (g_langCode != code) {
+				g_langCode = std::move(code);
+				g_languageGeneration.fetch_add(1, std::memory_order_acq_rel);
+			}
+		}
+
 		[[nodiscard]] std::string ToUpper(std::string value)
 		{
 			std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
@@ -94,45 +109,76 @@ namespace CodexOfPowerNG::L10n
 		}
 	}
 
-	void Load()
+	namespace
 	{
-		auto settings = GetSettings();
-		std::string desired = settings.languageOverride;
-		if (desired != "en" && desired != "ko") {
-			desired = DetectGameLanguage();
-		}
+		// `detectedLanguage` is used when the settings do not force en/ko.
+		void LoadWith(std::string detectedLanguage)
+		{
+			auto settings = GetSettings();
+			std::string desired = settings.languageOverride;
+			if (desired != "en" && desired != "ko") {
+				desired = std::move(detectedLanguage);
+			}
 
-		auto load = LoadJsonFile(LangPath(desired));
-		if (!load && desired != "en") {
-			desired = "en";
-			load = LoadJsonFile(LangPath(desired));
-		}
+			auto load = LoadJsonFile(LangPath(desired));
+			if (!load && desired != "en") {
+				desired = "en";
+				load = LoadJsonFile(LangPath(desired));
+			}
+
+			if (!load) {
+				SKSE::log::warn("No localization file found; using fallbacks only");
+				std::scoped_lock lock(g_mutex);
+				g_lang = nlohmann::json::object();
+				SetLanguageLocked(std::move(desired));
+				return;
+			}
 
-		if (!load) {
-			SKSE::log::warn("No localization file found; using fallbacks only");
 			std::scoped_lock lock(g_mutex);
-			g_lang = nlohmann::json::object();
-			g_langCode = desired;
-			return;
+			g_lang = std::move(*load);
+			SetLanguageLocked(std::move(desired));
 		}
+	}
 
-		std::scoped_lock lock(g_mutex);
-		g_lang = std::move(*load);
-		g_langCode = desired;
+	void Load()
+	{
+		const auto settings = GetSettings();
+		const bool forced = settings.languageOverride == "en" || settings.languageOverride == "ko";
+		LoadWith(forced ? std::string() : DetectGameLanguage());
+	}
+
+	void LoadAsync(Startup::WorkerPool& pool)
+	{
+		// INI settings are game state: read them here, not on the worker.
+		auto detected = DetectGameLanguage();
+		try {
+			g_ready.Arm(pool.Submit("lang", [detected]() { LoadWith(detected); }));
+		} catch (const std::exception& e) {
+			SKSE::log::warn("Background localization load unavailable ({}); loading inline", e.what());
+			LoadWith(std::move(detected));
+		}
 	}
 
 	std::string ActiveLanguage()
 	{
+		g_ready.Wait();
 		std::scoped_lock lock(g_mutex);
 		return g_langCode;
 	}
 
+	std::uint64_t LanguageGeneration() noexcept
+	{
+		g_ready.Wait();
+		return g_languageGeneration.load(std::memory_order_acquire);
+	}
+
 	std::string T(std::string_view dottedPath, std::string_view fallback)
 	{
 		if (dottedPath.empty()) {
 			return std::string(fallback);
 		}
 
+		g_ready.Wait();
 		std::scoped_lock lock(g_mutex);
 		const nlohmann::json* cur = &g_lang;
 		for (auto key : Split(dottedPath, '.')) {
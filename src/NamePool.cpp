@@ -0,0 +1,66 @@
+#include "CodexOfPowerNG/NamePool.h"
+
+#include "CodexOfPowerNG/L10n.h"
+
+#include <mutex>
+#include <string_view>
+
+namespace CodexOfPowerNG::NamePool
+{
+	namespace
+	{
+		// FormID 0 never names a form; it holds the localized placeholder.
+		inline constexpr RE::FormID kUnnamedKey = 0;
+
+		std::mutex                 g_mutex;
+		Ops::PoolState<RE::FormID> g_pool{};
+
+		[[nodiscard]] const RE::TESForm* PickNamedForm(
+			const RE::TESForm* primary,
+			const RE::TESForm* fallback,
+			std::string_view& outText) noexcept
+		{
+			for (const auto* form : { primary, fallback }) {
+				if (!form) {
+					continue;
+				}
+				if (const auto* name = form->GetName(); name && name[0] != '\0') {
+					outText = name;
+					return form;
+				}
+			}
+			return nullptr;
+		}
+
+		void SyncLanguageLocked()
+		{
+			const auto generation = L10n::LanguageGeneration();
+			if (g_pool.languageGeneration != generation) {
+				(void)Ops::SyncLanguage(g_pool, generation, NameCollation::LocaleFor(L10n::ActiveLanguage()));
+			}
+		}
+	}
+
+	NameRef Resolve(const RE::TESForm* primary, const RE::TESForm* fallback)
+	{
+		std::string_view text{};
+		const auto*      named = PickNamedForm(primary, fallback, text);
+
+		std::scoped_lock lock(g_mutex);
+		SyncLanguageLocked();
+		if (named) {
+			return Ops::Intern(g_pool, named->GetFormID(), text);
+		}
+
+		if (const auto it = g_pool.byKey.find(kUnnamedKey); it != g_pool.byKey.end()) {
+			return it->second;
+		}
+		return Ops::Intern(g_pool, kUnnamedKey, L10n::T("ui.unnamed", "(unnamed)"));
+	}
+
+	std::size_t Count() noexcept
+	{
+		std::scoped_lock lock(g_mutex);
+		return g_pool.byKey.size();
+	}
+}
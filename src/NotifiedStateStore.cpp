@@ -1,6 +1,7 @@
 #include "CodexOfPowerNG/NotifiedStateStore.h"
 
 #include "CodexOfPowerNG/NotifiedStateStoreOps.h"
+#include "CodexOfPowerNG/RegistrationLookup.h"
 #include "CodexOfPowerNG/State.h"
 
 #include <utility>
@@ -9,9 +10,8 @@ namespace CodexOfPowerNG::NotifiedStateStore
 {
 	bool ContainsAny(RE::FormID primaryId, RE::FormID secondaryId) noexcept
 	{
-		auto& state = GetState();
-		std::scoped_lock lock(state.mutex);
-		return Ops::ContainsAny(state.notifiedItems, primaryId, secondaryId);
+		// Queried for every looted item; served from the lock-free lookup snapshot.
+		return RegistrationLookup::IsNotifiedAny(primaryId, secondaryId);
 	}
 
 	void MarkPair(RE::FormID primaryId, RE::FormID secondaryId) noexcept
@@ -19,6 +19,8 @@ namespace CodexOfPowerNG::NotifiedStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		Ops::MarkPair(state.notifiedItems, primaryId, secondaryId);
+		state.saveGenerations.Bump(Serialization::SaveRecord::kNotified);
+		RegistrationLookup::NoteNotifiedLocked(primaryId, secondaryId);
 	}
 
 	void Clear() noexcept
@@ -26,16 +28,20 @@ namespace CodexOfPowerNG::NotifiedStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		state.notifiedItems.clear();
+		state.saveGenerations.Bump(Serialization::SaveRecord::kNotified);
+		RegistrationLookup::PublishLocked(state);
 	}
 
-	void ReplaceAll(std::unordered_set<RE::FormID> notifiedItems) noexcept
+	void ReplaceAll(Containers::FlatFormIdSet notifiedItems) noexcept
 	{
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		Ops::ReplaceAll(state.notifiedItems, std::move(notifiedItems));
+		state.saveGenerations.Bump(Serialization::SaveRecord::kNotified);
+		RegistrationLookup::PublishLocked(state);
 	}
 
-	std::unordered_set<RE::FormID> Snapshot() noexcept
+	Containers::FlatFormIdSet Snapshot() noexcept
 	{
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
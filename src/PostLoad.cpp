@@ -0,0 +1,223 @@
+#include "CodexOfPowerNG/PostLoad.h"
+
+#include "CodexOfPowerNG/TaskScheduler.h"
+
+#include <RE/Skyrim.h>
+
+#include <SKSE/Logger.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace CodexOfPowerNG::PostLoad
+{
+	namespace
+	{
+		// A pipeline that has not finished by then is given up so register/build/undo do not stay closed.
+		inline constexpr std::chrono::milliseconds kPipelineTimeout{ 60000 };
+
+		struct Run
+		{
+			std::uint64_t                         generation{ 0 };
+			StagePipeline<>                       pipeline;
+			std::uint32_t                         slices{ 0 };
+			ScheduledTask                         onReady;
+			std::chrono::steady_clock::time_point deadline{};
+		};
+
+		std::atomic<std::uint64_t> g_generation{ 1 };
+		std::atomic_bool           g_ready{ false };
+
+		[[nodiscard]] std::uint64_t BumpGeneration() noexcept
+		{
+			g_ready.store(false, std::memory_order_release);
+			return g_generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+		}
+
+		void LogTimings(const Run& run)
+		{
+			std::uint64_t workUs = 0;
+			std::uint64_t readyAtUs = 0;
+			for (const auto& timing : run.pipeline.Timings()) {
+				workUs += timing.runUs;
+				readyAtUs = (std::max)(readyAtUs, timing.finishedAtUs);
+			}
+			SKSE::log::info(
+				"Post-load pipeline ready: {:.2f} ms of work in {} slice(s), done {:.1f} ms after it started",
+				static_cast<double>(workUs) / 1000.0,
+				run.slices,
+				static_cast<double>(readyAtUs) / 1000.0);
+			for (const auto& timing : run.pipeline.Timings()) {
+				SKSE::log::info(
+					"  stage '{}': {:.2f} ms in {} slice(s), done at +{:.1f} ms",
+					timing.name,
+					static_cast<double>(timing.runUs) / 1000.0,
+					timing.slices,
+					static_cast<double>(timing.finishedAtUs) / 1000.0);
+			}
+		}
+
+		void NotifyReady(const ScheduledTask& onReady) noexcept
+		{
+			g_ready.store(true, std::memory_order_release);
+			try {
+				if (onReady) {
+					onReady();
+				}
+			} catch (const std::exception& e) {
+				SKSE::log::error("Post-load pipeline: ready callback failed: {}", e.what());
+			} catch (...) {
+				SKSE::log::error("Post-load pipeline: ready callback failed");
+			}
+		}
+
+		void MarkReady(const Run& run) noexcept
+		{
+			try {
+				LogTimings(run);
+			} catch (...) {}
+			NotifyReady(run.onReady);
+		}
+
+		// Opens the gated actions anyway; the state may be partly reconciled, which beats refusing them all session.
+		void GiveUp(const Run& run, std::string_view why) noexcept
+		{
+			SKSE::log::error(
+				"Post-load pipeline (generation {}): {} at stage '{}'; marking ready anyway",
+				run.generation,
+				why,
+				run.pipeline.CurrentStage());
+			MarkReady(run);
+		}
+
+		[[nodiscard]] TaskStep RunSlice(const std::shared_ptr<Run>& run, std::chrono::microseconds sliceBudget)
+		{
+			if (run->generation != CurrentGeneration()) {
+				SKSE::log::info(
+					"Post-load pipeline (generation {}) cancelled before stage '{}'",
+					run->generation,
+					run->pipeline.CurrentStage());
+				return TaskStep::kDone;
+			}
+
+			if (std::chrono::steady_clock::now() >= run->deadline) {
+				GiveUp(*run, "timed out");
+				return TaskStep::kDone;
+			}
+
+			++run->slices;
+			PipelineStep step{};
+			try {
+				step = run->pipeline.Run(sliceBudget);
+			} catch (const std::exception& e) {
+				SKSE::log::error("Post-load pipeline: stage '{}' threw: {}", run->pipeline.CurrentStage(), e.what());
+				GiveUp(*run, "stage failed");
+				return TaskStep::kDone;
+			} catch (...) {
+				GiveUp(*run, "stage failed");
+				return TaskStep::kDone;
+			}
+
+			switch (step) {
+			case PipelineStep::kYield:
+			case PipelineStep::kWait:
+				// Resumed next frame, so a waiting stage is polled once per frame.
+				return TaskStep::kYield;
+			case PipelineStep::kFinished:
+				break;
+			}
+
+			MarkReady(*run);
+			return TaskStep::kDone;
+		}
+
+		bool Schedule(std::shared_ptr<Run> run) noexcept
+		{
+			return QueueResumableMainTask(
+				[run = std::move(run)](std::chrono::microseconds sliceBudget) { return RunSlice(run, sliceBudget); },
+				TaskPriority::kBackground);
+		}
+	}
+
+	void Start(std::vector<Stage> stages, ScheduledTask onReady) noexcept
+	{
+		std::shared_ptr<Run> run;
+		try {
+			run = std::make_shared<Run>();
+			run->generation = BumpGeneration();
+			run->onReady = std::move(onReady);
+			run->deadline = std::chrono::steady_clock::now() + kPipelineTimeout;
+			for (auto& stage : stages) {
+				if (!run->pipeline.Add(std::move(stage.name), std::move(stage.after), std::move(stage.run))) {
+					SKSE::log::error("Post-load pipeline: duplicate or empty stage ignored");
+				}
+			}
+			if (!run->pipeline.Seal()) {
+				SKSE::log::error("Post-load pipeline: unknown stage dependency or cycle; nothing will run");
+				MarkReady(*run);
+				return;
+			}
+			if (Schedule(run)) {
+				return;
+			}
+
+			SKSE::log::warn("Post-load pipeline: main task queue unavailable; running stages inline");
+			PipelineStep step{};
+			do {
+				++run->slices;
+				step = run->pipeline.Run(kMainTaskFrameBudget);
+			} while (step == PipelineStep::kYield);
+			if (step == PipelineStep::kWait) {
+				GiveUp(*run, "cannot wait without the main task queue");
+				return;
+			}
+			MarkReady(*run);
+		} catch (const std::exception& e) {
+			SKSE::log::error("Post-load pipeline failed: {}; marking ready anyway", e.what());
+			NotifyReady(run ? run->onReady : ScheduledTask{});
+		} catch (...) {
+			SKSE::log::error("Post-load pipeline failed; marking ready anyway");
+			NotifyReady(run ? run->onReady : ScheduledTask{});
+		}
+	}
+
+	void Cancel() noexcept
+	{
+		(void)BumpGeneration();
+	}
+
+	bool IsReady() noexcept
+	{
+		return g_ready.load(std::memory_order_acquire);
+	}
+
+	std::uint64_t CurrentGeneration() noexcept
+	{
+		return g_generation.load(std::memory_order_acquire);
+	}
+
+	StageFn WaitForGameplay(std::chrono::milliseconds timeout)
+	{
+		return [timeout, since = std::optional<std::chrono::steady_clock::time_point>{}](std::chrono::microseconds) mutable {
+			const auto* main = RE::Main::GetSingleton();
+			if (RE::PlayerCharacter::GetSingleton() && main && main->gameActive) {
+				return StageStatus::kDone;
+			}
+
+			const auto now = std::chrono::steady_clock::now();
+			if (!since) {
+				since = now;
+			}
+			if (now - *since < timeout) {
+				return StageStatus::kWait;
+			}
+			SKSE::log::warn("Post-load pipeline: game still inactive after {} ms; continuing", timeout.count());
+			return StageStatus::kDone;
+		};
+	}
+}
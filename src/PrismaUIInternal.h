@@ -47,7 +47,7 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 	[[nodiscard]] json BuildSettingsPayload(const Settings& settings);
 	[[nodiscard]] json BuildRuntimeStatePayload();
-	void               SendJS(const char* fn, const json& payload) noexcept;
+	bool               SendJS(const char* fn, const json& payload) noexcept;
 	void               ShowToast(std::string_view level, std::string message) noexcept;
 	void               QueueSettingsSave(Settings settings, Settings fallbackSettings, bool reloadL10n) noexcept;
 	void               ShutdownSettingsWorker() noexcept;
@@ -0,0 +1,113 @@
+#include "PrismaUIPatch.h"
+
+#include "CodexOfPowerNG/UiPatchJson.h"
+#include "CodexOfPowerNG/UiPatchOps.h"
+
+#include <SKSE/Logger.h>
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+namespace CodexOfPowerNG::PrismaUIManager::Internal
+{
+	namespace
+	{
+		constexpr std::array<const char*, kPatchChannelCount> kChannelNames{
+			"state", "inventory", "build", "rewards", "undo"
+		};
+
+		constexpr std::array<std::string_view, kPatchChannelCount> kSnapshotFunctions{
+			"copng_setState", "copng_setInventory", "copng_setBuild", "copng_setRewards", "copng_setUndoList"
+		};
+
+		using PendingPatch = UiPatch::PendingPatch<json, kPatchChannelCount>;
+
+		std::mutex                                 g_patchMutex;
+		UiPatch::Journal<json, kPatchChannelCount> g_patchJournal{};
+
+		// Leaves the journal alone; `pending` carries the new baselines until the send succeeds.
+		[[nodiscard]] std::optional<json> BuildPatchLocked(PatchDocs& docs, PendingPatch& pending)
+		{
+			json channels = json::object();
+			for (std::size_t i = 0; i < kPatchChannelCount; ++i) {
+				auto& doc = docs[i];
+				if (!doc) {
+					continue;
+				}
+
+				const auto& baseline = g_patchJournal.baselines[i];
+				if (baseline && *baseline == *doc) {
+					continue;
+				}
+
+				json node;
+				if (baseline && UiPatch::DiffValue(*baseline, *doc, node)) {
+					channels[kChannelNames[i]] = json{ { "patch", std::move(node) } };
+				} else {
+					channels[kChannelNames[i]] = json{ { "full", *doc } };
+				}
+				pending.baselines[i] = std::move(*doc);
+			}
+
+			if (channels.empty()) {
+				return std::nullopt;
+			}
+
+			UiPatch::Begin(g_patchJournal, pending);
+			return json{
+				{ "base", pending.base },
+				{ "generation", pending.base + 1 },
+				{ "reset", pending.base == 0 },
+				{ "channels", std::move(channels) },
+			};
+		}
+	}
+
+	void NoteSnapshotSent(std::string_view fn, const json& payload) noexcept
+	{
+		const auto it = std::find(kSnapshotFunctions.begin(), kSnapshotFunctions.end(), fn);
+		if (it == kSnapshotFunctions.end()) {
+			return;
+		}
+
+		try {
+			std::scoped_lock lock(g_patchMutex);
+			UiPatch::Record(g_patchJournal, static_cast<std::size_t>(it - kSnapshotFunctions.begin()), payload);
+		} catch (const std::exception& e) {
+			SKSE::log::warn("UI patch: failed to record snapshot for '{}': {}", fn, e.what());
+			ResetPatchJournal();
+		}
+	}
+
+	void ResetPatchJournal() noexcept
+	{
+		std::scoped_lock lock(g_patchMutex);
+		UiPatch::Reset(g_patchJournal);
+	}
+
+	void SendPatch(PatchDocs docs) noexcept
+	{
+		std::optional<json> message;
+		PendingPatch        pending{};
+		try {
+			std::scoped_lock lock(g_patchMutex);
+			message = BuildPatchLocked(docs, pending);
+		} catch (const std::exception& e) {
+			SKSE::log::error("UI patch: diff failed ({}); view will be reseeded", e.what());
+			ResetPatchJournal();
+			return;
+		}
+
+		// An undelivered patch must not move the baselines, or the next diff is against state the view never saw.
+		if (!message || !SendJS("copng_applyPatch", *message)) {
+			return;
+		}
+
+		std::scoped_lock lock(g_patchMutex);
+		if (!UiPatch::Commit(g_patchJournal, pending)) {
+			SKSE::log::info("UI patch: journal reset while generation {} was in flight", pending.base + 1);
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "PrismaUIInternal.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace CodexOfPowerNG::PrismaUIManager::Internal
+{
+	// View state mirrored by copng_applyPatch. Each channel also has a full-snapshot function
+	// (copng_setState, ...) whose payloads seed the patch baselines.
+	enum class PatchChannel : std::uint8_t
+	{
+		kState,
+		kInventory,
+		kBuild,
+		kRewards,
+		kUndo,
+	};
+
+	inline constexpr std::size_t kPatchChannelCount = 5;
+
+	[[nodiscard]] constexpr std::size_t ChannelIndex(PatchChannel channel) noexcept
+	{
+		return static_cast<std::size_t>(channel);
+	}
+
+	using PatchDocs = std::array<std::optional<json>, kPatchChannelCount>;
+
+	// Records `payload` as the view's baseline when `fn` is a channel's full-snapshot function.
+	void NoteSnapshotSent(std::string_view fn, const json& payload) noexcept;
+
+	// Forgets every baseline; the next patch re-seeds the view with full documents.
+	void ResetPatchJournal() noexcept;
+
+	// Diffs the present channels against their baselines and sends one copng_applyPatch (UI thread).
+	void SendPatch(PatchDocs docs) noexcept;
+}
@@ -6,6 +6,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <string_view>
@@ -21,8 +22,15 @@ namespace CodexOfPowerNG::PrismaUIPayloads
 		std::uint32_t pageSize,
 		Registration::QuickRegisterList& pageData) noexcept;
 
-	[[nodiscard]] json BuildRegisteredPayload(
-		const std::vector<Registration::ListItem>& items) noexcept;
+	// Full-list page for copng_setRegisteredPage: rows [offset, offset + limit) of `update.items`.
+	[[nodiscard]] json BuildRegisteredPagePayload(
+		const Registration::RegisteredListUpdate& update,
+		std::size_t offset,
+		std::size_t limit) noexcept;
+
+	// Ordered splices for copng_setRegisteredDelta.
+	[[nodiscard]] json BuildRegisteredDeltaPayload(
+		const Registration::RegisteredListUpdate& update) noexcept;
 
 	[[nodiscard]] json BuildUndoPayload(
 		const std::vector<Registration::UndoListItem>& items) noexcept;
@@ -33,5 +41,10 @@ namespace CodexOfPowerNG::PrismaUIPayloads
 		const std::vector<std::pair<RE::ActorValue, float>>& totals,
 		bool useL10n) noexcept;
 
+	[[nodiscard]] json BuildRewardsPayload(
+		std::size_t registeredCount,
+		const std::vector<std::pair<RE::ActorValue, float>>& totals,
+		bool useL10n) noexcept;
+
 	[[nodiscard]] std::string FormatReward(float total, std::string_view fmt) noexcept;
 }
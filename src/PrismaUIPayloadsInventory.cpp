@@ -1,5 +1,7 @@
 #include "PrismaUIPayloads.h"
 
+#include <algorithm>
+
 namespace CodexOfPowerNG::PrismaUIPayloads
 {
 	namespace
@@ -22,7 +24,8 @@ namespace CodexOfPowerNG::PrismaUIPayloads
 			json* currentSection = nullptr;
 			std::string_view currentDiscipline{};
 
-			for (const auto& it : pageData.items) {
+			for (const auto& ref : pageData.items) {
+				const auto& it = *ref;
 				const auto discipline = std::string_view{ GroupToDiscipline(it.group) };
 				if (!currentSection || currentDiscipline != discipline) {
 					sections.push_back({
@@ -38,7 +41,7 @@ namespace CodexOfPowerNG::PrismaUIPayloads
 				(*currentSection)["rows"].push_back({
 					{ "formId", it.formId },
 					{ "regKey", it.regKey },
-					{ "name", it.name },
+					{ "name", NamePool::TextOf(it.name) },
 					{ "group", it.group },
 					{ "groupName", Registration::GetDiscoveryGroupName(it.group) },
 					{ "discipline", discipline },
@@ -53,6 +56,16 @@ namespace CodexOfPowerNG::PrismaUIPayloads
 
 			return sections;
 		}
+
+		[[nodiscard]] json BuildRegisteredRow(const Registration::ListItem& it) noexcept
+		{
+			return {
+				{ "formId", it.formId },
+				{ "name", NamePool::TextOf(it.name) },
+				{ "group", it.group },
+				{ "groupName", Registration::GetDiscoveryGroupName(it.group) },
+			};
+		}
 	}
 
 	json BuildInventoryPayload(
@@ -67,11 +80,12 @@ namespace CodexOfPowerNG::PrismaUIPayloads
 		payload["hasMore"] = pageData.hasMore;
 
 		json arr = json::array();
-		for (const auto& it : pageData.items) {
+		for (const auto& ref : pageData.items) {
+			const auto& it = *ref;
 			arr.push_back({
 				{ "formId", it.formId },
 				{ "regKey", it.regKey },
-				{ "name", it.name },
+				{ "name", NamePool::TextOf(it.name) },
 				{ "group", it.group },
 				{ "groupName", Registration::GetDiscoveryGroupName(it.group) },
 				{ "totalCount", it.totalCount },
@@ -85,18 +99,52 @@ namespace CodexOfPowerNG::PrismaUIPayloads
 		return payload;
 	}
 
-	json BuildRegisteredPayload(const std::vector<Registration::ListItem>& items) noexcept
+	json BuildRegisteredPagePayload(
+		const Registration::RegisteredListUpdate& update,
+		std::size_t offset,
+		std::size_t limit) noexcept
 	{
+		const auto total = update.items.size();
+		const auto begin = (std::min)(offset, total);
+		const auto end = begin + (std::min)(limit, total - begin);
+
 		json arr = json::array();
-		for (const auto& it : items) {
-			arr.push_back({
-				{ "formId", it.formId },
-				{ "name", it.name },
-				{ "group", it.group },
-				{ "groupName", Registration::GetDiscoveryGroupName(it.group) },
-			});
+		for (auto i = begin; i < end; ++i) {
+			arr.push_back(BuildRegisteredRow(*update.items[i]));
 		}
-		return arr;
+
+		json payload;
+		payload["version"] = update.version;
+		payload["total"] = total;
+		payload["offset"] = begin;
+		payload["items"] = std::move(arr);
+		return payload;
+	}
+
+	json BuildRegisteredDeltaPayload(const Registration::RegisteredListUpdate& update) noexcept
+	{
+		json changes = json::array();
+		for (const auto& change : update.changes) {
+			if (change.removed) {
+				changes.push_back({
+					{ "op", "remove" },
+					{ "index", change.index },
+					{ "formId", change.item->formId },
+				});
+			} else {
+				changes.push_back({
+					{ "op", "insert" },
+					{ "index", change.index },
+					{ "row", BuildRegisteredRow(*change.item) },
+				});
+			}
+		}
+
+		json payload;
+		payload["fromVersion"] = update.fromVersion;
+		payload["version"] = update.version;
+		payload["changes"] = std::move(changes);
+		return payload;
 	}
 
 	json BuildUndoPayload(const std::vector<Registration::UndoListItem>& items) noexcept
@@ -107,9 +155,10 @@ namespace CodexOfPowerNG::PrismaUIPayloads
 				{ "actionId", it.actionId },
 				{ "formId", it.formId },
 				{ "regKey", it.regKey },
-				{ "name", it.name },
+				{ "name", NamePool::TextOf(it.name) },
 				{ "group", it.group },
 				{ "groupName", Registration::GetDiscoveryGroupName(it.group) },
+				{ "itemCount", it.itemCount },
 				{ "canUndo", it.canUndo },
 				{ "hasRewardDelta", it.hasRewardDelta },
 			});
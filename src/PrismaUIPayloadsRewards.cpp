@@ -1,5 +1,6 @@
 #include "PrismaUIPayloads.h"
 
+#include "CodexOfPowerNG/Config.h"
 #include "CodexOfPowerNG/L10n.h"
 
 #include <array>
@@ -113,4 +114,24 @@ namespace CodexOfPowerNG::PrismaUIPayloads
 		}
 		return arr;
 	}
+
+	json BuildRewardsPayload(
+		std::size_t registeredCount,
+		const std::vector<std::pair<RE::ActorValue, float>>& totals,
+		bool useL10n) noexcept
+	{
+		const auto settings = GetSettings();
+		const auto every = settings.rewardEvery > 0 ? settings.rewardEvery : 0;
+		const auto rolls = (every > 0) ?
+			                   static_cast<std::int32_t>(registeredCount / static_cast<std::size_t>(every)) :
+			                   0;
+
+		json j;
+		j["registeredCount"] = registeredCount;
+		j["rewardEvery"] = every;
+		j["rewardMultiplier"] = settings.rewardMultiplier;
+		j["rolls"] = rolls;
+		j["totals"] = BuildRewardTotalsArray(totals, useL10n);
+		return j;
+	}
 }
@@ -3,21 +3,25 @@
 #include "CodexOfPowerNG/BuildEffectRuntime.h"
 #include "CodexOfPowerNG/BuildStateStore.h"
 #include "CodexOfPowerNG/Config.h"
+#include "CodexOfPowerNG/PostLoad.h"
 #include "CodexOfPowerNG/PrismaUIManager.h"
 #include "CodexOfPowerNG/Registration.h"
 #include "CodexOfPowerNG/RegistrationStateStore.h"
 #include "CodexOfPowerNG/Rewards.h"
 #include "CodexOfPowerNG/TaskScheduler.h"
+#include "PrismaUIPatch.h"
 #include "PrismaUIPayloads.h"
 
 #include <SKSE/Logger.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <charconv>
 #include <chrono>
 #include <cstdint>
 #include <exception>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -28,10 +32,16 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 {
 	namespace
 	{
+		// Rows per copng_setRegisteredPage message when the view needs the full registered list.
+		inline constexpr std::size_t kRegisteredPageSize = 500;
+
 		std::mutex       g_inventoryRequestMutex;
 		InventoryRequest g_lastInventoryRequest{};
 		std::atomic_bool g_refreshPending{ false };
 
+		// Registered-list version last shipped to the view; native-initiated refreshes diff against it.
+		std::atomic<std::uint64_t> g_registeredViewVersion{ 0 };
+
 		void RememberInventoryRequest(InventoryRequest req) noexcept
 		{
 			req.pageSize = std::clamp(req.pageSize, std::uint32_t{ 1 }, std::uint32_t{ 500 });
@@ -61,14 +71,27 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 			return std::nullopt;
 		}
 
+		struct RewardStateSnapshot
+		{
+			std::size_t                                   registeredCount{ 0 };
+			std::vector<std::pair<RE::ActorValue, float>> totals{};
+		};
+
+		[[nodiscard]] RewardStateSnapshot SnapshotRewardState()
+		{
+			return RewardStateSnapshot{ RegistrationStateStore::RegisteredCount(), Rewards::SnapshotRewardTotals() };
+		}
+
 		void RefreshUIAfterMutation() noexcept
 		{
-			SendStateToUI();
-			QueueSendInventory(SnapshotLastInventoryRequest());
 			QueueSendRegistered();
-			QueueSendBuild();
-			QueueSendRewards();
-			QueueSendUndoList();
+			QueueSendPatch({
+				PatchChannel::kState,
+				PatchChannel::kInventory,
+				PatchChannel::kBuild,
+				PatchChannel::kRewards,
+				PatchChannel::kUndo,
+			});
 		}
 
 		[[nodiscard]] bool IsCombatLockedForBuildMutation() noexcept
@@ -77,6 +100,20 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 			return player && player->IsInCombat();
 		}
 
+		// Register/build/undo mutate state the post-load migration and effect resync still own.
+		[[nodiscard]] bool RejectUntilPostLoadReady(const char* context) noexcept
+		{
+			if (PostLoad::IsReady()) {
+				return false;
+			}
+			SKSE::log::info(
+				"{}: rejected while post-load pipeline (generation {}) is running",
+				context,
+				PostLoad::CurrentGeneration());
+			ShowToast("error", "Still loading. Try again in a moment.");
+			return true;
+		}
+
 		void PresentRegisterResult(const Registration::RegisterResult& res) noexcept
 		{
 			SKSE::log::info(
@@ -112,6 +149,27 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 				"{}: main task queue unavailable; request dropped (pending refresh marked)",
 				context ? context : "Request");
 		}
+
+		TaskStep RunRegisterBatchSlice(
+			const std::shared_ptr<Registration::RegisterBatchJob>& job,
+			std::chrono::microseconds                              sliceBudget)
+		{
+			if (!Registration::TryRegisterBatch(*job, sliceBudget)) {
+				return TaskStep::kYield;
+			}
+
+			(void)QueueUITask([job]() {
+				const auto level = job->registered > 0u ? "info" : "error";
+				auto message = std::string("Registered ") + std::to_string(job->registered) + " / " +
+				               std::to_string(job->formIds.size());
+				if (!job->lastMessage.empty()) {
+					message += " (" + job->lastMessage + ")";
+				}
+				ShowToast(level, std::move(message));
+				RefreshUIAfterMutation();
+			});
+			return TaskStep::kDone;
+		}
 	}
 
 	void FlushPendingUIRefresh() noexcept
@@ -157,6 +215,23 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 		return out;
 	}
 
+	std::uint64_t ParseRegisteredRequestVersion(const char* argument) noexcept
+	{
+		const auto payloadOpt = ParseJsonPayload(argument, "Registered request JSON");
+		if (!payloadOpt || !payloadOpt->is_object()) {
+			return 0;
+		}
+
+		try {
+			if (auto it = payloadOpt->find("version"); it != payloadOpt->end() && it->is_number_unsigned()) {
+				return it->get<std::uint64_t>();
+			}
+		} catch (const json::exception& e) {
+			SKSE::log::warn("Registered request field parse error: {}", e.what());
+		}
+		return 0;
+	}
+
 	std::optional<RE::FormID> ParseFormIDFromJson(const json& j) noexcept
 	{
 		try {
@@ -233,7 +308,7 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 	{
 		RememberInventoryRequest(req);
 
-		if (QueueMainTask([req]() {
+		if (QueueCoalescedMainTask("ui.inventory", [req]() {
 				const auto tBuild0 = std::chrono::steady_clock::now();
 				const auto offset = static_cast<std::size_t>(req.page) * static_cast<std::size_t>(req.pageSize);
 				auto page = Registration::BuildQuickRegisterList(offset, req.pageSize);
@@ -273,10 +348,37 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 	void QueueSendRegistered() noexcept
 	{
-		if (QueueMainTask([]() {
-				auto items = Registration::BuildRegisteredList();
-				(void)QueueUITask([items = std::move(items)]() mutable {
-					SendJS("copng_setRegistered", PrismaUIPayloads::BuildRegisteredPayload(items));
+		QueueSendRegistered(g_registeredViewVersion.load(std::memory_order_acquire));
+	}
+
+	void QueueSendRegistered(std::uint64_t knownVersion) noexcept
+	{
+		if (QueueMainTask([knownVersion]() {
+				auto update = Registration::BuildRegisteredListUpdate(knownVersion);
+				if (!update.full && update.changes.empty()) {
+					g_registeredViewVersion.store(update.version, std::memory_order_release);
+					return;
+				}
+
+				(void)QueueUITask([update = std::move(update)]() {
+					// Only a delivered list becomes the diff base; a dropped call leaves the old version.
+					if (!update.full) {
+						if (SendJS("copng_setRegisteredDelta", PrismaUIPayloads::BuildRegisteredDeltaPayload(update))) {
+							g_registeredViewVersion.store(update.version, std::memory_order_release);
+						}
+						return;
+					}
+
+					std::size_t offset = 0;
+					do {
+						if (!SendJS(
+								"copng_setRegisteredPage",
+								PrismaUIPayloads::BuildRegisteredPagePayload(update, offset, kRegisteredPageSize))) {
+							return;
+						}
+						offset += kRegisteredPageSize;
+					} while (offset < update.items.size());
+					g_registeredViewVersion.store(update.version, std::memory_order_release);
 				});
 			})) {
 			return;
@@ -287,34 +389,12 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 	void QueueSendRewards() noexcept
 	{
-		auto gatherRewardState = []() {
-			const auto registeredCount = RegistrationStateStore::RegisteredCount();
-			auto totals = Rewards::SnapshotRewardTotals();
-			return std::make_pair(registeredCount, std::move(totals));
-		};
-
-		auto buildRewardsJson = [](std::size_t registeredCount,
-		                           std::vector<std::pair<RE::ActorValue, float>>& totals,
-		                           bool useL10n) {
-			const auto settings = GetSettings();
-			const auto every = settings.rewardEvery > 0 ? settings.rewardEvery : 0;
-			const auto rolls = (every > 0) ?
-				                   static_cast<std::int32_t>(registeredCount / static_cast<std::size_t>(every)) :
-				                   0;
-
-			json j;
-			j["registeredCount"] = registeredCount;
-			j["rewardEvery"] = every;
-			j["rewardMultiplier"] = settings.rewardMultiplier;
-			j["rolls"] = rolls;
-			j["totals"] = PrismaUIPayloads::BuildRewardTotalsArray(totals, useL10n);
-			return j;
-		};
-
-		if (QueueMainTask([gatherRewardState, buildRewardsJson]() {
-				auto [registeredCount, totals] = gatherRewardState();
-				(void)QueueUITask([registeredCount, totals = std::move(totals), buildRewardsJson]() mutable {
-					SendJS("copng_setRewards", buildRewardsJson(registeredCount, totals, true));
+		if (QueueCoalescedMainTask("ui.rewards", []() {
+				auto rewards = SnapshotRewardState();
+				(void)QueueUITask([rewards = std::move(rewards)]() {
+					SendJS(
+						"copng_setRewards",
+						PrismaUIPayloads::BuildRewardsPayload(rewards.registeredCount, rewards.totals, true));
 				});
 			})) {
 			return;
@@ -325,7 +405,7 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 	void QueueSendBuild() noexcept
 	{
-		if (QueueMainTask([]() {
+		if (QueueCoalescedMainTask("ui.build", []() {
 				auto payload = PrismaUIPayloads::BuildBuildPayload();
 				(void)QueueUITask([payload = std::move(payload)]() mutable {
 					SendJS("copng_setBuild", payload);
@@ -339,7 +419,7 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 	void QueueSendUndoList() noexcept
 	{
-		if (QueueMainTask([]() {
+		if (QueueCoalescedMainTask("ui.undo", []() {
 				auto items = Registration::BuildRecentUndoList();
 				(void)QueueUITask([items = std::move(items)]() mutable {
 					SendJS("copng_setUndoList", PrismaUIPayloads::BuildUndoPayload(items));
@@ -351,14 +431,88 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 		ReportMainTaskQueueUnavailable("Undo list");
 	}
 
+	void QueueSendPatch(std::initializer_list<PatchChannel> channels) noexcept
+	{
+		std::array<bool, kPatchChannelCount> wanted{};
+		for (const auto channel : channels) {
+			wanted[ChannelIndex(channel)] = true;
+		}
+		const auto req = SnapshotLastInventoryRequest();
+
+		if (QueueMainTask([wanted, req]() {
+				const auto want = [&wanted](PatchChannel channel) { return wanted[ChannelIndex(channel)]; };
+
+				std::optional<Registration::QuickRegisterList> inventory;
+				if (want(PatchChannel::kInventory)) {
+					const auto offset = static_cast<std::size_t>(req.page) * static_cast<std::size_t>(req.pageSize);
+					inventory = Registration::BuildQuickRegisterList(offset, req.pageSize);
+				}
+				std::optional<json> build;
+				if (want(PatchChannel::kBuild)) {
+					build = PrismaUIPayloads::BuildBuildPayload();
+				}
+				std::optional<RewardStateSnapshot> rewards;
+				if (want(PatchChannel::kRewards)) {
+					rewards = SnapshotRewardState();
+				}
+				std::optional<std::vector<Registration::UndoListItem>> undo;
+				if (want(PatchChannel::kUndo)) {
+					undo = Registration::BuildRecentUndoList();
+				}
+
+				(void)QueueUITask([wanted,
+				                   req,
+				                   inventory = std::move(inventory),
+				                   build = std::move(build),
+				                   rewards = std::move(rewards),
+				                   undo = std::move(undo)]() mutable {
+					PatchDocs docs{};
+					if (wanted[ChannelIndex(PatchChannel::kState)]) {
+						docs[ChannelIndex(PatchChannel::kState)] = BuildRuntimeStatePayload();
+					}
+					if (inventory) {
+						docs[ChannelIndex(PatchChannel::kInventory)] =
+							PrismaUIPayloads::BuildInventoryPayload(req.page, req.pageSize, *inventory);
+					}
+					if (build) {
+						docs[ChannelIndex(PatchChannel::kBuild)] = std::move(*build);
+					}
+					if (rewards) {
+						docs[ChannelIndex(PatchChannel::kRewards)] =
+							PrismaUIPayloads::BuildRewardsPayload(rewards->registeredCount, rewards->totals, true);
+					}
+					if (undo) {
+						docs[ChannelIndex(PatchChannel::kUndo)] = PrismaUIPayloads::BuildUndoPayload(*undo);
+					}
+					SendPatch(std::move(docs));
+				});
+			})) {
+			return;
+		}
+
+		ReportMainTaskQueueUnavailable("UI patch");
+	}
+
+	void HandlePatchResyncRequest() noexcept
+	{
+		SKSE::log::info("UI patch: view requested a full resync");
+		ResetPatchJournal();
+		QueueSendPatch({
+			PatchChannel::kState,
+			PatchChannel::kInventory,
+			PatchChannel::kBuild,
+			PatchChannel::kRewards,
+			PatchChannel::kUndo,
+		});
+	}
+
 	void HandleRefundRewardsRequest() noexcept
 	{
 		if (QueueMainTask([]() {
 				const auto cleared = Rewards::RefundRewards();
 				(void)QueueUITask([cleared]() {
 					ShowToast("info", "Rewards refunded (" + std::to_string(cleared) + ")");
-					SendStateToUI();
-					QueueSendRewards();
+					QueueSendPatch({ PatchChannel::kState, PatchChannel::kRewards });
 				});
 			})) {
 			return;
@@ -370,6 +524,10 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 	void HandleRegisterItemRequest(const char* argument) noexcept
 	{
+		if (RejectUntilPostLoadReady("Register item")) {
+			return;
+		}
+
 		const auto payloadOpt = ParseJsonPayload(argument, "Register item payload");
 		if (!payloadOpt) {
 			ShowToast("error", "Invalid JSON");
@@ -412,41 +570,27 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 	void HandleRegisterBatchRequest(const char* argument) noexcept
 	{
+		if (RejectUntilPostLoadReady("Register batch")) {
+			return;
+		}
+
 		const auto payloadOpt = ParseJsonPayload(argument, "Register batch payload");
 		if (!payloadOpt) {
 			ShowToast("error", "Invalid JSON");
 			return;
 		}
 
-		const auto requestOpt = ParseRegisterBatchRequest(*payloadOpt);
+		auto requestOpt = ParseRegisterBatchRequest(*payloadOpt);
 		if (!requestOpt.has_value()) {
 			ShowToast("error", "Invalid register batch payload");
 			return;
 		}
 
-		const auto request = *requestOpt;
-		if (QueueMainTask([request]() {
-				std::size_t successCount = 0u;
-				std::string lastMessage;
-				for (const auto formId : request.formIds) {
-					const auto result = Registration::TryRegisterItem(formId);
-					if (result.success) {
-						++successCount;
-					}
-					lastMessage = result.message;
-				}
-
-				(void)QueueUITask([request, successCount, lastMessage = std::move(lastMessage)]() mutable {
-					const auto level = successCount > 0u ? "info" : "error";
-					auto message = std::string("Registered ") + std::to_string(successCount) + " / " +
-					               std::to_string(request.formIds.size());
-					if (!lastMessage.empty()) {
-						message += " (" + lastMessage + ")";
-					}
-					ShowToast(level, std::move(message));
-					RefreshUIAfterMutation();
-				});
-			})) {
+		auto job = std::make_shared<Registration::RegisterBatchJob>();
+		job->formIds = std::move(requestOpt->formIds);
+		if (QueueResumableMainTask(
+				[job](std::chrono::microseconds sliceBudget) { return RunRegisterBatchSlice(job, sliceBudget); },
+				TaskPriority::kNormal)) {
 			return;
 		}
 
@@ -456,6 +600,10 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 	void HandleActivateBuildOptionRequest(const char* argument) noexcept
 	{
+		if (RejectUntilPostLoadReady("Activate build option")) {
+			return;
+		}
+
 		const auto payloadOpt = ParseJsonPayload(argument, "Build activate payload");
 		if (!payloadOpt) {
 			ShowToast("error", "Invalid JSON");
@@ -482,8 +630,7 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 				}
 				(void)QueueUITask([applied]() {
 					ShowToast(applied ? "info" : "error", applied ? "Build option activated" : "Build option unavailable");
-					SendStateToUI();
-					QueueSendBuild();
+					QueueSendPatch({ PatchChannel::kState, PatchChannel::kBuild });
 				});
 			})) {
 			return;
@@ -495,6 +642,10 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 	void HandleDeactivateBuildOptionRequest(const char* argument) noexcept
 	{
+		if (RejectUntilPostLoadReady("Deactivate build option")) {
+			return;
+		}
+
 		const auto payloadOpt = ParseJsonPayload(argument, "Build deactivate payload");
 		if (!payloadOpt) {
 			ShowToast("error", "Invalid JSON");
@@ -519,8 +670,7 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 				BuildEffectRuntime::SyncCurrentBuildEffectsToPlayer();
 				(void)QueueUITask([]() {
 					ShowToast("info", "Build option deactivated");
-					SendStateToUI();
-					QueueSendBuild();
+					QueueSendPatch({ PatchChannel::kState, PatchChannel::kBuild });
 				});
 			})) {
 			return;
@@ -532,6 +682,10 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 	void HandleSwapBuildOptionRequest(const char* argument) noexcept
 	{
+		if (RejectUntilPostLoadReady("Swap build option")) {
+			return;
+		}
+
 		const auto payloadOpt = ParseJsonPayload(argument, "Build swap payload");
 		if (!payloadOpt) {
 			ShowToast("error", "Invalid JSON");
@@ -566,8 +720,7 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 				(void)QueueUITask([applied]() {
 					ShowToast(applied ? "info" : "error", applied ? "Build option swapped" : "Build option swap failed");
-					SendStateToUI();
-					QueueSendBuild();
+					QueueSendPatch({ PatchChannel::kState, PatchChannel::kBuild });
 				});
 			})) {
 			return;
@@ -579,6 +732,10 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 	void HandleUndoRegisterRequest(const char* argument) noexcept
 	{
+		if (RejectUntilPostLoadReady("Undo register")) {
+			return;
+		}
+
 		const auto payloadOpt = ParseJsonPayload(argument, "Undo payload");
 		if (!payloadOpt) {
 			ShowToast("error", "Invalid JSON");
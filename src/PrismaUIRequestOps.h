@@ -1,11 +1,13 @@
 #pragma once
 
 #include "PrismaUIInternal.h"
+#include "PrismaUIPatch.h"
 
 #include "CodexOfPowerNG/BuildTypes.h"
 
 #include <RE/Skyrim.h>
 
+#include <initializer_list>
 #include <optional>
 #include <string>
 #include <vector>
@@ -49,6 +51,8 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 	};
 
 	[[nodiscard]] InventoryRequest ParseInventoryRequest(const char* argument) noexcept;
+	// Version of the registered list the view already holds (`{ "version": N }`; 0 when absent).
+	[[nodiscard]] std::uint64_t ParseRegisteredRequestVersion(const char* argument) noexcept;
 	[[nodiscard]] std::optional<RE::FormID> ParseFormIDFromJson(const json& j) noexcept;
 	[[nodiscard]] std::optional<std::uint64_t> ParseActionIdFromJson(const json& j) noexcept;
 	[[nodiscard]] std::optional<Builds::BuildSlotId> ParseBuildSlotId(std::string_view raw) noexcept;
@@ -60,11 +64,15 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 	void QueueSendInventory(InventoryRequest req) noexcept;
 	void QueueSendRegistered() noexcept;
+	void QueueSendRegistered(std::uint64_t knownVersion) noexcept;
 	void QueueSendRewards() noexcept;
 	void QueueSendBuild() noexcept;
 	void QueueSendUndoList() noexcept;
+	// Rebuilds the listed channels and ships whatever changed as one copng_applyPatch.
+	void QueueSendPatch(std::initializer_list<PatchChannel> channels) noexcept;
 	void FlushPendingUIRefresh() noexcept;
 
+	void HandlePatchResyncRequest() noexcept;
 	void HandleRefundRewardsRequest() noexcept;
 	void HandleRegisterItemRequest(const char* argument) noexcept;
 	void HandleRequestBuild() noexcept;
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <optional>
 #include <string_view>
+#include <unordered_set>
 
 namespace CodexOfPowerNG::PrismaUIManager::Internal
 {
@@ -184,12 +185,18 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 
 		RegisterBatchRequest request{};
 		request.formIds.reserve(formIdsIt->size());
+		// A repeated id would be planned again against an inventory entry the earlier registration
+		// in the same slice may already have removed, so only its first occurrence is kept.
+		std::unordered_set<RE::FormID> seen;
+		seen.reserve(formIdsIt->size());
 		for (const auto& rawValue : *formIdsIt) {
 			const auto formId = ParseBatchFormId(rawValue);
 			if (!formId.has_value() || formId.value() == 0u) {
 				return std::nullopt;
 			}
-			request.formIds.push_back(formId.value());
+			if (seen.insert(formId.value()).second) {
+				request.formIds.push_back(formId.value());
+			}
 		}
 
 		if (request.formIds.empty()) {
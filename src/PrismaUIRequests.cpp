@@ -39,11 +39,12 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 			QueueSendInventory(ParseInventoryRequest(argument));
 		}
 
-		void OnJsRequestRegistered(const char* /*argument*/) noexcept
+		void OnJsRequestRegistered(const char* argument) noexcept
 		{
 			FlushPendingUIRefresh();
-			SKSE::log::info("JS requested registered list");
-			QueueSendRegistered();
+			const auto knownVersion = ParseRegisteredRequestVersion(argument);
+			SKSE::log::info("JS requested registered list (view version {})", knownVersion);
+			QueueSendRegistered(knownVersion);
 		}
 
 		void OnJsRequestRewards(const char* /*argument*/) noexcept
@@ -108,6 +109,11 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 		{
 			HandleUndoRegisterRequest(argument);
 		}
+
+		void OnJsRequestPatchResync(const char* /*argument*/) noexcept
+		{
+			HandlePatchResyncRequest();
+		}
 	}
 
 	void RegisterCoreJSListeners(PRISMA_UI_API::IVPrismaUI1* api, std::uint64_t view) noexcept
@@ -132,5 +138,6 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 		api->RegisterJSListener(view, "copng_deactivateBuildOption", OnJsDeactivateBuildOption);
 		api->RegisterJSListener(view, "copng_swapBuildOption", OnJsSwapBuildOption);
 		api->RegisterJSListener(view, "copng_undoRegisterItem", OnJsUndoRegisterItem);
+		api->RegisterJSListener(view, "copng_requestPatchResync", OnJsRequestPatchResync);
 	}
 }
@@ -3,6 +3,7 @@
 #include "CodexOfPowerNG/Config.h"
 #include "CodexOfPowerNG/BuildStateStore.h"
 #include "CodexOfPowerNG/L10n.h"
+#include "CodexOfPowerNG/PostLoad.h"
 #include "CodexOfPowerNG/Registration.h"
 #include "CodexOfPowerNG/RegistrationStateStore.h"
 #include "CodexOfPowerNG/Rewards.h"
@@ -27,6 +28,11 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 			{ "focused", focused },
 			{ "hidden", hidden },
 		};
+		// Migration and build effects may still be settling for a few frames after a load.
+		j["postLoad"] = {
+			{ "ready", PostLoad::IsReady() },
+			{ "generation", PostLoad::CurrentGeneration() },
+		};
 		j["registeredCount"] = registeredCount;
 		j["rewardCount"] = rewardCount;
 		const auto migrationNotice = BuildStateStore::GetMigrationNoticeSnapshot();
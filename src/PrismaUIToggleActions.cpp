@@ -2,6 +2,7 @@
 
 #include "CodexOfPowerNG/Config.h"
 #include "CodexOfPowerNG/PrismaUIManager.h"
+#include "CodexOfPowerNG/Registration.h"
 
 #include <RE/Skyrim.h>
 
@@ -14,6 +15,7 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 		void QueueOpenTransition() noexcept
 		{
 			SKSE::log::info("ToggleUI: open (queued)");
+			Registration::RefreshQuickRegisterRows();
 			SetOpenRequested(true);
 			ResetFocusAttempts();
 			SetViewHidden(false);
@@ -59,6 +61,7 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 		// If we created the view as part of this toggle, DOM-ready will handle opening.
 		if (!readyBefore && createdNow) {
 			SKSE::log::info("ToggleUI: view created; will open after DOM ready");
+			Registration::RefreshQuickRegisterRows();
 			SendStateToUI();
 			SKSE::log::info("ToggleUI: end");
 			return;
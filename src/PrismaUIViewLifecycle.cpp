@@ -1,4 +1,5 @@
 #include "PrismaUIInternal.h"
+#include "PrismaUIPatch.h"
 #include "PrismaUIViewState.h"
 
 #include "CodexOfPowerNG/Config.h"
@@ -21,18 +22,18 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 {
 	namespace
 	{
-		void CallJS(const char* fn, const json& payload) noexcept
+		[[nodiscard]] bool CallJS(const char* fn, const json& payload) noexcept
 		{
 			if (!fn || fn[0] == '\0') {
-				return;
+				return false;
 			}
 			if (!State::domReady.load(std::memory_order_acquire)) {
-				return;
+				return false;
 			}
 			auto* api = GetPrismaAPI();
 			const auto view = State::view.load(std::memory_order_acquire);
 			if (!api || view == 0 || !api->IsValid(view)) {
-				return;
+				return false;
 			}
 
 			std::string s;
@@ -40,18 +41,19 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 				s = payload.dump();
 			} catch (const std::exception& e) {
 				SKSE::log::error("InteropCall: failed to serialize payload for '{}': {}", fn, e.what());
-				return;
+				return false;
 			} catch (...) {
 				SKSE::log::error("InteropCall: failed to serialize payload for '{}'", fn);
-				return;
+				return false;
 			}
 
 			api->InteropCall(view, fn, s.c_str());
+			return true;
 		}
 
 		void Toast(std::string_view level, std::string message) noexcept
 		{
-			CallJS("copng_toast", json{ { "level", level }, { "message", std::move(message) } });
+			(void)CallJS("copng_toast", json{ { "level", level }, { "message", std::move(message) } });
 		}
 
 		void OnDomReady(PrismaView view) noexcept
@@ -67,6 +69,8 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 				return;
 			}
 
+			// A fresh document holds no patch baselines.
+			ResetPatchJournal();
 			State::domReady.store(true, std::memory_order_release);
 
 			// Route initialization through the task queue to avoid any uncertainty
@@ -261,9 +265,13 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 		api->RegisterJSListener(view, "copng_saveSettings", HandleSaveSettingsRequest);
 	}
 
-	void SendJS(const char* fn, const json& payload) noexcept
+	bool SendJS(const char* fn, const json& payload) noexcept
 	{
-		CallJS(fn, payload);
+		if (!CallJS(fn, payload)) {
+			return false;
+		}
+		NoteSnapshotSent(fn, payload);
+		return true;
 	}
 
 	void ShowToast(std::string_view level, std::string message) noexcept
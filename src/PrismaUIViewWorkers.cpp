@@ -54,17 +54,29 @@ namespace CodexOfPowerNG::PrismaUIManager::Internal
 			// PrismaUI uses a native menu overlay ("PrismaUI_FocusMenu") for cursor/input capture.
 			// In some cases it can remain open even after Hide/Unfocus/Destroy, leaving the cursor visible and the game paused.
 			// Force-hide it on the main thread as a safety net.
-			(void)QueueMainTask([]() {
+			(void)QueueMainTask(TaskPriority::kHigh, []() {
 				if (auto* queue = RE::UIMessageQueue::GetSingleton(); queue) {
 					queue->AddMessage(RE::BSFixedString("PrismaUI_FocusMenu"), RE::UI_MESSAGE_TYPE::kForceHide, nullptr);
 				}
 				SKSE::log::info("Close: queued force-hide PrismaUI_FocusMenu");
+
+				const auto stats = SnapshotMainTaskStats();
+				SKSE::log::info(
+					"Main tasks: {} frames ({} over budget, max {}us), {} slices, {} coalesced, max depth {}, latency avg {}us max {}us",
+					stats.frames,
+					stats.framesOverBudget,
+					stats.maxFrameUs,
+					stats.slicesRun,
+					stats.coalesced,
+					stats.maxQueueDepth,
+					stats.startedTasks > 0 ? stats.totalLatencyUs / stats.startedTasks : 0u,
+					stats.maxLatencyUs);
 			});
 		}
 
 		void QueueHideSkyrimCursor() noexcept
 		{
-			(void)QueueMainTask([]() {
+			(void)QueueMainTask(TaskPriority::kHigh, []() {
 				if (auto* cursor = RE::MenuCursor::GetSingleton(); cursor) {
 					cursor->SetCursorVisibility(false);
 				}
@@ -1,17 +1,67 @@
 #include "CodexOfPowerNG/Registration.h"
 
 #include "CodexOfPowerNG/L10n.h"
+#include "CodexOfPowerNG/NamePool.h"
+#include "CodexOfPowerNG/RegisteredListView.h"
 #include "CodexOfPowerNG/RegistrationRules.h"
 #include "CodexOfPowerNG/RegistrationStateStore.h"
 
 #include "RegistrationInternal.h"
 
+#include <SKSE/Logger.h>
+
 #include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <optional>
 #include <utility>
 #include <vector>
 
 namespace CodexOfPowerNG::Registration
 {
+	namespace
+	{
+		struct RegisteredListCache
+		{
+			RegisteredView::View<ListItem> view{};
+			std::uint64_t                  languageGeneration{ 0 };
+		};
+
+		std::mutex          g_registeredListMutex;
+		RegisteredListCache g_registeredList{};
+
+		[[nodiscard]] std::optional<ListItem> MakeRegisteredItem(RE::FormID id, std::uint32_t storedGroup)
+		{
+			auto* form = RE::TESForm::LookupByID(id);
+			if (!form) {
+				return std::nullopt;
+			}
+
+			ListItem li{};
+			li.formId = id;
+			li.regKey = id;
+			li.group = Internal::ClampGroup(storedGroup, form);
+			li.name = NamePool::Resolve(form, nullptr);
+			return li;
+		}
+
+		void RebuildRegisteredListLocked(RegisteredListCache& cache, std::uint64_t languageGeneration)
+		{
+			auto ids = RegistrationStateStore::SnapshotRegisteredItems();
+
+			std::vector<ListItem> items;
+			items.reserve(ids.size());
+			for (const auto& [id, storedGroup] : ids) {
+				if (auto item = MakeRegisteredItem(id, storedGroup)) {
+					items.push_back(std::move(*item));
+				}
+			}
+
+			RegisteredView::Rebuild(cache.view, std::move(items));
+			cache.languageGeneration = languageGeneration;
+		}
+	}
+
 	std::uint32_t GetDiscoveryGroup(const RE::TESForm* item) noexcept
 	{
 		return RegistrationRules::DiscoveryGroupFor(item, Internal::IsExcludedForm(item));
@@ -37,79 +87,109 @@ namespace CodexOfPowerNG::Registration
 
 	RE::FormID GetRegisterKeyId(RE::FormID formId) noexcept
 	{
-		auto* form = RE::TESForm::LookupByID(formId);
-		auto* regKey = Internal::GetRegisterKey(form);
-		return regKey ? regKey->GetFormID() : 0;
+		const auto itemClass = Internal::ClassifyItem(formId);
+		return itemClass.regKey ? itemClass.regKey->GetFormID() : 0;
 	}
 
 	bool IsRegistered(RE::FormID formId) noexcept
 	{
-		auto* form = RE::TESForm::LookupByID(formId);
-		return Internal::IsRegisteredForm(form);
+		const auto itemClass = Internal::ClassifyItem(formId);
+		if (!itemClass.regKey) {
+			return false;
+		}
+		return RegistrationStateStore::IsRegisteredEither(itemClass.regKey->GetFormID(), formId);
 	}
 
 	bool IsExcluded(RE::FormID formId) noexcept
 	{
-		auto* form = RE::TESForm::LookupByID(formId);
-		if (!form) {
+		const auto itemClass = Internal::ClassifyItem(formId);
+		if (!itemClass.form) {
 			return true;
 		}
-
-		auto* regKey = Internal::GetRegisterKey(form);
-		return Internal::IsExcludedOrBlocked(form, regKey);
+		return itemClass.staticExcluded || Internal::IsBlockedEither(itemClass);
 	}
 
 	bool IsDiscoverable(RE::FormID formId) noexcept
 	{
-		auto* form = RE::TESForm::LookupByID(formId);
-		if (!form) {
+		const auto itemClass = Internal::ClassifyItem(formId);
+		if (!itemClass.regKey || itemClass.group > 5) {
 			return false;
 		}
+		return !Internal::IsBlockedEither(itemClass);
+	}
 
-		auto* regKey = Internal::GetRegisterKey(form);
-		if (!regKey) {
-			return false;
+	RE::FormID ResolveUnregisteredLootKey(RE::FormID formId) noexcept
+	{
+		const auto itemClass = Internal::ClassifyItem(formId);
+		if (!itemClass.regKey || itemClass.group > 5 || Internal::IsBlockedEither(itemClass)) {
+			return 0;
 		}
 
-		if (Internal::IsExcludedOrBlocked(form, regKey)) {
-			return false;
+		const auto regKeyId = itemClass.regKey->GetFormID();
+		if (RegistrationStateStore::IsRegisteredEither(regKeyId, formId)) {
+			return 0;
 		}
+		return regKeyId;
+	}
 
-		return GetDiscoveryGroup(regKey) <= 5;
+	ClassCache::Stats GetClassificationCacheStats() noexcept
+	{
+		return Internal::ClassificationStats();
 	}
 
-	std::vector<ListItem> BuildRegisteredList()
+	RegisteredListUpdate BuildRegisteredListUpdate(std::uint64_t knownVersion)
 	{
-		auto ids = RegistrationStateStore::SnapshotRegisteredItems();
+		RegisteredListUpdate update{};
+		update.fromVersion = knownVersion;
 
-		std::vector<ListItem> out;
-		out.reserve(ids.size());
+		const auto languageGeneration = L10n::LanguageGeneration();
 
-		for (const auto& [id, storedGroup] : ids) {
-			auto* form = RE::TESForm::LookupByID(id);
-			if (!form) {
-				continue;
-			}
+		std::scoped_lock lock(g_registeredListMutex);
+		auto& cache = g_registeredList;
+		if (!cache.view.built || cache.languageGeneration != languageGeneration) {
+			RebuildRegisteredListLocked(cache, languageGeneration);
+		}
 
-			ListItem li{};
-			li.formId = id;
-			li.regKey = id;
-			li.group = Internal::ClampGroup(storedGroup, form);
-			li.name = Internal::BestItemName(form, nullptr);
-			if (li.name.empty()) {
-				li.name = L10n::T("ui.unnamed", "(unnamed)");
+		update.version = cache.view.version;
+		if (RegisteredView::CanReplayFrom(cache.view, knownVersion)) {
+			for (auto& change : RegisteredView::ChangesSince(cache.view, knownVersion)) {
+				update.changes.push_back(RegisteredListChange{
+					change.kind == RegisteredView::ChangeKind::kRemove,
+					change.index,
+					std::move(change.item) });
 			}
-			out.push_back(std::move(li));
+			return update;
 		}
 
-		std::sort(out.begin(), out.end(), [](const ListItem& a, const ListItem& b) {
-			if (a.group != b.group) {
-				return a.group < b.group;
-			}
-			return a.name < b.name;
-		});
+		update.full = true;
+		update.items = RegisteredView::Page(cache.view, 0, cache.view.rows.size());
+		return update;
+	}
 
-		return out;
+	void NoteRegisteredInserted(RE::FormID regKey, std::uint32_t group) noexcept
+	{
+		std::scoped_lock lock(g_registeredListMutex);
+		auto& view = g_registeredList.view;
+		if (!view.built) {
+			return;
+		}
+		if (auto item = MakeRegisteredItem(regKey, group)) {
+			RegisteredView::Upsert(view, std::move(*item));
+		}
+	}
+
+	void NoteRegisteredRemoved(RE::FormID regKey) noexcept
+	{
+		std::scoped_lock lock(g_registeredListMutex);
+		if (g_registeredList.view.built) {
+			RegisteredView::Remove(g_registeredList.view, regKey);
+		}
+	}
+
+	void ResetRegisteredListCache() noexcept
+	{
+		std::scoped_lock lock(g_registeredListMutex);
+		RegisteredView::Invalidate(g_registeredList.view);
 	}
 
 	bool IsTccDisplayedListsAvailable() noexcept
@@ -117,9 +197,25 @@ namespace CodexOfPowerNG::Registration
 		return Internal::IsTccDisplayedListsAvailable();
 	}
 
+	void PrepareAsync(Startup::WorkerPool& pool) noexcept
+	{
+		Internal::PrepareMapsAsync(pool);
+	}
+
 	void Warmup() noexcept
 	{
+		using Clock = std::chrono::steady_clock;
+		const auto startedAt = Clock::now();
 		Internal::EnsureMapsLoaded();
+		const auto mapsDoneAt = Clock::now();
 		(void)Internal::ResolveTccLists();
+		const auto tccDoneAt = Clock::now();
+
+		SKSE::log::info(
+			"Startup stage 'maps.resolve': ran {} us",
+			std::chrono::duration_cast<std::chrono::microseconds>(mapsDoneAt - startedAt).count());
+		SKSE::log::info(
+			"Startup stage 'tcc.resolve': ran {} us",
+			std::chrono::duration_cast<std::chrono::microseconds>(tccDoneAt - mapsDoneAt).count());
 	}
 }
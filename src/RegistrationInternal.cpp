@@ -28,12 +28,12 @@ namespace CodexOfPowerNG::Registration::Internal
 			return false;
 		}
 
-		auto* regKey = GetRegisterKey(item);
-		if (!regKey) {
+		const auto itemClass = ClassifyItem(item, IsRegistrationNormalized());
+		if (!itemClass.regKey) {
 			return false;
 		}
 
-		return RegistrationStateStore::IsRegisteredEither(regKey->GetFormID(), item->GetFormID());
+		return RegistrationStateStore::IsRegisteredEither(itemClass.regKey->GetFormID(), item->GetFormID());
 	}
 
 	std::uint32_t ClampGroup(std::uint32_t group, const RE::TESForm* item) noexcept
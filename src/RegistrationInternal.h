@@ -1,11 +1,16 @@
 #pragma once
 
+#include "CodexOfPowerNG/BuildTypes.h"
 #include "CodexOfPowerNG/Config.h"
+#include "CodexOfPowerNG/RegistrationClassCache.h"
+#include "CodexOfPowerNG/RegistrationRules.h"
 #include "CodexOfPowerNG/RegistrationTccGate.h"
+#include "CodexOfPowerNG/RegistrationTccMembership.h"
 
 #include <RE/Skyrim.h>
 
 #include <cstdint>
+#include <memory>
 #include <string>
 
 namespace CodexOfPowerNG::Registration::Internal
@@ -14,6 +19,9 @@ namespace CodexOfPowerNG::Registration::Internal
 	{
 		RE::BGSListForm* master{ nullptr };
 		RE::BGSListForm* displayed{ nullptr };
+		// Hashed contents of the lists above; null only if building them failed (gate falls back to HasForm).
+		std::shared_ptr<const TccMembership::ListMembership> masterForms{};
+		std::shared_ptr<const TccMembership::ListMembership> displayedForms{};
 	};
 
 	[[nodiscard]] TccLists ResolveTccLists() noexcept;
@@ -25,10 +33,32 @@ namespace CodexOfPowerNG::Registration::Internal
 		const RE::TESForm* item,
 		const RE::TESForm* regKey) noexcept;
 
+	// What a base form registers as, minus save state (blocked/registered are checked by callers).
+	struct ItemClass
+	{
+		RE::TESForm*            form{ nullptr };
+		RE::TESForm*            regKey{ nullptr };
+		std::uint32_t           group{ RegistrationRules::kUnknownGroup };  // regKey's group; unknown when excluded
+		bool                    staticExcluded{ true };                     // exclude map or intrinsic rule, item or regKey
+		Builds::BuildPointCenti buildPointsCenti{ 0 };
+	};
+
+	// Memoised per FormID; the memo is dropped when the maps reload or normalizeRegistration flips.
+	[[nodiscard]] ItemClass ClassifyItem(const RE::TESForm* item, bool normalizeRegistration) noexcept;
+	[[nodiscard]] ItemClass ClassifyItem(RE::FormID formId) noexcept;
+	[[nodiscard]] bool      IsBlockedEither(const ItemClass& itemClass) noexcept;
+	[[nodiscard]] ClassCache::Stats ClassificationStats() noexcept;
+
+	// Bumped every time the exclude/variant maps are (re)loaded; loads them first.
+	[[nodiscard]] std::uint64_t MapsGeneration() noexcept;
+
+	// Starts the maps' file read/parse stages on `pool`; EnsureMapsLoaded() waits for them and resolves.
+	void PrepareMapsAsync(Startup::WorkerPool& pool) noexcept;
 	void EnsureMapsLoaded() noexcept;
 
 	[[nodiscard]] bool IsExcludedByMap(RE::FormID formId) noexcept;
 	[[nodiscard]] std::string BestItemName(const RE::TESForm* primary, const RE::TESForm* fallback);
+	[[nodiscard]] RE::TESForm* GetRegisterKey(const RE::TESForm* item, bool normalizeRegistration) noexcept;
 	[[nodiscard]] RE::TESForm* GetRegisterKey(const RE::TESForm* item, const Settings& settings) noexcept;
 	[[nodiscard]] RE::TESForm* GetRegisterKey(const RE::TESForm* item) noexcept;
 	[[nodiscard]] bool IsExcludedForm(const RE::TESForm* item) noexcept;
@@ -0,0 +1,122 @@
+#include "RegistrationInternal.h"
+
+#include "CodexOfPowerNG/BuildProgression.h"
+#include "CodexOfPowerNG/RegistrationStateStore.h"
+
+#include <RE/Skyrim.h>
+
+#include <exception>
+#include <optional>
+
+namespace CodexOfPowerNG::Registration::Internal
+{
+	namespace
+	{
+		ClassCache::GenerationalFormCache<ItemClass> g_classes;
+
+		[[nodiscard]] std::uint64_t GenerationFor(bool normalizeRegistration) noexcept
+		{
+			return (MapsGeneration() << 1) | (normalizeRegistration ? 1u : 0u);
+		}
+
+		// Runtime-created forms (0xFF index) can be deleted and their ids reused.
+		[[nodiscard]] bool IsCacheable(RE::FormID formId) noexcept
+		{
+			return (formId >> 24) != 0xFF;
+		}
+
+		[[nodiscard]] bool IsStaticExcluded(const RE::TESForm* item) noexcept
+		{
+			return IsExcludedByMap(item->GetFormID()) || RegistrationRules::IsIntrinsicExcluded(item);
+		}
+
+		[[nodiscard]] ItemClass Compute(RE::TESForm* form, bool normalizeRegistration) noexcept
+		{
+			ItemClass itemClass{};
+			itemClass.form = form;
+			itemClass.regKey = GetRegisterKey(form, normalizeRegistration);
+			if (!itemClass.regKey) {
+				return itemClass;
+			}
+
+			itemClass.staticExcluded =
+				IsStaticExcluded(form) || (itemClass.regKey != form && IsStaticExcluded(itemClass.regKey));
+			const auto formType = itemClass.regKey->GetFormType();
+			itemClass.group = itemClass.staticExcluded ? RegistrationRules::kUnknownGroup : RegistrationRules::GroupFromFormType(formType);
+			itemClass.buildPointsCenti = BuildProgression::ResolveBuildPointsForFormType(formType);
+			return itemClass;
+		}
+	}
+
+	ItemClass ClassifyItem(const RE::TESForm* item, bool normalizeRegistration) noexcept
+	{
+		if (!item) {
+			return {};
+		}
+
+		auto*      form = const_cast<RE::TESForm*>(item);
+		const auto formId = form->GetFormID();
+		if (!IsCacheable(formId)) {
+			return Compute(form, normalizeRegistration);
+		}
+
+		try {
+			const auto cached = g_classes.GetOrCompute(formId, GenerationFor(normalizeRegistration), [&]() {
+				return std::optional<ItemClass>(Compute(form, normalizeRegistration));
+			});
+			return cached ? *cached : ItemClass{};
+		} catch (const std::exception&) {
+			return Compute(form, normalizeRegistration);
+		}
+	}
+
+	ItemClass ClassifyItem(RE::FormID formId) noexcept
+	{
+		if (formId == 0) {
+			return {};
+		}
+
+		const bool normalizeRegistration = IsRegistrationNormalized();
+		if (!IsCacheable(formId)) {
+			auto* form = RE::TESForm::LookupByID(formId);
+			return form ? Compute(form, normalizeRegistration) : ItemClass{};
+		}
+
+		// A hit skips LookupByID too: forms loaded from plugins live for the whole session.
+		try {
+			const auto cached = g_classes.GetOrCompute(formId, GenerationFor(normalizeRegistration), [&]() -> std::optional<ItemClass> {
+				auto* form = RE::TESForm::LookupByID(formId);
+				if (!form) {
+					return std::nullopt;
+				}
+				return Compute(form, normalizeRegistration);
+			});
+			return cached ? *cached : ItemClass{};
+		} catch (const std::exception&) {
+			auto* form = RE::TESForm::LookupByID(formId);
+			return form ? Compute(form, normalizeRegistration) : ItemClass{};
+		}
+	}
+
+	bool IsBlockedEither(const ItemClass& itemClass) noexcept
+	{
+		if (!itemClass.form) {
+			return false;
+		}
+		const auto formId = itemClass.form->GetFormID();
+		if (RegistrationStateStore::IsBlocked(formId)) {
+			return true;
+		}
+		return itemClass.regKey && itemClass.regKey != itemClass.form &&
+		       RegistrationStateStore::IsBlocked(itemClass.regKey->GetFormID());
+	}
+
+	ClassCache::Stats ClassificationStats() noexcept
+	{
+		try {
+			return g_classes.GetStats();
+		} catch (const std::exception&) {
+			return {};
+		}
+	}
+}
@@ -3,18 +3,23 @@
 #include "CodexOfPowerNG/Constants.h"
 #include "CodexOfPowerNG/RegistrationFormId.h"
 #include "CodexOfPowerNG/RegistrationMaps.h"
+#include "CodexOfPowerNG/RegistrationMapsCache.h"
 #include "CodexOfPowerNG/RegistrationRules.h"
 #include "CodexOfPowerNG/RegistrationStateStore.h"
+#include "CodexOfPowerNG/RegistrationVariantRoots.h"
+#include "CodexOfPowerNG/StartupPool.h"
 
 #include <RE/Skyrim.h>
 
 #include <SKSE/Logger.h>
 
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <future>
 #include <mutex>
 #include <optional>
 #include <string_view>
-#include <unordered_map>
-#include <unordered_set>
 #include <utility>
 
 namespace CodexOfPowerNG::Registration::Internal
@@ -24,13 +29,39 @@ namespace CodexOfPowerNG::Registration::Internal
 		std::mutex g_mapsMutex;
 		bool       g_mapsLoaded{ false };
 
+		std::atomic<std::uint64_t> g_mapsGeneration{ 0 };
+
 		// Write-once maps: populated by EnsureMapsLoaded(), then immutable.
 		// Thread safety: every public function that reads these calls
 		// EnsureMapsLoaded() first. The mutex acquire/release there provides
 		// a happens-before relationship with the initial write, so subsequent
 		// lock-free reads are safe. Do NOT modify after initialization.
-		std::unordered_set<RE::FormID>              g_excluded{};
-		std::unordered_map<RE::FormID, RE::FormID> g_variantBase{};
+		Containers::FlatFormIdSet             g_excluded{};
+		Containers::FlatFormIdMap<RE::FormID> g_variantBase{};
+		// What GetRegisterKey() returns for every form it would change: variant chains followed to
+		// their root, and static weapons' templateWeapon hop folded in. Built with the maps.
+		Containers::FlatFormIdMap<RE::TESForm*> g_registerKeys{};
+
+		// Background read/parse stages started by PrepareMapsAsync(); consumed by EnsureMapsLoaded().
+		struct PendingMaps
+		{
+			std::shared_future<RegistrationMaps::CacheProbe>     probe;
+			std::shared_future<RegistrationMaps::ParsedExcludes> excludes;
+			std::shared_future<RegistrationMaps::ParsedVariants> variants;
+		};
+		std::optional<PendingMaps> g_pendingMaps{};
+
+		[[nodiscard]] RegistrationMaps::Paths MapsPaths()
+		{
+			return RegistrationMaps::Paths{
+				.excludeMapPath = kExcludeMapPath,
+				.excludeUserPath = kExcludeUserPath,
+				.pluginDataDir = kPluginDataDir,
+				.variantMapPath = kVariantMapPath,
+				.excludePatchMax = kExcludePatchMax,
+				.cachePath = kMapsCachePath
+			};
+		}
 
 		[[nodiscard]] std::optional<RE::FormID> LookupFormFromEntry(
 			std::string_view fileName,
@@ -58,6 +89,117 @@ namespace CodexOfPowerNG::Registration::Internal
 
 			return form->GetFormID();
 		}
+
+		// Resolved FormIDs depend on which plugins load, at which (light) index, and on each plugin's
+		// contents; size and mtime stand in for the contents.
+		[[nodiscard]] std::uint64_t LoadOrderFingerprint() noexcept
+		{
+			auto* data = RE::TESDataHandler::GetSingleton();
+			if (!data) {
+				return RegistrationMaps::kUnknownLoadOrder;
+			}
+
+			std::uint64_t hash = RegistrationMaps::Cache::kFnvOffset;
+			bool          stamped = true;
+			const auto mix = [&](const RE::TESFile* file, std::uint32_t index) {
+				if (!file || !stamped) {
+					return;
+				}
+				const std::string_view fileName = file->GetFilename();
+				const auto stamp = RegistrationMaps::StampOf(std::filesystem::path(kGameDataDir) / fileName);
+				if (!stamp || !stamp->exists) {
+					SKSE::log::info("Registration map cache off: cannot stamp plugin '{}'", fileName);
+					stamped = false;
+					return;
+				}
+				hash = RegistrationMaps::Cache::MixPlugin(hash, fileName, index, stamp->size, stamp->mtime);
+			};
+			try {
+				for (auto* file : data->compiledFileCollection.files) {
+					mix(file, file ? file->compileIndex : 0u);
+				}
+				for (auto* file : data->compiledFileCollection.smallFiles) {
+					mix(file, file ? 0xFE000u | file->smallFileCompileIndex : 0u);
+				}
+			} catch (const std::exception& e) {
+				SKSE::log::warn("Registration map cache off: plugin stamps unavailable ({})", e.what());
+				return RegistrationMaps::kUnknownLoadOrder;
+			}
+			if (!stamped || hash == RegistrationMaps::kUnknownLoadOrder) {
+				return RegistrationMaps::kUnknownLoadOrder;
+			}
+			return hash;
+		}
+	}
+
+	namespace
+	{
+		void BuildRegisterKeys()
+		{
+			g_registerKeys.clear();
+
+			Registration::VariantRoots::CompileStats stats{};
+			const auto roots = Registration::VariantRoots::Compile(
+				g_variantBase,
+				[](std::uint32_t current, std::uint32_t next) {
+					return RegistrationRules::IsValidVariantStep(current, next) && RE::TESForm::LookupByID(next) != nullptr;
+				},
+				&stats);
+
+			const auto rootOf = [&](RE::TESForm* form) -> RE::TESForm* {
+				const auto rootId = Registration::VariantRoots::Resolve(roots, form->GetFormID());
+				if (rootId == form->GetFormID()) {
+					return form;
+				}
+				auto* root = RE::TESForm::LookupByID(rootId);
+				return root ? root : form;
+			};
+
+			for (const auto& [id, rootId] : roots) {
+				if (id == rootId) {
+					continue;
+				}
+				if (auto* root = RE::TESForm::LookupByID(rootId)) {
+					g_registerKeys.insert_or_assign(id, root);
+				}
+			}
+
+			// The template hop comes first: a templated weapon's own variant entry is never consulted.
+			if (auto* data = RE::TESDataHandler::GetSingleton()) {
+				for (auto* weap : data->GetFormArray<RE::TESObjectWEAP>()) {
+					if (weap && weap->templateWeapon) {
+						g_registerKeys.insert_or_assign(weap->GetFormID(), rootOf(weap->templateWeapon));
+					}
+				}
+			}
+
+			if (stats.cycles > 0) {
+				SKSE::log::warn("Variant map: {} cyclic chain(s) broken", stats.cycles);
+			}
+			SKSE::log::info(
+				"Register keys compiled: {} forms (longest variant chain {})",
+				g_registerKeys.size(),
+				stats.maxDepth);
+		}
+	}
+
+	void PrepareMapsAsync(Startup::WorkerPool& pool) noexcept
+	{
+		try {
+			const auto paths = MapsPaths();
+			PendingMaps pending{
+				pool.Submit("maps.cache", [paths]() { return RegistrationMaps::ProbeCache(paths); }),
+				pool.Submit("maps.exclude", [paths]() { return RegistrationMaps::ParseExcludeSources(paths); }),
+				pool.Submit("maps.variant", [paths]() { return RegistrationMaps::ParseVariantSources(paths); })
+			};
+
+			std::scoped_lock lock(g_mapsMutex);
+			if (!g_mapsLoaded) {
+				g_pendingMaps = std::move(pending);
+			}
+		} catch (const std::exception& e) {
+			SKSE::log::warn("Background registration map load unavailable ({}); loading on first use", e.what());
+		}
 	}
 
 	void EnsureMapsLoaded() noexcept
@@ -71,19 +213,48 @@ namespace CodexOfPowerNG::Registration::Internal
 		g_excluded.clear();
 		g_variantBase.clear();
 
-		const RegistrationMaps::Paths paths{
-			.excludeMapPath = kExcludeMapPath,
-			.excludeUserPath = kExcludeUserPath,
-			.pluginDataDir = kPluginDataDir,
-			.variantMapPath = kVariantMapPath,
-			.excludePatchMax = kExcludePatchMax
-		};
-		auto loaded = RegistrationMaps::LoadFromDisk(paths, LookupFormFromEntry);
-		g_excluded = std::move(loaded.excluded);
-		g_variantBase = std::move(loaded.variantBase);
+		const auto paths = MapsPaths();
+		std::optional<RegistrationMaps::Data> loaded;
+		if (auto pending = std::exchange(g_pendingMaps, std::nullopt)) {
+			try {
+				// Readiness gate: normally the stages finished long before kDataLoaded.
+				loaded = RegistrationMaps::Resolve(
+					paths,
+					pending->probe.get(),
+					pending->excludes.get(),
+					pending->variants.get(),
+					LoadOrderFingerprint(),
+					LookupFormFromEntry);
+			} catch (const std::exception& e) {
+				SKSE::log::warn("Background registration map load failed ({}); loading inline", e.what());
+			}
+		}
+		if (!loaded) {
+			loaded = RegistrationMaps::LoadCached(paths, LoadOrderFingerprint(), LookupFormFromEntry);
+		}
+		g_excluded = std::move(loaded->excluded);
+		g_variantBase = std::move(loaded->variantBase);
 
 		SKSE::log::info("Exclude map loaded: {} forms", g_excluded.size());
 		SKSE::log::info("Variant map loaded: {} mappings", g_variantBase.size());
+
+		try {
+			BuildRegisterKeys();
+		} catch (const std::exception& e) {
+			SKSE::log::error("Failed to compile register keys: {}", e.what());
+			g_registerKeys.clear();
+		}
+		g_mapsGeneration.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	std::uint64_t MapsGeneration() noexcept
+	{
+		// Non-zero only once a load has published the tables.
+		if (const auto generation = g_mapsGeneration.load(std::memory_order_acquire); generation != 0) {
+			return generation;
+		}
+		EnsureMapsLoaded();
+		return g_mapsGeneration.load(std::memory_order_acquire);
 	}
 
 	bool IsExcludedByMap(RE::FormID formId) noexcept
@@ -95,50 +266,41 @@ namespace CodexOfPowerNG::Registration::Internal
 		return g_excluded.contains(formId);
 	}
 
-	RE::TESForm* GetRegisterKey(const RE::TESForm* item, const Settings& settings) noexcept
+	RE::TESForm* GetRegisterKey(const RE::TESForm* item, bool normalizeRegistration) noexcept
 	{
 		if (!item) {
 			return nullptr;
 		}
 
-		if (!settings.normalizeRegistration) {
-			return const_cast<RE::TESForm*>(item);
-		}
-
-		RE::TESForm* regKey = const_cast<RE::TESForm*>(item);
-
-		if (auto* weap = regKey->As<RE::TESObjectWEAP>(); weap && weap->templateWeapon) {
-			regKey = weap->templateWeapon;
+		auto* form = const_cast<RE::TESForm*>(item);
+		if (!normalizeRegistration) {
+			return form;
 		}
 
 		EnsureMapsLoaded();
 
-		for (int safety = 0; safety < 8; ++safety) {
-			const auto it = g_variantBase.find(regKey->GetFormID());
-			if (it == g_variantBase.end()) {
-				break;
-			}
-
-			const auto baseID = it->second;
-			if (!RegistrationRules::IsValidVariantStep(regKey->GetFormID(), baseID)) {
-				break;
-			}
-
-			auto* baseForm = RE::TESForm::LookupByID(baseID);
-			if (!baseForm || baseForm == regKey) {
-				break;
-			}
+		const auto& registerKeys = std::as_const(g_registerKeys);
+		if (const auto it = registerKeys.find(form->GetFormID()); it != registerKeys.end()) {
+			return it->second;
+		}
 
-			regKey = baseForm;
+		// Weapons created at runtime (player enchanting) are not in the table; their template may be.
+		if (auto* weap = form->As<RE::TESObjectWEAP>(); weap && weap->templateWeapon) {
+			const auto it = registerKeys.find(weap->templateWeapon->GetFormID());
+			return it != registerKeys.end() ? it->second : weap->templateWeapon;
 		}
 
-		return regKey;
+		return form;
+	}
+
+	RE::TESForm* GetRegisterKey(const RE::TESForm* item, const Settings& settings) noexcept
+	{
+		return GetRegisterKey(item, settings.normalizeRegistration);
 	}
 
 	RE::TESForm* GetRegisterKey(const RE::TESForm* item) noexcept
 	{
-		const auto settings = GetSettings();
-		return GetRegisterKey(item, settings);
+		return GetRegisterKey(item, IsRegistrationNormalized());
 	}
 
 	bool IsExcludedForm(const RE::TESForm* item) noexcept
@@ -1,16 +1,35 @@
 #include "RegistrationInternal.h"
 
+#include "CodexOfPowerNG/Util.h"
+
 #include <SKSE/Logger.h>
 
 #include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
 
 namespace CodexOfPowerNG::Registration::Internal
 {
 	namespace
 	{
+		// Lists missing at lookup time (LOTD not installed) are looked up again at most this often.
+		inline constexpr std::uint64_t kMissingListRetryMs = 1000;
+
+		struct CachedList
+		{
+			RE::BGSListForm*                                     list{ nullptr };
+			std::shared_ptr<const TccMembership::ListMembership> membership{};
+		};
+
 		std::atomic_bool g_tccListsAvailable{ false };
 		std::atomic_bool g_tccListsKnown{ false };
 
+		std::mutex    g_tccCacheMutex;
+		CachedList    g_masterList{};
+		CachedList    g_displayedList{};
+		std::uint64_t g_lookupRetryAtMs{ 0 };
+
 		[[nodiscard]] bool ListHasEitherForm(
 			const RE::BGSListForm* list,
 			const RE::TESForm* first,
@@ -30,6 +49,45 @@ namespace CodexOfPowerNG::Registration::Internal
 
 			return false;
 		}
+
+		[[nodiscard]] TccMembership::Fingerprint FingerprintOf(const RE::BGSListForm& list) noexcept
+		{
+			TccMembership::Fingerprint fingerprint{};
+			fingerprint.formCount = list.forms.size();
+			if (!list.forms.empty() && list.forms.back()) {
+				fingerprint.lastFormId = list.forms.back()->GetFormID();
+			}
+			if (const auto* added = list.scriptAddedTempForms; added && !added->empty()) {
+				fingerprint.addedCount = added->size();
+				fingerprint.lastAddedId = added->back();
+			}
+			return fingerprint;
+		}
+
+		// Call with g_tccCacheMutex held. Rebuilds only when the list's fingerprint moved.
+		void RefreshMembershipLocked(CachedList& cached) noexcept
+		{
+			if (!cached.list) {
+				cached.membership.reset();
+				return;
+			}
+
+			const auto fingerprint = FingerprintOf(*cached.list);
+			if (cached.membership && cached.membership->fingerprint == fingerprint) {
+				return;
+			}
+
+			try {
+				cached.membership = std::make_shared<const TccMembership::ListMembership>(TccMembership::Build(
+					fingerprint,
+					cached.list->forms,
+					[](const RE::TESForm* form) { return form ? form->GetFormID() : RE::FormID{ 0 }; },
+					cached.list->scriptAddedTempForms));
+			} catch (const std::exception& e) {
+				cached.membership.reset();
+				SKSE::log::warn("TCC list membership cache rebuild failed ({}); using FormList scans", e.what());
+			}
+		}
 	}
 
 	void WarnMissingTccListsOnce() noexcept
@@ -48,8 +106,24 @@ namespace CodexOfPowerNG::Registration::Internal
 	TccLists ResolveTccLists() noexcept
 	{
 		TccLists lists{};
-		lists.master = RE::TESForm::LookupByEditorID<RE::BGSListForm>("dbmMaster");
-		lists.displayed = RE::TESForm::LookupByEditorID<RE::BGSListForm>("dbmDisp");
+		{
+			std::scoped_lock lock(g_tccCacheMutex);
+			if (!g_masterList.list || !g_displayedList.list) {
+				const auto nowMs = NowMs();
+				if (nowMs >= g_lookupRetryAtMs) {
+					g_masterList.list = RE::TESForm::LookupByEditorID<RE::BGSListForm>("dbmMaster");
+					g_displayedList.list = RE::TESForm::LookupByEditorID<RE::BGSListForm>("dbmDisp");
+					g_lookupRetryAtMs = nowMs + kMissingListRetryMs;
+				}
+			}
+			RefreshMembershipLocked(g_masterList);
+			RefreshMembershipLocked(g_displayedList);
+
+			lists.master = g_masterList.list;
+			lists.displayed = g_displayedList.list;
+			lists.masterForms = g_masterList.membership;
+			lists.displayedForms = g_displayedList.membership;
+		}
 
 		const bool available = lists.master != nullptr && lists.displayed != nullptr;
 		g_tccListsAvailable.store(available, std::memory_order_relaxed);
@@ -63,8 +137,12 @@ namespace CodexOfPowerNG::Registration::Internal
 		const RE::TESForm* item,
 		const RE::TESForm* regKey) noexcept
 	{
-		const bool trackedByLotd = ListHasEitherForm(lists.master, regKey, item);
-		const bool displayed = ListHasEitherForm(lists.displayed, regKey, item);
+		const RE::FormID regKeyId = regKey ? regKey->GetFormID() : 0;
+		const RE::FormID itemId = item ? item->GetFormID() : 0;
+		const bool trackedByLotd = lists.masterForms ? TccMembership::HasEither(*lists.masterForms, regKeyId, itemId) :
+		                                               ListHasEitherForm(lists.master, regKey, item);
+		const bool displayed = lists.displayedForms ? TccMembership::HasEither(*lists.displayedForms, regKeyId, itemId) :
+		                                              ListHasEitherForm(lists.displayed, regKey, item);
 		return DecideTccGate(
 			settings.requireTccDisplayed,
 			lists.master != nullptr,
@@ -0,0 +1,184 @@
+#include "CodexOfPowerNG/RegistrationLookup.h"
+
+#include "CodexOfPowerNG/RcuCell.h"
+#include "CodexOfPowerNG/RegistrationLookupSnapshot.h"
+#include "CodexOfPowerNG/TaskScheduler.h"
+
+#include <SKSE/Logger.h>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace CodexOfPowerNG::RegistrationLookup
+{
+	namespace
+	{
+		// Blocked/notified ids recorded since the last publish. Loot marks one pair per item, so these
+		// are folded into the snapshot once per frame instead of republishing for every pair. The
+		// small pending lists are themselves published read-copy-update so readers never block.
+		struct PendingIds
+		{
+			FormIdList blocked;
+			FormIdList notified;
+		};
+
+		RcuCell<Snapshot> g_snapshot;
+
+		RcuCell<PendingIds>      g_pending;
+		std::atomic<std::size_t> g_pendingCount{ 0 };
+
+		// Readers check the pending ids before the snapshot: a publish lands before the pending ids
+		// are cleared, so an id is always visible in one of the two.
+		[[nodiscard]] bool PendingContainsAny(FormIdList PendingIds::*list, RE::FormID primaryId, RE::FormID secondaryId) noexcept
+		{
+			if (g_pendingCount.load(std::memory_order_acquire) == 0) {
+				return false;
+			}
+			const auto pending = g_pending.Read();
+			return ContainsAny((*pending).*list, primaryId, secondaryId);
+		}
+
+		// A full republish from RuntimeState already holds every pending id, so it drops them unmerged
+		// (merging would bring back ids the state just cleared).
+		template <class Edit>
+		void PublishEdit(Edit&& edit, bool mergePending = true) noexcept
+		{
+			try {
+				auto next = g_snapshot.CloneCurrent();
+				edit(*next);
+				if (mergePending && g_pendingCount.load(std::memory_order_relaxed) != 0) {
+					const auto pending = g_pending.Read();
+					if (!pending->blocked.empty()) {
+						Rewrite(next->blocked, [&](FormIdList& ids) { InsertAll(ids, pending->blocked); });
+					}
+					if (!pending->notified.empty()) {
+						Rewrite(next->notified, [&](FormIdList& ids) { InsertAll(ids, pending->notified); });
+					}
+				}
+				++next->version;
+				g_snapshot.Publish(std::move(next));
+
+				if (g_pendingCount.load(std::memory_order_relaxed) != 0) {
+					g_pending.Publish(std::make_unique<const PendingIds>());
+					g_pendingCount.store(0, std::memory_order_release);
+				}
+			} catch (const std::exception& e) {
+				SKSE::log::error("Registration lookup: failed to publish snapshot: {}", e.what());
+			}
+		}
+
+		void FlushPending() noexcept
+		{
+			auto& state = GetState();
+			std::scoped_lock lock(state.mutex);
+			if (g_pendingCount.load(std::memory_order_relaxed) != 0) {
+				PublishEdit([](Snapshot&) {});
+			}
+		}
+
+		// Called with RuntimeState::mutex held, which serializes every writer of the pending ids.
+		void NotePendingLocked(
+			FormIdList PendingIds::*     pending,
+			SharedFormIdList Snapshot::* published,
+			RE::FormID                   primaryId,
+			RE::FormID                   secondaryId) noexcept
+		{
+			std::size_t before = 0;
+			try {
+				auto next = g_pending.CloneCurrent();
+				Insert((*next).*pending, primaryId);
+				Insert((*next).*pending, secondaryId);
+				const auto count = next->blocked.size() + next->notified.size();
+				g_pending.Publish(std::move(next));
+				before = g_pendingCount.load(std::memory_order_relaxed);
+				g_pendingCount.store(count, std::memory_order_release);
+			} catch (const std::exception& e) {
+				SKSE::log::warn("Registration lookup: publishing ids directly ({})", e.what());
+				PublishEdit([&](Snapshot& next) {
+					Rewrite(next.*published, [&](FormIdList& ids) {
+						Insert(ids, primaryId);
+						Insert(ids, secondaryId);
+					});
+				});
+				return;
+			}
+
+			if (before == 0 && !QueueCoalescedMainTask("registration.lookup.flush", []() { FlushPending(); }, TaskPriority::kHigh)) {
+				PublishEdit([](Snapshot&) {});
+			}
+		}
+	}
+
+	bool IsRegistered(RE::FormID formId) noexcept
+	{
+		const auto snapshot = g_snapshot.Read();
+		return Contains(*snapshot->registered, formId);
+	}
+
+	bool IsRegisteredEither(RE::FormID regKeyId, RE::FormID legacyId) noexcept
+	{
+		// Backward compat: older data may have stored the non-template variant as the key.
+		const auto snapshot = g_snapshot.Read();
+		return ContainsAny(*snapshot->registered, regKeyId, legacyId);
+	}
+
+	bool IsBlocked(RE::FormID formId) noexcept
+	{
+		if (PendingContainsAny(&PendingIds::blocked, formId, formId)) {
+			return true;
+		}
+		const auto snapshot = g_snapshot.Read();
+		return Contains(*snapshot->blocked, formId);
+	}
+
+	bool IsNotifiedAny(RE::FormID primaryId, RE::FormID secondaryId) noexcept
+	{
+		if (PendingContainsAny(&PendingIds::notified, primaryId, secondaryId)) {
+			return true;
+		}
+		const auto snapshot = g_snapshot.Read();
+		return ContainsAny(*snapshot->notified, primaryId, secondaryId);
+	}
+
+	std::uint64_t Version() noexcept
+	{
+		const auto snapshot = g_snapshot.Read();
+		return snapshot->version;
+	}
+
+	void PublishLocked(const RuntimeState& state) noexcept
+	{
+		PublishEdit([&](Snapshot& next) {
+			next.registered = Share(SortedIds(state.registeredItems, [](const auto& entry) { return entry.first; }));
+			next.blocked = Share(SortedIds(state.blockedItems));
+			next.notified = Share(SortedIds(state.notifiedItems));
+		}, false);
+	}
+
+	void NoteRegisteredLocked(std::span<const RE::FormID> regKeys) noexcept
+	{
+		if (regKeys.empty()) {
+			return;
+		}
+		PublishEdit([&](Snapshot& next) { Rewrite(next.registered, [&](FormIdList& ids) { InsertAll(ids, regKeys); }); });
+	}
+
+	void NoteUnregisteredLocked(RE::FormID regKeyId) noexcept
+	{
+		PublishEdit([&](Snapshot& next) { Rewrite(next.registered, [&](FormIdList& ids) { Erase(ids, regKeyId); }); });
+	}
+
+	void NoteBlockedLocked(RE::FormID regKeyId, RE::FormID itemId) noexcept
+	{
+		NotePendingLocked(&PendingIds::blocked, &Snapshot::blocked, regKeyId, itemId);
+	}
+
+	void NoteNotifiedLocked(RE::FormID primaryId, RE::FormID secondaryId) noexcept
+	{
+		NotePendingLocked(&PendingIds::notified, &Snapshot::notified, primaryId, secondaryId);
+	}
+}
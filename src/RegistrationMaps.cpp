@@ -1,143 +1,386 @@
 #include "CodexOfPowerNG/RegistrationMaps.h"
 
-#include <SKSE/Logger.h>
+#include "CodexOfPowerNG/RegistrationMapsCache.h"
+#include "CodexOfPowerNG/RegistrationMapsSax.h"
 
-#include <nlohmann/json.hpp>
+#include <SKSE/Logger.h>
 
 #include <cstdio>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <optional>
+#include <span>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace CodexOfPowerNG::RegistrationMaps
 {
 	namespace
 	{
-		void LoadExcludeFile(const std::filesystem::path& path,
-			std::unordered_set<RE::FormID>& out,
-			const ResolveEntryFn& resolveEntry) noexcept
+		[[nodiscard]] std::filesystem::path PatchPath(const Paths& paths, std::uint32_t index)
+		{
+			char name[64];
+			const auto written = std::snprintf(name, sizeof(name), "exclude_patch_%02u.json", index);
+			if (written <= 0) {
+				return {};
+			}
+			return paths.pluginDataDir / name;
+		}
+
+		// Whole-file read; nullopt when the file cannot be opened.
+		[[nodiscard]] std::optional<std::string> ReadFile(const std::filesystem::path& path)
 		{
-			std::ifstream in(path, std::ios::binary);
+			std::ifstream in(path, std::ios::binary | std::ios::ate);
 			if (!in.is_open()) {
-				return;
+				return std::nullopt;
+			}
+			const auto size = in.tellg();
+			if (size < 0) {
+				return std::nullopt;
 			}
+			std::string bytes(static_cast<std::size_t>(size), '\0');
+			in.seekg(0);
+			if (!in.read(bytes.data(), size)) {
+				return std::nullopt;
+			}
+			return bytes;
+		}
 
+		// Appends the file's entries only when the whole file parsed.
+		void ParseExcludeFile(const std::filesystem::path& path, std::vector<EntryText>& out) noexcept
+		{
 			try {
-				nlohmann::json j;
-				in >> j;
-
-				auto it = j.find("forms");
-				if (it == j.end() || !it->is_array()) {
+				const auto text = ReadFile(path);
+				if (!text) {
 					return;
 				}
 
-				for (const auto& entry : *it) {
-					if (!entry.is_object()) {
-						continue;
-					}
+				std::vector<EntryText> entries;
+				std::string            error;
+				const bool             parsed = Sax::ParseExcludeEntries(
+					*text,
+					[&](const Sax::FormRef& entry) { entries.push_back(EntryText{ entry.file, entry.id }); },
+					&error);
+				if (!parsed) {
+					SKSE::log::warn("Failed to parse exclude file '{}': {}", path.string(), error);
+					return;
+				}
 
-					auto fileIt = entry.find("file");
-					auto idIt = entry.find("id");
-					if (fileIt == entry.end() || idIt == entry.end() || !fileIt->is_string() || !idIt->is_string()) {
-						continue;
-					}
+				out.insert(out.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+			} catch (const std::exception& e) {
+				SKSE::log::warn("Failed to parse exclude file '{}': {}", path.string(), e.what());
+			}
+		}
 
-					auto formIdOpt = resolveEntry(fileIt->get<std::string>(), idIt->get<std::string>());
-					if (!formIdOpt) {
-						continue;
-					}
+		void ParseVariantMapFile(const std::filesystem::path& path, std::vector<std::pair<EntryText, EntryText>>& out) noexcept
+		{
+			try {
+				const auto text = ReadFile(path);
+				if (!text) {
+					return;
+				}
 
-					out.insert(*formIdOpt);
+				std::vector<std::pair<EntryText, EntryText>> entries;
+				std::string                                  error;
+				const bool                                   parsed = Sax::ParseVariantEntries(
+					*text,
+					[&](const Sax::FormRef& variant, const Sax::FormRef& base) {
+						entries.emplace_back(EntryText{ variant.file, variant.id }, EntryText{ base.file, base.id });
+					},
+					&error);
+				if (!parsed) {
+					SKSE::log::warn("Failed to parse variant map '{}': {}", path.string(), error);
+					return;
 				}
+
+				out.insert(out.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
 			} catch (const std::exception& e) {
-				SKSE::log::warn("Failed to parse exclude file '{}': {}", path.string(), e.what());
+				SKSE::log::warn("Failed to parse variant map '{}': {}", path.string(), e.what());
 			}
 		}
 
-		void LoadVariantMapFile(const std::filesystem::path& path,
-			std::unordered_map<RE::FormID, RE::FormID>& out,
-			const ResolveEntryFn& resolveEntry) noexcept
+		// Same file set the parse stages read, plus the first missing patch slot so adding it invalidates.
+		[[nodiscard]] std::optional<std::vector<Cache::SourceStamp>> CollectSources(const Paths& paths)
 		{
-			std::ifstream in(path, std::ios::binary);
-			if (!in.is_open()) {
-				return;
-			}
+			std::vector<Cache::SourceStamp> sources;
+			const auto add = [&](const std::filesystem::path& path) {
+				auto stamp = StampOf(path);
+				if (!stamp) {
+					return false;
+				}
+				sources.push_back(std::move(*stamp));
+				return true;
+			};
 
-			try {
-				nlohmann::json j;
-				in >> j;
+			if (!add(paths.excludeMapPath) || !add(paths.excludeUserPath)) {
+				return std::nullopt;
+			}
+			for (std::uint32_t i = 1; i <= paths.excludePatchMax; ++i) {
+				const auto patchPath = PatchPath(paths, i);
+				if (patchPath.empty() || !add(patchPath)) {
+					return std::nullopt;
+				}
+				if (!sources.back().exists) {
+					break;
+				}
+			}
+			if (!add(paths.variantMapPath)) {
+				return std::nullopt;
+			}
+			return sources;
+		}
 
-				auto it = j.find("mappings");
-				if (it == j.end() || !it->is_array()) {
+		void WriteCache(const std::filesystem::path& path, const std::vector<char>& bytes) noexcept
+		{
+			auto tmpPath = path;
+			tmpPath += ".tmp";
+			{
+				std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+				if (!out.is_open()) {
+					SKSE::log::warn("Failed to write registration map cache '{}'", tmpPath.string());
+					return;
+				}
+				out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+				out.flush();
+				if (!out) {
+					SKSE::log::warn("Failed to flush registration map cache '{}'", tmpPath.string());
+					std::error_code rmEc{};
+					(void)std::filesystem::remove(tmpPath, rmEc);
 					return;
 				}
+			}
 
-				for (const auto& entry : *it) {
-					if (!entry.is_object()) {
-						continue;
-					}
+			std::error_code commitEc{};
+			std::filesystem::rename(tmpPath, path, commitEc);
+			if (commitEc) {
+				SKSE::log::warn(
+					"Failed to replace registration map cache '{}' ({}): {}",
+					path.string(),
+					commitEc.value(),
+					commitEc.message());
+				std::error_code rmEc{};
+				(void)std::filesystem::remove(tmpPath, rmEc);
+			}
+		}
 
-					const auto v = entry.find("variant");
-					const auto b = entry.find("base");
-					if (v == entry.end() || b == entry.end() || !v->is_object() || !b->is_object()) {
-						continue;
-					}
+		[[nodiscard]] std::optional<Data> TryCache(
+			const Paths&      paths,
+			const CacheProbe& probe,
+			std::uint64_t     loadOrderFingerprint) noexcept
+		{
+			if (paths.cachePath.empty() || loadOrderFingerprint == kUnknownLoadOrder || !probe.sources || !probe.bytes) {
+				return std::nullopt;
+			}
+			try {
+				const Cache::Key key{ loadOrderFingerprint, *probe.sources };
+				if (auto tables = Cache::Decode(std::span<const char>(probe.bytes->data(), probe.bytes->size()), key)) {
+					SKSE::log::info("Registration maps loaded from cache '{}'", paths.cachePath.string());
+					return Data{ std::move(tables->excluded), std::move(tables->variantBase) };
+				}
+			} catch (const std::exception& e) {
+				SKSE::log::warn("Registration map cache unreadable ({}); resolving sources", e.what());
+			}
+			return std::nullopt;
+		}
 
-					const auto vFileIt = v->find("file");
-					const auto vIdIt = v->find("id");
-					const auto bFileIt = b->find("file");
-					const auto bIdIt = b->find("id");
-					if (vFileIt == v->end() || vIdIt == v->end() || bFileIt == b->end() || bIdIt == b->end()) {
-						continue;
-					}
-					if (!vFileIt->is_string() || !vIdIt->is_string() || !bFileIt->is_string() || !bIdIt->is_string()) {
-						continue;
+		[[nodiscard]] Data ResolveEntries(
+			const ParsedExcludes& excludes,
+			const ParsedVariants& variants,
+			const ResolveEntryFn& resolveEntry) noexcept
+		{
+			Data out{};
+			try {
+				out.excluded.reserve(excludes.entries.size());
+				for (const auto& entry : excludes.entries) {
+					if (auto formIdOpt = resolveEntry(entry.file, entry.id)) {
+						out.excluded.insert(*formIdOpt);
 					}
-
-					auto variantIdOpt = resolveEntry(vFileIt->get<std::string>(), vIdIt->get<std::string>());
-					auto baseIdOpt = resolveEntry(bFileIt->get<std::string>(), bIdIt->get<std::string>());
+				}
+				for (const auto& [variant, base] : variants.entries) {
+					auto variantIdOpt = resolveEntry(variant.file, variant.id);
+					auto baseIdOpt = resolveEntry(base.file, base.id);
 					if (!variantIdOpt || !baseIdOpt || *variantIdOpt == *baseIdOpt) {
 						continue;
 					}
-
-					out.emplace(*variantIdOpt, *baseIdOpt);
+					out.variantBase.emplace(*variantIdOpt, *baseIdOpt);
 				}
 			} catch (const std::exception& e) {
-				SKSE::log::warn("Failed to parse variant map '{}': {}", path.string(), e.what());
+				SKSE::log::warn("Failed to resolve registration maps: {}", e.what());
+			}
+			return out;
+		}
+
+		[[nodiscard]] Data ResolveAndCache(
+			const Paths&          paths,
+			const ParsedExcludes& excludes,
+			const ParsedVariants& variants,
+			std::uint64_t         loadOrderFingerprint,
+			const ResolveEntryFn& resolveEntry) noexcept
+		{
+			auto data = ResolveEntries(excludes, variants, resolveEntry);
+			if (paths.cachePath.empty() || loadOrderFingerprint == kUnknownLoadOrder || !excludes.complete ||
+				!variants.complete) {
+				return data;
+			}
+			try {
+				Cache::Key key{ loadOrderFingerprint, excludes.sources };
+				key.sources.insert(key.sources.end(), variants.sources.begin(), variants.sources.end());
+				// Copies share storage with `data` (copy-on-write), so this does not duplicate the tables.
+				WriteCache(paths.cachePath, Cache::Encode(key, Cache::Tables{ data.excluded, data.variantBase }));
+			} catch (const std::exception& e) {
+				SKSE::log::warn("Failed to encode registration map cache: {}", e.what());
 			}
+			return data;
 		}
 	}
 
-	Data LoadFromDisk(const Paths& paths, const ResolveEntryFn& resolveEntry) noexcept
+	std::optional<Cache::SourceStamp> StampOf(const std::filesystem::path& path)
 	{
-		Data out{};
-		if (!resolveEntry) {
-			return out;
+		Cache::SourceStamp stamp{ path.generic_string(), false, 0, 0 };
+		std::error_code    ec;
+		const auto         status = std::filesystem::status(path, ec);
+		if (status.type() == std::filesystem::file_type::not_found) {
+			return stamp;
+		}
+		if (ec) {
+			return std::nullopt;
 		}
 
-		LoadExcludeFile(paths.excludeMapPath, out.excluded, resolveEntry);
-		LoadExcludeFile(paths.excludeUserPath, out.excluded, resolveEntry);
+		stamp.size = std::filesystem::file_size(path, ec);
+		if (ec) {
+			return std::nullopt;
+		}
+		const auto mtime = std::filesystem::last_write_time(path, ec);
+		if (ec) {
+			return std::nullopt;
+		}
+		stamp.exists = true;
+		stamp.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+		return stamp;
+	}
 
-		for (std::uint32_t i = 1; i <= paths.excludePatchMax; ++i) {
-			char name[64];
-			const auto written = std::snprintf(name, sizeof(name), "exclude_patch_%02u.json", i);
-			if (written <= 0) {
-				break;
-			}
-			const auto patchPath = paths.pluginDataDir / name;
-			std::error_code ec;
-			const bool exists = std::filesystem::exists(patchPath, ec);
-			if (ec) {
-				SKSE::log::warn("Exclude patch file check failed for '{}': {}", patchPath.string(), ec.message());
-				break;
+	CacheProbe ProbeCache(const Paths& paths) noexcept
+	{
+		CacheProbe probe{};
+		if (paths.cachePath.empty()) {
+			return probe;
+		}
+		try {
+			probe.sources = CollectSources(paths);
+			if (probe.sources) {
+				probe.bytes = ReadFile(paths.cachePath);
 			}
-			if (!exists) {
-				break;
+		} catch (const std::exception& e) {
+			SKSE::log::warn("Registration map cache unreadable ({}); parsing sources", e.what());
+			probe = {};
+		}
+		return probe;
+	}
+
+	ParsedExcludes ParseExcludeSources(const Paths& paths) noexcept
+	{
+		ParsedExcludes out{};
+		try {
+			const auto stampAndParse = [&](const std::filesystem::path& path) {
+				if (auto stamp = StampOf(path)) {
+					out.sources.push_back(std::move(*stamp));
+				} else {
+					out.complete = false;
+				}
+				ParseExcludeFile(path, out.entries);
+			};
+
+			stampAndParse(paths.excludeMapPath);
+			stampAndParse(paths.excludeUserPath);
+
+			for (std::uint32_t i = 1; i <= paths.excludePatchMax; ++i) {
+				const auto patchPath = PatchPath(paths, i);
+				if (patchPath.empty()) {
+					out.complete = false;
+					break;
+				}
+				std::error_code ec;
+				const bool exists = std::filesystem::exists(patchPath, ec);
+				if (ec) {
+					SKSE::log::warn("Exclude patch file check failed for '{}': {}", patchPath.string(), ec.message());
+					out.complete = false;
+					break;
+				}
+				if (!exists) {
+					if (auto stamp = StampOf(patchPath)) {
+						out.sources.push_back(std::move(*stamp));
+					} else {
+						out.complete = false;
+					}
+					break;
+				}
+				stampAndParse(patchPath);
 			}
-			LoadExcludeFile(patchPath, out.excluded, resolveEntry);
+		} catch (const std::exception& e) {
+			SKSE::log::warn("Failed to read exclude sources: {}", e.what());
+			out.complete = false;
 		}
+		return out;
+	}
 
-		LoadVariantMapFile(paths.variantMapPath, out.variantBase, resolveEntry);
+	ParsedVariants ParseVariantSources(const Paths& paths) noexcept
+	{
+		ParsedVariants out{};
+		try {
+			if (auto stamp = StampOf(paths.variantMapPath)) {
+				out.sources.push_back(std::move(*stamp));
+			} else {
+				out.complete = false;
+			}
+			ParseVariantMapFile(paths.variantMapPath, out.entries);
+		} catch (const std::exception& e) {
+			SKSE::log::warn("Failed to read variant map: {}", e.what());
+			out.complete = false;
+		}
 		return out;
 	}
+
+	Data Resolve(
+		const Paths&          paths,
+		const CacheProbe&     probe,
+		const ParsedExcludes& excludes,
+		const ParsedVariants& variants,
+		std::uint64_t         loadOrderFingerprint,
+		const ResolveEntryFn& resolveEntry) noexcept
+	{
+		if (!resolveEntry) {
+			return {};
+		}
+		if (auto cached = TryCache(paths, probe, loadOrderFingerprint)) {
+			return std::move(*cached);
+		}
+		return ResolveAndCache(paths, excludes, variants, loadOrderFingerprint, resolveEntry);
+	}
+
+	Data LoadFromDisk(const Paths& paths, const ResolveEntryFn& resolveEntry) noexcept
+	{
+		if (!resolveEntry) {
+			return {};
+		}
+		return ResolveEntries(ParseExcludeSources(paths), ParseVariantSources(paths), resolveEntry);
+	}
+
+	Data LoadCached(const Paths& paths, std::uint64_t loadOrderFingerprint, const ResolveEntryFn& resolveEntry) noexcept
+	{
+		if (paths.cachePath.empty() || !resolveEntry) {
+			return LoadFromDisk(paths, resolveEntry);
+		}
+		if (auto cached = TryCache(paths, ProbeCache(paths), loadOrderFingerprint)) {
+			return std::move(*cached);
+		}
+		return ResolveAndCache(
+			paths,
+			ParseExcludeSources(paths),
+			ParseVariantSources(paths),
+			loadOrderFingerprint,
+			resolveEntry);
+	}
 }
@@ -1,11 +1,20 @@
 #include "CodexOfPowerNG/RegistrationQuestGuard.h"
 
+#include "CodexOfPowerNG/RcuCell.h"
+#include "CodexOfPowerNG/TaskScheduler.h"
 #include "CodexOfPowerNG/Util.h"
 
 #include <RE/F/FormTraits.h>
 #include <SKSE/Logger.h>
 
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
 #include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // BGSRefAlias.cpp.obj in CommonLibSSE.lib references TESForm::As<Actor>
 // via GetActorReference(). Provide the instantiation so the linker can resolve it.
@@ -15,78 +24,276 @@ namespace CodexOfPowerNG::Registration::QuestGuard
 {
 	namespace
 	{
-		inline constexpr std::uint64_t kCacheTtlMs = 2000;
+		// Script-side alias changes (ForceRefTo) raise no event; a reconciliation pass catches them
+		// at most this long after the previous pass finished, as the old 2 s rescan did.
+		inline constexpr std::uint64_t kReconcileIntervalMs = 2000;
+		// The sweep checks its slice budget after this many quests.
+		inline constexpr std::size_t kSweepYieldCheckStride = 32;
+		inline constexpr std::chrono::microseconds kInlineSweepBudget{ std::chrono::seconds(10) };
 
-		std::mutex                          g_mutex;
-		std::unordered_set<RE::FormID>      g_protectedForms;
-		std::uint64_t                       g_builtAtMs{ 0 };
+		struct DirtyQuest
+		{
+			RE::FormID questId{ 0 };
+			bool       stopped{ false };
+		};
+
+		std::mutex                         g_writerMutex;
+		QuestProtection::ProtectionIndex   g_index;
+		std::uint64_t                      g_version{ 0 };
+		RcuCell<Snapshot>                  g_published;
+
+		std::mutex              g_dirtyMutex;
+		std::vector<DirtyQuest> g_dirtyQuests;
+
+		std::atomic_bool           g_sweepQueued{ false };
+		std::atomic<std::uint64_t> g_sweepDoneAtMs{ 0 };
+
+		std::mutex                 g_liveWalkMutex;
+		QuestProtection::LiveWalk  g_liveWalk;
+
+		[[nodiscard]] QuestProtection::QuestForms CollectQuestForms(RE::TESQuest* quest)
+		{
+			QuestProtection::QuestForms result{};
+			if (!quest) {
+				return result;
+			}
+			result.questId = quest->GetFormID();
+			if (!quest->IsRunning()) {
+				return result;
+			}
+
+			for (auto* alias : quest->aliases) {
+				if (!alias || alias->GetVMTypeID() != RE::BGSRefAlias::VMTYPEID) {
+					continue;
+				}
+				auto* refAlias = static_cast<RE::BGSRefAlias*>(alias);
+
+				// Check the live reference's base object
+				if (auto* ref = refAlias->GetReference()) {
+					if (auto* base = ref->GetBaseObject()) {
+						result.forms.push_back(base->GetFormID());
+					}
+				}
+
+				// Also check created-object aliases (fillType == kCreated)
+				if (refAlias->fillType == RE::BGSBaseAlias::FILL_TYPE::kCreated) {
+					if (auto* createdObj = refAlias->fillData.created.object) {
+						result.forms.push_back(createdObj->GetFormID());
+					}
+				}
+			}
+			return result;
+		}
 
-		void RebuildIfStale()
+		// Call with g_writerMutex held.
+		void PublishIfChangedLocked()
 		{
-			const auto now = NowMs();
-			if (now >= g_builtAtMs && (now - g_builtAtMs) <= kCacheTtlMs) {
+			if (!QuestProtection::TakeChanged(g_index)) {
 				return;
 			}
+			g_published.Publish(std::make_unique<const Snapshot>(Snapshot{ g_index.protectedForms, ++g_version }));
+		}
 
-			std::unordered_set<RE::FormID> fresh;
+		void ProcessDirtyQuests() noexcept
+		{
+			std::vector<DirtyQuest> dirty;
+			{
+				std::scoped_lock lock(g_dirtyMutex);
+				dirty.swap(g_dirtyQuests);
+			}
+
+			try {
+				std::scoped_lock lock(g_writerMutex);
+				for (const auto& quest : dirty) {
+					auto forms = quest.stopped ? QuestProtection::QuestForms{ quest.questId, {} } :
+					                             CollectQuestForms(RE::TESForm::LookupByID<RE::TESQuest>(quest.questId));
+					QuestProtection::SetQuestForms(g_index, quest.questId, std::move(forms.forms));
+				}
+				PublishIfChangedLocked();
+			} catch (const std::exception& e) {
+				SKSE::log::error("Quest guard: failed to apply quest changes: {}", e.what());
+			}
+		}
 
-			auto* handler = RE::TESDataHandler::GetSingleton();
-			if (!handler) {
-				g_protectedForms.clear();
-				g_builtAtMs = now;
+		void MarkQuestDirty(RE::FormID questId, bool stopped) noexcept
+		{
+			if (questId == 0) {
+				return;
+			}
+			try {
+				std::scoped_lock lock(g_dirtyMutex);
+				g_dirtyQuests.push_back(DirtyQuest{ questId, stopped });
+			} catch (const std::exception&) {
 				return;
 			}
+			// Aliases are filled after the start event; reading them a frame later sees the final refs.
+			(void)QueueCoalescedMainTask("quest.guard.dirty", []() { ProcessDirtyQuests(); });
+		}
 
-			for (auto* quest : handler->GetFormArray<RE::TESQuest>()) {
-				if (!quest || !quest->IsRunning()) {
-					continue;
+		[[nodiscard]] TaskStep RunSweepSlice(std::chrono::microseconds sliceBudget) noexcept
+		{
+			bool done = true;
+			try {
+				std::scoped_lock lock(g_writerMutex);
+				auto* handler = RE::TESDataHandler::GetSingleton();
+				if (handler) {
+					auto&       quests = handler->GetFormArray<RE::TESQuest>();
+					const auto  deadline = std::chrono::steady_clock::now() + sliceBudget;
+					std::size_t visited = 0;
+					done = QuestProtection::SweepStep(
+						g_index,
+						quests.size(),
+						[&](std::size_t i) { return CollectQuestForms(quests[static_cast<std::uint32_t>(i)]); },
+						[&]() {
+							return ++visited % kSweepYieldCheckStride == 0 && std::chrono::steady_clock::now() >= deadline;
+						});
 				}
+				PublishIfChangedLocked();
+			} catch (const std::exception& e) {
+				SKSE::log::error("Quest guard: reconciliation pass failed: {}", e.what());
+			}
 
-				for (auto* alias : quest->aliases) {
-					if (!alias) {
-						continue;
-					}
+			if (!done) {
+				return TaskStep::kYield;
+			}
+			g_sweepDoneAtMs.store(NowMs(), std::memory_order_relaxed);
+			g_sweepQueued.store(false, std::memory_order_release);
+			return TaskStep::kDone;
+		}
 
-					if (alias->GetVMTypeID() != RE::BGSRefAlias::VMTYPEID) {
-						continue;
-					}
-					auto* refAlias = static_cast<RE::BGSRefAlias*>(alias);
-
-					// Check the live reference's base object
-					auto* ref = refAlias->GetReference();
-					if (ref) {
-						auto* base = ref->GetBaseObject();
-						if (base) {
-							fresh.insert(base->GetFormID());
-						}
-					}
+		void StartSweep(bool force) noexcept
+		{
+			if (!force) {
+				const auto now = NowMs();
+				const auto doneAt = g_sweepDoneAtMs.load(std::memory_order_relaxed);
+				if (now >= doneAt && now - doneAt <= kReconcileIntervalMs) {
+					return;
+				}
+			}
+			if (g_sweepQueued.exchange(true, std::memory_order_acq_rel)) {
+				return;
+			}
 
-					// Also check created-object aliases (fillType == kCreated)
-					if (refAlias->fillType == RE::BGSBaseAlias::FILL_TYPE::kCreated) {
-						auto* createdObj = refAlias->fillData.created.object;
-						if (createdObj) {
-							fresh.insert(createdObj->GetFormID());
-						}
+			{
+				std::scoped_lock lock(g_writerMutex);
+				QuestProtection::BeginSweep(g_index);
+			}
+			if (QueueResumableMainTask([](std::chrono::microseconds sliceBudget) { return RunSweepSlice(sliceBudget); })) {
+				return;
+			}
+
+			// No task queue: finish the pass inline rather than leave quest items unprotected.
+			while (RunSweepSlice(kInlineSweepBudget) == TaskStep::kYield) {}
+		}
+
+		// A pass is queued or running, or quest events have not been applied yet.
+		[[nodiscard]] bool IsPublishedSetStale() noexcept
+		{
+			if (g_sweepQueued.load(std::memory_order_acquire)) {
+				return true;
+			}
+			std::scoped_lock lock(g_dirtyMutex);
+			return !g_dirtyQuests.empty();
+		}
+
+		template <class Event>
+		class QuestEventSink final : public RE::BSTEventSink<Event>
+		{
+		public:
+			RE::BSEventNotifyControl ProcessEvent(const Event* event, RE::BSTEventSource<Event>* /*source*/) override
+			{
+				if (event) {
+					if constexpr (std::is_same_v<Event, RE::TESQuestStartStopEvent>) {
+						MarkQuestDirty(event->formID, !event->started);
+					} else {
+						MarkQuestDirty(event->formID, false);
 					}
 				}
+				return RE::BSEventNotifyControl::kContinue;
 			}
+		};
 
-			g_protectedForms = std::move(fresh);
-			g_builtAtMs = now;
+		QuestEventSink<RE::TESQuestStartStopEvent> g_startStopSink;
+		QuestEventSink<RE::TESQuestInitEvent>      g_initSink;
+		QuestEventSink<RE::TESQuestStageEvent>     g_stageSink;
+		bool                                       g_installed{ false };
+	}
+
+	void OnGameLoaded() noexcept
+	{
+		if (!g_installed) {
+			if (auto* sources = RE::ScriptEventSourceHolder::GetSingleton()) {
+				sources->AddEventSink<RE::TESQuestStartStopEvent>(&g_startStopSink);
+				sources->AddEventSink<RE::TESQuestInitEvent>(&g_initSink);
+				sources->AddEventSink<RE::TESQuestStageEvent>(&g_stageSink);
+				SKSE::log::info("Registered quest start/stop/init/stage sinks");
+				g_installed = true;
+			} else {
+				SKSE::log::error("ScriptEventSourceHolder unavailable; quest protection falls back to periodic passes");
+			}
 		}
+		// Running quests and their aliases all changed with the load.
+		StartSweep(true);
 	}
 
-	std::unordered_set<RE::FormID> SnapshotProtectedForms()
+	Snapshot SnapshotProtectedForms()
 	{
-		std::scoped_lock lock(g_mutex);
-		RebuildIfStale();
-		return g_protectedForms;
+		StartSweep(false);
+		const auto published = g_published.Read();
+		return *published;
+	}
+
+	std::uint64_t Version() noexcept
+	{
+		StartSweep(false);
+		const auto published = g_published.Read();
+		return published->version;
 	}
 
 	bool IsQuestProtected(RE::FormID formId) noexcept
 	{
-		std::scoped_lock lock(g_mutex);
-		RebuildIfStale();
-		return g_protectedForms.contains(formId);
+		StartSweep(false);
+		const auto published = g_published.Read();
+		return published->forms.contains(formId);
+	}
+
+	bool IsQuestProtectedNow(std::span<const RE::FormID> formIds) noexcept
+	{
+		const auto published = g_published.Read();
+		for (const auto formId : formIds) {
+			if (published->forms.contains(formId)) {
+				return true;
+			}
+		}
+
+		StartSweep(false);
+		if (!IsPublishedSetStale()) {
+			return false;
+		}
+
+		auto* handler = RE::TESDataHandler::GetSingleton();
+		if (!handler) {
+			return false;
+		}
+		try {
+			std::scoped_lock lock(g_liveWalkMutex);
+			const auto&      live = QuestProtection::LiveForms(g_liveWalk, CurrentMainTaskFrame(), [handler](auto& forms) {
+				for (auto* quest : handler->GetFormArray<RE::TESQuest>()) {
+					for (const auto formId : CollectQuestForms(quest).forms) {
+						if (formId != 0) {
+							forms.insert(formId);
+						}
+					}
+				}
+			});
+			for (const auto formId : formIds) {
+				if (live.contains(formId)) {
+					return true;
+				}
+			}
+		} catch (const std::exception& e) {
+			SKSE::log::error("Quest guard: synchronous check failed: {}", e.what());
+		}
+		return false;
 	}
 }
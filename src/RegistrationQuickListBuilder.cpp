@@ -1,12 +1,10 @@
 #include "RegistrationQuickListBuilder.h"
 
-#include "CodexOfPowerNG/BuildProgression.h"
 #include "CodexOfPowerNG/Inventory.h"
-#include "CodexOfPowerNG/L10n.h"
-#include "CodexOfPowerNG/RegistrationRules.h"
+#include "CodexOfPowerNG/NamePool.h"
 
 #include <algorithm>
-#include <unordered_set>
+#include <optional>
 #include <utility>
 
 namespace CodexOfPowerNG::Registration::Internal
@@ -33,106 +31,74 @@ namespace CodexOfPowerNG::Registration::Internal
 			return "not_actionable";
 		}
 
-		[[nodiscard]] bool IsExcludedFast(
+		[[nodiscard]] bool IsBlockedFast(
 			const RegistrationStateStore::QuickListSnapshot& quickListState,
-			const RE::TESForm* item) noexcept
+			const ItemClass& itemClass) noexcept
 		{
-			if (!item) {
-				return true;
-			}
-
-			const auto id = item->GetFormID();
-			if (Internal::IsExcludedByMap(id) || quickListState.blockedItems.contains(id)) {
-				return true;
-			}
-
-			return RegistrationRules::IsIntrinsicExcluded(item);
+			return quickListState.blockedItems.contains(itemClass.form->GetFormID()) ||
+			       (itemClass.regKey != itemClass.form && quickListState.blockedItems.contains(itemClass.regKey->GetFormID()));
 		}
+	}
 
-		[[nodiscard]] std::uint32_t GetDiscoveryGroupFast(
-			const RegistrationStateStore::QuickListSnapshot& quickListState,
-			const RE::TESForm* item) noexcept
-		{
-			if (!item || IsExcludedFast(quickListState, item)) {
-				return 255;
-			}
-
-			return RegistrationRules::GroupFromFormType(item->GetFormType());
+	std::optional<ListItem> EvaluateQuickListEntry(
+		const Settings& settings,
+		const TccLists& tccLists,
+		const RegistrationStateStore::QuickListSnapshot& quickListState,
+		const QuestGuard::ProtectedForms& questProtected,
+		const Inventory::PlayerSnapshot::Row& row)
+	{
+		if (!row.entry) {
+			return std::nullopt;
+		}
+		auto& entry = *row.entry;
+		auto* obj = entry.GetObject();
+		if (!obj) {
+			return std::nullopt;
 		}
 
-		void AppendEligibleItem(
-			RE::PlayerCharacter& player,
-			const Settings& settings,
-			const TccLists& tccLists,
-			const RegistrationStateStore::QuickListSnapshot& quickListState,
-			const std::unordered_set<RE::FormID>& questProtected,
-			std::unordered_set<RE::FormID>& seenRegKeys,
-			RE::InventoryEntryData& entry,
-			std::vector<ListItem>& allEligible)
-		{
-			auto* obj = entry.GetObject();
-			if (!obj) {
-				return;
-			}
-
-			auto* regKey = Internal::GetRegisterKey(obj, settings);
-			if (!regKey) {
-				return;
-			}
-
-			const auto group = GetDiscoveryGroupFast(quickListState, regKey);
-			if (group > 5) {
-				return;
-			}
-
-			if (IsExcludedFast(quickListState, obj) || (regKey != obj && IsExcludedFast(quickListState, regKey))) {
-				return;
-			}
-
-			const auto regKeyId = regKey->GetFormID();
-			const auto objId = obj->GetFormID();
-
-			if (quickListState.registeredKeys.contains(regKeyId) || quickListState.registeredKeys.contains(objId)) {
-				return;
-			}
+		const auto itemClass = Internal::ClassifyItem(obj, settings.normalizeRegistration);
+		auto*      regKey = itemClass.regKey;
+		if (!regKey || itemClass.group > 5 || IsBlockedFast(quickListState, itemClass)) {
+			return std::nullopt;
+		}
+		const auto group = itemClass.group;
 
-			if (!seenRegKeys.insert(regKeyId).second) {
-				return;
-			}
+		const auto regKeyId = regKey->GetFormID();
+		const auto objId = obj->GetFormID();
 
-			const auto totalCount = player.GetItemCount(obj);
-			if (totalCount <= 0) {
-				return;
-			}
+		if (quickListState.registeredItems.contains(regKeyId) || quickListState.registeredItems.contains(objId)) {
+			return std::nullopt;
+		}
 
-			const auto removal = Inventory::SelectSafeRemoval(&entry, totalCount, settings.protectFavorites);
-			const bool isQuestProtected =
-				entry.IsQuestObject() ||
-				questProtected.contains(regKeyId) ||
-				questProtected.contains(objId);
-			const auto tccGate = Internal::EvaluateTccGate(settings, tccLists, obj, regKey);
-			ListItem item{};
-			item.formId = objId;
-			item.regKey = regKeyId;
-			item.group = group;
-			item.totalCount = totalCount;
-			item.safeCount = removal.safeCount;
-			item.excluded = false;
-			item.registered = false;
-			item.blocked = false;
-			item.buildPointsCenti = BuildProgression::ResolveBuildPointsForFormType(regKey->GetFormType());
-			item.disabledReason = DetermineDisabledReason(isQuestProtected, tccGate, removal);
-			if (!item.disabledReason.empty()) {
-				item.safeCount = 0;
-				item.blocked = true;
-			}
-			item.name = Internal::BestItemName(regKey, obj);
-			if (item.name.empty()) {
-				item.name = L10n::T("ui.unnamed", "(unnamed)");
-			}
+		const auto totalCount = row.totalCount;
+		if (totalCount <= 0) {
+			return std::nullopt;
+		}
 
-			allEligible.push_back(std::move(item));
+		const auto& removal = row.removal;
+		const bool isQuestProtected =
+			entry.IsQuestObject() ||
+			questProtected.contains(regKeyId) ||
+			questProtected.contains(objId);
+		const auto tccGate = Internal::EvaluateTccGate(settings, tccLists, obj, regKey);
+		ListItem item{};
+		item.formId = objId;
+		item.regKey = regKeyId;
+		item.group = group;
+		item.totalCount = totalCount;
+		item.safeCount = removal.safeCount;
+		item.excluded = false;
+		item.registered = false;
+		item.blocked = false;
+		item.buildPointsCenti = itemClass.buildPointsCenti;
+		item.disabledReason = DetermineDisabledReason(isQuestProtected, tccGate, removal);
+		if (!item.disabledReason.empty()) {
+			item.safeCount = 0;
+			item.blocked = true;
 		}
+		item.name = NamePool::Resolve(regKey, obj);
+
+		return item;
 	}
 
 	std::vector<ListItem> BuildQuickListEligibleItems(
@@ -140,26 +106,14 @@ namespace CodexOfPowerNG::Registration::Internal
 		const Settings& settings,
 		const TccLists& tccLists,
 		const RegistrationStateStore::QuickListSnapshot& quickListState,
-		const std::unordered_set<RE::FormID>& questProtected)
+		const QuestGuard::ProtectedForms& questProtected)
 	{
-		std::vector<ListItem>          allEligible;
-		std::unordered_set<RE::FormID> seenRegKeys;
-
-		if (auto* changes = player.GetInventoryChanges(); changes && changes->entryList) {
-			for (auto* entry : *changes->entryList) {
-				if (!entry) {
-					continue;
-				}
+		std::vector<ListItem> allEligible;
 
-				AppendEligibleItem(
-					player,
-					settings,
-					tccLists,
-					quickListState,
-					questProtected,
-					seenRegKeys,
-					*entry,
-					allEligible);
+		const auto inventory = Inventory::GetPlayerSnapshot(player, settings.protectFavorites);
+		for (const auto& row : inventory->Rows()) {
+			if (auto item = EvaluateQuickListEntry(settings, tccLists, quickListState, questProtected, row)) {
+				allEligible.push_back(std::move(*item));
 			}
 		}
 
@@ -167,7 +121,13 @@ namespace CodexOfPowerNG::Registration::Internal
 			if (a.group != b.group) {
 				return a.group < b.group;
 			}
-			return a.name < b.name;
+			if (NamePool::CollatesBefore(a.name, b.name)) {
+				return true;
+			}
+			if (NamePool::CollatesBefore(b.name, a.name)) {
+				return false;
+			}
+			return a.regKey < b.regKey;
 		});
 
 		return allEligible;
@@ -1,22 +1,34 @@
 #pragma once
 
 #include "CodexOfPowerNG/Config.h"
+#include "CodexOfPowerNG/Inventory.h"
 #include "CodexOfPowerNG/Registration.h"
+#include "CodexOfPowerNG/RegistrationQuestGuard.h"
 #include "CodexOfPowerNG/RegistrationStateStore.h"
 
 #include "RegistrationInternal.h"
 
 #include <RE/Skyrim.h>
 
-#include <unordered_set>
+#include <optional>
 #include <vector>
 
 namespace CodexOfPowerNG::Registration::Internal
 {
+	// Evaluates a single inventory snapshot row; nullopt when the object cannot appear in the quick list.
+	[[nodiscard]] std::optional<ListItem> EvaluateQuickListEntry(
+		const Settings& settings,
+		const TccLists& tccLists,
+		const RegistrationStateStore::QuickListSnapshot& quickListState,
+		const QuestGuard::ProtectedForms& questProtected,
+		const Inventory::PlayerSnapshot::Row& row);
+
+	// Full scan. Returns every eligible object sorted by (group, name, regKey); objects that share a
+	// regKey are all kept so the quick-list index can promote a sibling when one leaves the inventory.
 	[[nodiscard]] std::vector<ListItem> BuildQuickListEligibleItems(
 		RE::PlayerCharacter& player,
 		const Settings& settings,
 		const TccLists& tccLists,
 		const RegistrationStateStore::QuickListSnapshot& quickListState,
-		const std::unordered_set<RE::FormID>& questProtected);
+		const QuestGuard::ProtectedForms& questProtected);
 }
@@ -5,7 +5,9 @@
 #include "CodexOfPowerNG/Config.h"
 #include "CodexOfPowerNG/Inventory.h"
 #include "CodexOfPowerNG/L10n.h"
+#include "CodexOfPowerNG/RegistrationBatchOps.h"
 #include "CodexOfPowerNG/RegistrationQuestGuard.h"
+#include "CodexOfPowerNG/RegistrationQuickListIndex.h"
 #include "CodexOfPowerNG/RegistrationStateStore.h"
 #include "CodexOfPowerNG/SerializationStateStore.h"
 #include "CodexOfPowerNG/Util.h"
@@ -14,9 +16,15 @@
 #include "RegistrationQuickListBuilder.h"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <exception>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -24,20 +32,82 @@ namespace CodexOfPowerNG::Registration
 {
 	namespace
 	{
-		inline constexpr std::uint64_t kQuickListCacheTtlMs = 750;
+		// Promoting a sibling after its representative left needs a second pass over the dirty set.
+		inline constexpr std::size_t kQuickListDeltaPasses = 2;
+
+		// LOTD edits dbmDisp without raising an event; the membership fingerprints stand in for one.
+		struct TccStamp
+		{
+			bool                       hasMaster{ false };
+			bool                       hasDisplayed{ false };
+			TccMembership::Fingerprint master{};
+			TccMembership::Fingerprint displayed{};
+
+			[[nodiscard]] bool operator==(const TccStamp&) const noexcept = default;
+		};
 
 		struct QuickListCache
 		{
-			std::vector<ListItem> allEligible{};
-			std::uint64_t generation{ 0 };
-			std::uint64_t builtAtMs{ 0 };
-			std::uint32_t settingsMask{ 0 };
+			QuickListIndex::EligibleIndex<ListItem> index{};
+			QuestGuard::ProtectedForms             questProtected{};
+			TccStamp                               tccStamp{};
+			std::uint64_t                          generation{ 0 };
+			std::uint64_t                          questVersion{ 0 };
+			std::uint64_t                          languageGeneration{ 0 };
 		};
 
 		std::mutex                g_quickListCacheMutex;
 		QuickListCache            g_quickListCache{};
 		std::atomic<std::uint64_t> g_quickListGeneration{ 1 };
 
+		// Dirty marks from event sinks and UI toggles. They land here under a short lock of their own
+		// and are folded into the index by the next list build, so a mark never waits on a rebuild.
+		struct DirtyInbox
+		{
+			std::vector<RE::FormID> objects;
+			bool                    all{ false };
+		};
+
+		std::mutex       g_dirtyInboxMutex;
+		DirtyInbox       g_dirtyInbox{};
+		std::atomic_bool g_dirtyInboxPending{ false };
+
+		void PostDirty(RE::FormID formId, bool all) noexcept
+		{
+			try {
+				std::scoped_lock lock(g_dirtyInboxMutex);
+				if (all) {
+					g_dirtyInbox.all = true;
+				} else {
+					g_dirtyInbox.objects.push_back(formId);
+				}
+			} catch (const std::exception&) {
+				std::scoped_lock lock(g_dirtyInboxMutex);
+				g_dirtyInbox.all = true;
+			}
+			g_dirtyInboxPending.store(true, std::memory_order_release);
+		}
+
+		// Call with g_quickListCacheMutex held.
+		void DrainDirtyInboxLocked(QuickListCache& cache)
+		{
+			if (!g_dirtyInboxPending.exchange(false, std::memory_order_acq_rel)) {
+				return;
+			}
+			DirtyInbox inbox;
+			{
+				std::scoped_lock lock(g_dirtyInboxMutex);
+				std::swap(inbox, g_dirtyInbox);
+			}
+			if (inbox.all) {
+				QuickListIndex::MarkAllDirty(cache.index);
+				return;
+			}
+			for (const auto formId : inbox.objects) {
+				QuickListIndex::MarkObjectDirty(cache.index, formId);
+			}
+		}
+
 		[[nodiscard]] std::uint32_t BuildQuickListSettingsMask(const Settings& settings) noexcept
 		{
 			std::uint32_t mask = 0;
@@ -47,22 +117,36 @@ namespace CodexOfPowerNG::Registration
 			return mask;
 		}
 
+		[[nodiscard]] TccStamp StampOf(const Internal::TccLists& lists) noexcept
+		{
+			TccStamp stamp{};
+			stamp.hasMaster = lists.master != nullptr;
+			stamp.hasDisplayed = lists.displayed != nullptr;
+			if (lists.masterForms) {
+				stamp.master = lists.masterForms->fingerprint;
+			}
+			if (lists.displayedForms) {
+				stamp.displayed = lists.displayedForms->fingerprint;
+			}
+			return stamp;
+		}
+
+		// The quest guard bumps its version on every change to the protected set.
+		[[nodiscard]] bool IsQuestSnapshotStale(const QuickListCache& cache) noexcept
+		{
+			return cache.questVersion != QuestGuard::Version();
+		}
+
 		void FillQuickListPage(
-			const std::vector<ListItem>& allEligible,
+			const QuickListIndex::EligibleIndex<ListItem>& index,
 			std::size_t offset,
 			std::size_t limit,
 			QuickRegisterList& result)
 		{
-			const auto totalEligible = allEligible.size();
-			const auto clampedOffset = (std::min)(offset, totalEligible);
-			const auto remaining = totalEligible - clampedOffset;
-			const auto pageSize = (std::min)(limit, remaining);
-
+			const auto totalEligible = index.items.size();
 			result.total = totalEligible;
-			result.hasMore = (clampedOffset + pageSize) < totalEligible;
-			result.items.assign(
-				allEligible.begin() + static_cast<std::ptrdiff_t>(clampedOffset),
-				allEligible.begin() + static_cast<std::ptrdiff_t>(clampedOffset + pageSize));
+			result.items = QuickListIndex::Page(index, offset, limit);
+			result.hasMore = ((std::min)(offset, totalEligible) + result.items.size()) < totalEligible;
 		}
 
 		[[nodiscard]] bool TryBuildQuickListFromCache(
@@ -70,35 +154,145 @@ namespace CodexOfPowerNG::Registration
 			std::size_t limit,
 			std::uint64_t generation,
 			std::uint32_t settingsMask,
+			const TccStamp& tccStamp,
 			QuickRegisterList& result) noexcept
 		{
 			std::scoped_lock lock(g_quickListCacheMutex);
-			if (g_quickListCache.generation != generation) {
+			const auto& cache = g_quickListCache;
+			if (cache.generation != generation || cache.tccStamp != tccStamp ||
+				g_dirtyInboxPending.load(std::memory_order_acquire)) {
 				return false;
 			}
-			if (g_quickListCache.settingsMask != settingsMask) {
+			if (QuickListIndex::NeedsRebuild(cache.index, settingsMask) || !cache.index.dirtyObjects.empty() ||
+				cache.languageGeneration != L10n::LanguageGeneration()) {
 				return false;
 			}
-			const auto nowMs = NowMs();
-			if (nowMs < g_quickListCache.builtAtMs || (nowMs - g_quickListCache.builtAtMs) > kQuickListCacheTtlMs) {
+			if (IsQuestSnapshotStale(cache)) {
 				return false;
 			}
 
-			FillQuickListPage(g_quickListCache.allEligible, offset, limit, result);
+			FillQuickListPage(cache.index, offset, limit, result);
 			return true;
 		}
 
+		void ApplyQuestProtectionChanges(QuickListCache& cache, QuestGuard::ProtectedForms questProtected)
+		{
+			if (questProtected.shares_storage_with(cache.questProtected)) {
+				return;
+			}
+
+			for (const auto& entry : std::as_const(cache.questProtected)) {
+				if (!questProtected.contains(entry.first)) {
+					QuickListIndex::MarkFormDirty(cache.index, entry.first);
+				}
+			}
+			for (const auto& entry : std::as_const(questProtected)) {
+				if (!cache.questProtected.contains(entry.first)) {
+					QuickListIndex::MarkFormDirty(cache.index, entry.first);
+				}
+			}
+			cache.questProtected = std::move(questProtected);
+		}
+
+		// Re-evaluates only dirty objects: one snapshot probe each, no full sort.
+		void ApplyQuickListDeltas(
+			RE::PlayerCharacter& player,
+			const Settings& settings,
+			const Internal::TccLists& tccLists,
+			QuickListCache& cache)
+		{
+			const auto quickListState = RegistrationStateStore::SnapshotQuickList();
+			const auto inventory = Inventory::GetPlayerSnapshot(player, settings.protectFavorites);
+
+			for (std::size_t pass = 0; pass < kQuickListDeltaPasses && !cache.index.dirtyObjects.empty(); ++pass) {
+				const auto pending = QuickListIndex::TakeDirtyObjects(cache.index);
+				for (const auto formId : pending) {
+					// Objects without a row left the inventory.
+					std::optional<ListItem> item;
+					if (const auto* row = inventory->Find(formId)) {
+						item = Internal::EvaluateQuickListEntry(settings, tccLists, quickListState, cache.questProtected, *row);
+					}
+					if (item) {
+						QuickListIndex::Upsert(cache.index, std::move(*item));
+					} else {
+						QuickListIndex::EraseObject(cache.index, formId);
+					}
+				}
+			}
+		}
+
 		void UpdateQuickListCache(
-			std::vector<ListItem> allEligible,
-			std::uint64_t generation,
+			RE::PlayerCharacter& player,
+			const Settings& settings,
+			const Internal::TccLists& tccLists,
 			std::uint32_t settingsMask,
-			std::uint64_t builtAtMs) noexcept
+			std::uint64_t generation,
+			std::size_t offset,
+			std::size_t limit,
+			QuickRegisterList& result)
 		{
 			std::scoped_lock lock(g_quickListCacheMutex);
-			g_quickListCache.allEligible = std::move(allEligible);
-			g_quickListCache.generation = generation;
-			g_quickListCache.settingsMask = settingsMask;
-			g_quickListCache.builtAtMs = builtAtMs;
+			auto& cache = g_quickListCache;
+			DrainDirtyInboxLocked(cache);
+			// Rows are ordered by collation keys of the active language.
+			const auto languageGeneration = L10n::LanguageGeneration();
+			const bool rebuild =
+				QuickListIndex::NeedsRebuild(cache.index, settingsMask) || cache.languageGeneration != languageGeneration;
+
+			// Every row carries its gate decision; a list change can flip any of them.
+			const auto tccStamp = StampOf(tccLists);
+			if (!rebuild && cache.tccStamp != tccStamp) {
+				QuickListIndex::MarkAllDirty(cache.index);
+			}
+			cache.tccStamp = tccStamp;
+
+			if (rebuild || IsQuestSnapshotStale(cache)) {
+				auto questSnapshot = QuestGuard::SnapshotProtectedForms();
+				if (rebuild) {
+					cache.questProtected = std::move(questSnapshot.forms);
+				} else {
+					ApplyQuestProtectionChanges(cache, std::move(questSnapshot.forms));
+				}
+				cache.questVersion = questSnapshot.version;
+			}
+
+			if (rebuild || !cache.index.dirtyObjects.empty()) {
+				if (settings.requireTccDisplayed && (!tccLists.master || !tccLists.displayed)) {
+					Internal::WarnMissingTccListsOnce();
+				}
+
+				Internal::EnsureMapsLoaded();
+
+				if (rebuild) {
+					auto allEligible = Internal::BuildQuickListEligibleItems(
+						player,
+						settings,
+						tccLists,
+						RegistrationStateStore::SnapshotQuickList(),
+						cache.questProtected);
+					QuickListIndex::Rebuild(cache.index, std::move(allEligible), settingsMask);
+					cache.languageGeneration = languageGeneration;
+				} else {
+					ApplyQuickListDeltas(player, settings, tccLists, cache);
+				}
+			}
+
+			cache.generation = generation;
+			FillQuickListPage(cache.index, offset, limit, result);
+		}
+
+		void EraseQuickListRegKey(RE::FormID regKey) noexcept
+		{
+			std::scoped_lock lock(g_quickListCacheMutex);
+			QuickListIndex::EraseRegKey(g_quickListCache.index, regKey);
+		}
+
+		void EraseQuickListRegKeys(const std::vector<RE::FormID>& regKeys) noexcept
+		{
+			std::scoped_lock lock(g_quickListCacheMutex);
+			for (const auto regKey : regKeys) {
+				QuickListIndex::EraseRegKey(g_quickListCache.index, regKey);
+			}
 		}
 
 		void ClearQuickListCacheStorage() noexcept
@@ -106,14 +300,173 @@ namespace CodexOfPowerNG::Registration
 			std::scoped_lock lock(g_quickListCacheMutex);
 			g_quickListCache = QuickListCache{};
 		}
+
+		struct RegistrationPlan
+		{
+			RE::TESBoundObject*        item{ nullptr };
+			RE::TESForm*               regKey{ nullptr };
+			std::uint32_t              group{ 255 };
+			Inventory::RemoveSelection removal{};
+			std::int32_t               totalCount{ 0 };
+			std::string                displayName;
+		};
+
+		void WarnIfTccListsMissing(const Settings& settings, const Internal::TccLists& tccLists) noexcept
+		{
+			if (settings.requireTccDisplayed && (!tccLists.master || !tccLists.displayed)) {
+				Internal::WarnMissingTccListsOnce();
+			}
+		}
+
+		// Single registrations explain a refusal on the HUD; batches summarize in one toast instead.
+		void Refuse(RegisterResult& result, std::string message, bool notify)
+		{
+			result.message = std::move(message);
+			if (notify) {
+				RE::DebugNotification(result.message.c_str());
+			}
+		}
+
+		// Every check made before the inventory is touched. `row` is null when the player does not carry the item.
+		[[nodiscard]] std::optional<RegistrationPlan> PlanRegistration(
+			const Settings&                       settings,
+			const Internal::TccLists&             tccLists,
+			RE::TESBoundObject&                   item,
+			const Inventory::PlayerSnapshot::Row* row,
+			bool                                  notify,
+			RegisterResult&                       result)
+		{
+			auto* regKey = Internal::GetRegisterKey(&item, settings);
+			if (!regKey) {
+				result.message = "Invalid register key";
+				return std::nullopt;
+			}
+
+			if (Internal::IsExcludedOrBlocked(&item, regKey)) {
+				Refuse(result, L10n::T("msg.registerExcluded", "Codex of Power: Cannot register (excluded item)"), notify);
+				return std::nullopt;
+			}
+
+			const auto questItemMessage = [] {
+				return L10n::T("msg.registerQuestItem", "Codex of Power: Cannot register (active quest item)");
+			};
+			const std::array<RE::FormID, 2> questCandidates{ item.GetFormID(), regKey->GetFormID() };
+			if (QuestGuard::IsQuestProtectedNow(questCandidates)) {
+				Refuse(result, questItemMessage(), notify);
+				return std::nullopt;
+			}
+
+			if (RegistrationStateStore::IsRegisteredEither(regKey->GetFormID(), item.GetFormID())) {
+				result.message = "Already registered";
+				return std::nullopt;
+			}
+
+			const auto group = GetDiscoveryGroup(regKey);
+			if (group > 5) {
+				result.message = "Not discoverable";
+				return std::nullopt;
+			}
+
+			const auto tccGate = Internal::EvaluateTccGate(settings, tccLists, &item, regKey);
+			if (tccGate == TccGateDecision::kBlockNotDisplayed) {
+				Refuse(
+					result,
+					L10n::T("msg.registerLotdNotDisplayed", "Codex of Power: Cannot register (LOTD item not displayed yet)"),
+					notify);
+				return std::nullopt;
+			}
+			if (tccGate == TccGateDecision::kBlockUnavailable) {
+				Refuse(
+					result,
+					L10n::T(
+						"msg.registerLotdGateUnavailable",
+						"Codex of Power: Cannot register (LOTD gate unavailable; check TCC install/load order)"),
+					notify);
+				return std::nullopt;
+			}
+
+			auto* entry = row ? row->entry : nullptr;
+			if (!entry) {
+				result.message = "Not in inventory";
+				return std::nullopt;
+			}
+
+			if (entry->IsQuestObject()) {
+				Refuse(result, questItemMessage(), notify);
+				return std::nullopt;
+			}
+
+			RegistrationPlan plan{};
+			plan.item = &item;
+			plan.regKey = regKey;
+			plan.group = group;
+			plan.totalCount = row->totalCount;
+			plan.removal = row->removal;
+			plan.displayName = Internal::BestItemName(regKey, &item);
+			if (plan.displayName.empty()) {
+				RegistrationStateStore::BlockPair(regKey->GetFormID(), item.GetFormID());
+				EraseQuickListRegKey(regKey->GetFormID());
+
+				Refuse(result, L10n::T("msg.registerUnnamed", "Codex of Power: Cannot register (unnamed item)"), notify);
+				return std::nullopt;
+			}
+
+			if (plan.removal.safeCount <= 0) {
+				Refuse(result, L10n::T("msg.registerProtected", "Codex of Power: Cannot register (equipped/favorited)"), notify);
+				return std::nullopt;
+			}
+			return plan;
+		}
+
+		// Removes the one item being registered. Whether the game actually destroyed it is checked
+		// afterwards against a fresh snapshot, once per slice for batches.
+		void RemoveRegisteredItem(RE::PlayerCharacter& player, const RegistrationPlan& plan)
+		{
+			player.RemoveItem(plan.item, 1, RE::ITEM_REMOVE_REASON::kRemove, plan.removal.extraList, nullptr);
+			Inventory::InvalidatePlayerSnapshot();
+		}
+
+		// Blocks the pair when the game refused to destroy the item.
+		[[nodiscard]] bool ConfirmRemoved(
+			const Inventory::PlayerSnapshot& inventory,
+			const RegistrationPlan&          plan,
+			bool                             notify,
+			RegisterResult&                  result)
+		{
+			const auto newHave = inventory.CountOf(plan.item->GetFormID());
+			if (newHave >= plan.totalCount) {
+				RegistrationStateStore::BlockPair(plan.regKey->GetFormID(), plan.item->GetFormID());
+				EraseQuickListRegKey(plan.regKey->GetFormID());
+
+				Refuse(result, L10n::T("msg.registerCantDestroy", "Codex of Power: Cannot register (cannot destroy item)"), notify);
+				return false;
+			}
+			return true;
+		}
 	}
 
 	void InvalidateQuickRegisterCache() noexcept
 	{
 		(void)g_quickListGeneration.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	void ResetQuickRegisterIndex() noexcept
+	{
 		ClearQuickListCacheStorage();
 	}
 
+	void MarkQuickRegisterItemDirty(RE::FormID formId) noexcept
+	{
+		if (formId != 0) {
+			PostDirty(formId, false);
+		}
+	}
+
+	void RefreshQuickRegisterRows() noexcept
+	{
+		PostDirty(0, true);
+	}
+
 	QuickRegisterList BuildQuickRegisterList(std::size_t offset, std::size_t limit)
 	{
 		QuickRegisterList result{};
@@ -126,30 +479,12 @@ namespace CodexOfPowerNG::Registration
 		const auto settings = GetSettings();
 		const auto settingsMask = BuildQuickListSettingsMask(settings);
 		const auto cacheGeneration = g_quickListGeneration.load(std::memory_order_acquire);
-		if (TryBuildQuickListFromCache(offset, limit, cacheGeneration, settingsMask, result)) {
-			return result;
-		}
-
 		const auto tccLists = Internal::ResolveTccLists();
-		if (settings.requireTccDisplayed && (!tccLists.master || !tccLists.displayed)) {
-			Internal::WarnMissingTccListsOnce();
+		if (TryBuildQuickListFromCache(offset, limit, cacheGeneration, settingsMask, StampOf(tccLists), result)) {
+			return result;
 		}
 
-		Internal::EnsureMapsLoaded();
-
-		const auto questProtected = QuestGuard::SnapshotProtectedForms();
-		const auto quickListState = RegistrationStateStore::SnapshotQuickList();
-		auto allEligible = Internal::BuildQuickListEligibleItems(
-			*player,
-			settings,
-			tccLists,
-			quickListState,
-			questProtected);
-
-		// Phase 2: paginate and update short-lived cache
-		FillQuickListPage(allEligible, offset, limit, result);
-		UpdateQuickListCache(std::move(allEligible), cacheGeneration, settingsMask, NowMs());
-
+		UpdateQuickListCache(*player, settings, tccLists, settingsMask, cacheGeneration, offset, limit, result);
 		return result;
 	}
 
@@ -171,114 +506,30 @@ namespace CodexOfPowerNG::Registration
 
 		const auto settings = GetSettings();
 		const auto tccLists = Internal::ResolveTccLists();
-		if (settings.requireTccDisplayed && (!tccLists.master || !tccLists.displayed)) {
-			Internal::WarnMissingTccListsOnce();
-		}
-
-		auto* regKey = Internal::GetRegisterKey(item, settings);
-		if (!regKey) {
-			result.message = "Invalid register key";
-			return result;
-		}
-
-		if (Internal::IsExcludedOrBlocked(item, regKey)) {
-			result.message = L10n::T("msg.registerExcluded", "Codex of Power: Cannot register (excluded item)");
-			RE::DebugNotification(result.message.c_str());
-			return result;
-		}
-
-		if (QuestGuard::IsQuestProtected(item->GetFormID()) ||
-			(regKey != item && QuestGuard::IsQuestProtected(regKey->GetFormID()))) {
-			result.message = L10n::T("msg.registerQuestItem",
-				"Codex of Power: Cannot register (active quest item)");
-			RE::DebugNotification(result.message.c_str());
-			return result;
-		}
-
-		if (RegistrationStateStore::IsRegisteredEither(regKey->GetFormID(), item->GetFormID())) {
-			result.message = "Already registered";
-			return result;
-		}
-
-		const auto group = GetDiscoveryGroup(regKey);
-		if (group > 5) {
-			result.message = "Not discoverable";
-			return result;
-		}
+		WarnIfTccListsMissing(settings, tccLists);
 
-		const auto tccGate = Internal::EvaluateTccGate(settings, tccLists, item, regKey);
-		if (tccGate == TccGateDecision::kBlockNotDisplayed) {
-			result.message = L10n::T("msg.registerLotdNotDisplayed", "Codex of Power: Cannot register (LOTD item not displayed yet)");
-			RE::DebugNotification(result.message.c_str());
-			return result;
-		}
-		if (tccGate == TccGateDecision::kBlockUnavailable) {
-			result.message = L10n::T(
-				"msg.registerLotdGateUnavailable",
-				"Codex of Power: Cannot register (LOTD gate unavailable; check TCC install/load order)");
-			RE::DebugNotification(result.message.c_str());
-			return result;
-		}
-
-		RE::InventoryEntryData* foundEntry = nullptr;
-		if (auto* changes = player->GetInventoryChanges(); changes && changes->entryList) {
-			for (auto* entry : *changes->entryList) {
-				if (!entry) {
-					continue;
-				}
-
-				if (entry->GetObject() == item) {
-					foundEntry = entry;
-					break;
-				}
-			}
-		}
-
-		if (!foundEntry) {
-			result.message = "Not in inventory";
-			return result;
-		}
-
-		if (foundEntry->IsQuestObject() ||
-			QuestGuard::IsQuestProtected(item->GetFormID()) ||
-			(regKey != item && QuestGuard::IsQuestProtected(regKey->GetFormID()))) {
-			result.message = L10n::T("msg.registerQuestItem",
-				"Codex of Power: Cannot register (active quest item)");
-			RE::DebugNotification(result.message.c_str());
-			return result;
-		}
-
-		const auto totalCount = player->GetItemCount(item);
-		const auto removal = Inventory::SelectSafeRemoval(foundEntry, totalCount, settings.protectFavorites);
-		const auto displayName = Internal::BestItemName(regKey, item);
-		if (displayName.empty()) {
-			RegistrationStateStore::BlockPair(regKey->GetFormID(), item->GetFormID());
-
-			result.message = L10n::T("msg.registerUnnamed", "Codex of Power: Cannot register (unnamed item)");
-			RE::DebugNotification(result.message.c_str());
+		const auto plan = PlanRegistration(
+			settings,
+			tccLists,
+			*item,
+			Inventory::GetPlayerSnapshot(*player, settings.protectFavorites)->Find(item->GetFormID()),
+			true,
+			result);
+		if (!plan) {
 			return result;
 		}
-
-		if (removal.safeCount <= 0) {
-			result.message = L10n::T("msg.registerProtected", "Codex of Power: Cannot register (equipped/favorited)");
-			RE::DebugNotification(result.message.c_str());
+		RemoveRegisteredItem(*player, *plan);
+		if (!ConfirmRemoved(*Inventory::GetPlayerSnapshot(*player, settings.protectFavorites), *plan, true, result)) {
 			return result;
 		}
 
-		const auto oldHave = player->GetItemCount(item);
-
-		player->RemoveItem(item, 1, RE::ITEM_REMOVE_REASON::kRemove, removal.extraList, nullptr);
-
-		const auto newHave = player->GetItemCount(item);
-		if (newHave >= oldHave) {
-			RegistrationStateStore::BlockPair(regKey->GetFormID(), item->GetFormID());
-
-			result.message = L10n::T("msg.registerCantDestroy", "Codex of Power: Cannot register (cannot destroy item)");
-			RE::DebugNotification(result.message.c_str());
-			return result;
-		}
+		const auto* regKey = plan->regKey;
+		const auto  group = plan->group;
+		const auto& displayName = plan->displayName;
 
 		const auto totalRegistered = RegistrationStateStore::InsertRegistered(regKey->GetFormID(), group);
+		EraseQuickListRegKey(regKey->GetFormID());
+		NoteRegisteredInserted(regKey->GetFormID(), group);
 
 		const auto msg =
 			L10n::T("msg.registerOkPrefix", "Registered: ") + displayName +
@@ -307,4 +558,135 @@ namespace CodexOfPowerNG::Registration
 		result.totalRegistered = totalRegistered;
 		return result;
 	}
+
+	bool TryRegisterBatch(RegisterBatchJob& job, std::chrono::microseconds sliceBudget)
+	{
+		using Clock = std::chrono::steady_clock;
+		const auto sliceStart = Clock::now();
+
+		auto* player = RE::PlayerCharacter::GetSingleton();
+		if (!player) {
+			job.lastMessage = "Player unavailable";
+			job.next = job.formIds.size();
+			FinishRegisterBatch(job);
+			return true;
+		}
+
+		// Shared context is resolved once per slice; entry pointers do not outlive the frame.
+		const auto settings = GetSettings();
+		const auto tccLists = Internal::ResolveTccLists();
+		WarnIfTccListsMissing(settings, tccLists);
+		const auto inventory = Inventory::GetPlayerSnapshot(*player, settings.protectFavorites);
+
+		std::vector<RegistrationPlan>  removed;
+		std::unordered_set<RE::FormID> sliceItems;
+		std::unordered_set<RE::FormID> sliceRegKeys;
+		std::size_t                    doneInSlice = 0;
+		while (job.next < job.formIds.size() &&
+			   !BatchOps::ShouldYield(doneInSlice, Clock::now() - sliceStart, sliceBudget)) {
+			const auto formId = job.formIds[job.next++];
+			++doneInSlice;
+
+			RegisterResult result{};
+			auto* item = RE::TESForm::LookupByID<RE::TESBoundObject>(formId);
+			if (!item) {
+				job.lastMessage = "Invalid FormID";
+				continue;
+			}
+			// The snapshot row of an item removed earlier in this slice is stale.
+			if (sliceItems.contains(formId)) {
+				job.lastMessage = "Already registered";
+				continue;
+			}
+
+			const auto plan = PlanRegistration(settings, tccLists, *item, inventory->Find(formId), false, result);
+			if (!plan) {
+				job.lastMessage = std::move(result.message);
+				continue;
+			}
+			// Registrations of this slice are not in the state store yet.
+			if (!sliceRegKeys.insert(plan->regKey->GetFormID()).second) {
+				job.lastMessage = "Already registered";
+				continue;
+			}
+			RemoveRegisteredItem(*player, *plan);
+			sliceItems.insert(formId);
+			removed.push_back(*plan);
+		}
+
+		std::vector<UndoRecord> records;
+		BuildContributionTotals contributions{};
+		if (!removed.empty()) {
+			const auto after = Inventory::GetPlayerSnapshot(*player, settings.protectFavorites);
+			for (const auto& plan : removed) {
+				RegisterResult result{};
+				if (!ConfirmRemoved(*after, plan, false, result)) {
+					job.lastMessage = std::move(result.message);
+					continue;
+				}
+
+				UndoRecord record{};
+				record.formId = plan.item->GetFormID();
+				record.regKey = plan.regKey->GetFormID();
+				record.group = plan.group;
+				record.buildContribution = BuildProgression::MakeRegistrationContribution(plan.group, plan.regKey->GetFormType());
+				if (record.buildContribution.has_value()) {
+					BatchOps::AccumulateContribution(contributions, record.buildContribution.value());
+				}
+				records.push_back(std::move(record));
+			}
+		}
+
+		if (!records.empty()) {
+			std::vector<std::pair<RE::FormID, std::uint32_t>> registered;
+			std::vector<RE::FormID>                           regKeys;
+			registered.reserve(records.size());
+			regKeys.reserve(records.size());
+			for (const auto& record : records) {
+				registered.emplace_back(record.regKey, record.group);
+				regKeys.push_back(record.regKey);
+			}
+
+			const auto commit = RegistrationStateStore::CommitRegisterBatch(std::move(records), job.actionId);
+			job.actionId = commit.actionId;
+			job.totalRegistered = commit.totalRegistered;
+			job.registered += registered.size();
+
+			EraseQuickListRegKeys(regKeys);
+			for (const auto& [regKey, group] : registered) {
+				NoteRegisteredInserted(regKey, group);
+			}
+			for (const auto& contribution : contributions) {
+				if (contribution.has_value()) {
+					job.buildChanged = BuildProgression::ApplyRegistrationContribution(contribution.value()) || job.buildChanged;
+				}
+			}
+			InvalidateQuickRegisterCache();
+		}
+
+		if (job.next < job.formIds.size()) {
+			return false;
+		}
+		FinishRegisterBatch(job);
+		return true;
+	}
+
+	void FinishRegisterBatch(RegisterBatchJob& job)
+	{
+		if (job.finished) {
+			return;
+		}
+		job.finished = true;
+
+		if (job.buildChanged) {
+			BuildEffectRuntime::SyncCurrentBuildEffectsToPlayer();
+		}
+		if (job.registered > 0) {
+			const auto msg =
+				L10n::T("msg.registerOkPrefix", "Registered: ") + std::to_string(job.registered) +
+				" (" + L10n::T("msg.totalPrefix", "total ") + std::to_string(job.totalRegistered) +
+				L10n::T("msg.totalSuffix", " items") + ")";
+			RE::DebugNotification(msg.c_str());
+		}
+	}
 }
@@ -1,9 +1,12 @@
 #include "CodexOfPowerNG/RegistrationStateStore.h"
 
+#include "CodexOfPowerNG/RegistrationBatchOps.h"
+#include "CodexOfPowerNG/RegistrationLookup.h"
 #include "CodexOfPowerNG/State.h"
 
 #include <algorithm>
 #include <atomic>
+#include <span>
 #include <utility>
 
 namespace CodexOfPowerNG::RegistrationStateStore
@@ -13,33 +16,20 @@ namespace CodexOfPowerNG::RegistrationStateStore
 		class RuntimeRegistrationStateStore final : public IRegistrationStateStore
 		{
 		public:
+			// Hot-path reads (loot events, quick-list rules) go through the lock-free lookup snapshot.
 			bool IsBlocked(RE::FormID formId) noexcept override
 			{
-				auto& state = GetState();
-				std::scoped_lock lock(state.mutex);
-				return state.blockedItems.contains(formId);
+				return RegistrationLookup::IsBlocked(formId);
 			}
 
 			bool IsRegistered(RE::FormID formId) noexcept override
 			{
-				auto& state = GetState();
-				std::scoped_lock lock(state.mutex);
-				return state.registeredItems.contains(formId);
+				return RegistrationLookup::IsRegistered(formId);
 			}
 
 			bool IsRegisteredEither(RE::FormID regKeyId, RE::FormID legacyId) noexcept override
 			{
-				auto& state = GetState();
-				std::scoped_lock lock(state.mutex);
-				if (state.registeredItems.contains(regKeyId)) {
-					return true;
-				}
-
-				// Backward compat: older data may have stored the non-template variant as the key.
-				if (legacyId != regKeyId) {
-					return state.registeredItems.contains(legacyId);
-				}
-				return false;
+				return RegistrationLookup::IsRegisteredEither(regKeyId, legacyId);
 			}
 
 			void BlockPair(RE::FormID regKeyId, RE::FormID itemId) noexcept override
@@ -53,13 +43,18 @@ namespace CodexOfPowerNG::RegistrationStateStore
 				if (itemId != 0 && itemId != regKeyId) {
 					state.blockedItems.insert(itemId);
 				}
+				state.saveGenerations.Bump(Serialization::SaveRecord::kBlocked);
+				RegistrationLookup::NoteBlockedLocked(regKeyId, itemId);
 			}
 
 			std::size_t InsertRegistered(RE::FormID regKeyId, std::uint32_t group) noexcept override
 			{
 				auto& state = GetState();
 				std::scoped_lock lock(state.mutex);
-				state.registeredItems.emplace(regKeyId, group);
+				if (state.registeredItems.emplace(regKeyId, group).second) {
+					state.saveGenerations.Bump(Serialization::SaveRecord::kRegistered);
+					RegistrationLookup::NoteRegisteredLocked(std::span(&regKeyId, 1));
+				}
 				return state.registeredItems.size();
 			}
 
@@ -67,69 +62,93 @@ namespace CodexOfPowerNG::RegistrationStateStore
 			{
 				auto& state = GetState();
 				std::scoped_lock lock(state.mutex);
-				return state.registeredItems.erase(regKeyId) > 0;
+				if (state.registeredItems.erase(regKeyId) == 0) {
+					return false;
+				}
+				state.saveGenerations.Bump(Serialization::SaveRecord::kRegistered);
+				RegistrationLookup::NoteUnregisteredLocked(regKeyId);
+				return true;
 			}
 
-			std::uint64_t PushUndoRecord(Registration::UndoRecord record) noexcept override
+			BatchCommitResult CommitRegisterBatch(
+				std::vector<Registration::UndoRecord> records,
+				std::uint64_t                         joinActionId) noexcept override
 			{
 				auto& state = GetState();
 				std::scoped_lock lock(state.mutex);
 
-				record.actionId = state.undoNextActionId++;
-				state.undoHistory.push_back(std::move(record));
-				while (state.undoHistory.size() > Registration::kUndoHistoryLimit) {
-					state.undoHistory.pop_front();
+				std::vector<RE::FormID> inserted;
+				inserted.reserve(records.size());
+				for (const auto& record : records) {
+					if (state.registeredItems.emplace(record.regKey, record.group).second) {
+						inserted.push_back(record.regKey);
+					}
 				}
-
-				return state.undoHistory.empty() ? 0 : state.undoHistory.back().actionId;
+				if (!inserted.empty()) {
+					state.saveGenerations.Bump(Serialization::SaveRecord::kRegistered);
+				}
+				state.saveGenerations.Bump(Serialization::SaveRecord::kUndo);
+				RegistrationLookup::NoteRegisteredLocked(inserted);
+
+				BatchCommitResult result{};
+				result.totalRegistered = state.registeredItems.size();
+				result.actionId = Registration::BatchOps::PushUndoGroup(
+					state.undoHistory.Write(),
+					state.undoNextActionId,
+					std::move(records),
+					joinActionId,
+					Registration::kUndoHistoryLimit);
+				return result;
 			}
 
-			std::optional<Registration::UndoRecord> PopLatestUndoRecord(std::uint64_t actionId) noexcept override
+			std::uint64_t PushUndoRecord(Registration::UndoRecord record) noexcept override
 			{
 				auto& state = GetState();
 				std::scoped_lock lock(state.mutex);
-				if (state.undoHistory.empty()) {
-					return std::nullopt;
-				}
-
-				const auto& latest = state.undoHistory.back();
-				if (latest.actionId != actionId) {
-					return std::nullopt;
-				}
 
-				auto out = std::move(state.undoHistory.back());
-				state.undoHistory.pop_back();
-				return out;
+				state.saveGenerations.Bump(Serialization::SaveRecord::kUndo);
+				std::vector<Registration::UndoRecord> group;
+				group.push_back(std::move(record));
+				return Registration::BatchOps::PushUndoGroup(
+					state.undoHistory.Write(),
+					state.undoNextActionId,
+					std::move(group),
+					0,
+					Registration::kUndoHistoryLimit);
 			}
 
-			void RestoreUndoRecord(Registration::UndoRecord record) noexcept override
+			std::vector<Registration::UndoRecord> PopLatestUndoGroup(std::uint64_t actionId) noexcept override
 			{
 				auto& state = GetState();
 				std::scoped_lock lock(state.mutex);
-				state.undoNextActionId = (std::max)(state.undoNextActionId, record.actionId + 1);
-				state.undoHistory.push_back(std::move(record));
-				while (state.undoHistory.size() > Registration::kUndoHistoryLimit) {
-					state.undoHistory.pop_front();
-				}
+				state.saveGenerations.Bump(Serialization::SaveRecord::kUndo);
+				return Registration::BatchOps::PopLatestUndoGroup(state.undoHistory.Write(), actionId);
 			}
 
-			std::vector<Registration::UndoRecord> SnapshotUndoRecords(std::size_t limit) noexcept override
+			void RestoreUndoGroup(std::vector<Registration::UndoRecord> records) noexcept override
 			{
-				std::vector<Registration::UndoRecord> out;
+				if (records.empty()) {
+					return;
+				}
+
 				auto& state = GetState();
 				std::scoped_lock lock(state.mutex);
-
-				if (state.undoHistory.empty()) {
-					return out;
+				const auto actionId = records.front().actionId;
+				state.saveGenerations.Bump(Serialization::SaveRecord::kUndo);
+				state.undoNextActionId = (std::max)(state.undoNextActionId, actionId + 1);
+				auto& undoHistory = state.undoHistory.Write();
+				for (auto& record : records) {
+					record.actionId = actionId;
+					undoHistory.push_back(std::move(record));
 				}
+				Registration::BatchOps::TrimUndoGroups(undoHistory, Registration::kUndoHistoryLimit);
+			}
 
-				const auto take = (std::min)(limit, state.undoHistory.size());
-				out.reserve(take);
-
-				for (auto it = state.undoHistory.rbegin(); it != state.undoHistory.rend() && out.size() < take; ++it) {
-					out.push_back(*it);
-				}
-				return out;
+			std::vector<std::vector<Registration::UndoRecord>> SnapshotUndoGroups(std::size_t limit) noexcept override
+			{
+				auto& state = GetState();
+				std::scoped_lock lock(state.mutex);
+				return Registration::BatchOps::SnapshotUndoGroups(*state.undoHistory, limit);
 			}
 
 			QuickListSnapshot SnapshotQuickList() noexcept override
@@ -139,10 +158,7 @@ namespace CodexOfPowerNG::RegistrationStateStore
 				std::scoped_lock  lock(state.mutex);
 
 				snapshot.blockedItems = state.blockedItems;
-				snapshot.registeredKeys.reserve(state.registeredItems.size() * 2);
-				for (const auto& [id, _] : state.registeredItems) {
-					snapshot.registeredKeys.insert(id);
-				}
+				snapshot.registeredItems = state.registeredItems;
 				return snapshot;
 			}
 
@@ -153,7 +169,7 @@ namespace CodexOfPowerNG::RegistrationStateStore
 				std::scoped_lock                                   lock(state.mutex);
 
 				out.reserve(state.registeredItems.size());
-				for (const auto& [id, group] : state.registeredItems) {
+				for (const auto& [id, group] : std::as_const(state.registeredItems)) {
 					out.emplace_back(id, group);
 				}
 				return out;
@@ -214,24 +230,31 @@ namespace CodexOfPowerNG::RegistrationStateStore
 		return GetStore().RemoveRegistered(regKeyId);
 	}
 
+	BatchCommitResult CommitRegisterBatch(
+		std::vector<Registration::UndoRecord> records,
+		std::uint64_t                         joinActionId) noexcept
+	{
+		return GetStore().CommitRegisterBatch(std::move(records), joinActionId);
+	}
+
 	std::uint64_t PushUndoRecord(Registration::UndoRecord record) noexcept
 	{
 		return GetStore().PushUndoRecord(std::move(record));
 	}
 
-	std::optional<Registration::UndoRecord> PopLatestUndoRecord(std::uint64_t actionId) noexcept
+	std::vector<Registration::UndoRecord> PopLatestUndoGroup(std::uint64_t actionId) noexcept
 	{
-		return GetStore().PopLatestUndoRecord(actionId);
+		return GetStore().PopLatestUndoGroup(actionId);
 	}
 
-	void RestoreUndoRecord(Registration::UndoRecord record) noexcept
+	void RestoreUndoGroup(std::vector<Registration::UndoRecord> records) noexcept
 	{
-		GetStore().RestoreUndoRecord(std::move(record));
+		GetStore().RestoreUndoGroup(std::move(records));
 	}
 
-	std::vector<Registration::UndoRecord> SnapshotUndoRecords(std::size_t limit) noexcept
+	std::vector<std::vector<Registration::UndoRecord>> SnapshotUndoGroups(std::size_t limit) noexcept
 	{
-		return GetStore().SnapshotUndoRecords(limit);
+		return GetStore().SnapshotUndoGroups(limit);
 	}
 
 	QuickListSnapshot SnapshotQuickList() noexcept
@@ -1,9 +1,15 @@
 #include "CodexOfPowerNG/Registration.h"
 
+#include "CodexOfPowerNG/ActorValueSync.h"
 #include "CodexOfPowerNG/BuildEffectRuntime.h"
 #include "CodexOfPowerNG/BuildProgression.h"
+#include "CodexOfPowerNG/Config.h"
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+#include "CodexOfPowerNG/Inventory.h"
 #include "CodexOfPowerNG/L10n.h"
+#include "CodexOfPowerNG/NamePool.h"
 #include "CodexOfPowerNG/RewardCaps.h"
+#include "CodexOfPowerNG/RegistrationBatchOps.h"
 #include "CodexOfPowerNG/RegistrationStateStore.h"
 #include "CodexOfPowerNG/Rewards.h"
 
@@ -12,23 +18,23 @@
 #include <SKSE/Logger.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace CodexOfPowerNG::Registration
 {
 	namespace
 	{
-		[[nodiscard]] std::string ResolveUndoItemName(const UndoRecord& record)
+		[[nodiscard]] NamePool::NameRef ResolveUndoItemName(const UndoRecord& record)
 		{
-			auto* primary = RE::TESForm::LookupByID(record.formId);
-			auto* fallback = RE::TESForm::LookupByID(record.regKey);
-			auto  name = Internal::BestItemName(primary, fallback);
-			if (name.empty()) {
-				name = L10n::T("ui.unnamed", "(unnamed)");
-			}
-			return name;
+			return NamePool::Resolve(
+				RE::TESForm::LookupByID(record.formId),
+				RE::TESForm::LookupByID(record.regKey));
 		}
 
 		[[nodiscard]] RE::TESBoundObject* ResolveUndoItemObject(const UndoRecord& record) noexcept
@@ -39,29 +45,55 @@ namespace CodexOfPowerNG::Registration
 			return RE::TESForm::LookupByID<RE::TESBoundObject>(record.regKey);
 		}
 
+		// Re-registers a record whose item could not be given back; the caller restores its undo entry.
 		void RollbackFailedUndo(const UndoRecord& record) noexcept
 		{
 			(void)RegistrationStateStore::InsertRegistered(record.regKey, record.group);
-			RegistrationStateStore::RestoreUndoRecord(record);
+			NoteRegisteredInserted(record.regKey, record.group);
+		}
+
+		// Puts the record's item back and returns its form id; 0 with `failure` set when it cannot be tried.
+		[[nodiscard]] RE::FormID RestoreRecordItem(RE::PlayerCharacter& player, const UndoRecord& record, std::string& failure)
+		{
+			if (!RegistrationStateStore::RemoveRegistered(record.regKey)) {
+				failure = L10n::T("msg.undoMissingRegistration", "Codex of Power: Undo failed (registration missing)");
+				return 0;
+			}
+			NoteRegisteredRemoved(record.regKey);
+
+			auto* restoreItem = ResolveUndoItemObject(record);
+			if (!restoreItem) {
+				RollbackFailedUndo(record);
+				failure = L10n::T("msg.undoItemMissing", "Codex of Power: Undo failed (item form missing)");
+				return 0;
+			}
+
+			player.AddObjectToContainer(restoreItem, nullptr, 1, nullptr);
+			Inventory::InvalidatePlayerSnapshot();
+			return restoreItem->GetFormID();
 		}
 	}
 
 	std::vector<UndoListItem> BuildRecentUndoList(std::size_t limit)
 	{
 		const auto take = (std::min)(limit, kUndoHistoryLimit);
-		auto records = RegistrationStateStore::SnapshotUndoRecords(take);
+		auto groups = RegistrationStateStore::SnapshotUndoGroups(take);
 
 		std::vector<UndoListItem> out;
-		out.reserve(records.size());
-		for (std::size_t i = 0; i < records.size(); ++i) {
-			const auto& record = records[i];
+		out.reserve(groups.size());
+		for (std::size_t i = 0; i < groups.size(); ++i) {
+			const auto& records = groups[i];
+			const auto& record = records.front();
 			UndoListItem item{};
 			item.actionId = record.actionId;
 			item.formId = record.formId;
 			item.regKey = record.regKey;
 			item.group = record.group;
+			item.itemCount = records.size();
 			item.canUndo = (i == 0);
-			item.hasRewardDelta = record.buildContribution.has_value() || !record.rewardDeltas.empty();
+			item.hasRewardDelta = std::any_of(records.begin(), records.end(), [](const UndoRecord& entry) {
+				return entry.buildContribution.has_value() || !entry.rewardDeltas.empty();
+			});
 			item.name = ResolveUndoItemName(record);
 			out.push_back(std::move(item));
 		}
@@ -73,79 +105,121 @@ namespace CodexOfPowerNG::Registration
 		UndoResult result{};
 		result.actionId = actionId;
 
-		auto recordOpt = RegistrationStateStore::PopLatestUndoRecord(actionId);
-		if (!recordOpt) {
+		auto records = RegistrationStateStore::PopLatestUndoGroup(actionId);
+		if (records.empty()) {
 			result.message = L10n::T(
 				"msg.undoOnlyLatest",
 				"Codex of Power: Undo is available only for the latest registration");
 			return result;
 		}
 
-		auto record = std::move(*recordOpt);
-		result.regKey = record.regKey;
-
-		if (!RegistrationStateStore::RemoveRegistered(record.regKey)) {
-			RegistrationStateStore::RestoreUndoRecord(record);
-			result.message = L10n::T("msg.undoMissingRegistration", "Codex of Power: Undo failed (registration missing)");
-			return result;
-		}
+		result.regKey = records.front().regKey;
 
 		auto* player = RE::PlayerCharacter::GetSingleton();
 		if (!player) {
-			RollbackFailedUndo(record);
+			RegistrationStateStore::RestoreUndoGroup(std::move(records));
 			result.message = L10n::T("msg.undoPlayerUnavailable", "Codex of Power: Undo failed (player unavailable)");
 			return result;
 		}
 
-		auto* restoreItem = ResolveUndoItemObject(record);
-		if (!restoreItem) {
-			RollbackFailedUndo(record);
-			result.message = L10n::T("msg.undoItemMissing", "Codex of Power: Undo failed (item form missing)");
-			return result;
+		// A batch is undone as a whole; records that cannot be given back stay registered and undoable.
+		// Counts come from one snapshot before and one after the whole group, not two walks per record.
+		const bool protectFavorites = GetSettings().protectFavorites;
+		const auto before = Inventory::GetPlayerSnapshot(*player, protectFavorites);
+
+		std::string             failure;
+		std::vector<RE::FormID> restoredIds(records.size(), 0);
+		for (std::size_t i = 0; i < records.size(); ++i) {
+			restoredIds[i] = RestoreRecordItem(*player, records[i], failure);
 		}
 
-		const auto oldCount = player->GetItemCount(restoreItem);
-		player->AddObjectToContainer(restoreItem, nullptr, 1, nullptr);
-		const auto newCount = player->GetItemCount(restoreItem);
-		if (newCount <= oldCount) {
-			RollbackFailedUndo(record);
-			result.message = L10n::T("msg.undoRestoreFailed", "Codex of Power: Undo failed (cannot restore item)");
+		const auto after = Inventory::GetPlayerSnapshot(*player, protectFavorites);
+		Containers::FlatFormIdMap<std::int32_t> gained;
+		for (const auto formId : restoredIds) {
+			if (formId != 0) {
+				gained.try_emplace(formId, after->CountOf(formId) - before->CountOf(formId));
+			}
+		}
+
+		std::vector<UndoRecord> undone;
+		std::vector<UndoRecord> kept;
+		for (std::size_t i = 0; i < records.size(); ++i) {
+			auto& record = records[i];
+			if (const auto formId = restoredIds[i]; formId != 0) {
+				if (auto& left = gained.find(formId)->second; left > 0) {
+					--left;
+					undone.push_back(std::move(record));
+					continue;
+				}
+				RollbackFailedUndo(record);
+				failure = L10n::T("msg.undoRestoreFailed", "Codex of Power: Undo failed (cannot restore item)");
+			}
+			kept.push_back(std::move(record));
+		}
+		if (!kept.empty()) {
+			RegistrationStateStore::RestoreUndoGroup(std::move(kept));
+		}
+		if (undone.empty()) {
+			result.message = std::move(failure);
 			return result;
 		}
 
-		bool hadRollbackTarget = false;
-		bool rollbackApplied = false;
-		if (record.buildContribution.has_value()) {
-			hadRollbackTarget =
-				record.buildContribution->recordDelta > 0 ||
-				record.buildContribution->pointsDeltaCenti > 0;
-			const auto rollbackResult =
-				BuildProgression::RollbackRegistrationContributionDetailed(record.buildContribution.value());
-			rollbackApplied = rollbackResult.scoreChanged || rollbackResult.deactivatedSlots > 0u;
-		} else {
-			const auto legacyRollbackApplied = Rewards::RollbackRewardDeltas(record.rewardDeltas);
-			hadRollbackTarget =
-				std::any_of(record.rewardDeltas.begin(), record.rewardDeltas.end(), [](const RewardDelta& entry) {
+		BuildContributionTotals contributions{};
+		std::vector<RewardDelta> legacyRewardDeltas;
+		for (const auto& record : undone) {
+			if (record.buildContribution.has_value()) {
+				BatchOps::AccumulateContribution(contributions, record.buildContribution.value());
+			} else {
+				legacyRewardDeltas.insert(legacyRewardDeltas.end(), record.rewardDeltas.begin(), record.rewardDeltas.end());
+			}
+		}
+
+		// Legacy reward rollback and the build effect resync land on the actor as one write per AV.
+		ActorValueSync::WriteBatch actorValueWrites;
+		bool                       hadRollbackTarget = false;
+		bool                       rollbackApplied = false;
+		bool                       buildChanged = false;
+		for (const auto& contribution : contributions) {
+			if (!contribution.has_value()) {
+				continue;
+			}
+			buildChanged = true;
+			hadRollbackTarget = hadRollbackTarget || contribution->recordDelta > 0 || contribution->pointsDeltaCenti > 0;
+			const auto rollbackResult = BuildProgression::RollbackRegistrationContributionDetailed(contribution.value());
+			rollbackApplied = rollbackApplied || rollbackResult.scoreChanged || rollbackResult.deactivatedSlots > 0u;
+		}
+		if (!legacyRewardDeltas.empty()) {
+			const auto legacyRollbackApplied = Rewards::RollbackRewardDeltas(legacyRewardDeltas);
+			hadRollbackTarget = hadRollbackTarget ||
+				std::any_of(legacyRewardDeltas.begin(), legacyRewardDeltas.end(), [](const RewardDelta& entry) {
 					return std::abs(entry.delta) > Rewards::kRewardCapEpsilon;
 				});
-			rollbackApplied = legacyRollbackApplied > 0;
+			rollbackApplied = rollbackApplied || legacyRollbackApplied > 0;
 		}
 		if (hadRollbackTarget && !rollbackApplied) {
 			SKSE::log::warn(
-				"Undo progression rollback: no state changes applied (actionId={}, regKey=0x{:08X})",
-				record.actionId,
-				static_cast<std::uint32_t>(record.regKey));
+				"Undo progression rollback: no state changes applied (actionId={}, regKey=0x{:08X}, records={})",
+				actionId,
+				static_cast<std::uint32_t>(result.regKey),
+				undone.size());
 		}
-		if (record.buildContribution.has_value()) {
+		if (buildChanged) {
 			BuildEffectRuntime::SyncCurrentBuildEffectsToPlayer();
 		}
+		// The index never tracked inventory variants of a registered regKey, so undo rescans once.
+		ResetQuickRegisterIndex();
 		InvalidateQuickRegisterCache();
 
-		const auto totalRegistered = RegistrationStateStore::SnapshotRegisteredItems().size();
+		std::string itemName = NamePool::TextOf(ResolveUndoItemName(undone.front()));
+		if (undone.size() > 1) {
+			itemName += " +" + std::to_string(undone.size() - 1);
+		}
+
+		const auto totalRegistered = RegistrationStateStore::RegisteredCount();
 		result.totalRegistered = totalRegistered;
 		result.success = true;
 		result.message =
-			L10n::T("msg.undoOkPrefix", "Undo: ") + ResolveUndoItemName(record) +
+			L10n::T("msg.undoOkPrefix", "Undo: ") + itemName +
 			" (" + L10n::T("msg.totalPrefix", "total ") +
 			std::to_string(totalRegistered) +
 			L10n::T("msg.totalSuffix", " items") + ")";
@@ -154,6 +228,9 @@ namespace CodexOfPowerNG::Registration
 				"msg.undoRewardRollbackWarning",
 				" [warning: reward rollback not applied]");
 		}
+		if (!failure.empty()) {
+			result.message += " " + failure;
+		}
 
 		RE::DebugNotification(result.message.c_str());
 		return result;
@@ -10,6 +10,7 @@ namespace CodexOfPowerNG::RewardStateStore
 	{
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
+		state.saveGenerations.Bump(Serialization::SaveRecord::kRewards);
 		return Ops::AdjustClamped(
 			state.rewardTotals,
 			av,
@@ -29,6 +30,7 @@ namespace CodexOfPowerNG::RewardStateStore
 	{
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
+		state.saveGenerations.Bump(Serialization::SaveRecord::kRewards);
 		return Ops::Take(state.rewardTotals, av);
 	}
 
@@ -37,6 +39,7 @@ namespace CodexOfPowerNG::RewardStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		Ops::Set(state.rewardTotals, av, total, Rewards::kRewardCapEpsilon);
+		state.saveGenerations.Bump(Serialization::SaveRecord::kRewards);
 	}
 
 	void Clear() noexcept
@@ -44,6 +47,7 @@ namespace CodexOfPowerNG::RewardStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		state.rewardTotals.clear();
+		state.saveGenerations.Bump(Serialization::SaveRecord::kRewards);
 	}
 
 	std::size_t Count() noexcept
@@ -64,6 +68,7 @@ namespace CodexOfPowerNG::RewardStateStore
 	{
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
+		state.saveGenerations.Bump(Serialization::SaveRecord::kRewards);
 		return Ops::ClampAll(
 			state.rewardTotals,
 			[](RE::ActorValue actorValue, float total) { return Rewards::ClampRewardTotal(actorValue, total); },
@@ -1,5 +1,6 @@
 #include "CodexOfPowerNG/Rewards.h"
 
+#include "CodexOfPowerNG/ActorValueSync.h"
 #include "CodexOfPowerNG/Config.h"
 #include "CodexOfPowerNG/L10n.h"
 #include "CodexOfPowerNG/RewardCaps.h"
@@ -150,6 +151,7 @@ namespace CodexOfPowerNG::Rewards
 			}
 
 			avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kPermanent, RE::ActorValue::kCarryWeight, delta);
+			Engine::MarkRewardActorValueDirty(RE::ActorValue::kCarryWeight);
 
 			// Migration: move from temporary to permanent channel only when
 			// temporary actually holds the reward (old ModActorValue path).
@@ -269,7 +271,7 @@ namespace CodexOfPowerNG::Rewards
 					CompleteRewardSyncRun(passState->generation);
 					return;
 				}
-				if (QueueMainTask([passState, remainingPasses]() { RunRewardSyncPasses(passState, remainingPasses); })) {
+				if (QueueMainTask(TaskPriority::kBackground, [passState, remainingPasses]() { RunRewardSyncPasses(passState, remainingPasses); })) {
 					return;
 				}
 
@@ -290,7 +292,7 @@ namespace CodexOfPowerNG::Rewards
 				auto rerunPassState = std::make_shared<RewardSyncPassState>();
 				rerunPassState->weaponAbilityRefreshRequested = passState->weaponAbilityRefreshRequested;
 				rerunPassState->generation = passState->generation;
-				if (QueueMainTask([rerunPassState]() { RunRewardSyncPasses(rerunPassState, kRewardSyncPassCount); })) {
+				if (QueueMainTask(TaskPriority::kBackground, [rerunPassState]() { RunRewardSyncPasses(rerunPassState, kRewardSyncPassCount); })) {
 					return true;
 				}
 				SKSE::log::warn("Reward sync: scheduler unavailable while queueing rerun; deferring rerun");
@@ -318,7 +320,7 @@ namespace CodexOfPowerNG::Rewards
 				return;
 			}
 
-			if (QueueMainTask([passState, remainingPasses]() { RunRewardSyncPasses(passState, remainingPasses - 1); })) {
+			if (QueueMainTask(TaskPriority::kBackground, [passState, remainingPasses]() { RunRewardSyncPasses(passState, remainingPasses - 1); })) {
 				return;
 			}
 
@@ -382,7 +384,7 @@ namespace CodexOfPowerNG::Rewards
 			passState->weaponAbilityRefreshRequested =
 				std::abs(Engine::SnapshotRewardTotalForActorValue(RE::ActorValue::kAttackDamageMult)) > kRewardCapEpsilon;
 
-		if (QueueMainTask([passState]() { RunRewardSyncPasses(passState, kRewardSyncPassCount); })) {
+		if (QueueMainTask(TaskPriority::kBackground, [passState]() { RunRewardSyncPasses(passState, kRewardSyncPassCount); })) {
 			return;
 		}
 
@@ -394,6 +396,7 @@ namespace CodexOfPowerNG::Rewards
 	void ResetSyncSchedulersForLoad() noexcept
 	{
 		const auto generation = SyncRuntime::BumpGenerationAndClearSchedulers();
+		Engine::MarkAllRewardActorValuesDirty();
 		SKSE::log::info("Reward sync schedulers reset for load boundary (generation {})", generation);
 	}
 
@@ -445,10 +448,11 @@ namespace CodexOfPowerNG::Rewards
 		Engine::NormalizeRewardCapsOnStateAndPlayer();
 		totals = Engine::SnapshotRewardTotals();
 		RewardStateStore::Clear();
+		Engine::MarkAllRewardActorValuesDirty();
 
 		bool carryWeightTouched = false;
 		for (const auto& [av, total] : totals) {
-			avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kPermanent, av, -total);
+			(void)ActorValueSync::ApplyPermanentDelta(av, -total, ActorValueSync::Layer::kRewards);
 			if (av == RE::ActorValue::kCarryWeight && std::abs(total) > kRewardCapEpsilon) {
 				carryWeightTouched = true;
 			}
@@ -475,10 +479,11 @@ namespace CodexOfPowerNG::Rewards
 			Engine::NormalizeRewardCapsOnStateAndPlayer();
 			auto totals = Engine::SnapshotRewardTotals();
 		RewardStateStore::Clear();
+		Engine::MarkAllRewardActorValuesDirty();
 
 		std::size_t cleared = 0;
 		for (const auto& [av, total] : totals) {
-			avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kPermanent, av, -total);
+			(void)ActorValueSync::ApplyPermanentDelta(av, -total, ActorValueSync::Layer::kRewards);
 			++cleared;
 		}
 
@@ -520,6 +525,7 @@ namespace CodexOfPowerNG::Rewards
 			if (!transition.existedBefore) {
 				continue;
 			}
+			Engine::MarkRewardActorValueDirty(av);
 
 			const float previousApplied = ActorAppliedRewardTotal(av, transition.previousTotal);
 			const float nextApplied = ActorAppliedRewardTotal(av, transition.nextTotal);
@@ -531,7 +537,7 @@ namespace CodexOfPowerNG::Rewards
 
 		bool carryWeightTouched = false;
 		for (const auto& adjustment : actorAdjustments) {
-			avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kPermanent, adjustment.av, adjustment.delta);
+			(void)ActorValueSync::ApplyPermanentDelta(adjustment.av, adjustment.delta, ActorValueSync::Layer::kRewards);
 			if (adjustment.av == RE::ActorValue::kCarryWeight) {
 				carryWeightTouched = true;
 			}
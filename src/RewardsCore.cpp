@@ -1,5 +1,7 @@
 #include "RewardsInternal.h"
+#include "RewardsSyncEngine.h"
 
+#include "CodexOfPowerNG/ActorValueSync.h"
 #include "CodexOfPowerNG/Config.h"
 #include "CodexOfPowerNG/L10n.h"
 #include "CodexOfPowerNG/RewardCaps.h"
@@ -53,6 +55,7 @@ namespace CodexOfPowerNG::Rewards::Internal
 		}
 
 		const auto transition = RewardStateStore::AdjustClamped(av, delta);
+		Engine::MarkRewardActorValueDirty(av);
 		outcome.stateDelta = transition.nextTotal - transition.previousTotal;
 		outcome.actorDelta =
 			ActorAppliedRewardTotal(av, transition.nextTotal) -
@@ -116,9 +119,10 @@ namespace CodexOfPowerNG::Rewards::Internal
 
 		float applied = amount * mult;
 
-		// ShoutRecoveryMult: lower is better (default 1.0, 0 removes cooldown)
+		// ShoutRecoveryMult: lower is better (default 1.0, 0 removes cooldown).
+		// Grants staged earlier in the same batch have not reached the actor yet.
 		if (av == RE::ActorValue::kShoutRecoveryMult) {
-			const float cur = avOwner->GetActorValue(av);
+			const float cur = avOwner->GetActorValue(av) + ActorValueSync::PendingDelta(av);
 			const float minValue = 0.30f;
 			if (cur <= minValue) {
 				applied = 0.0f;
@@ -146,7 +150,7 @@ namespace CodexOfPowerNG::Rewards::Internal
 		}
 
 		if (std::abs(outcome.actorDelta) > kRewardCapEpsilon) {
-			avOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kPermanent, av, outcome.actorDelta);
+			(void)ActorValueSync::ApplyPermanentDelta(av, outcome.actorDelta, ActorValueSync::Layer::kRewards);
 		}
 		CaptureAppliedRewardDelta(av, outcome.stateDelta);
 		if (av == RE::ActorValue::kCarryWeight && std::abs(outcome.actorDelta) > kRewardCapEpsilon) {
@@ -1,5 +1,6 @@
 #include "RewardsSyncEngine.h"
 
+#include "CodexOfPowerNG/ActorValueSync.h"
 #include "CodexOfPowerNG/RewardCaps.h"
 #include "CodexOfPowerNG/RewardStateStore.h"
 #include "CodexOfPowerNG/RewardsResync.h"
@@ -7,13 +8,12 @@
 
 #include <RE/Skyrim.h>
 
-#include <RE/T/TESObjectWEAP.h>
-
 #include <SKSE/Logger.h>
 
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -34,49 +34,29 @@ namespace CodexOfPowerNG::Rewards::Engine
 
 		using RewardCapAdjustment = RewardStateStore::RewardCapAdjustment;
 
-		[[nodiscard]] RE::ExtraDataList* PickFirstExtraDataList(RE::InventoryEntryData* entry) noexcept
+		struct ResyncTrackerState
 		{
-			if (!entry || !entry->extraLists) {
-				return nullptr;
-			}
+			std::mutex                                          mutex;
+			RewardResyncTracker<RE::ActorValue, ActorValueHash> tracker;
+		};
 
-			for (auto* extraData : *entry->extraLists) {
-				if (extraData) {
-					return extraData;
-				}
-			}
+		ResyncTrackerState g_resyncTracker{};
 
-			return nullptr;
+		[[nodiscard]] RewardActorObservation ObservationOf(const RewardActorSnapshot& snapshot) noexcept
+		{
+			return RewardActorObservation{ snapshot.base, snapshot.current, snapshot.permanent, snapshot.permanentModifier };
 		}
 
-		void RefreshEquippedWeaponAbilityForHand(RE::Actor* actor, bool leftHand) noexcept
+		[[nodiscard]] bool NeedsExamination(RE::ActorValue av, float expectedTotal, const RewardActorSnapshot& snapshot)
 		{
-			if (!actor) {
-				return;
-			}
-
-			auto* equippedForm = actor->GetEquippedObject(leftHand);
-			if (!equippedForm) {
-				return;
-			}
-			if (!equippedForm->As<RE::TESObjectWEAP>()) {
-				return;
-			}
-
-			auto* entry = actor->GetEquippedEntryData(leftHand);
-			auto* extraData = PickFirstExtraDataList(entry);
-			actor->UpdateWeaponAbility(equippedForm, extraData, leftHand);
+			std::scoped_lock lock(g_resyncTracker.mutex);
+			return g_resyncTracker.tracker.NeedsExamination(av, expectedTotal, ObservationOf(snapshot), kRewardCapEpsilon);
 		}
 
-		void RefreshEquippedWeaponAbilities() noexcept
+		void MarkSettled(RE::ActorValue av, float expectedTotal, const RewardActorSnapshot& snapshot)
 		{
-			auto* player = RE::PlayerCharacter::GetSingleton();
-			if (!player) {
-				return;
-			}
-
-			RefreshEquippedWeaponAbilityForHand(player, false);
-			RefreshEquippedWeaponAbilityForHand(player, true);
+			std::scoped_lock lock(g_resyncTracker.mutex);
+			g_resyncTracker.tracker.MarkSettled(av, expectedTotal, ObservationOf(snapshot));
 		}
 
 		void MigrateLegacyAttackDamageMultReward(RewardSyncPassState& passState) noexcept
@@ -202,6 +182,7 @@ namespace CodexOfPowerNG::Rewards::Engine
 
 			std::size_t appliedCount = 0;
 			for (const auto& entry : adjustments) {
+				MarkRewardActorValueDirty(entry.av);
 				const float base = avOwner->GetBaseActorValue(entry.av);
 				const float cur = avOwner->GetActorValue(entry.av);
 				const float permanent = avOwner->GetPermanentActorValue(entry.av);
@@ -275,6 +256,18 @@ namespace CodexOfPowerNG::Rewards::Engine
 		return totals;
 	}
 
+	void MarkRewardActorValueDirty(RE::ActorValue av) noexcept
+	{
+		std::scoped_lock lock(g_resyncTracker.mutex);
+		g_resyncTracker.tracker.MarkDirty(av);
+	}
+
+	void MarkAllRewardActorValuesDirty() noexcept
+	{
+		std::scoped_lock lock(g_resyncTracker.mutex);
+		g_resyncTracker.tracker.MarkAllDirty();
+	}
+
 	void PrepareRewardSyncPass(RewardSyncPassState& passState) noexcept
 	{
 		if (!passState.normalizeCapsOnFirstPass) {
@@ -308,6 +301,11 @@ namespace CodexOfPowerNG::Rewards::Engine
 				continue;
 			}
 			const auto snapshot = CaptureRewardActorSnapshot(player, avOwner, av, total);
+			if (!NeedsExamination(av, total, snapshot)) {
+				++passResult.skippedCount;
+				continue;
+			}
+			++passResult.examinedCount;
 			const float base = snapshot.base;
 			const float cur = snapshot.current;
 			const float permanent = snapshot.permanent;
@@ -383,6 +381,8 @@ namespace CodexOfPowerNG::Rewards::Engine
 			if (!applyImmediately && !ShouldApplyAfterStreak(delta, streak, minMissingStreak)) {
 				if (std::abs(delta) > kRewardCapEpsilon) {
 					++passResult.pendingCount;
+				} else if (!passState.nonConvergingActorValues.contains(av)) {
+					MarkSettled(av, total, snapshot);
 				}
 				continue;
 			}
@@ -459,6 +459,9 @@ namespace CodexOfPowerNG::Rewards::Engine
 					postSnapshot.permanentModifier, total, kRewardCapEpsilon);
 			}
 
+			if (std::abs(postDelta) <= kRewardCapEpsilon) {
+				MarkSettled(av, total, postSnapshot);
+			}
 			// Some AVs (e.g. multiplicative channels) can report no observable convergence
 			// even after ModActorValue succeeds, which would cause repeated re-application
 			// across this pass loop. Stop re-applying that AV within the same run.
@@ -490,6 +493,14 @@ namespace CodexOfPowerNG::Rewards::Engine
 		if (passResult.correctedCount > 0) {
 			SKSE::log::info("Reward sync: corrected {} actor value entries", passResult.correctedCount);
 		}
+		if (passResult.examinedCount > 0) {
+			SKSE::log::info(
+				"Reward sync pass: examined {} of {} tracked AV(s) ({} unchanged, skipped), adjusted {}",
+				passResult.examinedCount,
+				totals.size(),
+				passResult.skippedCount,
+				passResult.correctedCount);
+		}
 
 		return passResult;
 	}
@@ -500,7 +511,8 @@ namespace CodexOfPowerNG::Rewards::Engine
 			return;
 		}
 
-		RefreshEquippedWeaponAbilities();
+		ActorValueSync::WriteBatch actorValueWrites;
+		ActorValueSync::RequestWeaponAbilityRefresh();
 		SKSE::log::info("Reward sync: refreshed equipped weapon ability after attack damage sync");
 	}
 }
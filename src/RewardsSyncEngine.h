@@ -25,12 +25,19 @@ namespace CodexOfPowerNG::Rewards::Engine
 	{
 		std::size_t correctedCount{ 0 };
 		std::size_t pendingCount{ 0 };
+		std::size_t examinedCount{ 0 };
+		std::size_t skippedCount{ 0 };
 	};
 
 	[[nodiscard]] float SnapshotRewardTotalForActorValue(RE::ActorValue av) noexcept;
 	void NormalizeRewardCapsOnStateAndPlayer() noexcept;
 	[[nodiscard]] std::vector<std::pair<RE::ActorValue, float>> SnapshotRewardTotals() noexcept;
 
+	// Feed the resync tracker: we changed the AV's reward total or actor channels, so the next pass
+	// examines it even if its observed channels happen to match the last converged reading.
+	void MarkRewardActorValueDirty(RE::ActorValue av) noexcept;
+	void MarkAllRewardActorValuesDirty() noexcept;
+
 	void PrepareRewardSyncPass(RewardSyncPassState& passState) noexcept;
 	[[nodiscard]] RewardSyncPassResult ApplyRewardSyncPass(
 		RewardSyncPassState& passState,
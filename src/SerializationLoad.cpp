@@ -3,8 +3,11 @@
 #include "CodexOfPowerNG/BuildProgression.h"
 #include "CodexOfPowerNG/Constants.h"
 #include "CodexOfPowerNG/Registration.h"
+#include "CodexOfPowerNG/RegistrationBatchOps.h"
 #include "CodexOfPowerNG/RewardCaps.h"
 #include "CodexOfPowerNG/Rewards.h"
+#include "CodexOfPowerNG/SerializationFormIdRemap.h"
+#include "CodexOfPowerNG/SerializationRecordCodec.h"
 #include "CodexOfPowerNG/SerializationStateStore.h"
 
 #include <SKSE/Interfaces.h>
@@ -16,9 +19,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <exception>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace CodexOfPowerNG::Serialization::Internal
 {
@@ -128,6 +134,20 @@ namespace CodexOfPowerNG::Serialization::Internal
 			}
 		}
 
+		// Reads the rest of the current record with a single call.
+		[[nodiscard]] bool ReadWholeRecord(
+			SKSE::SerializationInterface* a_intfc,
+			std::uint32_t                 length,
+			std::vector<std::byte>&       buffer) noexcept
+		{
+			try {
+				buffer.resize(length);
+			} catch (const std::exception&) {
+				return false;
+			}
+			return length == 0 || a_intfc->ReadRecordData(buffer.data(), length) == length;
+		}
+
 		[[nodiscard]] bool ReadString(
 			SKSE::SerializationInterface* a_intfc,
 			std::uint32_t&                remaining,
@@ -164,109 +184,83 @@ namespace CodexOfPowerNG::Serialization::Internal
 		std::uint32_t version{};
 		std::uint32_t length{};
 		SerializationStateStore::Snapshot loadedState{};
+		std::vector<std::byte>            recordBytes;
+		std::vector<RE::FormID>           decodedIds;
+		std::vector<std::uint32_t>        decodedGroups;
+
+		// One ResolveFormID per plugin per load; the FormID records are remapped from the table in bulk.
+		FormIdRemap::Translation translation([a_intfc](RE::FormID oldId, RE::FormID& newId) {
+			return a_intfc->ResolveFormID(oldId, newId);
+		});
 
 		while (a_intfc->GetNextRecordInfo(type, version, length)) {
 			switch (type) {
 			case kRecordRegisteredItems: {
-				// v1: [count][FormID...]
-				// v2: [count][FormID, group(uint32)]...
-				std::uint32_t count{};
-				if (length < sizeof(count) || a_intfc->ReadRecordData(count) != sizeof(count)) {
-					SKSE::log::error("Failed to read registered count");
+				if (!ReadWholeRecord(a_intfc, length, recordBytes)) {
+					SKSE::log::error("Failed to read registered record");
 					return;
 				}
 
-				auto remaining = length - static_cast<std::uint32_t>(sizeof(count));
-
-				if (version == 1) {
-					const auto maxCount = remaining / static_cast<std::uint32_t>(sizeof(RE::FormID));
-					if (count > maxCount) {
-						count = maxCount;
-					}
-
-					for (std::uint32_t i = 0; i < count; ++i) {
-						RE::FormID oldId{};
-						if (a_intfc->ReadRecordData(oldId) != sizeof(oldId)) {
-							SKSE::log::error("Failed to read registered formId");
-							return;
-						}
-						remaining -= static_cast<std::uint32_t>(sizeof(oldId));
-
-						RE::FormID newId{};
-						if (!a_intfc->ResolveFormID(oldId, newId)) {
-							continue;
-						}
-
-					loadedState.registeredItems.emplace(newId, kGroupUnknown);
-					}
-				} else if (version == 2) {
-					const auto entrySize = static_cast<std::uint32_t>(sizeof(RE::FormID) + sizeof(std::uint32_t));
-					const auto maxCount = remaining / entrySize;
-					if (count > maxCount) {
-						count = maxCount;
-					}
-
-					for (std::uint32_t i = 0; i < count; ++i) {
-						RE::FormID oldId{};
-						std::uint32_t group{};
-						if (a_intfc->ReadRecordData(oldId) != sizeof(oldId) || a_intfc->ReadRecordData(group) != sizeof(group)) {
-							SKSE::log::error("Failed to read registered entry");
-							return;
-						}
-						remaining -= entrySize;
-
-						RE::FormID newId{};
-						if (!a_intfc->ResolveFormID(oldId, newId)) {
-							continue;
-						}
-
-						loadedState.registeredItems.emplace(newId, group);
-					}
-				} else {
-					SKSE::log::warn("Unsupported REGI version {}", version);
+				decodedIds.clear();
+				decodedGroups.clear();
+				decodedIds.reserve(RecordCodec::CountHint(recordBytes));
+				decodedGroups.reserve(RecordCodec::CountHint(recordBytes));
+				const auto decoded = RecordCodec::DecodeRegistered(
+					recordBytes,
+					version,
+					kGroupUnknown,
+					[&](RE::FormID oldId, std::uint32_t group) {
+						decodedIds.push_back(oldId);
+						decodedGroups.push_back(group);
+					});
+				if (decoded.status == RecordCodec::DecodeStatus::kTruncatedHeader) {
+					SKSE::log::error("Failed to read registered count");
+					return;
 				}
 
-				if (remaining > 0) {
-					Skip(a_intfc, remaining);
+				const auto kept = translation.RemapInPlace(std::span(decodedIds), std::span(decodedGroups));
+				loadedState.registeredItems.reserve(kept);
+				for (std::size_t i = 0; i < kept; ++i) {
+					loadedState.registeredItems.emplace(decodedIds[i], decodedGroups[i]);
+				}
+				if (decoded.status == RecordCodec::DecodeStatus::kUnsupportedVersion) {
+					SKSE::log::warn("Unsupported REGI version {}", version);
+				} else if (decoded.status == RecordCodec::DecodeStatus::kMalformed) {
+					SKSE::log::warn("Malformed REGI record: kept the first {} of {} entries", decoded.decoded, decoded.declared);
+				} else if (decoded.decoded < decoded.declared) {
+					SKSE::log::warn("REGI record truncated: {} of {} entries readable", decoded.decoded, decoded.declared);
 				}
 				break;
 			}
 			case kRecordBlockedItems:
 			case kRecordNotifiedItems: {
-				std::uint32_t count{};
-				if (length < sizeof(count) || a_intfc->ReadRecordData(count) != sizeof(count)) {
-					SKSE::log::error("Failed to read list count");
+				if (!ReadWholeRecord(a_intfc, length, recordBytes)) {
+					SKSE::log::error("Failed to read list record");
 					return;
 				}
 
-				auto remaining = length - static_cast<std::uint32_t>(sizeof(count));
-				const auto maxCount = remaining / static_cast<std::uint32_t>(sizeof(RE::FormID));
-				if (count > maxCount) {
-					count = maxCount;
+				decodedIds.clear();
+				decodedIds.reserve(RecordCodec::CountHint(recordBytes));
+				const auto decoded = RecordCodec::DecodeFormIds(recordBytes, version, [&](RE::FormID oldId) {
+					decodedIds.push_back(oldId);
+				});
+				if (decoded.status == RecordCodec::DecodeStatus::kTruncatedHeader) {
+					SKSE::log::error("Failed to read list count");
+					return;
 				}
 
-				for (std::uint32_t i = 0; i < count; ++i) {
-					RE::FormID oldId{};
-					if (a_intfc->ReadRecordData(oldId) != sizeof(oldId)) {
-						SKSE::log::error("Failed to read list formId");
-						return;
-					}
-					remaining -= static_cast<std::uint32_t>(sizeof(oldId));
-
-					RE::FormID newId{};
-					if (!a_intfc->ResolveFormID(oldId, newId)) {
-						continue;
-					}
-
-					if (type == kRecordBlockedItems) {
-						loadedState.blockedItems.insert(newId);
-					} else {
-						loadedState.notifiedItems.insert(newId);
-					}
+				auto&      target = type == kRecordBlockedItems ? loadedState.blockedItems : loadedState.notifiedItems;
+				const auto kept = translation.RemapInPlace(std::span(decodedIds));
+				target.reserve(kept);
+				for (std::size_t i = 0; i < kept; ++i) {
+					target.insert(decodedIds[i]);
 				}
-
-				if (remaining > 0) {
-					Skip(a_intfc, remaining);
+				if (decoded.status == RecordCodec::DecodeStatus::kUnsupportedVersion) {
+					SKSE::log::warn("Unsupported list record {:08X} version {}", type, version);
+				} else if (decoded.status == RecordCodec::DecodeStatus::kMalformed) {
+					SKSE::log::warn("Malformed list record {:08X}: kept the first {} of {} entries", type, decoded.decoded, decoded.declared);
+				} else if (decoded.decoded < decoded.declared) {
+					SKSE::log::warn("List record {:08X} truncated: {} of {} entries readable", type, decoded.decoded, decoded.declared);
 				}
 				break;
 			}
@@ -517,7 +511,8 @@ namespace CodexOfPowerNG::Serialization::Internal
 					static_cast<std::uint32_t>(sizeof(std::uint32_t));
 				const auto rewardDeltaSize = static_cast<std::uint32_t>(sizeof(std::uint32_t) + sizeof(float));
 
-				loadedState.undoHistory.clear();
+				auto& undoHistory = loadedState.undoHistory.Write();
+				undoHistory.clear();
 				for (std::uint32_t i = 0; i < count && remaining >= undoHeaderSize; ++i) {
 					Registration::UndoRecord entry{};
 					std::uint32_t            rewardCount{};
@@ -574,9 +569,9 @@ namespace CodexOfPowerNG::Serialization::Internal
 					remaining -= static_cast<std::uint32_t>(sizeof(rewardCount));
 
 					RE::FormID newRegKey{};
-					const bool regKeyResolved = a_intfc->ResolveFormID(oldRegKey, newRegKey);
+					const bool regKeyResolved = translation.ResolveFormID(oldRegKey, newRegKey);
 					RE::FormID newFormId{};
-					const bool formIdResolved = a_intfc->ResolveFormID(oldFormId, newFormId);
+					const bool formIdResolved = translation.ResolveFormID(oldFormId, newFormId);
 
 					const auto availableRewardCount = rewardDeltaSize > 0 ? (remaining / rewardDeltaSize) : 0;
 					const auto readableRewardCount = (std::min)(rewardCount, availableRewardCount);
@@ -627,14 +622,12 @@ namespace CodexOfPowerNG::Serialization::Internal
 					entry.regKey = newRegKey;
 					entry.formId = newFormId;
 
-					loadedState.undoHistory.push_back(std::move(entry));
-					while (loadedState.undoHistory.size() > Registration::kUndoHistoryLimit) {
-						loadedState.undoHistory.pop_front();
-					}
+					undoHistory.push_back(std::move(entry));
 				}
+				Registration::BatchOps::TrimUndoGroups(undoHistory, Registration::kUndoHistoryLimit);
 
-				if (!loadedState.undoHistory.empty()) {
-					const auto maxActionId = loadedState.undoHistory.back().actionId + 1;
+				if (!undoHistory.empty()) {
+					const auto maxActionId = undoHistory.back().actionId + 1;
 					loadedState.undoNextActionId = (std::max)(nextActionId, maxActionId);
 				} else {
 					loadedState.undoNextActionId = (std::max)(nextActionId, std::uint64_t{ 1 });
@@ -652,8 +645,15 @@ namespace CodexOfPowerNG::Serialization::Internal
 			}
 		}
 
+		SKSE::log::info(
+			"Co-save FormIDs remapped with {} plugin lookup(s); {} dropped (plugin no longer loaded)",
+			translation.ResolveCalls(),
+			translation.Dropped());
+
 		BuildProgression::NormalizeLoadedSnapshot(loadedState);
 		SerializationStateStore::ReplaceState(std::move(loadedState));
+		Registration::ResetQuickRegisterIndex();
+		Registration::ResetRegisteredListCache();
 		Registration::InvalidateQuickRegisterCache();
 	}
 }
@@ -2,6 +2,8 @@
 
 #include "CodexOfPowerNG/Constants.h"
 #include "CodexOfPowerNG/Registration.h"
+#include "CodexOfPowerNG/SerializationRecordCache.h"
+#include "CodexOfPowerNG/SerializationRecordCodec.h"
 #include "CodexOfPowerNG/SerializationStateStore.h"
 #include "CodexOfPowerNG/SerializationWriteFlow.h"
 
@@ -9,6 +11,10 @@
 #include <SKSE/Logger.h>
 
 #include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <string>
 
 namespace CodexOfPowerNG::Serialization::Internal
 {
@@ -16,244 +22,175 @@ namespace CodexOfPowerNG::Serialization::Internal
 	{
 		inline constexpr std::uint32_t kUndoRecordVersion = 4u;
 
-		[[nodiscard]] bool WriteString(SKSE::SerializationInterface* a_intfc, const std::string& value) noexcept
+		using SerializationStateStore::Snapshot;
+
+		void PutString(RecordCodec::ByteWriter& buffer, const std::string& value)
 		{
-			const auto length = static_cast<std::uint32_t>(value.size());
-			if (!a_intfc->WriteRecordData(length)) {
-				return false;
+			buffer.Put(static_cast<std::uint32_t>(value.size()));
+			if (!value.empty()) {
+				std::memcpy(buffer.Grow(value.size()), value.data(), value.size());
 			}
-			if (length == 0) {
-				return true;
-			}
-			return a_intfc->WriteRecordData(value.data(), length);
 		}
 
-		[[nodiscard]] bool WriteRegisteredRecord(SKSE::SerializationInterface* a_intfc,
-			const SerializationStateStore::Snapshot& state) noexcept
+		// Last encoded payload of every record, reused while the record's generation stays put.
+		EncodedRecordCache g_recordCache;
+
+		// Hands the record payload over in one call, encoding it into the cache first only when the
+		// stores changed the record since the previous save.
+		template <class Encode>
+		[[nodiscard]] bool WriteCachedRecord(
+			SKSE::SerializationInterface* a_intfc,
+			const Snapshot&               state,
+			SaveRecord                    record,
+			std::uint32_t                 type,
+			std::uint32_t                 version,
+			const char*                   tag,
+			SaveStats&                    stats,
+			Encode&&                      encode) noexcept
 		{
-			if (!a_intfc->OpenRecord(kRecordRegisteredItems, kSerializationVersion)) {
-				SKSE::log::error("Failed to open co-save record REGI");
+			if (!a_intfc->OpenRecord(type, version)) {
+				SKSE::log::error("Failed to open co-save record {}", tag);
 				return false;
 			}
 
-			const std::uint32_t count = static_cast<std::uint32_t>(state.registeredItems.size());
-			if (!a_intfc->WriteRecordData(count)) {
-				SKSE::log::error("Failed to write registered count");
+			const RecordCodec::ByteWriter* bytes = nullptr;
+			try {
+				bytes = &g_recordCache.Get(record, state.saveGenerations.Of(record), encode, stats);
+			} catch (const std::exception& e) {
+				SKSE::log::error("Failed to encode co-save record {}: {}", tag, e.what());
 				return false;
 			}
 
-			for (const auto& [formId, group] : state.registeredItems) {
-				if (!a_intfc->WriteRecordData(formId) || !a_intfc->WriteRecordData(group)) {
-					SKSE::log::error("Failed to write registered entry");
-					return false;
-				}
+			const auto size = bytes->size();
+			if (size > (std::numeric_limits<std::uint32_t>::max)() ||
+				!a_intfc->WriteRecordData(bytes->data(), static_cast<std::uint32_t>(size))) {
+				SKSE::log::error("Failed to write co-save record {} ({} bytes)", tag, size);
+				return false;
 			}
 			return true;
 		}
 
-		[[nodiscard]] bool WriteBlockedRecord(SKSE::SerializationInterface* a_intfc,
-			const SerializationStateStore::Snapshot& state) noexcept
+		[[nodiscard]] bool WriteRegisteredRecord(SKSE::SerializationInterface* a_intfc, const Snapshot& state, SaveStats& stats) noexcept
 		{
-			if (!a_intfc->OpenRecord(kRecordBlockedItems, kSerializationVersion)) {
-				SKSE::log::error("Failed to open co-save record BLCK");
-				return false;
-			}
-			const std::uint32_t count = static_cast<std::uint32_t>(state.blockedItems.size());
-			if (!a_intfc->WriteRecordData(count)) {
-				SKSE::log::error("Failed to write blocked count");
-				return false;
-			}
-			for (auto formId : state.blockedItems) {
-				if (!a_intfc->WriteRecordData(formId)) {
-					SKSE::log::error("Failed to write blocked formId");
-					return false;
-				}
-			}
-			return true;
+			return WriteCachedRecord(a_intfc, state, SaveRecord::kRegistered, kRecordRegisteredItems, RecordCodec::kRegisteredRecordVersion, "REGI", stats, [&](auto& buffer) {
+				RecordCodec::EncodeRegistered(buffer, state.registeredItems);
+			});
 		}
 
-		[[nodiscard]] bool WriteNotifiedRecord(SKSE::SerializationInterface* a_intfc,
-			const SerializationStateStore::Snapshot& state) noexcept
+		[[nodiscard]] bool WriteBlockedRecord(SKSE::SerializationInterface* a_intfc, const Snapshot& state, SaveStats& stats) noexcept
 		{
-			if (!a_intfc->OpenRecord(kRecordNotifiedItems, kSerializationVersion)) {
-				SKSE::log::error("Failed to open co-save record NTFY");
-				return false;
-			}
-			const std::uint32_t count = static_cast<std::uint32_t>(state.notifiedItems.size());
-			if (!a_intfc->WriteRecordData(count)) {
-				SKSE::log::error("Failed to write notified count");
-				return false;
-			}
-			for (auto formId : state.notifiedItems) {
-				if (!a_intfc->WriteRecordData(formId)) {
-					SKSE::log::error("Failed to write notified formId");
-					return false;
-				}
-			}
-			return true;
+			return WriteCachedRecord(a_intfc, state, SaveRecord::kBlocked, kRecordBlockedItems, RecordCodec::kFormIdListRecordVersion, "BLCK", stats, [&](auto& buffer) {
+				RecordCodec::EncodeFormIds(buffer, state.blockedItems);
+			});
 		}
 
-		[[nodiscard]] bool WriteBuildScoresRecord(
-			SKSE::SerializationInterface*          a_intfc,
-			const SerializationStateStore::Snapshot& state) noexcept
+		[[nodiscard]] bool WriteNotifiedRecord(SKSE::SerializationInterface* a_intfc, const Snapshot& state, SaveStats& stats) noexcept
 		{
-			if (!a_intfc->OpenRecord(kRecordBuildScores, 2u)) {
-				SKSE::log::error("Failed to open co-save record BSCR");
-				return false;
-			}
-			return a_intfc->WriteRecordData(state.attackScore) &&
-			       a_intfc->WriteRecordData(state.defenseScore) &&
-			       a_intfc->WriteRecordData(state.utilityScore) &&
-			       a_intfc->WriteRecordData(state.attackBuildPointsCenti) &&
-			       a_intfc->WriteRecordData(state.defenseBuildPointsCenti) &&
-			       a_intfc->WriteRecordData(state.utilityBuildPointsCenti);
+			return WriteCachedRecord(a_intfc, state, SaveRecord::kNotified, kRecordNotifiedItems, RecordCodec::kFormIdListRecordVersion, "NTFY", stats, [&](auto& buffer) {
+				RecordCodec::EncodeFormIds(buffer, state.notifiedItems);
+			});
 		}
 
-		[[nodiscard]] bool WriteBuildSlotsRecord(
-			SKSE::SerializationInterface*          a_intfc,
-			const SerializationStateStore::Snapshot& state) noexcept
+		[[nodiscard]] bool WriteBuildScoresRecord(SKSE::SerializationInterface* a_intfc, const Snapshot& state, SaveStats& stats) noexcept
 		{
-			if (!a_intfc->OpenRecord(kRecordBuildSlots, 1u)) {
-				SKSE::log::error("Failed to open co-save record BSLT");
-				return false;
-			}
-
-			const auto slotCount = static_cast<std::uint32_t>(state.activeBuildSlots.size());
-			if (!a_intfc->WriteRecordData(slotCount)) {
-				SKSE::log::error("Failed to write build slot count");
-				return false;
-			}
+			return WriteCachedRecord(a_intfc, state, SaveRecord::kBuildScores, kRecordBuildScores, 2u, "BSCR", stats, [&](auto& buffer) {
+				buffer.Put(state.attackScore);
+				buffer.Put(state.defenseScore);
+				buffer.Put(state.utilityScore);
+				buffer.Put(state.attackBuildPointsCenti);
+				buffer.Put(state.defenseBuildPointsCenti);
+				buffer.Put(state.utilityBuildPointsCenti);
+			});
+		}
 
-			for (const auto& slot : state.activeBuildSlots) {
-				if (!WriteString(a_intfc, slot)) {
-					SKSE::log::error("Failed to write build slot entry");
-					return false;
+		[[nodiscard]] bool WriteBuildSlotsRecord(SKSE::SerializationInterface* a_intfc, const Snapshot& state, SaveStats& stats) noexcept
+		{
+			return WriteCachedRecord(a_intfc, state, SaveRecord::kBuildSlots, kRecordBuildSlots, 1u, "BSLT", stats, [&](auto& buffer) {
+				buffer.Put(static_cast<std::uint32_t>(state.activeBuildSlots.size()));
+				for (const auto& slot : state.activeBuildSlots) {
+					PutString(buffer, slot);
 				}
-			}
-			return true;
+			});
 		}
 
-		[[nodiscard]] bool WriteBuildMigrationRecord(
-			SKSE::SerializationInterface*          a_intfc,
-			const SerializationStateStore::Snapshot& state) noexcept
+		[[nodiscard]] bool WriteBuildMigrationRecord(SKSE::SerializationInterface* a_intfc, const Snapshot& state, SaveStats& stats) noexcept
 		{
-			if (!a_intfc->OpenRecord(kRecordBuildMigration, 1u)) {
-				SKSE::log::error("Failed to open co-save record BMIG");
-				return false;
-			}
-
-			const auto migrationState = static_cast<std::uint32_t>(state.buildMigrationState);
-			const std::uint8_t needsNotice = state.buildMigrationNotice.needsNotice ? 1u : 0u;
-			const std::uint8_t legacyRewardsMigrated = state.buildMigrationNotice.legacyRewardsMigrated ? 1u : 0u;
-			return a_intfc->WriteRecordData(state.buildMigrationVersion) &&
-			       a_intfc->WriteRecordData(migrationState) &&
-			       a_intfc->WriteRecordData(needsNotice) &&
-			       a_intfc->WriteRecordData(legacyRewardsMigrated) &&
-			       a_intfc->WriteRecordData(state.buildMigrationNotice.unresolvedHistoricalRegistrations);
+			return WriteCachedRecord(a_intfc, state, SaveRecord::kBuildMigration, kRecordBuildMigration, 1u, "BMIG", stats, [&](auto& buffer) {
+				const auto migrationState = static_cast<std::uint32_t>(state.buildMigrationState);
+				const std::uint8_t needsNotice = state.buildMigrationNotice.needsNotice ? 1u : 0u;
+				const std::uint8_t legacyRewardsMigrated = state.buildMigrationNotice.legacyRewardsMigrated ? 1u : 0u;
+				buffer.Put(state.buildMigrationVersion);
+				buffer.Put(migrationState);
+				buffer.Put(needsNotice);
+				buffer.Put(legacyRewardsMigrated);
+				buffer.Put(state.buildMigrationNotice.unresolvedHistoricalRegistrations);
+			});
 		}
 
-		[[nodiscard]] bool WriteBuildAppliedEffectsRecord(
-			SKSE::SerializationInterface*           a_intfc,
-			const SerializationStateStore::Snapshot& state) noexcept
+		void PutActorValueTotals(RecordCodec::ByteWriter& buffer, const ActorValueTotals& totals)
 		{
-			if (!a_intfc->OpenRecord(kRecordBuildAppliedEffects, 1u)) {
-				SKSE::log::error("Failed to open co-save record BEFX");
-				return false;
+			buffer.Put(static_cast<std::uint32_t>(totals.size()));
+			for (const auto& [av, total] : totals) {
+				buffer.Put(static_cast<std::uint32_t>(av));
+				buffer.Put(total);
 			}
-
-			const std::uint32_t count = static_cast<std::uint32_t>(state.buildAppliedEffectTotals.size());
-			if (!a_intfc->WriteRecordData(count)) {
-				SKSE::log::error("Failed to write build applied effect count");
-				return false;
-			}
-
-			for (const auto& [av, total] : state.buildAppliedEffectTotals) {
-				const auto avRaw = static_cast<std::uint32_t>(av);
-				if (!a_intfc->WriteRecordData(avRaw) || !a_intfc->WriteRecordData(total)) {
-					SKSE::log::error("Failed to write build applied effect entry");
-					return false;
-				}
-			}
-			return true;
 		}
 
-		[[nodiscard]] bool WriteRewardsRecord(SKSE::SerializationInterface* a_intfc,
-			const SerializationStateStore::Snapshot& state) noexcept
+		[[nodiscard]] bool WriteBuildAppliedEffectsRecord(SKSE::SerializationInterface* a_intfc, const Snapshot& state, SaveStats& stats) noexcept
 		{
-			if (!a_intfc->OpenRecord(kRecordRewards, kSerializationVersion)) {
-				SKSE::log::error("Failed to open co-save record RWDS");
-				return false;
-			}
-			const std::uint32_t count = static_cast<std::uint32_t>(state.rewardTotals.size());
-			if (!a_intfc->WriteRecordData(count)) {
-				SKSE::log::error("Failed to write reward count");
-				return false;
-			}
-
-			for (const auto& [av, total] : state.rewardTotals) {
-				const auto avRaw = static_cast<std::uint32_t>(av);
-				if (!a_intfc->WriteRecordData(avRaw) || !a_intfc->WriteRecordData(total)) {
-					SKSE::log::error("Failed to write reward entry");
-					return false;
-				}
-			}
-			return true;
+			return WriteCachedRecord(a_intfc, state, SaveRecord::kBuildAppliedEffects, kRecordBuildAppliedEffects, 1u, "BEFX", stats, [&](auto& buffer) {
+				PutActorValueTotals(buffer, state.buildAppliedEffectTotals);
+			});
 		}
 
-		[[nodiscard]] bool WriteUndoRecord(SKSE::SerializationInterface* a_intfc,
-			const SerializationStateStore::Snapshot& state) noexcept
+		[[nodiscard]] bool WriteRewardsRecord(SKSE::SerializationInterface* a_intfc, const Snapshot& state, SaveStats& stats) noexcept
 		{
-			if (!a_intfc->OpenRecord(kRecordUndoHistory, kUndoRecordVersion)) {
-				SKSE::log::error("Failed to open co-save record UNDO");
-				return false;
-			}
-
-			const std::uint32_t count = static_cast<std::uint32_t>(state.undoHistory.size());
-			if (!a_intfc->WriteRecordData(count) || !a_intfc->WriteRecordData(state.undoNextActionId)) {
-				SKSE::log::error("Failed to write undo header");
-				return false;
-			}
-
-			for (const auto& entry : state.undoHistory) {
-				const std::uint32_t hasBuildContribution = entry.buildContribution.has_value() ? 1u : 0u;
-				const std::uint32_t disciplineRaw = entry.buildContribution.has_value()
-					? static_cast<std::uint32_t>(entry.buildContribution->discipline)
-					: 0u;
-				const std::int32_t recordDelta = entry.buildContribution.has_value()
-					? entry.buildContribution->recordDelta
-					: 0;
-				const std::int32_t pointsDeltaCenti = entry.buildContribution.has_value()
-					? entry.buildContribution->pointsDeltaCenti
-					: 0;
-				const std::uint32_t rewardCount = static_cast<std::uint32_t>(entry.rewardDeltas.size());
-				if (!a_intfc->WriteRecordData(entry.actionId) ||
-				    !a_intfc->WriteRecordData(entry.formId) ||
-				    !a_intfc->WriteRecordData(entry.regKey) ||
-				    !a_intfc->WriteRecordData(entry.group) ||
-				    !a_intfc->WriteRecordData(hasBuildContribution) ||
-				    !a_intfc->WriteRecordData(disciplineRaw) ||
-				    !a_intfc->WriteRecordData(recordDelta) ||
-				    !a_intfc->WriteRecordData(pointsDeltaCenti) ||
-				    !a_intfc->WriteRecordData(rewardCount)) {
-					SKSE::log::error("Failed to write undo entry header");
-					return false;
-				}
+			return WriteCachedRecord(a_intfc, state, SaveRecord::kRewards, kRecordRewards, kSerializationVersion, "RWDS", stats, [&](auto& buffer) {
+				PutActorValueTotals(buffer, state.rewardTotals);
+			});
+		}
 
-				for (const auto& delta : entry.rewardDeltas) {
-					const auto avRaw = static_cast<std::uint32_t>(delta.av);
-					if (!a_intfc->WriteRecordData(avRaw) || !a_intfc->WriteRecordData(delta.delta)) {
-						SKSE::log::error("Failed to write undo reward delta");
-						return false;
+		[[nodiscard]] bool WriteUndoRecord(SKSE::SerializationInterface* a_intfc, const Snapshot& state, SaveStats& stats) noexcept
+		{
+			return WriteCachedRecord(a_intfc, state, SaveRecord::kUndo, kRecordUndoHistory, kUndoRecordVersion, "UNDO", stats, [&](auto& buffer) {
+				buffer.Put(static_cast<std::uint32_t>(state.undoHistory->size()));
+				buffer.Put(state.undoNextActionId);
+
+				for (const auto& entry : *state.undoHistory) {
+					const std::uint32_t hasBuildContribution = entry.buildContribution.has_value() ? 1u : 0u;
+					const std::uint32_t disciplineRaw = entry.buildContribution.has_value()
+						? static_cast<std::uint32_t>(entry.buildContribution->discipline)
+						: 0u;
+					const std::int32_t recordDelta = entry.buildContribution.has_value()
+						? entry.buildContribution->recordDelta
+						: 0;
+					const std::int32_t pointsDeltaCenti = entry.buildContribution.has_value()
+						? entry.buildContribution->pointsDeltaCenti
+						: 0;
+					buffer.Put(entry.actionId);
+					buffer.Put(entry.formId);
+					buffer.Put(entry.regKey);
+					buffer.Put(entry.group);
+					buffer.Put(hasBuildContribution);
+					buffer.Put(disciplineRaw);
+					buffer.Put(recordDelta);
+					buffer.Put(pointsDeltaCenti);
+					buffer.Put(static_cast<std::uint32_t>(entry.rewardDeltas.size()));
+
+					for (const auto& delta : entry.rewardDeltas) {
+						buffer.Put(static_cast<std::uint32_t>(delta.av));
+						buffer.Put(delta.delta);
 					}
 				}
-			}
-			return true;
+			});
 		}
 	}
 
 	void Revert(SKSE::SerializationInterface* /*a_intfc*/) noexcept
 	{
 		SerializationStateStore::Clear();
+		Registration::ResetQuickRegisterIndex();
+		Registration::ResetRegisteredListCache();
 		Registration::InvalidateQuickRegisterCache();
 	}
 
@@ -261,18 +198,25 @@ namespace CodexOfPowerNG::Serialization::Internal
 	{
 		const auto state = SerializationStateStore::SnapshotState();
 
+		SaveStats  stats{};
 		const bool allOk = ExecuteAllSaveWriters(
-			[&]() { return WriteRegisteredRecord(a_intfc, state); },
-			[&]() { return WriteBlockedRecord(a_intfc, state); },
-			[&]() { return WriteNotifiedRecord(a_intfc, state); },
-			[&]() { return WriteBuildScoresRecord(a_intfc, state); },
-			[&]() { return WriteBuildSlotsRecord(a_intfc, state); },
-			[&]() { return WriteBuildMigrationRecord(a_intfc, state); },
-			[&]() { return WriteBuildAppliedEffectsRecord(a_intfc, state); },
-			[&]() { return WriteRewardsRecord(a_intfc, state); },
-			[&]() { return WriteUndoRecord(a_intfc, state); });
+			[&]() { return WriteRegisteredRecord(a_intfc, state, stats); },
+			[&]() { return WriteBlockedRecord(a_intfc, state, stats); },
+			[&]() { return WriteNotifiedRecord(a_intfc, state, stats); },
+			[&]() { return WriteBuildScoresRecord(a_intfc, state, stats); },
+			[&]() { return WriteBuildSlotsRecord(a_intfc, state, stats); },
+			[&]() { return WriteBuildMigrationRecord(a_intfc, state, stats); },
+			[&]() { return WriteBuildAppliedEffectsRecord(a_intfc, state, stats); },
+			[&]() { return WriteRewardsRecord(a_intfc, state, stats); },
+			[&]() { return WriteUndoRecord(a_intfc, state, stats); });
 		if (!allOk) {
 			SKSE::log::error("Serialization save completed with writer failures; co-save may be incomplete");
 		}
+		SKSE::log::info(
+			"Co-save: {} record(s) encoded ({} bytes), {} reused ({} bytes)",
+			stats.encodedRecords,
+			stats.encodedBytes,
+			stats.reusedRecords,
+			stats.reusedBytes);
 	}
 }
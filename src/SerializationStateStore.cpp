@@ -1,5 +1,6 @@
 #include "CodexOfPowerNG/SerializationStateStore.h"
 
+#include "CodexOfPowerNG/RegistrationLookup.h"
 #include "CodexOfPowerNG/SerializationStateStoreOps.h"
 #include "CodexOfPowerNG/State.h"
 
@@ -11,7 +12,9 @@ namespace CodexOfPowerNG::SerializationStateStore
 	{
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
-		return Ops::SnapshotState<Snapshot>(state);
+		auto snapshot = Ops::SnapshotState<Snapshot>(state);
+		snapshot.saveGenerations = state.saveGenerations;
+		return snapshot;
 	}
 
 	void ReplaceState(Snapshot snapshot) noexcept
@@ -19,6 +22,8 @@ namespace CodexOfPowerNG::SerializationStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		Ops::ReplaceState(state, std::move(snapshot));
+		state.saveGenerations.BumpAll();
+		RegistrationLookup::PublishLocked(state);
 	}
 
 	void Clear() noexcept
@@ -26,5 +31,7 @@ namespace CodexOfPowerNG::SerializationStateStore
 		auto& state = GetState();
 		std::scoped_lock lock(state.mutex);
 		Ops::Clear(state);
+		state.saveGenerations.BumpAll();
+		RegistrationLookup::PublishLocked(state);
 	}
 }
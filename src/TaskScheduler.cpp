@@ -1,10 +1,13 @@
 #include "CodexOfPowerNG/TaskScheduler.h"
 
+#include "CodexOfPowerNG/MainTaskQueue.h"
+
 #include <SKSE/SKSE.h>
 #include <SKSE/Logger.h>
 
 #include <atomic>
 #include <exception>
+#include <string_view>
 #include <utility>
 
 namespace CodexOfPowerNG
@@ -57,8 +60,37 @@ namespace CodexOfPowerNG
 			}
 		};
 
+		void LogMainTaskError(const char* what) noexcept
+		{
+			SKSE::log::error("Unhandled exception in queued main task: {}", what ? what : "unknown");
+		}
+
 		SKSETaskScheduler g_defaultScheduler;
 		std::atomic<ITaskScheduler*> g_overrideScheduler{ nullptr };
+		MainTaskQueue<> g_mainTasks{ kMainTaskFrameBudget, LogMainTaskError };
+
+		[[nodiscard]] bool EnqueueMainTask(TaskPriority priority, std::string_view key, ResumableTask task) noexcept
+		{
+			try {
+				return g_mainTasks.Enqueue(GetTaskScheduler(), priority, key, std::move(task));
+			} catch (const std::exception& e) {
+				SKSE::log::error("Failed to queue main task: {}", e.what());
+			} catch (...) {
+				SKSE::log::error("Failed to queue main task");
+			}
+			return false;
+		}
+
+		[[nodiscard]] ResumableTask RunOnce(ScheduledTask task)
+		{
+			if (!task) {
+				return {};
+			}
+			return [task = std::move(task)](std::chrono::microseconds) {
+				task();
+				return TaskStep::kDone;
+			};
+		}
 	}
 
 	ITaskScheduler& GetTaskScheduler() noexcept
@@ -76,11 +108,51 @@ namespace CodexOfPowerNG
 
 	bool QueueMainTask(ScheduledTask task) noexcept
 	{
-		return GetTaskScheduler().AddMainTask(std::move(task));
+		return QueueMainTask(TaskPriority::kNormal, std::move(task));
+	}
+
+	bool QueueMainTask(TaskPriority priority, ScheduledTask task) noexcept
+	{
+		return EnqueueMainTask(priority, {}, RunOnce(std::move(task)));
+	}
+
+	bool QueueCoalescedMainTask(std::string_view key, ScheduledTask task, TaskPriority priority) noexcept
+	{
+		return EnqueueMainTask(priority, key, RunOnce(std::move(task)));
+	}
+
+	bool QueueResumableMainTask(ResumableTask task, TaskPriority priority) noexcept
+	{
+		return EnqueueMainTask(priority, {}, std::move(task));
 	}
 
 	bool QueueUITask(ScheduledTask task) noexcept
 	{
 		return GetTaskScheduler().AddUITask(std::move(task));
 	}
+
+	MainTaskStats SnapshotMainTaskStats() noexcept
+	{
+		try {
+			return g_mainTasks.Snapshot();
+		} catch (...) {
+			return {};
+		}
+	}
+
+	void TickMainTaskFrame() noexcept
+	{
+		try {
+			g_mainTasks.Tick(GetTaskScheduler());
+		} catch (const std::exception& e) {
+			SKSE::log::error("Main task frame tick failed: {}", e.what());
+		} catch (...) {
+			SKSE::log::error("Main task frame tick failed");
+		}
+	}
+
+	std::uint64_t CurrentMainTaskFrame() noexcept
+	{
+		return g_mainTasks.CurrentFrame();
+	}
 }
@@ -1,14 +1,19 @@
 #include "CodexOfPowerNG/Constants.h"
+#include "CodexOfPowerNG/ActorValueSync.h"
 #include "CodexOfPowerNG/BuildEffectRuntime.h"
 #include "CodexOfPowerNG/BuildProgression.h"
 #include "CodexOfPowerNG/Config.h"
 #include "CodexOfPowerNG/Events.h"
+#include "CodexOfPowerNG/FrameHook.h"
 #include "CodexOfPowerNG/L10n.h"
+#include "CodexOfPowerNG/PostLoad.h"
 #include "CodexOfPowerNG/PrismaUIManager.h"
 #include "CodexOfPowerNG/Registration.h"
+#include "CodexOfPowerNG/RegistrationQuestGuard.h"
 #include "CodexOfPowerNG/Rewards.h"
 #include "CodexOfPowerNG/Serialization.h"
 #include "CodexOfPowerNG/SerializationStateStore.h"
+#include "CodexOfPowerNG/StartupPool.h"
 #include "CodexOfPowerNG/TaskScheduler.h"
 
 #include <RE/Skyrim.h>
@@ -22,10 +27,15 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/spdlog.h>
 
+#include <chrono>
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <string>
 #include <exception>
+#include <utility>
+#include <vector>
 
 namespace CodexOfPowerNG
 {
@@ -34,9 +44,16 @@ namespace CodexOfPowerNG
 		inline constexpr auto kLegacySVCollectionIniPath = "Data/MCM/Settings/SVCollection.ini";
 		inline constexpr auto kLegacyMCMKeybindsPath = "Data/MCM/Settings/keybinds.json";
 
+		inline constexpr std::chrono::milliseconds kPostLoadGameplayTimeout{ 30000 };
+		// Registered items tallied per migration-stage call; the pipeline re-runs it while the frame budget lasts.
+		inline constexpr std::size_t               kPostLoadMigrationChunk{ 256 };
+
 		bool g_hasLegacySVCollectionResidue{ false };
 		bool g_legacyResidueNotified{ false };
 
+		// Lives from kPostLoad to kDataLoaded; only the SKSE message thread touches it.
+		std::optional<Startup::WorkerPool> g_startupPool;
+
 		[[nodiscard]] bool FileExists(const std::filesystem::path& path)
 		{
 			std::error_code ec{};
@@ -132,10 +149,10 @@ namespace CodexOfPowerNG
 			return message;
 		}
 
-		void ProcessBuildMigrationState() noexcept
+		void ProcessBuildMigrationState(const BuildProgression::LegacyScoreTally* tally = nullptr) noexcept
 		{
 			auto snapshot = SerializationStateStore::SnapshotState();
-			BuildProgression::NormalizeLoadedSnapshot(snapshot);
+			BuildProgression::NormalizeLoadedSnapshot(snapshot, nullptr, tally);
 			(void)BuildProgression::TryFinalizePendingMigration(
 				snapshot,
 				[](const SerializationStateStore::Snapshot& /*ignored*/) noexcept {
@@ -153,6 +170,86 @@ namespace CodexOfPowerNG
 				RE::DebugNotification(message.c_str());
 			}
 		}
+
+		// Migration and effect resync run once the game is interactive, in frame-budgeted slices,
+		// instead of inside the load message. A later load cancels whatever is still pending.
+		void StartPostLoadPipeline()
+		{
+			const auto step = [](void (*fn)() noexcept) {
+				return [fn](std::chrono::microseconds) {
+					fn();
+					return StageStatus::kDone;
+				};
+			};
+
+			std::vector<PostLoad::Stage> stages;
+			stages.push_back({ "game-active", {}, PostLoad::WaitForGameplay(kPostLoadGameplayTimeout) });
+			// A pre-build save re-derives scores from every registered item: tally a chunk per call.
+			stages.push_back({ "build-migration", { "game-active" },
+				[tally = std::optional<BuildProgression::LegacyScoreTally>{}](std::chrono::microseconds) mutable {
+					if (!tally) {
+						tally = BuildProgression::BeginLegacyScoreTally(SerializationStateStore::SnapshotState());
+					}
+					if (!BuildProgression::ContinueLegacyScoreTally(*tally, kPostLoadMigrationChunk)) {
+						return StageStatus::kYield;
+					}
+					ProcessBuildMigrationState(&*tally);
+					return StageStatus::kDone;
+				} });
+			stages.push_back({ "build-effects", { "build-migration" },
+				[cursor = BuildEffectRuntime::BuildEffectSyncCursor{}](std::chrono::microseconds sliceBudget) mutable {
+					return BuildEffectRuntime::SyncCurrentBuildEffectsToPlayerSlice(cursor, sliceBudget) ?
+					           StageStatus::kDone :
+					           StageStatus::kYield;
+				} });
+			stages.push_back({ "legacy-notice", { "game-active" }, step([]() noexcept { NotifyLegacyResidueIfNeeded(); }) });
+			// The UI gates register/build/undo on postLoad.ready, so push the flag as soon as it flips.
+			PostLoad::Start(std::move(stages), []() {
+				if (!QueueUITask([]() { PrismaUIManager::SendStateToUI(); })) {
+					SKSE::log::warn("Post-load pipeline: failed to queue UI state refresh");
+				}
+			});
+		}
+
+		void LogClassificationCacheStats() noexcept
+		{
+			const auto stats = Registration::GetClassificationCacheStats();
+			SKSE::log::info(
+				"Item classification cache: {} hits, {} misses ({:.1f}% hit rate), {} entries, {} resets",
+				stats.hits,
+				stats.misses,
+				stats.HitRate() * 100.0,
+				stats.size,
+				stats.resets);
+		}
+
+		// File I/O and JSON decode that does not need game data. Settings go first: the lang stage reads them.
+		void StartBackgroundLoads()
+		{
+			g_startupPool.emplace(Startup::WorkerPool::DefaultThreadCount());
+			SKSE::log::info("Startup loads: {} worker thread(s)", g_startupPool->ThreadCount());
+
+			LoadSettingsFromDiskAsync(*g_startupPool);
+			L10n::LoadAsync(*g_startupPool);
+			Registration::PrepareAsync(*g_startupPool);
+		}
+
+		void FinishBackgroundLoads()
+		{
+			if (!g_startupPool) {
+				return;
+			}
+
+			g_startupPool->Join();
+			for (const auto& stage : g_startupPool->Timings()) {
+				SKSE::log::info(
+					"Startup stage '{}': waited {} us, ran {} us",
+					stage.name,
+					stage.waited.count(),
+					stage.ran.count());
+			}
+			g_startupPool.reset();
+		}
 	}
 
 	void SetupLogging()
@@ -244,18 +341,23 @@ namespace CodexOfPowerNG
 
 		switch (message->type) {
 		case SKSE::MessagingInterface::kPostLoad:
+			StartBackgroundLoads();
 			PrismaUIManager::OnPostLoad();
 			break;
 		case SKSE::MessagingInterface::kInputLoaded:
 			RegisterInputSink();
 			break;
 		case SKSE::MessagingInterface::kPreLoadGame:
+			LogClassificationCacheStats();
 			Rewards::ResetSyncSchedulersForLoad();
 			BuildEffectRuntime::ResetForLoad();
+			ActorValueSync::DiscardStagedForLoad();
+			PostLoad::Cancel();
 			PrismaUIManager::OnPreLoadGame();
 			break;
 		case SKSE::MessagingInterface::kDataLoaded:
 			Registration::Warmup();
+			FinishBackgroundLoads();
 			break;
 		case SKSE::MessagingInterface::kPostLoadGame:
 		case SKSE::MessagingInterface::kNewGame:
@@ -264,14 +366,14 @@ namespace CodexOfPowerNG
 			if (message->type == SKSE::MessagingInterface::kNewGame) {
 				Rewards::ResetSyncSchedulersForLoad();
 				BuildEffectRuntime::ResetForLoad();
+				ActorValueSync::DiscardStagedForLoad();
 			}
 			// Avoid doing UI work at the main menu. Create the view lazily on hotkey.
 			PrismaUIManager::OnGameLoaded();
 			Events::Install();
 			Events::OnGameLoaded();
-			ProcessBuildMigrationState();
-			BuildEffectRuntime::SyncCurrentBuildEffectsToPlayer();
-			NotifyLegacyResidueIfNeeded();
+			Registration::QuestGuard::OnGameLoaded();
+			StartPostLoadPipeline();
 			break;
 		default:
 			break;
@@ -286,11 +388,10 @@ SKSEPluginLoad(const SKSE::LoadInterface* skse)
 
 	SKSE::log::info("{} loaded", CodexOfPowerNG::kPluginName);
 
-	CodexOfPowerNG::LoadSettingsFromDisk();
-	CodexOfPowerNG::L10n::Load();
 	CodexOfPowerNG::g_hasLegacySVCollectionResidue = CodexOfPowerNG::DetectLegacySVCollectionResidue();
 
 	CodexOfPowerNG::Serialization::Install();
+	CodexOfPowerNG::FrameHook::Install();
 
 	auto* messaging = SKSE::GetMessagingInterface();
 	if (messaging) {
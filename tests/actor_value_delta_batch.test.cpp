@@ -0,0 +1,82 @@
+#include "CodexOfPowerNG/ActorValueDeltaBatch.h"
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	namespace ActorValueSync = CodexOfPowerNG::ActorValueSync;
+	using ActorValueSync::Layer;
+
+	using Writes = std::vector<std::pair<std::size_t, float>>;
+
+	[[nodiscard]] bool Near(float lhs, float rhs)
+	{
+		return lhs - rhs <= 0.0001f && rhs - lhs <= 0.0001f;
+	}
+
+	void MergesLayersIntoOneWritePerActorValue()
+	{
+		ActorValueSync::DeltaBatch<8> batch;
+		assert(batch.Empty());
+
+		assert(batch.Add(5, Layer::kRewards, -2.0f));      // undo takes back a legacy reward
+		assert(batch.Add(2, Layer::kBuildEffects, 0.10f));
+		assert(batch.Add(5, Layer::kBuildEffects, 3.0f));  // build effect grows on the same AV
+		assert(batch.Add(2, Layer::kBuildEffects, 0.05f));
+		assert(batch.TouchedCount() == 2);
+		assert(Near(batch.Pending(5), 1.0f));
+		assert(Near(batch.Pending(2), 0.15f));
+		assert(batch.Pending(7) == 0.0f);
+
+		Writes     writes;
+		const auto stats = batch.Flush([&](std::size_t av, float delta) { writes.emplace_back(av, delta); }, 0.001f);
+		assert(writes.size() == 2);
+		assert(writes[0].first == 5 && Near(writes[0].second, 1.0f));
+		assert(writes[1].first == 2 && Near(writes[1].second, 0.15f));
+		assert(stats.writes == 2 && stats.cancelled == 0);
+		assert(stats.staged[static_cast<std::size_t>(Layer::kRewards)] == 1);
+		assert(stats.staged[static_cast<std::size_t>(Layer::kBuildEffects)] == 3);
+
+		assert(batch.Empty());
+		assert(batch.Pending(5) == 0.0f);
+	}
+
+	void SkipsActorValuesWhoseLayersCancelOut()
+	{
+		ActorValueSync::DeltaBatch<8> batch;
+		assert(batch.Add(3, Layer::kRewards, -5.0f));
+		assert(batch.Add(3, Layer::kBuildEffects, 5.0f));
+		assert(batch.Add(4, Layer::kRewards, 1.0f));
+
+		Writes     writes;
+		const auto stats = batch.Flush([&](std::size_t av, float delta) { writes.emplace_back(av, delta); }, 0.001f);
+		assert(writes.size() == 1 && writes[0].first == 4);
+		assert(stats.writes == 1 && stats.cancelled == 1);
+
+		// A flushed batch starts over.
+		assert(batch.Add(3, Layer::kRewards, 2.0f));
+		writes.clear();
+		const auto next = batch.Flush([&](std::size_t av, float delta) { writes.emplace_back(av, delta); }, 0.001f);
+		assert(writes.size() == 1 && writes[0].first == 3 && Near(writes[0].second, 2.0f));
+		assert(next.staged[static_cast<std::size_t>(Layer::kRewards)] == 1 && next.cancelled == 0);
+	}
+
+	void RejectsOutOfRangeActorValues()
+	{
+		ActorValueSync::DeltaBatch<4> batch;
+		assert(!batch.Add(4, Layer::kRewards, 1.0f));
+		assert(batch.Empty());
+		assert(batch.Pending(9) == 0.0f);
+	}
+}
+
+int main()
+{
+	MergesLayersIntoOneWritePerActorValue();
+	SkipsActorValuesWhoseLayersCancelOut();
+	RejectsOutOfRangeActorValues();
+	return 0;
+}
@@ -3,7 +3,6 @@
 #include <cmath>
 #include <iostream>
 #include <optional>
-#include <vector>
 
 namespace
 {
@@ -18,15 +17,13 @@ namespace
 	}
 
 	[[nodiscard]] std::optional<float> LookupTotal(
-		const std::vector<std::pair<RE::ActorValue, float>>& totals,
-		RE::ActorValue av) noexcept
+		const CodexOfPowerNG::ActorValueTotals& totals,
+		RE::ActorValue                          av) noexcept
 	{
-		for (const auto& [entryAv, total] : totals) {
-			if (entryAv == av) {
-				return total;
-			}
+		if (!totals.contains(av)) {
+			return std::nullopt;
 		}
-		return std::nullopt;
+		return totals.Value(av);
 	}
 
 	BuildRuntimeSnapshot MakeSingleOptionSnapshot(
@@ -4,13 +4,16 @@
 
 #include <RE/Skyrim.h>
 
+#include <cstddef>
 #include <iostream>
 #include <optional>
 #include <string_view>
 
 namespace
 {
+	using CodexOfPowerNG::BuildProgression::BeginLegacyScoreTally;
 	using CodexOfPowerNG::BuildProgression::ConsumeMigrationNotice;
+	using CodexOfPowerNG::BuildProgression::ContinueLegacyScoreTally;
 	using CodexOfPowerNG::BuildProgression::ConvertLegacyGroupToDiscipline;
 	using CodexOfPowerNG::BuildProgression::NormalizeLoadedSnapshot;
 	using CodexOfPowerNG::BuildProgression::TryFinalizePendingMigration;
@@ -64,7 +67,7 @@ namespace
 			RE::ActorValue::kDamageResist,
 			5.0f,
 		});
-		snapshot.undoHistory.push_back(legacyUndo);
+		snapshot.undoHistory.Write().push_back(legacyUndo);
 		return snapshot;
 	}
 
@@ -107,6 +110,31 @@ namespace
 		       snapshot.activeBuildSlots[3].empty();
 	}
 
+	bool ChunkedTallyMatchesInlineMigration()
+	{
+		auto inlineSnapshot = BuildLegacySnapshot();
+		NormalizeLoadedSnapshot(inlineSnapshot, ResolveLegacyDisciplineForTest);
+
+		auto snapshot = BuildLegacySnapshot();
+		auto tally = BeginLegacyScoreTally(snapshot);
+		std::size_t calls = 1u;
+		while (!ContinueLegacyScoreTally(tally, 2u, ResolveLegacyDisciplineForTest)) {
+			++calls;
+		}
+		NormalizeLoadedSnapshot(snapshot, ResolveLegacyDisciplineForTest, &tally);
+
+		return calls == 4u &&
+		       snapshot.attackScore == inlineSnapshot.attackScore &&
+		       snapshot.defenseScore == inlineSnapshot.defenseScore &&
+		       snapshot.utilityScore == inlineSnapshot.utilityScore &&
+		       snapshot.attackBuildPointsCenti == inlineSnapshot.attackBuildPointsCenti &&
+		       snapshot.defenseBuildPointsCenti == inlineSnapshot.defenseBuildPointsCenti &&
+		       snapshot.utilityBuildPointsCenti == inlineSnapshot.utilityBuildPointsCenti &&
+		       snapshot.buildMigrationNotice.unresolvedHistoricalRegistrations == 1u &&
+		       snapshot.buildMigrationState == BuildMigrationState::kPendingCleanup &&
+		       BeginLegacyScoreTally(snapshot).Finished();
+	}
+
 	bool MigrationRetryKeepsDeterministicScores()
 	{
 		auto snapshot = BuildLegacySnapshot();
@@ -165,8 +193,8 @@ namespace
 
 		return snapshot.buildMigrationState == BuildMigrationState::kComplete &&
 		       snapshot.rewardTotals.empty() &&
-		       snapshot.undoHistory.size() == 1u &&
-		       snapshot.undoHistory.front().rewardDeltas.empty();
+		       snapshot.undoHistory->size() == 1u &&
+		       snapshot.undoHistory->front().rewardDeltas.empty();
 	}
 
 	bool MigrationNoticeIsOneShot()
@@ -199,7 +227,7 @@ namespace
 		snapshot.attackBuildPointsCenti = 900u;
 		snapshot.defenseBuildPointsCenti = 450u;
 		snapshot.utilityBuildPointsCenti = 700u;
-		snapshot.undoHistory.front().rewardDeltas.push_back({
+		snapshot.undoHistory.Write().front().rewardDeltas.push_back({
 			RE::ActorValue::kHealth,
 			3.0f,
 		});
@@ -213,7 +241,7 @@ namespace
 		       snapshot.defenseBuildPointsCenti == 450u &&
 		       snapshot.utilityBuildPointsCenti == 700u &&
 		       snapshot.buildMigrationState == BuildMigrationState::kComplete &&
-		       snapshot.undoHistory.front().rewardDeltas.empty() &&
+		       snapshot.undoHistory->front().rewardDeltas.empty() &&
 		       !ConsumeMigrationNotice(snapshot).has_value();
 	}
 
@@ -251,6 +279,9 @@ int main()
 	if (!expect(MigrationDerivesDeterministicScoresAndStagesCleanup(), "migration must derive deterministic scores and stage cleanup")) {
 		return 1;
 	}
+	if (!expect(ChunkedTallyMatchesInlineMigration(), "a legacy score tally run in chunks must match the inline migration")) {
+		return 1;
+	}
 	if (!expect(MigrationRetryKeepsDeterministicScores(), "migration retry must keep deterministic scores")) {
 		return 1;
 	}
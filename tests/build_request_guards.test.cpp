@@ -47,6 +47,18 @@ namespace
 		       request->formIds[1] == 51234u &&
 		       request->formIds[2] == 61234u;
 	}
+
+	bool BatchRequestDropsRepeatedFormIds()
+	{
+		const auto request = ParseRegisterBatchRequest(json{
+			{ "formIds", json::array({ 46775u, 51234u, 46775u, 61234u, 51234u }) },
+		});
+		return request.has_value() &&
+		       request->formIds.size() == 3u &&
+		       request->formIds[0] == 46775u &&
+		       request->formIds[1] == 51234u &&
+		       request->formIds[2] == 61234u;
+	}
 }
 
 int main()
@@ -70,6 +82,9 @@ int main()
 			"batch request must preserve one row per registration payload entry")) {
 		return 1;
 	}
+	if (!expect(BatchRequestDropsRepeatedFormIds(), "batch request must register a repeated form id once")) {
+		return 1;
+	}
 
 	return 0;
 }
@@ -11,7 +11,7 @@ const undoSrc = fs.readFileSync(path.join(repoRoot, "src", "RegistrationUndo.cpp
 
 test("build runtime sync is wired at gameplay boundaries", () => {
   assert.match(mainSrc, /BuildEffectRuntime::ResetForLoad\(\)/);
-  assert.match(mainSrc, /BuildEffectRuntime::SyncCurrentBuildEffectsToPlayer\(\)/);
+  assert.match(mainSrc, /BuildEffectRuntime::SyncCurrentBuildEffectsToPlayerSlice\(cursor, sliceBudget\)/);
   assert.match(requestOpsSrc, /BuildEffectRuntime::SyncCurrentBuildEffectsToPlayer\(\)/);
   assert.match(registerSrc, /BuildEffectRuntime::SyncCurrentBuildEffectsToPlayer\(\)/);
   assert.match(undoSrc, /BuildEffectRuntime::SyncCurrentBuildEffectsToPlayer\(\)/);
@@ -0,0 +1,37 @@
+#include "CodexOfPowerNG/CopyOnWrite.h"
+
+#include <cassert>
+#include <deque>
+#include <utility>
+#include <vector>
+
+int main()
+{
+	using History = CodexOfPowerNG::Containers::CopyOnWrite<std::deque<std::vector<int>>>;
+
+	History history;
+	assert(history->empty());
+	history.Write().push_back({ 1, 2 });
+	history.Write().push_back({ 3 });
+
+	History snapshot = history;
+	assert(snapshot.SharesWith(history));
+	assert(&*snapshot == &*history);
+
+	history.Write().front().push_back(9);
+	assert(!snapshot.SharesWith(history));
+	assert(snapshot->front().size() == 2 && history->front().size() == 3);
+
+	// Once the only other owner is gone, writes go to the value in place.
+	snapshot = History{};
+	const auto* before = &*history;
+	history.Write().pop_back();
+	assert(&*history == before && history->size() == 1);
+
+	History moved = std::move(history);
+	assert(moved->size() == 1 && history->empty());
+	history.Write().push_back({ 4 });
+	assert(history->size() == 1 && moved->front().size() == 3);
+
+	return 0;
+}
@@ -0,0 +1,156 @@
+#include "CodexOfPowerNG/DenseEnumMap.h"
+#include "CodexOfPowerNG/RewardStateStoreOps.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using CodexOfPowerNG::Containers::DenseEnumMap;
+
+	enum class AV : std::uint32_t
+	{
+		kHealth,
+		kMagicka,
+		kCarryWeight,
+		kSpeedMult = 70,
+		kShoutRecoveryMult = 130,
+		kTotal = 164,
+		kNone = static_cast<std::uint32_t>(-1),
+	};
+
+	using Totals = DenseEnumMap<AV, static_cast<std::size_t>(AV::kTotal)>;
+
+	bool NearlyEqual(float lhs, float rhs)
+	{
+		return std::abs(lhs - rhs) <= 0.0001f;
+	}
+
+	std::vector<std::pair<AV, float>> Entries(const Totals& totals)
+	{
+		std::vector<std::pair<AV, float>> entries;
+		for (const auto& [av, total] : totals) {
+			entries.emplace_back(av, total);
+		}
+		return entries;
+	}
+
+	void BehavesLikeTheMapItReplaces()
+	{
+		Totals totals;
+		assert(totals.empty() && totals.begin() == totals.end());
+
+		assert(totals.insert_or_assign(AV::kShoutRecoveryMult, -0.1f).second);
+		assert(!totals.insert_or_assign(AV::kShoutRecoveryMult, -0.2f).second);
+		assert(totals.emplace(AV::kHealth, 10.0f).second);
+		assert(!totals.emplace(AV::kHealth, 99.0f).second);
+		totals.Accumulate(AV::kSpeedMult, 0.05f);
+		totals.Accumulate(AV::kSpeedMult, 0.05f);
+
+		assert(totals.size() == 3);
+		assert(totals.contains(AV::kHealth) && !totals.contains(AV::kMagicka));
+		assert(NearlyEqual(totals.Value(AV::kHealth), 10.0f));
+		assert(totals.Value(AV::kMagicka) == 0.0f);
+
+		// Key order, regardless of insertion order.
+		const auto entries = Entries(totals);
+		assert(entries.size() == 3);
+		assert(entries[0].first == AV::kHealth && entries[1].first == AV::kSpeedMult);
+		assert(entries[2].first == AV::kShoutRecoveryMult && NearlyEqual(entries[2].second, -0.2f));
+		assert(NearlyEqual(entries[1].second, 0.1f));
+
+		auto it = totals.find(AV::kSpeedMult);
+		it->second = 0.3f;
+		assert(NearlyEqual(totals.Value(AV::kSpeedMult), 0.3f));
+
+		it = totals.erase(it);
+		assert(it != totals.end() && it->first == AV::kShoutRecoveryMult);
+		assert(totals.erase(AV::kSpeedMult) == 0);
+		assert(totals.erase(AV::kHealth) == 1);
+		assert(totals.size() == 1);
+
+		// Erased slots read as zero again.
+		totals.Accumulate(AV::kHealth, 1.0f);
+		assert(NearlyEqual(totals.Value(AV::kHealth), 1.0f));
+
+		assert(totals.find(AV::kNone) == totals.end());
+		assert(!totals.insert_or_assign(AV::kNone, 1.0f).second);
+		totals.Accumulate(AV::kTotal, 1.0f);
+		assert(totals.size() == 2);
+
+		const Totals copy = totals;
+		assert(copy == totals);
+		totals.clear();
+		assert(totals.empty() && totals.Value(AV::kHealth) == 0.0f && copy != totals);
+	}
+
+	void DifferenceCoversBothKeySetsAndPruneDropsZeros()
+	{
+		Totals desired;
+		desired.insert_or_assign(AV::kHealth, 10.0f);
+		desired.insert_or_assign(AV::kCarryWeight, 25.0f);
+
+		Totals applied;
+		applied.insert_or_assign(AV::kHealth, 10.0f);
+		applied.insert_or_assign(AV::kSpeedMult, 0.1f);
+
+		auto deltas = Totals::Difference(desired, applied);
+		assert(deltas.size() == 3);
+		const auto entries = Entries(deltas);
+		assert(entries[0].first == AV::kHealth && entries[0].second == 0.0f);
+		assert(entries[1].first == AV::kCarryWeight && NearlyEqual(entries[1].second, 25.0f));
+		assert(entries[2].first == AV::kSpeedMult && NearlyEqual(entries[2].second, -0.1f));
+
+		deltas.Accumulate(AV::kCarryWeight, -24.9995f);
+		assert(deltas.Prune(0.001f) == 2);
+		assert(deltas.size() == 1 && deltas.contains(AV::kSpeedMult));
+		assert(deltas.Value(AV::kCarryWeight) == 0.0f);
+		assert(deltas.Prune(0.001f) == 0);
+	}
+
+	void RewardStoreOpsRunThroughTheTable()
+	{
+		namespace Ops = CodexOfPowerNG::RewardStateStore::Ops;
+
+		constexpr float epsilon = 0.001f;
+		auto            clamp = [](AV av, float total) {
+			return av == AV::kSpeedMult ? (std::min)(total, 0.5f) : total;
+		};
+
+		Totals totals;
+		const auto first = Ops::AdjustClamped(totals, AV::kSpeedMult, 0.8f, clamp, epsilon);
+		assert(!first.existedBefore && NearlyEqual(first.nextTotal, 0.5f));
+		const auto second = Ops::AdjustClamped(totals, AV::kSpeedMult, -0.5f, clamp, epsilon);
+		assert(second.existedBefore && NearlyEqual(second.previousTotal, 0.5f));
+		assert(!Ops::Get(totals, AV::kSpeedMult).has_value());
+
+		Ops::Set(totals, AV::kHealth, 10.0f, epsilon);
+		Ops::Set(totals, AV::kCarryWeight, 5.0f, epsilon);
+		totals.insert_or_assign(AV::kSpeedMult, 0.75f);
+		assert(NearlyEqual(*Ops::Get(totals, AV::kHealth), 10.0f));
+
+		const auto adjustments = Ops::ClampAll(totals, clamp, epsilon);
+		assert(adjustments.size() == 1 && adjustments[0].av == AV::kSpeedMult);
+		assert(NearlyEqual(totals.Value(AV::kSpeedMult), 0.5f));
+
+		const auto snapshot = Ops::Snapshot(totals);
+		assert(snapshot.size() == 3 && snapshot.front().first == AV::kHealth);
+
+		assert(NearlyEqual(*Ops::Take(totals, AV::kCarryWeight), 5.0f));
+		assert(!totals.contains(AV::kCarryWeight));
+		Ops::Set(totals, AV::kHealth, 0.0f, epsilon);
+		assert(totals.size() == 1);
+	}
+}
+
+int main()
+{
+	BehavesLikeTheMapItReplaces();
+	DifferenceCoversBothKeySetsAndPruneDropsZeros();
+	RewardStoreOpsRunThroughTheTable();
+	return 0;
+}
@@ -0,0 +1,277 @@
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+#include "CodexOfPowerNG/RewardStateStoreOps.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using CodexOfPowerNG::Containers::FlatFormIdMap;
+	using CodexOfPowerNG::Containers::FlatFormIdSet;
+
+	struct Rng
+	{
+		std::uint64_t state{ 0x2545F4914F6CDD1Dull };
+
+		[[nodiscard]] std::uint32_t Below(std::uint32_t bound) noexcept
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return static_cast<std::uint32_t>(state % bound);
+		}
+	};
+
+	template <class Table, class Reference>
+	void AssertSameContents(const Table& table, const Reference& reference)
+	{
+		assert(table.size() == reference.size());
+		std::size_t visited = 0;
+		for (const auto& entry : table) {
+			if constexpr (std::is_same_v<Table, FlatFormIdSet>) {
+				assert(reference.contains(entry));
+			} else {
+				const auto it = reference.find(entry.first);
+				assert(it != reference.end() && it->second == entry.second);
+			}
+			++visited;
+		}
+		assert(visited == reference.size());
+	}
+
+	void SetBasics()
+	{
+		FlatFormIdSet set;
+		assert(set.empty() && set.capacity() == 0);
+		assert(!set.contains(0) && set.begin() == set.end());
+		assert(set.erase(5u) == 0);
+
+		assert(set.insert(0x01020304u).second);
+		assert(!set.insert(0x01020304u).second);
+		assert(set.insert(0u).second);  // 0 is an ordinary key; emptiness lives in the control bytes
+		assert(set.contains(0u) && set.contains(0x01020304u) && !set.contains(0x01020305u));
+		assert(set.size() == 2 && set.count(0u) == 1);
+
+		assert(set.erase(0u) == 1);
+		assert(!set.contains(0u) && set.size() == 1);
+
+		const FlatFormIdSet listed{ 7u, 9u, 7u };
+		assert(listed.size() == 2 && listed.contains(9u));
+
+		set.clear();
+		assert(set.empty() && set.capacity() != 0 && !set.contains(0x01020304u));
+	}
+
+	void MapBasics()
+	{
+		FlatFormIdMap<std::uint32_t> map;
+		assert(map.emplace(0x10u, 1u).second);
+		assert(!map.emplace(0x10u, 2u).second);
+		assert(map.find(0x10u)->second == 1u);
+
+		assert(!map.insert_or_assign(0x10u, 3u).second);
+		assert(map.find(0x10u)->second == 3u);
+		map[0x20u] += 4u;
+		assert(map[0x20u] == 4u);
+
+		for (const auto& [formId, group] : map) {
+			assert((formId == 0x10u && group == 3u) || (formId == 0x20u && group == 4u));
+		}
+
+		const auto it = map.find(0x10u);
+		map.erase(it);
+		assert(!map.contains(0x10u) && map.size() == 1);
+	}
+
+	// Random inserts and erases over a small id space (lots of tombstones and in-place rehashes)
+	// must track std::unordered_map exactly.
+	void MatchesUnorderedMapUnderChurn()
+	{
+		FlatFormIdMap<std::uint32_t>                     map;
+		FlatFormIdSet                                    set;
+		std::unordered_map<std::uint32_t, std::uint32_t> referenceMap;
+		std::unordered_set<std::uint32_t>                referenceSet;
+
+		Rng rng;
+		for (std::uint32_t step = 0; step < 60000; ++step) {
+			// Mix dense low ids with ids that differ only in the load-order byte.
+			const auto id = rng.Below(2) == 0 ? rng.Below(3000) : (rng.Below(256) << 24) | rng.Below(8);
+			switch (rng.Below(4)) {
+			case 0:
+			case 1:
+				assert(map.insert_or_assign(id, step).second == referenceMap.insert_or_assign(id, step).second);
+				assert(set.insert(id).second == referenceSet.insert(id).second);
+				break;
+			case 2:
+				assert(map.erase(id) == referenceMap.erase(id));
+				assert(set.erase(id) == referenceSet.erase(id));
+				break;
+			default:
+				assert(map.contains(id) == referenceMap.contains(id));
+				assert(set.contains(id) == referenceSet.contains(id));
+				break;
+			}
+		}
+		AssertSameContents(map, referenceMap);
+		AssertSameContents(set, referenceSet);
+		assert(map.size() - map.size() / 8 <= map.capacity());
+
+		// Erasing while iterating visits every remaining entry exactly once.
+		std::size_t kept = 0;
+		for (auto it = map.begin(); it != map.end();) {
+			if (it->first % 3 == 0) {
+				referenceMap.erase(it->first);
+				it = map.erase(it);
+			} else {
+				++kept;
+				++it;
+			}
+		}
+		assert(kept == referenceMap.size());
+		AssertSameContents(map, referenceMap);
+	}
+
+	void CopiesAreIndependentAndMovesEmpty()
+	{
+		FlatFormIdSet original;
+		original.reserve(1000);
+		const auto capacity = original.capacity();
+		for (std::uint32_t id = 1; id <= 1000; ++id) {
+			original.insert(id * 7919u);
+		}
+		assert(original.capacity() == capacity);
+
+		FlatFormIdSet copy = original;
+		assert(copy == original);
+		copy.erase(7919u);
+		assert(!(copy == original) && original.contains(7919u));
+
+		FlatFormIdSet moved = std::move(copy);
+		assert(moved.size() == 999);
+		assert(copy.empty() && copy.begin() == copy.end() && !copy.contains(7919u * 2u));
+		copy.insert(3u);
+		assert(copy.size() == 1 && copy.contains(3u));
+	}
+
+	// Copies share the arrays until one side writes; reads and erase misses never unshare.
+	void CopiesShareUntilWritten()
+	{
+		FlatFormIdMap<std::uint32_t> state;
+		for (std::uint32_t id = 1; id <= 500; ++id) {
+			state.emplace(id, id % 6);
+		}
+
+		const auto snapshot = state;
+		assert(snapshot.shares_storage_with(state));
+		assert(state.contains(7u) && state.erase(9999u) == 0);
+		assert(std::as_const(state).find(7u)->second == 1u);
+		for (const auto& entry : std::as_const(state)) {
+			(void)entry;
+		}
+		assert(snapshot.shares_storage_with(state));
+
+		state.insert_or_assign(7u, 5u);
+		state.erase(8u);
+		state.emplace(1000u, 2u);
+		assert(!snapshot.shares_storage_with(state));
+		assert(snapshot.find(7u)->second == 1u && snapshot.contains(8u) && !snapshot.contains(1000u));
+		assert(state.find(7u)->second == 5u && !state.contains(8u) && state.contains(1000u));
+		assert(snapshot.size() == 500 && state.size() == 500);
+
+		// Mutable iteration over a shared map unshares first, so the snapshot keeps its values.
+		auto second = state;
+		for (auto& [id, group] : second) {
+			group = id;
+		}
+		assert(state.find(7u)->second == 5u && second.find(7u)->second == 7u);
+
+		FlatFormIdSet set{ 1u, 2u, 3u };
+		const auto frozen = set;
+		set.clear();
+		assert(set.empty() && frozen.size() == 3 && frozen.contains(2u));
+		set.insert(4u);
+		assert(!frozen.contains(4u));
+	}
+
+	// A reader walks a snapshot on another thread while the owner keeps writing and snapshotting.
+	void SnapshotsSurviveConcurrentWriter()
+	{
+		FlatFormIdSet     state;
+		FlatFormIdSet     published;
+		std::mutex        mutex;
+		std::atomic_bool  stop{ false };
+		std::atomic<bool> failed{ false };
+
+		std::thread reader([&]() {
+			while (!stop.load(std::memory_order_relaxed)) {
+				FlatFormIdSet snapshot;
+				{
+					std::scoped_lock lock(mutex);
+					snapshot = published;
+				}
+				std::uint64_t count = 0;
+				for (const auto id : snapshot) {
+					count += snapshot.contains(id) ? 1u : 0u;
+				}
+				if (count != snapshot.size()) {
+					failed.store(true);
+				}
+				std::this_thread::yield();
+			}
+		});
+
+		for (std::uint32_t round = 1; round <= 2000; ++round) {
+			std::scoped_lock lock(mutex);
+			state.insert(round);
+			if (round % 3 == 0) {
+				state.erase(round / 3);
+			}
+			published = state;
+		}
+		stop.store(true);
+		reader.join();
+		assert(!failed.load());
+	}
+
+	void PlugsIntoRewardStateStoreOps()
+	{
+		namespace Ops = CodexOfPowerNG::RewardStateStore::Ops;
+
+		FlatFormIdMap<float> totals;
+		constexpr float epsilon = 0.001f;
+		auto clamp = [](std::uint32_t av, float total) { return av == 1u ? std::clamp(total, -10.0f, 10.0f) : total; };
+
+		const auto first = Ops::AdjustClamped(totals, 1u, 15.0f, clamp, epsilon);
+		assert(!first.existedBefore && first.nextTotal == 10.0f);
+		Ops::Set(totals, 2u, 4.0f, epsilon);
+		Ops::Set(totals, 3u, 0.0f, epsilon);
+		assert(Ops::Snapshot(totals).size() == 2);
+
+		totals.insert_or_assign(1u, 30.0f);
+		const auto adjustments = Ops::ClampAll(totals, clamp, epsilon);
+		assert(adjustments.size() == 1 && adjustments.front().av == 1u);
+		assert(std::abs(*Ops::Get(totals, 1u) - 10.0f) < epsilon);
+		assert(*Ops::Take(totals, 2u) == 4.0f && !totals.contains(2u));
+	}
+}
+
+int main()
+{
+	SetBasics();
+	MapBasics();
+	MatchesUnorderedMapUnderChurn();
+	CopiesAreIndependentAndMovesEmpty();
+	CopiesShareUntilWritten();
+	SnapshotsSurviveConcurrentWriter();
+	PlugsIntoRewardStateStoreOps();
+	return 0;
+}
@@ -34,6 +34,7 @@ test("inventory payload groups sections by discipline and forwards disabled reas
 
 test("quick register builder preserves disabled rows with explicit reason tags", () => {
   const builderSrc = read("src/RegistrationQuickListBuilder.cpp");
+  const classifySrc = read("src/RegistrationInternalClassify.cpp");
   const registrationHeader = read("include/CodexOfPowerNG/Registration.h");
 
   assert.match(
@@ -58,7 +59,12 @@ test("quick register builder preserves disabled rows with explicit reason tags",
   );
   assert.match(
     builderSrc,
-    /item\.buildPointsCenti\s*=\s*BuildProgression::ResolveBuildPointsForFormType/,
+    /item\.buildPointsCenti\s*=\s*itemClass\.buildPointsCenti/,
     "Quick register builder should attach the build-point weight for each candidate row",
   );
+  assert.match(
+    classifySrc,
+    /itemClass\.buildPointsCenti\s*=\s*BuildProgression::ResolveBuildPointsForFormType\(formType\)/,
+    "Item classification should derive the build-point weight from the regKey form type",
+  );
 });
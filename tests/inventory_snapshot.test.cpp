@@ -0,0 +1,87 @@
+#include "CodexOfPowerNG/InventorySnapshot.h"
+
+#include <cassert>
+#include <cstdint>
+
+namespace
+{
+	struct Entry
+	{
+		std::int32_t extraCount{ 0 };
+	};
+
+	struct Removal
+	{
+		std::int32_t safeCount{ 0 };
+	};
+
+	using Snapshot = CodexOfPowerNG::Inventory::Snapshot<Entry, Removal>;
+
+	void BuildsRowsInOnePass()
+	{
+		Entry sword{ 1 };
+		Entry potion{ 0 };
+
+		Snapshot snapshot;
+		snapshot.Reserve(4);
+		snapshot.AddCount(0x10u, 3);
+		snapshot.AddCount(0x20u, 5);
+		snapshot.AddCount(0x30u, 2);  // base container only
+		snapshot.AddCount(0x10u, 1);  // counts for one object add up
+		snapshot.AttachEntry(0x10u, &sword);
+		snapshot.AttachEntry(0x20u, &potion);
+		snapshot.AttachEntry(0x40u, &potion);  // entry whose count nets out to zero
+
+		int selected = 0;
+		snapshot.SelectRemovals([&](Entry& entry, std::int32_t totalCount) {
+			++selected;
+			return Removal{ totalCount - entry.extraCount };
+		});
+		assert(selected == 2);
+
+		assert(snapshot.size() == 4);
+		const auto* row = snapshot.Find(0x10u);
+		assert(row && row->entry == &sword && row->totalCount == 4 && row->removal.safeCount == 3);
+
+		row = snapshot.Find(0x30u);
+		assert(row && !row->entry && row->totalCount == 2 && row->removal.safeCount == 0);
+
+		row = snapshot.Find(0x40u);
+		assert(row && row->entry == &potion && row->totalCount == 0 && row->removal.safeCount == 0);
+
+		assert(!snapshot.Find(0x50u));
+		assert(snapshot.CountOf(0x20u) == 5);
+		assert(snapshot.CountOf(0x50u) == 0);
+
+		// Rows keep first-seen order.
+		const auto rows = snapshot.Rows();
+		assert(rows.size() == 4);
+		assert(rows[0].formId == 0x10u && rows[1].formId == 0x20u && rows[2].formId == 0x30u && rows[3].formId == 0x40u);
+	}
+
+	void FirstEntryWinsAndZeroIdsAreIgnored()
+	{
+		Entry first{};
+		Entry second{};
+
+		Snapshot snapshot;
+		snapshot.AddCount(0u, 9);
+		snapshot.AttachEntry(0u, &first);
+		snapshot.AttachEntry(0x10u, nullptr);
+		assert(snapshot.empty());
+
+		snapshot.AttachEntry(0x10u, &first);
+		snapshot.AttachEntry(0x10u, &second);
+		snapshot.AddCount(0x10u, 1);
+		assert(snapshot.size() == 1);
+		assert(snapshot.Find(0x10u)->entry == &first);
+		assert(snapshot.CountOf(0x10u) == 1);
+	}
+}
+
+int main()
+{
+	BuildsRowsInOnePass();
+	FirstEntryWinsAndZeroIdsAreIgnored();
+	return 0;
+}
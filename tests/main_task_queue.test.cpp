@@ -0,0 +1,298 @@
+#include "CodexOfPowerNG/MainTaskQueue.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using CodexOfPowerNG::ITaskScheduler;
+	using CodexOfPowerNG::MainTaskQueue;
+	using CodexOfPowerNG::ResumableTask;
+	using CodexOfPowerNG::ScheduledTask;
+	using CodexOfPowerNG::TaskPriority;
+	using CodexOfPowerNG::TaskStep;
+	using std::chrono::microseconds;
+
+	// Synthetic time: tasks advance it by what they "cost".
+	struct FakeClock
+	{
+		using duration = std::chrono::microseconds;
+		using rep = duration::rep;
+		using period = duration::period;
+		using time_point = std::chrono::time_point<FakeClock>;
+		static constexpr bool is_steady = true;
+
+		static inline std::int64_t nowUs = 0;
+
+		static time_point now() noexcept { return time_point(duration(nowUs)); }
+		static void Spend(std::int64_t us) noexcept { nowUs += us; }
+	};
+
+	// Stands in for the game's task interface: like SKSE, a drain also runs tasks posted while it drains.
+	class FakeBackend final : public ITaskScheduler
+	{
+	public:
+		bool AddMainTask(ScheduledTask task) noexcept override
+		{
+			if (refuse || refuseOnce) {
+				refuseOnce = false;
+				if (auto racer = std::move(onRefuse)) {
+					onRefuse = nullptr;
+					racer();
+				}
+				return false;
+			}
+			pending.push_back(std::move(task));
+			return true;
+		}
+
+		bool AddUITask(ScheduledTask) noexcept override { return false; }
+
+		void Drain()
+		{
+			for (std::size_t ran = 0; !pending.empty(); ++ran) {
+				assert(ran < 100000 && "a pump keeps re-posting itself within one drain");
+				auto task = std::move(pending.front());
+				pending.erase(pending.begin());
+				task();
+			}
+		}
+
+		std::vector<ScheduledTask> pending;
+		bool                       refuse{ false };
+		bool                       refuseOnce{ false };
+		ScheduledTask              onRefuse;  // runs inside the refused post, like a caller on another thread
+	};
+
+	constexpr microseconds kBudget{ 4000 };
+
+	// One game frame: the frame hook ticks the queue, then the game drains its task queue. Returns the
+	// frame's duration in synthetic microseconds.
+	std::int64_t RunGameFrame(MainTaskQueue<FakeClock>& queue, FakeBackend& backend)
+	{
+		const auto start = FakeClock::nowUs;
+		queue.Tick(backend);
+		backend.Drain();
+		return FakeClock::nowUs - start;
+	}
+
+	[[nodiscard]] std::size_t Depth(const MainTaskQueue<FakeClock>& queue)
+	{
+		std::size_t depth = 0;
+		for (const auto d : queue.Snapshot().queueDepth) {
+			depth += d;
+		}
+		return depth;
+	}
+
+	[[nodiscard]] ResumableTask Costing(std::int64_t us, std::vector<std::string>* log = nullptr, std::string name = {})
+	{
+		return [us, log, name = std::move(name)](microseconds) {
+			FakeClock::Spend(us);
+			if (log) {
+				log->push_back(name);
+			}
+			return TaskStep::kDone;
+		};
+	}
+
+	void FrameTimeStaysWithinBudgetUnderLoad()
+	{
+		FakeBackend                backend;
+		MainTaskQueue<FakeClock>   queue{ kBudget };
+
+		constexpr int           kTasks = 200;
+		constexpr std::int64_t  kTaskCostUs = 450;
+		int                     ran = 0;
+		for (int i = 0; i < kTasks; ++i) {
+			assert(queue.Enqueue(backend, TaskPriority::kNormal, {}, [&ran](microseconds) {
+				FakeClock::Spend(kTaskCostUs);
+				++ran;
+				return TaskStep::kDone;
+			}));
+		}
+		assert(backend.pending.size() == 1 && "one pump per burst");
+
+		// A resumable job that chews through 60 chunks of 300us, bounded by the slice budget it is given.
+		int chunksLeft = 60;
+		assert(queue.Enqueue(backend, TaskPriority::kBackground, {}, [&chunksLeft](microseconds budget) {
+			std::int64_t spent = 0;
+			do {
+				FakeClock::Spend(300);
+				spent += 300;
+				--chunksLeft;
+			} while (chunksLeft > 0 && spent < budget.count());
+			return chunksLeft > 0 ? TaskStep::kYield : TaskStep::kDone;
+		}));
+
+		int frames = 0;
+		while (Depth(queue) > 0) {
+			const auto frameUs = RunGameFrame(queue, backend);
+			++frames;
+			// A frame may overshoot the budget by at most one slice.
+			assert(frameUs <= kBudget.count() + kTaskCostUs);
+			assert(frames < 1000);
+		}
+
+		assert(ran == kTasks);
+		assert(chunksLeft == 0);
+		const auto stats = queue.Snapshot();
+		assert(stats.slicesRun >= kTasks + 1u);
+		assert(stats.frames == static_cast<std::uint64_t>(frames));
+		assert(queue.CurrentFrame() == static_cast<std::uint64_t>(frames));
+		assert(stats.maxFrameUs <= static_cast<std::uint64_t>(kBudget.count() + kTaskCostUs));
+		assert(stats.maxQueueDepth == kTasks + 1u);
+		assert(stats.startedTasks == kTasks + 1u);
+		assert(stats.maxLatencyUs > 0 && stats.totalLatencyUs >= stats.maxLatencyUs);
+		for (const auto depth : stats.queueDepth) {
+			assert(depth == 0);
+		}
+		// 200 * 450us + 60 * 300us of work cannot fit in fewer frames than this.
+		assert(frames >= (kTasks * kTaskCostUs + 60 * 300) / (kBudget.count() + kTaskCostUs));
+	}
+
+	void PrioritiesAndCoalescing()
+	{
+		FakeBackend              backend;
+		MainTaskQueue<FakeClock> queue{ kBudget };
+		std::vector<std::string> log;
+
+		assert(queue.Enqueue(backend, TaskPriority::kBackground, {}, Costing(10, &log, "sync")));
+		for (int i = 0; i < 5; ++i) {
+			assert(queue.Enqueue(backend, TaskPriority::kNormal, "ui.rewards", Costing(10, &log, "rewards#" + std::to_string(i))));
+		}
+		assert(queue.Enqueue(backend, TaskPriority::kNormal, {}, Costing(10, &log, "inventory")));
+		assert(queue.Enqueue(backend, TaskPriority::kHigh, {}, Costing(10, &log, "close")));
+
+		auto stats = queue.Snapshot();
+		assert(stats.coalesced == 4);
+		assert(stats.queueDepth[0] == 1 && stats.queueDepth[1] == 2 && stats.queueDepth[2] == 1);
+
+		(void)RunGameFrame(queue, backend);
+		// The latest body runs in the slot of the first request.
+		assert((log == std::vector<std::string>{ "close", "rewards#4", "inventory", "sync" }));
+		assert(backend.pending.empty());
+
+		// Once a keyed task has started, the key is free again.
+		log.clear();
+		assert(queue.Enqueue(backend, TaskPriority::kNormal, "ui.rewards", [&](microseconds) {
+			log.push_back("outer");
+			assert(queue.Enqueue(backend, TaskPriority::kNormal, "ui.rewards", Costing(1, &log, "inner")));
+			return TaskStep::kDone;
+		}));
+		(void)RunGameFrame(queue, backend);
+		assert((log == std::vector<std::string>{ "outer" }) && "work queued during a frame waits for the next one");
+		(void)RunGameFrame(queue, backend);
+		assert((log == std::vector<std::string>{ "outer", "inner" }));
+		assert(queue.Snapshot().coalesced == 4);
+	}
+
+	void FailuresAreContained()
+	{
+		FakeBackend              backend;
+		MainTaskQueue<FakeClock> queue{ kBudget };
+		std::vector<std::string> log;
+
+		assert(queue.Enqueue(backend, TaskPriority::kNormal, {}, [](microseconds) -> TaskStep {
+			throw std::runtime_error("boom");
+		}));
+		assert(queue.Enqueue(backend, TaskPriority::kNormal, {}, Costing(5, &log, "after")));
+		(void)RunGameFrame(queue, backend);
+		assert((log == std::vector<std::string>{ "after" }));
+		assert(queue.Snapshot().failedTasks == 1);
+
+		// Without a backend nothing would run the task, so the caller is told and the queue stays empty.
+		backend.refuse = true;
+		assert(!queue.Enqueue(backend, TaskPriority::kNormal, "ui.build", Costing(5)));
+		assert(queue.Snapshot().queueDepth[1] == 0);
+		backend.refuse = false;
+		assert(queue.Enqueue(backend, TaskPriority::kNormal, "ui.build", Costing(5, &log, "build")));
+		assert(queue.Snapshot().coalesced == 0);
+		(void)RunGameFrame(queue, backend);
+		assert(log.back() == "build");
+
+		assert(!queue.Enqueue(backend, TaskPriority::kNormal, {}, ResumableTask{}));
+
+		// A caller that enqueues while the pump post is failing was told its task would run; the
+		// withdrawing caller re-posts the pump for it.
+		log.clear();
+		backend.refuseOnce = true;
+		backend.onRefuse = [&]() {
+			assert(queue.Enqueue(backend, TaskPriority::kNormal, {}, Costing(5, &log, "racer")));
+		};
+		assert(!queue.Enqueue(backend, TaskPriority::kNormal, {}, Costing(5, &log, "refused")));
+		assert(backend.pending.size() == 1);
+		(void)RunGameFrame(queue, backend);
+		assert((log == std::vector<std::string>{ "racer" }));
+		assert(backend.pending.empty());
+	}
+
+	// The game runs tasks posted mid-drain in the same drain; the budget must still push work to the next frame.
+	void LeftoverWorkWaitsForTheNextTick()
+	{
+		FakeBackend              backend;
+		MainTaskQueue<FakeClock> queue{ kBudget };
+		std::vector<std::string> log;
+
+		assert(queue.Enqueue(backend, TaskPriority::kNormal, {}, Costing(3000, &log, "a")));
+		assert(queue.Enqueue(backend, TaskPriority::kNormal, {}, Costing(3000, &log, "b")));
+		assert(queue.Enqueue(backend, TaskPriority::kNormal, {}, Costing(3000, &log, "c")));
+		(void)RunGameFrame(queue, backend);
+		assert((log == std::vector<std::string>{ "a", "b" }));
+		assert(backend.pending.empty());
+
+		// Work queued after the frame's pump (e.g. from the UI thread) posts a pump that runs in the same
+		// drain but leaves it for the next frame.
+		assert(queue.Enqueue(backend, TaskPriority::kHigh, {}, Costing(10, &log, "late")));
+		assert(backend.pending.size() == 1);
+		backend.Drain();
+		assert((log == std::vector<std::string>{ "a", "b" }));
+		(void)RunGameFrame(queue, backend);
+		assert((log == std::vector<std::string>{ "a", "b", "late", "c" }));
+		assert(queue.CurrentFrame() == 2);
+
+		// A poller that yields at once runs once per frame instead of spinning out the budget.
+		int polls = 0;
+		assert(queue.Enqueue(backend, TaskPriority::kBackground, {}, [&polls](microseconds) {
+			++polls;
+			return polls < 3 ? TaskStep::kYield : TaskStep::kDone;
+		}));
+		(void)RunGameFrame(queue, backend);
+		assert(polls == 1);
+		(void)RunGameFrame(queue, backend);
+		assert(polls == 2);
+		(void)RunGameFrame(queue, backend);
+		assert(polls == 3 && Depth(queue) == 0);
+	}
+
+	// Before the frame hook ticks, every pump is its own frame and re-posts itself.
+	void PumpsRepostWithoutAFrameHook()
+	{
+		FakeBackend              backend;
+		MainTaskQueue<FakeClock> queue{ kBudget };
+		std::vector<std::string> log;
+
+		assert(queue.Enqueue(backend, TaskPriority::kNormal, {}, Costing(3000, &log, "a")));
+		assert(queue.Enqueue(backend, TaskPriority::kNormal, {}, Costing(3000, &log, "b")));
+		assert(queue.Enqueue(backend, TaskPriority::kNormal, {}, Costing(3000, &log, "c")));
+		backend.Drain();
+		assert((log == std::vector<std::string>{ "a", "b", "c" }));
+		assert(queue.CurrentFrame() == 2);
+		assert(queue.Snapshot().frames == 2);
+	}
+}
+
+int main()
+{
+	FrameTimeStaysWithinBudgetUnderLoad();
+	PrioritiesAndCoalescing();
+	FailuresAreContained();
+	LeftoverWorkWaitsForTheNextTick();
+	PumpsRepostWithoutAFrameHook();
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include "CodexOfPowerNG/NamePoolOps.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+	namespace Collation = CodexOfPowerNG::NameCollation;
+
+	[[nodiscard]] std::vector<std::string> SortedBy(std::vector<std::string> names, Collation::Locale locale)
+	{
+		std::sort(names.begin(), names.end(), [locale](const std::string& a, const std::string& b) {
+			return Collation::BuildKey(a, locale) < Collation::BuildKey(b, locale);
+		});
+		return names;
+	}
+}
+
+int main()
+{
+	namespace NamePool = CodexOfPowerNG::NamePool;
+	namespace Ops = CodexOfPowerNG::NamePool::Ops;
+
+	assert(Collation::LocaleFor("ko") == Collation::Locale::kKorean);
+	assert(Collation::LocaleFor("en") == Collation::Locale::kDefault);
+
+	// Latin: case-insensitive with accents folded; exact bytes only break ties.
+	assert((SortedBy({ "iron Sword", "Elven Bow", "Éclair", "Iron sword", "Iron" }, Collation::Locale::kDefault) ==
+			std::vector<std::string>{ "Éclair", "Elven Bow", "Iron", "Iron sword", "iron Sword" }));
+
+	// Hangul by jamo: 가 < 각 < 나 < 다, bare consonant before its syllables.
+	const std::string ga = "\xEA\xB0\x80";     // 가
+	const std::string gak = "\xEA\xB0\x81";    // 각
+	const std::string na = "\xEB\x82\x98";     // 나
+	const std::string da = "\xEB\x8B\xA4";     // 다
+	const std::string giyeok = "\xE3\x84\xB1"; // ㄱ
+	assert((SortedBy({ da, gak, na, ga, giyeok }, Collation::Locale::kDefault) ==
+			std::vector<std::string>{ giyeok, ga, gak, na, da }));
+
+	// Script order follows the locale; digits and symbols lead in both.
+	assert((SortedBy({ na, "Axe", "10 Arrows", "[Q] Key" }, Collation::Locale::kDefault) ==
+			std::vector<std::string>{ "[Q] Key", "10 Arrows", "Axe", na }));
+	assert((SortedBy({ na, "Axe", "10 Arrows", "[Q] Key" }, Collation::Locale::kKorean) ==
+			std::vector<std::string>{ "[Q] Key", "10 Arrows", na, "Axe" }));
+
+	// Keys are equal only for identical text; malformed UTF-8 still yields a key.
+	assert(Collation::BuildKey("Axe", Collation::Locale::kDefault) != Collation::BuildKey("axe", Collation::Locale::kDefault));
+	assert(!Collation::BuildKey("\xEA\xB0", Collation::Locale::kDefault).empty());
+
+	// Pool: one shared entry per key, reinterned only when the text changes.
+	Ops::PoolState<std::uint32_t> pool;
+	assert(Ops::SyncLanguage(pool, 1u, Collation::Locale::kDefault));
+	assert(!Ops::SyncLanguage(pool, 1u, Collation::Locale::kDefault));
+
+	const auto sword = Ops::Intern(pool, 0x10u, "Iron Sword");
+	assert(Ops::Intern(pool, 0x10u, "Iron Sword") == sword);
+	assert(NamePool::TextOf(sword) == "Iron Sword");
+	const auto renamed = Ops::Intern(pool, 0x10u, "Steel Sword");
+	assert(renamed != sword && NamePool::TextOf(sword) == "Iron Sword");
+
+	const auto axe = Ops::Intern(pool, 0x20u, "axe");
+	assert(NamePool::CollatesBefore(axe, renamed));
+	assert(!NamePool::CollatesBefore(renamed, axe));
+	assert(!NamePool::CollatesBefore(axe, axe));
+	assert(NamePool::CollatesBefore(nullptr, axe));
+	assert(NamePool::TextOf(nullptr).empty());
+
+	// A language switch drops the pool and rebuilds keys for the new locale.
+	const auto hangul = Ops::Intern(pool, 0x30u, na);
+	assert(NamePool::CollatesBefore(axe, hangul));
+	assert(Ops::SyncLanguage(pool, 2u, Collation::Locale::kKorean));
+	assert(pool.byKey.empty());
+	const auto hangulKo = Ops::Intern(pool, 0x30u, na);
+	const auto axeKo = Ops::Intern(pool, 0x20u, "axe");
+	assert(NamePool::CollatesBefore(hangulKo, axeKo));
+
+	return 0;
+}
@@ -15,6 +15,7 @@ const modulePath = path.join(
 
 const html = fs.readFileSync(viewPath, "utf8");
 const mod = require(modulePath);
+const virtualTables = require(path.join(path.dirname(modulePath), "virtual_tables.js"));
 
 test("view loads native state bridge module", () => {
   assert.match(
@@ -120,3 +121,55 @@ test("native state bridge updates state, language, renders, and refresh resync h
   assert.equal(recorded.order.filter((x) => x === "renderUndo").length, 1);
   assert.ok(recorded.order.includes("renderSettings"));
 });
+
+test("native state bridge assembles registered pages and applies deltas against its version", () => {
+  const recorded = { rows: null, version: 0, resyncRequests: 0, order: [] };
+  const bridge = mod.createNativeStateBridge({
+    setRegisteredItems: (next) => {
+      recorded.rows = next;
+    },
+    getRegisteredItems: () => recorded.rows,
+    applyRowChanges: virtualTables.applyRowChanges,
+    getRegisteredVersion: () => recorded.version,
+    setRegisteredVersion: (next) => {
+      recorded.version = next;
+    },
+    requestRegisteredResync: () => {
+      recorded.resyncRequests++;
+    },
+    renderRegistered: () => recorded.order.push("renderRegistered"),
+    isTabActive: (tabId) => tabId === "tabRegistered",
+  });
+
+  bridge.onRegisteredPage({ version: 5, total: 3, offset: 0, items: [{ formId: 1 }, { formId: 2 }] });
+  assert.equal(recorded.rows, null);
+  bridge.onRegisteredPage({ version: 5, total: 3, offset: 2, items: [{ formId: 3 }] });
+  assert.deepEqual(recorded.rows.map((r) => r.formId), [1, 2, 3]);
+  assert.equal(recorded.version, 5);
+
+  bridge.onRegisteredDelta({
+    fromVersion: 5,
+    version: 7,
+    changes: [
+      { op: "remove", index: 0, formId: 1 },
+      { op: "insert", index: 2, row: { formId: 4 } },
+    ],
+  });
+  assert.deepEqual(recorded.rows.map((r) => r.formId), [2, 3, 4]);
+  assert.equal(recorded.version, 7);
+  assert.equal(recorded.resyncRequests, 0);
+
+  // A delta from another version, or one that does not line up, forces a full resync.
+  bridge.onRegisteredDelta({ fromVersion: 6, version: 8, changes: [] });
+  assert.equal(recorded.resyncRequests, 1);
+  assert.equal(recorded.version, 0);
+
+  recorded.version = 7;
+  bridge.onRegisteredDelta({ fromVersion: 7, version: 8, changes: [{ op: "remove", index: 0, formId: 99 }] });
+  assert.equal(recorded.resyncRequests, 2);
+
+  // A page that skips ahead is dropped the same way.
+  bridge.onRegisteredPage({ version: 9, total: 4, offset: 2, items: [{ formId: 5 }] });
+  assert.equal(recorded.resyncRequests, 3);
+  assert.equal(recorded.order.filter((x) => x === "renderRegistered").length, 2);
+});
@@ -27,12 +27,13 @@ test("notified state store exposes focused helpers and delegates pure set operat
 
   assert.match(header, /ContainsAny\(RE::FormID primaryId,\s*RE::FormID secondaryId\)/);
   assert.match(header, /MarkPair\(RE::FormID primaryId,\s*RE::FormID secondaryId\)/);
-  assert.match(header, /ReplaceAll\(std::unordered_set<RE::FormID> notifiedItems\)/);
+  assert.match(header, /ReplaceAll\(Containers::FlatFormIdSet notifiedItems\)/);
   assert.match(opsHeader, /namespace CodexOfPowerNG::NotifiedStateStore::Ops/);
   assert.match(opsHeader, /ContainsAny\(const Set& notifiedItems/);
   assert.match(opsHeader, /MarkPair\(Set& notifiedItems/);
 
-  assert.match(impl, /Ops::ContainsAny\(state\.notifiedItems,\s*primaryId,\s*secondaryId\)/);
+  assert.match(impl, /RegistrationLookup::IsNotifiedAny\(primaryId,\s*secondaryId\)/);
+  assert.match(impl, /RegistrationLookup::NoteNotifiedLocked\(primaryId,\s*secondaryId\)/);
   assert.match(impl, /Ops::MarkPair\(state\.notifiedItems,\s*primaryId,\s*secondaryId\)/);
   assert.match(impl, /Ops::ReplaceAll\(state\.notifiedItems,\s*std::move\(notifiedItems\)\)/);
 });
@@ -1,14 +1,14 @@
+#include "CodexOfPowerNG/FlatFormIdMap.h"
 #include "CodexOfPowerNG/NotifiedStateStoreOps.h"
 
 #include <cassert>
 #include <cstdint>
-#include <unordered_set>
 
 int main()
 {
 	namespace Ops = CodexOfPowerNG::NotifiedStateStore::Ops;
 
-	std::unordered_set<std::uint32_t> notifiedItems;
+	CodexOfPowerNG::Containers::FlatFormIdSet notifiedItems;
 	assert(!Ops::ContainsAny(notifiedItems, 0u, 0u));
 
 	Ops::MarkPair(notifiedItems, 0u, 0u);
@@ -22,7 +22,7 @@ int main()
 	auto snapshot = Ops::Snapshot(notifiedItems);
 	assert(snapshot == notifiedItems);
 
-	Ops::ReplaceAll(notifiedItems, std::unordered_set<std::uint32_t>{ 0xDEADBEEFu });
+	Ops::ReplaceAll(notifiedItems, CodexOfPowerNG::Containers::FlatFormIdSet{ 0xDEADBEEFu });
 	assert(Ops::Count(notifiedItems) == 1);
 	assert(Ops::ContainsAny(notifiedItems, 0xDEADBEEFu, 0u));
 
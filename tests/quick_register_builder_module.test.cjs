@@ -23,6 +23,7 @@ test("quick register builder owns quest protection, TCC gating, and stable sorti
   const builderSrc = read("src/RegistrationQuickListBuilder.cpp");
   assert.match(builderSrc, /entry\.IsQuestObject\(\)/);
   assert.match(builderSrc, /Internal::EvaluateTccGate\(settings, tccLists, obj, regKey\)/);
-  assert.match(builderSrc, /player\.GetItemCount\(obj\)/);
+  assert.match(builderSrc, /Inventory::GetPlayerSnapshot\(player, settings\.protectFavorites\)/);
+  assert.match(builderSrc, /const auto totalCount = row\.totalCount;/);
   assert.match(builderSrc, /std::sort\(allEligible\.begin\(\), allEligible\.end\(\)/);
 });
@@ -7,9 +7,10 @@ function read(relPath) {
   return fs.readFileSync(path.join(__dirname, "..", relPath), "utf8");
 }
 
-test("quick register list uses short-lived cache with generation invalidation", () => {
+test("quick register list cache is invalidated by generation and quest guard version", () => {
   const src = read("src/RegistrationQuickRegister.cpp");
-  assert.match(src, /kQuickListCacheTtlMs/);
+  assert.doesNotMatch(src, /kQuickListCacheTtlMs/);
+  assert.match(src, /cache\.questVersion != QuestGuard::Version\(\)/);
   assert.match(src, /TryBuildQuickListFromCache/);
   assert.match(src, /UpdateQuickListCache/);
   assert.match(src, /std::atomic<std::uint64_t>\s+g_quickListGeneration/);
@@ -20,15 +20,22 @@ test("ammo is grouped as weapons for discovery categories", () => {
 });
 
 test("quick register list uses live inventory count API", () => {
+  const inventorySrc = fs.readFileSync(path.join(__dirname, "..", "src", "Inventory.cpp"), "utf8");
+  assert.match(
+    inventorySrc,
+    /player\.GetInventoryCounts\(\)/,
+    "The inventory snapshot should derive counts from the engine's inventory count walk",
+  );
   const src = regPaths
     .filter((p) => fs.existsSync(p))
     .map((p) => fs.readFileSync(p, "utf8"))
     .join("\n");
   assert.match(
     src,
-    /GetItemCount\(obj\)/,
-    "Quick register list should derive counts from PlayerCharacter::GetItemCount",
+    /Inventory::GetPlayerSnapshot\(/,
+    "Quick register list should read counts from the shared inventory snapshot",
   );
+  assert.doesNotMatch(src, /GetItemCount\(/, "Per-object GetItemCount walks should not come back");
 });
 
 test("quick register consults quest-object protection in both the list and consume path", () => {
@@ -0,0 +1,107 @@
+#include "CodexOfPowerNG/RankedList.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace
+{
+	using List = CodexOfPowerNG::Containers::RankedList<std::uint32_t, std::less<std::uint32_t>, 8>;
+
+	[[nodiscard]] std::vector<std::uint32_t> Range(const List& list, std::size_t offset, std::size_t count)
+	{
+		std::vector<std::uint32_t> out;
+		list.for_each_range(offset, count, [&out](std::uint32_t v) { out.push_back(v); });
+		return out;
+	}
+
+	void CheckAgainst(const List& list, const std::set<std::uint32_t>& model)
+	{
+		assert(list.size() == model.size());
+		const std::vector<std::uint32_t> expected(model.begin(), model.end());
+		std::vector<std::uint32_t> all;
+		list.for_each([&all](std::uint32_t v) { all.push_back(v); });
+		assert(all == expected);
+		for (std::size_t rank = 0; rank < expected.size(); rank += 7) {
+			assert(list.at(rank) == expected[rank]);
+			assert(list.rank_of(expected[rank]) == rank);
+			const auto page = Range(list, rank, 5);
+			const auto end = (std::min)(expected.size(), rank + 5);
+			assert(page == std::vector<std::uint32_t>(
+				expected.begin() + static_cast<std::ptrdiff_t>(rank),
+				expected.begin() + static_cast<std::ptrdiff_t>(end)));
+		}
+	}
+}
+
+int main()
+{
+	List list;
+	assert(list.empty());
+	assert(!list.erase(1u));
+	assert(Range(list, 0, 10).empty());
+
+	// Ranks returned by insert match sorted position, including across leaf splits.
+	assert(list.insert(50u) == 0);
+	assert(list.insert(10u) == 0);
+	assert(list.insert(30u) == 1);
+	assert(list.insert(30u) == 1);
+	assert(list.size() == 3);
+	for (std::uint32_t v = 100; v < 140; ++v) {
+		assert(list.insert(v) == v - 100 + 3);
+	}
+	assert(list.insert(20u) == 1);
+	assert(list.contains(20u));
+	assert(!list.contains(21u));
+
+	// Randomized insert/erase against std::set.
+	std::set<std::uint32_t> model{ 10u, 20u, 30u, 50u };
+	for (std::uint32_t v = 100; v < 140; ++v) {
+		model.insert(v);
+	}
+	CheckAgainst(list, model);
+
+	std::uint64_t state = 0x243F6A8885A308D3ull;
+	const auto next = [&state]() {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return static_cast<std::uint32_t>(state % 2000u);
+	};
+	for (int i = 0; i < 4000; ++i) {
+		const auto v = next();
+		if (i % 3 == 2) {
+			assert(list.erase(v) == (model.erase(v) > 0));
+		} else {
+			model.insert(v);
+			const auto rank = list.insert(v);
+			assert(rank == static_cast<std::size_t>(std::distance(model.begin(), model.find(v))));
+		}
+		if (i % 250 == 0) {
+			CheckAgainst(list, model);
+		}
+	}
+	CheckAgainst(list, model);
+
+	// Drain to empty and refill through the bulk path.
+	for (const auto v : std::vector<std::uint32_t>(model.begin(), model.end())) {
+		assert(list.erase(v));
+	}
+	assert(list.empty());
+
+	std::vector<std::uint32_t> sorted;
+	for (std::uint32_t v = 0; v < 100; ++v) {
+		sorted.push_back(v * 2);
+	}
+	list.assign_sorted(sorted);
+	assert(list.size() == 100);
+	assert(list.at(99) == 198);
+	assert(Range(list, 95, 10) == (std::vector<std::uint32_t>{ 190u, 192u, 194u, 196u, 198u }));
+	assert(list.insert(3u) == 2);
+
+	list.clear();
+	assert(list.empty());
+	return 0;
+}
@@ -0,0 +1,99 @@
+#include "CodexOfPowerNG/RegisteredListView.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+	namespace View = CodexOfPowerNG::Registration::RegisteredView;
+
+	struct Row
+	{
+		std::uint32_t regKey{ 0 };
+		std::uint32_t group{ 0 };
+		std::string   name{};
+	};
+
+	[[nodiscard]] std::vector<std::uint32_t> Keys(const View::View<Row>& view)
+	{
+		std::vector<std::uint32_t> keys;
+		for (const auto& ref : View::Page(view, 0, view.rows.size())) {
+			keys.push_back(ref->regKey);
+		}
+		return keys;
+	}
+
+	// Applies journal splices the way the UI does.
+	void Replay(std::vector<std::uint32_t>& keys, const std::vector<View::Change<Row>>& changes)
+	{
+		for (const auto& change : changes) {
+			if (change.kind == View::ChangeKind::kRemove) {
+				assert(change.index < keys.size() && keys[change.index] == change.item->regKey);
+				keys.erase(keys.begin() + static_cast<std::ptrdiff_t>(change.index));
+			} else {
+				assert(change.index <= keys.size());
+				keys.insert(keys.begin() + static_cast<std::ptrdiff_t>(change.index), change.item->regKey);
+			}
+		}
+	}
+}
+
+int main()
+{
+	View::View<Row> view;
+	assert(!View::CanReplayFrom(view, 0));
+
+	View::Rebuild(view, { { 3, 1, "Steel Sword" }, { 1, 0, "Iron Helmet" }, { 2, 1, "Elven Bow" }, { 4, 0, "Apple" } });
+	assert(view.built);
+	assert((Keys(view) == std::vector<std::uint32_t>{ 4, 1, 2, 3 }));
+	const auto base = view.version;
+	assert(View::CanReplayFrom(view, base));
+	assert(View::ChangesSince(view, base).empty());
+
+	// Splices reported by the view reproduce it from the client's copy.
+	auto client = Keys(view);
+	View::Upsert(view, Row{ 5, 1, "Glass Dagger" });
+	View::Remove(view, 1);
+	View::Remove(view, 99);
+	View::Upsert(view, Row{ 3, 0, "Steel Sword" });
+	assert(view.version == base + 4);
+	assert(View::CanReplayFrom(view, base));
+	assert(View::CanReplayFrom(view, base + 2));
+	assert(!View::CanReplayFrom(view, base + 5));
+
+	const auto changes = View::ChangesSince(view, base);
+	assert(changes.size() == 4);
+	assert(changes[0].kind == View::ChangeKind::kInsert && changes[0].index == 3);
+	assert(changes[1].kind == View::ChangeKind::kRemove && changes[1].index == 1);
+	Replay(client, changes);
+	assert(client == Keys(view));
+	assert((client == std::vector<std::uint32_t>{ 4, 3, 2, 5 }));
+
+	// Paging clamps at the end.
+	const auto page = View::Page(view, 3, 10);
+	assert(page.size() == 1 && page[0]->regKey == 5);
+	assert(View::Page(view, 10, 10).empty());
+
+	// A client older than the bounded journal needs a full snapshot.
+	const auto beforeOverflow = view.version;
+	for (std::uint32_t i = 0; i < View::kJournalLimit + 1; ++i) {
+		View::Upsert(view, Row{ 1000 + i, 2, "Gem " + std::to_string(i) });
+	}
+	assert(view.journal.size() == View::kJournalLimit);
+	assert(!View::CanReplayFrom(view, beforeOverflow));
+	assert(View::CanReplayFrom(view, beforeOverflow + 1));
+
+	// Rebuild and invalidation both cut off replay.
+	const auto beforeRebuild = view.version;
+	View::Rebuild(view, { { 7, 0, "Ring" } });
+	assert(view.version == beforeRebuild + 1);
+	assert(!View::CanReplayFrom(view, beforeRebuild));
+	assert(View::CanReplayFrom(view, view.version));
+	View::Invalidate(view);
+	assert(!View::CanReplayFrom(view, view.version));
+
+	return 0;
+}
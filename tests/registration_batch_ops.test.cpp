@@ -0,0 +1,93 @@
+#include "CodexOfPowerNG/BuildTypes.h"
+#include "CodexOfPowerNG/RegistrationBatchOps.h"
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace
+{
+	namespace BatchOps = CodexOfPowerNG::Registration::BatchOps;
+	using CodexOfPowerNG::Builds::BuildDiscipline;
+
+	struct Record
+	{
+		std::uint64_t actionId{ 0 };
+		std::uint32_t regKey{ 0 };
+	};
+
+	struct Contribution
+	{
+		BuildDiscipline discipline{ BuildDiscipline::Attack };
+		std::int32_t    recordDelta{ 0 };
+		std::int32_t    pointsDeltaCenti{ 0 };
+	};
+
+	[[nodiscard]] std::vector<Record> Records(std::initializer_list<std::uint32_t> regKeys)
+	{
+		std::vector<Record> out;
+		for (const auto regKey : regKeys) {
+			out.push_back(Record{ 0, regKey });
+		}
+		return out;
+	}
+}
+
+int main()
+{
+	std::deque<Record> history;
+	std::uint64_t      nextActionId = 1;
+
+	// Single registrations are groups of one.
+	assert(BatchOps::PushUndoGroup(history, nextActionId, Records({ 10 }), 0, 3) == 1);
+	assert(BatchOps::PushUndoGroup(history, nextActionId, Records({ 20, 21, 22 }), 0, 3) == 2);
+	assert(history.size() == 4 && BatchOps::CountUndoGroups(history) == 2);
+
+	// A later slice of the same batch joins the newest group.
+	assert(BatchOps::PushUndoGroup(history, nextActionId, Records({ 23 }), 2, 3) == 2);
+	assert(history.size() == 5 && BatchOps::CountUndoGroups(history) == 2);
+
+	// Joining is refused once another registration landed in between.
+	assert(BatchOps::PushUndoGroup(history, nextActionId, Records({ 30 }), 0, 3) == 3);
+	assert(BatchOps::PushUndoGroup(history, nextActionId, Records({ 24 }), 2, 3) == 4);
+	assert(BatchOps::PushUndoGroup(history, nextActionId, {}, 4, 3) == 4);
+
+	// The limit counts groups and drops the oldest one whole.
+	assert(BatchOps::CountUndoGroups(history) == 3);
+	assert(history.front().actionId == 2 && history.size() == 6);
+
+	const auto groups = BatchOps::SnapshotUndoGroups(history, 2);
+	assert(groups.size() == 2);
+	assert(groups[0].size() == 1 && groups[0][0].regKey == 24);
+	assert(groups[1].size() == 1 && groups[1][0].regKey == 30);
+	assert(BatchOps::SnapshotUndoGroups(history, 10).back().size() == 4);
+
+	// Only the newest group can be popped, and it comes back in commit order.
+	assert(BatchOps::PopLatestUndoGroup(history, 2).empty());
+	assert(BatchOps::PopLatestUndoGroup(history, 4).size() == 1);
+	assert(BatchOps::PopLatestUndoGroup(history, 3).size() == 1);
+	const auto batch = BatchOps::PopLatestUndoGroup(history, 2);
+	assert(batch.size() == 4 && batch.front().regKey == 20 && batch.back().regKey == 23);
+	assert(history.empty());
+
+	// Contributions fold into one total per discipline.
+	std::array<std::optional<Contribution>, CodexOfPowerNG::Builds::kBuildDisciplineCount> totals{};
+	BatchOps::AccumulateContribution(totals, Contribution{ BuildDiscipline::Attack, 1, 150 });
+	BatchOps::AccumulateContribution(totals, Contribution{ BuildDiscipline::Attack, 1, 100 });
+	BatchOps::AccumulateContribution(totals, Contribution{ BuildDiscipline::Utility, 1, 50 });
+	assert(totals[0].has_value() && totals[0]->recordDelta == 2 && totals[0]->pointsDeltaCenti == 250);
+	assert(!totals[1].has_value());
+	assert(totals[2].has_value() && totals[2]->recordDelta == 1);
+
+	// A slice always processes one item, then respects its budget.
+	using std::chrono::microseconds;
+	assert(!BatchOps::ShouldYield(0, microseconds{ 9000 }, microseconds{ 4000 }));
+	assert(!BatchOps::ShouldYield(5, microseconds{ 100 }, microseconds{ 4000 }));
+	assert(BatchOps::ShouldYield(5, microseconds{ 4000 }, microseconds{ 4000 }));
+
+	return 0;
+}
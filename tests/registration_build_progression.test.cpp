@@ -138,12 +138,13 @@ namespace
 		CodexOfPowerNG::SerializationStateStore::Clear();
 		CodexOfPowerNG::SerializationStateStore::ReplaceState(std::move(snapshot));
 
-		const auto restored = CodexOfPowerNG::RegistrationStateStore::SnapshotUndoRecords(1u);
+		const auto restored = CodexOfPowerNG::RegistrationStateStore::SnapshotUndoGroups(1u);
 		return restored.size() == 1u &&
-		       restored.front().buildContribution.has_value() &&
-		       restored.front().buildContribution->discipline == BuildDiscipline::Defense &&
-		       restored.front().buildContribution->recordDelta == 1 &&
-		       restored.front().buildContribution->pointsDeltaCenti == 40;
+		       restored.front().size() == 1u &&
+		       restored.front().front().buildContribution.has_value() &&
+		       restored.front().front().buildContribution->discipline == BuildDiscipline::Defense &&
+		       restored.front().front().buildContribution->recordDelta == 1 &&
+		       restored.front().front().buildContribution->pointsDeltaCenti == 40;
 	}
 }
 
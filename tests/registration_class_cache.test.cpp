@@ -0,0 +1,82 @@
+#include "CodexOfPowerNG/RegistrationClassCache.h"
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+
+namespace
+{
+	namespace CC = CodexOfPowerNG::Registration::ClassCache;
+
+	struct Entry
+	{
+		std::uint32_t regKey{ 0 };
+		std::uint32_t group{ 255 };
+	};
+
+	void MemoisesPerGeneration()
+	{
+		CC::GenerationalFormCache<Entry> cache;
+		int computed = 0;
+		const auto compute = [&](std::uint32_t regKey) {
+			return [&computed, regKey]() {
+				++computed;
+				return std::optional<Entry>(Entry{ regKey, 1 });
+			};
+		};
+
+		auto first = cache.GetOrCompute(0x10u, 1, compute(0x20u));
+		assert(first && first->regKey == 0x20u);
+		auto second = cache.GetOrCompute(0x10u, 1, compute(0x99u));
+		assert(second && second->regKey == 0x20u);
+		assert(computed == 1);
+
+		auto stats = cache.GetStats();
+		assert(stats.hits == 1 && stats.misses == 1 && stats.size == 1 && stats.resets == 0);
+		assert(stats.HitRate() == 0.5);
+
+		// A new generation (maps reloaded, normalizeRegistration flipped) drops every entry.
+		auto flipped = cache.GetOrCompute(0x10u, 2, compute(0x10u));
+		assert(flipped && flipped->regKey == 0x10u);
+		assert(computed == 2);
+		stats = cache.GetStats();
+		assert(stats.resets == 1 && stats.size == 1);
+
+		// Going back is another change, not a return to the old table.
+		auto back = cache.GetOrCompute(0x10u, 1, compute(0x21u));
+		assert(back && back->regKey == 0x21u);
+		assert(cache.GetStats().resets == 2);
+	}
+
+	void DoesNotCacheMisses()
+	{
+		CC::GenerationalFormCache<Entry> cache;
+		int computed = 0;
+		const auto missing = [&]() {
+			++computed;
+			return std::optional<Entry>{};
+		};
+		assert(!cache.GetOrCompute(0x30u, 1, missing));
+		assert(!cache.GetOrCompute(0x30u, 1, missing));
+		assert(computed == 2);
+		assert(cache.GetStats().size == 0);
+
+		assert(cache.GetOrCompute(0x30u, 1, []() { return std::optional<Entry>(Entry{ 0x30u, 5 }); }));
+		cache.Clear();
+		assert(cache.GetStats().size == 0);
+	}
+
+	void EmptyStatsHaveZeroRate()
+	{
+		const CC::Stats stats{};
+		assert(stats.HitRate() == 0.0);
+	}
+}
+
+int main()
+{
+	MemoisesPerGeneration();
+	DoesNotCacheMisses();
+	EmptyStatsHaveZeroRate();
+	return 0;
+}
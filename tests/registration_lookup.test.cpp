@@ -0,0 +1,163 @@
+#include "CodexOfPowerNG/RcuCell.h"
+#include "CodexOfPowerNG/RegistrationLookupSnapshot.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	namespace Lookup = CodexOfPowerNG::RegistrationLookup;
+	using CodexOfPowerNG::RcuCell;
+
+	void SortedIdListOps()
+	{
+		Lookup::FormIdList ids;
+		Lookup::Insert(ids, 30);
+		Lookup::Insert(ids, 10);
+		Lookup::Insert(ids, 20);
+		Lookup::Insert(ids, 10);
+		Lookup::Insert(ids, 0);
+		assert((ids == Lookup::FormIdList{ 10, 20, 30 }));
+
+		assert(Lookup::Contains(ids, 20));
+		assert(!Lookup::Contains(ids, 0));
+		assert(!Lookup::Contains(ids, 25));
+		assert(Lookup::ContainsAny(ids, 25, 30));
+		assert(!Lookup::ContainsAny(ids, 25, 25));
+
+		Lookup::InsertAll(ids, std::vector<std::uint32_t>{ 25, 5, 20, 0, 40 });
+		assert((ids == Lookup::FormIdList{ 5, 10, 20, 25, 30, 40 }));
+
+		Lookup::Erase(ids, 20);
+		Lookup::Erase(ids, 21);
+		assert((ids == Lookup::FormIdList{ 5, 10, 25, 30, 40 }));
+
+		// The branchless search agrees with std::binary_search at every size and position.
+		for (std::uint32_t size = 0; size < 40; ++size) {
+			Lookup::FormIdList sparse;
+			for (std::uint32_t i = 0; i < size; ++i) {
+				sparse.push_back(2 * i + 1);
+			}
+			for (std::uint32_t probe = 1; probe < 2 * size + 3; ++probe) {
+				assert(Lookup::Contains(sparse, probe) == std::binary_search(sparse.begin(), sparse.end(), probe));
+			}
+		}
+
+		const std::unordered_map<std::uint32_t, std::uint32_t> registered{ { 7, 1 }, { 3, 0 }, { 9, 5 } };
+		assert((Lookup::SortedIds(registered, [](const auto& e) { return e.first; }) == Lookup::FormIdList{ 3, 7, 9 }));
+		const std::unordered_set<std::uint32_t> blocked{ 4, 2 };
+		assert((Lookup::SortedIds(blocked) == Lookup::FormIdList{ 2, 4 }));
+	}
+
+	void SnapshotsShareUneditedLists()
+	{
+		Lookup::Snapshot first;
+		first.registered = Lookup::Share({ 1, 2 });
+		first.notified = Lookup::Share({ 5 });
+		assert(first.blocked && first.blocked->empty());
+
+		auto second = first;
+		Lookup::Rewrite(second.notified, [](Lookup::FormIdList& ids) { Lookup::Insert(ids, 3); });
+		assert(second.registered == first.registered && second.blocked == first.blocked);
+		assert((*second.notified == Lookup::FormIdList{ 3, 5 }));
+		assert((*first.notified == Lookup::FormIdList{ 5 }));
+	}
+
+	void PublishReplacesValueAndFreesThePrevious()
+	{
+		struct Tracked
+		{
+			std::shared_ptr<int> alive;
+			int                  value{ 0 };
+		};
+
+		auto first = std::make_shared<int>(1);
+		std::weak_ptr<int> firstAlive = first;
+		RcuCell<Tracked> cell(std::make_unique<const Tracked>(Tracked{ std::move(first), 1 }));
+		{
+			const auto guard = cell.Read();
+			assert(guard->value == 1);
+		}
+
+		auto next = cell.CloneCurrent();
+		next->alive = std::make_shared<int>(2);
+		next->value = 2;
+		cell.Publish(std::move(next));
+		assert(firstAlive.expired());
+		assert(cell.Read()->value == 2);
+	}
+
+	// Readers check an invariant that only holds for a fully built value while a writer republishes
+	// as fast as it can; a reader seeing a freed or half-built snapshot trips the checksum.
+	void ConcurrentReadersSeeWholeSnapshots()
+	{
+		struct Value
+		{
+			std::vector<std::uint32_t> ids;
+			std::uint64_t              sum{ 0 };
+			std::uint64_t              version{ 0 };
+		};
+
+		RcuCell<Value>    cell;
+		std::atomic_bool  stop{ false };
+		std::atomic<bool> failed{ false };
+
+		std::atomic<std::uint64_t> reads{ 0 };
+		std::vector<std::thread>   readers;
+		for (int t = 0; t < 3; ++t) {
+			readers.emplace_back([&]() {
+				std::uint64_t lastVersion = 0;
+				while (!stop.load(std::memory_order_relaxed)) {
+					{
+						const auto guard = cell.Read();
+						std::uint64_t sum = 0;
+						for (const auto id : guard->ids) {
+							sum += id;
+						}
+						if (sum != guard->sum || guard->version < lastVersion) {
+							failed.store(true);
+						}
+						lastVersion = guard->version;
+					}
+					reads.fetch_add(1, std::memory_order_relaxed);
+					std::this_thread::yield();
+				}
+			});
+		}
+
+		for (std::uint32_t round = 1; round <= 500; ++round) {
+			auto next = cell.CloneCurrent();
+			next->ids.push_back(round);
+			next->sum += round;
+			next->version = round;
+			cell.Publish(std::move(next));
+			std::this_thread::yield();
+		}
+		while (reads.load(std::memory_order_relaxed) < 500) {
+			std::this_thread::yield();
+		}
+		stop.store(true);
+		for (auto& reader : readers) {
+			reader.join();
+		}
+
+		assert(!failed.load());
+		assert(cell.Read()->ids.size() == 500);
+	}
+}
+
+int main()
+{
+	SortedIdListOps();
+	SnapshotsShareUneditedLists();
+	PublishReplacesValueAndFreesThePrevious();
+	ConcurrentReadersSeeWholeSnapshots();
+	return 0;
+}
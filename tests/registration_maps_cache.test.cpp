@@ -0,0 +1,183 @@
+#include "CodexOfPowerNG/RegistrationMapsCache.h"
+
+#if __has_include(<nlohmann/json.hpp>)
+#	include "CodexOfPowerNG/RegistrationMapsSax.h"
+#	define COPNG_TEST_MAPS_SAX 1
+#endif
+
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	namespace Cache = CodexOfPowerNG::RegistrationMaps::Cache;
+
+	[[nodiscard]] Cache::Key MakeKey()
+	{
+		return Cache::Key{
+			0xA11CE5u,
+			{
+				{ "Data/SKSE/Plugins/CodexOfPowerNG/exclude_map.json", true, 1234, 99 },
+				{ "Data/SKSE/Plugins/CodexOfPowerNG/exclude_user.json", false, 0, 0 },
+				{ "Data/SKSE/Plugins/CodexOfPowerNG/exclude_patch_01.json", false, 0, 0 },
+				{ "Data/SKSE/Plugins/CodexOfPowerNG/variant_map.json", true, 77, 100 },
+			}
+		};
+	}
+
+	// A plugin swapped in place keeps its name and slot; only its size or mtime tells it apart.
+	void PluginStampsFeedTheLoadOrder()
+	{
+		const auto base = Cache::MixPlugin(Cache::kFnvOffset, "Skyrim.esm", 0, 249'000'000, 100);
+		assert(base == Cache::MixPlugin(Cache::kFnvOffset, "Skyrim.esm", 0, 249'000'000, 100));
+		assert(base != Cache::MixPlugin(Cache::kFnvOffset, "Skyrim.esm", 0, 249'000'000, 101));
+		assert(base != Cache::MixPlugin(Cache::kFnvOffset, "Skyrim.esm", 0, 249'000'001, 100));
+		assert(base != Cache::MixPlugin(Cache::kFnvOffset, "Skyrim.esm", 1, 249'000'000, 100));
+		assert(base != Cache::MixPlugin(Cache::kFnvOffset, "Update.esm", 0, 249'000'000, 100));
+	}
+
+	[[nodiscard]] std::optional<Cache::Tables> DecodeBytes(const std::vector<char>& bytes, const Cache::Key& key)
+	{
+		return Cache::Decode(std::span<const char>(bytes.data(), bytes.size()), key);
+	}
+
+	void RoundTripsAndValidatesKey()
+	{
+		Cache::Tables tables;
+		for (std::uint32_t i = 0; i < 5000; ++i) {
+			tables.excluded.insert(0x0A000000u + i * 7u);
+		}
+		tables.variantBase.emplace(0x00012EB7u, 0x00012EB6u);
+		tables.variantBase.emplace(0x0100ABCDu, 0x00012EB6u);
+
+		const auto key = MakeKey();
+		const auto bytes = Cache::Encode(key, tables);
+		// Deterministic: the same tables encode to the same bytes regardless of hash order.
+		assert(Cache::Encode(key, Cache::Tables{ tables.excluded, tables.variantBase }) == bytes);
+
+		const auto decoded = DecodeBytes(bytes, key);
+		assert(decoded);
+		assert(decoded->excluded == tables.excluded);
+		assert(decoded->variantBase == tables.variantBase);
+
+		auto otherLoadOrder = key;
+		otherLoadOrder.loadOrder ^= 1;
+		assert(!DecodeBytes(bytes, otherLoadOrder));
+
+		auto touched = key;
+		touched.sources[0].mtime += 1;
+		assert(!DecodeBytes(bytes, touched));
+
+		auto resized = key;
+		resized.sources[3].size += 1;
+		assert(!DecodeBytes(bytes, resized));
+
+		auto patchAdded = key;
+		patchAdded.sources[2] = { patchAdded.sources[2].path, true, 10, 5 };
+		patchAdded.sources.push_back({ "Data/SKSE/Plugins/CodexOfPowerNG/exclude_patch_02.json", false, 0, 0 });
+		assert(!DecodeBytes(bytes, patchAdded));
+	}
+
+	void RejectsDamagedFiles()
+	{
+		Cache::Tables tables;
+		tables.excluded.insert(0x00000014u);
+		tables.variantBase.emplace(0x00000020u, 0x00000010u);
+		const auto key = MakeKey();
+		const auto bytes = Cache::Encode(key, tables);
+
+		assert(!DecodeBytes({}, key));
+		for (std::size_t size = 0; size < bytes.size(); size += 3) {
+			assert(!DecodeBytes(std::vector<char>(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(size)), key));
+		}
+
+		auto flipped = bytes;
+		flipped.back() ^= 0x40;
+		assert(!DecodeBytes(flipped, key));
+
+		auto badMagic = bytes;
+		badMagic[0] = 'X';
+		assert(!DecodeBytes(badMagic, key));
+
+		auto trailing = bytes;
+		trailing.push_back('\0');
+		assert(!DecodeBytes(trailing, key));
+
+		const auto empty = DecodeBytes(Cache::Encode(key, {}), key);
+		assert(empty && empty->excluded.empty() && empty->variantBase.empty());
+	}
+
+#ifdef COPNG_TEST_MAPS_SAX
+	namespace Sax = CodexOfPowerNG::RegistrationMaps::Sax;
+
+	void SaxMatchesDomShapeChecks()
+	{
+		const std::string exclude = R"({
+			"version": 1,
+			"note": { "forms": [ { "file": "Nested.esp", "id": "0x1" } ] },
+			"forms": [
+				{ "file": "Skyrim.esm", "id": "0x00012EB7" },
+				{ "file": "Skyrim.esm" },
+				{ "file": 5, "id": "0x2" },
+				"not an object",
+				{ "file": "Dawnguard.esm", "id": "0x0200ABCD", "extra": { "id": "0xBAD" } },
+				{ "id": "0x3", "file": "" }
+			]
+		} trailing)";
+		std::vector<std::pair<std::string, std::string>> seen;
+		const bool ok = Sax::ParseExcludeEntries(exclude, [&](const Sax::FormRef& entry) {
+			seen.emplace_back(entry.file, entry.id);
+		});
+		assert(ok);
+		assert((seen == std::vector<std::pair<std::string, std::string>>{
+					   { "Skyrim.esm", "0x00012EB7" },
+					   { "Dawnguard.esm", "0x0200ABCD" },
+					   { "", "0x3" },
+				   }));
+
+		const std::string variants = R"({
+			"mappings": [
+				{ "variant": { "file": "A.esp", "id": "0x10" }, "base": { "file": "Skyrim.esm", "id": "0x20" } },
+				{ "variant": { "file": "A.esp", "id": "0x11" } },
+				{ "variant": "A.esp", "base": { "file": "Skyrim.esm", "id": "0x20" } },
+				{ "base": { "id": "0x21", "file": "Skyrim.esm" }, "variant": { "file": "B.esp", "id": "0x12" } }
+			]
+		})";
+		std::vector<std::string> pairs;
+		const bool variantsOk = Sax::ParseVariantEntries(variants, [&](const Sax::FormRef& variant, const Sax::FormRef& base) {
+			pairs.push_back(variant.file + ":" + variant.id + "->" + base.file + ":" + base.id);
+		});
+		assert(variantsOk);
+		assert((pairs == std::vector<std::string>{ "A.esp:0x10->Skyrim.esm:0x20", "B.esp:0x12->Skyrim.esm:0x21" }));
+
+		std::string error;
+		std::size_t count = 0;
+		const bool broken = Sax::ParseExcludeEntries(
+			R"({ "forms": [ { "file": "A.esp", "id": "0x1" }, { "file": )",
+			[&](const Sax::FormRef&) { ++count; },
+			&error);
+		assert(!broken && !error.empty() && count == 1);
+
+		const bool topArray = Sax::ParseExcludeEntries(R"([ { "forms": [ { "file": "A", "id": "1" } ] } ])", [&](const Sax::FormRef&) {
+			++count;
+		});
+		assert(topArray && count == 1);
+	}
+#endif
+}
+
+int main()
+{
+	RoundTripsAndValidatesKey();
+	RejectsDamagedFiles();
+	PluginStampsFeedTheLoadOrder();
+#ifdef COPNG_TEST_MAPS_SAX
+	SaxMatchesDomShapeChecks();
+#endif
+	return 0;
+}
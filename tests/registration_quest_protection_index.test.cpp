@@ -0,0 +1,252 @@
+#include "CodexOfPowerNG/RegistrationQuestProtectionIndex.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	namespace QP = CodexOfPowerNG::Registration::QuestProtection;
+
+	// Synthetic quest/alias model: each quest is running or not and has alias slots holding base forms.
+	struct FakeQuest
+	{
+		std::uint32_t              id{ 0 };
+		bool                       running{ false };
+		std::vector<std::uint32_t> aliasForms{};
+	};
+
+	[[nodiscard]] QP::QuestForms Collect(const FakeQuest& quest)
+	{
+		QP::QuestForms result{ quest.id, {} };
+		if (quest.running) {
+			result.forms = quest.aliasForms;
+		}
+		return result;
+	}
+
+	// What the old full rescan produced; the index must always converge to it.
+	[[nodiscard]] std::unordered_set<std::uint32_t> FullRescan(const std::vector<FakeQuest>& quests)
+	{
+		std::unordered_set<std::uint32_t> out;
+		for (const auto& quest : quests) {
+			if (!quest.running) {
+				continue;
+			}
+			for (const auto formId : quest.aliasForms) {
+				if (formId != 0) {
+					out.insert(formId);
+				}
+			}
+		}
+		return out;
+	}
+
+	[[nodiscard]] std::uint32_t RefCount(const QP::ProtectionIndex& index, std::uint32_t formId)
+	{
+		const auto it = index.protectedForms.find(formId);
+		return it == index.protectedForms.end() ? 0u : it->second;
+	}
+
+	[[nodiscard]] bool Matches(const QP::ProtectionIndex& index, const std::unordered_set<std::uint32_t>& expected)
+	{
+		if (index.protectedForms.size() != expected.size()) {
+			return false;
+		}
+		for (const auto formId : expected) {
+			if (!index.protectedForms.contains(formId)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void RunSweep(QP::ProtectionIndex& index, const std::vector<FakeQuest>& quests, std::size_t questsPerStep)
+	{
+		QP::BeginSweep(index);
+		std::size_t steps = 0;
+		for (;;) {
+			std::size_t visited = 0;
+			const bool done = QP::SweepStep(
+				index,
+				quests.size(),
+				[&](std::size_t i) { return Collect(quests[i]); },
+				[&]() { return ++visited >= questsPerStep; });
+			++steps;
+			if (done) {
+				break;
+			}
+		}
+		assert(steps == (quests.empty() ? 1 : (quests.size() + questsPerStep - 1) / questsPerStep));
+	}
+
+	void SetQuestFormsDiffsAndRefcounts()
+	{
+		QP::ProtectionIndex index;
+		QP::SetQuestForms(index, 1, { 0x10, 0x20, 0x20, 0 });
+		assert(QP::TakeChanged(index));
+		assert(!QP::TakeChanged(index));
+		assert(index.protectedForms.size() == 2 && RefCount(index, 0x20) == 1u);
+
+		// A second quest sharing 0x20 only bumps its count.
+		QP::SetQuestForms(index, 2, { 0x20, 0x30 });
+		assert(QP::TakeChanged(index));
+		assert(RefCount(index, 0x20) == 2u);
+
+		// Same forms again: nothing changes.
+		QP::SetQuestForms(index, 2, { 0x30, 0x20 });
+		assert(!QP::TakeChanged(index));
+
+		// Quest 1 stops; 0x20 stays protected through quest 2.
+		QP::SetQuestForms(index, 1, {});
+		assert(QP::TakeChanged(index));
+		assert(!index.protectedForms.contains(0x10));
+		assert(RefCount(index, 0x20) == 1u);
+		assert(!index.quests.contains(1));
+
+		// Quest 2 swaps an alias: one release, one retain.
+		QP::SetQuestForms(index, 2, { 0x20, 0x40 });
+		assert(QP::TakeChanged(index));
+		assert(!index.protectedForms.contains(0x30) && index.protectedForms.contains(0x40));
+
+		QP::SetQuestForms(index, 3, {});
+		assert(!QP::TakeChanged(index));
+		assert(!index.quests.contains(3));
+	}
+
+	void SweepConvergesAcrossSteps()
+	{
+		std::vector<FakeQuest> quests;
+		for (std::uint32_t q = 0; q < 257; ++q) {
+			FakeQuest quest{ 0x00050000u + q, q % 3 != 0, {} };
+			for (std::uint32_t a = 0; a < q % 5; ++a) {
+				quest.aliasForms.push_back(0x01000000u + (q * 7u + a * 13u) % 400u);
+			}
+			quests.push_back(quest);
+		}
+		quests[10].id = 0;  // null form slot
+
+		QP::ProtectionIndex index;
+		RunSweep(index, quests, 16);
+		assert(Matches(index, FullRescan(quests)));
+		assert(QP::TakeChanged(index));
+
+		// Nothing changed in the model: a second pass publishes nothing.
+		RunSweep(index, quests, 40);
+		assert(!QP::TakeChanged(index));
+		assert(Matches(index, FullRescan(quests)));
+
+		// Script-side changes that raised no event: the sweep picks them up.
+		quests[1].aliasForms = { 0x02000001u };
+		quests[4].running = false;
+		RunSweep(index, quests, 7);
+		assert(QP::TakeChanged(index));
+		assert(Matches(index, FullRescan(quests)));
+
+		// Quests that vanished from the data handler are dropped when the pass completes.
+		const auto dropped = quests.back();
+		quests.pop_back();
+		QP::BeginSweep(index);
+		std::size_t visited = 0;
+		const bool finishedEarly =
+			QP::SweepStep(index, quests.size(), [&](std::size_t i) { return Collect(quests[i]); }, [&]() { return ++visited == 5; });
+		assert(!finishedEarly);
+		assert(index.quests.contains(dropped.id) == (dropped.running && !dropped.aliasForms.empty()));
+		while (!QP::SweepStep(index, quests.size(), [&](std::size_t i) { return Collect(quests[i]); }, []() { return false; })) {}
+		assert(!index.quests.contains(dropped.id));
+		assert(Matches(index, FullRescan(quests)));
+		assert(!index.sweeping);
+	}
+
+	void EventsDuringSweepAreKept()
+	{
+		std::vector<FakeQuest> quests{
+			{ 1, true, { 0x10 } },
+			{ 2, false, { 0x20 } },
+			{ 3, true, { 0x30 } },
+		};
+		QP::ProtectionIndex index;
+		RunSweep(index, quests, 1);
+
+		QP::BeginSweep(index);
+		std::size_t visited = 0;
+		const bool finishedEarly =
+			QP::SweepStep(index, quests.size(), [&](std::size_t i) { return Collect(quests[i]); }, [&]() { return ++visited == 1; });
+		assert(!finishedEarly);
+
+		// Quest 2 starts after the cursor passed it; its start event stamps the current pass.
+		quests[1].running = true;
+		QP::SetQuestForms(index, 2, Collect(quests[1]).forms);
+		while (!QP::SweepStep(index, quests.size(), [&](std::size_t i) { return Collect(quests[i]); }, []() { return false; })) {}
+		assert(index.protectedForms.contains(0x20));
+		assert(Matches(index, FullRescan(quests)));
+	}
+
+	void SnapshotsShareUntilChanged()
+	{
+		QP::ProtectionIndex index;
+		QP::SetQuestForms(index, 1, { 0x10, 0x20 });
+		const QP::ProtectedForms published = index.protectedForms;
+		assert(published.shares_storage_with(index.protectedForms));
+
+		QP::SetQuestForms(index, 2, { 0x30 });
+		assert(!published.shares_storage_with(index.protectedForms));
+		assert(published.size() == 2 && index.protectedForms.size() == 3);
+	}
+
+	// A stale published set sends every register check to a live walk; one frame walks once.
+	void LiveWalkRunsOncePerKey()
+	{
+		std::vector<FakeQuest> quests{
+			{ 1, true, { 0x10, 0x11 } },
+			{ 2, false, { 0x20 } },
+			{ 3, true, { 0x30 } },
+		};
+		const auto walk = [&](auto& forms) {
+			for (const auto& quest : quests) {
+				for (const auto formId : Collect(quest).forms) {
+					forms.insert(formId);
+				}
+			}
+		};
+
+		QP::LiveWalk live;
+		constexpr std::uint32_t kLookups = 500;
+		std::uint32_t           hits = 0;
+		for (std::uint32_t i = 0; i < kLookups; ++i) {
+			hits += QP::LiveForms(live, 7, walk).contains(0x10 + (i % 0x30)) ? 1u : 0u;
+		}
+		assert(live.walks == 1);
+		assert(hits > 0);
+		assert(!QP::LiveForms(live, 7, walk).contains(0x20));
+
+		// The next frame sees quest 2 running.
+		quests[1].running = true;
+		assert(!QP::LiveForms(live, 7, walk).contains(0x20));
+		assert(QP::LiveForms(live, 8, walk).contains(0x20));
+		assert(live.walks == 2);
+
+		// A walk that throws caches nothing; the next check walks again.
+		bool threw = false;
+		try {
+			(void)QP::LiveForms(live, 9, [](auto&) { throw 1; });
+		} catch (int) {
+			threw = true;
+		}
+		assert(threw && !live.valid);
+		assert(QP::LiveForms(live, 9, walk).contains(0x30));
+		assert(live.walks == 3);
+	}
+}
+
+int main()
+{
+	SetQuestFormsDiffsAndRefcounts();
+	SweepConvergesAcrossSteps();
+	EventsDuringSweepAreKept();
+	SnapshotsShareUntilChanged();
+	LiveWalkRunsOncePerKey();
+	return 0;
+}
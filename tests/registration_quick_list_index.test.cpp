@@ -0,0 +1,149 @@
+#include "CodexOfPowerNG/NamePoolOps.h"
+#include "CodexOfPowerNG/RegistrationQuickListIndex.h"
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Row
+	{
+		std::uint32_t formId{ 0 };
+		std::uint32_t regKey{ 0 };
+		std::uint32_t group{ 0 };
+		std::string   name{};
+		int           count{ 0 };
+	};
+
+	struct NamedRow
+	{
+		std::uint32_t                     formId{ 0 };
+		std::uint32_t                     regKey{ 0 };
+		std::uint32_t                     group{ 0 };
+		CodexOfPowerNG::NamePool::NameRef name{};
+	};
+
+	[[nodiscard]] std::vector<std::uint32_t> VisibleRegKeys(
+		const CodexOfPowerNG::Registration::QuickListIndex::EligibleIndex<Row>& index)
+	{
+		std::vector<std::uint32_t> keys;
+		index.items.for_each([&keys](const auto& ref) { keys.push_back(ref->regKey); });
+		return keys;
+	}
+}
+
+int main()
+{
+	namespace Index = CodexOfPowerNG::Registration::QuickListIndex;
+
+	Index::EligibleIndex<Row> index;
+	assert(Index::NeedsRebuild(index, 0u));
+
+	// Dirty marks are ignored until the first full scan.
+	Index::MarkObjectDirty(index, 0x10u);
+	assert(index.dirtyObjects.empty());
+
+	// Full scan: 0x21 is a variant of regKey 0x20 and stays hidden behind the representative.
+	Index::Rebuild(
+		index,
+		{
+			Row{ 0x30u, 0x30u, 1u, "Apple", 1 },
+			Row{ 0x10u, 0x10u, 0u, "Sword", 1 },
+			Row{ 0x20u, 0x20u, 0u, "Axe", 2 },
+			Row{ 0x21u, 0x20u, 0u, "Axe", 1 },
+		},
+		0b101u);
+	assert(!Index::NeedsRebuild(index, 0b101u));
+	assert(Index::NeedsRebuild(index, 0b001u));
+	assert((VisibleRegKeys(index) == std::vector<std::uint32_t>{ 0x20u, 0x10u, 0x30u }));
+	assert(index.members.size() == 4);
+	assert(index.regKeyMembers.at(0x20u).size() == 2);
+	assert(index.visible.at(0x20u)->formId == 0x20u);
+
+	// New object lands in sorted position without a rescan.
+	Index::Upsert(index, Row{ 0x40u, 0x40u, 0u, "Bow", 1 });
+	assert((VisibleRegKeys(index) == std::vector<std::uint32_t>{ 0x20u, 0x40u, 0x10u, 0x30u }));
+
+	// Re-evaluating the representative updates it in place.
+	Index::Upsert(index, Row{ 0x40u, 0x40u, 0u, "Bow", 5 });
+	assert(index.items.size() == 4);
+	assert(index.items.at(1)->count == 5);
+
+	// A sibling evaluation never replaces the visible representative.
+	Index::Upsert(index, Row{ 0x21u, 0x20u, 0u, "Axe", 9 });
+	assert(index.items.at(0)->formId == 0x20u);
+	assert(index.items.at(0)->count == 2);
+
+	// Losing the representative hides the regKey and queues its sibling for re-evaluation.
+	Index::EraseObject(index, 0x20u);
+	assert(!index.visible.contains(0x20u));
+	assert((VisibleRegKeys(index) == std::vector<std::uint32_t>{ 0x40u, 0x10u, 0x30u }));
+	auto dirty = Index::TakeDirtyObjects(index);
+	assert(dirty.size() == 1 && dirty.contains(0x21u));
+	assert(index.dirtyObjects.empty());
+
+	Index::Upsert(index, Row{ 0x21u, 0x20u, 0u, "Axe", 1 });
+	assert(index.visible.at(0x20u)->formId == 0x21u);
+	assert(index.items.at(0)->formId == 0x21u);
+
+	// Registering a regKey drops every member for it, including queued dirty marks.
+	Index::MarkObjectDirty(index, 0x21u);
+	Index::EraseRegKey(index, 0x20u);
+	assert(!index.visible.contains(0x20u));
+	assert(!index.members.contains(0x21u));
+	assert(!index.regKeyMembers.contains(0x20u));
+	assert(index.dirtyObjects.empty());
+	assert((VisibleRegKeys(index) == std::vector<std::uint32_t>{ 0x40u, 0x10u, 0x30u }));
+
+	// Erasing a non-member is a no-op.
+	Index::EraseObject(index, 0x99u);
+	assert(index.items.size() == 3);
+
+	// MarkFormDirty resolves a regKey to its representative object.
+	Index::Upsert(index, Row{ 0x51u, 0x50u, 2u, "Gem", 1 });
+	Index::MarkFormDirty(index, 0x50u);
+	dirty = Index::TakeDirtyObjects(index);
+	assert(dirty.contains(0x50u) && dirty.contains(0x51u));
+
+	// An object whose regKey changed moves to the new key.
+	Index::Upsert(index, Row{ 0x51u, 0x52u, 2u, "Gem", 1 });
+	assert(!index.visible.contains(0x50u));
+	assert(index.visible.at(0x52u)->formId == 0x51u);
+	assert(!index.regKeyMembers.contains(0x50u) && index.regKeyMembers.at(0x52u).size() == 1);
+	assert(index.items.size() == 4);
+
+	// Pages are shared references into the index, not copies.
+	const auto page = Index::Page(index, 1, 2);
+	assert(page.size() == 2);
+	assert(page[0].get() == index.items.at(1).get());
+	assert(Index::Page(index, 4, 10).empty());
+	assert(Index::Page(index, 3, 10).size() == 1);
+
+	// Eventless changes re-evaluate every indexed object.
+	Index::MarkAllDirty(index);
+	dirty = Index::TakeDirtyObjects(index);
+	assert(dirty.size() == index.members.size());
+	assert(dirty.contains(0x10u) && dirty.contains(0x51u));
+
+	Index::RequestRebuild(index);
+	assert(Index::NeedsRebuild(index, 0b101u));
+	Index::MarkAllDirty(index);
+	assert(index.dirtyObjects.empty());
+
+	// Interned names order by collation key (case-insensitive), not by pointer or raw bytes.
+	namespace NamePoolOps = CodexOfPowerNG::NamePool::Ops;
+	NamePoolOps::PoolState<std::uint32_t> pool;
+	(void)NamePoolOps::SyncLanguage(pool, 1u, CodexOfPowerNG::NameCollation::Locale::kDefault);
+	Index::EligibleIndex<NamedRow> named;
+	named.built = true;
+	Index::Upsert(named, NamedRow{ 0x1u, 0x1u, 0u, NamePoolOps::Intern(pool, 0x1u, "iron") });
+	Index::Upsert(named, NamedRow{ 0x2u, 0x2u, 0u, NamePoolOps::Intern(pool, 0x2u, "Axe") });
+	Index::Upsert(named, NamedRow{ 0x3u, 0x3u, 0u, NamePoolOps::Intern(pool, 0x3u, "Iron") });
+	assert(named.items.at(0)->formId == 0x2u);
+	assert(named.items.at(1)->formId == 0x3u);
+	assert(named.items.at(2)->formId == 0x1u);
+
+	return 0;
+}
@@ -0,0 +1,93 @@
+#include "CodexOfPowerNG/RegistrationTccMembership.h"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+	namespace TM = CodexOfPowerNG::Registration::TccMembership;
+
+	struct FakeForm
+	{
+		std::uint32_t formId{ 0 };
+	};
+
+	// FormList stand-in: plugin-defined entries (may hold null forms) plus script-added ids.
+	struct FakeList
+	{
+		std::vector<const FakeForm*> forms{};
+		std::vector<std::uint32_t>   added{};
+		bool                         hasAdded{ false };
+	};
+
+	[[nodiscard]] TM::Fingerprint FingerprintOf(const FakeList& list)
+	{
+		TM::Fingerprint fingerprint{};
+		fingerprint.formCount = static_cast<std::uint32_t>(list.forms.size());
+		if (!list.forms.empty() && list.forms.back()) {
+			fingerprint.lastFormId = list.forms.back()->formId;
+		}
+		if (list.hasAdded && !list.added.empty()) {
+			fingerprint.addedCount = static_cast<std::uint32_t>(list.added.size());
+			fingerprint.lastAddedId = list.added.back();
+		}
+		return fingerprint;
+	}
+
+	[[nodiscard]] TM::ListMembership Build(const FakeList& list)
+	{
+		return TM::Build(
+			FingerprintOf(list),
+			list.forms,
+			[](const FakeForm* form) { return form ? form->formId : 0u; },
+			list.hasAdded ? &list.added : nullptr);
+	}
+}
+
+int main()
+{
+	const FakeForm sword{ 0x00012EB7 };
+	const FakeForm helmet{ 0x00013950 };
+	const FakeForm amulet{ 0x0002AC61 };
+
+	FakeList master{ { &sword, nullptr, &helmet }, {}, false };
+	const auto masterForms = Build(master);
+	assert(masterForms.forms.size() == 2);
+	assert(TM::HasEither(masterForms, sword.formId, 0));
+	assert(TM::HasEither(masterForms, 0x0BADF00D, helmet.formId));
+	assert(!TM::HasEither(masterForms, amulet.formId, amulet.formId));
+	assert(!TM::HasEither(masterForms, 0, 0));
+
+	// Displayed list grows through script-added ids only.
+	FakeList displayed{ {}, {}, true };
+	auto displayedForms = Build(displayed);
+	assert(displayedForms.forms.empty());
+	assert(!TM::HasEither(displayedForms, sword.formId, helmet.formId));
+
+	displayed.added.push_back(sword.formId);
+	assert(!(FingerprintOf(displayed) == displayedForms.fingerprint));
+	displayedForms = Build(displayed);
+	assert(TM::HasEither(displayedForms, sword.formId, 0));
+	assert(FingerprintOf(displayed) == displayedForms.fingerprint);
+
+	// Removing one display and adding another in the same frame keeps the count but moves the tail.
+	displayed.added = { helmet.formId };
+	assert(!(FingerprintOf(displayed) == displayedForms.fingerprint));
+	displayedForms = Build(displayed);
+	assert(!TM::HasEither(displayedForms, sword.formId, 0));
+	assert(TM::HasEither(displayedForms, 0, helmet.formId));
+
+	// Large lists behave the same as small ones.
+	FakeList big{ {}, {}, true };
+	for (std::uint32_t i = 1; i <= 10000; ++i) {
+		big.added.push_back(0x05000000u + i);
+	}
+	const auto bigForms = Build(big);
+	assert(bigForms.forms.size() == 10000);
+	assert(TM::HasEither(bigForms, 0x05000000u + 1, 0));
+	assert(TM::HasEither(bigForms, 0x05000000u + 10000, 0));
+	assert(!TM::HasEither(bigForms, 0x05000000u + 10001, 0x05000000u));
+
+	return 0;
+}
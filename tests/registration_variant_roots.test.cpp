@@ -0,0 +1,113 @@
+#include "CodexOfPowerNG/RegistrationVariantRoots.h"
+
+#include <cassert>
+#include <cstdint>
+
+namespace
+{
+	namespace VR = CodexOfPowerNG::Registration::VariantRoots;
+	using VariantMap = CodexOfPowerNG::Containers::FlatFormIdMap<std::uint32_t>;
+
+	// The per-call loop GetRegisterKey() used to run (max 8 hops).
+	template <class AcceptStep>
+	[[nodiscard]] std::uint32_t WalkChain(const VariantMap& variantBase, std::uint32_t id, AcceptStep acceptStep)
+	{
+		for (int safety = 0; safety < 8; ++safety) {
+			const auto it = variantBase.find(id);
+			if (it == variantBase.end() || !acceptStep(id, it->second)) {
+				break;
+			}
+			id = it->second;
+		}
+		return id;
+	}
+
+	[[nodiscard]] bool ValidStep(std::uint32_t current, std::uint32_t next)
+	{
+		return next != 0 && next != current;
+	}
+
+	void FlattensChainsToOneProbe()
+	{
+		VariantMap variantBase;
+		// 0x10 -> 0x11 -> 0x12 -> 0x13 and a branch 0x20 -> 0x11.
+		variantBase.emplace(0x10u, 0x11u);
+		variantBase.emplace(0x11u, 0x12u);
+		variantBase.emplace(0x12u, 0x13u);
+		variantBase.emplace(0x20u, 0x11u);
+		variantBase.emplace(0x30u, 0x30u);  // self-mapping is not a step
+		variantBase.emplace(0x40u, 0u);
+
+		VR::CompileStats stats{};
+		const auto roots = VR::Compile(variantBase, ValidStep, &stats);
+		assert(stats.cycles == 0);
+		assert(stats.maxDepth >= 1 && stats.maxDepth <= 4);
+
+		for (const std::uint32_t id : { 0x10u, 0x11u, 0x12u, 0x13u, 0x20u, 0x30u, 0x40u, 0x99u }) {
+			assert(VR::Resolve(roots, id) == WalkChain(variantBase, id, ValidStep));
+		}
+		assert(VR::Resolve(roots, 0x10u) == 0x13u);
+		assert(VR::Resolve(roots, 0x20u) == 0x13u);
+		assert(VR::Resolve(roots, 0x99u) == 0x99u);
+	}
+
+	void StopsAtRejectedSteps()
+	{
+		VariantMap variantBase;
+		variantBase.emplace(0x10u, 0x11u);
+		variantBase.emplace(0x11u, 0x12u);  // 0x12 does not exist in game data
+		variantBase.emplace(0x12u, 0x13u);
+
+		const auto missing = [](std::uint32_t current, std::uint32_t next) { return ValidStep(current, next) && next != 0x12u; };
+		const auto roots = VR::Compile(variantBase, missing);
+		assert(VR::Resolve(roots, 0x10u) == 0x11u);
+		assert(VR::Resolve(roots, 0x11u) == 0x11u);
+		assert(VR::Resolve(roots, 0x12u) == 0x13u);
+	}
+
+	void BreaksCycles()
+	{
+		VariantMap variantBase;
+		variantBase.emplace(0x1u, 0x2u);
+		variantBase.emplace(0x2u, 0x3u);
+		variantBase.emplace(0x3u, 0x1u);
+		variantBase.emplace(0x9u, 0x2u);
+
+		VR::CompileStats stats{};
+		const auto roots = VR::Compile(variantBase, ValidStep, &stats);
+		assert(stats.cycles == 1);
+
+		// Every member of the loop, and anything feeding into it, lands on the same member.
+		const auto root = VR::Resolve(roots, 0x1u);
+		assert(root == 0x1u || root == 0x2u || root == 0x3u);
+		assert(VR::Resolve(roots, 0x2u) == root);
+		assert(VR::Resolve(roots, 0x3u) == root);
+		assert(VR::Resolve(roots, 0x9u) == root);
+	}
+
+	void FollowsDeepChains()
+	{
+		VariantMap variantBase;
+		constexpr std::uint32_t kDepth = 200;
+		for (std::uint32_t i = 1; i < kDepth; ++i) {
+			variantBase.emplace(0x1000u + i, 0x1000u + i - 1);
+		}
+
+		VR::CompileStats stats{};
+		const auto roots = VR::Compile(variantBase, ValidStep, &stats);
+		for (std::uint32_t i = 0; i < kDepth; ++i) {
+			assert(VR::Resolve(roots, 0x1000u + i) == 0x1000u);
+		}
+		assert(stats.cycles == 0);
+		assert(roots.size() == kDepth);
+	}
+}
+
+int main()
+{
+	FlattensChainsToOneProbe();
+	StopsAtRejectedSteps();
+	BreaksCycles();
+	FollowsDeepChains();
+	return 0;
+}
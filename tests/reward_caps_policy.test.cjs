@@ -61,7 +61,7 @@ test("skill rewards store fractional progress but apply whole-level actor deltas
   assert.match(coreSrc, /ActorAppliedRewardTotal\(av,\s*transition\.nextTotal\)/);
   assert.match(coreSrc, /ActorAppliedRewardTotal\(av,\s*transition\.previousTotal\)/);
   assert.match(coreSrc, /CaptureAppliedRewardDelta\(av, outcome\.stateDelta\)/);
-  assert.match(coreSrc, /RestoreActorValue\(RE::ACTOR_VALUE_MODIFIER::kPermanent,\s*av,\s*outcome\.actorDelta\)/);
+  assert.match(coreSrc, /ActorValueSync::ApplyPermanentDelta\(av,\s*outcome\.actorDelta,\s*ActorValueSync::Layer::kRewards\)/);
 
   assert.match(rewardsSrc, /const float previousApplied = ActorAppliedRewardTotal\(av, transition\.previousTotal\);/);
   assert.match(rewardsSrc, /const float nextApplied = ActorAppliedRewardTotal\(av, transition\.nextTotal\);/);
@@ -81,11 +81,11 @@ test("reward sync avoids synchronous fallback loops when scheduler is unavailabl
 
   assert.doesNotMatch(
     src,
-    /if \(QueueMainTask\(\[passState\]\(\) \{ RunRewardSyncPasses\(passState, kRewardSyncPassCount\); \}\)\) \{[\s\S]*?return;[\s\S]*?\}[\s\S]*?RunRewardSyncPasses\(passState, kRewardSyncPassCount\);/,
+    /if \(QueueMainTask\((?:TaskPriority::\w+, )?\[passState\]\(\) \{ RunRewardSyncPasses\(passState, kRewardSyncPassCount\); \}\)\) \{[\s\S]*?return;[\s\S]*?\}[\s\S]*?RunRewardSyncPasses\(passState, kRewardSyncPassCount\);/,
   );
   assert.doesNotMatch(
     src,
-    /if \(QueueMainTask\(\[rerunPassState\]\(\) \{ RunRewardSyncPasses\(rerunPassState, kRewardSyncPassCount\); \}\)\) \{[\s\S]*?return true;[\s\S]*?\}[\s\S]*?RunRewardSyncPasses\(rerunPassState, kRewardSyncPassCount\);/,
+    /if \(QueueMainTask\((?:TaskPriority::\w+, )?\[rerunPassState\]\(\) \{ RunRewardSyncPasses\(rerunPassState, kRewardSyncPassCount\); \}\)\) \{[\s\S]*?return true;[\s\S]*?\}[\s\S]*?RunRewardSyncPasses\(rerunPassState, kRewardSyncPassCount\);/,
   );
   assert.doesNotMatch(src, /Fallback when task interface is unavailable: finish synchronously/);
   assert.doesNotMatch(src, /not ready during fallback; aborting this quick pass/);
@@ -145,12 +145,13 @@ test("post-load/new-game path routes through build migration processing", () =>
   assert.match(src, /case SKSE::MessagingInterface::kPreLoadGame:[\s\S]*Rewards::ResetSyncSchedulersForLoad\(\)/);
   assert.match(src, /case SKSE::MessagingInterface::kPostLoadGame:[\s\S]*case SKSE::MessagingInterface::kNewGame:/);
   assert.match(src, /if \(message->type == SKSE::MessagingInterface::kNewGame\)[\s\S]*Rewards::ResetSyncSchedulersForLoad\(\)/);
-  assert.match(src, /void ProcessBuildMigrationState\(\) noexcept/);
-  assert.match(src, /BuildProgression::NormalizeLoadedSnapshot\(snapshot\);/);
+  assert.match(src, /void ProcessBuildMigrationState\(const BuildProgression::LegacyScoreTally\* tally = nullptr\) noexcept/);
+  assert.match(src, /BuildProgression::NormalizeLoadedSnapshot\(snapshot, nullptr, tally\);/);
+  assert.match(src, /BuildProgression::ContinueLegacyScoreTally\(\*tally, kPostLoadMigrationChunk\)/);
   assert.match(src, /BuildProgression::TryFinalizePendingMigration\(/);
   assert.match(src, /Rewards::CleanupLegacyRewardTotals\(\)/);
   assert.match(src, /BuildProgression::ConsumeMigrationNotice\(snapshot\)/);
-  assert.match(src, /ProcessBuildMigrationState\(\);/);
+  assert.match(src, /ProcessBuildMigrationState\(&\*tally\);/);
 });
 
 test("reward sync runtime protects load boundary and readiness retries", () => {
@@ -167,8 +168,8 @@ test("reward sync runtime protects load boundary and readiness retries", () => {
   assert.match(rewardsSrc, /if \(!IsRewardSyncEnvironmentReady\(\)\)/);
   assert.match(rewardsSrc, /watchdog: force restarting stale sync worker \(generation \{\}\)/);
   assert.match(engineSrc, /weaponAbilityRefreshRequested/);
-  assert.match(engineSrc, /UpdateWeaponAbility\(/);
-  assert.match(engineSrc, /RefreshEquippedWeaponAbilities\(\)/);
+  assert.match(engineSrc, /ActorValueSync::RequestWeaponAbilityRefresh\(\)/);
+  assert.doesNotMatch(engineSrc, /UpdateWeaponAbility\(/);
   assert.match(engineSrc, /MigrateLegacyAttackDamageMultReward/);
   assert.match(engineSrc, /RewardStateStore::Take\(RE::ActorValue::kAttackDamageMult\)/);
   assert.match(engineSrc, /ModActorValue\(RE::ActorValue::kAttackDamageMult,\s*-removable\)/);
@@ -0,0 +1,213 @@
+#include "CodexOfPowerNG/RewardsResync.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	using namespace CodexOfPowerNG::Rewards;
+
+	enum class AV : std::uint32_t
+	{
+		kHealth,
+		kCarryWeight,
+		kOneHanded,
+		kSpeedMult,
+	};
+
+	struct AVHash
+	{
+		std::size_t operator()(AV av) const noexcept { return static_cast<std::size_t>(av); }
+	};
+
+	// Stands in for the player's ActorValueOwner: rewards land on the permanent modifier channel.
+	class FakeActorValueOwner
+	{
+	public:
+		void SetBase(AV av, float base) { _values[av].base = base; }
+
+		void RestorePermanent(AV av, float delta)
+		{
+			++restores;
+			_values[av].permanentModifier += delta;
+		}
+
+		void AddTemporary(AV av, float delta) { _values[av].temporary += delta; }
+
+		[[nodiscard]] RewardActorObservation Observe(AV av)
+		{
+			++reads;
+			const auto& channels = _values[av];
+			const float permanent = channels.base + channels.permanentModifier;
+			return RewardActorObservation{ channels.base, permanent + channels.temporary, permanent, channels.permanentModifier };
+		}
+
+		int reads{ 0 };
+		int restores{ 0 };
+
+	private:
+		struct Channels
+		{
+			float base{ 0.0f };
+			float permanentModifier{ 0.0f };
+			float temporary{ 0.0f };
+		};
+
+		std::map<AV, Channels> _values;
+	};
+
+	struct PassCounters
+	{
+		std::size_t examined{ 0 };
+		std::size_t skipped{ 0 };
+		std::size_t adjusted{ 0 };
+	};
+
+	using Tracker = RewardResyncTracker<AV, AVHash>;
+
+	// The engine's pass reduced to its tracker contract: examine, correct, settle once converged.
+	PassCounters RunPass(FakeActorValueOwner& owner, Tracker& tracker, const std::vector<std::pair<AV, float>>& totals)
+	{
+		PassCounters counters{};
+		for (const auto& [av, total] : totals) {
+			const auto observed = owner.Observe(av);
+			if (!tracker.NeedsExamination(av, total, observed)) {
+				++counters.skipped;
+				continue;
+			}
+			++counters.examined;
+
+			const float delta = ComputeCarryWeightSyncDelta(
+				observed.base,
+				observed.current,
+				observed.permanent,
+				observed.permanentModifier,
+				total);
+			if (std::abs(delta) <= 0.001f) {
+				tracker.MarkSettled(av, total, observed);
+				continue;
+			}
+
+			owner.RestorePermanent(av, delta);
+			++counters.adjusted;
+			const auto after = owner.Observe(av);
+			if (std::abs(ComputeRewardSyncDelta(after.permanentModifier, total)) <= 0.001f) {
+				tracker.MarkSettled(av, total, after);
+			}
+		}
+		return counters;
+	}
+
+	void SteadyStateSkipsUnchangedActorValues()
+	{
+		FakeActorValueOwner owner;
+		owner.SetBase(AV::kHealth, 100.0f);
+		owner.SetBase(AV::kCarryWeight, 300.0f);
+		owner.SetBase(AV::kOneHanded, 15.0f);
+		owner.RestorePermanent(AV::kHealth, 10.0f);
+		owner.restores = 0;
+
+		Tracker tracker;
+		const std::vector<std::pair<AV, float>> totals{
+			{ AV::kHealth, 10.0f },
+			{ AV::kCarryWeight, 25.0f },
+			{ AV::kOneHanded, 2.0f },
+		};
+
+		auto counters = RunPass(owner, tracker, totals);
+		assert(counters.examined == 3 && counters.skipped == 0 && counters.adjusted == 2);
+		assert(owner.restores == 2);
+		assert(tracker.SettledCount() == 3);
+
+		counters = RunPass(owner, tracker, totals);
+		assert(counters.examined == 0 && counters.skipped == 3 && counters.adjusted == 0);
+		assert(owner.restores == 2);
+	}
+
+	void ReexaminesDirtyDriftedOrRetargetedActorValues()
+	{
+		FakeActorValueOwner owner;
+		owner.SetBase(AV::kHealth, 100.0f);
+		owner.SetBase(AV::kCarryWeight, 300.0f);
+		owner.SetBase(AV::kOneHanded, 15.0f);
+
+		Tracker                           tracker;
+		std::vector<std::pair<AV, float>> totals{
+			{ AV::kHealth, 10.0f },
+			{ AV::kCarryWeight, 25.0f },
+			{ AV::kOneHanded, 2.0f },
+		};
+		(void)RunPass(owner, tracker, totals);
+
+		// Something outside the reward path stripped part of the carry weight bonus.
+		owner.RestorePermanent(AV::kCarryWeight, -5.0f);
+		auto counters = RunPass(owner, tracker, totals);
+		assert(counters.examined == 1 && counters.adjusted == 1 && counters.skipped == 2);
+
+		// A grant changes the expected total before the actor catches up.
+		totals[2].second = 3.0f;
+		counters = RunPass(owner, tracker, totals);
+		assert(counters.examined == 1 && counters.adjusted == 1);
+
+		// Marked dirty but already aligned: examined once, nothing to correct, then settled again.
+		tracker.MarkDirty(AV::kHealth);
+		assert(tracker.DirtyCount() == 1);
+		counters = RunPass(owner, tracker, totals);
+		assert(counters.examined == 1 && counters.adjusted == 0);
+		assert(tracker.DirtyCount() == 0);
+
+		// Temporary effects move `current`, which the policies read, so the AV is looked at again.
+		owner.AddTemporary(AV::kOneHanded, 5.0f);
+		counters = RunPass(owner, tracker, totals);
+		assert(counters.examined == 1 && counters.adjusted == 0);
+		counters = RunPass(owner, tracker, totals);
+		assert(counters.examined == 0);
+
+		// Load boundary.
+		tracker.MarkAllDirty();
+		assert(tracker.SettledCount() == 0);
+		counters = RunPass(owner, tracker, totals);
+		assert(counters.examined == 3 && counters.adjusted == 0);
+	}
+
+	void UnconvergedActorValuesStayExamined()
+	{
+		FakeActorValueOwner owner;
+		owner.SetBase(AV::kSpeedMult, 100.0f);
+
+		Tracker                                 tracker;
+		const std::vector<std::pair<AV, float>> totals{ { AV::kSpeedMult, 0.5f } };
+
+		// The engine leaves an AV unsettled while its delta is still pending (missing streak).
+		const auto observed = owner.Observe(AV::kSpeedMult);
+		assert(tracker.NeedsExamination(AV::kSpeedMult, 0.5f, observed));
+		assert(tracker.NeedsExamination(AV::kSpeedMult, 0.5f, observed));
+
+		(void)RunPass(owner, tracker, totals);
+		assert(!tracker.NeedsExamination(AV::kSpeedMult, 0.5f, owner.Observe(AV::kSpeedMult)));
+	}
+
+	void DriftComparesEveryChannel()
+	{
+		const RewardActorObservation settled{ 100.0f, 120.0f, 110.0f, 10.0f };
+		assert(!HasObservationDrifted(settled, settled));
+		assert(!HasObservationDrifted(settled, { 100.0f, 120.0005f, 110.0f, 10.0f }));
+		assert(HasObservationDrifted(settled, { 101.0f, 120.0f, 110.0f, 10.0f }));
+		assert(HasObservationDrifted(settled, { 100.0f, 121.0f, 110.0f, 10.0f }));
+		assert(HasObservationDrifted(settled, { 100.0f, 120.0f, 111.0f, 10.0f }));
+		assert(HasObservationDrifted(settled, { 100.0f, 120.0f, 110.0f, 9.0f }));
+	}
+}
+
+int main()
+{
+	SteadyStateSkipsUnchangedActorValues();
+	ReexaminesDirtyDriftedOrRetargetedActorValues();
+	UnconvergedActorValuesStayExamined();
+	DriftComparesEveryChannel();
+	return 0;
+}
@@ -0,0 +1,157 @@
+#include "CodexOfPowerNG/SerializationFormIdRemap.h"
+
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace
+{
+	namespace FormIdRemap = CodexOfPowerNG::Serialization::FormIdRemap;
+
+	// Load order changed since the save: plugin 0x01 moved to 0x03, 0x02 is gone, light plugin
+	// 0x005 moved to 0x010 and light 0x006 is gone. Only the plugin part is remapped, like SKSE.
+	struct FakeLoadOrder
+	{
+		int* calls;
+
+		bool operator()(std::uint32_t oldId, std::uint32_t& newId) const
+		{
+			++*calls;
+			if (FormIdRemap::IsLight(oldId)) {
+				const auto light = (oldId >> 12) & 0xFFFu;
+				if (light == 0x006u) {
+					return false;
+				}
+				newId = 0xFE000000u | ((light == 0x005u ? 0x010u : light) << 12) | (oldId & 0xFFFu);
+				return true;
+			}
+			const auto index = oldId >> 24;
+			if (index == 0x02u) {
+				return false;
+			}
+			newId = ((index == 0x01u ? 0x03u : index) << 24) | (oldId & 0x00FFFFFFu);
+			return true;
+		}
+	};
+
+	void SlotsSplitRegularAndLightPlugins()
+	{
+		static_assert(FormIdRemap::SlotOf(0x00012EB7u) == 0);
+		static_assert(FormIdRemap::SlotOf(0x2A000800u) == 0x2A);
+		static_assert(FormIdRemap::SlotOf(0xFE005801u) == FormIdRemap::kRegularSlots + 0x005);
+		static_assert(FormIdRemap::LocalMaskOf(0xFE005801u) == 0xFFFu);
+		static_assert(FormIdRemap::LocalMaskOf(0x01000801u) == 0x00FFFFFFu);
+	}
+
+	void ResolvesOncePerPlugin()
+	{
+		int  calls = 0;
+		auto translation = FormIdRemap::Translation(FakeLoadOrder{ &calls });
+
+		std::uint32_t newId{};
+		assert(translation.ResolveFormID(0x01000801u, newId) && newId == 0x03000801u);
+		assert(translation.ResolveFormID(0x01ABCDEFu, newId) && newId == 0x03ABCDEFu);
+		assert(translation.ResolveFormID(0xFE005ABCu, newId) && newId == 0xFE010ABCu);
+		assert(translation.ResolveFormID(0xFE005001u, newId) && newId == 0xFE010001u);
+		assert(translation.ResolveFormID(0x00012EB7u, newId) && newId == 0x00012EB7u);
+
+		newId = 0x1234u;
+		assert(!translation.ResolveFormID(0x02000800u, newId) && newId == 0x1234u);
+		assert(!translation.ResolveFormID(0x02000801u, newId));
+		assert(!translation.ResolveFormID(0xFE006800u, newId));
+
+		assert(calls == 5);
+		assert(translation.ResolveCalls() == 5);
+		assert(translation.Dropped() == 3);
+	}
+
+	void RemapsInBulkAndDropsMissingPlugins()
+	{
+		int  calls = 0;
+		auto translation = FormIdRemap::Translation(FakeLoadOrder{ &calls });
+
+		std::vector<std::uint32_t> ids{ 0x01000801u, 0x02000802u, 0xFE005803u, 0x00012EB7u, 0xFE006804u, 0x01000805u, 0x02000806u };
+		std::vector<std::uint32_t> groups{ 1, 2, 3, 4, 5, 6, 7 };
+
+		const auto kept = translation.RemapInPlace(std::span(ids), std::span(groups));
+		assert(kept == 4);
+		assert(ids[0] == 0x03000801u && groups[0] == 1);
+		assert(ids[1] == 0xFE010803u && groups[1] == 3);
+		assert(ids[2] == 0x00012EB7u && groups[2] == 4);
+		assert(ids[3] == 0x03000805u && groups[3] == 6);
+		assert(calls == 5);
+		assert(translation.Dropped() == 3);
+
+		// The table carries over to later records of the same load.
+		std::vector<std::uint32_t> blocked{ 0x02000001u, 0x01000002u, 0xFE005003u };
+		assert(translation.RemapInPlace(std::span(blocked)) == 2);
+		assert(blocked[0] == 0x03000002u && blocked[1] == 0xFE010003u);
+		assert(calls == 5);
+		assert(translation.Dropped() == 4);
+
+		std::vector<std::uint32_t> empty;
+		assert(translation.RemapInPlace(std::span(empty)) == 0);
+	}
+
+	// Plugin 0x04 was re-flagged light (now light 0x020) and light 0x007 became regular 0x05.
+	struct ReflaggedLoadOrder
+	{
+		int* calls;
+
+		bool operator()(std::uint32_t oldId, std::uint32_t& newId) const
+		{
+			++*calls;
+			if (FormIdRemap::IsLight(oldId)) {
+				assert(((oldId >> 12) & 0xFFFu) == 0x007u);
+				newId = 0x05000000u | (oldId & 0xFFFu);
+				return true;
+			}
+			assert((oldId >> 24) == 0x04u);
+			newId = 0xFE020000u | (oldId & 0xFFFu);
+			return true;
+		}
+	};
+
+	void RemapsRegularPluginReflaggedLight()
+	{
+		int  calls = 0;
+		auto translation = FormIdRemap::Translation(ReflaggedLoadOrder{ &calls });
+
+		std::uint32_t newId{};
+		assert(translation.ResolveFormID(0x04000ABCu, newId) && newId == 0xFE020ABCu);
+		assert(translation.ResolveFormID(0x04000DEFu, newId) && newId == 0xFE020DEFu);
+
+		std::vector<std::uint32_t> ids{ 0x04000801u, 0x04000FFFu };
+		assert(translation.RemapInPlace(std::span(ids)) == 2);
+		assert(ids[0] == 0xFE020801u && ids[1] == 0xFE020FFFu);
+		assert(calls == 1);
+	}
+
+	void RemapsLightPluginReflaggedRegular()
+	{
+		int  calls = 0;
+		auto translation = FormIdRemap::Translation(ReflaggedLoadOrder{ &calls });
+
+		std::uint32_t newId{};
+		assert(translation.ResolveFormID(0xFE007123u, newId) && newId == 0x05000123u);
+		assert(translation.ResolveFormID(0xFE007FFFu, newId) && newId == 0x05000FFFu);
+
+		std::vector<std::uint32_t> ids{ 0xFE007800u, 0xFE007001u };
+		std::vector<std::uint32_t> groups{ 1, 2 };
+		assert(translation.RemapInPlace(std::span(ids), std::span(groups)) == 2);
+		assert(ids[0] == 0x05000800u && groups[0] == 1);
+		assert(ids[1] == 0x05000001u && groups[1] == 2);
+		assert(calls == 1);
+	}
+}
+
+int main()
+{
+	SlotsSplitRegularAndLightPlugins();
+	ResolvesOncePerPlugin();
+	RemapsInBulkAndDropsMissingPlugins();
+	RemapsRegularPluginReflaggedLight();
+	RemapsLightPluginReflaggedRegular();
+	return 0;
+}
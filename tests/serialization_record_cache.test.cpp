@@ -0,0 +1,91 @@
+#include "CodexOfPowerNG/SerializationRecordCache.h"
+
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+namespace
+{
+	namespace Serialization = CodexOfPowerNG::Serialization;
+	using Serialization::SaveRecord;
+
+	void GenerationsMoveIndependently()
+	{
+		Serialization::SaveRecordGenerations generations;
+		assert(generations.Of(SaveRecord::kRegistered) == 0);
+
+		generations.Bump(SaveRecord::kRegistered);
+		generations.Bump(SaveRecord::kRegistered);
+		assert(generations.Of(SaveRecord::kRegistered) == 2);
+		assert(generations.Of(SaveRecord::kBlocked) == 0);
+
+		generations.BumpAll();
+		assert(generations.Of(SaveRecord::kRegistered) == 3);
+		assert(generations.Of(SaveRecord::kUndo) == 1);
+	}
+
+	void ReusesBytesUntilGenerationMoves()
+	{
+		Serialization::EncodedRecordCache cache;
+		Serialization::SaveStats          stats{};
+		int                               encodes = 0;
+		std::uint32_t                     value = 7;
+		const auto encode = [&](auto& buffer) {
+			++encodes;
+			buffer.Put(value);
+		};
+
+		const auto& first = cache.Get(SaveRecord::kBuildScores, 0, encode, stats);
+		assert(encodes == 1 && first.size() == sizeof(value));
+
+		value = 9;  // same generation: the stale bytes are what the caller asked for
+		const auto& second = cache.Get(SaveRecord::kBuildScores, 0, encode, stats);
+		assert(encodes == 1 && &second == &first);
+
+		(void)cache.Get(SaveRecord::kBuildScores, 1, encode, stats);
+		assert(encodes == 2);
+		(void)cache.Get(SaveRecord::kRewards, 1, encode, stats);
+		assert(encodes == 3);
+
+		assert(stats.encodedRecords == 3 && stats.reusedRecords == 1);
+		assert(stats.encodedBytes == 3 * sizeof(value) && stats.reusedBytes == sizeof(value));
+
+		cache.Invalidate();
+		(void)cache.Get(SaveRecord::kBuildScores, 1, encode, stats);
+		assert(encodes == 4);
+	}
+
+	void FailedEncodeIsNotCached()
+	{
+		Serialization::EncodedRecordCache cache;
+		Serialization::SaveStats          stats{};
+		int                               encodes = 0;
+
+		bool threw = false;
+		try {
+			(void)cache.Get(SaveRecord::kUndo, 4, [&](auto& buffer) {
+				++encodes;
+				buffer.Put(std::uint32_t{ 1 });
+				throw std::bad_alloc();
+			}, stats);
+		} catch (const std::bad_alloc&) {
+			threw = true;
+		}
+		assert(threw);
+
+		const auto& bytes = cache.Get(SaveRecord::kUndo, 4, [&](auto& buffer) {
+			++encodes;
+			buffer.Put(std::uint64_t{ 2 });
+		}, stats);
+		assert(encodes == 2 && bytes.size() == sizeof(std::uint64_t));
+		assert(stats.encodedRecords == 1 && stats.reusedRecords == 0);
+	}
+}
+
+int main()
+{
+	GenerationsMoveIndependently();
+	ReusesBytesUntilGenerationMoves();
+	FailedEncodeIsNotCached();
+	return 0;
+}
@@ -0,0 +1,295 @@
+#include "CodexOfPowerNG/FlatFormIdMap.h"
+#include "CodexOfPowerNG/SerializationRecordCodec.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	namespace Codec = CodexOfPowerNG::Serialization::RecordCodec;
+	using CodexOfPowerNG::Containers::FlatFormIdMap;
+	using CodexOfPowerNG::Containers::FlatFormIdSet;
+
+	[[nodiscard]] std::span<const std::byte> BytesOf(const Codec::ByteWriter& writer)
+	{
+		return { writer.data(), writer.size() };
+	}
+
+	void RegisteredRoundTripsAsColumns()
+	{
+		FlatFormIdMap<std::uint32_t> registered;
+		registered.emplace(0x00012EB7u, 0u);
+		registered.emplace(0x01000801u, 5u);
+		registered.emplace(0xFE001234u, 255u);
+		registered.emplace(0x02000002u, 4096u);  // wider than a packed group
+
+		Codec::ByteWriter writer;
+		Codec::EncodeRegisteredColumns(writer, registered);
+		assert(writer.size() == sizeof(std::uint32_t) + registered.size() * 5);
+
+		FlatFormIdMap<std::uint32_t> decoded;
+		const auto result = Codec::DecodeRegistered(BytesOf(writer), 3u, 255u, [&](std::uint32_t formId, std::uint32_t group) {
+			decoded.emplace(formId, group);
+		});
+		assert(result.status == Codec::DecodeStatus::kOk);
+		assert(result.declared == 4 && result.decoded == 4);
+		assert(decoded.size() == 4);
+		assert(decoded.find(0x00012EB7u)->second == 0u);
+		assert(decoded.find(0x01000801u)->second == 5u);
+		assert(decoded.find(0xFE001234u)->second == 255u);
+		assert(decoded.find(0x02000002u)->second == Codec::kPackedGroupUnknown);
+
+		// Clear keeps the buffer for the next record.
+		writer.Clear();
+		Codec::EncodeRegisteredColumns(writer, FlatFormIdMap<std::uint32_t>{});
+		assert(writer.size() == sizeof(std::uint32_t));
+	}
+
+	void ReadsLegacyRegisteredLayouts()
+	{
+		Codec::ByteWriter v1;
+		v1.Put(std::uint32_t{ 2 });
+		v1.Put(std::uint32_t{ 0x10u });
+		v1.Put(std::uint32_t{ 0x20u });
+
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> entries;
+		const auto sink = [&](std::uint32_t formId, std::uint32_t group) { entries.emplace_back(formId, group); };
+		auto result = Codec::DecodeRegistered(BytesOf(v1), 1u, 255u, sink);
+		assert(result.status == Codec::DecodeStatus::kOk && result.decoded == 2);
+		assert((entries == std::vector<std::pair<std::uint32_t, std::uint32_t>>{ { 0x10u, 255u }, { 0x20u, 255u } }));
+
+		Codec::ByteWriter v2;
+		v2.Put(std::uint32_t{ 3 });  // claims one more entry than it holds
+		v2.Put(std::uint32_t{ 0x30u });
+		v2.Put(std::uint32_t{ 2u });
+		v2.Put(std::uint32_t{ 0x40u });
+		v2.Put(std::uint32_t{ 1u });
+		entries.clear();
+		result = Codec::DecodeRegistered(BytesOf(v2), 2u, 255u, sink);
+		assert(result.status == Codec::DecodeStatus::kOk);
+		assert(result.declared == 3 && result.decoded == 2);
+		assert((entries == std::vector<std::pair<std::uint32_t, std::uint32_t>>{ { 0x30u, 2u }, { 0x40u, 1u } }));
+
+		result = Codec::DecodeRegistered(BytesOf(v2), 9u, 255u, sink);
+		assert(result.status == Codec::DecodeStatus::kUnsupportedVersion);
+	}
+
+	void RejectsShortRecords()
+	{
+		int calls = 0;
+		const auto count = [&](std::uint32_t, std::uint32_t) { ++calls; };
+
+		Codec::ByteWriter empty;
+		assert(Codec::DecodeRegistered(BytesOf(empty), 3u, 255u, count).status == Codec::DecodeStatus::kTruncatedHeader);
+		assert(Codec::DecodeFormIds(BytesOf(empty), 2u, [&](std::uint32_t) { ++calls; }).status == Codec::DecodeStatus::kTruncatedHeader);
+		assert(Codec::DecodeFormIds(BytesOf(empty), 3u, [&](std::uint32_t) { ++calls; }).status == Codec::DecodeStatus::kTruncatedHeader);
+
+		// A cut-off v3 record has no group column to pair ids with.
+		FlatFormIdMap<std::uint32_t> registered{ { 0x10u, 1u }, { 0x20u, 2u } };
+		Codec::ByteWriter            writer;
+		Codec::EncodeRegisteredColumns(writer, registered);
+		const auto result = Codec::DecodeRegistered(BytesOf(writer).first(writer.size() - 1), 3u, 255u, count);
+		assert(result.status == Codec::DecodeStatus::kOk && result.declared == 2 && result.decoded == 0);
+		assert(calls == 0);
+	}
+
+	void RawFormIdListsRoundTrip()
+	{
+		FlatFormIdSet blocked{ 0x1u, 0x0100ABCDu, 0xFF000010u };
+
+		Codec::ByteWriter writer;
+		Codec::EncodeFormIdsRaw(writer, blocked);
+		assert(writer.size() == sizeof(std::uint32_t) * 4);
+
+		FlatFormIdSet decoded;
+		auto result = Codec::DecodeFormIds(BytesOf(writer), 2u, [&](std::uint32_t formId) { decoded.insert(formId); });
+		assert(result.status == Codec::DecodeStatus::kOk && result.decoded == 3);
+		assert(decoded.size() == 3 && decoded.contains(0x1u) && decoded.contains(0x0100ABCDu) && decoded.contains(0xFF000010u));
+
+		decoded.clear();
+		result = Codec::DecodeFormIds(BytesOf(writer).first(writer.size() - 2), 2u, [&](std::uint32_t formId) { decoded.insert(formId); });
+		assert(result.declared == 3 && result.decoded == 2 && decoded.size() == 2);
+
+		assert(Codec::CountHint(BytesOf(writer)) == 3);
+		assert(Codec::CountHint(BytesOf(writer).first(6)) == 2);
+		assert(Codec::CountHint({}) == 0);
+
+		assert(Codec::DecodeFormIds(BytesOf(writer), 7u, [](std::uint32_t) {}).status == Codec::DecodeStatus::kUnsupportedVersion);
+	}
+
+	void VarintsRoundTrip()
+	{
+		constexpr std::uint32_t kValues[]{ 0u, 1u, 0x7Fu, 0x80u, 0x3FFFu, 0x4000u, 0x0FFFFFFFu, 0xFFFFFFFFu };
+		Codec::ByteWriter writer;
+		for (const auto value : kValues) {
+			writer.PutVarint(value);
+		}
+		assert(writer.size() == 1 + 1 + 1 + 2 + 2 + 3 + 4 + 5);
+
+		Codec::ByteReader reader(BytesOf(writer));
+		for (const auto value : kValues) {
+			std::uint32_t decoded{};
+			assert(reader.GetVarint(decoded) && decoded == value);
+		}
+		std::uint32_t extra{};
+		assert(!reader.GetVarint(extra));
+
+		// Continuation bit on the last byte, and a fifth byte carrying more than 32 bits.
+		const std::byte cut[]{ std::byte{ 0x80 } };
+		Codec::ByteReader cutReader(cut);
+		assert(!cutReader.GetVarint(extra));
+		const std::byte wide[]{ std::byte{ 0xFF }, std::byte{ 0xFF }, std::byte{ 0xFF }, std::byte{ 0xFF }, std::byte{ 0x1F } };
+		Codec::ByteReader wideReader(wide);
+		assert(!wideReader.GetVarint(extra));
+	}
+
+	void CompactRegisteredSortsAndPartitions()
+	{
+		FlatFormIdMap<std::uint32_t> registered;
+		registered.emplace(0x00012EB7u, 0u);
+		registered.emplace(0x00012EB8u, 5u);
+		registered.emplace(0x00000001u, 2u);
+		registered.emplace(0x02FFFFFFu, 3u);          // last local id of a full plugin
+		registered.emplace(0xFE001800u, 255u);        // light plugin 0x001
+		registered.emplace(0xFE001FFFu, 1u);
+		registered.emplace(0xFE123000u, 4096u);       // light plugin 0x123, wider than a group
+		registered.emplace(0xFF000010u, 6u);
+
+		Codec::ByteWriter writer;
+		Codec::EncodeRegistered(writer, registered);
+		Codec::ByteWriter columns;
+		Codec::EncodeRegisteredColumns(columns, registered);
+		assert(writer.size() < columns.size());
+
+		std::vector<std::pair<std::uint32_t, std::uint32_t>> entries;
+		const auto result = Codec::DecodeRegistered(BytesOf(writer), Codec::kRegisteredRecordVersion, 255u, [&](std::uint32_t formId, std::uint32_t group) {
+			entries.emplace_back(formId, group);
+		});
+		assert(result.status == Codec::DecodeStatus::kOk);
+		assert(result.declared == 8 && result.decoded == 8);
+		assert((entries == std::vector<std::pair<std::uint32_t, std::uint32_t>>{
+					{ 0x00000001u, 2u },
+					{ 0x00012EB7u, 0u },
+					{ 0x00012EB8u, 5u },
+					{ 0x02FFFFFFu, 3u },
+					{ 0xFE001800u, 255u },
+					{ 0xFE001FFFu, 1u },
+					{ 0xFE123000u, 255u },
+					{ 0xFF000010u, 6u },
+				}));
+
+		// Every cut-off prefix decodes a prefix of the entries and never more.
+		for (std::size_t size = 0; size < writer.size(); ++size) {
+			std::size_t seen = 0;
+			const auto partial = Codec::DecodeRegistered(BytesOf(writer).first(size), 4u, 255u, [&](std::uint32_t formId, std::uint32_t) {
+				assert(formId == entries[seen].first);
+				++seen;
+			});
+			assert(partial.status != Codec::DecodeStatus::kMalformed);
+			assert(partial.decoded == seen && seen < entries.size());
+		}
+	}
+
+	void CompactFormIdListsRoundTrip()
+	{
+		FlatFormIdSet notified;
+		for (std::uint32_t i = 0; i < 1000; ++i) {
+			notified.insert(0x01000000u + i * 3);
+			notified.insert(0xFE00A000u + i);
+		}
+
+		Codec::ByteWriter writer;
+		Codec::EncodeFormIds(writer, notified);
+		Codec::ByteWriter raw;
+		Codec::EncodeFormIdsRaw(raw, notified);
+		assert(writer.size() * 3 < raw.size());
+
+		FlatFormIdSet decoded;
+		std::uint32_t previous = 0;
+		const auto result = Codec::DecodeFormIds(BytesOf(writer), Codec::kFormIdListRecordVersion, [&](std::uint32_t formId) {
+			assert(decoded.empty() || formId > previous);
+			previous = formId;
+			decoded.insert(formId);
+		});
+		assert(result.status == Codec::DecodeStatus::kOk && result.decoded == 2000);
+		assert(decoded.size() == notified.size());
+		for (const auto formId : notified) {
+			assert(decoded.contains(formId));
+		}
+
+		writer.Clear();
+		Codec::EncodeFormIds(writer, FlatFormIdSet{});
+		assert(Codec::DecodeFormIds(BytesOf(writer), 3u, [](std::uint32_t) {}).status == Codec::DecodeStatus::kOk);
+	}
+
+	void CompactRejectsMalformedEntries()
+	{
+		const auto decode = [](const Codec::ByteWriter& writer) {
+			return Codec::DecodeFormIds(BytesOf(writer), 3u, [](std::uint32_t) {});
+		};
+
+		Codec::ByteWriter duplicate;
+		duplicate.Put(std::uint32_t{ 2 });
+		duplicate.PutVarint(1);       // partitions
+		duplicate.PutVarint(0x01u);   // plugin 0x01
+		duplicate.PutVarint(2);
+		duplicate.PutVarint(0x10u);
+		duplicate.PutVarint(0);       // same id again
+		auto result = decode(duplicate);
+		assert(result.status == Codec::DecodeStatus::kMalformed && result.decoded == 1);
+
+		Codec::ByteWriter overflow;
+		overflow.Put(std::uint32_t{ 1 });
+		overflow.PutVarint(1);
+		overflow.PutVarint(0xFE001u);  // light plugin: 12 local bits
+		overflow.PutVarint(1);
+		overflow.PutVarint(0x1000u);
+		assert(decode(overflow).status == Codec::DecodeStatus::kMalformed);
+
+		Codec::ByteWriter bareLightByte;
+		bareLightByte.Put(std::uint32_t{ 1 });
+		bareLightByte.PutVarint(1);
+		bareLightByte.PutVarint(0xFEu);
+		bareLightByte.PutVarint(1);
+		bareLightByte.PutVarint(1);
+		assert(decode(bareLightByte).status == Codec::DecodeStatus::kMalformed);
+
+		Codec::ByteWriter unordered;
+		unordered.Put(std::uint32_t{ 2 });
+		unordered.PutVarint(2);
+		unordered.PutVarint(0x02u);
+		unordered.PutVarint(1);
+		unordered.PutVarint(1);
+		unordered.PutVarint(0x01u);
+		unordered.PutVarint(1);
+		unordered.PutVarint(1);
+		assert(decode(unordered).status == Codec::DecodeStatus::kMalformed);
+
+		Codec::ByteWriter overcount;
+		overcount.Put(std::uint32_t{ 1 });
+		overcount.PutVarint(1);
+		overcount.PutVarint(0x01u);
+		overcount.PutVarint(2);
+		overcount.PutVarint(1);
+		overcount.PutVarint(1);
+		result = decode(overcount);
+		assert(result.status == Codec::DecodeStatus::kMalformed && result.decoded == 1);
+	}
+}
+
+int main()
+{
+	RegisteredRoundTripsAsColumns();
+	ReadsLegacyRegisteredLayouts();
+	RejectsShortRecords();
+	RawFormIdListsRoundTrip();
+	VarintsRoundTrip();
+	CompactRegisteredSortsAndPartitions();
+	CompactFormIdListsRoundTrip();
+	CompactRejectsMalformedEntries();
+	return 0;
+}
@@ -1,4 +1,5 @@
 #include "CodexOfPowerNG/BuildTypes.h"
+#include "CodexOfPowerNG/FlatFormIdMap.h"
 #include "CodexOfPowerNG/SerializationStateStoreOps.h"
 
 #include <cassert>
@@ -7,15 +8,14 @@
 #include <deque>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 
 namespace
 {
 	struct FakeSnapshot
 	{
-		std::unordered_map<std::uint32_t, std::uint32_t> registeredItems;
-		std::unordered_set<std::uint32_t>                blockedItems;
-		std::unordered_set<std::uint32_t>                notifiedItems;
+		CodexOfPowerNG::Containers::FlatFormIdMap<std::uint32_t> registeredItems;
+		CodexOfPowerNG::Containers::FlatFormIdSet                blockedItems;
+		CodexOfPowerNG::Containers::FlatFormIdSet                notifiedItems;
 		std::unordered_map<int, float>                   rewardTotals;
 		std::unordered_map<int, float>                   buildAppliedEffectTotals;
 		std::uint32_t                                    attackScore{ 0 };
@@ -34,9 +34,9 @@ namespace
 
 	struct FakeState
 	{
-		std::unordered_map<std::uint32_t, std::uint32_t> registeredItems;
-		std::unordered_set<std::uint32_t>                blockedItems;
-		std::unordered_set<std::uint32_t>                notifiedItems;
+		CodexOfPowerNG::Containers::FlatFormIdMap<std::uint32_t> registeredItems;
+		CodexOfPowerNG::Containers::FlatFormIdSet                blockedItems;
+		CodexOfPowerNG::Containers::FlatFormIdSet                notifiedItems;
 		std::unordered_map<int, float>                   rewardTotals;
 		std::unordered_map<int, float>                   buildAppliedEffectTotals;
 		std::uint32_t                                    attackScore{ 0 };
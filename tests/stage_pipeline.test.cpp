@@ -0,0 +1,137 @@
+#include "CodexOfPowerNG/StagePipeline.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using namespace CodexOfPowerNG;
+	using namespace std::chrono_literals;
+
+	struct FakeClock
+	{
+		using duration = std::chrono::microseconds;
+		using rep = duration::rep;
+		using period = duration::period;
+		using time_point = std::chrono::time_point<FakeClock>;
+		static constexpr bool is_steady = true;
+
+		static inline std::int64_t nowUs = 0;
+
+		static time_point now() noexcept { return time_point(duration(nowUs)); }
+		static void Spend(std::int64_t us) noexcept { nowUs += us; }
+	};
+
+	using Pipeline = StagePipeline<FakeClock>;
+
+	[[nodiscard]] StageFn Step(std::vector<std::string>& log, std::string name, std::int64_t costUs)
+	{
+		return [&log, name, costUs](std::chrono::microseconds) {
+			FakeClock::Spend(costUs);
+			log.push_back(name);
+			return StageStatus::kDone;
+		};
+	}
+
+	void RunsStagesAfterTheirDependencies()
+	{
+		std::vector<std::string> log;
+		Pipeline                 pipeline;
+		assert(pipeline.Add("effects", { "migration" }, Step(log, "effects", 10)));
+		assert(pipeline.Add("notice", {}, Step(log, "notice", 10)));
+		assert(pipeline.Add("migration", { "gate" }, Step(log, "migration", 10)));
+		assert(pipeline.Add("gate", {}, Step(log, "gate", 10)));
+		assert(!pipeline.Add("gate", {}, Step(log, "gate", 10)));
+		assert(pipeline.Seal());
+		assert(!pipeline.Add("late", {}, Step(log, "late", 10)));
+
+		assert(pipeline.CurrentStage() == "notice");
+		assert(pipeline.Run(1000us) == PipelineStep::kFinished);
+		assert(pipeline.Finished());
+		assert(pipeline.CurrentStage().empty());
+		assert((log == std::vector<std::string>{ "notice", "gate", "migration", "effects" }));
+	}
+
+	void RejectsUnknownDependenciesAndCycles()
+	{
+		std::vector<std::string> log;
+
+		Pipeline unknown;
+		assert(unknown.Add("a", { "missing" }, Step(log, "a", 0)));
+		assert(!unknown.Seal());
+		assert(unknown.Run(1000us) == PipelineStep::kFinished);
+
+		Pipeline cycle;
+		assert(cycle.Add("a", { "b" }, Step(log, "a", 0)));
+		assert(cycle.Add("b", { "a" }, Step(log, "b", 0)));
+		assert(!cycle.Seal());
+		assert(cycle.Run(1000us) == PipelineStep::kFinished);
+		assert(!cycle.Finished());
+		assert(log.empty());
+	}
+
+	void WaitsAndYieldsWithinTheBudget()
+	{
+		FakeClock::nowUs = 0;
+		std::vector<std::string> log;
+		bool                     ready = false;
+		int                      chunksLeft = 3;
+
+		Pipeline pipeline;
+		assert(pipeline.Add("gate", {}, [&](std::chrono::microseconds) {
+			FakeClock::Spend(5);
+			return ready ? StageStatus::kDone : StageStatus::kWait;
+		}));
+		assert(pipeline.Add("chunks", { "gate" }, [&](std::chrono::microseconds budget) {
+			assert(budget > 0us);
+			FakeClock::Spend(600);
+			return --chunksLeft > 0 ? StageStatus::kYield : StageStatus::kDone;
+		}));
+		assert(pipeline.Add("tail", { "chunks" }, Step(log, "tail", 10)));
+		assert(pipeline.Seal());
+
+		assert(pipeline.Run(1000us) == PipelineStep::kWait);
+		assert(pipeline.CurrentStage() == "gate");
+		assert(pipeline.Run(1000us) == PipelineStep::kWait);
+
+		ready = true;
+		FakeClock::Spend(100);
+		// gate (5us) + two chunks (1200us) exhaust the budget before the third chunk.
+		assert(pipeline.Run(1000us) == PipelineStep::kYield);
+		assert(pipeline.CurrentStage() == "chunks");
+		assert(pipeline.Run(1000us) == PipelineStep::kFinished);
+		assert((log == std::vector<std::string>{ "tail" }));
+
+		const auto timings = pipeline.Timings();
+		assert(timings.size() == 3);
+		assert(timings[0].name == "gate" && timings[0].slices == 3 && timings[0].runUs == 15 && timings[0].done);
+		assert(timings[0].finishedAtUs == 115);
+		assert(timings[1].slices == 3 && timings[1].runUs == 1800);
+		assert(timings[2].done && timings[2].finishedAtUs == 1925);
+	}
+
+	void AlwaysRunsOneSliceOnAnEmptyBudget()
+	{
+		std::vector<std::string> log;
+		Pipeline                 pipeline;
+		assert(pipeline.Add("a", {}, Step(log, "a", 10)));
+		assert(pipeline.Add("b", {}, Step(log, "b", 10)));
+		assert(pipeline.Seal());
+
+		assert(pipeline.Run(0us) == PipelineStep::kYield);
+		assert(pipeline.Run(0us) == PipelineStep::kFinished);
+		assert((log == std::vector<std::string>{ "a", "b" }));
+	}
+}
+
+int main()
+{
+	RunsStagesAfterTheirDependencies();
+	RejectsUnknownDependenciesAndCycles();
+	WaitsAndYieldsWithinTheBudget();
+	AlwaysRunsOneSliceOnAnEmptyBudget();
+	return 0;
+}
@@ -0,0 +1,115 @@
+#include "CodexOfPowerNG/StartupPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	namespace Startup = CodexOfPowerNG::Startup;
+
+	void RunsStagesAndRecordsTimings()
+	{
+		Startup::WorkerPool pool(3);
+		assert(pool.ThreadCount() == 3);
+
+		auto settings = pool.Submit("settings", []() { return 42; });
+		// A stage may wait on one submitted before it.
+		auto lang = pool.Submit("lang", [settings]() { return settings.get() + 1; });
+		auto maps = pool.Submit("maps", []() { return std::string("maps"); });
+
+		assert(lang.get() == 43);
+		assert(maps.get() == "maps");
+
+		pool.Join();
+		auto timings = pool.Timings();
+		assert(timings.size() == 3);
+		std::vector<std::string> names;
+		for (const auto& stage : timings) {
+			names.push_back(stage.name);
+			assert(stage.waited.count() >= 0 && stage.ran.count() >= 0);
+		}
+		std::sort(names.begin(), names.end());
+		assert((names == std::vector<std::string>{ "lang", "maps", "settings" }));
+
+		// After Join() stages run inline on the caller.
+		const auto caller = std::this_thread::get_id();
+		auto late = pool.Submit("late", [caller]() { return std::this_thread::get_id() == caller; });
+		assert(late.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+		assert(late.get());
+	}
+
+	void DestructorDrainsQueue()
+	{
+		std::atomic_int ran{ 0 };
+		{
+			Startup::WorkerPool pool(1);
+			for (int i = 0; i < 16; ++i) {
+				(void)pool.Submit("stage", [&ran]() { ran.fetch_add(1); });
+			}
+		}
+		assert(ran.load() == 16);
+	}
+
+	void PropagatesStageExceptions()
+	{
+		Startup::WorkerPool pool(1);
+		auto failing = pool.Submit("broken", []() -> int { throw std::runtime_error("bad file"); });
+		bool threw = false;
+		try {
+			(void)failing.get();
+		} catch (const std::runtime_error&) {
+			threw = true;
+		}
+		assert(threw);
+
+		auto next = pool.Submit("next", []() { return 7; });
+		assert(next.get() == 7);
+	}
+
+	void GateBlocksUntilStageFinishes()
+	{
+		Startup::LoadGate unarmed;
+		assert(unarmed.IsReady());
+		unarmed.Wait();
+
+		std::promise<void> release;
+		auto released = release.get_future().share();
+
+		Startup::WorkerPool pool(1);
+		std::atomic_bool loaded{ false };
+		Startup::LoadGate gate;
+		gate.Arm(pool.Submit("settings", [released, &loaded]() {
+			released.wait();
+			loaded.store(true);
+		}));
+		assert(!gate.IsReady());
+
+		std::atomic_bool sawLoaded{ false };
+		std::thread consumer([&]() {
+			gate.Wait();
+			sawLoaded.store(loaded.load());
+		});
+		release.set_value();
+		consumer.join();
+		assert(sawLoaded.load());
+		assert(gate.IsReady());
+		gate.Wait();
+	}
+}
+
+int main()
+{
+	RunsStagesAndRecordsTimings();
+	DestructorDrainsQueue();
+	PropagatesStageExceptions();
+	GateBlocksUntilStageFinishes();
+	assert(Startup::WorkerPool::DefaultThreadCount() >= 1 && Startup::WorkerPool::DefaultThreadCount() <= 3);
+	return 0;
+}
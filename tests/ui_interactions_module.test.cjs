@@ -219,3 +219,55 @@ test("build swap requests use distinct source and destination slots", () => {
     },
   ]);
 });
+
+test("register, undo and build requests wait for post-load readiness", () => {
+  const calls = [];
+  const toasts = [];
+  let state = { postLoad: { ready: false, generation: 3 } };
+  const undoBody = { nodeType: 1 };
+  const buildPanelEl = { nodeType: 1 };
+
+  function makeNode(attrs, parentNode, tagName) {
+    return {
+      nodeType: 1,
+      tagName,
+      parentNode,
+      getAttribute(name) {
+        return Object.prototype.hasOwnProperty.call(attrs, name) ? attrs[name] : null;
+      },
+    };
+  }
+
+  const api = mod.createUIInteractions({
+    undoBody,
+    buildPanelEl,
+    stateApi: {
+      getState: () => state,
+      showToast: (level, message) => toasts.push({ level, message }),
+      getQuickBatchSelectedIds: () => [46775],
+      setBuildSelection: () => {},
+    },
+    safeCall: (name, payload) => calls.push({ name, payload }),
+  });
+
+  const undo = () => api.onUndoBodyClick({ target: makeNode({ "data-action": "undo", "data-id": "7" }, undoBody, "BUTTON") });
+  const deactivate = () =>
+    api.onBuildPanelClick({ target: makeNode({ "data-action": "build-deactivate", "data-slot-id": "attack_1" }, buildPanelEl) });
+
+  api.onBatchRegisterClick();
+  undo();
+  deactivate();
+  assert.deepEqual(calls, []);
+  assert.equal(toasts.length, 3);
+  assert.equal(toasts[0].level, "warn");
+
+  state = { postLoad: { ready: true, generation: 3 } };
+  api.onBatchRegisterClick();
+  undo();
+  deactivate();
+  assert.deepEqual(
+    calls.map((call) => call.name),
+    ["copng_requestRegisterBatch", "copng_undoRegisterItem", "copng_deactivateBuildOption"],
+  );
+  assert.equal(toasts.length, 3);
+});
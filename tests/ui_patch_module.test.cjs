@@ -0,0 +1,174 @@
+const test = require("node:test");
+const assert = require("node:assert/strict");
+const fs = require("node:fs");
+const path = require("node:path");
+
+const viewDir = path.join(__dirname, "..", "PrismaUI", "views", "codexofpowerng");
+const html = fs.readFileSync(path.join(viewDir, "index.html"), "utf8");
+const uiPatch = require(path.join(viewDir, "ui_patch.js"));
+const interopBridge = require(path.join(viewDir, "interop_bridge.js"));
+const nativeBridgeBootstrap = require(path.join(viewDir, "native_bridge_bootstrap.js"));
+
+test("view loads ui patch module before the interop bridge", () => {
+  assert.match(html, /<script src="ui_patch\.js"><\/script>\s*<script src="interop_bridge\.js"><\/script>/);
+  assert.match(html, /requestPatchResync: \(\) => safeCall\("copng_requestPatchResync", \{\}\)/);
+  assert.match(html, /window\.copng_applyPatch = /, "inline fallback should handle copng_applyPatch");
+});
+
+test("applyPatch sets, unsets and recurses without mutating the input", () => {
+  const before = { a: 1, b: { c: 2, d: 3 }, e: "x" };
+  const after = uiPatch.applyPatch(before, { set: { a: 5, f: true }, unset: ["e"], patch: { b: { set: { d: 4 } } } });
+
+  assert.deepEqual(after, { a: 5, b: { c: 2, d: 4 }, f: true });
+  assert.deepEqual(before, { a: 1, b: { c: 2, d: 3 }, e: "x" });
+});
+
+test("applyPatch splices keyed rows", () => {
+  const rows = [
+    { formId: 1, n: "a" },
+    { formId: 2, n: "b" },
+    { formId: 3, n: "c" },
+  ];
+  const after = uiPatch.applyPatch(rows, {
+    key: "formId",
+    rows: [
+      { op: "remove", index: 1, key: 2 },
+      { op: "insert", index: 2, row: { formId: 4, n: "d" } },
+      { op: "patch", index: 1, patch: { set: { n: "c2" } } },
+    ],
+  });
+
+  assert.deepEqual(after, [
+    { formId: 1, n: "a" },
+    { formId: 3, n: "c2" },
+    { formId: 4, n: "d" },
+  ]);
+  assert.equal(after[0], rows[0], "untouched rows are shared");
+});
+
+test("applyPatch reports mismatched baselines", () => {
+  const rows = [{ formId: 1 }];
+  assert.equal(uiPatch.applyPatch(rows, { key: "formId", rows: [{ op: "remove", index: 0, key: 9 }] }), undefined);
+  assert.equal(uiPatch.applyPatch(rows, { key: "formId", rows: [{ op: "insert", index: 5, row: {} }] }), undefined);
+  assert.equal(uiPatch.applyPatch({ a: 1 }, { rows: [] }), undefined);
+  assert.equal(uiPatch.applyPatch([], { set: { a: 1 } }), undefined);
+  assert.equal(uiPatch.applyPatch(undefined, { set: { a: 1 } }), undefined);
+});
+
+test("patch receiver follows generations and resyncs when they diverge", () => {
+  const seen = [];
+  let resyncs = 0;
+  const receiver = uiPatch.createPatchReceiver({
+    channels: {
+      state: (v) => seen.push(["state", v]),
+      undo: (v) => seen.push(["undo", v]),
+    },
+    requestResync: () => {
+      resyncs += 1;
+    },
+  });
+
+  receiver.noteSnapshot("state", { count: 1 });
+  receiver.noteSnapshot("registered", { ignored: true });
+  assert.equal(receiver.receive({ base: 0, generation: 1, reset: true, channels: { state: { patch: { set: { count: 2 } } } } }), true);
+  assert.deepEqual(seen, [["state", { count: 2 }]]);
+  assert.equal(receiver.getGeneration(), 1);
+
+  // A patch diffed against another generation is dropped.
+  assert.equal(receiver.receive({ base: 7, generation: 8, channels: { state: { patch: { set: { count: 3 } } } } }), false);
+  assert.equal(resyncs, 1);
+
+  // A channel without a baseline cannot be patched; nothing is dispatched.
+  seen.length = 0;
+  assert.equal(
+    receiver.receive({
+      base: 1,
+      generation: 2,
+      channels: { state: { patch: { set: { count: 3 } } }, undo: { patch: { key: "actionId", rows: [] } } },
+    }),
+    false,
+  );
+  assert.deepEqual(seen, []);
+  assert.equal(resyncs, 2);
+  assert.equal(receiver.getGeneration(), 1);
+
+  // A reset re-seeds with full documents in channel order.
+  assert.equal(
+    receiver.receive({ base: 0, generation: 1, reset: true, channels: { undo: { full: [] }, state: { full: { count: 9 } } } }),
+    true,
+  );
+  assert.deepEqual(seen, [
+    ["state", { count: 9 }],
+    ["undo", []],
+  ]);
+});
+
+test("interop bridge applies patches on top of full snapshots", () => {
+  const win = {};
+  const received = { inventory: null, rewards: null };
+  let resyncs = 0;
+  const detach = interopBridge.installNativeCallbacks({
+    windowObj: win,
+    uiPatchApi: uiPatch,
+    onInventory: (v) => {
+      received.inventory = v;
+    },
+    onRewards: (v) => {
+      received.rewards = v;
+    },
+    requestPatchResync: () => {
+      resyncs += 1;
+    },
+  });
+
+  win.copng_setInventory('{"page":0,"pageSize":2,"total":1,"hasMore":false,"items":[{"formId":1,"count":1}]}');
+  win.copng_setRewards('{"registeredCount":4,"totals":[]}');
+  win.copng_applyPatch(
+    JSON.stringify({
+      base: 0,
+      generation: 1,
+      reset: true,
+      channels: {
+        inventory: {
+          patch: {
+            set: { total: 2 },
+            patch: { items: { key: "formId", rows: [{ op: "insert", index: 1, row: { formId: 2, count: 3 } }] } },
+          },
+        },
+        rewards: { patch: { set: { registeredCount: 5 } } },
+      },
+    }),
+  );
+
+  assert.equal(resyncs, 0);
+  assert.equal(received.inventory.total, 2);
+  assert.deepEqual(received.inventory.items.map((row) => row.formId), [1, 2]);
+  assert.equal(received.rewards.registeredCount, 5);
+
+  win.copng_applyPatch('{"base":5,"generation":6,"channels":{}}');
+  assert.equal(resyncs, 1);
+
+  detach();
+  assert.equal(win.copng_applyPatch, undefined);
+});
+
+test("native bridge bootstrap fallback also applies patches", () => {
+  const win = {};
+  let undo = null;
+  const detach = nativeBridgeBootstrap.installFallbackNativeCallbacks({
+    windowObj: win,
+    uiPatchApi: uiPatch,
+    onUndoList: (v) => {
+      undo = v;
+    },
+  });
+
+  win.copng_setUndoList('[{"actionId":1}]');
+  win.copng_applyPatch(
+    '{"base":0,"generation":1,"reset":true,"channels":{"undo":{"patch":{"key":"actionId","rows":[{"op":"insert","index":0,"row":{"actionId":2}}]}}}}',
+  );
+  assert.deepEqual(undo, [{ actionId: 2 }, { actionId: 1 }]);
+
+  detach();
+  assert.equal(win.copng_applyPatch, undefined);
+});
@@ -0,0 +1,117 @@
+#include "CodexOfPowerNG/UiPatchOps.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	namespace UiPatch = CodexOfPowerNG::UiPatch;
+
+	struct Row
+	{
+		int         key{ 0 };
+		std::string value{};
+
+		bool operator==(const Row&) const = default;
+	};
+
+	[[nodiscard]] std::vector<int> KeysOf(const std::vector<Row>& rows)
+	{
+		std::vector<int> keys;
+		for (const auto& row : rows) {
+			keys.push_back(row.key);
+		}
+		return keys;
+	}
+
+	// Plans a patch and replays it the way the UI does; returns the number of ops.
+	std::size_t RoundTrip(const std::vector<Row>& prev, const std::vector<Row>& next)
+	{
+		const auto ops = UiPatch::PlanRowOps(KeysOf(prev), KeysOf(next), [&](std::size_t i, std::size_t j) {
+			return prev[i] == next[j];
+		});
+		assert(ops.has_value());
+
+		auto rows = prev;
+		for (const auto& op : *ops) {
+			switch (op.kind) {
+			case UiPatch::RowOpKind::kRemove:
+				assert(op.index < rows.size() && rows[op.index].key == prev[op.prevIndex].key);
+				rows.erase(rows.begin() + static_cast<std::ptrdiff_t>(op.index));
+				break;
+			case UiPatch::RowOpKind::kInsert:
+				assert(op.index <= rows.size());
+				rows.insert(rows.begin() + static_cast<std::ptrdiff_t>(op.index), next[op.nextIndex]);
+				break;
+			case UiPatch::RowOpKind::kUpdate:
+				assert(op.index < rows.size() && rows[op.index].key == next[op.nextIndex].key);
+				rows[op.index] = next[op.nextIndex];
+				break;
+			}
+		}
+		assert(rows == next);
+		return ops->size();
+	}
+}
+
+int main()
+{
+	const std::vector<Row> base{ { 1, "a" }, { 2, "b" }, { 3, "c" }, { 4, "d" }, { 5, "e" } };
+
+	assert(RoundTrip(base, base) == 0);
+	assert(RoundTrip({}, base) == base.size());
+	assert(RoundTrip(base, {}) == base.size());
+
+	// A registration: one row leaves the page, the next one slides in, one count changes.
+	assert(RoundTrip(base, { { 1, "a" }, { 3, "c" }, { 4, "d2" }, { 5, "e" }, { 6, "f" } }) == 3);
+
+	// Undo history: newest first, oldest falls off.
+	assert(RoundTrip(base, { { 9, "z" }, { 1, "a" }, { 2, "b" }, { 3, "c" }, { 4, "d" } }) == 2);
+
+	// Moving one row keeps the rest in place.
+	assert(RoundTrip(base, { { 2, "b" }, { 3, "c" }, { 4, "d" }, { 1, "a" }, { 5, "e" } }) == 2);
+	RoundTrip(base, { { 5, "e" }, { 4, "d" }, { 3, "c" }, { 2, "b" }, { 1, "a" } });
+
+	// Duplicate keys cannot be patched by key.
+	const auto same = [](std::size_t, std::size_t) { return true; };
+	assert(!UiPatch::PlanRowOps(std::vector<int>{ 1, 1 }, std::vector<int>{ 1 }, same).has_value());
+	assert(!UiPatch::PlanRowOps(std::vector<int>{ 1 }, std::vector<int>{ 2, 2 }, same).has_value());
+
+	// Journal: generations advance per patch; a reset drops baselines and restarts at 0.
+	UiPatch::Journal<std::string, 2> journal;
+	UiPatch::Record(journal, 0, std::string("state"));
+	UiPatch::Record(journal, 5, std::string("ignored"));
+	assert(journal.baselines[0] == "state" && !journal.baselines[1].has_value());
+	assert((UiPatch::Advance(journal) == std::pair<std::uint64_t, std::uint64_t>{ 0, 1 }));
+	assert((UiPatch::Advance(journal) == std::pair<std::uint64_t, std::uint64_t>{ 1, 2 }));
+	UiPatch::Reset(journal);
+	assert(journal.generation == 0 && !journal.baselines[0].has_value());
+
+	// Commit: a delivered patch adopts its baselines; one diffed before a reset is dropped.
+	UiPatch::PendingPatch<std::string, 2> pending;
+	UiPatch::Begin(journal, pending);
+	pending.baselines[1] = std::string("inventory");
+	assert(UiPatch::Commit(journal, pending));
+	assert(journal.generation == 1 && journal.baselines[1] == "inventory" && !journal.baselines[0].has_value());
+	UiPatch::PendingPatch<std::string, 2> stale;
+	stale.baselines[0] = std::string("state");
+	UiPatch::Reset(journal);
+	stale.base = 1;
+	assert(!UiPatch::Commit(journal, stale));
+	assert(journal.generation == 0 && !journal.baselines[0].has_value());
+
+	// A patch diffed at generation 0 is still stale when a reset lands in flight.
+	UiPatch::PendingPatch<std::string, 2> fromZero;
+	UiPatch::Begin(journal, fromZero);
+	fromZero.baselines[0] = std::string("old");
+	UiPatch::Reset(journal);
+	assert(journal.generation == fromZero.base);
+	assert(!UiPatch::Commit(journal, fromZero));
+	assert(journal.generation == 0 && !journal.baselines[0].has_value());
+
+	return 0;
+}
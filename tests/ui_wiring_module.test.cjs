@@ -160,6 +160,7 @@ test("installUIWiring binds core controls and forwards callbacks", async () => {
       pageRequests.push(page);
     },
     getInventoryPage: () => inventory,
+    getRegisteredVersion: () => 2 ** 32 + 42,
     setInventoryPageSize: (next) => {
       setPageSize.push(next);
       inventory.pageSize = next;
@@ -247,6 +248,8 @@ test("installUIWiring binds core controls and forwards callbacks", async () => {
     safeCalls.slice(0, 5).map((entry) => entry.name),
     ["copng_requestState", "copng_getSettings", "copng_requestRegistered", "copng_requestUndoList", "copng_requestBuild"],
   );
+  // Versions past 2^32 go out unchanged.
+  assert.deepEqual(safeCalls[2].payload, { version: 2 ** 32 + 42 });
 
   map.get("btnClose").fire("click");
   const toggleCall = safeCalls.find((entry) => entry.name === "copng_requestToggle");
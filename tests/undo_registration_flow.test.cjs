@@ -84,10 +84,10 @@ test("undo reward rollback applies actual clamped delta to actor values", () =>
 test("undo checks rollback result and emits warning path when no actor deltas were applied", () => {
   const undoSrc = read("src/RegistrationUndo.cpp");
   assert.match(undoSrc, /if \(record\.buildContribution\.has_value\(\)\)/);
-  assert.match(undoSrc, /const auto rollbackResult =/);
-  assert.match(undoSrc, /BuildProgression::RollbackRegistrationContributionDetailed\(record\.buildContribution\.value\(\)\)/);
-  assert.match(undoSrc, /rollbackApplied = rollbackResult\.scoreChanged \|\| rollbackResult\.deactivatedSlots > 0u;/);
-  assert.match(undoSrc, /const auto legacyRollbackApplied = Rewards::RollbackRewardDeltas\(record\.rewardDeltas\);/);
+  assert.match(undoSrc, /BatchOps::AccumulateContribution\(contributions, record\.buildContribution\.value\(\)\)/);
+  assert.match(undoSrc, /const auto rollbackResult = BuildProgression::RollbackRegistrationContributionDetailed\(contribution\.value\(\)\)/);
+  assert.match(undoSrc, /rollbackApplied = rollbackApplied \|\| rollbackResult\.scoreChanged \|\| rollbackResult\.deactivatedSlots > 0u;/);
+  assert.match(undoSrc, /const auto legacyRollbackApplied = Rewards::RollbackRewardDeltas\(legacyRewardDeltas\);/);
   assert.match(undoSrc, /if \(hadRollbackTarget && !rollbackApplied\)/);
   assert.match(undoSrc, /msg\.undoRewardRollbackWarning/);
 });
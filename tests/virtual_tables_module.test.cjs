@@ -26,6 +26,25 @@ test("view loads virtual tables module", () => {
 test("virtual tables module exports expected API", () => {
   assert.equal(typeof mod.createVirtualTableManager, "function");
   assert.equal(typeof mod.getOffsetTopInRoot, "function");
+  assert.equal(typeof mod.applyRowChanges, "function");
+});
+
+test("applyRowChanges splices rows in order and rejects changes that do not line up", () => {
+  const rows = [{ formId: 1 }, { formId: 2 }, { formId: 3 }];
+  assert.equal(
+    mod.applyRowChanges(rows, [
+      { op: "remove", index: 1, formId: 2 },
+      { op: "insert", index: 0, row: { formId: 9 } },
+      { op: "insert", index: 3, row: { formId: 4 } },
+    ]),
+    true,
+  );
+  assert.deepEqual(rows.map((r) => r.formId), [9, 1, 3, 4]);
+
+  assert.equal(mod.applyRowChanges(rows, [{ op: "remove", index: 0, formId: 1 }]), false);
+  assert.equal(mod.applyRowChanges(rows, [{ op: "insert", index: 9, row: { formId: 5 } }]), false);
+  assert.equal(mod.applyRowChanges(rows, [{ op: "move", index: 0 }]), false);
+  assert.equal(mod.applyRowChanges(rows, null), false);
 });
 
 test("quick renderer bypasses virtualization for small lists", () => {